@@ -0,0 +1,174 @@
+# Build-time HLSL -> SPIR-V compilation through the shadercross CLI, used
+# when LUMINOL_RENDER_ENGINE_PRECOMPILE_SHADERS is ON. The renderer then
+# loads these blobs as ShaderSourceLanguage::SpirvBinary instead of compiling
+# HLSL at runtime, so each output name must match what
+# get_precompiled_spirv_path (SDL_GPUShader.hpp) builds for the same
+# ShaderInfo:
+#
+#   res/<dir>/spirv/<stem>[.<NAME>[=<value>]...].spv
+#
+# with one suffix per define, in order, and "=<value>" left out for "1".
+
+# Every file source pulls in through #include "...", recursively, resolved
+# relative to the including file like DXC does. Each scanned file is also a
+# configure dependency, so adding an #include re-runs CMake and the new
+# header is tracked from then on.
+function(luminol_collect_hlsl_includes source out_var)
+    set(includes)
+    set(pending ${source})
+
+    while(pending)
+        list(POP_FRONT pending current)
+        if(NOT EXISTS ${current})
+            message(FATAL_ERROR "HLSL include not found: ${current}")
+        endif()
+        set_property(DIRECTORY APPEND PROPERTY
+            CMAKE_CONFIGURE_DEPENDS ${current}
+        )
+
+        get_filename_component(current_dir ${current} DIRECTORY)
+        file(STRINGS ${current} include_lines
+            REGEX "^[ \t]*#[ \t]*include[ \t]*\"[^\"]+\""
+        )
+        foreach(include_line IN LISTS include_lines)
+            string(REGEX REPLACE
+                "^[ \t]*#[ \t]*include[ \t]*\"([^\"]+)\".*$" "\\1"
+                include_name "${include_line}"
+            )
+            get_filename_component(include_path ${include_name}
+                ABSOLUTE BASE_DIR ${current_dir}
+            )
+            if(NOT include_path IN_LIST includes)
+                list(APPEND includes ${include_path})
+                list(APPEND pending ${include_path})
+            endif()
+        endforeach()
+    endwhile()
+
+    set(${out_var} ${includes} PARENT_SCOPE)
+endfunction()
+
+# luminol_compile_hlsl(<outputs_var>
+#     SOURCE <file.hlsl> STAGE <vertex|fragment|compute>
+#     [ENTRYPOINT <name>] [DEFINES <NAME[=VALUE]>...])
+#
+# Adds the rule producing one SPIR-V permutation of SOURCE under
+# ${CMAKE_BINARY_DIR}/res, next to the copy-resources output, and appends
+# its path to <outputs_var>.
+function(luminol_compile_hlsl outputs_var)
+    cmake_parse_arguments(PARSE_ARGV 1 arg
+        "" "SOURCE;STAGE;ENTRYPOINT" "DEFINES"
+    )
+
+    if(NOT arg_ENTRYPOINT)
+        set(arg_ENTRYPOINT main)
+    endif()
+
+    get_filename_component(source_dir ${arg_SOURCE} DIRECTORY)
+    get_filename_component(source_stem ${arg_SOURCE} NAME_WE)
+    file(RELATIVE_PATH relative_dir
+        ${LUMINOL_RENDER_ENGINE_RES_DIR} ${source_dir}
+    )
+
+    set(output_name ${source_stem})
+    set(define_args)
+    foreach(define IN LISTS arg_DEFINES)
+        string(REGEX REPLACE "=1$" "" define_suffix ${define})
+        string(APPEND output_name ".${define_suffix}")
+        if(define MATCHES "=")
+            list(APPEND define_args "-D${define}")
+        else()
+            list(APPEND define_args "-D${define}=1")
+        endif()
+    endforeach()
+
+    set(output_dir ${CMAKE_BINARY_DIR}/res/${relative_dir}/spirv)
+    set(output ${output_dir}/${output_name}.spv)
+
+    luminol_collect_hlsl_includes(${arg_SOURCE} includes)
+
+    add_custom_command(
+        OUTPUT ${output}
+        COMMAND ${CMAKE_COMMAND} -E make_directory ${output_dir}
+        COMMAND $<TARGET_FILE:shadercross> ${arg_SOURCE}
+            --source HLSL
+            --dest SPIRV
+            --stage ${arg_STAGE}
+            --entrypoint ${arg_ENTRYPOINT}
+            --include ${source_dir}
+            ${define_args}
+            --output ${output}
+        DEPENDS ${arg_SOURCE} ${includes} shadercross
+        COMMENT "Compiling ${relative_dir}/spirv/${output_name}.spv"
+        VERBATIM
+    )
+
+    set(${outputs_var} ${${outputs_var}} ${output} PARENT_SCOPE)
+endfunction()
+
+# Every shader the SDL_GPU renderer (and its smoke tests) creates, one line
+# per permutation. A shader missing here fails at runtime with a missing
+# SPIR-V file, so add new shaders and define combinations as they appear.
+function(luminol_add_sdl_gpu_shaders_target target)
+    set(dir ${LUMINOL_RENDER_ENGINE_RES_DIR}/shaders/sdl_gpu)
+    set(outputs)
+
+    foreach(name
+        brdf_lut_frag
+        hiz_debug_visualize_frag
+        irradiance_convolve_frag
+        mesh_frag
+        normal_prepass_frag
+        pbr_frag
+        pbr_frag_alpha_test
+        prefilter_specular_frag
+        shadow_depth_frag
+        skybox_frag
+        ssao_blur_frag
+        ssao_frag
+        ssr_frag
+        ssr_resolve_frag
+        text_frag
+        tonemap_frag
+    )
+        luminol_compile_hlsl(outputs SOURCE ${dir}/${name}.hlsl STAGE fragment)
+    endforeach()
+
+    foreach(name
+        fullscreen_vert
+        mesh_vert
+        skybox_vert
+        text_vert
+    )
+        luminol_compile_hlsl(outputs SOURCE ${dir}/${name}.hlsl STAGE vertex)
+    endforeach()
+
+    # get_vertex_format_shader_defines permutations.
+    foreach(name pbr_vert pbr_vert_meshlet)
+        luminol_compile_hlsl(outputs SOURCE ${dir}/${name}.hlsl STAGE vertex)
+        luminol_compile_hlsl(outputs
+            SOURCE ${dir}/${name}.hlsl STAGE vertex DEFINES COMPACT_VERTICES
+        )
+    endforeach()
+
+    foreach(name
+        cluster_aabb_build
+        cluster_light_compact
+        cluster_light_count
+        cluster_light_scan
+        cluster_light_transform
+        compute_smoke_test
+        hiz_copy_depth
+        hiz_downsample
+        instance_cull
+        light_sort_global
+        light_sort_local
+        light_tile_cull
+        light_z_bin
+        meshlet_cull
+    )
+        luminol_compile_hlsl(outputs SOURCE ${dir}/${name}.hlsl STAGE compute)
+    endforeach()
+
+    add_custom_target(${target} ALL DEPENDS ${outputs})
+endfunction()
@@ -3,10 +3,21 @@
 // two files must stay in sync) and writes matching light indices into the
 // global index list at [offset, offset+point_count) for point lights and
 // [offset+point_count, offset+point_count+spot_count) for spot lights.
+// A cluster the count pass clamped to lights_per_cluster keeps the lights
+// its grid.importance_cutoff picks (see keep_light), which are exactly the
+// ones it counted.
 //
-// Light view-space position + cull radius are precomputed once per frame on
-// the CPU (SDL_GPUClusterPass::cull_lights) rather than recomputed per
-// cluster here - see cluster_light_count.hlsl.
+// The list is sized from a budget, so a cluster's slice can run past its
+// end (see cluster_light_scan.hlsl). Such a cluster keeps what fits - point
+// lights first - has its grid counts lowered to match, and adds the entries
+// it dropped to light_index_list_usage[1], the overflow counter
+// SDL_GPUClusterPass reads back to grow the list or lower lights_per_cluster.
+//
+// Light view-space position + cull radius are precomputed once per frame by
+// cluster_light_transform.hlsl rather than recomputed per cluster here, and
+// staged through groupshared memory in batches exactly as in
+// cluster_light_count.hlsl (including its every-thread-reaches-every-barrier
+// rule).
 //
 // SDL_GPU compute HLSL register convention: space0 = read-only t/s,
 // space1 = read-write u, space2 = uniform b.
@@ -20,7 +31,9 @@ struct ClusterLightGrid {
     uint offset;
     uint point_count;
     uint spot_count;
-    uint padding;
+    // (cutoff bucket << 16) | quota, or KEEP_ALL_LIGHTS - see
+    // cluster_light_count.hlsl.
+    uint importance_cutoff;
 };
 
 // xyz = view-space position, w = cull radius.
@@ -30,50 +43,143 @@ StructuredBuffer<float4> spot_light_culling_data : register(t1, space0);
 // Written by cluster_aabb_build.hlsl; only read here, but bound via the
 // read-write mechanism since it was created with compute-write usage.
 RWStructuredBuffer<ClusterAABB> cluster_aabbs : register(u0, space1);
-// Offsets already computed by cluster_light_scan.hlsl; only read here.
+// Offsets already computed by cluster_light_scan.hlsl; counts only
+// written back for clusters that don't fit in the list.
 RWStructuredBuffer<ClusterLightGrid> cluster_light_grid : register(u1, space1);
 RWStructuredBuffer<uint> global_light_index_list : register(u2, space1);
+// See cluster_light_scan.hlsl.
+RWStructuredBuffer<uint> light_index_list_usage : register(u3, space1);
 
-// x = point_light_count, y = spot_light_count, z = total_clusters, w = unused.
+// counts: x = point_light_count, y = spot_light_count, z = total_clusters,
+// w = lights_per_cluster (already applied by cluster_light_count.hlsl).
+// index_list: x = global light index list capacity, yzw = unused.
 cbuffer ClusterCullParams : register(b0, space2) {
     uint4 counts;
+    uint4 index_list;
 }
 
+// Must match the numthreads below - one light loaded per thread.
+#define LIGHT_BATCH_SIZE 64
+
+groupshared float4 light_batch[LIGHT_BATCH_SIZE];
+
+#define IMPORTANCE_BUCKET_COUNT 16
+#define KEEP_ALL_LIGHTS 0xFFFFFFFF
+
 bool sphere_intersects_aabb(float3 center, float radius, float3 box_min, float3 box_max) {
     float3 closest = clamp(center, box_min, box_max);
     float3 delta = center - closest;
     return dot(delta, delta) <= radius * radius;
 }
 
+// log2 of how far the light reaches past the cluster's center - radius^2
+// over squared distance - so a bright light right on the cluster outranks a
+// dim one barely grazing it. Higher is more important.
+uint importance_bucket(float3 center, float radius, float3 cluster_center) {
+    float3 delta = center - cluster_center;
+    float reach = (radius * radius) / max(dot(delta, delta), 1e-4);
+    int bucket = int(floor(log2(reach))) + IMPORTANCE_BUCKET_COUNT / 2;
+    return uint(clamp(bucket, 0, IMPORTANCE_BUCKET_COUNT - 1));
+}
+
+// Whether the cluster keeps a light it matched: every light above the
+// cutoff bucket, and the first quota in it - cutoff_taken counts those,
+// across point lights then spot lights, as cluster_light_count.hlsl did.
+bool keep_light(float4 culling_data, float3 cluster_center, uint cutoff, inout uint cutoff_taken) {
+    if (cutoff == KEEP_ALL_LIGHTS) {
+        return true;
+    }
+
+    uint bucket = importance_bucket(culling_data.xyz, culling_data.w, cluster_center);
+    uint cutoff_bucket = cutoff >> 16;
+    if (bucket != cutoff_bucket) {
+        return bucket > cutoff_bucket;
+    }
+    if (cutoff_taken >= (cutoff & 0xFFFF)) {
+        return false;
+    }
+    cutoff_taken++;
+    return true;
+}
+
 [numthreads(64, 1, 1)]
-void main(uint3 dispatch_thread_id : SV_DispatchThreadID) {
+void main(
+    uint3 dispatch_thread_id : SV_DispatchThreadID,
+    uint3 group_thread_id : SV_GroupThreadID
+) {
     uint cluster_index = dispatch_thread_id.x;
     uint total_clusters = counts.z;
-    if (cluster_index >= total_clusters) {
-        return;
-    }
+    bool is_cluster = cluster_index < total_clusters;
+
+    uint grid_index = min(cluster_index, total_clusters - 1);
+    float3 aabb_min = cluster_aabbs[grid_index].min_view.xyz;
+    float3 aabb_max = cluster_aabbs[grid_index].max_view.xyz;
+    float3 aabb_center = (aabb_min + aabb_max) * 0.5;
 
-    float3 aabb_min = cluster_aabbs[cluster_index].min_view.xyz;
-    float3 aabb_max = cluster_aabbs[cluster_index].max_view.xyz;
+    ClusterLightGrid grid = cluster_light_grid[grid_index];
+    uint offset = grid.offset;
 
-    uint offset = cluster_light_grid[cluster_index].offset;
+    // What's left of the list from offset on.
+    uint capacity = index_list.x;
+    uint matched_count = grid.point_count + grid.spot_count;
+    uint kept_count = min(matched_count, offset < capacity ? capacity - offset : 0);
+    uint kept_point_count = min(grid.point_count, kept_count);
+    if (is_cluster && kept_count < matched_count) {
+        cluster_light_grid[cluster_index].point_count = kept_point_count;
+        cluster_light_grid[cluster_index].spot_count = kept_count - kept_point_count;
+        InterlockedAdd(light_index_list_usage[1], matched_count - kept_count);
+    }
+
+    // Threads past the last cluster write nothing.
+    uint point_limit = is_cluster ? kept_point_count : 0;
+    uint spot_limit = is_cluster ? kept_count : 0;
+    uint cutoff = grid.importance_cutoff;
+    uint cutoff_taken = 0;
     uint local_count = 0;
 
     uint point_light_count = counts.x;
-    for (uint i = 0; i < point_light_count; ++i) {
-        float4 culling_data = point_light_culling_data[i];
-        if (sphere_intersects_aabb(culling_data.xyz, culling_data.w, aabb_min, aabb_max)) {
-            global_light_index_list[offset + local_count] = i;
-            local_count++;
+    for (uint batch_start = 0; batch_start < point_light_count; batch_start += LIGHT_BATCH_SIZE) {
+        uint light_index = batch_start + group_thread_id.x;
+        light_batch[group_thread_id.x] = light_index < point_light_count
+            ? point_light_culling_data[light_index]
+            : float4(0.0, 0.0, 0.0, 0.0);
+        GroupMemoryBarrierWithGroupSync();
+
+        uint batch_count = min(LIGHT_BATCH_SIZE, point_light_count - batch_start);
+        for (uint i = 0; i < batch_count; ++i) {
+            float4 culling_data = light_batch[i];
+            // Nested rather than &&'d, so keep_light only ever sees
+            // matching lights - it counts the ones it keeps.
+            if (local_count < point_limit &&
+                sphere_intersects_aabb(culling_data.xyz, culling_data.w, aabb_min, aabb_max)) {
+                if (keep_light(culling_data, aabb_center, cutoff, cutoff_taken)) {
+                    global_light_index_list[offset + local_count] = batch_start + i;
+                    local_count++;
+                }
+            }
         }
+        GroupMemoryBarrierWithGroupSync();
     }
 
     uint spot_light_count = counts.y;
-    for (uint i = 0; i < spot_light_count; ++i) {
-        float4 culling_data = spot_light_culling_data[i];
-        if (sphere_intersects_aabb(culling_data.xyz, culling_data.w, aabb_min, aabb_max)) {
-            global_light_index_list[offset + local_count] = i;
-            local_count++;
+    for (uint batch_start = 0; batch_start < spot_light_count; batch_start += LIGHT_BATCH_SIZE) {
+        uint light_index = batch_start + group_thread_id.x;
+        light_batch[group_thread_id.x] = light_index < spot_light_count
+            ? spot_light_culling_data[light_index]
+            : float4(0.0, 0.0, 0.0, 0.0);
+        GroupMemoryBarrierWithGroupSync();
+
+        uint batch_count = min(LIGHT_BATCH_SIZE, spot_light_count - batch_start);
+        for (uint i = 0; i < batch_count; ++i) {
+            float4 culling_data = light_batch[i];
+            if (local_count < spot_limit &&
+                sphere_intersects_aabb(culling_data.xyz, culling_data.w, aabb_min, aabb_max)) {
+                if (keep_light(culling_data, aabb_center, cutoff, cutoff_taken)) {
+                    global_light_index_list[offset + local_count] = batch_start + i;
+                    local_count++;
+                }
+            }
         }
+        GroupMemoryBarrierWithGroupSync();
     }
 }
@@ -4,15 +4,34 @@
 // writes how many of each matched. cluster_light_scan.hlsl turns these
 // counts into offsets, then cluster_light_compact.hlsl re-runs the exact
 // same test to write the matching light indices - both files must therefore
-// keep the sphere_intersects_aabb function and iteration order identical
+// keep the sphere_intersects_aabb/importance_bucket functions and iteration
+// order identical
 // (mirrors the existing pbr_frag.hlsl/pbr_frag_alpha_test.hlsl duplication
 // convention in this project).
 //
-// Light view-space position + cull radius are precomputed once per frame on
-// the CPU (SDL_GPUClusterPass::cull_lights) rather than recomputed per
-// cluster here, since neither depends on the cluster being tested - see
+// Light view-space position + cull radius are precomputed once per frame by
+// cluster_light_transform.hlsl rather than recomputed per cluster here,
+// since neither depends on the cluster being tested - see
 // point_light_culling_data/spot_light_culling_data.
 //
+// With tens of thousands of lights, every cluster reading every light from
+// the buffer would dominate, so each thread group stages LIGHT_BATCH_SIZE
+// lights at a time in groupshared memory and all 64 of its clusters test
+// against that copy.
+//
+// A cluster's count is clamped to lights_per_cluster (counts.w), so its
+// slice of the global light index list is bounded however many lights
+// there are. Past that, it keeps the most important lights it matched:
+// each match lands in one of IMPORTANCE_BUCKET_COUNT buckets by
+// importance_bucket(), and the cluster keeps every light in the buckets
+// above a cutoff bucket plus the first quota lights found in it. The cutoff
+// is stored in grid.importance_cutoff for cluster_light_compact.hlsl to
+// pick the same lights - KEEP_ALL_LIGHTS when the cluster wasn't clamped.
+//
+// IMPORTANT: every thread must reach every GroupMemoryBarrierWithGroupSync,
+// so threads past the last cluster still help load batches instead of
+// returning early.
+//
 // SDL_GPU compute HLSL register convention: space0 = read-only t/s,
 // space1 = read-write u, space2 = uniform b.
 
@@ -25,7 +44,8 @@ struct ClusterLightGrid {
     uint offset;
     uint point_count;
     uint spot_count;
-    uint padding;
+    // (cutoff bucket << 16) | quota, or KEEP_ALL_LIGHTS.
+    uint importance_cutoff;
 };
 
 // xyz = view-space position, w = cull radius.
@@ -37,51 +57,133 @@ StructuredBuffer<float4> spot_light_culling_data : register(t1, space0);
 RWStructuredBuffer<ClusterAABB> cluster_aabbs : register(u0, space1);
 RWStructuredBuffer<ClusterLightGrid> cluster_light_grid : register(u1, space1);
 
-// x = point_light_count, y = spot_light_count, z = total_clusters, w = unused.
+// counts: x = point_light_count, y = spot_light_count, z = total_clusters,
+// w = lights_per_cluster. index_list: x = global light index list capacity
+// (only used by cluster_light_compact.hlsl), yzw = unused.
 cbuffer ClusterCullParams : register(b0, space2) {
     uint4 counts;
+    uint4 index_list;
 }
 
+// Must match the numthreads below - one light loaded per thread.
+#define LIGHT_BATCH_SIZE 64
+
+groupshared float4 light_batch[LIGHT_BATCH_SIZE];
+
+#define IMPORTANCE_BUCKET_COUNT 16
+#define KEEP_ALL_LIGHTS 0xFFFFFFFF
+
 bool sphere_intersects_aabb(float3 center, float radius, float3 box_min, float3 box_max) {
     float3 closest = clamp(center, box_min, box_max);
     float3 delta = center - closest;
     return dot(delta, delta) <= radius * radius;
 }
 
+// log2 of how far the light reaches past the cluster's center - radius^2
+// over squared distance - so a bright light right on the cluster outranks a
+// dim one barely grazing it. Higher is more important.
+uint importance_bucket(float3 center, float radius, float3 cluster_center) {
+    float3 delta = center - cluster_center;
+    float reach = (radius * radius) / max(dot(delta, delta), 1e-4);
+    int bucket = int(floor(log2(reach))) + IMPORTANCE_BUCKET_COUNT / 2;
+    return uint(clamp(bucket, 0, IMPORTANCE_BUCKET_COUNT - 1));
+}
+
 [numthreads(64, 1, 1)]
-void main(uint3 dispatch_thread_id : SV_DispatchThreadID) {
+void main(
+    uint3 dispatch_thread_id : SV_DispatchThreadID,
+    uint3 group_thread_id : SV_GroupThreadID
+) {
     uint cluster_index = dispatch_thread_id.x;
     uint total_clusters = counts.z;
-    if (cluster_index >= total_clusters) {
-        return;
-    }
+    bool is_cluster = cluster_index < total_clusters;
 
-    float3 aabb_min = cluster_aabbs[cluster_index].min_view.xyz;
-    float3 aabb_max = cluster_aabbs[cluster_index].max_view.xyz;
+    uint aabb_index = min(cluster_index, total_clusters - 1);
+    float3 aabb_min = cluster_aabbs[aabb_index].min_view.xyz;
+    float3 aabb_max = cluster_aabbs[aabb_index].max_view.xyz;
+    float3 aabb_center = (aabb_min + aabb_max) * 0.5;
 
     uint point_light_count = counts.x;
     uint spot_light_count = counts.y;
+    uint lights_per_cluster = counts.w;
+
+    // Matches per importance bucket - all of them, and point lights only.
+    uint bucket_counts[IMPORTANCE_BUCKET_COUNT];
+    uint bucket_point_counts[IMPORTANCE_BUCKET_COUNT];
+    for (uint bucket = 0; bucket < IMPORTANCE_BUCKET_COUNT; ++bucket) {
+        bucket_counts[bucket] = 0;
+        bucket_point_counts[bucket] = 0;
+    }
 
     uint matched_point_count = 0;
-    for (uint i = 0; i < point_light_count; ++i) {
-        float4 culling_data = point_light_culling_data[i];
-        if (sphere_intersects_aabb(culling_data.xyz, culling_data.w, aabb_min, aabb_max)) {
-            matched_point_count++;
+    for (uint batch_start = 0; batch_start < point_light_count; batch_start += LIGHT_BATCH_SIZE) {
+        uint light_index = batch_start + group_thread_id.x;
+        light_batch[group_thread_id.x] = light_index < point_light_count
+            ? point_light_culling_data[light_index]
+            : float4(0.0, 0.0, 0.0, 0.0);
+        GroupMemoryBarrierWithGroupSync();
+
+        uint batch_count = min(LIGHT_BATCH_SIZE, point_light_count - batch_start);
+        for (uint i = 0; i < batch_count; ++i) {
+            float4 culling_data = light_batch[i];
+            if (sphere_intersects_aabb(culling_data.xyz, culling_data.w, aabb_min, aabb_max)) {
+                uint bucket = importance_bucket(culling_data.xyz, culling_data.w, aabb_center);
+                bucket_counts[bucket]++;
+                bucket_point_counts[bucket]++;
+                matched_point_count++;
+            }
         }
+        GroupMemoryBarrierWithGroupSync();
     }
 
     uint matched_spot_count = 0;
-    for (uint i = 0; i < spot_light_count; ++i) {
-        float4 culling_data = spot_light_culling_data[i];
-        if (sphere_intersects_aabb(culling_data.xyz, culling_data.w, aabb_min, aabb_max)) {
-            matched_spot_count++;
+    for (uint batch_start = 0; batch_start < spot_light_count; batch_start += LIGHT_BATCH_SIZE) {
+        uint light_index = batch_start + group_thread_id.x;
+        light_batch[group_thread_id.x] = light_index < spot_light_count
+            ? spot_light_culling_data[light_index]
+            : float4(0.0, 0.0, 0.0, 0.0);
+        GroupMemoryBarrierWithGroupSync();
+
+        uint batch_count = min(LIGHT_BATCH_SIZE, spot_light_count - batch_start);
+        for (uint i = 0; i < batch_count; ++i) {
+            float4 culling_data = light_batch[i];
+            if (sphere_intersects_aabb(culling_data.xyz, culling_data.w, aabb_min, aabb_max)) {
+                bucket_counts[importance_bucket(culling_data.xyz, culling_data.w, aabb_center)]++;
+                matched_spot_count++;
+            }
         }
+        GroupMemoryBarrierWithGroupSync();
+    }
+
+    if (!is_cluster) {
+        return;
     }
 
     ClusterLightGrid grid;
     grid.offset = 0;
-    grid.point_count = matched_point_count;
-    grid.spot_count = matched_spot_count;
-    grid.padding = 0;
+    if (matched_point_count + matched_spot_count <= lights_per_cluster) {
+        grid.point_count = matched_point_count;
+        grid.spot_count = matched_spot_count;
+        grid.importance_cutoff = KEEP_ALL_LIGHTS;
+    } else {
+        // Walk down from the most important bucket until one can't be kept
+        // whole - more matches than lights_per_cluster means one always is.
+        uint kept_count = 0;
+        uint kept_point_count = 0;
+        uint cutoff_bucket = IMPORTANCE_BUCKET_COUNT - 1;
+        while (kept_count + bucket_counts[cutoff_bucket] < lights_per_cluster) {
+            kept_count += bucket_counts[cutoff_bucket];
+            kept_point_count += bucket_point_counts[cutoff_bucket];
+            cutoff_bucket--;
+        }
+
+        // The cutoff bucket's first quota lights, found point lights first.
+        uint quota = lights_per_cluster - kept_count;
+        kept_point_count += min(bucket_point_counts[cutoff_bucket], quota);
+
+        grid.point_count = kept_point_count;
+        grid.spot_count = lights_per_cluster - kept_point_count;
+        grid.importance_cutoff = (cutoff_bucket << 16) | quota;
+    }
     cluster_light_grid[cluster_index] = grid;
 }
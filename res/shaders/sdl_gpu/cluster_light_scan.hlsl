@@ -4,19 +4,30 @@
 // 3456 clusters (16x9x24 grid) so a single-thread serial scan is cheap and
 // avoids the complexity of a parallel scan algorithm.
 //
-// The global light index list is sized cluster_count * (max_point_lights +
-// max_spot_lights), which by construction can never be smaller than the sum
-// of counts across all clusters (no cluster can match more lights than exist
-// in the scene), so no overflow clamping is needed here.
+// The global light index list is sized from a budget, not for every cluster
+// holding lights_per_cluster lights, so the offsets can run past its end.
+// They're left as they are - cluster_light_compact.hlsl clamps every
+// cluster to what's left of the list and counts what it drops - and this
+// pass starts the frame's light_index_list_usage off with the entries the
+// lists needed and how many clusters cluster_light_count.hlsl clamped.
+// SDL_GPUClusterPass reads it back a few frames later to resize the list.
 
 struct ClusterLightGrid {
     uint offset;
     uint point_count;
     uint spot_count;
-    uint padding;
+    // (cutoff bucket << 16) | quota, or KEEP_ALL_LIGHTS - see
+    // cluster_light_count.hlsl.
+    uint importance_cutoff;
 };
 
+#define KEEP_ALL_LIGHTS 0xFFFFFFFF
+
 RWStructuredBuffer<ClusterLightGrid> cluster_light_grid : register(u0, space1);
+// [0] = entries required, [1] = entries dropped (added to by
+// cluster_light_compact.hlsl), [2] = clusters clamped, [3] = unused - see
+// LightIndexListUsage in SDL_GPUClusterPass.hpp.
+RWStructuredBuffer<uint> light_index_list_usage : register(u1, space1);
 
 // x = total_clusters.
 cbuffer ClusterScanParams : register(b0, space2) {
@@ -26,9 +37,19 @@ cbuffer ClusterScanParams : register(b0, space2) {
 [numthreads(1, 1, 1)]
 void main() {
     uint running_offset = 0;
+    uint clamped_cluster_count = 0;
     uint total_clusters = params.x;
     for (uint i = 0; i < total_clusters; ++i) {
+        ClusterLightGrid grid = cluster_light_grid[i];
         cluster_light_grid[i].offset = running_offset;
-        running_offset += cluster_light_grid[i].point_count + cluster_light_grid[i].spot_count;
+        running_offset += grid.point_count + grid.spot_count;
+        if (grid.importance_cutoff != KEEP_ALL_LIGHTS) {
+            clamped_cluster_count++;
+        }
     }
+
+    light_index_list_usage[0] = running_offset;
+    light_index_list_usage[1] = 0;
+    light_index_list_usage[2] = clamped_cluster_count;
+    light_index_list_usage[3] = 0;
 }
@@ -0,0 +1,73 @@
+// Clustered Forward+ light culling setup, run before cluster_light_count.hlsl
+// every frame. One thread per light: transforms the light's world-space
+// position (the same point_lights/spot_lights buffers pbr_frag.hlsl shades
+// from) into view space and computes its cull radius, once, so the 3456
+// clusters of the count/compact passes don't each redo it.
+//
+// Done here rather than on the CPU so a frame whose lights didn't change
+// uploads nothing at all - the light buffers are only patched where
+// LightManager marked lights dirty (SDL_GPUClusterPass::cull_lights), while
+// the view matrix moving every frame costs only this dispatch.
+//
+// SDL_GPU compute HLSL register convention: space0 = read-only t/s,
+// space1 = read-write u, space2 = uniform b.
+
+// Must match struct PointLight/SpotLight in pbr_frag.hlsl (and
+// AlignedPointLight/AlignedSpotLight in Light.hpp) exactly.
+struct PointLight {
+    float4 position;
+    float4 color;
+    float4 shadow_data;
+};
+
+struct SpotLight {
+    float4 position;
+    float4 direction;
+    float3 color;
+    float cut_off;
+    float outer_cut_off;
+    float shadow_slot;
+    float2 padding;
+};
+
+StructuredBuffer<PointLight> point_lights : register(t0, space0);
+StructuredBuffer<SpotLight> spot_lights : register(t1, space0);
+
+// xyz = view-space position, w = cull radius.
+RWStructuredBuffer<float4> point_light_culling_data : register(u0, space1);
+RWStructuredBuffer<float4> spot_light_culling_data : register(u1, space1);
+
+cbuffer ClusterLightTransformParams : register(b0, space2) {
+    row_major float4x4 view_matrix;
+    // x = point_light_count, y = spot_light_count, zw = unused.
+    uint4 counts;
+};
+
+// Must match the light_cull_radius cutoff in pbr_frag.hlsl /
+// SDL_GPUPointSpotShadowPass.cpp / LightManager.cpp exactly.
+float light_cull_radius(float3 color) {
+    const float cutoff = 1.0f / 16.0f;
+    const float intensity = max(color.r, max(color.g, color.b));
+    return sqrt(max(intensity, 0.0f) / cutoff);
+}
+
+[numthreads(64, 1, 1)]
+void main(uint3 dispatch_thread_id : SV_DispatchThreadID) {
+    uint light_index = dispatch_thread_id.x;
+
+    if (light_index < counts.x) {
+        PointLight light = point_lights[light_index];
+        float3 view_position =
+            mul(float4(light.position.xyz, 1.0), view_matrix).xyz;
+        point_light_culling_data[light_index] =
+            float4(view_position, light_cull_radius(light.color.rgb));
+    }
+
+    if (light_index < counts.y) {
+        SpotLight light = spot_lights[light_index];
+        float3 view_position =
+            mul(float4(light.position.xyz, 1.0), view_matrix).xyz;
+        spot_light_culling_data[light_index] =
+            float4(view_position, light_cull_radius(light.color));
+    }
+}
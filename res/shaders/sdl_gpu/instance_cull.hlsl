@@ -46,6 +46,25 @@ struct IndirectDrawCommand {
     uint first_instance;
 };
 
+// Mirrors struct InstanceTransform (InstanceTransform.hpp) - see
+// pbr_vert.hlsl.
+struct InstanceTransform {
+    float4 world_x;
+    float4 world_y;
+    float4 world_z;
+};
+
+// Rebuilds the row_major model matrix (row-vector convention) the rest of
+// this shader multiplies by.
+row_major float4x4 decode_instance_model(InstanceTransform transform) {
+    return transpose(float4x4(
+        transform.world_x,
+        transform.world_y,
+        transform.world_z,
+        float4(0.0f, 0.0f, 0.0f, 1.0f)
+    ));
+}
+
 // hiz_pyramid/hiz_sampler must share the same numeric index (t0/s0) to
 // compile as one combined-image-sampler descriptor; instance_models is a
 // separate SRV so it takes the next free t-register (t and Texture SRVs
@@ -53,7 +72,7 @@ struct IndirectDrawCommand {
 // submesh_metadata/group_to_submesh follow at t2/t3.
 Texture2D hiz_pyramid : register(t0, space0);
 SamplerState hiz_sampler : register(s0, space0);
-StructuredBuffer<row_major float4x4> instance_models : register(t1, space0);
+StructuredBuffer<InstanceTransform> instance_models : register(t1, space0);
 
 // One entry per submesh. Mirrors struct SubmeshCullMetadata in
 // SDL_GPUInstanceCullPass.cpp exactly. command_indices/instance_base_offsets
@@ -71,12 +90,18 @@ StructuredBuffer<row_major float4x4> instance_models : register(t1, space0);
 // such per-element stride rule (always exactly 16 bytes, byte-identical to
 // the C++ side on every backend), which is why they're used here instead.
 // [] indexing with a dynamic index works identically on vector types.
-// The struct's own byte size (88) isn't a multiple of 16, but a
+// The struct's own byte size (92) isn't a multiple of 16, but a
 // StructuredBuffer's implicit per-element array STRIDE always is (rounded up
 // to the buffer's base alignment, 16, under the std430-style layout DXC
 // emits by default for SPIR-V) - so submesh_metadata[i] is actually read at
-// byte i*96, not i*88. _padding makes the struct's real size match that
+// byte i*96, not i*92. _padding makes the struct's real size match that
 // stride exactly, so no rounding-induced drift can occur between elements.
+//
+// first_instance is the batch's first instance within the bound
+// instance_models arena (SDL_GPUInstanceBufferCache): instance_models holds
+// every renderable's instances, so this submesh's instance i lives at
+// first_instance + i, and that arena index is what's written to
+// visible_instance_indices for the vertex shader to read back.
 struct SubmeshCullMetadata {
     float4 local_bounds_min;
     float4 local_bounds_max;
@@ -85,7 +110,8 @@ struct SubmeshCullMetadata {
     float4 lod_distances_sq;
     uint instance_count;
     uint first_group;
-    uint2 _padding;
+    uint first_instance;
+    uint _padding;
 };
 StructuredBuffer<SubmeshCullMetadata> submesh_metadata : register(t2, space0);
 // One entry per thread group in this dispatch, indexed by
@@ -152,7 +178,9 @@ void main(uint3 group_id : SV_GroupID, uint3 group_thread_id : SV_GroupThreadID)
         return;
     }
 
-    row_major float4x4 model = instance_models[instance_index];
+    uint arena_index = metadata.first_instance + instance_index;
+    row_major float4x4 model =
+        decode_instance_model(instance_models[arena_index]);
 
     float3 local_bounds_min = metadata.local_bounds_min.xyz;
     float3 local_bounds_max = metadata.local_bounds_max.xyz;
@@ -305,5 +333,5 @@ void main(uint3 group_id : SV_GroupID, uint3 group_thread_id : SV_GroupThreadID)
         1, dest_slot
     );
     visible_instance_indices[metadata.instance_base_offsets[selected_lod] + dest_slot] =
-        instance_index;
+        arena_index;
 }
@@ -0,0 +1,39 @@
+// Z-binned light culling, bitonic sort of every point/spot light by view
+// depth - one step of a merge stage whose pairs are further apart than a
+// light_sort_local.hlsl block, so they can't be sorted in groupshared
+// memory. One thread per compare-exchange pair; each step is its own
+// dispatch, since the next depends on it. See SDL_GPUZBinPass for the
+// dispatch order.
+//
+// SDL_GPU compute HLSL register convention: space0 = read-only t/s,
+// space1 = read-write u, space2 = uniform b.
+
+// uint2(depth key, light) - see light_sort_local.hlsl.
+RWStructuredBuffer<uint2> depth_sorted_lights : register(u0, space1);
+
+// x = merge stage size, y = partner distance, z = sorted slot count (a
+// power of two), w = unused.
+cbuffer LightSortParams : register(b0, space2) {
+    uint4 params;
+};
+
+[numthreads(256, 1, 1)]
+void main(uint3 dispatch_thread_id : SV_DispatchThreadID) {
+    uint thread_index = dispatch_thread_id.x;
+    uint stage_size = params.x;
+    uint distance = params.y;
+    if (thread_index >= params.z / 2) {
+        return;
+    }
+
+    uint first = 2 * distance * (thread_index / distance) + (thread_index % distance);
+    uint second = first + distance;
+    bool ascending = (first & stage_size) == 0;
+
+    uint2 a = depth_sorted_lights[first];
+    uint2 b = depth_sorted_lights[second];
+    if ((a.x > b.x) == ascending) {
+        depth_sorted_lights[first] = b;
+        depth_sorted_lights[second] = a;
+    }
+}
@@ -0,0 +1,104 @@
+// Z-binned light culling, bitonic sort of every point/spot light by view
+// depth - the in-block part. Each thread group sorts one SORT_BLOCK_SIZE
+// slice of depth_sorted_lights in groupshared memory: either the whole
+// bitonic network up to SORT_BLOCK_SIZE (params.z == 0, the first pass,
+// which also builds the keys from the light culling data), or the tail of
+// one merge stage params.z, whose steps no longer cross a block boundary.
+// light_sort_global.hlsl does the steps that do. See SDL_GPUZBinPass for
+// the dispatch order.
+//
+// A sorted entry is uint2(key, light): key is the light's view depth with
+// its bits flipped so unsigned order matches float order, light its index
+// in point_lights, or in spot_lights with SPOT_LIGHT_FLAG set. Slots past
+// the last light are padding with the largest key, so they sort last.
+//
+// SDL_GPU compute HLSL register convention: space0 = read-only t/s,
+// space1 = read-write u, space2 = uniform b.
+
+// xyz = view-space position, w = cull radius.
+StructuredBuffer<float4> point_light_culling_data : register(t0, space0);
+StructuredBuffer<float4> spot_light_culling_data : register(t1, space0);
+
+RWStructuredBuffer<uint2> depth_sorted_lights : register(u0, space1);
+
+// x = point_light_count, y = spot_light_count, z = merge stage size (0 =
+// build keys and sort each block), w = unused.
+cbuffer LightSortParams : register(b0, space2) {
+    uint4 params;
+};
+
+// Must match the numthreads below - two entries per thread.
+#define SORT_BLOCK_SIZE 1024
+// Must match pbr_frag.hlsl / light_tile_cull.hlsl / light_z_bin.hlsl.
+#define SPOT_LIGHT_FLAG 0x80000000
+#define PADDING_KEY 0xFFFFFFFF
+
+groupshared uint2 block[SORT_BLOCK_SIZE];
+
+uint depth_key(float depth) {
+    uint bits = asuint(depth);
+    return (bits & 0x80000000) != 0 ? ~bits : bits | 0x80000000;
+}
+
+uint2 make_entry(uint slot) {
+    uint point_light_count = params.x;
+    uint spot_light_count = params.y;
+    if (slot < point_light_count) {
+        return uint2(depth_key(point_light_culling_data[slot].z), slot);
+    }
+    if (slot < point_light_count + spot_light_count) {
+        uint spot_index = slot - point_light_count;
+        return uint2(
+            depth_key(spot_light_culling_data[spot_index].z),
+            spot_index | SPOT_LIGHT_FLAG
+        );
+    }
+    return uint2(PADDING_KEY, 0);
+}
+
+// One compare-exchange step of stage stage_size with partner distance
+// distance: thread_index handles one pair, ordered ascending or descending
+// by where the pair sits in the whole list.
+void sort_step(uint block_start, uint thread_index, uint stage_size, uint distance) {
+    uint first = 2 * distance * (thread_index / distance) + (thread_index % distance);
+    uint second = first + distance;
+    bool ascending = ((block_start + first) & stage_size) == 0;
+
+    uint2 a = block[first];
+    uint2 b = block[second];
+    if ((a.x > b.x) == ascending) {
+        block[first] = b;
+        block[second] = a;
+    }
+    GroupMemoryBarrierWithGroupSync();
+}
+
+[numthreads(512, 1, 1)]
+void main(uint3 group_id : SV_GroupID, uint3 group_thread_id : SV_GroupThreadID) {
+    uint block_start = group_id.x * SORT_BLOCK_SIZE;
+    uint thread_index = group_thread_id.x;
+    uint merge_stage = params.z;
+
+    for (uint i = thread_index; i < SORT_BLOCK_SIZE; i += SORT_BLOCK_SIZE / 2) {
+        block[i] = merge_stage == 0
+            ? make_entry(block_start + i)
+            : depth_sorted_lights[block_start + i];
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    if (merge_stage == 0) {
+        for (uint stage_size = 2; stage_size <= SORT_BLOCK_SIZE; stage_size *= 2) {
+            for (uint distance = stage_size / 2; distance > 0; distance /= 2) {
+                sort_step(block_start, thread_index, stage_size, distance);
+            }
+        }
+    } else {
+        for (uint distance = SORT_BLOCK_SIZE / 2; distance > 0; distance /= 2) {
+            sort_step(block_start, thread_index, merge_stage, distance);
+        }
+    }
+
+    for (uint i = thread_index; i < SORT_BLOCK_SIZE; i += SORT_BLOCK_SIZE / 2) {
+        depth_sorted_lights[block_start + i] = block[i];
+    }
+}
@@ -0,0 +1,113 @@
+// Z-binned light culling, pass 1 of 2 (tile cull -> z bin), after
+// light_sort_local.hlsl/light_sort_global.hlsl have sorted every light by
+// view depth. Screen tiles (LIGHT_TILE_GRID_X x LIGHT_TILE_GRID_Y, covering
+// the whole view depth range) each get a bitmask over the sorted lights,
+// one bit per light whose culling sphere touches the tile's frustum. One
+// thread per (tile, mask word) tests that word's 32 lights.
+//
+// Depth is handled separately by light_z_bin.hlsl, so a tile's mask only
+// needs its four side planes here. Its threads also reset the z bins for
+// that pass, since this dispatch always runs first.
+//
+// SDL_GPU compute HLSL register convention: space0 = read-only t/s,
+// space1 = read-write u, space2 = uniform b.
+
+// xyz = view-space position, w = cull radius.
+StructuredBuffer<float4> point_light_culling_data : register(t0, space0);
+StructuredBuffer<float4> spot_light_culling_data : register(t1, space0);
+// uint2(depth key, light) - see light_sort_local.hlsl.
+StructuredBuffer<uint2> depth_sorted_lights : register(t2, space0);
+
+// LIGHT_TILE_GRID_X * LIGHT_TILE_GRID_Y masks of params.y words each,
+// tile-major.
+RWStructuredBuffer<uint> light_tile_masks : register(u0, space1);
+// First then last sorted light touching each z bin - see light_z_bin.hlsl.
+RWStructuredBuffer<uint> light_z_bins : register(u1, space1);
+
+// camera: x = tan(vertical fov / 2), y = aspect ratio, z = near plane,
+// w = far plane. params: x = light count, y = mask words per tile,
+// zw = unused.
+cbuffer LightBinParams : register(b0, space2) {
+    float4 camera;
+    uint4 params;
+};
+
+// Must match light_tile_grid_x/y and light_z_bin_count in
+// SDL_GPUZBinPass.hpp, and pbr_frag.hlsl.
+#define LIGHT_TILE_GRID_X 32
+#define LIGHT_TILE_GRID_Y 18
+#define LIGHT_Z_BIN_COUNT 512
+// Must match light_sort_local.hlsl.
+#define SPOT_LIGHT_FLAG 0x80000000
+
+float4 light_culling_data(uint light) {
+    return (light & SPOT_LIGHT_FLAG) != 0
+        ? spot_light_culling_data[light & ~SPOT_LIGHT_FLAG]
+        : point_light_culling_data[light];
+}
+
+// Whether a sphere is on the inner side of a plane through the view origin
+// (or crosses it), for a plane given by its unnormalized inward normal.
+bool sphere_inside_plane(float3 center, float radius, float3 normal) {
+    return dot(normal, center) >= -radius * length(normal);
+}
+
+[numthreads(64, 1, 1)]
+void main(uint3 dispatch_thread_id : SV_DispatchThreadID) {
+    uint thread_index = dispatch_thread_id.x;
+    if (thread_index < LIGHT_Z_BIN_COUNT) {
+        light_z_bins[thread_index * 2] = 0xFFFFFFFF;
+        light_z_bins[thread_index * 2 + 1] = 0;
+    }
+
+    uint light_count = params.x;
+    uint word_count = params.y;
+    uint tile_count = LIGHT_TILE_GRID_X * LIGHT_TILE_GRID_Y;
+    if (thread_index >= tile_count * word_count) {
+        return;
+    }
+
+    uint tile_index = thread_index / word_count;
+    uint word_index = thread_index % word_count;
+
+    // Row 0 is the bottom of the screen (NDC y = -1), as in
+    // cluster_aabb_build.hlsl.
+    uint tile_x = tile_index % LIGHT_TILE_GRID_X;
+    uint tile_y = tile_index / LIGHT_TILE_GRID_X;
+    float2 ndc_min = float2(
+        float(tile_x) / LIGHT_TILE_GRID_X,
+        float(tile_y) / LIGHT_TILE_GRID_Y
+    ) * 2.0 - 1.0;
+    float2 ndc_max = float2(
+        float(tile_x + 1) / LIGHT_TILE_GRID_X,
+        float(tile_y + 1) / LIGHT_TILE_GRID_Y
+    ) * 2.0 - 1.0;
+
+    // A view-space point is in the tile when x / z is between these
+    // slopes (and likewise for y) - each side plane holds the view origin.
+    float slope_x = camera.x * camera.y;
+    float slope_y = camera.x;
+    float3 left = float3(1.0, 0.0, -ndc_min.x * slope_x);
+    float3 right = float3(-1.0, 0.0, ndc_max.x * slope_x);
+    float3 bottom = float3(0.0, 1.0, -ndc_min.y * slope_y);
+    float3 top = float3(0.0, -1.0, ndc_max.y * slope_y);
+    float near_plane = camera.z;
+
+    uint mask = 0;
+    uint first_slot = word_index * 32;
+    uint slot_count = min(32, light_count - min(light_count, first_slot));
+    for (uint bit = 0; bit < slot_count; ++bit) {
+        float4 culling_data =
+            light_culling_data(depth_sorted_lights[first_slot + bit].y);
+        float3 center = culling_data.xyz;
+        float radius = culling_data.w;
+        if (center.z + radius >= near_plane &&
+            sphere_inside_plane(center, radius, left) &&
+            sphere_inside_plane(center, radius, right) &&
+            sphere_inside_plane(center, radius, bottom) &&
+            sphere_inside_plane(center, radius, top)) {
+            mask |= 1u << bit;
+        }
+    }
+    light_tile_masks[thread_index] = mask;
+}
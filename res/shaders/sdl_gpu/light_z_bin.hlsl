@@ -0,0 +1,67 @@
+// Z-binned light culling, pass 2 of 2 (tile cull -> z bin). The view depth
+// range is cut into LIGHT_Z_BIN_COUNT bins, sliced exponentially like the
+// cluster grid's z slices (see cluster_aabb_build.hlsl), and each bin keeps
+// the first and last sorted light whose culling sphere spans its depth.
+// Lights are sorted by view depth, so that range is short, and pbr_frag.hlsl
+// only walks the tile mask words it covers. One thread per sorted light
+// widens every bin its sphere spans; light_tile_cull.hlsl reset the bins to
+// empty (first > last) just before.
+//
+// SDL_GPU compute HLSL register convention: space0 = read-only t/s,
+// space1 = read-write u, space2 = uniform b.
+
+// xyz = view-space position, w = cull radius.
+StructuredBuffer<float4> point_light_culling_data : register(t0, space0);
+StructuredBuffer<float4> spot_light_culling_data : register(t1, space0);
+// uint2(depth key, light) - see light_sort_local.hlsl.
+StructuredBuffer<uint2> depth_sorted_lights : register(t2, space0);
+
+// First then last sorted light touching each bin - plain uints rather than
+// uint2s so each can be updated atomically.
+RWStructuredBuffer<uint> light_z_bins : register(u0, space1);
+
+// Same layout as light_tile_cull.hlsl's.
+cbuffer LightBinParams : register(b0, space2) {
+    float4 camera;
+    uint4 params;
+};
+
+// Must match light_tile_cull.hlsl / pbr_frag.hlsl.
+#define LIGHT_Z_BIN_COUNT 512
+#define SPOT_LIGHT_FLAG 0x80000000
+
+float4 light_culling_data(uint light) {
+    return (light & SPOT_LIGHT_FLAG) != 0
+        ? spot_light_culling_data[light & ~SPOT_LIGHT_FLAG]
+        : point_light_culling_data[light];
+}
+
+// Must match compute_light_z_bin in pbr_frag.hlsl exactly.
+uint z_bin(float z_view, float near_plane, float far_plane) {
+    float slice = log(z_view / near_plane) / log(far_plane / near_plane);
+    return min(uint(max(slice, 0.0) * LIGHT_Z_BIN_COUNT), LIGHT_Z_BIN_COUNT - 1);
+}
+
+[numthreads(64, 1, 1)]
+void main(uint3 dispatch_thread_id : SV_DispatchThreadID) {
+    uint slot = dispatch_thread_id.x;
+    if (slot >= params.x) {
+        return;
+    }
+
+    float4 culling_data = light_culling_data(depth_sorted_lights[slot].y);
+    float near_plane = camera.z;
+    float far_plane = camera.w;
+    float nearest = culling_data.z - culling_data.w;
+    float farthest = culling_data.z + culling_data.w;
+    if (farthest < near_plane || nearest > far_plane) {
+        return;
+    }
+
+    uint first_bin = z_bin(max(nearest, near_plane), near_plane, far_plane);
+    uint last_bin = z_bin(min(farthest, far_plane), near_plane, far_plane);
+    for (uint bin = first_bin; bin <= last_bin; ++bin) {
+        InterlockedMin(light_z_bins[bin * 2], slot);
+        InterlockedMax(light_z_bins[bin * 2 + 1], slot);
+    }
+}
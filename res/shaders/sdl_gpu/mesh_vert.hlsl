@@ -2,7 +2,26 @@ cbuffer UBO : register(b0, space1) {
     row_major float4x4 view_proj;
 };
 
-StructuredBuffer<row_major float4x4> instance_models : register(t0, space0);
+// Mirrors struct InstanceTransform (InstanceTransform.hpp) - see
+// pbr_vert.hlsl.
+struct InstanceTransform {
+    float4 world_x;
+    float4 world_y;
+    float4 world_z;
+};
+
+// Rebuilds the row_major model matrix (row-vector convention) the rest of
+// this shader multiplies by.
+row_major float4x4 decode_instance_model(InstanceTransform transform) {
+    return transpose(float4x4(
+        transform.world_x,
+        transform.world_y,
+        transform.world_z,
+        float4(0.0f, 0.0f, 0.0f, 1.0f)
+    ));
+}
+
+StructuredBuffer<InstanceTransform> instance_models : register(t0, space0);
 
 struct VSInput {
     float3 position : POSITION;
@@ -16,7 +35,8 @@ struct VSOutput {
 };
 
 VSOutput main(VSInput input) {
-    const row_major float4x4 instance_model = instance_models[input.instance_id];
+    const row_major float4x4 instance_model =
+        decode_instance_model(instance_models[input.instance_id]);
 
     VSOutput output;
     output.position = mul(
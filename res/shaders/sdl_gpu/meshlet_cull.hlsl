@@ -109,11 +109,30 @@ struct GpuMeshletMetadata {
     float4 local_bounds_max;
 };
 
+// Mirrors struct InstanceTransform (InstanceTransform.hpp) - see
+// pbr_vert.hlsl.
+struct InstanceTransform {
+    float4 world_x;
+    float4 world_y;
+    float4 world_z;
+};
+
+// Rebuilds the row_major model matrix (row-vector convention) the rest of
+// this shader multiplies by.
+row_major float4x4 decode_instance_model(InstanceTransform transform) {
+    return transpose(float4x4(
+        transform.world_x,
+        transform.world_y,
+        transform.world_z,
+        float4(0.0f, 0.0f, 0.0f, 1.0f)
+    ));
+}
+
 // hiz_pyramid/hiz_sampler share t0/s0 to compile as one combined-image-
 // sampler descriptor, mirroring instance_cull.hlsl.
 Texture2D hiz_pyramid : register(t0, space0);
 SamplerState hiz_sampler : register(s0, space0);
-StructuredBuffer<row_major float4x4> instance_models : register(t1, space0);
+StructuredBuffer<InstanceTransform> instance_models : register(t1, space0);
 StructuredBuffer<uint> phase_a_visible_instance_indices : register(t2, space0);
 StructuredBuffer<PhaseAIndirectDrawCommand> phase_a_commands : register(t3, space0);
 StructuredBuffer<MeshletCullMetadata> meshlet_cull_metadata : register(t4, space0);
@@ -194,7 +213,8 @@ void main(uint3 group_id : SV_GroupID, uint3 group_thread_id : SV_GroupThreadID)
     uint original_instance_index = phase_a_visible_instance_indices[
         metadata.phase_a_instance_base + instance_slot
     ];
-    row_major float4x4 model = instance_models[original_instance_index];
+    row_major float4x4 model =
+        decode_instance_model(instance_models[original_instance_index]);
 
     uint meshlet_index = metadata.meshlet_first + meshlet_slot;
     GpuMeshletMetadata meshlet = mesh_meshlet_metadata[meshlet_index];
@@ -85,6 +85,17 @@ StructuredBuffer<ClusterLightGrid> cluster_light_grid : register(t15, space2);
 StructuredBuffer<uint> global_light_index_list : register(t16, space2);
 StructuredBuffer<row_major float4x4> spot_shadow_matrices : register(t17, space2);
 
+// Z-binned light culling buffers, populated by SDL_GPUZBinPass and read
+// instead of cluster_light_grid/global_light_index_list when
+// cluster_params.z is LIGHT_CULLING_MODE_Z_BINNED. light_z_bins holds the
+// first then last depth-sorted light reaching each z bin,
+// light_tile_masks a bitmask over the depth-sorted lights per screen tile,
+// and depth_sorted_lights the light each bit stands for - see
+// light_tile_cull.hlsl/light_z_bin.hlsl.
+StructuredBuffer<uint> light_z_bins : register(t18, space2);
+StructuredBuffer<uint> light_tile_masks : register(t19, space2);
+StructuredBuffer<uint2> depth_sorted_lights : register(t20, space2);
+
 // Must match SDL_GPUPointSpotShadowPass.cpp exactly.
 static const float POINT_SHADOW_NEAR_PLANE = 0.05f;
 static const float POINT_SHADOW_RESOLUTION = 512.0f;
@@ -102,6 +113,16 @@ static const uint CLUSTER_GRID_X = 16;
 static const uint CLUSTER_GRID_Y = 9;
 static const uint CLUSTER_GRID_Z = 24;
 
+// Must match LightCullingMode in SDL_GPUClusterPass.hpp.
+static const float LIGHT_CULLING_MODE_Z_BINNED = 1.0f;
+
+// Must match light_tile_grid_x/y and light_z_bin_count in
+// SDL_GPUZBinPass.hpp, and SPOT_LIGHT_FLAG in light_sort_local.hlsl.
+static const uint LIGHT_TILE_GRID_X = 32;
+static const uint LIGHT_TILE_GRID_Y = 18;
+static const uint LIGHT_Z_BIN_COUNT = 512;
+static const uint SPOT_LIGHT_FLAG = 0x80000000;
+
 // Must match shadow_pass_num_cascades in SDL_GPUMeshRenderPass.hpp exactly.
 static const uint NUM_SHADOW_CASCADES = 4;
 
@@ -113,7 +134,8 @@ cbuffer LightBuffer : register(b0, space3) {
     // x: shadow map resolution, y: normal-offset bias,
     // z: max prefiltered specular mip level
     float4 shadow_params;
-    // x: camera near plane, y: camera far plane, z/w: unused.
+    // x: camera near plane, y: camera far plane, z: LightCullingMode,
+    // w: light_tile_masks words per tile (Z-binned mode only).
     float4 cluster_params;
     row_major float4x4 cascade_light_space_matrices[NUM_SHADOW_CASCADES];
     // View-space far distance of each cascade (see SDL_GPUShadowPass); the
@@ -153,6 +175,32 @@ uint compute_cluster_index(
         cluster_y * CLUSTER_GRID_X + cluster_x;
 }
 
+// Must match the tile layout in light_tile_cull.hlsl exactly.
+uint compute_light_tile_index(float2 screen_position) {
+    const float2 tile_uv = screen_position / screen_size.xy;
+
+    const uint tile_x =
+        min(uint(tile_uv.x * float(LIGHT_TILE_GRID_X)), LIGHT_TILE_GRID_X - 1);
+    // Flipped like cluster_y in compute_cluster_index.
+    const uint tile_y = min(
+        uint((1.0f - tile_uv.y) * float(LIGHT_TILE_GRID_Y)),
+        LIGHT_TILE_GRID_Y - 1
+    );
+    return tile_y * LIGHT_TILE_GRID_X + tile_x;
+}
+
+// Must match z_bin in light_z_bin.hlsl exactly.
+uint compute_light_z_bin(float z_ndc, float near_plane, float far_plane) {
+    const float z_view = (near_plane * far_plane) /
+        (far_plane - z_ndc * (far_plane - near_plane));
+    const float slice =
+        log(z_view / near_plane) / log(far_plane / near_plane);
+    return min(
+        uint(max(slice, 0.0f) * float(LIGHT_Z_BIN_COUNT)),
+        LIGHT_Z_BIN_COUNT - 1
+    );
+}
+
 struct PSInput {
     float2 uv : TEXCOORD0;
     float3 world_position : TEXCOORD1;
@@ -277,8 +325,7 @@ float3 calculate_directional_light(
     return (k_d * albedo / PI + specular) * radiance * n_dot_l;
 }
 
-// Must match the cutoff in cluster_light_count.hlsl / cluster_light_compact.hlsl
-// exactly, so a light's shaded falloff (via distance_window below) reaches
+// Must match the cutoff in cluster_light_transform.hlsl exactly, so a light's shaded falloff (via distance_window below) reaches
 // zero at the same radius culling uses to exclude it entirely - otherwise
 // lights would pop off abruptly at cluster boundaries instead of fading out.
 float light_cull_radius(float3 color) {
@@ -624,37 +671,83 @@ float4 main(PSInput input) : SV_Target {
         normal, view_direction, albedo, f0, metallic, roughness
     );
 
-    const uint cluster_index = compute_cluster_index(
-        input.screen_position.xy, input.screen_position.z,
-        cluster_params.x, cluster_params.y
-    );
-    const ClusterLightGrid grid = cluster_light_grid[cluster_index];
-
     float3 point_lo = float3(0.0f, 0.0f, 0.0f);
-    [loop]
-    for (uint i = 0; i < grid.point_count; ++i) {
-        const uint light_index = global_light_index_list[grid.offset + i];
-        const PointLight point_light = point_lights[light_index];
-        const float point_shadow =
-            calculate_point_shadow(input.world_position, N, point_light);
-        point_lo += calculate_point_light(
-            point_light, normal, view_direction, input.world_position,
-            albedo, f0, metallic, roughness
-        ) * point_shadow;
-    }
-
     float3 spot_lo = float3(0.0f, 0.0f, 0.0f);
-    [loop]
-    for (uint i = 0; i < grid.spot_count; ++i) {
-        const uint light_index =
-            global_light_index_list[grid.offset + grid.point_count + i];
-        const SpotLight spot_light = spot_lights[light_index];
-        const float spot_shadow =
-            calculate_spot_shadow(input.world_position, N, spot_light);
-        spot_lo += calculate_spot_light(
-            spot_light, normal, view_direction, input.world_position,
-            albedo, f0, metallic, roughness
-        ) * spot_shadow;
+    if (cluster_params.z == LIGHT_CULLING_MODE_Z_BINNED) {
+        const uint tile_index =
+            compute_light_tile_index(input.screen_position.xy);
+        const uint z_bin = compute_light_z_bin(
+            input.screen_position.z, cluster_params.x, cluster_params.y
+        );
+        // First and last depth-sorted light that can reach this depth -
+        // only the tile mask words between them are read.
+        const uint first_slot = light_z_bins[z_bin * 2];
+        const uint last_slot = light_z_bins[z_bin * 2 + 1];
+        const uint mask_word_count = uint(cluster_params.w);
+        [loop]
+        for (uint word = first_slot / 32;
+             first_slot <= last_slot && word <= last_slot / 32; ++word) {
+            const uint low_bit = word == first_slot / 32 ? first_slot % 32 : 0;
+            const uint high_bit = word == last_slot / 32 ? last_slot % 32 : 31;
+            uint mask = light_tile_masks[tile_index * mask_word_count + word] &
+                (0xFFFFFFFFu << low_bit) & (0xFFFFFFFFu >> (31 - high_bit));
+
+            [loop]
+            while (mask != 0) {
+                const uint bit = firstbitlow(mask);
+                mask &= mask - 1;
+                const uint light = depth_sorted_lights[word * 32 + bit].y;
+                if ((light & SPOT_LIGHT_FLAG) != 0) {
+                    const SpotLight spot_light =
+                        spot_lights[light & ~SPOT_LIGHT_FLAG];
+                    const float spot_shadow =
+                        calculate_spot_shadow(input.world_position, N, spot_light);
+                    spot_lo += calculate_spot_light(
+                        spot_light, normal, view_direction, input.world_position,
+                        albedo, f0, metallic, roughness
+                    ) * spot_shadow;
+                } else {
+                    const PointLight point_light = point_lights[light];
+                    const float point_shadow =
+                        calculate_point_shadow(input.world_position, N, point_light);
+                    point_lo += calculate_point_light(
+                        point_light, normal, view_direction, input.world_position,
+                        albedo, f0, metallic, roughness
+                    ) * point_shadow;
+                }
+            }
+        }
+    } else {
+        const uint cluster_index = compute_cluster_index(
+            input.screen_position.xy, input.screen_position.z,
+            cluster_params.x, cluster_params.y
+        );
+        const ClusterLightGrid grid = cluster_light_grid[cluster_index];
+
+        [loop]
+        for (uint i = 0; i < grid.point_count; ++i) {
+            const uint light_index = global_light_index_list[grid.offset + i];
+            const PointLight point_light = point_lights[light_index];
+            const float point_shadow =
+                calculate_point_shadow(input.world_position, N, point_light);
+            point_lo += calculate_point_light(
+                point_light, normal, view_direction, input.world_position,
+                albedo, f0, metallic, roughness
+            ) * point_shadow;
+        }
+
+        [loop]
+        for (uint i = 0; i < grid.spot_count; ++i) {
+            const uint light_index =
+                global_light_index_list[grid.offset + grid.point_count + i];
+            const SpotLight spot_light = spot_lights[light_index];
+            const float spot_shadow =
+                calculate_spot_shadow(input.world_position, N, spot_light);
+            spot_lo += calculate_spot_light(
+                spot_light, normal, view_direction, input.world_position,
+                albedo, f0, metallic, roughness
+            ) * spot_shadow;
+        }
     }
 
     const float shadow = calculate_shadow(input.world_position, N);
@@ -2,7 +2,38 @@ cbuffer UBO : register(b0, space1) {
     row_major float4x4 view_proj;
 };
 
-StructuredBuffer<row_major float4x4> instance_models : register(t0, space0);
+// Maps a COMPACT_VERTICES position back to model space - mirrors
+// VertexDequantization (SDL_GPUVertexFormat.hpp). Always pushed per
+// renderable (identity for the full-precision layout) so both builds of
+// this shader share one resource layout.
+cbuffer VertexDequantization : register(b1, space1) {
+    float4 position_offset;
+    float4 position_scale;
+};
+
+// Mirrors struct InstanceTransform (InstanceTransform.hpp): an affine model
+// matrix's three world-space axes, without its constant (0, 0, 0, 1) last
+// column - 48 bytes per instance instead of 64. The struct's size is
+// already a multiple of 16, so its StructuredBuffer stride matches the C++
+// side exactly.
+struct InstanceTransform {
+    float4 world_x;
+    float4 world_y;
+    float4 world_z;
+};
+
+// Rebuilds the row_major model matrix (row-vector convention) the rest of
+// this shader multiplies by.
+row_major float4x4 decode_instance_model(InstanceTransform transform) {
+    return transpose(float4x4(
+        transform.world_x,
+        transform.world_y,
+        transform.world_z,
+        float4(0.0f, 0.0f, 0.0f, 1.0f)
+    ));
+}
+
+StructuredBuffer<InstanceTransform> instance_models : register(t0, space0);
 // Indirection layer written by SDL_GPUInstanceCullPass's compute shader
 // (instance_cull.hlsl): maps a compacted 0..num_instances-1 range back to
 // the original instance index in instance_models, so a culled/compacted
@@ -20,6 +51,26 @@ StructuredBuffer<row_major float4x4> instance_models : register(t0, space0);
 // first_instance per sub-draw works where a per-draw uniform push wouldn't.
 StructuredBuffer<uint> visible_instance_indices : register(t1, space0);
 
+#ifdef COMPACT_VERTICES
+// CompactVertex (SDL_GPUVertexFormat.hpp): snorm16 position relative to the
+// renderable's bounds, half-float uv, and octahedral-encoded snorm16 normal
+// (xy) and tangent (zw) - all widened to float by the vertex fetch.
+struct VSInput {
+    float4 position : POSITION;
+    float2 uv : TEXCOORD0;
+    float4 normal_tangent : NORMAL;
+    uint instance_id : SV_InstanceID;
+};
+
+// Inverse of oct_encode in SDL_GPUVertexFormat.cpp.
+float3 oct_decode(float2 encoded) {
+    float3 v = float3(encoded, 1.0f - abs(encoded.x) - abs(encoded.y));
+    const float fold = saturate(-v.z);
+    v.x += v.x >= 0.0f ? -fold : fold;
+    v.y += v.y >= 0.0f ? -fold : fold;
+    return normalize(v);
+}
+#else
 struct VSInput {
     float3 position : POSITION;
     float2 uv : TEXCOORD0;
@@ -27,6 +78,7 @@ struct VSInput {
     float3 tangent : TANGENT;
     uint instance_id : SV_InstanceID;
 };
+#endif
 
 struct VSOutput {
     float2 uv : TEXCOORD0;
@@ -39,16 +91,29 @@ struct VSOutput {
 VSOutput main(VSInput input) {
     const uint original_instance_index =
         visible_instance_indices[input.instance_id];
-    const row_major float4x4 instance_model = instance_models[original_instance_index];
+    const row_major float4x4 instance_model =
+        decode_instance_model(instance_models[original_instance_index]);
     const float3x3 normal_matrix = (float3x3)instance_model;
 
-    const float4 world_position = mul(float4(input.position, 1.0f), instance_model);
+#ifdef COMPACT_VERTICES
+    const float3 position =
+        position_offset.xyz + position_scale.xyz * input.position.xyz;
+    const float3 normal = oct_decode(input.normal_tangent.xy);
+    const float3 tangent = oct_decode(input.normal_tangent.zw);
+#else
+    const float3 position =
+        position_offset.xyz + position_scale.xyz * input.position;
+    const float3 normal = input.normal;
+    const float3 tangent = input.tangent;
+#endif
+
+    const float4 world_position = mul(float4(position, 1.0f), instance_model);
 
     VSOutput output;
     output.position = mul(world_position, view_proj);
     output.world_position = world_position.xyz;
-    output.world_normal = mul(input.normal, normal_matrix);
-    output.world_tangent = mul(input.tangent, normal_matrix);
+    output.world_normal = mul(normal, normal_matrix);
+    output.world_tangent = mul(tangent, normal_matrix);
     output.uv = input.uv;
     return output;
 }
@@ -14,13 +14,43 @@
 // instead of branching the draw call itself.
 
 #define MESHLET_MAX_TRIANGLES 64
+#ifdef COMPACT_VERTICES
+// sizeof(CompactVertex) / 4 - see SDL_GPUVertexFormat.hpp.
+#define VERTEX_STRIDE_WORDS 5
+#else
 #define VERTEX_STRIDE_FLOATS 11
+#endif
 
 cbuffer UBO : register(b0, space1) {
     row_major float4x4 view_proj;
 };
 
-StructuredBuffer<row_major float4x4> instance_models : register(t0, space0);
+// Same per-renderable push as pbr_vert.hlsl's VertexDequantization.
+cbuffer VertexDequantization : register(b1, space1) {
+    float4 position_offset;
+    float4 position_scale;
+};
+
+// Mirrors struct InstanceTransform (InstanceTransform.hpp) - see
+// pbr_vert.hlsl.
+struct InstanceTransform {
+    float4 world_x;
+    float4 world_y;
+    float4 world_z;
+};
+
+// Rebuilds the row_major model matrix (row-vector convention) the rest of
+// this shader multiplies by.
+row_major float4x4 decode_instance_model(InstanceTransform transform) {
+    return transpose(float4x4(
+        transform.world_x,
+        transform.world_y,
+        transform.world_z,
+        float4(0.0f, 0.0f, 0.0f, 1.0f)
+    ));
+}
+
+StructuredBuffer<InstanceTransform> instance_models : register(t0, space0);
 // x = original instance index (into instance_models), y = meshlet index
 // (into meshlet_metadata) - written by meshlet_cull.hlsl. Indexed directly
 // by input.instance_id, same first_instance/SV_InstanceID indirection trick
@@ -46,16 +76,44 @@ StructuredBuffer<GpuMeshletMetadata> meshlet_metadata : register(t2, space0);
 // Per (meshlet, local vertex slot 0..vertex_count-1): absolute index into
 // combined_vertices - see SDL_GPUMesh.cpp's build_meshlets.
 StructuredBuffer<uint> meshlet_vertices : register(t3, space0);
-// Per (meshlet, local triangle, vertex-in-triangle), flattened: local vertex
-// slot 0..vertex_count-1 - see SDL_GPUMesh.cpp's build_meshlets.
+// One word per (meshlet, local triangle): the triangle's three local vertex
+// slots (0..vertex_count-1) in bits 0-7, 8-15 and 16-23 - see
+// SDL_GPUMesh.hpp's pack_meshlet_triangle. triangle_offset counts words.
 StructuredBuffer<uint> meshlet_triangles : register(t4, space0);
 // The renderable's shared interleaved vertex data (position3/uv2/normal3/
 // tangent3 = 11 floats/vertex), bound as a plain StructuredBuffer<float>
 // instead of a struct - deliberately sidesteps StructuredBuffer struct-
 // layout ambiguity entirely (see SDL_GPUInstanceCullPass.cpp's
 // SubmeshCullMetadata comment for the two bugs that motivate this) since a
-// tightly-packed scalar buffer has no stride/padding to get wrong.
+// tightly-packed scalar buffer has no stride/padding to get wrong. The
+// COMPACT_VERTICES layout is read the same way, as 5 raw words per
+// CompactVertex unpacked by hand below.
+#ifdef COMPACT_VERTICES
+StructuredBuffer<uint> combined_vertices : register(t5, space0);
+
+float snorm16_low(uint word) {
+    return max(float(int(word << 16) >> 16) / 32767.0f, -1.0f);
+}
+
+float snorm16_high(uint word) {
+    return max(float(int(word) >> 16) / 32767.0f, -1.0f);
+}
+
+float2 snorm16x2(uint word) {
+    return float2(snorm16_low(word), snorm16_high(word));
+}
+
+// Inverse of oct_encode in SDL_GPUVertexFormat.cpp - same as pbr_vert.hlsl.
+float3 oct_decode(float2 encoded) {
+    float3 v = float3(encoded, 1.0f - abs(encoded.x) - abs(encoded.y));
+    const float fold = saturate(-v.z);
+    v.x += v.x >= 0.0f ? -fold : fold;
+    v.y += v.y >= 0.0f ? -fold : fold;
+    return normalize(v);
+}
+#else
 StructuredBuffer<float> combined_vertices : register(t5, space0);
+#endif
 
 struct VSInput {
     uint vertex_id : SV_VertexID;
@@ -88,15 +146,27 @@ VSOutput main(VSInput input) {
         min(triangle_in_meshlet, meshlet.triangle_count - 1);
     uint effective_vertex_in_triangle = is_padding ? 0 : vertex_in_triangle;
 
-    uint local_vertex_slot = meshlet_triangles[
-        meshlet.triangle_offset + (clamped_triangle * 3) +
-        effective_vertex_in_triangle
-    ];
+    uint packed_triangle =
+        meshlet_triangles[meshlet.triangle_offset + clamped_triangle];
+    uint local_vertex_slot =
+        (packed_triangle >> (8 * effective_vertex_in_triangle)) & 0xFF;
     uint absolute_vertex_index =
         meshlet_vertices[meshlet.vertex_offset + local_vertex_slot];
 
+#ifdef COMPACT_VERTICES
+    uint vertex_base = absolute_vertex_index * VERTEX_STRIDE_WORDS;
+    uint position_xy = combined_vertices[vertex_base + 0];
+    uint position_zw = combined_vertices[vertex_base + 1];
+    uint uv_bits = combined_vertices[vertex_base + 2];
+    float3 position = position_offset.xyz + position_scale.xyz * float3(
+        snorm16x2(position_xy), snorm16_low(position_zw)
+    );
+    float2 uv = f16tof32(uint2(uv_bits & 0xFFFF, uv_bits >> 16));
+    float3 normal = oct_decode(snorm16x2(combined_vertices[vertex_base + 3]));
+    float3 tangent = oct_decode(snorm16x2(combined_vertices[vertex_base + 4]));
+#else
     uint vertex_base = absolute_vertex_index * VERTEX_STRIDE_FLOATS;
-    float3 position = float3(
+    float3 position = position_offset.xyz + position_scale.xyz * float3(
         combined_vertices[vertex_base + 0],
         combined_vertices[vertex_base + 1],
         combined_vertices[vertex_base + 2]
@@ -114,8 +184,10 @@ VSOutput main(VSInput input) {
         combined_vertices[vertex_base + 9],
         combined_vertices[vertex_base + 10]
     );
+#endif
 
-    row_major float4x4 instance_model = instance_models[original_instance_index];
+    row_major float4x4 instance_model =
+        decode_instance_model(instance_models[original_instance_index]);
     float3x3 normal_matrix = (float3x3)instance_model;
 
     float4 world_position = mul(float4(position, 1.0f), instance_model);
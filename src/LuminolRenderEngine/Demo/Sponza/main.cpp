@@ -95,6 +95,29 @@ auto handle_debug_present_mode_key(
     i_key_was_down = i_key_down;
 }
 
+// Debug-only: 'l' toggles between low-latency (1 frame in flight) and
+// throughput (3 frames in flight) pacing - see
+// SDL_GPURenderer::set_frames_in_flight. Watch "gpu_wait"/"cpu_wait" in the
+// [Perf] log to see which side each mode leaves waiting.
+auto handle_frames_in_flight_key(
+    RenderEngine& engine, bool& low_latency, bool& l_key_was_down
+) -> void {
+    const auto l_key_down = engine.get_window().is_key_event('l', KeyEvent::Press);
+    if (l_key_down && !l_key_was_down) {
+        low_latency = !low_latency;
+        engine.get_renderer().set_frames_in_flight(
+            low_latency
+                ? Graphics::SDL_GPU::FramePacer::low_latency_frames_in_flight
+                : Graphics::SDL_GPU::FramePacer::throughput_frames_in_flight
+        );
+        std::printf(
+            "[GpuProfiling] frames in flight: %u\n",
+            engine.get_renderer().get_frames_in_flight()
+        );
+    }
+    l_key_was_down = l_key_down;
+}
+
 }  // namespace
 
 auto main() -> int {
@@ -218,6 +241,9 @@ auto main() -> int {
     auto vsync_disabled = false;
     auto i_key_was_down = false;
 
+    auto low_latency = false;
+    auto l_key_was_down = false;
+
     while (!luminol_engine.get_window().should_close()) {
         const auto current_frame_time_seconds = timer.elapsed_seconds();
         const auto delta_time_seconds =
@@ -238,6 +264,10 @@ auto main() -> int {
             luminol_engine, vsync_disabled, i_key_was_down
         );
 
+        handle_frames_in_flight_key(
+            luminol_engine, low_latency, l_key_was_down
+        );
+
         const auto mouse_delta = luminol_engine.get_window().get_mouse_delta();
         camera.rotate(
             gsl::narrow_cast<float>(mouse_delta.delta_x),
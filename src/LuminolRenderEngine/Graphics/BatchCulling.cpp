@@ -0,0 +1,411 @@
+#include "BatchCulling.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || \
+    defined(_M_IX86)
+#define LUMINOL_BATCH_CULLING_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#else
+#define LUMINOL_BATCH_CULLING_X86 0
+#endif
+
+// GCC/Clang only allow intrinsics above the translation unit's baseline ISA
+// inside functions marked for that ISA; MSVC allows them anywhere.
+#if defined(__GNUC__) || defined(__clang__)
+#define LUMINOL_TARGET_SSE4_2 __attribute__((target("sse4.2")))
+#define LUMINOL_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define LUMINOL_TARGET_SSE4_2
+#define LUMINOL_TARGET_AVX2
+#endif
+
+namespace {
+
+using namespace Luminol::Graphics;
+using namespace Luminol::Maths;
+
+auto detect_simd_level() -> SimdLevel {
+#if LUMINOL_BATCH_CULLING_X86
+#if defined(_MSC_VER)
+    constexpr auto sse4_2_bit = 1 << 20;
+    constexpr auto osxsave_bit = 1 << 27;
+    constexpr auto avx_bit = 1 << 28;
+    constexpr auto avx2_bit = 1 << 5;
+    // XMM and YMM state, both of which the OS must save for AVX to be usable.
+    constexpr auto xcr0_avx_state = 0x6ULL;
+
+    auto registers = std::array<int, 4>{};
+    __cpuid(registers.data(), 0);
+    const auto max_leaf = registers[0];
+
+    __cpuid(registers.data(), 1);
+    const auto feature_ecx = registers[2];
+    const auto has_sse4_2 = (feature_ecx & sse4_2_bit) != 0;
+    const auto has_os_avx = (feature_ecx & osxsave_bit) != 0 &&
+        (feature_ecx & avx_bit) != 0 &&
+        (_xgetbv(0) & xcr0_avx_state) == xcr0_avx_state;
+
+    auto has_avx2 = false;
+    if (max_leaf >= 7 && has_os_avx) {
+        __cpuidex(registers.data(), 7, 0);
+        has_avx2 = (registers[1] & avx2_bit) != 0;
+    }
+#else
+    __builtin_cpu_init();
+    const auto has_sse4_2 = __builtin_cpu_supports("sse4.2") != 0;
+    const auto has_avx2 = __builtin_cpu_supports("avx2") != 0;
+#endif
+
+    if (has_avx2) {
+        return SimdLevel::AVX2;
+    }
+    if (has_sse4_2) {
+        return SimdLevel::SSE4_2;
+    }
+#endif
+
+    return SimdLevel::Scalar;
+}
+
+auto resolve_simd_level(SimdLevel requested) -> SimdLevel {
+    return std::min(requested, get_supported_simd_level());
+}
+
+struct LocalBoundsCenterExtent {
+    Vector3f center;
+    Vector3f half_extent;
+};
+
+auto to_center_extent(const BoundingBox& bounds) -> LocalBoundsCenterExtent {
+    return LocalBoundsCenterExtent{
+        .center =
+            Vector3f{
+                (bounds.min.x() + bounds.max.x()) * 0.5F,
+                (bounds.min.y() + bounds.max.y()) * 0.5F,
+                (bounds.min.z() + bounds.max.z()) * 0.5F,
+            },
+        .half_extent =
+            Vector3f{
+                (bounds.max.x() - bounds.min.x()) * 0.5F,
+                (bounds.max.y() - bounds.min.y()) * 0.5F,
+                (bounds.max.z() - bounds.min.z()) * 0.5F,
+            },
+    };
+}
+
+auto transform_point(const Matrix4x4f& matrix, const Vector3f& point)
+    -> Vector3f {
+    return Vector3f{
+        (point.x() * matrix[0][0]) + (point.y() * matrix[1][0]) +
+            (point.z() * matrix[2][0]) + matrix[3][0],
+        (point.x() * matrix[0][1]) + (point.y() * matrix[1][1]) +
+            (point.z() * matrix[2][1]) + matrix[3][1],
+        (point.x() * matrix[0][2]) + (point.y() * matrix[1][2]) +
+            (point.z() * matrix[2][2]) + matrix[3][2],
+    };
+}
+
+auto transform_extent(const Matrix4x4f& matrix, const Vector3f& extent)
+    -> Vector3f {
+    return Vector3f{
+        (extent.x() * std::abs(matrix[0][0])) +
+            (extent.y() * std::abs(matrix[1][0])) +
+            (extent.z() * std::abs(matrix[2][0])),
+        (extent.x() * std::abs(matrix[0][1])) +
+            (extent.y() * std::abs(matrix[1][1])) +
+            (extent.z() * std::abs(matrix[2][1])),
+        (extent.x() * std::abs(matrix[0][2])) +
+            (extent.y() * std::abs(matrix[1][2])) +
+            (extent.z() * std::abs(matrix[2][2])),
+    };
+}
+
+auto transform_center_extent(
+    const Matrix4x4f& matrix, const LocalBoundsCenterExtent& local
+) -> BoundingBox {
+    const auto world_center = transform_point(matrix, local.center);
+    const auto world_extent = transform_extent(matrix, local.half_extent);
+    return BoundingBox{
+        .min =
+            Vector3f{
+                world_center.x() - world_extent.x(),
+                world_center.y() - world_extent.y(),
+                world_center.z() - world_extent.z(),
+            },
+        .max =
+            Vector3f{
+                world_center.x() + world_extent.x(),
+                world_center.y() + world_extent.y(),
+                world_center.z() + world_extent.z(),
+            },
+    };
+}
+
+auto merge_bounds(BoundingBox& accumulated, const BoundingBox& bounds)
+    -> void {
+    accumulated.min = Vector3f{
+        std::min(accumulated.min.x(), bounds.min.x()),
+        std::min(accumulated.min.y(), bounds.min.y()),
+        std::min(accumulated.min.z(), bounds.min.z()),
+    };
+    accumulated.max = Vector3f{
+        std::max(accumulated.max.x(), bounds.max.x()),
+        std::max(accumulated.max.y(), bounds.max.y()),
+        std::max(accumulated.max.z(), bounds.max.z()),
+    };
+}
+
+#if LUMINOL_BATCH_CULLING_X86
+
+struct LocalBoundsSSE {
+    __m128 center_x;
+    __m128 center_y;
+    __m128 center_z;
+    __m128 extent_x;
+    __m128 extent_y;
+    __m128 extent_z;
+};
+
+struct LocalBoundsAVX2 {
+    __m256 center_x;
+    __m256 center_y;
+    __m256 center_z;
+    __m256 extent_x;
+    __m256 extent_y;
+    __m256 extent_z;
+};
+
+LUMINOL_TARGET_SSE4_2 auto make_local_bounds_sse(
+    const LocalBoundsCenterExtent& local
+) -> LocalBoundsSSE {
+    return LocalBoundsSSE{
+        .center_x = _mm_set1_ps(local.center.x()),
+        .center_y = _mm_set1_ps(local.center.y()),
+        .center_z = _mm_set1_ps(local.center.z()),
+        .extent_x = _mm_set1_ps(local.half_extent.x()),
+        .extent_y = _mm_set1_ps(local.half_extent.y()),
+        .extent_z = _mm_set1_ps(local.half_extent.z()),
+    };
+}
+
+LUMINOL_TARGET_AVX2 auto make_local_bounds_avx2(
+    const LocalBoundsCenterExtent& local
+) -> LocalBoundsAVX2 {
+    return LocalBoundsAVX2{
+        .center_x = _mm256_set1_ps(local.center.x()),
+        .center_y = _mm256_set1_ps(local.center.y()),
+        .center_z = _mm256_set1_ps(local.center.z()),
+        .extent_x = _mm256_set1_ps(local.half_extent.x()),
+        .extent_y = _mm256_set1_ps(local.half_extent.y()),
+        .extent_z = _mm256_set1_ps(local.half_extent.z()),
+    };
+}
+
+// One matrix per call: each matrix row is already an (x, y, z, w) vector, so
+// lanes 0-2 hold the world min/max x/y/z (lane 3 is unused).
+LUMINOL_TARGET_SSE4_2 auto transform_bounds_sse(
+    const Matrix4x4f& matrix,
+    const LocalBoundsSSE& local,
+    __m128& out_min,
+    __m128& out_max
+) -> void {
+    const auto sign_mask = _mm_set1_ps(-0.0F);
+    const auto row0 = _mm_loadu_ps(&matrix[0][0]);
+    const auto row1 = _mm_loadu_ps(&matrix[1][0]);
+    const auto row2 = _mm_loadu_ps(&matrix[2][0]);
+    const auto row3 = _mm_loadu_ps(&matrix[3][0]);
+
+    const auto center = _mm_add_ps(
+        _mm_add_ps(
+            _mm_add_ps(
+                _mm_mul_ps(local.center_x, row0),
+                _mm_mul_ps(local.center_y, row1)
+            ),
+            _mm_mul_ps(local.center_z, row2)
+        ),
+        row3
+    );
+    const auto extent = _mm_add_ps(
+        _mm_add_ps(
+            _mm_mul_ps(local.extent_x, _mm_andnot_ps(sign_mask, row0)),
+            _mm_mul_ps(local.extent_y, _mm_andnot_ps(sign_mask, row1))
+        ),
+        _mm_mul_ps(local.extent_z, _mm_andnot_ps(sign_mask, row2))
+    );
+
+    out_min = _mm_sub_ps(center, extent);
+    out_max = _mm_add_ps(center, extent);
+}
+
+LUMINOL_TARGET_AVX2 auto load_row_pair(
+    const Matrix4x4f& low, const Matrix4x4f& high, std::size_t row
+) -> __m256 {
+    return _mm256_insertf128_ps(
+        _mm256_castps128_ps256(_mm_loadu_ps(&low[row][0])),
+        _mm_loadu_ps(&high[row][0]),
+        1
+    );
+}
+
+// Two matrices per call, one per 128-bit half, laid out as in
+// transform_bounds_sse.
+LUMINOL_TARGET_AVX2 auto transform_bounds_pair_avx2(
+    const Matrix4x4f& low,
+    const Matrix4x4f& high,
+    const LocalBoundsAVX2& local,
+    __m256& out_min,
+    __m256& out_max
+) -> void {
+    const auto sign_mask = _mm256_set1_ps(-0.0F);
+    const auto row0 = load_row_pair(low, high, 0);
+    const auto row1 = load_row_pair(low, high, 1);
+    const auto row2 = load_row_pair(low, high, 2);
+    const auto row3 = load_row_pair(low, high, 3);
+
+    const auto center = _mm256_add_ps(
+        _mm256_add_ps(
+            _mm256_add_ps(
+                _mm256_mul_ps(local.center_x, row0),
+                _mm256_mul_ps(local.center_y, row1)
+            ),
+            _mm256_mul_ps(local.center_z, row2)
+        ),
+        row3
+    );
+    const auto extent = _mm256_add_ps(
+        _mm256_add_ps(
+            _mm256_mul_ps(local.extent_x, _mm256_andnot_ps(sign_mask, row0)),
+            _mm256_mul_ps(local.extent_y, _mm256_andnot_ps(sign_mask, row1))
+        ),
+        _mm256_mul_ps(local.extent_z, _mm256_andnot_ps(sign_mask, row2))
+    );
+
+    out_min = _mm256_sub_ps(center, extent);
+    out_max = _mm256_add_ps(center, extent);
+}
+
+LUMINOL_TARGET_SSE4_2 auto transform_bounds_union_sse(
+    gsl::span<const Matrix4x4f> matrices,
+    const LocalBoundsCenterExtent& local
+) -> BoundingBox {
+    const auto local_sse = make_local_bounds_sse(local);
+
+    auto union_min = __m128{};
+    auto union_max = __m128{};
+    transform_bounds_sse(matrices[0], local_sse, union_min, union_max);
+
+    for (auto i = std::size_t{1}; i < matrices.size(); ++i) {
+        auto world_min = __m128{};
+        auto world_max = __m128{};
+        transform_bounds_sse(matrices[i], local_sse, world_min, world_max);
+        union_min = _mm_min_ps(union_min, world_min);
+        union_max = _mm_max_ps(union_max, world_max);
+    }
+
+    alignas(16) auto min_lanes = std::array<float, 4>{};
+    alignas(16) auto max_lanes = std::array<float, 4>{};
+    _mm_store_ps(min_lanes.data(), union_min);
+    _mm_store_ps(max_lanes.data(), union_max);
+    return BoundingBox{
+        .min = Vector3f{min_lanes[0], min_lanes[1], min_lanes[2]},
+        .max = Vector3f{max_lanes[0], max_lanes[1], max_lanes[2]},
+    };
+}
+
+LUMINOL_TARGET_AVX2 auto transform_bounds_union_avx2(
+    gsl::span<const Matrix4x4f> matrices,
+    const LocalBoundsCenterExtent& local
+) -> BoundingBox {
+    const auto local_avx2 = make_local_bounds_avx2(local);
+
+    // An odd count pairs the first matrix with itself, which can't change
+    // the union.
+    const auto first_partner =
+        matrices.size() % 2 == 1 ? std::size_t{0} : std::size_t{1};
+    auto union_min = __m256{};
+    auto union_max = __m256{};
+    transform_bounds_pair_avx2(
+        matrices[0], matrices[first_partner], local_avx2, union_min, union_max
+    );
+
+    for (auto i = first_partner + 1; i < matrices.size(); i += 2) {
+        auto world_min = __m256{};
+        auto world_max = __m256{};
+        transform_bounds_pair_avx2(
+            matrices[i], matrices[i + 1], local_avx2, world_min, world_max
+        );
+        union_min = _mm256_min_ps(union_min, world_min);
+        union_max = _mm256_max_ps(union_max, world_max);
+    }
+
+    const auto merged_min = _mm_min_ps(
+        _mm256_castps256_ps128(union_min), _mm256_extractf128_ps(union_min, 1)
+    );
+    const auto merged_max = _mm_max_ps(
+        _mm256_castps256_ps128(union_max), _mm256_extractf128_ps(union_max, 1)
+    );
+
+    alignas(16) auto min_lanes = std::array<float, 4>{};
+    alignas(16) auto max_lanes = std::array<float, 4>{};
+    _mm_store_ps(min_lanes.data(), merged_min);
+    _mm_store_ps(max_lanes.data(), merged_max);
+    return BoundingBox{
+        .min = Vector3f{min_lanes[0], min_lanes[1], min_lanes[2]},
+        .max = Vector3f{max_lanes[0], max_lanes[1], max_lanes[2]},
+    };
+}
+
+#endif
+
+}  // namespace
+
+namespace Luminol::Graphics {
+
+auto get_supported_simd_level() -> SimdLevel {
+    static const auto level = detect_simd_level();
+    return level;
+}
+
+auto transform_bounds(const Matrix4x4f& matrix, const BoundingBox& local_bounds)
+    -> BoundingBox {
+    return transform_center_extent(matrix, to_center_extent(local_bounds));
+}
+
+auto transform_bounds_union(
+    gsl::span<const Matrix4x4f> matrices,
+    const BoundingBox& local_bounds,
+    SimdLevel level
+) -> BoundingBox {
+    if (matrices.empty()) {
+        return local_bounds;
+    }
+
+    const auto local = to_center_extent(local_bounds);
+
+#if LUMINOL_BATCH_CULLING_X86
+    switch (resolve_simd_level(level)) {
+        case SimdLevel::AVX2:
+            return transform_bounds_union_avx2(matrices, local);
+        case SimdLevel::SSE4_2:
+            return transform_bounds_union_sse(matrices, local);
+        case SimdLevel::Scalar:
+            break;
+    }
+#else
+    static_cast<void>(level);
+#endif
+
+    auto world_bounds = transform_center_extent(matrices[0], local);
+    for (auto i = std::size_t{1}; i < matrices.size(); ++i) {
+        merge_bounds(world_bounds, transform_center_extent(matrices[i], local));
+    }
+    return world_bounds;
+}
+
+}  // namespace Luminol::Graphics
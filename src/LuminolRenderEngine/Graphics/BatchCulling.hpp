@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+
+#include <gsl/gsl>
+#include <LuminolMaths/Matrix.hpp>
+#include <LuminolMaths/Vector.hpp>
+
+#include <LuminolRenderEngine/Graphics/BoundingBox.hpp>
+
+namespace Luminol::Graphics {
+
+// Bounds transforms for instanced draws, with SSE4.2 and AVX2 paths for the
+// many-instance union picked at runtime from what the CPU supports and a
+// scalar fallback everywhere else. Every path produces the same result as
+// merging transform_bounds per matrix - the SIMD paths do the same float
+// operations in the same order, just several lanes at a time.
+enum class SimdLevel : uint8_t {
+    Scalar,
+    SSE4_2,
+    AVX2,
+};
+
+// Highest level the running CPU (and OS) supports. Detected once, on first
+// call.
+[[nodiscard]] auto get_supported_simd_level() -> SimdLevel;
+
+// Exact world-space AABB of local_bounds under an affine matrix (row-vector
+// convention, translation in row 3): the transformed center plus the
+// half-extent through the absolute value of the matrix's 3x3 linear part,
+// rather than transforming all 8 corners.
+[[nodiscard]] auto transform_bounds(
+    const Maths::Matrix4x4f& matrix, const BoundingBox& local_bounds
+) -> BoundingBox;
+
+// Union of transform_bounds(matrix, local_bounds) over every matrix,
+// without storing the per-matrix boxes. local_bounds if matrices is empty.
+// level is there for tests and benchmarks; it is clamped to
+// get_supported_simd_level(), so asking for AVX2 on a CPU without it
+// quietly runs a lower path.
+[[nodiscard]] auto transform_bounds_union(
+    gsl::span<const Maths::Matrix4x4f> matrices,
+    const BoundingBox& local_bounds,
+    SimdLevel level = get_supported_simd_level()
+) -> BoundingBox;
+
+}  // namespace Luminol::Graphics
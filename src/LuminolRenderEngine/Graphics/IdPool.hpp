@@ -13,13 +13,14 @@ public:
         : capacity{capacity} {}
 
     [[nodiscard]] auto allocate() -> std::optional<Id> {
-        if (!this->free_ids.empty()) {
+        if (!this->free_ids.empty() &&
+            this->is_within_capacity(*this->free_ids.begin())) {
             const auto free_id = *this->free_ids.begin();
             this->free_ids.erase(this->free_ids.begin());
             return free_id;
         }
 
-        if (this->capacity.has_value() && this->next_id >= *this->capacity) {
+        if (!this->is_within_capacity(this->next_id)) {
             return std::nullopt;
         }
 
@@ -32,7 +33,21 @@ public:
         }
     }
 
+    // Lowering the capacity below ids already handed out doesn't revoke
+    // them - they're just not handed out again once freed.
+    auto set_capacity(std::optional<Id> new_capacity) -> void {
+        this->capacity = new_capacity;
+    }
+
+    [[nodiscard]] auto get_capacity() const -> std::optional<Id> {
+        return this->capacity;
+    }
+
 private:
+    [[nodiscard]] auto is_within_capacity(Id id) const -> bool {
+        return !this->capacity.has_value() || id < *this->capacity;
+    }
+
     std::optional<Id> capacity;
     std::set<Id> free_ids;
     Id next_id = 0;
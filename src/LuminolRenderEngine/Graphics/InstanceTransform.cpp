@@ -0,0 +1,37 @@
+#include "InstanceTransform.hpp"
+
+namespace Luminol::Graphics {
+
+auto to_instance_transform(const Maths::Matrix4x4f& model_matrix)
+    -> InstanceTransform {
+    const auto& m = model_matrix;
+    return InstanceTransform{
+        .world_x = {m[0][0], m[1][0], m[2][0], m[3][0]},
+        .world_y = {m[0][1], m[1][1], m[2][1], m[3][1]},
+        .world_z = {m[0][2], m[1][2], m[2][2], m[3][2]},
+    };
+}
+
+auto to_model_matrix(const InstanceTransform& instance_transform)
+    -> Maths::Matrix4x4f {
+    const auto& t = instance_transform;
+    auto model_matrix = Maths::Matrix4x4f::identity();
+    for (auto row = std::size_t{0}; row < 4; ++row) {
+        model_matrix[row][0] = t.world_x[row];
+        model_matrix[row][1] = t.world_y[row];
+        model_matrix[row][2] = t.world_z[row];
+    }
+    return model_matrix;
+}
+
+auto to_instance_transforms(
+    gsl::span<const Maths::Matrix4x4f> model_matrices,
+    gsl::span<InstanceTransform> out
+) -> void {
+    Expects(out.size() >= model_matrices.size());
+    for (auto i = std::size_t{0}; i < model_matrices.size(); ++i) {
+        out[i] = to_instance_transform(model_matrices[i]);
+    }
+}
+
+}  // namespace Luminol::Graphics
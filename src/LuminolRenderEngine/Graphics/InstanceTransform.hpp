@@ -0,0 +1,40 @@
+#pragma once
+
+#include <array>
+
+#include <gsl/gsl>
+#include <LuminolMaths/Matrix.hpp>
+
+namespace Luminol::Graphics {
+
+// The per-instance transform as it's stored on the GPU: an affine model
+// matrix without its constant last column (0, 0, 0, 1), transposed so each
+// member is one world-space axis - dot(float4(position, 1), world_x) is the
+// transformed position's x. 48 bytes instead of a Matrix4x4f's 64, and
+// lossless for every transform the renderer draws. Mirrors struct
+// InstanceTransform in the shaders that read instance_models.
+struct InstanceTransform {
+    std::array<float, 4> world_x;
+    std::array<float, 4> world_y;
+    std::array<float, 4> world_z;
+};
+
+static_assert(sizeof(InstanceTransform) == 48);
+
+// model_matrix must be affine (row-vector convention, translation in row 3,
+// last column (0, 0, 0, 1)) - its last column is dropped.
+[[nodiscard]] auto to_instance_transform(const Maths::Matrix4x4f& model_matrix)
+    -> InstanceTransform;
+
+[[nodiscard]] auto to_model_matrix(const InstanceTransform& instance_transform)
+    -> Maths::Matrix4x4f;
+
+// out[i] = to_instance_transform(model_matrices[i]); out must hold at least
+// model_matrices.size() entries. Used to pack straight into mapped staging
+// memory, so the pack is the upload's only copy.
+auto to_instance_transforms(
+    gsl::span<const Maths::Matrix4x4f> model_matrices,
+    gsl::span<InstanceTransform> out
+) -> void;
+
+}  // namespace Luminol::Graphics
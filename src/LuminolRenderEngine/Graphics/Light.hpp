@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
 
 #include <LuminolMaths/Vector.hpp>
@@ -11,18 +12,17 @@ struct DirectionalLight {
     Maths::Vector3f color = {1.0f, 1.0f, 1.0f};
 };
 
-// Raised from 64 now that lighting is Clustered Forward+ (per-cluster light
-// index lists via SDL_GPUClusterPass) rather than a fixed-size cbuffer array
-// in pbr_frag.hlsl, so the cap no longer needs to fit inside a uniform
-// buffer.
-constexpr static auto max_point_lights = 1024u;
+// Default caps on simultaneous point/spot lights - runtime limits, see
+// LightManager::set_capacity. Every per-light buffer, CPU and GPU, only
+// grows as lights are added, so a high cap costs nothing until it's used.
+constexpr static auto default_max_point_lights = 65536u;
+constexpr static auto default_max_spot_lights = 65536u;
 
 struct PointLight {
     Maths::Vector3f position = {0.0f, 0.0f, 0.0f};
     Maths::Vector3f color = {1.0f, 1.0f, 1.0f};
 };
 
-constexpr static auto max_spot_lights = 1024u;
 constexpr static auto default_cut_off = 0.0f;
 constexpr static auto default_outer_cut_off = 0.0f;
 
@@ -41,10 +41,10 @@ struct AlignedDirectionalLight {
         Maths::Vector4f{1.0f, 1.0f, 1.0f, 1.0f};  // 16 bytes
 };
 
-// Point/spot lights are far too numerous (up to max_point_lights /
-// max_spot_lights) to each get a full shadow map, so only the
-// highest-scoring (nearest/brightest, in-frustum) lights cast shadows each
-// frame. See LightManager::update_shadow_casters (selection/hysteresis) and
+// Point/spot lights are far too numerous (up to tens of thousands) to each
+// get a full shadow map, so only the highest-scoring (nearest/brightest,
+// in-frustum) lights cast shadows each frame. See
+// LightManager::update_shadow_casters (selection/hysteresis) and
 // SDL_GPUPointSpotShadowPass (rendering into the shadow slots these produce).
 constexpr static auto max_shadow_casting_point_lights = 16u;
 constexpr static auto max_shadow_casting_spot_lights = 32u;
@@ -81,10 +81,21 @@ struct Light {
     uint32_t point_light_count = 0;                         // 4 bytes
     uint32_t spot_light_count = 0;                          // 4 bytes
     Maths::Vector2f padding = Maths::Vector2f{0.0f, 0.0f};  // 8 bytes
-    std::vector<AlignedPointLight> point_lights =
-        std::vector<AlignedPointLight>{max_point_lights};
-    std::vector<AlignedSpotLight> spot_lights =
-        std::vector<AlignedSpotLight>{max_spot_lights};
+    // At least point_light_count/spot_light_count long - LightManager grows
+    // them as lights are added, and never shrinks them.
+    std::vector<AlignedPointLight> point_lights;
+    std::vector<AlignedSpotLight> spot_lights;
+    // Indices into point_lights/spot_lights that changed since the last
+    // LightManager::clear_changes(), so only those are uploaded (see
+    // SDL_GPUClusterPass::cull_lights). Unsorted and duplicate-free, and
+    // may hold indices at or past the count once lights are removed.
+    std::vector<uint32_t> changed_point_lights;
+    std::vector<uint32_t> changed_spot_lights;
+    // Indices into point_lights/spot_lights of the lights holding a shadow
+    // slot (see LightManager::update_shadow_casters), in slot order - so
+    // shadow rendering never walks every light to find them.
+    std::vector<uint32_t> shadow_casting_point_lights;
+    std::vector<uint32_t> shadow_casting_spot_lights;
 };
 
 constexpr static auto alignment = 16u;
@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstddef>
 #include <span>
 #include <vector>
 
@@ -16,9 +17,8 @@ using namespace Luminol::Graphics;
 using namespace Luminol::Maths;
 
 // Must match the light_cull_radius cutoff in pbr_frag.hlsl /
-// cluster_light_count.hlsl / cluster_light_compact.hlsl exactly, so a
-// shadow-caster's frustum test is consistent with the sphere used to cull
-// its shading contribution to zero.
+// cluster_light_transform.hlsl exactly, so a shadow-caster's frustum test is
+// consistent with the sphere used to cull its shading contribution to zero.
 auto light_cull_radius(const Vector3f& color) -> float {
     constexpr auto cutoff = 1.0f / 16.0f;
     const auto intensity = std::max({color.x(), color.y(), color.z()});
@@ -26,79 +26,57 @@ auto light_cull_radius(const Vector3f& color) -> float {
 }
 
 using Luminol::Graphics::extract_frustum_planes;
-using Luminol::Graphics::sphere_in_frustum;
-
-struct ShadowCandidate {
-    LightManager::LightId id;
-    float score;
-};
-
-// Re-ranks the active lights in `lights` by an in-frustum,
-// nearest/brightest-first score, then updates current_slots so at most
-// max_slots lights hold a slot. A light already holding a slot keeps it as
-// long as it's still within a soft margin of the cutoff rank (not just the
-// strict top max_slots), which stops lights that hover right at the boundary
-// from popping their shadow in and out every frame; it can never displace a
-// strictly higher-ranked light though, so the physical slot count is always
-// respected.
-template <typename LightT>
+
+// Picks the in-frustum, nearest/brightest-first lights from light_index,
+// then updates current_slots (and slot_owners, the light holding each slot)
+// so at most max_slots lights hold a slot. A light already holding a slot
+// keeps it as long as it's still within a soft margin of the cutoff rank
+// (not just the strict top max_slots), which stops lights that hover right
+// at the boundary from popping their shadow in and out every frame; it can
+// never displace a strictly higher-ranked light though, so the physical
+// slot count is always respected.
+//
+// Only the top soft-margin lights are ranked, by
+// LightSpatialIndex::select_highest_scoring, and only slot holders old and
+// new are revisited, so nothing here is linear in the light count. Works in
+// scratch, which holds nothing between calls.
 auto update_shadow_slot_assignments(
-    std::span<const LightT> lights,
-    std::span<const std::uint8_t> active,
+    const LightSpatialIndex& light_index,
     std::span<uint32_t> current_slots,
+    std::span<LightManager::LightId> slot_owners,
     const std::array<Vector4f, 6>& frustum_planes,
     const Vector3f& camera_position,
-    uint32_t max_slots
+    uint32_t max_slots,
+    LightManager::ShadowSelectionScratch& scratch
 ) -> void {
-    auto candidates = std::vector<ShadowCandidate>{};
-    candidates.reserve(lights.size());
-
-    for (auto id = 0u; id < lights.size(); ++id) {
-        if (active[id] == 0) {
-            continue;
-        }
-
-        const auto& light = lights[id];
-        const auto radius = light_cull_radius(light.color);
-        if (!sphere_in_frustum(frustum_planes, light.position, radius)) {
-            continue;
-        }
-
-        const auto to_light = light.position - camera_position;
-        const auto distance_squared = to_light.dot(to_light);
-        const auto intensity =
-            std::max({light.color.x(), light.color.y(), light.color.z()});
-        const auto score = intensity / std::max(distance_squared, 0.01f);
-
-        candidates.push_back(ShadowCandidate{.id = id, .score = score});
-    }
-
-    std::ranges::sort(candidates, [](const auto& lhs, const auto& rhs) {
-        return lhs.score > rhs.score;
-    });
-
-    const auto strict_count =
-        std::min(candidates.size(), static_cast<size_t>(max_slots));
     const auto soft_limit = static_cast<size_t>(
         std::ceil(static_cast<float>(max_slots) * 1.25f)
     );
-    const auto soft_count = std::min(candidates.size(), soft_limit);
-
-    auto new_slots = std::vector<uint32_t>(
-        current_slots.size(), LightManager::no_shadow_slot
+    auto& candidates = scratch.candidates;
+    light_index.select_highest_scoring(
+        frustum_planes, camera_position, soft_limit, candidates,
+        scratch.index_scratch
     );
-    auto used_slots = std::vector<bool>(max_slots, false);
+
+    const auto strict_count =
+        std::min(candidates.size(), static_cast<size_t>(max_slots));
+
+    auto& new_owners = scratch.new_owners;
+    new_owners.assign(max_slots, LightManager::no_light);
+    auto& used_slots = scratch.used_slots;
+    used_slots.assign(max_slots, 0);
 
     // Strict winners: always get a slot, preferring to keep whichever slot
     // they already held.
-    auto unassigned_winners = std::vector<LightManager::LightId>{};
+    auto& unassigned_winners = scratch.unassigned_winners;
+    unassigned_winners.clear();
     for (size_t i = 0; i < strict_count; ++i) {
         const auto id = candidates[i].id;
         const auto existing = current_slots[id];
         if (existing != LightManager::no_shadow_slot &&
-            existing < max_slots && !used_slots[existing]) {
-            new_slots[id] = existing;
-            used_slots[existing] = true;
+            existing < max_slots && used_slots[existing] == 0) {
+            new_owners[existing] = id;
+            used_slots[existing] = 1;
         } else {
             unassigned_winners.push_back(id);
         }
@@ -106,7 +84,7 @@ auto update_shadow_slot_assignments(
 
     auto next_free_slot = [&used_slots, max_slots]() -> std::optional<uint32_t> {
         for (auto slot = 0u; slot < max_slots; ++slot) {
-            if (!used_slots[slot]) {
+            if (used_slots[slot] == 0) {
                 return slot;
             }
         }
@@ -118,34 +96,222 @@ auto update_shadow_slot_assignments(
         if (!slot.has_value()) {
             break;
         }
-        new_slots[id] = *slot;
-        used_slots[*slot] = true;
+        new_owners[*slot] = id;
+        used_slots[*slot] = 1;
     }
 
     // Boundary lights (ranked between the strict cap and the soft margin):
     // keep their previous slot if it's still free, but never take a slot
     // away from a strict winner.
-    for (size_t i = strict_count; i < soft_count; ++i) {
+    for (size_t i = strict_count; i < candidates.size(); ++i) {
         const auto id = candidates[i].id;
         const auto existing = current_slots[id];
         if (existing != LightManager::no_shadow_slot &&
-            existing < max_slots && !used_slots[existing]) {
-            new_slots[id] = existing;
-            used_slots[existing] = true;
+            existing < max_slots && used_slots[existing] == 0) {
+            new_owners[existing] = id;
+            used_slots[existing] = 1;
+        }
+    }
+
+    // A listed owner whose slot no longer matches lost it since (removed,
+    // or dropped by sync_lights_from), and is already no_shadow_slot.
+    auto& changed_ids = scratch.changed_ids;
+    changed_ids.clear();
+    for (auto slot = 0u; slot < max_slots; ++slot) {
+        const auto old_owner = slot_owners[slot];
+        const auto new_owner = new_owners[slot];
+        slot_owners[slot] = new_owner;
+
+        if (old_owner != LightManager::no_light && old_owner != new_owner &&
+            current_slots[old_owner] == slot) {
+            current_slots[old_owner] = LightManager::no_shadow_slot;
+            changed_ids.push_back(old_owner);
+        }
+        if (new_owner != LightManager::no_light &&
+            current_slots[new_owner] != slot) {
+            current_slots[new_owner] = slot;
+            changed_ids.push_back(new_owner);
+        }
+    }
+}
+
+// Rebuilds shadow_casters as the packed index of every light still holding
+// the slot slot_owners lists it for, forgetting owners that lost theirs.
+auto collect_shadow_casters(
+    std::span<LightManager::LightId> slot_owners,
+    std::span<const uint32_t> shadow_slots,
+    std::span<const uint32_t> packed_indices,
+    std::vector<uint32_t>& shadow_casters
+) -> void {
+    shadow_casters.clear();
+    for (auto slot = 0u; slot < slot_owners.size(); ++slot) {
+        const auto id = slot_owners[slot];
+        if (id == LightManager::no_light) {
+            continue;
+        }
+        if (gsl::at(shadow_slots, id) != slot) {
+            slot_owners[slot] = LightManager::no_light;
+            continue;
         }
+        shadow_casters.push_back(gsl::at(packed_indices, id));
+    }
+}
+
+auto make_indexed_light(const PointLight& point_light) -> IndexedLight {
+    return IndexedLight{
+        .position = point_light.position,
+        .radius = light_cull_radius(point_light.color),
+        .intensity = std::max(
+            {point_light.color.x(), point_light.color.y(),
+             point_light.color.z()}
+        ),
+    };
+}
+
+auto make_indexed_light(const SpotLight& spot_light) -> IndexedLight {
+    return IndexedLight{
+        .position = spot_light.position,
+        .radius = light_cull_radius(spot_light.color),
+        .intensity = std::max(
+            {spot_light.color.x(), spot_light.color.y(), spot_light.color.z()}
+        ),
+    };
+}
+
+auto get_shadow_slot_value(uint32_t shadow_slot) -> float {
+    return shadow_slot != LightManager::no_shadow_slot
+        ? static_cast<float>(shadow_slot)
+        : -1.0f;
+}
+
+auto pack_point_light(const PointLight& point_light, uint32_t shadow_slot)
+    -> AlignedPointLight {
+    return AlignedPointLight{
+        .position =
+            Vector4f{
+                point_light.position.x(),
+                point_light.position.y(),
+                point_light.position.z(),
+                1.0f,
+            },
+        .color =
+            Vector4f{
+                point_light.color.x(),
+                point_light.color.y(),
+                point_light.color.z(),
+                1.0f,
+            },
+        .shadow_data =
+            Vector4f{get_shadow_slot_value(shadow_slot), 0.0f, 0.0f, 0.0f},
+    };
+}
+
+auto pack_spot_light(const SpotLight& spot_light, uint32_t shadow_slot)
+    -> AlignedSpotLight {
+    return AlignedSpotLight{
+        .position =
+            Vector4f{
+                spot_light.position.x(),
+                spot_light.position.y(),
+                spot_light.position.z(),
+                1.0f,
+            },
+        .direction =
+            Vector4f{
+                spot_light.direction.x(),
+                spot_light.direction.y(),
+                spot_light.direction.z(),
+                0.0f,
+            },
+        .color =
+            Vector3f{
+                spot_light.color.x(),
+                spot_light.color.y(),
+                spot_light.color.z(),
+            },
+        .cut_off = spot_light.cut_off,
+        .outer_cut_off = spot_light.outer_cut_off,
+        .shadow_slot = get_shadow_slot_value(shadow_slot),
+    };
+}
+
+// Lists packed_index in changed, unless its flag says it already is.
+auto mark_changed(
+    std::vector<uint32_t>& changed,
+    std::span<std::uint8_t> changed_flags,
+    uint32_t packed_index
+) -> void {
+    if (gsl::at(changed_flags, packed_index) == 0) {
+        gsl::at(changed_flags, packed_index) = 1;
+        changed.push_back(packed_index);
     }
+}
 
-    std::ranges::copy(new_slots, current_slots.begin());
+// Moves the last of count packed lights into the removed light's
+// packed_index, keeping the packed arrays dense, and returns the new count.
+template <typename AlignedLightT>
+auto swap_remove_packed_light(
+    std::vector<AlignedLightT>& packed_lights,
+    std::span<uint32_t> packed_indices,
+    std::span<LightManager::LightId> packed_ids,
+    std::vector<uint32_t>& changed,
+    std::span<std::uint8_t> changed_flags,
+    uint32_t packed_index,
+    uint32_t count
+) -> uint32_t {
+    const auto last_index = count - 1;
+    if (packed_index != last_index) {
+        const auto moved_id = gsl::at(packed_ids, last_index);
+        gsl::at(packed_ids, packed_index) = moved_id;
+        gsl::at(packed_indices, moved_id) = packed_index;
+        gsl::at(packed_lights, packed_index) =
+            gsl::at(packed_lights, last_index);
+        mark_changed(changed, changed_flags, packed_index);
+    }
+    return last_index;
+}
+
+// False for ids past active's end too - never handed out yet.
+auto is_active(
+    std::span<const std::uint8_t> active, LightManager::LightId light_id
+) -> bool {
+    return light_id < active.size() && active[light_id] != 0;
+}
+
+// Grows values to size, filling with value - resize's geometric growth
+// keeps adding lights one at a time amortized O(1).
+template <typename T>
+auto grow_to(std::vector<T>& values, std::size_t size, const T& value = T{})
+    -> void {
+    if (values.size() < size) {
+        values.resize(size, value);
+    }
 }
 
 }  // namespace
 
 namespace Luminol::Graphics {
 
-LightManager::LightManager()
-    : point_light_ids{max_point_lights}, spot_light_ids{max_spot_lights} {
-    point_shadow_slots.fill(LightManager::no_shadow_slot);
-    spot_shadow_slots.fill(LightManager::no_shadow_slot);
+LightManager::LightManager(const LightCapacity& capacity)
+    : point_light_ids{capacity.max_point_lights},
+      spot_light_ids{capacity.max_spot_lights},
+      point_shadow_slot_owners(
+          max_shadow_casting_point_lights, LightManager::no_light
+      ),
+      spot_shadow_slot_owners(
+          max_shadow_casting_spot_lights, LightManager::no_light
+      ) {}
+
+auto LightManager::set_capacity(const LightCapacity& capacity) -> void {
+    this->point_light_ids.set_capacity(capacity.max_point_lights);
+    this->spot_light_ids.set_capacity(capacity.max_spot_lights);
+}
+
+auto LightManager::get_capacity() const -> LightCapacity {
+    return LightCapacity{
+        .max_point_lights = this->point_light_ids.get_capacity().value_or(0),
+        .max_spot_lights = this->spot_light_ids.get_capacity().value_or(0),
+    };
 }
 
 auto LightManager::update_directional_light(
@@ -176,9 +342,17 @@ auto LightManager::add_point_light(const PointLight& point_light)
         return std::nullopt;
     }
 
+    const auto packed_index = this->light_data.point_light_count;
+    grow_point_light_storage(*point_light_id + 1, packed_index + 1);
     gsl::at(this->point_lights, *point_light_id) = point_light;
     gsl::at(this->point_light_active, *point_light_id) = 1;
+    gsl::at(this->point_light_packed_indices, *point_light_id) = packed_index;
+    gsl::at(this->packed_point_light_ids, packed_index) = *point_light_id;
     ++this->light_data.point_light_count;
+    repack_point_light(*point_light_id);
+    this->point_light_index.insert(
+        *point_light_id, make_indexed_light(point_light)
+    );
 
     return point_light_id;
 }
@@ -186,23 +360,38 @@ auto LightManager::add_point_light(const PointLight& point_light)
 auto LightManager::update_point_light(
     LightId point_light_id, const PointLight& point_light
 ) -> void {
-    if (gsl::at(this->point_light_active, point_light_id) == 0) {
+    if (!is_active(this->point_light_active, point_light_id)) {
         return;
     }
 
     gsl::at(this->point_lights, point_light_id) = point_light;
+    repack_point_light(point_light_id);
+    this->point_light_index.insert(
+        point_light_id, make_indexed_light(point_light)
+    );
 }
 
 auto LightManager::remove_point_light(LightId point_light_id) -> void {
-    if (gsl::at(this->point_light_active, point_light_id) == 0) {
+    if (!is_active(this->point_light_active, point_light_id)) {
         return;
     }
 
+    this->light_data.point_light_count = swap_remove_packed_light(
+        this->light_data.point_lights, this->point_light_packed_indices,
+        this->packed_point_light_ids, this->light_data.changed_point_lights,
+        this->point_light_changed,
+        gsl::at(this->point_light_packed_indices, point_light_id),
+        this->light_data.point_light_count
+    );
     this->point_light_ids.free(point_light_id);
     gsl::at(this->point_light_active, point_light_id) = 0;
     gsl::at(this->point_shadow_slots, point_light_id) =
         LightManager::no_shadow_slot;
-    --this->light_data.point_light_count;
+    this->point_light_index.remove(point_light_id);
+    this->removed_point_light_ids.push_back(point_light_id);
+    // The removed light may have held a slot, and the light moved into
+    // its packed index may hold one.
+    collect_point_shadow_casters();
 }
 
 auto LightManager::add_spot_light(const SpotLight& spot_light)
@@ -212,9 +401,17 @@ auto LightManager::add_spot_light(const SpotLight& spot_light)
         return std::nullopt;
     }
 
+    const auto packed_index = this->light_data.spot_light_count;
+    grow_spot_light_storage(*spot_light_id + 1, packed_index + 1);
     gsl::at(this->spot_lights, *spot_light_id) = spot_light;
     gsl::at(this->spot_light_active, *spot_light_id) = 1;
+    gsl::at(this->spot_light_packed_indices, *spot_light_id) = packed_index;
+    gsl::at(this->packed_spot_light_ids, packed_index) = *spot_light_id;
     ++this->light_data.spot_light_count;
+    repack_spot_light(*spot_light_id);
+    this->spot_light_index.insert(
+        *spot_light_id, make_indexed_light(spot_light)
+    );
 
     return spot_light_id;
 }
@@ -222,23 +419,36 @@ auto LightManager::add_spot_light(const SpotLight& spot_light)
 auto LightManager::update_spot_light(
     LightId spot_light_id, const SpotLight& spot_light
 ) -> void {
-    if (gsl::at(this->spot_light_active, spot_light_id) == 0) {
+    if (!is_active(this->spot_light_active, spot_light_id)) {
         return;
     }
 
     gsl::at(this->spot_lights, spot_light_id) = spot_light;
+    repack_spot_light(spot_light_id);
+    this->spot_light_index.insert(
+        spot_light_id, make_indexed_light(spot_light)
+    );
 }
 
 auto LightManager::remove_spot_light(LightId spot_light_id) -> void {
-    if (gsl::at(this->spot_light_active, spot_light_id) == 0) {
+    if (!is_active(this->spot_light_active, spot_light_id)) {
         return;
     }
 
+    this->light_data.spot_light_count = swap_remove_packed_light(
+        this->light_data.spot_lights, this->spot_light_packed_indices,
+        this->packed_spot_light_ids, this->light_data.changed_spot_lights,
+        this->spot_light_changed,
+        gsl::at(this->spot_light_packed_indices, spot_light_id),
+        this->light_data.spot_light_count
+    );
     this->spot_light_ids.free(spot_light_id);
     gsl::at(this->spot_light_active, spot_light_id) = 0;
     gsl::at(this->spot_shadow_slots, spot_light_id) =
         LightManager::no_shadow_slot;
-    --this->light_data.spot_light_count;
+    this->spot_light_index.remove(spot_light_id);
+    this->removed_spot_light_ids.push_back(spot_light_id);
+    collect_spot_shadow_casters();
 }
 
 auto LightManager::update_shadow_casters(
@@ -247,102 +457,200 @@ auto LightManager::update_shadow_casters(
 ) -> void {
     const auto frustum_planes = extract_frustum_planes(view_projection_matrix);
 
-    update_shadow_slot_assignments<PointLight>(
-        this->point_lights, this->point_light_active, this->point_shadow_slots,
-        frustum_planes, camera_position, max_shadow_casting_point_lights
+    update_shadow_slot_assignments(
+        this->point_light_index, this->point_shadow_slots,
+        this->point_shadow_slot_owners, frustum_planes, camera_position,
+        max_shadow_casting_point_lights, this->shadow_selection_scratch
     );
-    update_shadow_slot_assignments<SpotLight>(
-        this->spot_lights, this->spot_light_active, this->spot_shadow_slots,
-        frustum_planes, camera_position, max_shadow_casting_spot_lights
+    for (const auto id : this->shadow_selection_scratch.changed_ids) {
+        repack_point_light(id);
+    }
+    collect_point_shadow_casters();
+
+    update_shadow_slot_assignments(
+        this->spot_light_index, this->spot_shadow_slots,
+        this->spot_shadow_slot_owners, frustum_planes, camera_position,
+        max_shadow_casting_spot_lights, this->shadow_selection_scratch
     );
+    for (const auto id : this->shadow_selection_scratch.changed_ids) {
+        repack_spot_light(id);
+    }
+    collect_spot_shadow_casters();
 }
 
-[[nodiscard]] auto LightManager::get_light_data() -> const Light& {
-    /// NOLINTBEGIN(cppcoreguidelines-pro-bounds-constant-array-index)
-    {
-        size_t array_index = 0;
-        for (auto point_light_id = 0u; point_light_id < this->point_lights.size();
-             ++point_light_id) {
-            if (this->point_light_active[point_light_id] == 0) {
-                continue;
-            }
+auto LightManager::get_point_light_index() const -> const LightSpatialIndex& {
+    return this->point_light_index;
+}
 
-            const auto& point_light = this->point_lights[point_light_id];
-            const auto shadow_slot_value =
-                this->point_shadow_slots[point_light_id];
-            const auto shadow_slot = shadow_slot_value != LightManager::no_shadow_slot
-                ? static_cast<float>(shadow_slot_value)
-                : -1.0f;
-
-            this->light_data.point_lights[array_index] = AlignedPointLight{
-                .position =
-                    Maths::Vector4f{
-                        point_light.position.x(),
-                        point_light.position.y(),
-                        point_light.position.z(),
-                        1.0f,
-                    },
-                .color =
-                    Maths::Vector4f{
-                        point_light.color.x(),
-                        point_light.color.y(),
-                        point_light.color.z(),
-                        1.0f,
-                    },
-                .shadow_data = Maths::Vector4f{shadow_slot, 0.0f, 0.0f, 0.0f},
-            };
-
-            ++array_index;
-        }
+auto LightManager::get_spot_light_index() const -> const LightSpatialIndex& {
+    return this->spot_light_index;
+}
+
+auto LightManager::get_light_data() const -> const Light& {
+    return this->light_data;
+}
+
+auto LightManager::clear_changes() -> void {
+    for (const auto packed_index : this->light_data.changed_point_lights) {
+        gsl::at(this->point_light_changed, packed_index) = 0;
+    }
+    for (const auto packed_index : this->light_data.changed_spot_lights) {
+        gsl::at(this->spot_light_changed, packed_index) = 0;
     }
 
-    {
-        size_t array_index = 0;
-        for (auto spot_light_id = 0u; spot_light_id < this->spot_lights.size();
-             ++spot_light_id) {
-            if (this->spot_light_active[spot_light_id] == 0) {
-                continue;
-            }
+    this->light_data.changed_point_lights.clear();
+    this->light_data.changed_spot_lights.clear();
+    this->removed_point_light_ids.clear();
+    this->removed_spot_light_ids.clear();
+}
+
+auto LightManager::mark_all_lights_changed() -> void {
+    for (auto packed_index = 0u;
+         packed_index < this->light_data.point_light_count;
+         ++packed_index) {
+        mark_changed(
+            this->light_data.changed_point_lights, this->point_light_changed,
+            packed_index
+        );
+    }
+    for (auto packed_index = 0u;
+         packed_index < this->light_data.spot_light_count;
+         ++packed_index) {
+        mark_changed(
+            this->light_data.changed_spot_lights, this->spot_light_changed,
+            packed_index
+        );
+    }
+}
 
-            const auto& spot_light = this->spot_lights[spot_light_id];
-            const auto shadow_slot_value =
-                this->spot_shadow_slots[spot_light_id];
-            const auto shadow_slot = shadow_slot_value != LightManager::no_shadow_slot
-                ? static_cast<float>(shadow_slot_value)
-                : -1.0f;
-
-            this->light_data.spot_lights[array_index] = AlignedSpotLight{
-                .position =
-                    Maths::Vector4f{
-                        spot_light.position.x(),
-                        spot_light.position.y(),
-                        spot_light.position.z(),
-                        1.0f,
-                    },
-                .direction =
-                    Maths::Vector4f{
-                        spot_light.direction.x(),
-                        spot_light.direction.y(),
-                        spot_light.direction.z(),
-                        0.0f,
-                    },
-                .color =
-                    Maths::Vector3f{
-                        spot_light.color.x(),
-                        spot_light.color.y(),
-                        spot_light.color.z(),
-                    },
-                .cut_off = spot_light.cut_off,
-                .outer_cut_off = spot_light.outer_cut_off,
-                .shadow_slot = shadow_slot,
-            };
-
-            ++array_index;
+auto LightManager::sync_lights_from(LightManager& source) -> void {
+    grow_point_light_storage(
+        source.point_lights.size(), source.light_data.point_lights.size()
+    );
+    grow_spot_light_storage(
+        source.spot_lights.size(), source.light_data.spot_lights.size()
+    );
+
+    this->light_data.directional_light = source.light_data.directional_light;
+    this->light_data.point_light_count = source.light_data.point_light_count;
+    this->light_data.spot_light_count = source.light_data.spot_light_count;
+
+    // Removed first: a removed id that was added back since is listed
+    // below again, and shouldn't inherit the old light's shadow slot.
+    for (const auto id : source.removed_point_light_ids) {
+        gsl::at(this->point_light_active, id) =
+            gsl::at(source.point_light_active, id);
+        gsl::at(this->point_shadow_slots, id) = LightManager::no_shadow_slot;
+        this->point_light_index.remove(id);
+    }
+    for (const auto id : source.removed_spot_light_ids) {
+        gsl::at(this->spot_light_active, id) =
+            gsl::at(source.spot_light_active, id);
+        gsl::at(this->spot_shadow_slots, id) = LightManager::no_shadow_slot;
+        this->spot_light_index.remove(id);
+    }
+
+    for (const auto packed_index : source.light_data.changed_point_lights) {
+        if (packed_index >= this->light_data.point_light_count) {
+            continue;
+        }
+        const auto id = gsl::at(source.packed_point_light_ids, packed_index);
+        gsl::at(this->packed_point_light_ids, packed_index) = id;
+        gsl::at(this->point_light_packed_indices, id) = packed_index;
+        gsl::at(this->point_lights, id) = gsl::at(source.point_lights, id);
+        gsl::at(this->point_light_active, id) = 1;
+        repack_point_light(id);
+        this->point_light_index.insert(
+            id, make_indexed_light(gsl::at(this->point_lights, id))
+        );
+    }
+    for (const auto packed_index : source.light_data.changed_spot_lights) {
+        if (packed_index >= this->light_data.spot_light_count) {
+            continue;
         }
+        const auto id = gsl::at(source.packed_spot_light_ids, packed_index);
+        gsl::at(this->packed_spot_light_ids, packed_index) = id;
+        gsl::at(this->spot_light_packed_indices, id) = packed_index;
+        gsl::at(this->spot_lights, id) = gsl::at(source.spot_lights, id);
+        gsl::at(this->spot_light_active, id) = 1;
+        repack_spot_light(id);
+        this->spot_light_index.insert(
+            id, make_indexed_light(gsl::at(this->spot_lights, id))
+        );
     }
-    /// NOLINTEND(cppcoreguidelines-pro-bounds-constant-array-index)
 
-    return this->light_data;
+    collect_point_shadow_casters();
+    collect_spot_shadow_casters();
+
+    source.clear_changes();
+}
+
+auto LightManager::grow_point_light_storage(
+    std::size_t id_count, std::size_t packed_count
+) -> void {
+    grow_to(this->point_lights, id_count);
+    grow_to(this->point_light_active, id_count);
+    grow_to(this->point_shadow_slots, id_count, LightManager::no_shadow_slot);
+    grow_to(this->point_light_packed_indices, id_count);
+
+    grow_to(this->light_data.point_lights, packed_count);
+    grow_to(this->packed_point_light_ids, packed_count);
+    grow_to(this->point_light_changed, packed_count);
+}
+
+auto LightManager::grow_spot_light_storage(
+    std::size_t id_count, std::size_t packed_count
+) -> void {
+    grow_to(this->spot_lights, id_count);
+    grow_to(this->spot_light_active, id_count);
+    grow_to(this->spot_shadow_slots, id_count, LightManager::no_shadow_slot);
+    grow_to(this->spot_light_packed_indices, id_count);
+
+    grow_to(this->light_data.spot_lights, packed_count);
+    grow_to(this->packed_spot_light_ids, packed_count);
+    grow_to(this->spot_light_changed, packed_count);
+}
+
+auto LightManager::collect_point_shadow_casters() -> void {
+    collect_shadow_casters(
+        this->point_shadow_slot_owners, this->point_shadow_slots,
+        this->point_light_packed_indices,
+        this->light_data.shadow_casting_point_lights
+    );
+}
+
+auto LightManager::collect_spot_shadow_casters() -> void {
+    collect_shadow_casters(
+        this->spot_shadow_slot_owners, this->spot_shadow_slots,
+        this->spot_light_packed_indices,
+        this->light_data.shadow_casting_spot_lights
+    );
+}
+
+auto LightManager::repack_point_light(LightId point_light_id) -> void {
+    const auto packed_index =
+        gsl::at(this->point_light_packed_indices, point_light_id);
+    gsl::at(this->light_data.point_lights, packed_index) = pack_point_light(
+        gsl::at(this->point_lights, point_light_id),
+        gsl::at(this->point_shadow_slots, point_light_id)
+    );
+    mark_changed(
+        this->light_data.changed_point_lights, this->point_light_changed,
+        packed_index
+    );
+}
+
+auto LightManager::repack_spot_light(LightId spot_light_id) -> void {
+    const auto packed_index =
+        gsl::at(this->spot_light_packed_indices, spot_light_id);
+    gsl::at(this->light_data.spot_lights, packed_index) = pack_spot_light(
+        gsl::at(this->spot_lights, spot_light_id),
+        gsl::at(this->spot_shadow_slots, spot_light_id)
+    );
+    mark_changed(
+        this->light_data.changed_spot_lights, this->spot_light_changed,
+        packed_index
+    );
 }
 
 }  // namespace Luminol::Graphics
@@ -1,23 +1,36 @@
 #pragma once
 
-#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <limits>
 #include <optional>
+#include <vector>
 
 #include <LuminolMaths/Matrix.hpp>
 #include <LuminolMaths/Vector.hpp>
 
 #include <LuminolRenderEngine/Graphics/IdPool.hpp>
 #include <LuminolRenderEngine/Graphics/Light.hpp>
+#include <LuminolRenderEngine/Graphics/LightSpatialIndex.hpp>
 
 namespace Luminol::Graphics {
 
+// How many point/spot lights a LightManager hands out ids for at once.
+struct LightCapacity {
+    uint32_t max_point_lights = default_max_point_lights;
+    uint32_t max_spot_lights = default_max_spot_lights;
+};
+
 class LightManager {
 public:
     using LightId = uint32_t;
 
-    LightManager();
+    explicit LightManager(const LightCapacity& capacity = {});
+
+    // Lowering it below the lights already added doesn't remove any - it
+    // only stops add_point_light/add_spot_light until enough are removed.
+    auto set_capacity(const LightCapacity& capacity) -> void;
+    [[nodiscard]] auto get_capacity() const -> LightCapacity;
 
     auto update_directional_light(const DirectionalLight& directional_light)
         -> void;
@@ -35,44 +48,134 @@ public:
         -> void;
     auto remove_spot_light(LightId spot_light_id) -> void;
 
-    // Re-scores every active point/spot light against the camera's frustum
-    // (in-frustum, nearest/brightest first) and updates which lights hold a
-    // shadow slot, with hysteresis so lights near the cap boundary don't
-    // flicker in/out of shadowing every frame. Must be called before
-    // get_light_data() so the repacked arrays reflect this frame's
-    // assignment.
+    // Picks the best-scoring point/spot lights in the camera's frustum
+    // (nearest/brightest first) from the lights' spatial indices and updates
+    // which lights hold a shadow slot, with hysteresis so lights near the
+    // cap boundary don't flicker in/out of shadowing every frame. Only
+    // lights whose slot changed are repacked, and get_light_data()'s
+    // shadow_casting_point_lights/shadow_casting_spot_lights list the
+    // holders.
     auto update_shadow_casters(
         const Maths::Matrix4x4f& view_projection_matrix,
         const Maths::Vector3f& camera_position
     ) -> void;
 
-    [[nodiscard]] auto get_light_data() -> const Light&;
+    // Every active point/spot light's culling sphere, kept up to date as
+    // lights are added, updated and removed - for frustum and radius queries
+    // by LightId.
+    [[nodiscard]] auto get_point_light_index() const
+        -> const LightSpatialIndex&;
+    [[nodiscard]] auto get_spot_light_index() const
+        -> const LightSpatialIndex&;
+
+    // The active lights, packed densely - kept up to date as lights are
+    // added, updated and removed, so this never repacks anything. Its
+    // changed_point_lights/changed_spot_lights list what changed since the
+    // last clear_changes().
+    [[nodiscard]] auto get_light_data() const -> const Light&;
+
+    // Forgets the changes listed in get_light_data(), once they've been
+    // uploaded.
+    auto clear_changes() -> void;
+
+    // Lists every packed light as changed, for when whatever holds the
+    // uploaded copy no longer matches this manager's last clear_changes().
+    auto mark_all_lights_changed() -> void;
+
+    // Brings this manager's lights up to date with source's changes since
+    // source's last clear_changes(), then clears them - O(changed). This
+    // manager must have mirrored source as of that clear (start it as a
+    // copy). Keeps this manager's own shadow-slot assignment (bar lights
+    // source removed), so a copy that another thread selects shadow casters
+    // from keeps its hysteresis - see
+    // SDL_GPURenderer::set_render_thread_enabled. Light ids aren't mirrored
+    // back, so never add/remove lights on the copy.
+    auto sync_lights_from(LightManager& source) -> void;
 
     // Sentinel stored in point_shadow_slots/spot_shadow_slots for a light
     // that doesn't currently hold a shadow slot.
     static constexpr auto no_shadow_slot = std::numeric_limits<uint32_t>::max();
+    // Sentinel for a shadow slot no light holds.
+    static constexpr auto no_light = std::numeric_limits<LightId>::max();
+
+    // Working lists for update_shadow_casters' ranking, kept across calls
+    // so a frame's re-ranking reuses their capacity instead of allocating.
+    struct ShadowSelectionScratch {
+        LightSpatialIndex::SelectionScratch index_scratch;
+        std::vector<ScoredLight> candidates;
+        // The light holding each slot after the ranking.
+        std::vector<LightId> new_owners;
+        std::vector<std::uint8_t> used_slots;
+        std::vector<LightId> unassigned_winners;
+        // Lights whose slot the ranking changed.
+        std::vector<LightId> changed_ids;
+    };
 
 private:
+    // Grows the storage indexed by LightId to id_count entries and the
+    // packed storage to packed_count, if either is shorter.
+    auto grow_point_light_storage(
+        std::size_t id_count, std::size_t packed_count
+    ) -> void;
+    auto grow_spot_light_storage(
+        std::size_t id_count, std::size_t packed_count
+    ) -> void;
+
+    // Rewrites light_id's packed entry from its light and shadow slot, and
+    // lists it as changed.
+    auto repack_point_light(LightId point_light_id) -> void;
+    auto repack_spot_light(LightId spot_light_id) -> void;
+
+    // Rebuilds light_data's shadow caster list from the slot owners.
+    auto collect_point_shadow_casters() -> void;
+    auto collect_spot_shadow_casters() -> void;
+
     Light light_data = {};
 
     IdPool<LightId> point_light_ids;
     IdPool<LightId> spot_light_ids;
 
-    // Dense, fixed-capacity storage indexed directly by LightId (ids are
-    // handed out from a bounded 0..max_point_lights-1 / 0..max_spot_lights-1
-    // pool - see point_light_ids/spot_light_ids), so every per-frame
-    // lookup/update is a direct array index instead of a tree traversal.
-    // Active flags use
-    // uint8_t rather than array<bool, N> so they're span-able (array<bool, N>
-    // has no special packing like vector<bool>, but uint8_t keeps this
-    // consistent with the rest of the flags here).
-    std::array<PointLight, max_point_lights> point_lights{};
-    std::array<std::uint8_t, max_point_lights> point_light_active{};
-    std::array<uint32_t, max_point_lights> point_shadow_slots{};
-
-    std::array<SpotLight, max_spot_lights> spot_lights{};
-    std::array<std::uint8_t, max_spot_lights> spot_light_active{};
-    std::array<uint32_t, max_spot_lights> spot_shadow_slots{};
+    // Dense storage indexed directly by LightId (ids are handed out lowest
+    // first - see point_light_ids/spot_light_ids), so every per-frame
+    // lookup/update is a direct index instead of a tree traversal. Grown as
+    // higher ids are handed out, never shrunk, so it only ever costs as much
+    // as the most lights there have been at once. Active flags use uint8_t
+    // rather than vector<bool> so they're span-able.
+    std::vector<PointLight> point_lights;
+    std::vector<std::uint8_t> point_light_active;
+    std::vector<uint32_t> point_shadow_slots;
+
+    std::vector<SpotLight> spot_lights;
+    std::vector<std::uint8_t> spot_light_active;
+    std::vector<uint32_t> spot_shadow_slots;
+
+    // The light holding each shadow slot, or no_light. May list a light
+    // that has since lost its slot - see collect_point_shadow_casters.
+    std::vector<LightId> point_shadow_slot_owners;
+    std::vector<LightId> spot_shadow_slot_owners;
+
+    LightSpatialIndex point_light_index;
+    LightSpatialIndex spot_light_index;
+
+    // Each active light's index into light_data's packed arrays, and the
+    // light at each packed index. Removing a light moves the last packed
+    // light into its place, so the packed arrays stay dense without
+    // repacking the lights after it.
+    std::vector<uint32_t> point_light_packed_indices;
+    std::vector<LightId> packed_point_light_ids;
+    std::vector<uint32_t> spot_light_packed_indices;
+    std::vector<LightId> packed_spot_light_ids;
+
+    // Per packed index: already in light_data's changed list, so each is
+    // listed once.
+    std::vector<std::uint8_t> point_light_changed;
+    std::vector<std::uint8_t> spot_light_changed;
+
+    // Lights removed since the last clear_changes(), for sync_lights_from.
+    std::vector<LightId> removed_point_light_ids;
+    std::vector<LightId> removed_spot_light_ids;
+
+    ShadowSelectionScratch shadow_selection_scratch;
 };
 
 }  // namespace Luminol::Graphics
@@ -0,0 +1,426 @@
+#include "LightSpatialIndex.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
+
+#include <gsl/gsl>
+
+#include <LuminolRenderEngine/Graphics/Frustum.hpp>
+
+namespace {
+
+using namespace Luminol::Graphics;
+using namespace Luminol::Maths;
+
+// Cell coordinates are clamped to this many cells either side of the
+// origin, so each fits 21 bits of the lookup key.
+constexpr auto max_cell_coordinate = int32_t{1} << 20U;
+constexpr auto cell_key_bits = 21U;
+
+// Headroom for the score bound and the cell-vs-frustum test, whose float
+// math rounds differently from the per-light test they stand in for.
+constexpr auto bound_slack = 1.001f;
+
+auto get_cell_key(const std::array<int32_t, 3>& coordinates) -> uint64_t {
+    auto key = uint64_t{0};
+    for (const auto coordinate : coordinates) {
+        key = (key << cell_key_bits) |
+            static_cast<uint64_t>(coordinate + max_cell_coordinate);
+    }
+    return key;
+}
+
+auto to_cell_coordinate(float position, float cell_size) -> int32_t {
+    const auto coordinate = std::floor(position / cell_size);
+    if (!(coordinate > static_cast<float>(-max_cell_coordinate))) {
+        return -max_cell_coordinate;
+    }
+    if (!(coordinate < static_cast<float>(max_cell_coordinate - 1))) {
+        return max_cell_coordinate - 1;
+    }
+    return static_cast<int32_t>(coordinate);
+}
+
+// Squared distance from point to the nearest point of [box_min, box_max].
+auto distance_squared_to_box(
+    const Vector3f& point, const Vector3f& box_min, const Vector3f& box_max
+) -> float {
+    const auto nearest = Vector3f{
+        std::clamp(point.x(), box_min.x(), box_max.x()),
+        std::clamp(point.y(), box_min.y(), box_max.y()),
+        std::clamp(point.z(), box_min.z(), box_max.z()),
+    };
+    const auto offset = point - nearest;
+    return offset.dot(offset);
+}
+
+constexpr auto everywhere = BoundingBox{
+    .min =
+        Vector3f{
+            -std::numeric_limits<float>::infinity(),
+            -std::numeric_limits<float>::infinity(),
+            -std::numeric_limits<float>::infinity(),
+        },
+    .max =
+        Vector3f{
+            std::numeric_limits<float>::infinity(),
+            std::numeric_limits<float>::infinity(),
+            std::numeric_limits<float>::infinity(),
+        },
+};
+
+auto grow(const BoundingBox& bounds, float amount) -> BoundingBox {
+    const auto offset = Vector3f{amount, amount, amount};
+    return BoundingBox{.min = bounds.min - offset, .max = bounds.max + offset};
+}
+
+// Where the planes meet, or std::nullopt if they don't meet in one point.
+auto intersect_planes(const Vector4f& a, const Vector4f& b, const Vector4f& c)
+    -> std::optional<Vector3f> {
+    const auto normal_a = Vector3f{a.x(), a.y(), a.z()};
+    const auto normal_b = Vector3f{b.x(), b.y(), b.z()};
+    const auto normal_c = Vector3f{c.x(), c.y(), c.z()};
+
+    const auto b_cross_c = normal_b.cross(normal_c);
+    const auto determinant = normal_a.dot(b_cross_c);
+    const auto point = ((b_cross_c * a.w()) +
+                        (normal_c.cross(normal_a) * b.w()) +
+                        (normal_a.cross(normal_b) * c.w())) *
+        (-1.0f / determinant);
+    if (!std::isfinite(point.x()) || !std::isfinite(point.y()) ||
+        !std::isfinite(point.z())) {
+        return std::nullopt;
+    }
+    return point;
+}
+
+// The box around the frustum's eight corners, each where a left/right,
+// bottom/top and near/far plane meet (see extract_frustum_planes for their
+// order), or std::nullopt for a degenerate frustum.
+auto get_frustum_bounds(const std::array<Vector4f, 6>& planes)
+    -> std::optional<BoundingBox> {
+    constexpr auto infinity = std::numeric_limits<float>::infinity();
+    auto bounds = BoundingBox{
+        .min = Vector3f{infinity, infinity, infinity},
+        .max = Vector3f{-infinity, -infinity, -infinity},
+    };
+    for (const auto x_plane : {0U, 1U}) {
+        for (const auto y_plane : {2U, 3U}) {
+            for (const auto z_plane : {4U, 5U}) {
+                const auto corner = intersect_planes(
+                    gsl::at(planes, x_plane),
+                    gsl::at(planes, y_plane),
+                    gsl::at(planes, z_plane)
+                );
+                if (!corner.has_value()) {
+                    return std::nullopt;
+                }
+                bounds.min = Vector3f{
+                    std::min(bounds.min.x(), corner->x()),
+                    std::min(bounds.min.y(), corner->y()),
+                    std::min(bounds.min.z(), corner->z()),
+                };
+                bounds.max = Vector3f{
+                    std::max(bounds.max.x(), corner->x()),
+                    std::max(bounds.max.y(), corner->y()),
+                    std::max(bounds.max.z(), corner->z()),
+                };
+            }
+        }
+    }
+    return bounds;
+}
+
+// Must match update_shadow_casters' ranking before this index existed -
+// intensity over squared distance, floored so a light at the camera doesn't
+// divide by zero.
+auto get_score(float intensity, float distance_squared) -> float {
+    return intensity / std::max(distance_squared, 0.01f);
+}
+
+// Min-heap order: the worst kept light at the front.
+auto higher_score(const ScoredLight& lhs, const ScoredLight& rhs) -> bool {
+    return lhs.score > rhs.score;
+}
+
+}  // namespace
+
+namespace Luminol::Graphics {
+
+LightSpatialIndex::LightSpatialIndex(float cell_size) : cell_size{cell_size} {}
+
+auto LightSpatialIndex::insert(LightId id, const IndexedLight& light) -> void {
+    if (this->entries.size() <= id) {
+        this->entries.resize(static_cast<std::size_t>(id) + 1);
+    }
+
+    const auto cell_index =
+        find_or_add_cell(get_cell_coordinates(light.position));
+    auto& cell = gsl::at(this->cells, cell_index);
+    auto& entry = gsl::at(this->entries, id);
+    if (entry.cell != cell_index) {
+        remove(id);
+        entry.cell = cell_index;
+        entry.slot = static_cast<uint32_t>(cell.light_ids.size());
+        cell.light_ids.push_back(id);
+        ++this->light_count;
+    }
+
+    entry.light = light;
+    this->max_radius = std::max(this->max_radius, light.radius);
+    cell.max_radius = std::max(cell.max_radius, light.radius);
+    cell.max_intensity = std::max(cell.max_intensity, light.intensity);
+}
+
+auto LightSpatialIndex::remove(LightId id) -> void {
+    if (!contains(id)) {
+        return;
+    }
+
+    auto& entry = gsl::at(this->entries, id);
+    auto& cell = gsl::at(this->cells, entry.cell);
+    const auto moved_id = cell.light_ids.back();
+    gsl::at(cell.light_ids, entry.slot) = moved_id;
+    gsl::at(this->entries, moved_id).slot = entry.slot;
+    cell.light_ids.pop_back();
+    if (cell.light_ids.empty()) {
+        cell.max_radius = 0.0f;
+        cell.max_intensity = 0.0f;
+    }
+
+    entry.cell = no_cell;
+    --this->light_count;
+}
+
+auto LightSpatialIndex::contains(LightId id) const -> bool {
+    return id < this->entries.size() &&
+        gsl::at(this->entries, id).cell != no_cell;
+}
+
+auto LightSpatialIndex::size() const -> std::size_t {
+    return this->light_count;
+}
+
+template <typename Visit>
+auto LightSpatialIndex::for_each_cell_in(
+    const BoundingBox& bounds, const Visit& visit
+) const -> void {
+    const auto first = get_cell_coordinates(bounds.min);
+    const auto last = get_cell_coordinates(bounds.max);
+
+    // At most 2^21 cells per axis, so this can't overflow.
+    auto covered_cell_count = uint64_t{1};
+    for (auto axis = 0u; axis < first.size(); ++axis) {
+        covered_cell_count *=
+            static_cast<uint64_t>(gsl::at(last, axis) - gsl::at(first, axis)) +
+            1;
+    }
+
+    if (covered_cell_count >= this->cells.size()) {
+        for (auto cell_index = 0u; cell_index < this->cells.size();
+             ++cell_index) {
+            if (!gsl::at(this->cells, cell_index).light_ids.empty()) {
+                visit(cell_index);
+            }
+        }
+        return;
+    }
+
+    for (auto x = first[0]; x <= last[0]; ++x) {
+        for (auto y = first[1]; y <= last[1]; ++y) {
+            for (auto z = first[2]; z <= last[2]; ++z) {
+                const auto lookup =
+                    this->cell_lookup.find(get_cell_key({x, y, z}));
+                if (lookup != this->cell_lookup.end() &&
+                    !gsl::at(this->cells, lookup->second).light_ids.empty()) {
+                    visit(lookup->second);
+                }
+            }
+        }
+    }
+}
+
+template <typename Visit>
+auto LightSpatialIndex::for_each_cell_near_frustum(
+    const std::array<Maths::Vector4f, 6>& planes, const Visit& visit
+) const -> void {
+    const auto frustum_bounds = get_frustum_bounds(planes);
+    if (!frustum_bounds.has_value()) {
+        for_each_cell_in(everywhere, visit);
+        return;
+    }
+
+    // The corners come from float plane intersections, so allow for their
+    // rounding as well as the lights' radii.
+    const auto extent = frustum_bounds->max - frustum_bounds->min;
+    const auto largest_extent =
+        std::max({extent.x(), extent.y(), extent.z()});
+    const auto reach = (this->max_radius * bound_slack) +
+        (largest_extent * (bound_slack - 1.0f)) + 1e-3f;
+    for_each_cell_in(grow(*frustum_bounds, reach), visit);
+}
+
+auto LightSpatialIndex::query_sphere(
+    const Maths::Vector3f& center, float radius, std::vector<LightId>& out
+) const -> void {
+    const auto query_reach = (radius + this->max_radius) * bound_slack;
+    const auto query_bounds =
+        grow(BoundingBox{.min = center, .max = center}, query_reach);
+    for_each_cell_in(query_bounds, [&](uint32_t cell_index) {
+        const auto& cell = gsl::at(this->cells, cell_index);
+        const auto cell_reach = (radius + cell.max_radius) * bound_slack;
+        if (distance_squared_to_box(
+                center, get_cell_min(cell), get_cell_max(cell)
+            ) > cell_reach * cell_reach) {
+            return;
+        }
+
+        for (const auto id : cell.light_ids) {
+            const auto& light = gsl::at(this->entries, id).light;
+            const auto offset = light.position - center;
+            const auto reach = radius + light.radius;
+            if (offset.dot(offset) <= reach * reach) {
+                out.push_back(id);
+            }
+        }
+    });
+}
+
+auto LightSpatialIndex::query_frustum(
+    const std::array<Maths::Vector4f, 6>& planes, std::vector<LightId>& out
+) const -> void {
+    for_each_cell_near_frustum(planes, [&](uint32_t cell_index) {
+        const auto& cell = gsl::at(this->cells, cell_index);
+        if (!cell_in_frustum(cell, planes)) {
+            return;
+        }
+
+        for (const auto id : cell.light_ids) {
+            const auto& light = gsl::at(this->entries, id).light;
+            if (sphere_in_frustum(planes, light.position, light.radius)) {
+                out.push_back(id);
+            }
+        }
+    });
+}
+
+auto LightSpatialIndex::select_highest_scoring(
+    const std::array<Maths::Vector4f, 6>& planes,
+    const Maths::Vector3f& camera_position,
+    std::size_t count,
+    std::vector<ScoredLight>& out,
+    SelectionScratch& scratch
+) const -> void {
+    out.clear();
+    if (count == 0) {
+        return;
+    }
+
+    auto& cell_bounds = scratch.cells;
+    cell_bounds.clear();
+    for_each_cell_near_frustum(planes, [&](uint32_t cell_index) {
+        const auto& cell = gsl::at(this->cells, cell_index);
+        if (!cell_in_frustum(cell, planes)) {
+            return;
+        }
+
+        const auto distance_squared = distance_squared_to_box(
+            camera_position, get_cell_min(cell), get_cell_max(cell)
+        );
+        cell_bounds.push_back(SelectionScratch::CellBound{
+            .cell = cell_index,
+            .max_score =
+                get_score(cell.max_intensity, distance_squared) * bound_slack,
+        });
+    });
+
+    std::ranges::sort(cell_bounds, [](const auto& lhs, const auto& rhs) {
+        return lhs.max_score > rhs.max_score;
+    });
+
+    for (const auto& cell_bound : cell_bounds) {
+        if (out.size() == count && cell_bound.max_score < out.front().score) {
+            break;
+        }
+
+        for (const auto id : gsl::at(this->cells, cell_bound.cell).light_ids) {
+            const auto& light = gsl::at(this->entries, id).light;
+            if (!sphere_in_frustum(planes, light.position, light.radius)) {
+                continue;
+            }
+
+            const auto to_light = light.position - camera_position;
+            const auto scored = ScoredLight{
+                .id = id,
+                .score = get_score(light.intensity, to_light.dot(to_light)),
+            };
+            if (out.size() < count) {
+                out.push_back(scored);
+                std::ranges::push_heap(out, higher_score);
+            } else if (scored.score > out.front().score) {
+                std::ranges::pop_heap(out, higher_score);
+                out.back() = scored;
+                std::ranges::push_heap(out, higher_score);
+            }
+        }
+    }
+
+    std::ranges::sort_heap(out, higher_score);
+}
+
+auto LightSpatialIndex::get_cell_coordinates(
+    const Maths::Vector3f& position
+) const -> CellCoordinates {
+    return CellCoordinates{
+        to_cell_coordinate(position.x(), this->cell_size),
+        to_cell_coordinate(position.y(), this->cell_size),
+        to_cell_coordinate(position.z(), this->cell_size),
+    };
+}
+
+auto LightSpatialIndex::find_or_add_cell(const CellCoordinates& coordinates)
+    -> uint32_t {
+    const auto [lookup, inserted] = this->cell_lookup.try_emplace(
+        get_cell_key(coordinates), static_cast<uint32_t>(this->cells.size())
+    );
+    if (inserted) {
+        this->cells.push_back(
+            Cell{.coordinates = coordinates, .light_ids = {}}
+        );
+    }
+    return lookup->second;
+}
+
+auto LightSpatialIndex::get_cell_min(const Cell& cell) const
+    -> Maths::Vector3f {
+    return Maths::Vector3f{
+        static_cast<float>(cell.coordinates[0]) * this->cell_size,
+        static_cast<float>(cell.coordinates[1]) * this->cell_size,
+        static_cast<float>(cell.coordinates[2]) * this->cell_size,
+    };
+}
+
+auto LightSpatialIndex::get_cell_max(const Cell& cell) const
+    -> Maths::Vector3f {
+    return Maths::Vector3f{
+        static_cast<float>(cell.coordinates[0] + 1) * this->cell_size,
+        static_cast<float>(cell.coordinates[1] + 1) * this->cell_size,
+        static_cast<float>(cell.coordinates[2] + 1) * this->cell_size,
+    };
+}
+
+// The cell's box grown by its largest radius: any sphere centered in the
+// cell that passes sphere_in_frustum has this box pass aabb_in_frustum.
+auto LightSpatialIndex::cell_in_frustum(
+    const Cell& cell, const std::array<Maths::Vector4f, 6>& planes
+) const -> bool {
+    const auto reach = (cell.max_radius * bound_slack) + 1e-3f;
+    const auto grow = Maths::Vector3f{reach, reach, reach};
+    return aabb_in_frustum(
+        planes, get_cell_min(cell) - grow, get_cell_max(cell) + grow
+    );
+}
+
+}  // namespace Luminol::Graphics
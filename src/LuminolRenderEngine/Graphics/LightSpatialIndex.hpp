@@ -0,0 +1,159 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+#include <LuminolMaths/Vector.hpp>
+
+#include <LuminolRenderEngine/Graphics/BoundingBox.hpp>
+
+namespace Luminol::Graphics {
+
+// What LightSpatialIndex keeps per light: its culling sphere, and the
+// intensity its score is weighted by.
+struct IndexedLight {
+    Maths::Vector3f position = {0.0f, 0.0f, 0.0f};
+    float radius = 0.0f;
+    float intensity = 0.0f;
+};
+
+struct ScoredLight {
+    uint32_t id;
+    float score;
+};
+
+// Sparse uniform grid over light culling spheres: each light sits in the
+// cell holding its center, and only occupied cells exist (hashed by cell
+// coordinates), so lights spread over a city cost no more than ones packed
+// into a room. insert/remove update it in place in O(1) - nothing is ever
+// rebuilt.
+//
+// Queries look up only the cells their bounds cover (grown by the largest
+// light radius, since a light reaches past its cell), so their cost follows
+// the queried region rather than how many cells are occupied. Each cell
+// keeps the largest radius and intensity of any light it's held since it
+// was last empty, which bounds both how far the cell's lights reach and the
+// best score among them, so queries test whole cells before any light in
+// them.
+//
+// Cells are cell_size wide; past +/-2^20 cells from the origin, positions
+// clamp to the outermost cell and queries may miss them.
+class LightSpatialIndex {
+public:
+    using LightId = uint32_t;
+
+    constexpr static auto default_cell_size = 16.0f;
+
+    explicit LightSpatialIndex(float cell_size = default_cell_size);
+
+    // Adds id, or moves it if it's already indexed.
+    auto insert(LightId id, const IndexedLight& light) -> void;
+    // Does nothing if id isn't indexed.
+    auto remove(LightId id) -> void;
+
+    [[nodiscard]] auto contains(LightId id) const -> bool;
+    [[nodiscard]] auto size() const -> std::size_t;
+
+    // Appends every light whose sphere intersects the given one, in no
+    // particular order.
+    auto query_sphere(
+        const Maths::Vector3f& center, float radius, std::vector<LightId>& out
+    ) const -> void;
+
+    // Appends every light whose sphere passes sphere_in_frustum, in no
+    // particular order.
+    auto query_frustum(
+        const std::array<Maths::Vector4f, 6>& planes, std::vector<LightId>& out
+    ) const -> void;
+
+    // Working list for select_highest_scoring, kept across calls so a
+    // frame's selection reuses its capacity instead of allocating.
+    struct SelectionScratch {
+        struct CellBound {
+            uint32_t cell;
+            float max_score;
+        };
+
+        std::vector<CellBound> cells;
+    };
+
+    // Replaces out with the (up to) count lights passing sphere_in_frustum
+    // with the highest score - intensity / max(squared distance to
+    // camera_position, 0.01) - highest first. Visits the cells in the
+    // frustum best score bound first, keeping the best count lights in a
+    // heap, and stops at the first cell whose bound can't beat the worst of
+    // them, so the cost is in the lights near the top rather than all of
+    // them.
+    auto select_highest_scoring(
+        const std::array<Maths::Vector4f, 6>& planes,
+        const Maths::Vector3f& camera_position,
+        std::size_t count,
+        std::vector<ScoredLight>& out,
+        SelectionScratch& scratch
+    ) const -> void;
+
+private:
+    using CellCoordinates = std::array<int32_t, 3>;
+
+    struct Cell {
+        CellCoordinates coordinates;
+        std::vector<LightId> light_ids;
+        float max_radius = 0.0f;
+        float max_intensity = 0.0f;
+    };
+
+    static constexpr auto no_cell = std::numeric_limits<uint32_t>::max();
+
+    // Indexed by LightId. cell is no_cell for ids that aren't indexed, and
+    // slot is the light's index in its cell's light_ids.
+    struct Entry {
+        IndexedLight light;
+        uint32_t cell = no_cell;
+        uint32_t slot = 0;
+    };
+
+    [[nodiscard]] auto get_cell_coordinates(
+        const Maths::Vector3f& position
+    ) const -> CellCoordinates;
+    [[nodiscard]] auto find_or_add_cell(const CellCoordinates& coordinates)
+        -> uint32_t;
+
+    // Calls visit with the index of every non-empty cell that may hold a
+    // light centered in bounds - by looking up each cell bounds covers, or
+    // by walking the occupied cells when there are fewer of those.
+    template <typename Visit>
+    auto for_each_cell_in(const BoundingBox& bounds, const Visit& visit) const
+        -> void;
+    // Same, for the cells that may hold a light reaching into the frustum.
+    template <typename Visit>
+    auto for_each_cell_near_frustum(
+        const std::array<Maths::Vector4f, 6>& planes, const Visit& visit
+    ) const -> void;
+
+    // The box every center in cell lies in.
+    [[nodiscard]] auto get_cell_min(const Cell& cell) const -> Maths::Vector3f;
+    [[nodiscard]] auto get_cell_max(const Cell& cell) const -> Maths::Vector3f;
+
+    // Whether cell may hold a light passing sphere_in_frustum.
+    [[nodiscard]] auto cell_in_frustum(
+        const Cell& cell, const std::array<Maths::Vector4f, 6>& planes
+    ) const -> bool;
+
+    float cell_size;
+
+    // Emptied cells stay, ready for the next light to land in them.
+    std::vector<Cell> cells;
+    std::unordered_map<uint64_t, uint32_t> cell_lookup;
+
+    std::vector<Entry> entries;
+    std::size_t light_count = 0;
+    // The largest radius ever inserted - never shrinks, which only makes
+    // queries look at a few more cells.
+    float max_radius = 0.0f;
+};
+
+}  // namespace Luminol::Graphics
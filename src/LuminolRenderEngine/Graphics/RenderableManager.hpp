@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <filesystem>
+#include <functional>
 #include <unordered_map>
 
 #include <LuminolRenderEngine/Graphics/IdPool.hpp>
@@ -10,6 +11,29 @@ namespace Luminol::Graphics {
 
 using RenderableId = uint32_t;
 using FontId = uint32_t;
+// Handle to one retained instance of a renderable (see
+// SDL_GPURenderer::create_instance).
+using InstanceId = uint32_t;
+
+// Residency of a renderable created via Renderer::create_renderable_async.
+// Every synchronously created renderable is Resident as soon as its id is
+// returned.
+enum class RenderableLoadState : uint8_t {
+    // Unknown or removed id.
+    Unloaded,
+    // Still being read/baked on the loader thread, or waiting for its turn
+    // in the per-frame upload budget.
+    Loading,
+    Resident,
+    // The model file couldn't be loaded - the id stays allocated (draws are
+    // skipped or proxied forever) until remove_renderable.
+    Failed,
+};
+
+// Invoked on the render thread, from inside Renderer::draw(), once an async
+// load has finished - with Resident or Failed.
+using RenderableLoadCallback =
+    std::function<void(RenderableId renderable_id, RenderableLoadState state)>;
 
 class RenderableManager {
 public:
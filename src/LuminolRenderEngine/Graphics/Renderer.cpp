@@ -1,5 +1,7 @@
 #include "Renderer.hpp"
 
+#include <utility>
+
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUFactory.hpp>
 
 namespace Luminol::Graphics {
@@ -28,6 +30,21 @@ auto Renderer::create_renderable(const std::filesystem::path& model_path)
     return this->graphics_factory->create_model(model_path);
 }
 
+auto Renderer::create_renderable_async(
+    const std::filesystem::path& model_path,
+    std::optional<RenderableId> proxy_renderable_id,
+    RenderableLoadCallback on_loaded
+) -> RenderableId {
+    return this->graphics_factory->create_model_async(
+        model_path, proxy_renderable_id, std::move(on_loaded)
+    );
+}
+
+auto Renderer::get_load_state(RenderableId renderable_id) const
+    -> RenderableLoadState {
+    return this->graphics_factory->get_load_state(renderable_id);
+}
+
 auto Renderer::remove_renderable(RenderableId renderable_id) -> void {
     this->graphics_factory->remove_renderable(renderable_id);
 }
@@ -2,6 +2,7 @@
 
 #include <filesystem>
 #include <memory>
+#include <optional>
 
 #include <gsl/gsl>
 
@@ -45,6 +46,22 @@ public:
         const std::filesystem::path& model_path
     ) -> RenderableId;
 
+    // Non-blocking counterpart of create_renderable(model_path): returns the
+    // id immediately and loads the model on a background thread, uploading
+    // it from a later draw() within the per-frame upload budget (see
+    // SDL_GPURenderer::set_async_upload_budget). Until it's resident,
+    // queue_draw/queue_draw_instanced on the id draw proxy_renderable_id
+    // instead if given (e.g. a cube created up front), or nothing. on_loaded
+    // runs on the render thread once the load finishes or fails.
+    [[nodiscard]] auto create_renderable_async(
+        const std::filesystem::path& model_path,
+        std::optional<RenderableId> proxy_renderable_id = std::nullopt,
+        RenderableLoadCallback on_loaded = {}
+    ) -> RenderableId;
+
+    [[nodiscard]] auto get_load_state(RenderableId renderable_id) const
+        -> RenderableLoadState;
+
     auto remove_renderable(RenderableId renderable_id) -> void;
 
     [[nodiscard]] auto create_font(
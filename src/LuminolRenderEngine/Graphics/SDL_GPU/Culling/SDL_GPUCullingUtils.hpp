@@ -1,6 +1,8 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
+#include <memory_resource>
 #include <optional>
 #include <utility>
 #include <vector>
@@ -12,6 +14,7 @@
 #include <LuminolRenderEngine/Graphics/BoundingBox.hpp>
 #include <LuminolRenderEngine/Graphics/RenderableManager.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUInstanceBatch.hpp>
+#include <LuminolRenderEngine/Utilities/JobSystem.hpp>
 #include <LuminolRenderEngine/Utilities/ModelLoader.hpp>
 
 namespace Luminol::Graphics::SDL_GPU {
@@ -36,24 +39,86 @@ struct IndirectDrawRange {
     uint32_t count;
 };
 
+// Fills batch_offsets with each batch's first mesh index in a flattened
+// (batch, mesh) array, plus one past the last batch, and returns the total
+// mesh count. For BatchMeshTable.
+auto assign_batch_mesh_offsets(
+    const SDL_GPUFactory& graphics_factory,
+    gsl::span<const InstanceBatch> instance_batches,
+    std::pmr::vector<std::size_t>& batch_offsets
+) -> std::size_t;
+
+// One T per mesh (submesh) of every batch in a frame, indexed
+// [batch_index][mesh_index] like a vector of vectors but stored as one flat
+// array - batch i's meshes are values[batch_offsets[i], batch_offsets[i + 1])
+// - so laying a frame's table out is two allocations, both from the frame
+// arena, rather than one per batch.
+template <typename T>
+class BatchMeshTable {
+public:
+    explicit BatchMeshTable(
+        std::pmr::memory_resource* memory = std::pmr::get_default_resource()
+    )
+        : values{memory}, batch_offsets{memory} {}
+
+    // Lays the table out for instance_batches, every value T{}.
+    auto assign(
+        const SDL_GPUFactory& graphics_factory,
+        gsl::span<const InstanceBatch> instance_batches
+    ) -> void {
+        values.assign(
+            assign_batch_mesh_offsets(
+                graphics_factory, instance_batches, batch_offsets
+            ),
+            T{}
+        );
+    }
+
+    [[nodiscard]] auto operator[](std::size_t batch_index) -> gsl::span<T> {
+        return gsl::span{values}.subspan(
+            batch_offsets[batch_index],
+            batch_offsets[batch_index + 1] - batch_offsets[batch_index]
+        );
+    }
+
+    [[nodiscard]] auto operator[](std::size_t batch_index) const
+        -> gsl::span<const T> {
+        return gsl::span{values}.subspan(
+            batch_offsets[batch_index],
+            batch_offsets[batch_index + 1] - batch_offsets[batch_index]
+        );
+    }
+
+    // Batch count.
+    [[nodiscard]] auto size() const -> std::size_t {
+        return batch_offsets.empty() ? 0 : batch_offsets.size() - 1;
+    }
+
+private:
+    std::pmr::vector<T> values;
+    std::pmr::vector<std::size_t> batch_offsets;
+};
+
 // One world-space AABB per mesh (submesh) within a batch, covering the union
 // of all of that batch's current-frame instances. Shared across every pass
 // that culls the same frame's batches against a frustum (shadow faces, main
 // camera, AO prepass), since it doesn't depend on which frustum is used.
-using BatchMeshBounds = std::vector<std::vector<BoundingBox>>;
+using BatchMeshBounds = BatchMeshTable<BoundingBox>;
 
+// Allocates the result from frame_memory. job_system, if given, splits the
+// work by batch across its threads.
 [[nodiscard]] auto compute_batch_mesh_world_bounds(
     const SDL_GPUFactory& graphics_factory,
     gsl::span<const InstanceBatch> instance_batches,
-    const QueuedDraws& queued_draws
+    const QueuedDraws& queued_draws,
+    std::pmr::memory_resource& frame_memory,
+    Utilities::JobSystem* job_system = nullptr
 ) -> BatchMeshBounds;
 
 // World-space AABB for a single submesh, covering the union of every given
 // instance transform. Lets callers compute bounds on demand for just the
-// submeshes they need (e.g. only blend-mode submeshes in a batch that
-// otherwise has no need for CPU-side bounds - see
-// SDL_GPUMeshRenderPass::draw's transparent bin), rather than eagerly for
-// every submesh in every batch like compute_batch_mesh_world_bounds.
+// submeshes they need, rather than eagerly for every submesh in every batch
+// like compute_batch_mesh_world_bounds.
 [[nodiscard]] auto compute_mesh_world_bounds(
     const SDL_GPUMesh& mesh,
     gsl::span<const Maths::Matrix4x4f> model_matrices
@@ -63,11 +128,12 @@ using BatchMeshBounds = std::vector<std::vector<BoundingBox>>;
 // frustum test (and, if alpha_mode_filter is set, matches that alpha mode),
 // and records where in out_commands this batch's commands start/how many
 // there are (0 if none survive - callers skip the indirect draw call
-// entirely in that case).
+// entirely in that case). Commands draw every instance uncompacted, starting
+// at the batch's first_instance in its instance arena.
 auto append_batch_indirect_commands(
     const SDL_GPUFactory& graphics_factory,
     const InstanceBatch& batch,
-    const std::vector<BoundingBox>& mesh_bounds,
+    gsl::span<const BoundingBox> mesh_bounds,
     const std::array<Maths::Vector4f, 6>& frustum_planes,
     std::optional<Utilities::ModelLoader::AlphaMode> alpha_mode_filter,
     std::vector<IndirectDrawCommand>& out_commands
@@ -62,8 +62,8 @@ auto make_pyramid_texture(GPUDevice& device, SDL_Window* window) -> Texture {
     return make_pyramid_texture(device, width, height);
 }
 
-auto make_downsample_pipeline(GPUDevice& device) -> ComputePipeline {
-    return device.create_compute_pipeline(ComputePipelineInfo{
+auto get_downsample_pipeline_info() -> ComputePipelineInfo {
+    return ComputePipelineInfo{
         .path = "res/shaders/sdl_gpu/hiz_downsample.hlsl",
         .source_language = ShaderSourceLanguage::Hlsl,
         .readwrite_storage_texture_count = 5,
@@ -71,7 +71,7 @@ auto make_downsample_pipeline(GPUDevice& device) -> ComputePipeline {
         .threadcount_x = downsample_threads,
         .threadcount_y = downsample_threads,
         .threadcount_z = 1,
-    });
+    };
 }
 
 auto make_pyramid_sampler(GPUDevice& device, uint32_t mip_levels) -> Sampler {
@@ -83,29 +83,47 @@ auto make_pyramid_sampler(GPUDevice& device, uint32_t mip_levels) -> Sampler {
     });
 }
 
+auto get_copy_depth_fragment_shader_info() -> ShaderInfo {
+    return make_hlsl_shader_info(
+        "res/shaders/sdl_gpu/hiz_copy_depth.hlsl", ShaderStage::Fragment, 1U
+    );
+}
+
 }  // namespace
 
 namespace Luminol::Graphics::SDL_GPU {
 
 SDL_GPUHiZPass::SDL_GPUHiZPass(GPUDevice& device, SDL_Window* window)
-    : fullscreen_vertex_shader{make_hlsl_shader(
-          device, "res/shaders/sdl_gpu/fullscreen_vert.hlsl",
-          ShaderStage::Vertex
-      )},
-      copy_depth_fragment_shader{make_hlsl_shader(
-          device, "res/shaders/sdl_gpu/hiz_copy_depth.hlsl",
-          ShaderStage::Fragment, 1U
-      )},
+    : fullscreen_vertex_shader{
+          device.create_shader(get_fullscreen_vertex_shader_info())
+      },
+      copy_depth_fragment_shader{
+          device.create_shader(get_copy_depth_fragment_shader_info())
+      },
       copy_depth_pipeline{make_fullscreen_pipeline(
           device, fullscreen_vertex_shader, copy_depth_fragment_shader,
           pyramid_format
       )},
-      downsample_pipeline{make_downsample_pipeline(device)},
+      downsample_pipeline{
+          device.create_compute_pipeline(get_downsample_pipeline_info())
+      },
       pyramid_texture{make_pyramid_texture(device, window)},
       pyramid_sampler{
           make_pyramid_sampler(device, pyramid_texture.get_mip_levels())
       } {}
 
+auto SDL_GPUHiZPass::get_shader_compile_requests()
+    -> ShaderCompileRequests {
+    return ShaderCompileRequests{
+        .shaders =
+            {
+                get_fullscreen_vertex_shader_info(),
+                get_copy_depth_fragment_shader_info(),
+            },
+        .compute_pipelines = {get_downsample_pipeline_info()},
+    };
+}
+
 auto SDL_GPUHiZPass::resize(GPUDevice& device, uint32_t width, uint32_t height)
     -> void {
     pyramid_texture = make_pyramid_texture(device, width, height);
@@ -12,6 +12,7 @@ struct SDL_Window;
 namespace Luminol::Graphics::SDL_GPU {
 
 class GPUDevice;
+struct ShaderCompileRequests;
 class CommandBuffer;
 
 // Builds a Hi-Z (max-depth) mip pyramid from the previous frame's depth
@@ -24,6 +25,9 @@ class SDL_GPUHiZPass {
 public:
     SDL_GPUHiZPass(GPUDevice& device, SDL_Window* window);
 
+    [[nodiscard]] static auto get_shader_compile_requests()
+        -> ShaderCompileRequests;
+
     auto resize(GPUDevice& device, uint32_t width, uint32_t height) -> void;
 
     auto build(
@@ -1,5 +1,7 @@
 #include "SDL_GPUInstanceCullPass.hpp"
 
+#include <algorithm>
+
 #include <gsl/gsl>
 
 #include <LuminolRenderEngine/Graphics/BoundingBox.hpp>
@@ -12,7 +14,9 @@
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUInstanceBufferCache.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUMesh.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUResourceBuilders.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUStagingRing.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUTexture.hpp>
+#include <LuminolRenderEngine/Utilities/JobSystem.hpp>
 
 namespace Luminol::Graphics::SDL_GPU {
 
@@ -70,13 +74,17 @@ struct InstanceCullParams {
 // vector types on the HLSL side, so the C++ side must match their fixed
 // 4-element size exactly (see instance_cull.hlsl's SubmeshCullMetadata).
 //
-// _padding: the struct's own field-by-field byte size (88) isn't a multiple
+// _padding: the struct's own field-by-field byte size (92) isn't a multiple
 // of 16, but a StructuredBuffer's implicit per-element array STRIDE always
 // is (rounded up to the buffer's base alignment, 16, under the std430-style
 // layout DXC emits by default) - so without this padding, sizeof(*this)
 // (used everywhere below to size/grow/upload submesh_metadata_buffer) would
-// undershoot the GPU's actual 96-byte per-element stride by 8 bytes,
-// desyncing every element past index 0 by an accumulating 8 bytes each.
+// undershoot the GPU's actual 96-byte per-element stride by 4 bytes,
+// desyncing every element past index 0 by an accumulating 4 bytes each.
+//
+// first_instance: InstanceBatch::first_instance - the shader reads
+// instance_models[first_instance + i] and writes that arena index (not i)
+// into visible_instance_indices.
 struct SubmeshCullMetadata {
     Vector4f local_bounds_min;
     Vector4f local_bounds_max;
@@ -85,7 +93,8 @@ struct SubmeshCullMetadata {
     std::array<float, max_lod_levels> lod_distances_sq;
     uint32_t instance_count;
     uint32_t first_group;
-    std::array<uint32_t, 2> _padding;
+    uint32_t first_instance;
+    uint32_t _padding;
 };
 
 // One batch's culling dispatch inputs, built once per frame (cost
@@ -98,8 +107,30 @@ struct BatchDispatchInfo {
     uint32_t total_group_count;
 };
 
-auto make_instance_cull_pipeline(GPUDevice& device) -> ComputePipeline {
-    return device.create_compute_pipeline(ComputePipelineInfo{
+// Where one batch's slices of cull()'s per-frame arrays start: its first
+// IndirectDrawCommand (and command index), SubmeshCullMetadata entry,
+// group_to_submesh entry and visible_instance_indices slot. Summed over
+// every batch, these are also the arrays' total sizes.
+struct BatchCullOffsets {
+    uint32_t command_base = 0;
+    uint32_t submesh_base = 0;
+    uint32_t group_base = 0;
+    uint32_t instance_index_base = 0;
+};
+
+// Batches per JobSystem job in cull()'s metadata build. Most batches have a
+// handful of submeshes, so a single batch is too little work to be worth a
+// job of its own.
+constexpr auto min_batches_per_job = std::size_t{16};
+
+// Thread groups dispatched per submesh - the same for every submesh in a
+// batch, since each covers all of the batch's instances.
+auto get_group_count(uint32_t instance_count) -> uint32_t {
+    return (instance_count + threads_per_group - 1) / threads_per_group;
+}
+
+auto get_instance_cull_pipeline_info() -> ComputePipelineInfo {
+    return ComputePipelineInfo{
         .path = "res/shaders/sdl_gpu/instance_cull.hlsl",
         .source_language = ShaderSourceLanguage::Hlsl,
         .sampler_count = 1,
@@ -109,7 +140,7 @@ auto make_instance_cull_pipeline(GPUDevice& device) -> ComputePipeline {
         .threadcount_x = threads_per_group,
         .threadcount_y = 1,
         .threadcount_z = 1,
-    });
+    };
 }
 
 auto make_indirect_command_buffer(GPUDevice& device, uint32_t command_capacity)
@@ -154,37 +185,34 @@ auto make_group_to_submesh_buffer(GPUDevice& device, uint32_t group_capacity)
 }  // namespace
 
 SDL_GPUInstanceCullPass::SDL_GPUInstanceCullPass(GPUDevice& device)
-    : instance_cull_pipeline{make_instance_cull_pipeline(device)},
+    : instance_cull_pipeline{
+          device.create_compute_pipeline(get_instance_cull_pipeline_info())
+      },
       indirect_command_buffer{
           make_indirect_command_buffer(device, initial_command_capacity)
       },
-      indirect_command_transfer_buffer{device.create_transfer_buffer(TransferBufferInfo{
-          .usage = TransferBufferUsage::Upload,
-          .size =
-              initial_command_capacity * static_cast<uint32_t>(sizeof(IndirectDrawCommand)),
-      })},
       visible_instance_indices_buffer{make_visible_instance_indices_buffer(
           device, initial_visible_index_capacity
       )},
       submesh_metadata_buffer{
           make_submesh_metadata_buffer(device, initial_metadata_capacity)
       },
-      submesh_metadata_transfer_buffer{device.create_transfer_buffer(TransferBufferInfo{
-          .usage = TransferBufferUsage::Upload,
-          .size =
-              initial_metadata_capacity * static_cast<uint32_t>(sizeof(SubmeshCullMetadata)),
-      })},
       group_to_submesh_buffer{
           make_group_to_submesh_buffer(device, initial_group_capacity)
-      },
-      group_to_submesh_transfer_buffer{device.create_transfer_buffer(TransferBufferInfo{
-          .usage = TransferBufferUsage::Upload,
-          .size = initial_group_capacity * static_cast<uint32_t>(sizeof(uint32_t)),
-      })} {}
+      } {}
+
+auto SDL_GPUInstanceCullPass::get_shader_compile_requests()
+    -> ShaderCompileRequests {
+    return ShaderCompileRequests{
+        .shaders = {},
+        .compute_pipelines = {get_instance_cull_pipeline_info()},
+    };
+}
 
 auto SDL_GPUInstanceCullPass::cull(
     const SDL_GPUFactory& graphics_factory,
     CommandBuffer& command_buffer,
+    StagingRing& staging_ring,
     const SDL_GPUInstanceBufferCache& instance_buffer_cache,
     gsl::span<const InstanceBatch> instance_batches,
     const std::array<Vector4f, 6>& camera_frustum_planes,
@@ -193,28 +221,72 @@ auto SDL_GPUInstanceCullPass::cull(
     const Sampler& hiz_sampler,
     uint32_t hiz_mip_levels,
     const Vector3f& lod_reference_position,
-    bool enable_lod
+    bool enable_lod,
+    std::pmr::memory_resource& frame_memory,
+    Utilities::JobSystem* job_system
 ) -> InstanceCullLayout {
-    auto layout = InstanceCullLayout{};
-    layout.reserve(instance_batches.size());
+    // Serial prefix over batches: every batch's slice of each output array
+    // depends only on the batches before it, so working those offsets out
+    // first lets the per-submesh fill below run one batch per job - and
+    // means every array is allocated here, before any job runs.
+    auto batch_offsets = std::pmr::vector<BatchCullOffsets>{&frame_memory};
+    batch_offsets.reserve(instance_batches.size());
+    auto batch_dispatch_infos =
+        std::pmr::vector<BatchDispatchInfo>{&frame_memory};
+    batch_dispatch_infos.reserve(instance_batches.size());
+
+    auto running_offsets = BatchCullOffsets{};
+    for (const auto& batch : instance_batches) {
+        batch_offsets.push_back(running_offsets);
 
-    auto commands = std::vector<IndirectDrawCommand>{};
-    auto submesh_metadata = std::vector<SubmeshCullMetadata>{};
-    auto group_to_submesh = std::vector<uint32_t>{};
-    auto batch_dispatch_infos = std::vector<BatchDispatchInfo>{};
+        const auto mesh_count = static_cast<uint32_t>(
+            graphics_factory.get_meshes(batch.renderable_id).size()
+        );
+        const auto batch_group_count =
+            mesh_count * get_group_count(batch.instance_count);
 
-    auto running_index_base = uint32_t{0};
+        if (batch_group_count > 0) {
+            batch_dispatch_infos.push_back(BatchDispatchInfo{
+                .renderable_id = batch.renderable_id,
+                .group_to_submesh_base = running_offsets.group_base,
+                .total_group_count = batch_group_count,
+            });
+        }
 
-    for (const auto& batch : instance_batches) {
+        running_offsets.command_base += mesh_count * max_lod_levels;
+        running_offsets.submesh_base += mesh_count;
+        running_offsets.group_base += batch_group_count;
+        running_offsets.instance_index_base +=
+            mesh_count * max_lod_levels * batch.instance_count;
+    }
+
+    auto layout = InstanceCullLayout{&frame_memory};
+    layout.assign(graphics_factory, instance_batches);
+    auto commands = std::pmr::vector<IndirectDrawCommand>(
+        running_offsets.command_base, &frame_memory
+    );
+    auto submesh_metadata = std::pmr::vector<SubmeshCullMetadata>(
+        running_offsets.submesh_base, &frame_memory
+    );
+    auto group_to_submesh = std::pmr::vector<uint32_t>(
+        running_offsets.group_base, &frame_memory
+    );
+
+    const auto build_batch = [&](std::size_t batch_index) {
+        const auto& batch = instance_batches[batch_index];
+        const auto& offsets = batch_offsets[batch_index];
         const auto meshes = graphics_factory.get_meshes(batch.renderable_id);
-        auto submesh_infos = std::vector<SubmeshCullInfo>{};
-        submesh_infos.reserve(meshes.size());
+        const auto group_count = get_group_count(batch.instance_count);
+
+        const auto submesh_infos = layout[batch_index];
+
+        auto command_index = offsets.command_base;
+        auto running_index_base = offsets.instance_index_base;
 
-        const auto batch_group_base =
-            static_cast<uint32_t>(group_to_submesh.size());
-        auto batch_group_count = uint32_t{0};
+        for (auto mesh_index = std::size_t{0}; mesh_index < meshes.size();
+             ++mesh_index) {
+            const auto& mesh = meshes[mesh_index];
 
-        for (const auto& mesh : meshes) {
             // Reserve one IndirectDrawCommand and one visible_instance_indices
             // slice per LOD level (sized to the batch's full instance count -
             // worst case every instance selects that LOD), since GPU LOD
@@ -227,8 +299,6 @@ auto SDL_GPUInstanceCullPass::cull(
                 std::array<uint32_t, max_lod_levels>{};
 
             for (auto lod = std::size_t{0}; lod < max_lod_levels; ++lod) {
-                const auto command_index =
-                    static_cast<uint32_t>(commands.size());
                 const auto instance_base_offset = running_index_base;
                 running_index_base += batch.instance_count;
 
@@ -243,33 +313,33 @@ auto SDL_GPUInstanceCullPass::cull(
                 // needed. This is what lets geometry-only passes (shadow
                 // cascades, occlusion depth) multi-draw all of a batch's
                 // submeshes/LODs in one call instead of one draw per submesh.
-                commands.push_back(IndirectDrawCommand{
+                commands[command_index] = IndirectDrawCommand{
                     .num_indices = lod_range.index_count,
                     .num_instances = 0U,
                     .first_index = lod_range.first_index,
                     .vertex_offset = mesh.get_vertex_offset(),
                     .first_instance = instance_base_offset,
-                });
+                };
 
                 submesh_command_indices.at(lod) = command_index;
                 submesh_instance_base_offsets.at(lod) = instance_base_offset;
                 submesh_command_byte_offsets.at(lod) = command_index *
                     static_cast<uint32_t>(sizeof(IndirectDrawCommand));
+                command_index += 1;
             }
 
-            submesh_infos.push_back(SubmeshCullInfo{
+            submesh_infos[mesh_index] = SubmeshCullInfo{
                 .indirect_command_byte_offsets = submesh_command_byte_offsets,
                 .instance_base_offsets = submesh_instance_base_offsets,
-            });
+            };
 
             const auto local_bounds = mesh.get_local_bounds();
             const auto submesh_index =
-                static_cast<uint32_t>(submesh_metadata.size());
-            const auto first_group = batch_group_base + batch_group_count;
-            const auto group_count = (batch.instance_count + threads_per_group - 1) /
-                threads_per_group;
+                offsets.submesh_base + static_cast<uint32_t>(mesh_index);
+            const auto first_group = offsets.group_base +
+                static_cast<uint32_t>(mesh_index) * group_count;
 
-            submesh_metadata.push_back(SubmeshCullMetadata{
+            submesh_metadata[submesh_index] = SubmeshCullMetadata{
                 .local_bounds_min = Vector4f{
                     local_bounds.min.x(), local_bounds.min.y(),
                     local_bounds.min.z(), 0.0F
@@ -283,23 +353,31 @@ auto SDL_GPUInstanceCullPass::cull(
                 .lod_distances_sq = default_lod_distances_sq,
                 .instance_count = batch.instance_count,
                 .first_group = first_group,
-                ._padding = {},
-            });
+                .first_instance = batch.first_instance,
+                ._padding = 0,
+            };
 
-            group_to_submesh.insert(
-                group_to_submesh.end(), group_count, submesh_index
+            std::fill_n(
+                group_to_submesh.begin() + first_group, group_count,
+                submesh_index
             );
-            batch_group_count += group_count;
         }
-
-        layout.push_back(std::move(submesh_infos));
-
-        if (batch_group_count > 0) {
-            batch_dispatch_infos.push_back(BatchDispatchInfo{
-                .renderable_id = batch.renderable_id,
-                .group_to_submesh_base = batch_group_base,
-                .total_group_count = batch_group_count,
-            });
+    };
+
+    if (job_system != nullptr) {
+        job_system->parallel_for(
+            instance_batches.size(), min_batches_per_job,
+            [&build_batch](std::size_t begin, std::size_t end) {
+                for (auto batch_index = begin; batch_index < end;
+                     ++batch_index) {
+                    build_batch(batch_index);
+                }
+            }
+        );
+    } else {
+        for (auto batch_index = std::size_t{0};
+             batch_index < instance_batches.size(); ++batch_index) {
+            build_batch(batch_index);
         }
     }
 
@@ -315,25 +393,16 @@ auto SDL_GPUInstanceCullPass::cull(
             );
         }
     );
-    ensure_buffer_capacity(
-        indirect_command_transfer_buffer, required_command_size,
-        [&] {
-            return graphics_factory.get_gpu_device()->create_transfer_buffer(
-                TransferBufferInfo{
-                    .usage = TransferBufferUsage::Upload,
-                    .size = required_command_size,
-                }
-            );
-        }
-    );
 
     const auto required_index_size =
-        running_index_base * static_cast<uint32_t>(sizeof(uint32_t));
+        running_offsets.instance_index_base *
+        static_cast<uint32_t>(sizeof(uint32_t));
     ensure_buffer_capacity(
         visible_instance_indices_buffer, required_index_size,
         [&] {
             return make_visible_instance_indices_buffer(
-                *graphics_factory.get_gpu_device(), running_index_base
+                *graphics_factory.get_gpu_device(),
+                running_offsets.instance_index_base
             );
         }
     );
@@ -350,17 +419,6 @@ auto SDL_GPUInstanceCullPass::cull(
             );
         }
     );
-    ensure_buffer_capacity(
-        submesh_metadata_transfer_buffer, required_metadata_size,
-        [&] {
-            return graphics_factory.get_gpu_device()->create_transfer_buffer(
-                TransferBufferInfo{
-                    .usage = TransferBufferUsage::Upload,
-                    .size = required_metadata_size,
-                }
-            );
-        }
-    );
 
     const auto required_group_size = static_cast<uint32_t>(
         group_to_submesh.size() * sizeof(uint32_t)
@@ -374,23 +432,11 @@ auto SDL_GPUInstanceCullPass::cull(
             );
         }
     );
-    ensure_buffer_capacity(
-        group_to_submesh_transfer_buffer, required_group_size,
-        [&] {
-            return graphics_factory.get_gpu_device()->create_transfer_buffer(
-                TransferBufferInfo{
-                    .usage = TransferBufferUsage::Upload,
-                    .size = required_group_size,
-                }
-            );
-        }
-    );
 
     if (!commands.empty()) {
         auto copy_pass = command_buffer.begin_copy_pass();
-        upload_via_transfer(
-            copy_pass, indirect_command_transfer_buffer,
-            indirect_command_buffer,
+        staging_ring.upload(
+            copy_pass, indirect_command_buffer,
             gsl::span{
                 reinterpret_cast<const std::byte*>(commands.data()),
                 required_command_size
@@ -400,9 +446,8 @@ auto SDL_GPUInstanceCullPass::cull(
 
     if (!submesh_metadata.empty()) {
         auto copy_pass = command_buffer.begin_copy_pass();
-        upload_via_transfer(
-            copy_pass, submesh_metadata_transfer_buffer,
-            submesh_metadata_buffer,
+        staging_ring.upload(
+            copy_pass, submesh_metadata_buffer,
             gsl::span{
                 reinterpret_cast<const std::byte*>(submesh_metadata.data()),
                 required_metadata_size
@@ -412,9 +457,8 @@ auto SDL_GPUInstanceCullPass::cull(
 
     if (!group_to_submesh.empty()) {
         auto copy_pass = command_buffer.begin_copy_pass();
-        upload_via_transfer(
-            copy_pass, group_to_submesh_transfer_buffer,
-            group_to_submesh_buffer,
+        staging_ring.upload(
+            copy_pass, group_to_submesh_buffer,
             gsl::span{
                 reinterpret_cast<const std::byte*>(group_to_submesh.data()),
                 required_group_size
@@ -2,25 +2,28 @@
 
 #include <array>
 #include <cstdint>
-#include <vector>
+#include <memory_resource>
 
 #include <gsl/gsl>
 #include <LuminolMaths/Vector.hpp>
 
 #include <LuminolMaths/Matrix.hpp>
 
+#include <LuminolRenderEngine/Graphics/SDL_GPU/Culling/SDL_GPUCullingUtils.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUBuffer.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUComputePipeline.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUInstanceBatch.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUMesh.hpp>
-#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUTransferBuffer.hpp>
+#include <LuminolRenderEngine/Utilities/JobSystem.hpp>
 
 namespace Luminol::Graphics::SDL_GPU {
 
 class GPUDevice;
+struct ShaderCompileRequests;
 class CommandBuffer;
 class SDL_GPUFactory;
 class SDL_GPUInstanceBufferCache;
+class StagingRing;
 class Texture;
 class Sampler;
 
@@ -43,7 +46,7 @@ struct SubmeshCullInfo {
 // One entry per batch, one inner entry per submesh - same shape as
 // BatchMeshBounds (SDL_GPUCullingUtils.hpp), indexed the same way by
 // (batch_index, mesh_index).
-using InstanceCullLayout = std::vector<std::vector<SubmeshCullInfo>>;
+using InstanceCullLayout = BatchMeshTable<SubmeshCullInfo>;
 
 // GPU-driven per-instance frustum culling: one compute dispatch per BATCH
 // (not per submesh) runs instance_cull.hlsl - one thread per instance,
@@ -64,6 +67,9 @@ class SDL_GPUInstanceCullPass {
 public:
     explicit SDL_GPUInstanceCullPass(GPUDevice& device);
 
+    [[nodiscard]] static auto get_shader_compile_requests()
+        -> ShaderCompileRequests;
+
     // Must be called after instance data is uploaded (SDL_GPUInstanceBufferCache)
     // and before any render pass is opened on command_buffer this frame -
     // it opens its own copy pass and compute pass(es).
@@ -75,9 +81,15 @@ public:
     // (SDL_GPUShadowPass) both pass the main camera's world position here,
     // so a shadow caster selects the same LOD as its color-pass geometry
     // despite the shadow cull using a light-space frustum.
+    // Its per-call inputs are staged through staging_ring. The returned
+    // layout and every CPU-side scratch array are allocated from
+    // frame_memory. job_system, if given, spreads the CPU-side metadata
+    // build (one job per few batches) across its threads; null builds it on
+    // the calling thread.
     [[nodiscard]] auto cull(
         const SDL_GPUFactory& graphics_factory,
         CommandBuffer& command_buffer,
+        StagingRing& staging_ring,
         const SDL_GPUInstanceBufferCache& instance_buffer_cache,
         gsl::span<const InstanceBatch> instance_batches,
         const std::array<Maths::Vector4f, 6>& camera_frustum_planes,
@@ -86,7 +98,9 @@ public:
         const Sampler& hiz_sampler,
         uint32_t hiz_mip_levels,
         const Maths::Vector3f& lod_reference_position,
-        bool enable_lod
+        bool enable_lod,
+        std::pmr::memory_resource& frame_memory,
+        Utilities::JobSystem* job_system = nullptr
     ) -> InstanceCullLayout;
 
     [[nodiscard]] auto get_indirect_command_buffer() const -> const Buffer&;
@@ -97,7 +111,6 @@ private:
     ComputePipeline instance_cull_pipeline;
 
     Buffer indirect_command_buffer;
-    TransferBuffer indirect_command_transfer_buffer;
     Buffer visible_instance_indices_buffer;
 
     // Per-submesh cull inputs (bounds, command_index, instance_base_offset,
@@ -107,9 +120,7 @@ private:
     // looks up its own submesh via group_to_submesh), instead of one dispatch
     // per submesh - see the doc comment on cull().
     Buffer submesh_metadata_buffer;
-    TransferBuffer submesh_metadata_transfer_buffer;
     Buffer group_to_submesh_buffer;
-    TransferBuffer group_to_submesh_transfer_buffer;
 };
 
 }  // namespace Luminol::Graphics::SDL_GPU
@@ -1,7 +1,5 @@
 #include "SDL_GPUMeshletCullPass.hpp"
 
-#include <cstring>
-
 #include <gsl/gsl>
 
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUCommandBuffer.hpp>
@@ -12,6 +10,8 @@
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUFactory.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUInstanceBufferCache.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUMesh.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUResourceBuilders.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUStagingRing.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUTexture.hpp>
 
 namespace Luminol::Graphics::SDL_GPU {
@@ -75,8 +75,8 @@ struct BatchDispatchInfo {
     uint32_t total_group_count;
 };
 
-auto make_meshlet_cull_pipeline(GPUDevice& device) -> ComputePipeline {
-    return device.create_compute_pipeline(ComputePipelineInfo{
+auto get_meshlet_cull_pipeline_info() -> ComputePipelineInfo {
+    return ComputePipelineInfo{
         .path = "res/shaders/sdl_gpu/meshlet_cull.hlsl",
         .source_language = ShaderSourceLanguage::Hlsl,
         .sampler_count = 1,
@@ -86,7 +86,7 @@ auto make_meshlet_cull_pipeline(GPUDevice& device) -> ComputePipeline {
         .threadcount_x = threads_per_group,
         .threadcount_y = 1,
         .threadcount_z = 1,
-    });
+    };
 }
 
 auto make_indirect_command_buffer(GPUDevice& device, uint32_t command_capacity)
@@ -125,37 +125,34 @@ auto make_group_to_meshlet_dispatch_buffer(GPUDevice& device, uint32_t capacity)
 }  // namespace
 
 SDL_GPUMeshletCullPass::SDL_GPUMeshletCullPass(GPUDevice& device)
-    : meshlet_cull_pipeline{make_meshlet_cull_pipeline(device)},
+    : meshlet_cull_pipeline{
+          device.create_compute_pipeline(get_meshlet_cull_pipeline_info())
+      },
       indirect_command_buffer{
           make_indirect_command_buffer(device, initial_command_capacity)
       },
-      indirect_command_transfer_buffer{device.create_transfer_buffer(TransferBufferInfo{
-          .usage = TransferBufferUsage::Upload,
-          .size = initial_command_capacity *
-              static_cast<uint32_t>(sizeof(MeshletIndirectDrawCommand)),
-      })},
       visible_meshlet_instances_buffer{make_visible_meshlet_instances_buffer(
           device, initial_visible_instance_capacity
       )},
       meshlet_cull_metadata_buffer{
           make_meshlet_cull_metadata_buffer(device, initial_metadata_capacity)
       },
-      meshlet_cull_metadata_transfer_buffer{device.create_transfer_buffer(TransferBufferInfo{
-          .usage = TransferBufferUsage::Upload,
-          .size = initial_metadata_capacity *
-              static_cast<uint32_t>(sizeof(MeshletCullMetadata)),
-      })},
       group_to_meshlet_dispatch_buffer{make_group_to_meshlet_dispatch_buffer(
           device, initial_group_capacity
-      )},
-      group_to_meshlet_dispatch_transfer_buffer{device.create_transfer_buffer(TransferBufferInfo{
-          .usage = TransferBufferUsage::Upload,
-          .size = initial_group_capacity * static_cast<uint32_t>(sizeof(uint32_t)),
-      })} {}
+      )} {}
+
+auto SDL_GPUMeshletCullPass::get_shader_compile_requests()
+    -> ShaderCompileRequests {
+    return ShaderCompileRequests{
+        .shaders = {},
+        .compute_pipelines = {get_meshlet_cull_pipeline_info()},
+    };
+}
 
 auto SDL_GPUMeshletCullPass::cull(
     const SDL_GPUFactory& graphics_factory,
     CommandBuffer& command_buffer,
+    StagingRing& staging_ring,
     const SDL_GPUInstanceBufferCache& instance_buffer_cache,
     gsl::span<const InstanceBatch> instance_batches,
     const InstanceCullLayout& phase_a_layout,
@@ -164,15 +161,20 @@ auto SDL_GPUMeshletCullPass::cull(
     const Matrix4x4f& current_view_projection,
     const Texture& hiz_pyramid,
     const Sampler& hiz_sampler,
-    uint32_t hiz_mip_levels
+    uint32_t hiz_mip_levels,
+    std::pmr::memory_resource& frame_memory
 ) -> MeshletCullLayout {
-    auto layout = MeshletCullLayout{};
-    layout.reserve(instance_batches.size());
-
-    auto commands = std::vector<MeshletIndirectDrawCommand>{};
-    auto metadata_entries = std::vector<MeshletCullMetadata>{};
-    auto group_to_meshlet_dispatch = std::vector<uint32_t>{};
-    auto batch_dispatch_infos = std::vector<BatchDispatchInfo>{};
+    auto layout = MeshletCullLayout{&frame_memory};
+    layout.assign(graphics_factory, instance_batches);
+
+    auto commands = std::pmr::vector<MeshletIndirectDrawCommand>{&frame_memory};
+    auto metadata_entries =
+        std::pmr::vector<MeshletCullMetadata>{&frame_memory};
+    auto group_to_meshlet_dispatch =
+        std::pmr::vector<uint32_t>{&frame_memory};
+    auto batch_dispatch_infos =
+        std::pmr::vector<BatchDispatchInfo>{&frame_memory};
+    batch_dispatch_infos.reserve(instance_batches.size());
 
     auto running_output_index_base = uint32_t{0};
 
@@ -183,12 +185,8 @@ auto SDL_GPUMeshletCullPass::cull(
          ++batch_index) {
         const auto& batch = instance_batches[batch_index];
         const auto meshes = graphics_factory.get_meshes(batch.renderable_id);
-        const auto& phase_a_submesh_infos = phase_a_layout[batch_index];
-
-        auto submesh_infos =
-            std::vector<std::array<MeshletSubmeshCullInfo, max_lod_levels>>(
-                meshes.size()
-            );
+        const auto phase_a_submesh_infos = phase_a_layout[batch_index];
+        const auto submesh_infos = layout[batch_index];
 
         const auto batch_group_base =
             static_cast<uint32_t>(group_to_meshlet_dispatch.size());
@@ -218,7 +216,7 @@ auto SDL_GPUMeshletCullPass::cull(
                     .first_instance = output_instance_base,
                 });
 
-                submesh_infos.at(mesh_index).at(lod) = MeshletSubmeshCullInfo{
+                submesh_infos[mesh_index].at(lod) = MeshletSubmeshCullInfo{
                     .indirect_command_byte_offset = output_command_index *
                         static_cast<uint32_t>(sizeof(MeshletIndirectDrawCommand)),
                 };
@@ -266,8 +264,6 @@ auto SDL_GPUMeshletCullPass::cull(
             }
         }
 
-        layout.push_back(std::move(submesh_infos));
-
         if (batch_group_count > 0U) {
             batch_dispatch_infos.push_back(BatchDispatchInfo{
                 .renderable_id = batch.renderable_id,
@@ -290,15 +286,6 @@ auto SDL_GPUMeshletCullPass::cull(
             );
         }
     );
-    ensure_buffer_capacity(
-        indirect_command_transfer_buffer, required_command_size,
-        [&] {
-            return device->create_transfer_buffer(TransferBufferInfo{
-                .usage = TransferBufferUsage::Upload,
-                .size = required_command_size,
-            });
-        }
-    );
 
     const auto required_visible_instance_size = running_output_index_base *
         static_cast<uint32_t>(sizeof(std::array<uint32_t, 2>));
@@ -322,15 +309,6 @@ auto SDL_GPUMeshletCullPass::cull(
             );
         }
     );
-    ensure_buffer_capacity(
-        meshlet_cull_metadata_transfer_buffer, required_metadata_size,
-        [&] {
-            return device->create_transfer_buffer(TransferBufferInfo{
-                .usage = TransferBufferUsage::Upload,
-                .size = required_metadata_size,
-            });
-        }
-    );
 
     const auto required_group_size = static_cast<uint32_t>(
         group_to_meshlet_dispatch.size() * sizeof(uint32_t)
@@ -343,50 +321,39 @@ auto SDL_GPUMeshletCullPass::cull(
             );
         }
     );
-    ensure_buffer_capacity(
-        group_to_meshlet_dispatch_transfer_buffer, required_group_size,
-        [&] {
-            return device->create_transfer_buffer(TransferBufferInfo{
-                .usage = TransferBufferUsage::Upload,
-                .size = required_group_size,
-            });
-        }
-    );
 
     if (!commands.empty()) {
         auto copy_pass = command_buffer.begin_copy_pass();
-        const auto mapped = indirect_command_transfer_buffer.map(true);
-        std::memcpy(mapped.data(), commands.data(), required_command_size);
-        indirect_command_transfer_buffer.unmap();
-        copy_pass.upload_to_buffer(
-            indirect_command_transfer_buffer, 0, indirect_command_buffer, 0,
-            required_command_size, true
+        staging_ring.upload(
+            copy_pass, indirect_command_buffer,
+            gsl::span{
+                reinterpret_cast<const std::byte*>(commands.data()),
+                required_command_size
+            }
         );
     }
 
     if (!metadata_entries.empty()) {
         auto copy_pass = command_buffer.begin_copy_pass();
-        const auto mapped = meshlet_cull_metadata_transfer_buffer.map(true);
-        std::memcpy(
-            mapped.data(), metadata_entries.data(), required_metadata_size
-        );
-        meshlet_cull_metadata_transfer_buffer.unmap();
-        copy_pass.upload_to_buffer(
-            meshlet_cull_metadata_transfer_buffer, 0, meshlet_cull_metadata_buffer,
-            0, required_metadata_size, true
+        staging_ring.upload(
+            copy_pass, meshlet_cull_metadata_buffer,
+            gsl::span{
+                reinterpret_cast<const std::byte*>(metadata_entries.data()),
+                required_metadata_size
+            }
         );
     }
 
     if (!group_to_meshlet_dispatch.empty()) {
         auto copy_pass = command_buffer.begin_copy_pass();
-        const auto mapped = group_to_meshlet_dispatch_transfer_buffer.map(true);
-        std::memcpy(
-            mapped.data(), group_to_meshlet_dispatch.data(), required_group_size
-        );
-        group_to_meshlet_dispatch_transfer_buffer.unmap();
-        copy_pass.upload_to_buffer(
-            group_to_meshlet_dispatch_transfer_buffer, 0,
-            group_to_meshlet_dispatch_buffer, 0, required_group_size, true
+        staging_ring.upload(
+            copy_pass, group_to_meshlet_dispatch_buffer,
+            gsl::span{
+                reinterpret_cast<const std::byte*>(
+                    group_to_meshlet_dispatch.data()
+                ),
+                required_group_size
+            }
         );
     }
 
@@ -2,7 +2,7 @@
 
 #include <array>
 #include <cstdint>
-#include <vector>
+#include <memory_resource>
 
 #include <gsl/gsl>
 #include <LuminolMaths/Matrix.hpp>
@@ -12,14 +12,15 @@
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUComputePipeline.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUInstanceBatch.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/Culling/SDL_GPUInstanceCullPass.hpp>
-#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUTransferBuffer.hpp>
 
 namespace Luminol::Graphics::SDL_GPU {
 
 class GPUDevice;
+struct ShaderCompileRequests;
 class CommandBuffer;
 class SDL_GPUFactory;
 class SDL_GPUInstanceBufferCache;
+class StagingRing;
 class Texture;
 class Sampler;
 
@@ -38,8 +39,8 @@ struct MeshletSubmeshCullInfo {
 // contiguous in get_indirect_command_buffer() in LOD order, mirroring
 // SDL_GPUInstanceCullPass's layout - callers that need one LOD's command
 // index it directly by offsetting from the first.
-using MeshletCullLayout = std::vector<std::vector<
-    std::array<MeshletSubmeshCullInfo, max_lod_levels>>>;
+using MeshletCullLayout =
+    BatchMeshTable<std::array<MeshletSubmeshCullInfo, max_lod_levels>>;
 
 // Phase B of meshlet-level GPU culling, main color pass only (see
 // meshlet_cull.hlsl's file comment for the full design). Consumes
@@ -60,13 +61,19 @@ class SDL_GPUMeshletCullPass {
 public:
     explicit SDL_GPUMeshletCullPass(GPUDevice& device);
 
+    [[nodiscard]] static auto get_shader_compile_requests()
+        -> ShaderCompileRequests;
+
     // Must be called after phase_a_cull_pass.cull() (same command_buffer,
     // same frame, before any render pass is opened) - opens its own copy
     // pass and compute pass(es). phase_a_layout is the InstanceCullLayout
-    // phase_a_cull_pass.cull() returned this same call.
+    // phase_a_cull_pass.cull() returned this same call. Its per-call inputs
+    // are staged through staging_ring. The returned layout and the CPU-side
+    // scratch arrays are allocated from frame_memory.
     [[nodiscard]] auto cull(
         const SDL_GPUFactory& graphics_factory,
         CommandBuffer& command_buffer,
+        StagingRing& staging_ring,
         const SDL_GPUInstanceBufferCache& instance_buffer_cache,
         gsl::span<const InstanceBatch> instance_batches,
         const InstanceCullLayout& phase_a_layout,
@@ -75,7 +82,8 @@ public:
         const Maths::Matrix4x4f& current_view_projection,
         const Texture& hiz_pyramid,
         const Sampler& hiz_sampler,
-        uint32_t hiz_mip_levels
+        uint32_t hiz_mip_levels,
+        std::pmr::memory_resource& frame_memory
     ) -> MeshletCullLayout;
 
     [[nodiscard]] auto get_indirect_command_buffer() const -> const Buffer&;
@@ -86,7 +94,6 @@ private:
     ComputePipeline meshlet_cull_pipeline;
 
     Buffer indirect_command_buffer;
-    TransferBuffer indirect_command_transfer_buffer;
     // x = original instance index, y = meshlet index - see
     // meshlet_cull.hlsl's visible_meshlet_instances (RWStructuredBuffer<uint2>).
     Buffer visible_meshlet_instances_buffer;
@@ -96,9 +103,7 @@ private:
     // meshlets) and a group-index -> metadata-index lookup, both rebuilt
     // and re-uploaded every cull() call.
     Buffer meshlet_cull_metadata_buffer;
-    TransferBuffer meshlet_cull_metadata_transfer_buffer;
     Buffer group_to_meshlet_dispatch_buffer;
-    TransferBuffer group_to_meshlet_dispatch_transfer_buffer;
 };
 
 }  // namespace Luminol::Graphics::SDL_GPU
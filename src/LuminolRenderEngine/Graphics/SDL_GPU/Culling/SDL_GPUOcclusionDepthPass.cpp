@@ -46,21 +46,32 @@ auto make_depth_texture(GPUDevice& device, SDL_Window* window) -> Texture {
 namespace Luminol::Graphics::SDL_GPU {
 
 SDL_GPUOcclusionDepthPass::SDL_GPUOcclusionDepthPass(
-    GPUDevice& device, SDL_Window* window
+    GPUDevice& device, SDL_Window* window, VertexFormat vertex_format
 )
-    : vertex_shader{make_hlsl_shader(
-          device, "res/shaders/sdl_gpu/pbr_vert.hlsl", ShaderStage::Vertex,
-          0U, 1U, 2U
-      )},
-      fragment_shader{make_hlsl_shader(
-          device, "res/shaders/sdl_gpu/shadow_depth_frag.hlsl",
-          ShaderStage::Fragment
-      )},
-      pipeline{
-          make_depth_only_mesh_pipeline(device, vertex_shader, fragment_shader, depth_format)
+    : vertex_shader{
+          device.create_shader(get_mesh_vertex_shader_info(vertex_format))
       },
+      fragment_shader{
+          device.create_shader(get_depth_only_fragment_shader_info())
+      },
+      pipeline{make_depth_only_mesh_pipeline(
+          device, vertex_shader, fragment_shader, depth_format, vertex_format
+      )},
       depth_texture{make_depth_texture(device, window)} {}
 
+auto SDL_GPUOcclusionDepthPass::get_shader_compile_requests(
+    VertexFormat vertex_format
+) -> ShaderCompileRequests {
+    return ShaderCompileRequests{
+        .shaders =
+            {
+                get_mesh_vertex_shader_info(vertex_format),
+                get_depth_only_fragment_shader_info(),
+            },
+        .compute_pipelines = {},
+    };
+}
+
 auto SDL_GPUOcclusionDepthPass::resize(
     GPUDevice& device, uint32_t width, uint32_t height
 ) -> void {
@@ -124,6 +135,10 @@ auto SDL_GPUOcclusionDepthPass::draw(
             graphics_factory.get_index_buffer(batch.renderable_id),
             IndexElementSize::Bits32, 0
         );
+        push_vertex_dequantization(
+            command_buffer,
+            graphics_factory.get_vertex_dequantization(batch.renderable_id)
+        );
 
         // Per-submesh (not one multi-draw covering the whole batch): a
         // Mask/Blend submesh writing full, unconditional depth here (this
@@ -10,12 +10,14 @@
 #include <LuminolRenderEngine/Graphics/SDL_GPU/Culling/SDL_GPUInstanceCullPass.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUShader.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUTexture.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUVertexFormat.hpp>
 
 struct SDL_Window;
 
 namespace Luminol::Graphics::SDL_GPU {
 
 class GPUDevice;
+struct ShaderCompileRequests;
 class CommandBuffer;
 class SDL_GPUFactory;
 class Buffer;
@@ -30,7 +32,13 @@ class Buffer;
 // of drawing every instance uncalled.
 class SDL_GPUOcclusionDepthPass {
 public:
-    SDL_GPUOcclusionDepthPass(GPUDevice& device, SDL_Window* window);
+    SDL_GPUOcclusionDepthPass(
+        GPUDevice& device, SDL_Window* window, VertexFormat vertex_format
+    );
+
+    [[nodiscard]] static auto get_shader_compile_requests(
+        VertexFormat vertex_format
+    ) -> ShaderCompileRequests;
 
     auto resize(GPUDevice& device, uint32_t width, uint32_t height) -> void;
 
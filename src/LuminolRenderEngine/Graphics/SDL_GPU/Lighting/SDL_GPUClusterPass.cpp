@@ -1,6 +1,8 @@
 #include "SDL_GPUClusterPass.hpp"
 
+#include <algorithm>
 #include <array>
+#include <bit>
 #include <cmath>
 #include <cstring>
 #include <numbers>
@@ -11,6 +13,9 @@
 #include <LuminolRenderEngine/Graphics/SDL_GPU/RenderPasses/SDL_GPUComputePass.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/RenderPasses/SDL_GPUCopyPass.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUDevice.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUFramePacer.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUResourceBuilders.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUStagingRing.hpp>
 
 namespace {
 
@@ -24,34 +29,55 @@ constexpr auto cluster_aabb_buffer_size = cluster_count * cluster_aabb_size_byte
 constexpr auto cluster_light_grid_element_size = uint32_t{16};
 constexpr auto cluster_light_grid_buffer_size =
     cluster_count * cluster_light_grid_element_size;
-constexpr auto global_light_index_list_buffer_size =
-    global_light_index_capacity * static_cast<uint32_t>(sizeof(uint32_t));
-constexpr auto point_light_buffer_size =
-    max_point_lights * static_cast<uint32_t>(sizeof(AlignedPointLight));
-constexpr auto spot_light_buffer_size =
-    max_spot_lights * static_cast<uint32_t>(sizeof(AlignedSpotLight));
+constexpr auto light_index_size = static_cast<uint32_t>(sizeof(uint32_t));
+
+// The global light index list starts with room for this many lights per
+// cluster, and grows from there as LightIndexListUsage asks.
+constexpr auto initial_light_index_entries_per_cluster = uint32_t{64};
+
+// uint4 - see light_index_list_usage_buffer.
+constexpr auto light_index_list_usage_size = uint32_t{16};
+// One per frame the GPU can still be working on, plus the one being
+// recorded.
+constexpr auto usage_readback_count = FramePacer::max_frames_in_flight + 1;
+
+// Room for this many lights of each type up front; the light buffers grow
+// to the next power of two past it as more are added.
+constexpr auto initial_light_capacity = uint32_t{1024};
 
 // float4 per light: xyz = view-space position, w = cull radius.
-constexpr auto point_light_culling_buffer_size =
-    max_point_lights * static_cast<uint32_t>(sizeof(Luminol::Maths::Vector4f));
-constexpr auto spot_light_culling_buffer_size =
-    max_spot_lights * static_cast<uint32_t>(sizeof(Luminol::Maths::Vector4f));
+constexpr auto light_culling_data_size =
+    static_cast<uint32_t>(sizeof(Luminol::Maths::Vector4f));
 
 constexpr auto threads_per_group = uint32_t{64};
 constexpr auto dispatch_group_count =
     (cluster_count + threads_per_group - 1) / threads_per_group;
 
+// Unchanged lights re-uploaded to merge two changed ranges rather than issue
+// a separate copy for each - under 1 KiB of point lights.
+constexpr auto max_changed_range_gap = uint32_t{16};
+
 // Mirrors cbuffer ClusterBuildParams in cluster_aabb_build.hlsl.
 struct ClusterBuildParams {
     std::array<float, 4> camera_params;
     std::array<uint32_t, 4> grid_dim;
 };
 
+// Mirrors cbuffer ClusterLightTransformParams in
+// cluster_light_transform.hlsl.
+struct ClusterLightTransformParams {
+    Luminol::Maths::Matrix4x4f view_matrix;
+    std::array<uint32_t, 4> counts;
+};
+
 // Mirrors cbuffer ClusterCullParams in cluster_light_count.hlsl and
 // cluster_light_compact.hlsl. view_matrix isn't needed here - lights are
-// pre-transformed to view space on the CPU (see point_light_culling_data).
+// already in view space (see point_light_culling_data).
+// counts.w is LightIndexListSettings::lights_per_cluster, index_list.x its
+// capacity.
 struct ClusterCullParams {
     std::array<uint32_t, 4> counts;
+    std::array<uint32_t, 4> index_list;
 };
 
 // Mirrors cbuffer ClusterScanParams in cluster_light_scan.hlsl.
@@ -59,8 +85,8 @@ struct ClusterScanParams {
     std::array<uint32_t, 4> params;
 };
 
-auto make_aabb_build_pipeline(GPUDevice& device) -> ComputePipeline {
-    return device.create_compute_pipeline(ComputePipelineInfo{
+auto get_aabb_build_pipeline_info() -> ComputePipelineInfo {
+    return ComputePipelineInfo{
         .path = "res/shaders/sdl_gpu/cluster_aabb_build.hlsl",
         .source_language = ShaderSourceLanguage::Hlsl,
         .readwrite_storage_buffer_count = 1,
@@ -68,11 +94,24 @@ auto make_aabb_build_pipeline(GPUDevice& device) -> ComputePipeline {
         .threadcount_x = threads_per_group,
         .threadcount_y = 1,
         .threadcount_z = 1,
-    });
+    };
 }
 
-auto make_light_count_pipeline(GPUDevice& device) -> ComputePipeline {
-    return device.create_compute_pipeline(ComputePipelineInfo{
+auto get_light_transform_pipeline_info() -> ComputePipelineInfo {
+    return ComputePipelineInfo{
+        .path = "res/shaders/sdl_gpu/cluster_light_transform.hlsl",
+        .source_language = ShaderSourceLanguage::Hlsl,
+        .readonly_storage_buffer_count = 2,
+        .readwrite_storage_buffer_count = 2,
+        .uniform_buffer_count = 1,
+        .threadcount_x = threads_per_group,
+        .threadcount_y = 1,
+        .threadcount_z = 1,
+    };
+}
+
+auto get_light_count_pipeline_info() -> ComputePipelineInfo {
+    return ComputePipelineInfo{
         .path = "res/shaders/sdl_gpu/cluster_light_count.hlsl",
         .source_language = ShaderSourceLanguage::Hlsl,
         .readonly_storage_buffer_count = 2,
@@ -81,87 +120,201 @@ auto make_light_count_pipeline(GPUDevice& device) -> ComputePipeline {
         .threadcount_x = threads_per_group,
         .threadcount_y = 1,
         .threadcount_z = 1,
-    });
+    };
 }
 
-auto make_light_scan_pipeline(GPUDevice& device) -> ComputePipeline {
-    return device.create_compute_pipeline(ComputePipelineInfo{
+auto get_light_scan_pipeline_info() -> ComputePipelineInfo {
+    return ComputePipelineInfo{
         .path = "res/shaders/sdl_gpu/cluster_light_scan.hlsl",
         .source_language = ShaderSourceLanguage::Hlsl,
-        .readwrite_storage_buffer_count = 1,
+        .readwrite_storage_buffer_count = 2,
         .uniform_buffer_count = 1,
         .threadcount_x = 1,
         .threadcount_y = 1,
         .threadcount_z = 1,
-    });
+    };
 }
 
-auto make_light_compact_pipeline(GPUDevice& device) -> ComputePipeline {
-    return device.create_compute_pipeline(ComputePipelineInfo{
+auto get_light_compact_pipeline_info() -> ComputePipelineInfo {
+    return ComputePipelineInfo{
         .path = "res/shaders/sdl_gpu/cluster_light_compact.hlsl",
         .source_language = ShaderSourceLanguage::Hlsl,
         .readonly_storage_buffer_count = 2,
-        .readwrite_storage_buffer_count = 3,
+        .readwrite_storage_buffer_count = 4,
         .uniform_buffer_count = 1,
         .threadcount_x = threads_per_group,
         .threadcount_y = 1,
         .threadcount_z = 1,
+    };
+}
+
+auto make_light_index_list_buffer(GPUDevice& device, uint32_t capacity)
+    -> Buffer {
+    return device.create_buffer(BufferInfo{
+        .usage = BufferUsage::ComputeStorageReadWrite |
+            BufferUsage::StorageRead,
+        .size = capacity * light_index_size,
     });
 }
 
-// Row-vector transform (mul(pos, matrix) convention, matching
-// SDL_GPUCullingUtils.cpp's transform_point) - only the 3x3+translation part
-// is needed since this is a point, not a direction.
-auto transform_point(
-    const Luminol::Maths::Matrix4x4f& matrix, const Luminol::Maths::Vector3f& point
-) -> Luminol::Maths::Vector3f {
-    return Luminol::Maths::Vector3f{
-        (point.x() * matrix[0][0]) + (point.y() * matrix[1][0]) +
-            (point.z() * matrix[2][0]) + matrix[3][0],
-        (point.x() * matrix[0][1]) + (point.y() * matrix[1][1]) +
-            (point.z() * matrix[2][1]) + matrix[3][1],
-        (point.x() * matrix[0][2]) + (point.y() * matrix[1][2]) +
-            (point.z() * matrix[2][2]) + matrix[3][2],
-    };
+// At least one entry per cluster, so every cluster can keep a light.
+auto get_light_index_budget_capacity(uint32_t budget_bytes) -> uint32_t {
+    return std::max(budget_bytes / light_index_size, cluster_count);
 }
 
-// Must match the light_cull_radius cutoff in pbr_frag.hlsl /
-// cluster_light_count.hlsl / cluster_light_compact.hlsl /
-// SDL_GPUPointSpotShadowPass.cpp / LightManager.cpp exactly.
-auto light_cull_radius(const Luminol::Maths::Vector3f& color) -> float {
-    constexpr auto cutoff = 1.0F / 16.0F;
-    const auto intensity = std::max({color.x(), color.y(), color.z()});
-    return std::sqrt(std::max(intensity, 0.0F) / cutoff);
+template <typename AlignedLightT>
+auto make_light_buffer(GPUDevice& device, uint32_t light_capacity) -> Buffer {
+    return device.create_buffer(BufferInfo{
+        .usage = BufferUsage::ComputeStorageRead | BufferUsage::StorageRead,
+        .size = light_capacity * static_cast<uint32_t>(sizeof(AlignedLightT)),
+    });
 }
 
-template <typename T>
-auto upload_lights(
-    CopyPass& copy_pass,
-    TransferBuffer& transfer_buffer,
-    const Buffer& destination_buffer,
-    gsl::span<const T> lights
+auto make_light_culling_buffer(GPUDevice& device, uint32_t light_capacity)
+    -> Buffer {
+    return device.create_buffer(BufferInfo{
+        .usage = BufferUsage::ComputeStorageRead |
+            BufferUsage::ComputeStorageReadWrite,
+        .size = light_capacity * light_culling_data_size,
+    });
+}
+
+// Every one of count lights as a single range, for a light buffer that
+// holds none of them yet.
+auto collect_all_light_ranges(
+    uint32_t count, std::vector<SDL_GPUClusterPass::ChangedLightRange>& ranges
 ) -> void {
-    if (lights.empty()) {
-        return;
+    ranges.clear();
+    if (count > 0) {
+        ranges.push_back(SDL_GPUClusterPass::ChangedLightRange{
+            .begin = 0,
+            .end = count,
+            .staging_offset = 0,
+        });
+    }
+}
+
+// Stages ranges' lights back to back, for upload_changed_lights. Empty if
+// ranges is.
+template <typename T>
+auto stage_changed_lights(
+    StagingRing& staging_ring,
+    gsl::span<const T> lights,
+    gsl::span<const SDL_GPUClusterPass::ChangedLightRange> ranges
+) -> StagingAllocation {
+    if (ranges.empty()) {
+        return {};
     }
 
-    const auto size = static_cast<uint32_t>(lights.size() * sizeof(T));
-    const auto mapped = transfer_buffer.map(true);
-    std::memcpy(mapped.data(), lights.data(), size);
-    transfer_buffer.unmap();
+    // Ranges are staged back to back, so the last one ends at the total.
+    const auto& last_range = ranges.back();
+    const auto staged_count =
+        last_range.staging_offset + (last_range.end - last_range.begin);
+    const auto allocation = staging_ring.allocate(
+        staged_count * static_cast<uint32_t>(sizeof(T))
+    );
+    for (const auto& range : ranges) {
+        const auto source =
+            lights.subspan(range.begin, range.end - range.begin);
+        std::memcpy(
+            allocation.memory.data() + (range.staging_offset * sizeof(T)),
+            source.data(), source.size_bytes()
+        );
+    }
+
+    return allocation;
+}
 
-    copy_pass.upload_to_buffer(transfer_buffer, 0, destination_buffer, 0, size, true);
+// cycle = false: every light outside ranges must survive, so this writes
+// the current buffer in place (ordered after earlier frames' reads on the
+// GPU timeline) rather than a fresh one.
+template <typename T>
+auto upload_changed_lights(
+    CopyPass& copy_pass,
+    StagingRing& staging_ring,
+    const StagingAllocation& allocation,
+    gsl::span<const SDL_GPUClusterPass::ChangedLightRange> ranges,
+    const Buffer& destination
+) -> void {
+    for (const auto& range : ranges) {
+        staging_ring.upload(
+            copy_pass, allocation,
+            range.staging_offset * static_cast<uint32_t>(sizeof(T)),
+            destination, range.begin * static_cast<uint32_t>(sizeof(T)),
+            (range.end - range.begin) * static_cast<uint32_t>(sizeof(T)),
+            false
+        );
+    }
 }
 
 }  // namespace
 
 namespace Luminol::Graphics::SDL_GPU {
 
+auto adapt_light_index_list_settings(
+    const LightIndexListSettings& current,
+    const LightIndexListUsage& usage,
+    uint32_t budget_capacity
+) -> LightIndexListSettings {
+    auto next = current;
+    const auto required = uint64_t{usage.required_entry_count};
+
+    if (usage.dropped_entry_count > 0) {
+        // A quarter to spare, so a scene that's still gaining lights doesn't
+        // overflow again straight away.
+        const auto wanted =
+            std::max(uint64_t{current.capacity}, required + (required / 4));
+        next.capacity = static_cast<uint32_t>(
+            std::min(uint64_t{budget_capacity}, std::bit_ceil(wanted))
+        );
+        if (required > next.capacity) {
+            next.lights_per_cluster = std::max(
+                min_lights_per_cluster,
+                static_cast<uint32_t>(
+                    current.lights_per_cluster * uint64_t{next.capacity} /
+                    required
+                )
+            );
+        }
+        return next;
+    }
+
+    if (usage.clamped_cluster_count == 0 ||
+        current.lights_per_cluster >= max_lights_per_cluster) {
+        return next;
+    }
+
+    // Doubling lights_per_cluster at most doubles every cluster's list, so
+    // it's only relaxed once that still fits - otherwise the list grows
+    // first, as far as the budget allows.
+    if (required * 2 <= current.capacity) {
+        next.lights_per_cluster =
+            std::min(max_lights_per_cluster, current.lights_per_cluster * 2);
+    } else {
+        next.capacity = static_cast<uint32_t>(std::min(
+            uint64_t{budget_capacity},
+            std::max(uint64_t{current.capacity}, std::bit_ceil(required * 2))
+        ));
+    }
+    return next;
+}
+
 SDL_GPUClusterPass::SDL_GPUClusterPass(GPUDevice& device)
-    : aabb_build_pipeline{make_aabb_build_pipeline(device)},
-      light_count_pipeline{make_light_count_pipeline(device)},
-      light_scan_pipeline{make_light_scan_pipeline(device)},
-      light_compact_pipeline{make_light_compact_pipeline(device)},
+    : aabb_build_pipeline{
+          device.create_compute_pipeline(get_aabb_build_pipeline_info())
+      },
+      light_transform_pipeline{
+          device.create_compute_pipeline(get_light_transform_pipeline_info())
+      },
+      light_count_pipeline{
+          device.create_compute_pipeline(get_light_count_pipeline_info())
+      },
+      light_scan_pipeline{
+          device.create_compute_pipeline(get_light_scan_pipeline_info())
+      },
+      light_compact_pipeline{
+          device.create_compute_pipeline(get_light_compact_pipeline_info())
+      },
       cluster_aabb_buffer{device.create_buffer(BufferInfo{
           .usage = BufferUsage::ComputeStorageReadWrite,
           .size = cluster_aabb_buffer_size,
@@ -170,46 +323,69 @@ SDL_GPUClusterPass::SDL_GPUClusterPass(GPUDevice& device)
           .usage = BufferUsage::ComputeStorageReadWrite | BufferUsage::StorageRead,
           .size = cluster_light_grid_buffer_size,
       })},
-      global_light_index_list_buffer{device.create_buffer(BufferInfo{
-          .usage = BufferUsage::ComputeStorageReadWrite | BufferUsage::StorageRead,
-          .size = global_light_index_list_buffer_size,
-      })},
-      point_light_buffer{device.create_buffer(BufferInfo{
-          .usage = BufferUsage::ComputeStorageRead | BufferUsage::StorageRead,
-          .size = point_light_buffer_size,
-      })},
-      spot_light_buffer{device.create_buffer(BufferInfo{
-          .usage = BufferUsage::ComputeStorageRead | BufferUsage::StorageRead,
-          .size = spot_light_buffer_size,
-      })},
-      point_light_transfer_buffer{device.create_transfer_buffer(TransferBufferInfo{
-          .usage = TransferBufferUsage::Upload,
-          .size = point_light_buffer_size,
-      })},
-      spot_light_transfer_buffer{device.create_transfer_buffer(TransferBufferInfo{
-          .usage = TransferBufferUsage::Upload,
-          .size = spot_light_buffer_size,
-      })},
-      point_light_culling_buffer{device.create_buffer(BufferInfo{
-          .usage = BufferUsage::ComputeStorageRead,
-          .size = point_light_culling_buffer_size,
-      })},
-      spot_light_culling_buffer{device.create_buffer(BufferInfo{
-          .usage = BufferUsage::ComputeStorageRead,
-          .size = spot_light_culling_buffer_size,
+      light_index_list_settings{
+          .capacity = std::min(
+              get_light_index_budget_capacity(default_light_index_budget_bytes),
+              cluster_count * initial_light_index_entries_per_cluster
+          ),
+          .lights_per_cluster = max_lights_per_cluster,
+      },
+      global_light_index_list_buffer{make_light_index_list_buffer(
+          device, light_index_list_settings.capacity
+      )},
+      light_index_list_usage_buffer{device.create_buffer(BufferInfo{
+          .usage = BufferUsage::ComputeStorageReadWrite,
+          .size = light_index_list_usage_size,
       })},
-      point_light_culling_transfer_buffer{
-          device.create_transfer_buffer(TransferBufferInfo{
-              .usage = TransferBufferUsage::Upload,
-              .size = point_light_culling_buffer_size,
-          })
+      point_light_buffer{
+          make_light_buffer<AlignedPointLight>(device, initial_light_capacity)
+      },
+      spot_light_buffer{
+          make_light_buffer<AlignedSpotLight>(device, initial_light_capacity)
       },
-      spot_light_culling_transfer_buffer{
-          device.create_transfer_buffer(TransferBufferInfo{
-              .usage = TransferBufferUsage::Upload,
-              .size = spot_light_culling_buffer_size,
-          })
-      } {}
+      point_light_culling_buffer{
+          make_light_culling_buffer(device, initial_light_capacity)
+      },
+      spot_light_culling_buffer{
+          make_light_culling_buffer(device, initial_light_capacity)
+      },
+      z_bin_pass{device} {
+    // At most one entry or range per light, and only ever grown, so
+    // collecting changes only allocates when the light count does.
+    changed_index_scratch.reserve(initial_light_capacity);
+    point_light_ranges.reserve(initial_light_capacity);
+    spot_light_ranges.reserve(initial_light_capacity);
+
+    usage_readbacks.reserve(usage_readback_count);
+    for (auto i = uint32_t{0}; i < usage_readback_count; ++i) {
+        usage_readbacks.push_back(UsageReadback{
+            .transfer_buffer = device.create_transfer_buffer(TransferBufferInfo{
+                .usage = TransferBufferUsage::Download,
+                .size = light_index_list_usage_size,
+            }),
+            .settings = light_index_list_settings,
+        });
+    }
+}
+
+auto SDL_GPUClusterPass::get_shader_compile_requests()
+    -> ShaderCompileRequests {
+    auto requests = ShaderCompileRequests{
+        .shaders = {},
+        .compute_pipelines =
+            {
+                get_aabb_build_pipeline_info(),
+                get_light_transform_pipeline_info(),
+                get_light_count_pipeline_info(),
+                get_light_scan_pipeline_info(),
+                get_light_compact_pipeline_info(),
+            },
+    };
+    append_shader_compile_requests(
+        requests, SDL_GPUZBinPass::get_shader_compile_requests()
+    );
+    return requests;
+}
 
 auto SDL_GPUClusterPass::build_cluster_grid(
     CommandBuffer& command_buffer,
@@ -259,64 +435,121 @@ auto SDL_GPUClusterPass::build_cluster_grid(
 }
 
 auto SDL_GPUClusterPass::cull_lights(
+    GPUDevice& device,
+    const FramePacer& frame_pacer,
     CommandBuffer& command_buffer,
+    StagingRing& staging_ring,
     const Light& light_data,
     const Maths::Matrix4x4f& view_matrix
 ) -> void {
-    point_light_culling_data.clear();
-    for (auto i = uint32_t{0}; i < light_data.point_light_count; ++i) {
-        const auto& light = light_data.point_lights[i];
-        const auto view_position = transform_point(
-            view_matrix,
-            Maths::Vector3f{light.position.x(), light.position.y(), light.position.z()}
+    const auto point_lights =
+        gsl::span{light_data.point_lights}.first(light_data.point_light_count);
+    const auto spot_lights =
+        gsl::span{light_data.spot_lights}.first(light_data.spot_light_count);
+
+    read_back_light_index_list_usage(frame_pacer);
+    ensure_light_index_list_capacity(device);
+
+    const auto growth = ensure_light_buffer_capacity(
+        device, light_data.point_light_count, light_data.spot_light_count
+    );
+    if (growth.point_lights) {
+        collect_all_light_ranges(
+            light_data.point_light_count, point_light_ranges
+        );
+    } else {
+        collect_changed_light_ranges(
+            light_data.changed_point_lights, light_data.point_light_count,
+            point_light_ranges
         );
-        point_light_culling_data.push_back(Maths::Vector4f{
-            view_position.x(), view_position.y(), view_position.z(),
-            light_cull_radius(
-                Maths::Vector3f{light.color.x(), light.color.y(), light.color.z()}
-            )
-        });
     }
-
-    spot_light_culling_data.clear();
-    for (auto i = uint32_t{0}; i < light_data.spot_light_count; ++i) {
-        const auto& light = light_data.spot_lights[i];
-        const auto view_position = transform_point(
-            view_matrix,
-            Maths::Vector3f{light.position.x(), light.position.y(), light.position.z()}
+    if (growth.spot_lights) {
+        collect_all_light_ranges(
+            light_data.spot_light_count, spot_light_ranges
+        );
+    } else {
+        collect_changed_light_ranges(
+            light_data.changed_spot_lights, light_data.spot_light_count,
+            spot_light_ranges
         );
-        spot_light_culling_data.push_back(Maths::Vector4f{
-            view_position.x(), view_position.y(), view_position.z(),
-            light_cull_radius(light.color)
-        });
     }
 
-    {
+    // Both staged before the copy pass below records anything - see
+    // StagingRing's doc comment.
+    const auto point_light_staging = stage_changed_lights(
+        staging_ring, point_lights, gsl::span{point_light_ranges}
+    );
+    const auto spot_light_staging = stage_changed_lights(
+        staging_ring, spot_lights, gsl::span{spot_light_ranges}
+    );
+
+    if (!point_light_ranges.empty() || !spot_light_ranges.empty()) {
         auto copy_pass = command_buffer.begin_copy_pass();
-        upload_lights<AlignedPointLight>(
-            copy_pass,
-            point_light_transfer_buffer,
-            point_light_buffer,
-            gsl::span{light_data.point_lights}.first(light_data.point_light_count)
+        upload_changed_lights<AlignedPointLight>(
+            copy_pass, staging_ring, point_light_staging, point_light_ranges,
+            point_light_buffer
         );
-        upload_lights<AlignedSpotLight>(
-            copy_pass,
-            spot_light_transfer_buffer,
-            spot_light_buffer,
-            gsl::span{light_data.spot_lights}.first(light_data.spot_light_count)
+        upload_changed_lights<AlignedSpotLight>(
+            copy_pass, staging_ring, spot_light_staging, spot_light_ranges,
+            spot_light_buffer
         );
-        upload_lights<Maths::Vector4f>(
-            copy_pass,
-            point_light_culling_transfer_buffer,
-            point_light_culling_buffer,
-            gsl::span{point_light_culling_data}
+    }
+
+    const auto light_dispatch_group_count =
+        (std::max(light_data.point_light_count, light_data.spot_light_count) +
+         threads_per_group - 1) /
+        threads_per_group;
+    if (light_dispatch_group_count > 0) {
+        const auto transform_params = ClusterLightTransformParams{
+            .view_matrix = view_matrix,
+            .counts =
+                {light_data.point_light_count,
+                 light_data.spot_light_count,
+                 0,
+                 0},
+        };
+        const auto light_buffers = std::array<const Buffer* const, 2>{
+            &point_light_buffer, &spot_light_buffer
+        };
+        const auto storage_bindings =
+            std::array<StorageBufferReadWriteBinding, 2>{
+                StorageBufferReadWriteBinding{
+                    .buffer = &point_light_culling_buffer, .cycle = false
+                },
+                StorageBufferReadWriteBinding{
+                    .buffer = &spot_light_culling_buffer, .cycle = false
+                },
+            };
+        auto compute_pass =
+            command_buffer.begin_compute_pass({}, storage_bindings);
+        compute_pass.bind_storage_buffers(0, light_buffers);
+        command_buffer.push_compute_uniform_data(
+            0,
+            gsl::span<const std::byte>{
+                reinterpret_cast<const std::byte*>(&transform_params),
+                sizeof(transform_params)
+            }
         );
-        upload_lights<Maths::Vector4f>(
-            copy_pass,
-            spot_light_culling_transfer_buffer,
-            spot_light_culling_buffer,
-            gsl::span{spot_light_culling_data}
+        compute_pass.bind_compute_pipeline(light_transform_pipeline);
+        compute_pass.dispatch(light_dispatch_group_count, 1, 1);
+    }
+
+    if (culling_mode == LightCullingMode::ZBinned) {
+        z_bin_pass.cull_lights(
+            device, command_buffer, point_light_culling_buffer,
+            spot_light_culling_buffer, light_data.point_light_count,
+            light_data.spot_light_count,
+            ZBinProjection{
+                .tan_half_fov_y = std::tan(
+                    cached_fov_degrees *
+                    (std::numbers::pi_v<float> / 180.0F) / 2.0F
+                ),
+                .aspect_ratio = cached_aspect_ratio,
+                .near_plane = cached_near_plane,
+                .far_plane = cached_far_plane,
+            }
         );
+        return;
     }
 
     const auto cull_params = ClusterCullParams{
@@ -324,7 +557,8 @@ auto SDL_GPUClusterPass::cull_lights(
             {light_data.point_light_count,
              light_data.spot_light_count,
              cluster_count,
-             0},
+             light_index_list_settings.lights_per_cluster},
+        .index_list = {light_index_list_settings.capacity, 0, 0, 0},
     };
 
     const auto light_culling_buffers = std::array<const Buffer* const, 2>{
@@ -359,10 +593,13 @@ auto SDL_GPUClusterPass::cull_lights(
             .params = {cluster_count, 0, 0, 0},
         };
         const auto storage_bindings =
-            std::array<StorageBufferReadWriteBinding, 1>{
+            std::array<StorageBufferReadWriteBinding, 2>{
                 StorageBufferReadWriteBinding{
                     .buffer = &cluster_light_grid_buffer, .cycle = false
                 },
+                StorageBufferReadWriteBinding{
+                    .buffer = &light_index_list_usage_buffer, .cycle = false
+                },
             };
         auto compute_pass = command_buffer.begin_compute_pass({}, storage_bindings);
         command_buffer.push_compute_uniform_data(
@@ -378,7 +615,7 @@ auto SDL_GPUClusterPass::cull_lights(
 
     {
         const auto storage_bindings =
-            std::array<StorageBufferReadWriteBinding, 3>{
+            std::array<StorageBufferReadWriteBinding, 4>{
                 StorageBufferReadWriteBinding{
                     .buffer = &cluster_aabb_buffer, .cycle = false
                 },
@@ -388,6 +625,9 @@ auto SDL_GPUClusterPass::cull_lights(
                 StorageBufferReadWriteBinding{
                     .buffer = &global_light_index_list_buffer, .cycle = false
                 },
+                StorageBufferReadWriteBinding{
+                    .buffer = &light_index_list_usage_buffer, .cycle = false
+                },
             };
         auto compute_pass = command_buffer.begin_compute_pass({}, storage_bindings);
         compute_pass.bind_storage_buffers(0, light_culling_buffers);
@@ -401,6 +641,198 @@ auto SDL_GPUClusterPass::cull_lights(
         compute_pass.bind_compute_pipeline(light_compact_pipeline);
         compute_pass.dispatch(dispatch_group_count, 1, 1);
     }
+
+    record_usage_readback(command_buffer);
+}
+
+auto SDL_GPUClusterPass::end_frame(uint64_t frame) -> void {
+    for (auto& readback : usage_readbacks) {
+        if (readback.awaiting_frame) {
+            readback.frame = frame;
+            readback.awaiting_frame = false;
+        }
+    }
+}
+
+auto SDL_GPUClusterPass::set_culling_mode(LightCullingMode mode) -> void {
+    culling_mode = mode;
+}
+
+auto SDL_GPUClusterPass::get_culling_mode() const -> LightCullingMode {
+    return culling_mode;
+}
+
+auto SDL_GPUClusterPass::get_z_bin_pass() const -> const SDL_GPUZBinPass& {
+    return z_bin_pass;
+}
+
+auto SDL_GPUClusterPass::set_light_index_budget(uint32_t budget_bytes)
+    -> void {
+    light_index_budget = budget_bytes;
+    light_index_list_settings.capacity = std::min(
+        light_index_list_settings.capacity,
+        get_light_index_budget_capacity(budget_bytes)
+    );
+}
+
+auto SDL_GPUClusterPass::get_light_index_budget() const -> uint32_t {
+    return light_index_budget;
+}
+
+auto SDL_GPUClusterPass::get_light_index_list_settings() const
+    -> LightIndexListSettings {
+    return light_index_list_settings;
+}
+
+auto SDL_GPUClusterPass::get_last_light_index_list_usage() const
+    -> LightIndexListUsage {
+    return last_light_index_list_usage;
+}
+
+auto SDL_GPUClusterPass::read_back_light_index_list_usage(
+    const FramePacer& frame_pacer
+) -> void {
+    while (true) {
+        auto* oldest = static_cast<UsageReadback*>(nullptr);
+        for (auto& readback : usage_readbacks) {
+            const auto is_finished = readback.in_use &&
+                !readback.awaiting_frame &&
+                frame_pacer.is_frame_complete(readback.frame);
+            if (is_finished &&
+                (oldest == nullptr || readback.frame < oldest->frame)) {
+                oldest = &readback;
+            }
+        }
+        if (oldest == nullptr) {
+            return;
+        }
+
+        auto values = std::array<uint32_t, 4>{};
+        const auto mapped = oldest->transfer_buffer.map(false);
+        std::memcpy(values.data(), mapped.data(), sizeof(values));
+        oldest->transfer_buffer.unmap();
+        oldest->in_use = false;
+
+        // Culled with settings already adapted past (or replaced by
+        // set_light_index_budget) - its usage says nothing about the
+        // current ones.
+        if (oldest->settings != light_index_list_settings) {
+            continue;
+        }
+
+        last_light_index_list_usage = LightIndexListUsage{
+            .required_entry_count = values[0],
+            .dropped_entry_count = values[1],
+            .clamped_cluster_count = values[2],
+        };
+        light_index_list_settings = adapt_light_index_list_settings(
+            light_index_list_settings, last_light_index_list_usage,
+            get_light_index_budget_capacity(light_index_budget)
+        );
+    }
+}
+
+auto SDL_GPUClusterPass::ensure_light_index_list_capacity(GPUDevice& device)
+    -> void {
+    const auto size = light_index_list_settings.capacity * light_index_size;
+    if (global_light_index_list_buffer.get_size() == size) {
+        return;
+    }
+
+    // SDL_GPU defers releasing the replaced buffer until the GPU is done
+    // with it. Nothing carries over - the compact pass rewrites every
+    // cluster's list each frame.
+    global_light_index_list_buffer = make_light_index_list_buffer(
+        device, light_index_list_settings.capacity
+    );
+}
+
+auto SDL_GPUClusterPass::record_usage_readback(CommandBuffer& command_buffer)
+    -> void {
+    const auto free_readback = std::ranges::find_if(
+        usage_readbacks,
+        [](const UsageReadback& readback) { return !readback.in_use; }
+    );
+    if (free_readback == usage_readbacks.end()) {
+        return;
+    }
+
+    {
+        auto copy_pass = command_buffer.begin_copy_pass();
+        copy_pass.download_from_buffer(
+            light_index_list_usage_buffer, 0, free_readback->transfer_buffer,
+            0, light_index_list_usage_size
+        );
+    }
+    free_readback->settings = light_index_list_settings;
+    free_readback->in_use = true;
+    free_readback->awaiting_frame = true;
+}
+
+auto SDL_GPUClusterPass::ensure_light_buffer_capacity(
+    GPUDevice& device, uint32_t point_light_count, uint32_t spot_light_count
+) -> LightBufferGrowth {
+    const auto growth = LightBufferGrowth{
+        .point_lights = point_light_buffer.get_size() <
+            point_light_count * sizeof(AlignedPointLight),
+        .spot_lights = spot_light_buffer.get_size() <
+            spot_light_count * sizeof(AlignedSpotLight),
+    };
+
+    // SDL_GPU defers releasing the replaced buffers until the GPU is done
+    // with them.
+    if (growth.point_lights) {
+        const auto capacity = std::bit_ceil(point_light_count);
+        point_light_buffer =
+            make_light_buffer<AlignedPointLight>(device, capacity);
+        point_light_culling_buffer =
+            make_light_culling_buffer(device, capacity);
+    }
+    if (growth.spot_lights) {
+        const auto capacity = std::bit_ceil(spot_light_count);
+        spot_light_buffer =
+            make_light_buffer<AlignedSpotLight>(device, capacity);
+        spot_light_culling_buffer =
+            make_light_culling_buffer(device, capacity);
+    }
+
+    return growth;
+}
+
+auto SDL_GPUClusterPass::collect_changed_light_ranges(
+    gsl::span<const uint32_t> changed,
+    uint32_t count,
+    std::vector<ChangedLightRange>& ranges
+) -> void {
+    auto& indices = changed_index_scratch;
+    indices.clear();
+    for (const auto index : changed) {
+        if (index < count) {
+            indices.push_back(index);
+        }
+    }
+    std::ranges::sort(indices);
+
+    // Coalesce nearby lights, re-uploading the few unchanged ones between
+    // them, so scattered changes don't become one copy per light.
+    ranges.clear();
+    auto staged_count = uint32_t{0};
+    for (auto index = std::size_t{0}; index < indices.size();) {
+        const auto begin = indices[index];
+        auto end = begin + 1;
+        for (++index; index < indices.size() &&
+             indices[index] <= end + max_changed_range_gap;
+             ++index) {
+            end = indices[index] + 1;
+        }
+
+        ranges.push_back(ChangedLightRange{
+            .begin = begin,
+            .end = end,
+            .staging_offset = staged_count,
+        });
+        staged_count += end - begin;
+    }
 }
 
 auto SDL_GPUClusterPass::get_cluster_aabb_buffer() const -> const Buffer& {
@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <vector>
 
+#include <gsl/gsl>
 #include <LuminolMaths/Matrix.hpp>
 #include <LuminolMaths/Vector.hpp>
 
@@ -10,11 +11,15 @@
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUBuffer.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUComputePipeline.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUTransferBuffer.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/Lighting/SDL_GPUZBinPass.hpp>
 
 namespace Luminol::Graphics::SDL_GPU {
 
 class GPUDevice;
+struct ShaderCompileRequests;
 class CommandBuffer;
+class FramePacer;
+class StagingRing;
 
 // 16x9x24 froxel grid = 3456 clusters. Z is sliced exponentially (Doom 2016
 // style) so slice thickness scales with distance from the camera, matching
@@ -24,18 +29,77 @@ constexpr auto cluster_grid_y = uint32_t{9};
 constexpr auto cluster_grid_z = uint32_t{24};
 constexpr auto cluster_count = cluster_grid_x * cluster_grid_y * cluster_grid_z;
 
-// No cluster can match more lights than exist in the scene, so sizing the
-// global index list to cluster_count * max_lights_per_cluster can never
-// overflow (see cluster_light_scan.hlsl).
-constexpr auto max_lights_per_cluster = max_point_lights + max_spot_lights;
-constexpr auto global_light_index_capacity = cluster_count * max_lights_per_cluster;
+// Most lights one cluster's list holds - point lights first, then spot
+// lights. The count kernel clamps every cluster to the current
+// LightIndexListSettings::lights_per_cluster, which adapts between
+// min_lights_per_cluster and this; a cluster matching more keeps the most
+// important ones (see cluster_light_count.hlsl).
+constexpr auto max_lights_per_cluster = uint32_t{2048};
+constexpr auto min_lights_per_cluster = uint32_t{32};
+
+// Ceiling on the global light index list - 2M entries, against the ~28 MiB
+// a list with room for max_lights_per_cluster in every cluster would take.
+constexpr auto default_light_index_budget_bytes = uint32_t{8} << 20U;
+
+// How big the global light index list is, and how many lights each cluster
+// may keep in it - adapted from LightIndexListUsage a few frames later.
+struct LightIndexListSettings {
+    // In entries (light indices).
+    uint32_t capacity;
+    uint32_t lights_per_cluster;
+
+    auto operator==(const LightIndexListSettings&) const -> bool = default;
+};
+
+// What culling with one LightIndexListSettings took, as written on the GPU
+// by cluster_light_scan.hlsl and cluster_light_compact.hlsl.
+struct LightIndexListUsage {
+    // Entries every cluster's (already lights_per_cluster-clamped) list
+    // needed, kept or not.
+    uint32_t required_entry_count = 0;
+    // Of those, entries that didn't fit in the list and were dropped - the
+    // clusters past the end were culled with fewer lights than they hit.
+    uint32_t dropped_entry_count = 0;
+    // Clusters that matched more than lights_per_cluster lights and kept
+    // only the most important.
+    uint32_t clamped_cluster_count = 0;
+};
+
+// How SDL_GPUClusterPass::cull_lights() culls lights for pbr_frag.hlsl:
+// Clustered builds per-cluster light index lists over the cluster grid,
+// ZBinned per-tile light bitmasks and depth bins (see SDL_GPUZBinPass). The
+// values are what pbr_frag.hlsl compares cluster_params.z against.
+enum class LightCullingMode : uint8_t { Clustered = 0, ZBinned = 1 };
+
+// Settings for the frames after one culled with current reported usage,
+// never growing the list past budget_capacity entries: an overflowing list
+// grows to fit with some headroom, and when even budget_capacity can't fit
+// it, lights_per_cluster shrinks in proportion instead. Once the list has
+// room to spare, a clamped lights_per_cluster doubles back up, and the list
+// grows toward the budget to make room for it.
+[[nodiscard]] auto adapt_light_index_list_settings(
+    const LightIndexListSettings& current,
+    const LightIndexListUsage& usage,
+    uint32_t budget_capacity
+) -> LightIndexListSettings;
 
 // Owns the Clustered Forward+ cluster AABB grid and per-cluster light index
 // lists (built via a 3-pass count -> scan -> compact compute pipeline).
+//
+// The global light index list is sized from a budget rather than for the
+// worst case. Every cull_lights() downloads the frame's LightIndexListUsage
+// into one of a few small transfer buffers, and a later cull_lights() reads
+// it once the frame has finished on the GPU - never waiting on it - and
+// adapts the list's settings (see adapt_light_index_list_settings). Until
+// then, clusters past the end of an overflowing list lose lights for a few
+// frames, and that's the only cost of the list being too small.
 class SDL_GPUClusterPass {
 public:
     SDL_GPUClusterPass(GPUDevice& device);
 
+    [[nodiscard]] static auto get_shader_compile_requests()
+        -> ShaderCompileRequests;
+
     // Rebuilds the cluster AABB grid via a compute pass, but only if the
     // projection parameters differ from the last build (dirty-checked), so
     // a static camera projection doesn't pay the compute cost every frame.
@@ -48,17 +112,52 @@ public:
         float far_plane
     ) -> void;
 
-    // Uploads the current point/spot lights and culls them against every
-    // cluster, producing get_cluster_light_grid_buffer() and
-    // get_global_light_index_list_buffer(). Must be called after
+    // Uploads the point/spot lights light_data lists as changed through
+    // staging_ring - nothing, when none changed - and culls them against
+    // every cluster, producing get_cluster_light_grid_buffer() and
+    // get_global_light_index_list_buffer(). The light buffers are patched in
+    // place, so every call must see every change since the last one (see
+    // LightManager::clear_changes). The light buffers grow to fit the light
+    // counts, re-uploading every light when they do. Must be called after
     // build_cluster_grid() on the same command buffer (or a later one), and
     // while no render/copy pass on command_buffer is open.
+    //
+    // Also reads back any earlier frame's LightIndexListUsage frame_pacer
+    // reports finished, and adapts the global light index list to it.
     auto cull_lights(
+        GPUDevice& device,
+        const FramePacer& frame_pacer,
         CommandBuffer& command_buffer,
+        StagingRing& staging_ring,
         const Light& light_data,
         const Maths::Matrix4x4f& view_matrix
     ) -> void;
 
+    // Takes effect from the next cull_lights(). In ZBinned mode,
+    // cull_lights() produces get_z_bin_pass()'s buffers instead of the
+    // cluster light grid and global light index list, and reads back no
+    // LightIndexListUsage.
+    auto set_culling_mode(LightCullingMode mode) -> void;
+    [[nodiscard]] auto get_culling_mode() const -> LightCullingMode;
+    [[nodiscard]] auto get_z_bin_pass() const -> const SDL_GPUZBinPass&;
+
+    // Closes the frame: frame (from FramePacer::submit() of the command
+    // buffer cull_lights() last recorded into) gates reading back its
+    // LightIndexListUsage.
+    auto end_frame(uint64_t frame) -> void;
+
+    // Caps the global light index list at budget_bytes (at least one entry
+    // per cluster). A smaller budget than the list's size shrinks it from
+    // the next cull_lights().
+    auto set_light_index_budget(uint32_t budget_bytes) -> void;
+    [[nodiscard]] auto get_light_index_budget() const -> uint32_t;
+
+    [[nodiscard]] auto get_light_index_list_settings() const
+        -> LightIndexListSettings;
+    // The newest LightIndexListUsage read back - from a frame or few ago.
+    [[nodiscard]] auto get_last_light_index_list_usage() const
+        -> LightIndexListUsage;
+
     [[nodiscard]] auto get_cluster_aabb_buffer() const -> const Buffer&;
     [[nodiscard]] auto get_cluster_light_grid_buffer() const -> const Buffer&;
     [[nodiscard]] auto get_global_light_index_list_buffer() const
@@ -66,35 +165,98 @@ public:
     [[nodiscard]] auto get_point_light_buffer() const -> const Buffer&;
     [[nodiscard]] auto get_spot_light_buffer() const -> const Buffer&;
 
+    // A run of changed packed lights, copied from staging_offset lights into
+    // the frame's staging to [begin, end) of the light buffer.
+    struct ChangedLightRange {
+        uint32_t begin;
+        uint32_t end;
+        uint32_t staging_offset;
+    };
+
 private:
+    // A download of light_index_list_usage_buffer, readable once frame
+    // finishes - frame is only known once end_frame() is called, so
+    // awaiting_frame is set until then.
+    struct UsageReadback {
+        TransferBuffer transfer_buffer;
+        LightIndexListSettings settings;
+        uint64_t frame = 0;
+        bool in_use = false;
+        bool awaiting_frame = false;
+    };
+
+    // Adapts light_index_list_settings to every finished readback, oldest
+    // first, skipping any culled with settings since replaced.
+    auto read_back_light_index_list_usage(const FramePacer& frame_pacer)
+        -> void;
+
+    // Recreates global_light_index_list_buffer if it isn't the size
+    // light_index_list_settings asks for.
+    auto ensure_light_index_list_capacity(GPUDevice& device) -> void;
+
+    // Records a download of this frame's usage into a free readback, if
+    // there is one - otherwise this frame isn't read back.
+    auto record_usage_readback(CommandBuffer& command_buffer) -> void;
+
+    // Recreates point_light_buffer/point_light_culling_buffer (and the spot
+    // ones) with room for at least the given counts if they're too small.
+    // Returns whether each was, since a recreated light buffer holds none
+    // of the lights uploaded before.
+    struct LightBufferGrowth {
+        bool point_lights;
+        bool spot_lights;
+    };
+    auto ensure_light_buffer_capacity(
+        GPUDevice& device, uint32_t point_light_count, uint32_t spot_light_count
+    ) -> LightBufferGrowth;
+
+    // Sorts changed's indices below count into coalesced ranges, written
+    // to ranges.
+    auto collect_changed_light_ranges(
+        gsl::span<const uint32_t> changed,
+        uint32_t count,
+        std::vector<ChangedLightRange>& ranges
+    ) -> void;
+
     ComputePipeline aabb_build_pipeline;
+    ComputePipeline light_transform_pipeline;
     ComputePipeline light_count_pipeline;
     ComputePipeline light_scan_pipeline;
     ComputePipeline light_compact_pipeline;
 
     Buffer cluster_aabb_buffer;
     Buffer cluster_light_grid_buffer;
+    // Before global_light_index_list_buffer, which is sized from it.
+    LightIndexListSettings light_index_list_settings;
     Buffer global_light_index_list_buffer;
+    // uint4: x = required, y = dropped, z = clamped - see
+    // LightIndexListUsage.
+    Buffer light_index_list_usage_buffer;
+
+    uint32_t light_index_budget = default_light_index_budget_bytes;
+    LightIndexListUsage last_light_index_list_usage;
+    std::vector<UsageReadback> usage_readbacks;
 
     Buffer point_light_buffer;
     Buffer spot_light_buffer;
-    TransferBuffer point_light_transfer_buffer;
-    TransferBuffer spot_light_transfer_buffer;
 
-    // Per-light view-space position (xyz) + cull radius (w), precomputed
-    // once per frame on the CPU and read directly by the count/compact
+    // Per-light view-space position (xyz) + cull radius (w), computed once
+    // per frame from point_light_buffer/spot_light_buffer by
+    // cluster_light_transform.hlsl and read directly by the count/compact
     // shaders - avoids each of the 3456 clusters redundantly recomputing the
-    // same world-to-view transform and radius for every light. Distinct from
+    // same world-to-view transform and radius for every light, without
+    // re-uploading every light whenever the camera moves. Distinct from
     // point_light_buffer/spot_light_buffer above, which stay in world space
     // since they're also bound directly for shading (pbr_frag.hlsl).
     Buffer point_light_culling_buffer;
     Buffer spot_light_culling_buffer;
-    TransferBuffer point_light_culling_transfer_buffer;
-    TransferBuffer spot_light_culling_transfer_buffer;
-    // Persisted across frames so their heap capacity carries over instead of
-    // being reallocated every frame.
-    std::vector<Maths::Vector4f> point_light_culling_data;
-    std::vector<Maths::Vector4f> spot_light_culling_data;
+
+    std::vector<uint32_t> changed_index_scratch;
+    std::vector<ChangedLightRange> point_light_ranges;
+    std::vector<ChangedLightRange> spot_light_ranges;
+
+    LightCullingMode culling_mode = LightCullingMode::Clustered;
+    SDL_GPUZBinPass z_bin_pass;
 
     bool has_built = false;
     float cached_fov_degrees = 0.0F;
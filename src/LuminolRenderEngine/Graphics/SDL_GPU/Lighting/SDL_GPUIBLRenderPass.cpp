@@ -76,6 +76,36 @@ auto make_cube_texture(GPUDevice& device, uint32_t size, uint32_t mip_levels)
     });
 }
 
+auto get_cubemap_face_vertex_shader_info() -> ShaderInfo {
+    return make_hlsl_shader_info(
+        "res/shaders/sdl_gpu/skybox_vert.hlsl", ShaderStage::Vertex, 0U, 1U
+    );
+}
+
+auto get_irradiance_fragment_shader_info() -> ShaderInfo {
+    return make_hlsl_shader_info(
+        "res/shaders/sdl_gpu/irradiance_convolve_frag.hlsl",
+        ShaderStage::Fragment,
+        1U,
+        0U
+    );
+}
+
+auto get_prefilter_fragment_shader_info() -> ShaderInfo {
+    return make_hlsl_shader_info(
+        "res/shaders/sdl_gpu/prefilter_specular_frag.hlsl",
+        ShaderStage::Fragment,
+        1U,
+        1U
+    );
+}
+
+auto get_brdf_lut_fragment_shader_info() -> ShaderInfo {
+    return make_hlsl_shader_info(
+        "res/shaders/sdl_gpu/brdf_lut_frag.hlsl", ShaderStage::Fragment
+    );
+}
+
 }  // namespace
 
 namespace Luminol::Graphics::SDL_GPU {
@@ -85,27 +115,15 @@ SDL_GPUIBLRenderPass::SDL_GPUIBLRenderPass(
     const Texture& skybox_texture,
     const Sampler& skybox_sampler
 )
-    : cubemap_face_vertex_shader{make_hlsl_shader(
-          device,
-          "res/shaders/sdl_gpu/skybox_vert.hlsl",
-          ShaderStage::Vertex,
-          0U,
-          1U
-      )},
-      irradiance_fragment_shader{make_hlsl_shader(
-          device,
-          "res/shaders/sdl_gpu/irradiance_convolve_frag.hlsl",
-          ShaderStage::Fragment,
-          1U,
-          0U
-      )},
-      prefilter_fragment_shader{make_hlsl_shader(
-          device,
-          "res/shaders/sdl_gpu/prefilter_specular_frag.hlsl",
-          ShaderStage::Fragment,
-          1U,
-          1U
-      )},
+    : cubemap_face_vertex_shader{
+          device.create_shader(get_cubemap_face_vertex_shader_info())
+      },
+      irradiance_fragment_shader{
+          device.create_shader(get_irradiance_fragment_shader_info())
+      },
+      prefilter_fragment_shader{
+          device.create_shader(get_prefilter_fragment_shader_info())
+      },
       irradiance_pipeline{make_fullscreen_pipeline(
           device, cubemap_face_vertex_shader, irradiance_fragment_shader,
           ibl_texture_format
@@ -114,14 +132,12 @@ SDL_GPUIBLRenderPass::SDL_GPUIBLRenderPass(
           device, cubemap_face_vertex_shader, prefilter_fragment_shader,
           ibl_texture_format
       )},
-      fullscreen_vertex_shader{make_hlsl_shader(
-          device, "res/shaders/sdl_gpu/fullscreen_vert.hlsl",
-          ShaderStage::Vertex
-      )},
-      brdf_lut_fragment_shader{make_hlsl_shader(
-          device, "res/shaders/sdl_gpu/brdf_lut_frag.hlsl",
-          ShaderStage::Fragment
-      )},
+      fullscreen_vertex_shader{
+          device.create_shader(get_fullscreen_vertex_shader_info())
+      },
+      brdf_lut_fragment_shader{
+          device.create_shader(get_brdf_lut_fragment_shader_info())
+      },
       brdf_lut_pipeline{make_fullscreen_pipeline(
           device, fullscreen_vertex_shader, brdf_lut_fragment_shader,
           ibl_texture_format
@@ -234,6 +250,21 @@ SDL_GPUIBLRenderPass::SDL_GPUIBLRenderPass(
     command_buffer.submit();
 }
 
+auto SDL_GPUIBLRenderPass::get_shader_compile_requests()
+    -> ShaderCompileRequests {
+    return ShaderCompileRequests{
+        .shaders =
+            {
+                get_cubemap_face_vertex_shader_info(),
+                get_irradiance_fragment_shader_info(),
+                get_prefilter_fragment_shader_info(),
+                get_fullscreen_vertex_shader_info(),
+                get_brdf_lut_fragment_shader_info(),
+            },
+        .compute_pipelines = {},
+    };
+}
+
 auto SDL_GPUIBLRenderPass::get_irradiance_texture() const -> const Texture& {
     return irradiance_texture;
 }
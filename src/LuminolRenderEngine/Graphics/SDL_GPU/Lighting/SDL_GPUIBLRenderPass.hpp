@@ -9,6 +9,7 @@
 namespace Luminol::Graphics::SDL_GPU {
 
 class GPUDevice;
+struct ShaderCompileRequests;
 
 // Precomputes the three components of split-sum image-based lighting from
 // the already-uploaded skybox cubemap: an irradiance cubemap (diffuse IBL),
@@ -24,6 +25,9 @@ public:
         const Sampler& skybox_sampler
     );
 
+    [[nodiscard]] static auto get_shader_compile_requests()
+        -> ShaderCompileRequests;
+
     [[nodiscard]] auto get_irradiance_texture() const -> const Texture&;
     [[nodiscard]] auto get_irradiance_sampler() const -> const Sampler&;
 
@@ -0,0 +1,349 @@
+#include "SDL_GPUZBinPass.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+
+#include <gsl/gsl>
+
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUCommandBuffer.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/RenderPasses/SDL_GPUComputePass.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUDevice.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUResourceBuilders.hpp>
+
+namespace {
+
+using namespace Luminol::Graphics::SDL_GPU;
+
+// Lights sorted per light_sort_local.hlsl thread group - two per thread.
+constexpr auto sort_block_size = uint32_t{1024};
+constexpr auto sort_local_threads = sort_block_size / 2;
+constexpr auto sort_global_threads = uint32_t{256};
+constexpr auto bin_threads = uint32_t{64};
+
+// uint2(depth key, light) per sorted slot - see light_sort_local.hlsl.
+constexpr auto sorted_light_size = uint32_t{8};
+// uint first + uint last sorted light per bin.
+constexpr auto z_bin_size = uint32_t{8};
+constexpr auto bits_per_mask_word = uint32_t{32};
+constexpr auto mask_word_size = static_cast<uint32_t>(sizeof(uint32_t));
+
+// Mirrors cbuffer LightSortParams in light_sort_local.hlsl and
+// light_sort_global.hlsl - params differ between the two, see each.
+struct LightSortParams {
+    std::array<uint32_t, 4> params;
+};
+
+// Mirrors cbuffer LightBinParams in light_tile_cull.hlsl and
+// light_z_bin.hlsl.
+struct LightBinParams {
+    std::array<float, 4> camera;
+    std::array<uint32_t, 4> params;
+};
+
+auto get_sort_local_pipeline_info() -> ComputePipelineInfo {
+    return ComputePipelineInfo{
+        .path = "res/shaders/sdl_gpu/light_sort_local.hlsl",
+        .source_language = ShaderSourceLanguage::Hlsl,
+        .readonly_storage_buffer_count = 2,
+        .readwrite_storage_buffer_count = 1,
+        .uniform_buffer_count = 1,
+        .threadcount_x = sort_local_threads,
+        .threadcount_y = 1,
+        .threadcount_z = 1,
+    };
+}
+
+auto get_sort_global_pipeline_info() -> ComputePipelineInfo {
+    return ComputePipelineInfo{
+        .path = "res/shaders/sdl_gpu/light_sort_global.hlsl",
+        .source_language = ShaderSourceLanguage::Hlsl,
+        .readwrite_storage_buffer_count = 1,
+        .uniform_buffer_count = 1,
+        .threadcount_x = sort_global_threads,
+        .threadcount_y = 1,
+        .threadcount_z = 1,
+    };
+}
+
+auto get_tile_cull_pipeline_info() -> ComputePipelineInfo {
+    return ComputePipelineInfo{
+        .path = "res/shaders/sdl_gpu/light_tile_cull.hlsl",
+        .source_language = ShaderSourceLanguage::Hlsl,
+        .readonly_storage_buffer_count = 3,
+        .readwrite_storage_buffer_count = 2,
+        .uniform_buffer_count = 1,
+        .threadcount_x = bin_threads,
+        .threadcount_y = 1,
+        .threadcount_z = 1,
+    };
+}
+
+auto get_z_bin_pipeline_info() -> ComputePipelineInfo {
+    return ComputePipelineInfo{
+        .path = "res/shaders/sdl_gpu/light_z_bin.hlsl",
+        .source_language = ShaderSourceLanguage::Hlsl,
+        .readonly_storage_buffer_count = 3,
+        .readwrite_storage_buffer_count = 1,
+        .uniform_buffer_count = 1,
+        .threadcount_x = bin_threads,
+        .threadcount_y = 1,
+        .threadcount_z = 1,
+    };
+}
+
+// Sorted slots for light_count lights - bitonic sort needs a power of two,
+// and at least one whole block.
+auto get_sort_capacity(uint32_t light_count) -> uint32_t {
+    return std::max(sort_block_size, std::bit_ceil(light_count));
+}
+
+auto make_depth_sorted_light_buffer(GPUDevice& device, uint32_t sort_capacity)
+    -> Buffer {
+    return device.create_buffer(BufferInfo{
+        .usage = BufferUsage::ComputeStorageRead |
+            BufferUsage::ComputeStorageReadWrite | BufferUsage::StorageRead,
+        .size = sort_capacity * sorted_light_size,
+    });
+}
+
+auto make_light_tile_mask_buffer(GPUDevice& device, uint32_t sort_capacity)
+    -> Buffer {
+    return device.create_buffer(BufferInfo{
+        .usage = BufferUsage::ComputeStorageReadWrite |
+            BufferUsage::StorageRead,
+        .size = light_tile_count * (sort_capacity / bits_per_mask_word) *
+            mask_word_size,
+    });
+}
+
+template <typename T>
+auto push_params(CommandBuffer& command_buffer, const T& params) -> void {
+    command_buffer.push_compute_uniform_data(
+        0,
+        gsl::span<const std::byte>{
+            reinterpret_cast<const std::byte*>(&params), sizeof(params)
+        }
+    );
+}
+
+}  // namespace
+
+namespace Luminol::Graphics::SDL_GPU {
+
+SDL_GPUZBinPass::SDL_GPUZBinPass(GPUDevice& device)
+    : sort_local_pipeline{
+          device.create_compute_pipeline(get_sort_local_pipeline_info())
+      },
+      sort_global_pipeline{
+          device.create_compute_pipeline(get_sort_global_pipeline_info())
+      },
+      tile_cull_pipeline{
+          device.create_compute_pipeline(get_tile_cull_pipeline_info())
+      },
+      z_bin_pipeline{
+          device.create_compute_pipeline(get_z_bin_pipeline_info())
+      },
+      light_z_bin_buffer{device.create_buffer(BufferInfo{
+          .usage = BufferUsage::ComputeStorageReadWrite |
+              BufferUsage::StorageRead,
+          .size = light_z_bin_count * z_bin_size,
+      })},
+      light_tile_mask_buffer{
+          make_light_tile_mask_buffer(device, get_sort_capacity(0))
+      },
+      depth_sorted_light_buffer{
+          make_depth_sorted_light_buffer(device, get_sort_capacity(0))
+      } {}
+
+auto SDL_GPUZBinPass::get_shader_compile_requests() -> ShaderCompileRequests {
+    return ShaderCompileRequests{
+        .shaders = {},
+        .compute_pipelines =
+            {
+                get_sort_local_pipeline_info(),
+                get_sort_global_pipeline_info(),
+                get_tile_cull_pipeline_info(),
+                get_z_bin_pipeline_info(),
+            },
+    };
+}
+
+auto SDL_GPUZBinPass::cull_lights(
+    GPUDevice& device,
+    CommandBuffer& command_buffer,
+    const Buffer& point_light_culling_buffer,
+    const Buffer& spot_light_culling_buffer,
+    uint32_t point_light_count,
+    uint32_t spot_light_count,
+    const ZBinProjection& projection
+) -> void {
+    const auto light_count = point_light_count + spot_light_count;
+    const auto sort_capacity = get_sort_capacity(light_count);
+    ensure_capacity(device, sort_capacity);
+
+    if (light_count > 0) {
+        record_sort(
+            command_buffer, point_light_culling_buffer,
+            spot_light_culling_buffer, point_light_count, spot_light_count,
+            sort_capacity
+        );
+    }
+
+    tile_mask_word_count = std::max(
+        uint32_t{1},
+        (light_count + bits_per_mask_word - 1) / bits_per_mask_word
+    );
+    const auto bin_params = LightBinParams{
+        .camera =
+            {projection.tan_half_fov_y,
+             projection.aspect_ratio,
+             projection.near_plane,
+             projection.far_plane},
+        .params = {light_count, tile_mask_word_count, 0, 0},
+    };
+    const auto light_buffers = std::array<const Buffer* const, 3>{
+        &point_light_culling_buffer,
+        &spot_light_culling_buffer,
+        &depth_sorted_light_buffer,
+    };
+
+    // Also empties every z bin, so it runs even without lights.
+    {
+        const auto storage_bindings =
+            std::array<StorageBufferReadWriteBinding, 2>{
+                StorageBufferReadWriteBinding{
+                    .buffer = &light_tile_mask_buffer, .cycle = false
+                },
+                StorageBufferReadWriteBinding{
+                    .buffer = &light_z_bin_buffer, .cycle = false
+                },
+            };
+        auto compute_pass =
+            command_buffer.begin_compute_pass({}, storage_bindings);
+        compute_pass.bind_storage_buffers(0, light_buffers);
+        push_params(command_buffer, bin_params);
+        compute_pass.bind_compute_pipeline(tile_cull_pipeline);
+        const auto thread_count = std::max(
+            light_tile_count * tile_mask_word_count, light_z_bin_count
+        );
+        compute_pass.dispatch(
+            (thread_count + bin_threads - 1) / bin_threads, 1, 1
+        );
+    }
+
+    if (light_count == 0) {
+        return;
+    }
+
+    {
+        const auto storage_bindings =
+            std::array<StorageBufferReadWriteBinding, 1>{
+                StorageBufferReadWriteBinding{
+                    .buffer = &light_z_bin_buffer, .cycle = false
+                },
+            };
+        auto compute_pass =
+            command_buffer.begin_compute_pass({}, storage_bindings);
+        compute_pass.bind_storage_buffers(0, light_buffers);
+        push_params(command_buffer, bin_params);
+        compute_pass.bind_compute_pipeline(z_bin_pipeline);
+        compute_pass.dispatch(
+            (light_count + bin_threads - 1) / bin_threads, 1, 1
+        );
+    }
+}
+
+auto SDL_GPUZBinPass::ensure_capacity(GPUDevice& device, uint32_t sort_capacity)
+    -> void {
+    if (depth_sorted_light_buffer.get_size() >=
+        sort_capacity * sorted_light_size) {
+        return;
+    }
+
+    // SDL_GPU defers releasing the replaced buffers until the GPU is done
+    // with them. Nothing carries over - every frame re-sorts from scratch.
+    depth_sorted_light_buffer =
+        make_depth_sorted_light_buffer(device, sort_capacity);
+    light_tile_mask_buffer = make_light_tile_mask_buffer(device, sort_capacity);
+}
+
+// Bitonic sort over sort_capacity slots: every stage up to sort_block_size
+// in one light_sort_local.hlsl dispatch, then for each larger stage, one
+// light_sort_global.hlsl dispatch per step whose pairs span blocks and one
+// light_sort_local.hlsl dispatch for the rest. Each is its own compute
+// pass, since SDL_GPU doesn't order storage buffer writes between
+// dispatches otherwise - 28 passes at 128k lights.
+auto SDL_GPUZBinPass::record_sort(
+    CommandBuffer& command_buffer,
+    const Buffer& point_light_culling_buffer,
+    const Buffer& spot_light_culling_buffer,
+    uint32_t point_light_count,
+    uint32_t spot_light_count,
+    uint32_t sort_capacity
+) -> void {
+    const auto culling_buffers = std::array<const Buffer* const, 2>{
+        &point_light_culling_buffer, &spot_light_culling_buffer
+    };
+    const auto storage_bindings = std::array<StorageBufferReadWriteBinding, 1>{
+        StorageBufferReadWriteBinding{
+            .buffer = &depth_sorted_light_buffer, .cycle = false
+        },
+    };
+
+    const auto sort_blocks = [&](uint32_t merge_stage) {
+        auto compute_pass =
+            command_buffer.begin_compute_pass({}, storage_bindings);
+        compute_pass.bind_storage_buffers(0, culling_buffers);
+        push_params(
+            command_buffer,
+            LightSortParams{
+                .params =
+                    {point_light_count, spot_light_count, merge_stage, 0},
+            }
+        );
+        compute_pass.bind_compute_pipeline(sort_local_pipeline);
+        compute_pass.dispatch(sort_capacity / sort_block_size, 1, 1);
+    };
+
+    sort_blocks(0);
+    for (auto stage = sort_block_size * 2; stage <= sort_capacity;
+         stage *= 2) {
+        for (auto distance = stage / 2; distance >= sort_block_size;
+             distance /= 2) {
+            auto compute_pass =
+                command_buffer.begin_compute_pass({}, storage_bindings);
+            push_params(
+                command_buffer,
+                LightSortParams{
+                    .params = {stage, distance, sort_capacity, 0},
+                }
+            );
+            compute_pass.bind_compute_pipeline(sort_global_pipeline);
+            compute_pass.dispatch(
+                (sort_capacity / 2 + sort_global_threads - 1) /
+                    sort_global_threads,
+                1, 1
+            );
+        }
+        sort_blocks(stage);
+    }
+}
+
+auto SDL_GPUZBinPass::get_light_z_bin_buffer() const -> const Buffer& {
+    return light_z_bin_buffer;
+}
+
+auto SDL_GPUZBinPass::get_light_tile_mask_buffer() const -> const Buffer& {
+    return light_tile_mask_buffer;
+}
+
+auto SDL_GPUZBinPass::get_depth_sorted_light_buffer() const -> const Buffer& {
+    return depth_sorted_light_buffer;
+}
+
+auto SDL_GPUZBinPass::get_tile_mask_word_count() const -> uint32_t {
+    return tile_mask_word_count;
+}
+
+}  // namespace Luminol::Graphics::SDL_GPU
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstdint>
+
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUBuffer.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUComputePipeline.hpp>
+
+namespace Luminol::Graphics::SDL_GPU {
+
+class GPUDevice;
+struct ShaderCompileRequests;
+class CommandBuffer;
+
+// 32x18 screen tiles, each covering the whole view depth range, and 512
+// exponential view-depth bins (sliced like the cluster grid's z).
+constexpr auto light_tile_grid_x = uint32_t{32};
+constexpr auto light_tile_grid_y = uint32_t{18};
+constexpr auto light_tile_count = light_tile_grid_x * light_tile_grid_y;
+constexpr auto light_z_bin_count = uint32_t{512};
+
+// The camera projection SDL_GPUZBinPass::cull_lights() bins against - the
+// same parameters the cluster grid is built from.
+struct ZBinProjection {
+    float tan_half_fov_y;
+    float aspect_ratio;
+    float near_plane;
+    float far_plane;
+};
+
+// Z-binned light culling, the alternative to SDL_GPUClusterPass's
+// per-cluster light index lists (see LightCullingMode): every light is
+// sorted by view depth, each screen tile gets a bitmask over the sorted
+// lights, and each 1D depth bin the first and last sorted light reaching
+// it. A fragment walks only its tile's mask words inside its depth bin's
+// range (pbr_frag.hlsl).
+//
+// That's one GPU bitonic sort (light_sort_local.hlsl/light_sort_global.hlsl
+// - one dispatch per step that spans more than a 1024-light block) and two
+// cheap dispatches, with no count/scan/compact and no per-cluster list
+// budget to overflow. Memory is light_tile_count * light count / 32 words
+// for the masks, plus two uints per light and per z bin.
+class SDL_GPUZBinPass {
+public:
+    SDL_GPUZBinPass(GPUDevice& device);
+
+    [[nodiscard]] static auto get_shader_compile_requests()
+        -> ShaderCompileRequests;
+
+    // Sorts and bins the first point_light_count/spot_light_count lights of
+    // the light culling buffers SDL_GPUClusterPass's transform pass wrote
+    // (view-space position + cull radius), producing the three get_*
+    // buffers below. Grows them to fit the light count. Must be called
+    // while no render/copy pass on command_buffer is open.
+    auto cull_lights(
+        GPUDevice& device,
+        CommandBuffer& command_buffer,
+        const Buffer& point_light_culling_buffer,
+        const Buffer& spot_light_culling_buffer,
+        uint32_t point_light_count,
+        uint32_t spot_light_count,
+        const ZBinProjection& projection
+    ) -> void;
+
+    [[nodiscard]] auto get_light_z_bin_buffer() const -> const Buffer&;
+    [[nodiscard]] auto get_light_tile_mask_buffer() const -> const Buffer&;
+    [[nodiscard]] auto get_depth_sorted_light_buffer() const -> const Buffer&;
+    // Words per tile in get_light_tile_mask_buffer() as of the last
+    // cull_lights().
+    [[nodiscard]] auto get_tile_mask_word_count() const -> uint32_t;
+
+private:
+    // Recreates depth_sorted_light_buffer/light_tile_mask_buffer if they're
+    // too small for sort_capacity sorted slots.
+    auto ensure_capacity(GPUDevice& device, uint32_t sort_capacity) -> void;
+
+    auto record_sort(
+        CommandBuffer& command_buffer,
+        const Buffer& point_light_culling_buffer,
+        const Buffer& spot_light_culling_buffer,
+        uint32_t point_light_count,
+        uint32_t spot_light_count,
+        uint32_t sort_capacity
+    ) -> void;
+
+    ComputePipeline sort_local_pipeline;
+    ComputePipeline sort_global_pipeline;
+    ComputePipeline tile_cull_pipeline;
+    ComputePipeline z_bin_pipeline;
+
+    Buffer light_z_bin_buffer;
+    Buffer light_tile_mask_buffer;
+    Buffer depth_sorted_light_buffer;
+
+    uint32_t tile_mask_word_count = 0;
+};
+
+}  // namespace Luminol::Graphics::SDL_GPU
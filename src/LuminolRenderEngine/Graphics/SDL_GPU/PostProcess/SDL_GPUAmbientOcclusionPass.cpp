@@ -76,15 +76,17 @@ auto make_half_res_ao_texture(GPUDevice& device, SDL_Window* window) -> Texture
 auto make_normal_prepass_pipeline(
     GPUDevice& device,
     const Shader& vertex_shader,
-    const Shader& fragment_shader
+    const Shader& fragment_shader,
+    VertexFormat vertex_format
 ) -> GraphicsPipeline {
     return device.create_graphics_pipeline(GraphicsPipelineInfo{
         .vertex_shader = vertex_shader,
         .fragment_shader = fragment_shader,
         .color_target_format = ao_texture_format,
         .primitive_type = PrimitiveType::TriangleList,
-        .vertex_buffer_descriptions = mesh_vertex_buffer_descriptions,
-        .vertex_attributes = mesh_vertex_attributes,
+        .vertex_buffer_descriptions =
+            get_mesh_vertex_buffer_descriptions(vertex_format),
+        .vertex_attributes = get_mesh_vertex_attributes(vertex_format),
         .enable_depth_test = true,
         .depth_stencil_format = depth_texture_format,
         .cull_mode = CullMode::Back,
@@ -92,56 +94,62 @@ auto make_normal_prepass_pipeline(
     });
 }
 
+auto get_normal_prepass_fragment_shader_info() -> ShaderInfo {
+    return make_hlsl_shader_info(
+        "res/shaders/sdl_gpu/normal_prepass_frag.hlsl",
+        ShaderStage::Fragment,
+        0U,
+        1U,
+        0U
+    );
+}
+
+auto get_ssao_fragment_shader_info() -> ShaderInfo {
+    return make_hlsl_shader_info(
+        "res/shaders/sdl_gpu/ssao_frag.hlsl", ShaderStage::Fragment, 2U, 1U, 0U
+    );
+}
+
+auto get_blur_fragment_shader_info() -> ShaderInfo {
+    return make_hlsl_shader_info(
+        "res/shaders/sdl_gpu/ssao_blur_frag.hlsl",
+        ShaderStage::Fragment,
+        1U,
+        1U,
+        0U
+    );
+}
+
 }  // namespace
 
 namespace Luminol::Graphics::SDL_GPU {
 
 SDL_GPUAmbientOcclusionPass::SDL_GPUAmbientOcclusionPass(
-    GPUDevice& device, SDL_Window* window
+    GPUDevice& device, SDL_Window* window, VertexFormat vertex_format
 )
-    : normal_prepass_vertex_shader{make_hlsl_shader(
-          device,
-          "res/shaders/sdl_gpu/pbr_vert.hlsl",
-          ShaderStage::Vertex,
-          0U,
-          1U,
-          2U
-      )},
-      normal_prepass_fragment_shader{make_hlsl_shader(
-          device,
-          "res/shaders/sdl_gpu/normal_prepass_frag.hlsl",
-          ShaderStage::Fragment,
-          0U,
-          1U,
-          0U
-      )},
+    : normal_prepass_vertex_shader{
+          device.create_shader(get_mesh_vertex_shader_info(vertex_format))
+      },
+      normal_prepass_fragment_shader{
+          device.create_shader(get_normal_prepass_fragment_shader_info())
+      },
       normal_prepass_pipeline{make_normal_prepass_pipeline(
-          device, normal_prepass_vertex_shader, normal_prepass_fragment_shader
-      )},
-      fullscreen_vertex_shader{make_hlsl_shader(
-          device, "res/shaders/sdl_gpu/fullscreen_vert.hlsl",
-          ShaderStage::Vertex
-      )},
-      ssao_fragment_shader{make_hlsl_shader(
-          device,
-          "res/shaders/sdl_gpu/ssao_frag.hlsl",
-          ShaderStage::Fragment,
-          2U,
-          1U,
-          0U
+          device, normal_prepass_vertex_shader, normal_prepass_fragment_shader,
+          vertex_format
       )},
+      fullscreen_vertex_shader{
+          device.create_shader(get_fullscreen_vertex_shader_info())
+      },
+      ssao_fragment_shader{
+          device.create_shader(get_ssao_fragment_shader_info())
+      },
       ssao_pipeline{make_fullscreen_pipeline(
           device, fullscreen_vertex_shader, ssao_fragment_shader,
           ao_texture_format
       )},
-      blur_fragment_shader{make_hlsl_shader(
-          device,
-          "res/shaders/sdl_gpu/ssao_blur_frag.hlsl",
-          ShaderStage::Fragment,
-          1U,
-          1U,
-          0U
-      )},
+      blur_fragment_shader{
+          device.create_shader(get_blur_fragment_shader_info())
+      },
       blur_pipeline{make_fullscreen_pipeline(
           device, fullscreen_vertex_shader, blur_fragment_shader,
           ao_texture_format
@@ -153,6 +161,22 @@ SDL_GPUAmbientOcclusionPass::SDL_GPUAmbientOcclusionPass(
           device, /*enable_compare=*/false
       )} {}
 
+auto SDL_GPUAmbientOcclusionPass::get_shader_compile_requests(
+    VertexFormat vertex_format
+) -> ShaderCompileRequests {
+    return ShaderCompileRequests{
+        .shaders =
+            {
+                get_mesh_vertex_shader_info(vertex_format),
+                get_normal_prepass_fragment_shader_info(),
+                get_fullscreen_vertex_shader_info(),
+                get_ssao_fragment_shader_info(),
+                get_blur_fragment_shader_info(),
+            },
+        .compute_pipelines = {},
+    };
+}
+
 auto SDL_GPUAmbientOcclusionPass::resize(
     GPUDevice& device, uint32_t width, uint32_t height
 ) -> void {
@@ -252,6 +276,10 @@ auto SDL_GPUAmbientOcclusionPass::draw(
                 graphics_factory.get_index_buffer(batch.renderable_id),
                 IndexElementSize::Bits32, 0
             );
+            push_vertex_dequantization(
+                command_buffer,
+                graphics_factory.get_vertex_dequantization(batch.renderable_id)
+            );
 
             // Every submesh in this batch's IndirectDrawCommand slice is
             // contiguous (SDL_GPUInstanceCullPass::cull builds them that
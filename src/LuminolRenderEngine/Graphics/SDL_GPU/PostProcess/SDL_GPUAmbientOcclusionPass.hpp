@@ -12,6 +12,7 @@
 #include <LuminolRenderEngine/Graphics/SDL_GPU/Culling/SDL_GPUInstanceCullPass.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUShader.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUTexture.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUVertexFormat.hpp>
 #include <LuminolRenderEngine/Utilities/PerformanceLogger.hpp>
 
 struct SDL_Window;
@@ -19,6 +20,7 @@ struct SDL_Window;
 namespace Luminol::Graphics::SDL_GPU {
 
 class GPUDevice;
+struct ShaderCompileRequests;
 class CommandBuffer;
 class SDL_GPUFactory;
 
@@ -29,7 +31,13 @@ class SDL_GPUFactory;
 // pass as an extra fragment sampler.
 class SDL_GPUAmbientOcclusionPass {
 public:
-    SDL_GPUAmbientOcclusionPass(GPUDevice& device, SDL_Window* window);
+    SDL_GPUAmbientOcclusionPass(
+        GPUDevice& device, SDL_Window* window, VertexFormat vertex_format
+    );
+
+    [[nodiscard]] static auto get_shader_compile_requests(
+        VertexFormat vertex_format
+    ) -> ShaderCompileRequests;
 
     auto resize(GPUDevice& device, uint32_t width, uint32_t height) -> void;
 
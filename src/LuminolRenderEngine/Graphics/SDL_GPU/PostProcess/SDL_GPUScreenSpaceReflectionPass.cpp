@@ -70,6 +70,21 @@ auto make_half_res_ssr_texture(GPUDevice& device, SDL_Window* window) -> Texture
     return make_half_res_ssr_texture(device, width, height);
 }
 
+auto get_ssr_fragment_shader_info() -> ShaderInfo {
+    return make_hlsl_shader_info(
+        "res/shaders/sdl_gpu/ssr_frag.hlsl", ShaderStage::Fragment, 3U, 1U
+    );
+}
+
+auto get_resolve_fragment_shader_info() -> ShaderInfo {
+    return make_hlsl_shader_info(
+        "res/shaders/sdl_gpu/ssr_resolve_frag.hlsl",
+        ShaderStage::Fragment,
+        1U,
+        1U
+    );
+}
+
 }  // namespace
 
 namespace Luminol::Graphics::SDL_GPU {
@@ -77,28 +92,17 @@ namespace Luminol::Graphics::SDL_GPU {
 SDL_GPUScreenSpaceReflectionPass::SDL_GPUScreenSpaceReflectionPass(
     GPUDevice& device, SDL_Window* window
 )
-    : fullscreen_vertex_shader{make_hlsl_shader(
-          device, "res/shaders/sdl_gpu/fullscreen_vert.hlsl",
-          ShaderStage::Vertex
-      )},
-      ssr_fragment_shader{make_hlsl_shader(
-          device,
-          "res/shaders/sdl_gpu/ssr_frag.hlsl",
-          ShaderStage::Fragment,
-          3U,
-          1U
-      )},
+    : fullscreen_vertex_shader{
+          device.create_shader(get_fullscreen_vertex_shader_info())
+      },
+      ssr_fragment_shader{device.create_shader(get_ssr_fragment_shader_info())},
       ssr_pipeline{make_fullscreen_pipeline(
           device, fullscreen_vertex_shader, ssr_fragment_shader,
           ssr_texture_format
       )},
-      resolve_fragment_shader{make_hlsl_shader(
-          device,
-          "res/shaders/sdl_gpu/ssr_resolve_frag.hlsl",
-          ShaderStage::Fragment,
-          1U,
-          1U
-      )},
+      resolve_fragment_shader{
+          device.create_shader(get_resolve_fragment_shader_info())
+      },
       resolve_pipeline{make_fullscreen_pipeline(
           device, fullscreen_vertex_shader, resolve_fragment_shader,
           ssr_texture_format
@@ -109,6 +113,19 @@ SDL_GPUScreenSpaceReflectionPass::SDL_GPUScreenSpaceReflectionPass(
           device, /*enable_compare=*/false
       )} {}
 
+auto SDL_GPUScreenSpaceReflectionPass::get_shader_compile_requests()
+    -> ShaderCompileRequests {
+    return ShaderCompileRequests{
+        .shaders =
+            {
+                get_fullscreen_vertex_shader_info(),
+                get_ssr_fragment_shader_info(),
+                get_resolve_fragment_shader_info(),
+            },
+        .compute_pipelines = {},
+    };
+}
+
 auto SDL_GPUScreenSpaceReflectionPass::resize(
     GPUDevice& device, uint32_t width, uint32_t height
 ) -> void {
@@ -14,6 +14,7 @@ struct SDL_Window;
 namespace Luminol::Graphics::SDL_GPU {
 
 class GPUDevice;
+struct ShaderCompileRequests;
 class CommandBuffer;
 
 // Screen-space reflections. A fullscreen pass that traces mirror reflection
@@ -26,6 +27,9 @@ class SDL_GPUScreenSpaceReflectionPass {
 public:
     SDL_GPUScreenSpaceReflectionPass(GPUDevice& device, SDL_Window* window);
 
+    [[nodiscard]] static auto get_shader_compile_requests()
+        -> ShaderCompileRequests;
+
     auto resize(GPUDevice& device, uint32_t width, uint32_t height) -> void;
 
     auto draw(
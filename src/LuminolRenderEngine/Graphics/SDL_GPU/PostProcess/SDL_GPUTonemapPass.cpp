@@ -15,22 +15,23 @@ struct TonemapUniforms {
     float exposure;
 };
 
+auto get_tonemap_fragment_shader_info() -> ShaderInfo {
+    return make_hlsl_shader_info(
+        "res/shaders/sdl_gpu/tonemap_frag.hlsl", ShaderStage::Fragment, 1U, 1U
+    );
+}
+
 }  // namespace
 
 namespace Luminol::Graphics::SDL_GPU {
 
 SDL_GPUTonemapPass::SDL_GPUTonemapPass(GPUDevice& device, SDL_Window* window)
-    : fullscreen_vertex_shader{make_hlsl_shader(
-          device, "res/shaders/sdl_gpu/fullscreen_vert.hlsl",
-          ShaderStage::Vertex
-      )},
-      tonemap_fragment_shader{make_hlsl_shader(
-          device,
-          "res/shaders/sdl_gpu/tonemap_frag.hlsl",
-          ShaderStage::Fragment,
-          1U,
-          1U
-      )},
+    : fullscreen_vertex_shader{
+          device.create_shader(get_fullscreen_vertex_shader_info())
+      },
+      tonemap_fragment_shader{
+          device.create_shader(get_tonemap_fragment_shader_info())
+      },
       tonemap_pipeline{make_fullscreen_pipeline(
           device, fullscreen_vertex_shader, tonemap_fragment_shader,
           device.get_swapchain_texture_format(window)
@@ -39,6 +40,18 @@ SDL_GPUTonemapPass::SDL_GPUTonemapPass(GPUDevice& device, SDL_Window* window)
           device, /*enable_compare=*/false
       )} {}
 
+auto SDL_GPUTonemapPass::get_shader_compile_requests()
+    -> ShaderCompileRequests {
+    return ShaderCompileRequests{
+        .shaders =
+            {
+                get_fullscreen_vertex_shader_info(),
+                get_tonemap_fragment_shader_info(),
+            },
+        .compute_pipelines = {},
+    };
+}
+
 auto SDL_GPUTonemapPass::draw(
     CommandBuffer& command_buffer,
     RenderPass& render_pass,
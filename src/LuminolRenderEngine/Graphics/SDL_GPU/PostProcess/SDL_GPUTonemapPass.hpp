@@ -11,6 +11,7 @@ namespace Luminol::Graphics::SDL_GPU {
 class GPUDevice;
 class CommandBuffer;
 class RenderPass;
+struct ShaderCompileRequests;
 
 // Resolves the offscreen HDR color target produced by SDL_GPUMeshRenderPass
 // into the swapchain: applies Reinhard tonemapping and gamma correction.
@@ -21,6 +22,9 @@ class SDL_GPUTonemapPass {
 public:
     SDL_GPUTonemapPass(GPUDevice& device, SDL_Window* window);
 
+    [[nodiscard]] static auto get_shader_compile_requests()
+        -> ShaderCompileRequests;
+
     auto draw(
         CommandBuffer& command_buffer,
         RenderPass& render_pass,
@@ -1,16 +1,25 @@
 #include "SDL_GPUComputePass.hpp"
 
+#include <array>
+#include <cstddef>
+
 #include <gsl/gsl>
 
 #include <SDL3/SDL_gpu.h>
 
-#include <vector>
-
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUBuffer.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUComputePipeline.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUTexture.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUTypes.hpp>
 
+namespace {
+
+// SDL_GPU's per-stage binding limit, so bindings are converted on the stack
+// rather than in a heap allocation per call.
+constexpr auto max_bindings_per_stage = std::size_t{16};
+
+}  // namespace
+
 namespace Luminol::Graphics::SDL_GPU {
 
 ComputePass::ComputePass(SDL_GPUComputePass* compute_pass)
@@ -44,8 +53,9 @@ auto ComputePass::bind_storage_buffers(
     uint32_t first_slot, gsl::span<const Buffer* const> buffers
 ) -> void {
     Expects(compute_pass != nullptr);
+    Expects(buffers.size() <= max_bindings_per_stage);
 
-    auto sdl_buffers = std::vector<SDL_GPUBuffer*>(buffers.size());
+    auto sdl_buffers = std::array<SDL_GPUBuffer*, max_bindings_per_stage>{};
     for (auto i = size_t{0}; i < buffers.size(); ++i) {
         Expects(buffers[i] != nullptr);
         sdl_buffers[i] = buffers[i]->native_handle();
@@ -55,7 +65,7 @@ auto ComputePass::bind_storage_buffers(
         compute_pass,
         first_slot,
         sdl_buffers.data(),
-        static_cast<uint32_t>(sdl_buffers.size())
+        static_cast<uint32_t>(buffers.size())
     );
 }
 
@@ -63,8 +73,9 @@ auto ComputePass::bind_storage_textures(
     uint32_t first_slot, gsl::span<const Texture* const> textures
 ) -> void {
     Expects(compute_pass != nullptr);
+    Expects(textures.size() <= max_bindings_per_stage);
 
-    auto sdl_textures = std::vector<SDL_GPUTexture*>(textures.size());
+    auto sdl_textures = std::array<SDL_GPUTexture*, max_bindings_per_stage>{};
     for (auto i = size_t{0}; i < textures.size(); ++i) {
         Expects(textures[i] != nullptr);
         sdl_textures[i] = textures[i]->native_handle();
@@ -74,7 +85,7 @@ auto ComputePass::bind_storage_textures(
         compute_pass,
         first_slot,
         sdl_textures.data(),
-        static_cast<uint32_t>(sdl_textures.size())
+        static_cast<uint32_t>(textures.size())
     );
 }
 
@@ -82,9 +93,10 @@ auto ComputePass::bind_samplers(
     uint32_t first_slot, gsl::span<const TextureSamplerBinding> bindings
 ) -> void {
     Expects(compute_pass != nullptr);
+    Expects(bindings.size() <= max_bindings_per_stage);
 
     auto sdl_bindings =
-        std::vector<SDL_GPUTextureSamplerBinding>(bindings.size());
+        std::array<SDL_GPUTextureSamplerBinding, max_bindings_per_stage>{};
     for (auto i = size_t{0}; i < bindings.size(); ++i) {
         Expects(bindings[i].texture != nullptr);
         Expects(bindings[i].sampler != nullptr);
@@ -98,7 +110,7 @@ auto ComputePass::bind_samplers(
         compute_pass,
         first_slot,
         sdl_bindings.data(),
-        static_cast<uint32_t>(sdl_bindings.size())
+        static_cast<uint32_t>(bindings.size())
     );
 }
 
@@ -1,11 +1,12 @@
 #include "SDL_GPURenderPass.hpp"
 
+#include <array>
+#include <cstddef>
+
 #include <gsl/gsl>
 
 #include <SDL3/SDL_gpu.h>
 
-#include <vector>
-
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUBuffer.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUGraphicsPipeline.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUTexture.hpp>
@@ -25,6 +26,10 @@ constexpr auto to_sdl_index_element_size(IndexElementSize size)
     throw std::runtime_error{"Invalid index element size"};
 }
 
+// SDL_GPU's per-stage binding limit, so bindings are converted on the stack
+// rather than in a heap allocation per call.
+constexpr auto max_bindings_per_stage = std::size_t{16};
+
 }  // namespace
 
 namespace Luminol::Graphics::SDL_GPU {
@@ -87,8 +92,10 @@ auto RenderPass::bind_vertex_buffers(
     uint32_t first_slot, gsl::span<const VertexBufferBinding> bindings
 ) -> void {
     Expects(render_pass != nullptr);
+    Expects(bindings.size() <= max_bindings_per_stage);
 
-    auto sdl_bindings = std::vector<SDL_GPUBufferBinding>(bindings.size());
+    auto sdl_bindings =
+        std::array<SDL_GPUBufferBinding, max_bindings_per_stage>{};
     for (auto i = size_t{0}; i < bindings.size(); ++i) {
         Expects(bindings[i].buffer != nullptr);
         sdl_bindings[i] = SDL_GPUBufferBinding{
@@ -101,7 +108,7 @@ auto RenderPass::bind_vertex_buffers(
         render_pass,
         first_slot,
         sdl_bindings.data(),
-        static_cast<uint32_t>(sdl_bindings.size())
+        static_cast<uint32_t>(bindings.size())
     );
 }
 
@@ -109,8 +116,9 @@ auto RenderPass::bind_vertex_storage_buffers(
     uint32_t first_slot, gsl::span<const Buffer* const> buffers
 ) -> void {
     Expects(render_pass != nullptr);
+    Expects(buffers.size() <= max_bindings_per_stage);
 
-    auto sdl_buffers = std::vector<SDL_GPUBuffer*>(buffers.size());
+    auto sdl_buffers = std::array<SDL_GPUBuffer*, max_bindings_per_stage>{};
     for (auto i = size_t{0}; i < buffers.size(); ++i) {
         Expects(buffers[i] != nullptr);
         sdl_buffers[i] = buffers[i]->native_handle();
@@ -120,7 +128,7 @@ auto RenderPass::bind_vertex_storage_buffers(
         render_pass,
         first_slot,
         sdl_buffers.data(),
-        static_cast<uint32_t>(sdl_buffers.size())
+        static_cast<uint32_t>(buffers.size())
     );
 }
 
@@ -128,9 +136,10 @@ auto RenderPass::bind_fragment_samplers(
     uint32_t first_slot, gsl::span<const TextureSamplerBinding> bindings
 ) -> void {
     Expects(render_pass != nullptr);
+    Expects(bindings.size() <= max_bindings_per_stage);
 
     auto sdl_bindings =
-        std::vector<SDL_GPUTextureSamplerBinding>(bindings.size());
+        std::array<SDL_GPUTextureSamplerBinding, max_bindings_per_stage>{};
     for (auto i = size_t{0}; i < bindings.size(); ++i) {
         Expects(bindings[i].texture != nullptr);
         Expects(bindings[i].sampler != nullptr);
@@ -144,7 +153,7 @@ auto RenderPass::bind_fragment_samplers(
         render_pass,
         first_slot,
         sdl_bindings.data(),
-        static_cast<uint32_t>(sdl_bindings.size())
+        static_cast<uint32_t>(bindings.size())
     );
 }
 
@@ -152,8 +161,9 @@ auto RenderPass::bind_fragment_storage_buffers(
     uint32_t first_slot, gsl::span<const Buffer* const> buffers
 ) -> void {
     Expects(render_pass != nullptr);
+    Expects(buffers.size() <= max_bindings_per_stage);
 
-    auto sdl_buffers = std::vector<SDL_GPUBuffer*>(buffers.size());
+    auto sdl_buffers = std::array<SDL_GPUBuffer*, max_bindings_per_stage>{};
     for (auto i = size_t{0}; i < buffers.size(); ++i) {
         Expects(buffers[i] != nullptr);
         sdl_buffers[i] = buffers[i]->native_handle();
@@ -163,7 +173,7 @@ auto RenderPass::bind_fragment_storage_buffers(
         render_pass,
         first_slot,
         sdl_buffers.data(),
-        static_cast<uint32_t>(sdl_buffers.size())
+        static_cast<uint32_t>(buffers.size())
     );
 }
 
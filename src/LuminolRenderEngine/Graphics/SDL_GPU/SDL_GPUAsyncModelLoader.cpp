@@ -0,0 +1,72 @@
+#include "SDL_GPUAsyncModelLoader.hpp"
+
+#include <utility>
+
+namespace Luminol::Graphics::SDL_GPU {
+
+auto fits_upload_budget(
+    uint64_t uploaded_bytes, uint64_t upload_size_bytes, uint64_t byte_budget
+) -> bool {
+    // Written as a subtraction so a huge upload_size_bytes can't overflow.
+    return uploaded_bytes == 0 || (uploaded_bytes <= byte_budget &&
+                                   upload_size_bytes <=
+                                       byte_budget - uploaded_bytes);
+}
+
+AsyncModelLoader::AsyncModelLoader(
+    const Utilities::ModelLoader::LoadOptions& load_options
+)
+    : load_options{load_options},
+      loader_thread{[this](const std::stop_token& stop_token) {
+          this->run(stop_token);
+      }} {}
+
+auto AsyncModelLoader::enqueue(
+    RenderableId renderable_id,
+    uint64_t ticket,
+    const std::filesystem::path& model_path
+) -> void {
+    {
+        const auto lock = std::scoped_lock{this->mutex};
+        this->pending.push_back(PendingModelLoad{
+            .renderable_id = renderable_id,
+            .ticket = ticket,
+            .model_path = model_path,
+        });
+    }
+    this->pending_changed.notify_one();
+}
+
+auto AsyncModelLoader::take_completed() -> std::vector<CompletedModelLoad> {
+    const auto lock = std::scoped_lock{this->mutex};
+    return std::exchange(this->completed, {});
+}
+
+auto AsyncModelLoader::run(const std::stop_token& stop_token) -> void {
+    while (true) {
+        auto load = PendingModelLoad{};
+        {
+            auto lock = std::unique_lock{this->mutex};
+            if (!this->pending_changed.wait(lock, stop_token, [this] {
+                    return !this->pending.empty();
+                })) {
+                return;
+            }
+            load = std::move(this->pending.front());
+            this->pending.pop_front();
+        }
+
+        // Outside the lock: this is the multi-second part, and the render
+        // thread polls take_completed every frame.
+        auto model = prepare_model(load.model_path, this->load_options);
+
+        const auto lock = std::scoped_lock{this->mutex};
+        this->completed.push_back(CompletedModelLoad{
+            .renderable_id = load.renderable_id,
+            .ticket = load.ticket,
+            .model = std::move(model),
+        });
+    }
+}
+
+}  // namespace Luminol::Graphics::SDL_GPU
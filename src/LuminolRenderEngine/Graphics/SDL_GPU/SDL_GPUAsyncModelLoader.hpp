@@ -0,0 +1,89 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include <LuminolRenderEngine/Graphics/RenderableManager.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUMeshCache.hpp>
+#include <LuminolRenderEngine/Utilities/ModelLoader.hpp>
+
+namespace Luminol::Graphics::SDL_GPU {
+
+// A prepare_model call that has finished on the loader thread. ticket is
+// whatever the caller passed to enqueue - SDL_GPUFactory uses it to tell a
+// result for a since-removed (and possibly reallocated) RenderableId apart
+// from the current one.
+struct CompletedModelLoad {
+    RenderableId renderable_id;
+    uint64_t ticket;
+    // std::nullopt if the model couldn't be loaded.
+    std::optional<PreparedModel> model;
+};
+
+// Whether a finished load needing upload_size_bytes may be uploaded this
+// frame, once uploaded_bytes of byte_budget are already spent. The first
+// upload of a frame always fits, however large, so an oversized model still
+// becomes resident; later ones must fit what's left.
+[[nodiscard]] auto fits_upload_budget(
+    uint64_t uploaded_bytes, uint64_t upload_size_bytes, uint64_t byte_budget
+) -> bool;
+
+// Runs prepare_model (file I/O, mesh cache lookup or assimp + bake, texture
+// decode) on a single background thread, one model at a time in enqueue
+// order. One thread is enough: each load already spreads its texture decode
+// and submesh bake across every core (see ImageLoader::load_images,
+// bake_model), so a second concurrent load would only contend with it.
+// Never touches the GPU - uploading the results is the caller's job, on the
+// thread that owns the GPUDevice.
+class AsyncModelLoader {
+public:
+    explicit AsyncModelLoader(
+        const Utilities::ModelLoader::LoadOptions& load_options = {}
+    );
+    // Finishes the model currently being prepared (if any), drops the rest
+    // of the queue and joins the loader thread (std::jthread requests stop,
+    // which also wakes the condition_variable_any wait in run).
+    ~AsyncModelLoader() = default;
+
+    AsyncModelLoader(const AsyncModelLoader&) = delete;
+    AsyncModelLoader(AsyncModelLoader&&) = delete;
+    auto operator=(const AsyncModelLoader&) -> AsyncModelLoader& = delete;
+    auto operator=(AsyncModelLoader&&) -> AsyncModelLoader& = delete;
+
+    auto enqueue(
+        RenderableId renderable_id,
+        uint64_t ticket,
+        const std::filesystem::path& model_path
+    ) -> void;
+
+    // Moves out every load finished since the last call, in completion
+    // order. Never blocks on a load in progress.
+    [[nodiscard]] auto take_completed() -> std::vector<CompletedModelLoad>;
+
+private:
+    struct PendingModelLoad {
+        RenderableId renderable_id;
+        uint64_t ticket;
+        std::filesystem::path model_path;
+    };
+
+    auto run(const std::stop_token& stop_token) -> void;
+
+    Utilities::ModelLoader::LoadOptions load_options;
+
+    std::mutex mutex;
+    std::condition_variable_any pending_changed;
+    std::deque<PendingModelLoad> pending;
+    std::vector<CompletedModelLoad> completed;
+
+    // Declared last so it's joined before the queues above are destroyed.
+    std::jthread loader_thread;
+};
+
+}  // namespace Luminol::Graphics::SDL_GPU
@@ -1,7 +1,8 @@
 #include "SDL_GPUCommandBuffer.hpp"
 
-#include <string>
-#include <vector>
+#include <algorithm>
+#include <array>
+#include <stdexcept>
 
 #include <gsl/gsl>
 
@@ -15,6 +16,25 @@ namespace {
 
 using namespace Luminol::Graphics::SDL_GPU;
 
+// SDL_GPU's own limits - the SDL_GPU*Info arrays passed to it are built on
+// the stack at these sizes rather than in a per-pass heap allocation.
+constexpr auto max_color_targets = std::size_t{4};
+constexpr auto max_compute_storage_bindings = std::size_t{8};
+
+// Longer debug group/label names are truncated, so they can be
+// NUL-terminated on the stack instead of in a std::string.
+constexpr auto max_debug_name_length = std::size_t{63};
+
+auto to_debug_name(std::string_view name)
+    -> std::array<char, max_debug_name_length + 1> {
+    auto debug_name = std::array<char, max_debug_name_length + 1>{};
+    std::copy_n(
+        name.begin(), std::min(name.size(), max_debug_name_length),
+        debug_name.begin()
+    );
+    return debug_name;
+}
+
 constexpr auto to_sdl_load_op(LoadOp op) -> SDL_GPULoadOp {
     switch (op) {
         case LoadOp::Load:
@@ -105,9 +125,10 @@ auto CommandBuffer::begin_render_pass(
     const DepthStencilTargetInfo* depth_stencil_target
 ) -> RenderPass {
     Expects(command_buffer != nullptr);
+    Expects(color_targets.size() <= max_color_targets);
 
     auto sdl_color_targets =
-        std::vector<SDL_GPUColorTargetInfo>(color_targets.size());
+        std::array<SDL_GPUColorTargetInfo, max_color_targets>{};
     for (auto i = size_t{0}; i < color_targets.size(); ++i) {
         const auto& target = color_targets[i];
         Expects(target.texture != nullptr);
@@ -159,7 +180,7 @@ auto CommandBuffer::begin_render_pass(
     auto* render_pass = SDL_BeginGPURenderPass(
         command_buffer,
         sdl_color_targets.data(),
-        static_cast<uint32_t>(sdl_color_targets.size()),
+        static_cast<uint32_t>(color_targets.size()),
         depth_stencil_target != nullptr ? &sdl_depth_stencil_target : nullptr
     );
 
@@ -200,11 +221,12 @@ auto CommandBuffer::begin_compute_pass(
     gsl::span<const StorageBufferReadWriteBinding> storage_buffer_bindings
 ) -> ComputePass {
     Expects(command_buffer != nullptr);
+    Expects(storage_texture_bindings.size() <= max_compute_storage_bindings);
+    Expects(storage_buffer_bindings.size() <= max_compute_storage_bindings);
 
-    auto sdl_texture_bindings =
-        std::vector<SDL_GPUStorageTextureReadWriteBinding>(
-            storage_texture_bindings.size()
-        );
+    auto sdl_texture_bindings = std::array<
+        SDL_GPUStorageTextureReadWriteBinding,
+        max_compute_storage_bindings>{};
     for (auto i = size_t{0}; i < storage_texture_bindings.size(); ++i) {
         Expects(storage_texture_bindings[i].texture != nullptr);
         sdl_texture_bindings[i] = SDL_GPUStorageTextureReadWriteBinding{
@@ -218,9 +240,9 @@ auto CommandBuffer::begin_compute_pass(
         };
     }
 
-    auto sdl_bindings = std::vector<SDL_GPUStorageBufferReadWriteBinding>(
-        storage_buffer_bindings.size()
-    );
+    auto sdl_bindings = std::array<
+        SDL_GPUStorageBufferReadWriteBinding,
+        max_compute_storage_bindings>{};
     for (auto i = size_t{0}; i < storage_buffer_bindings.size(); ++i) {
         Expects(storage_buffer_bindings[i].buffer != nullptr);
         sdl_bindings[i] = SDL_GPUStorageBufferReadWriteBinding{
@@ -235,9 +257,9 @@ auto CommandBuffer::begin_compute_pass(
     auto* compute_pass = SDL_BeginGPUComputePass(
         command_buffer,
         sdl_texture_bindings.data(),
-        static_cast<uint32_t>(sdl_texture_bindings.size()),
+        static_cast<uint32_t>(storage_texture_bindings.size()),
         sdl_bindings.data(),
-        static_cast<uint32_t>(sdl_bindings.size())
+        static_cast<uint32_t>(storage_buffer_bindings.size())
     );
 
     return ComputePass{compute_pass};
@@ -262,7 +284,7 @@ auto CommandBuffer::push_compute_uniform_data(
 
 auto CommandBuffer::push_debug_group(std::string_view name) -> void {
     Expects(command_buffer != nullptr);
-    SDL_PushGPUDebugGroup(command_buffer, std::string{name}.c_str());
+    SDL_PushGPUDebugGroup(command_buffer, to_debug_name(name).data());
 }
 
 auto CommandBuffer::pop_debug_group() -> void {
@@ -272,7 +294,7 @@ auto CommandBuffer::pop_debug_group() -> void {
 
 auto CommandBuffer::insert_debug_label(std::string_view name) -> void {
     Expects(command_buffer != nullptr);
-    SDL_InsertGPUDebugLabel(command_buffer, std::string{name}.c_str());
+    SDL_InsertGPUDebugLabel(command_buffer, to_debug_name(name).data());
 }
 
 auto CommandBuffer::submit() -> void {
@@ -136,12 +136,12 @@ public:
 
     auto submit() -> void;
 
-    // Like submit(), but returns a fence the caller can wait on to find out
-    // when the GPU has finished this frame's work. Intended for coarse,
-    // opt-in whole-frame GPU-time measurement (see
-    // SDL_GPURenderer::set_debug_gpu_profiling_enabled) - waiting on the
-    // fence blocks the CPU until the GPU catches up, which kills CPU/GPU
-    // overlap, so this must not be used unconditionally every frame.
+    // Like submit(), but returns a fence the caller can poll or wait on to
+    // find out when the GPU has finished this frame's work - FramePacer
+    // tracks every frame this way. Waiting on the fence blocks the CPU until
+    // the GPU catches up, which kills CPU/GPU overlap, so only opt-in
+    // measurement (SDL_GPURenderer::set_debug_gpu_profiling_enabled) waits
+    // on it unconditionally every frame.
     [[nodiscard]] auto submit_and_acquire_fence() -> SDL_GPUFence*;
 
     auto cancel() -> void;
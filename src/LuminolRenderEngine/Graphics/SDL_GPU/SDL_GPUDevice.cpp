@@ -3,8 +3,12 @@
 #include <algorithm>
 #include <array>
 #include <cfloat>
+#include <chrono>
 #include <cmath>
 #include <fstream>
+#include <functional>
+#include <string>
+#include <unordered_set>
 #include <vector>
 
 #include <gsl/gsl>
@@ -18,9 +22,17 @@
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUComputePipeline.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUGraphicsPipeline.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUShader.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUShaderCache.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUTexture.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUTransferBuffer.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUTypeConversions.hpp>
+#include <LuminolRenderEngine/Utilities/ParallelFor.hpp>
+
+// The SDL_shadercross commit this was built against (set by CMake), part of
+// every shader cache key so a compiler update invalidates cached SPIR-V.
+#ifndef LUMINOL_SHADERCROSS_REVISION
+#define LUMINOL_SHADERCROSS_REVISION "unknown"
+#endif
 
 namespace {
 
@@ -56,6 +68,7 @@ auto create_sdl_gpu_device(SDL_Window* window) -> SDL_GPUDevice* {
         return nullptr;
     }
 
+#ifndef LUMINOL_PRECOMPILED_SHADERS
     if (!SDL_ShaderCross_Init()) {
         SDL_LogError(
             SDL_LOG_CATEGORY_ERROR,
@@ -64,10 +77,222 @@ auto create_sdl_gpu_device(SDL_Window* window) -> SDL_GPUDevice* {
         );
         return nullptr;
     }
+#endif
 
     return gpu_device;
 }
 
+auto read_spirv_binary(const std::filesystem::path& path)
+    -> std::vector<uint8_t> {
+    auto shader_file =
+        std::ifstream{path, std::ios::in | std::ios::binary | std::ios::ate};
+    if (!shader_file) {
+        SDL_LogError(
+            SDL_LOG_CATEGORY_ERROR,
+            "Failed to open SPIR-V binary: %s",
+            path.string().c_str()
+        );
+        Ensures(false);
+    }
+
+    const auto code_size = shader_file.tellg();
+    shader_file.seekg(0, std::ios::beg);
+
+    auto code = std::vector<uint8_t>(static_cast<std::size_t>(code_size));
+    shader_file.read(reinterpret_cast<char*>(code.data()), code_size);
+
+    return code;
+}
+
+#ifdef LUMINOL_PRECOMPILED_SHADERS
+
+// The same shader, loaded from the SPIR-V the compile-shaders build target
+// produced for it (see get_precompiled_spirv_path) instead of compiled from
+// HLSL.
+auto to_precompiled_spirv_info(const ShaderInfo& info) -> ShaderInfo {
+    auto spirv_info = info;
+    spirv_info.path = get_precompiled_spirv_path(info.path, info.defines);
+    spirv_info.source_language = ShaderSourceLanguage::SpirvBinary;
+    spirv_info.defines.clear();
+    return spirv_info;
+}
+
+auto to_precompiled_spirv_info(const ComputePipelineInfo& info)
+    -> ComputePipelineInfo {
+    auto spirv_info = info;
+    spirv_info.path = get_precompiled_spirv_path(info.path, {});
+    spirv_info.source_language = ShaderSourceLanguage::SpirvBinary;
+    return spirv_info;
+}
+
+#else
+
+// Everything that determines an HLSL shader's SPIR-V, pulled out of a
+// ShaderInfo or ComputePipelineInfo.
+struct HlslCompileRequest {
+    std::filesystem::path path;
+    std::string entrypoint;
+    ShaderStage stage;
+    std::vector<ShaderDefine> defines;
+    ShaderResourceCounts resource_counts;
+};
+
+auto make_hlsl_compile_request(const ShaderInfo& info) -> HlslCompileRequest {
+    return HlslCompileRequest{
+        .path = info.path,
+        .entrypoint = info.entrypoint,
+        .stage = info.stage,
+        .defines = info.defines,
+        .resource_counts =
+            ShaderResourceCounts{
+                .sampler_count = info.sampler_count,
+                .uniform_buffer_count = info.uniform_buffer_count,
+                .storage_buffer_count = info.storage_buffer_count,
+                .storage_texture_count = info.storage_texture_count,
+            },
+    };
+}
+
+auto make_hlsl_compile_request(const ComputePipelineInfo& info)
+    -> HlslCompileRequest {
+    return HlslCompileRequest{
+        .path = info.path,
+        .entrypoint = info.entrypoint,
+        .stage = ShaderStage::Compute,
+        .defines = {},
+        .resource_counts =
+            ShaderResourceCounts{
+                .sampler_count = info.sampler_count,
+                .uniform_buffer_count = info.uniform_buffer_count,
+                .readonly_storage_texture_count =
+                    info.readonly_storage_texture_count,
+                .readonly_storage_buffer_count =
+                    info.readonly_storage_buffer_count,
+                .readwrite_storage_texture_count =
+                    info.readwrite_storage_texture_count,
+                .readwrite_storage_buffer_count =
+                    info.readwrite_storage_buffer_count,
+                .threadcount_x = info.threadcount_x,
+                .threadcount_y = info.threadcount_y,
+                .threadcount_z = info.threadcount_z,
+            },
+    };
+}
+
+auto read_hlsl_source(const std::filesystem::path& path) -> std::string {
+    auto shader_file = std::ifstream{path, std::ios::in};
+    return std::string{
+        std::istreambuf_iterator<char>{shader_file},
+        std::istreambuf_iterator<char>{}
+    };
+}
+
+auto get_hlsl_cache_key(
+    const HlslCompileRequest& request, const std::string& hlsl_source
+) -> uint64_t {
+    return compute_shader_cache_key(
+        hlsl_source,
+        request.entrypoint,
+        request.stage,
+        request.defines,
+        LUMINOL_SHADERCROSS_REVISION
+    );
+}
+
+// Compiles the HLSL to SPIR-V, or loads the result of an earlier compile
+// from the on-disk shader cache (see SDL_GPUShaderCache.hpp). A cached entry
+// created with different resource counts is recompiled rather than trusted,
+// since the counts aren't derived from the SPIR-V itself. Safe to call
+// concurrently for different keys: every call gets its own DXC compiler
+// instance inside shadercross, and writes its own cache file.
+auto load_or_compile_hlsl(
+    const HlslCompileRequest& request,
+    const std::string& hlsl_source,
+    uint64_t cache_key
+) -> ShaderCacheEntry {
+    const auto cache_path = get_shader_cache_path(cache_key);
+    if (auto entry = read_shader_cache(cache_path, cache_key);
+        entry.has_value() &&
+        entry->resource_counts == request.resource_counts) {
+        return std::move(entry).value();
+    }
+
+    // shadercross takes a null-terminated array of mutable C strings; copy
+    // the names/values out of the const defines.
+    auto define_strings = std::vector<std::string>{};
+    define_strings.reserve(request.defines.size() * 2);
+    for (const auto& define : request.defines) {
+        define_strings.push_back(define.name);
+        define_strings.push_back(define.value);
+    }
+    auto hlsl_defines = std::vector<SDL_ShaderCross_HLSL_Define>{};
+    hlsl_defines.reserve(request.defines.size() + 1);
+    for (auto i = std::size_t{0}; i < define_strings.size(); i += 2) {
+        hlsl_defines.push_back(SDL_ShaderCross_HLSL_Define{
+            .name = define_strings[i].data(),
+            .value = define_strings[i + 1].data(),
+        });
+    }
+    hlsl_defines.push_back(
+        SDL_ShaderCross_HLSL_Define{.name = nullptr, .value = nullptr}
+    );
+
+    const auto hlsl_info = SDL_ShaderCross_HLSL_Info{
+        .source = hlsl_source.c_str(),
+        .entrypoint = request.entrypoint.c_str(),
+        .include_dir = nullptr,
+        .defines = hlsl_defines.data(),
+        .shader_stage = to_shadercross_stage(request.stage),
+        .props = 0,
+    };
+
+    size_t spirv_size = 0;
+    auto* spirv_bytes = static_cast<uint8_t*>(
+        SDL_ShaderCross_CompileSPIRVFromHLSL(&hlsl_info, &spirv_size)
+    );
+    if (spirv_bytes == nullptr) {
+        SDL_LogError(
+            SDL_LOG_CATEGORY_ERROR,
+            "Failed to compile HLSL to SPIRV (%s): %s",
+            request.path.string().c_str(),
+            SDL_GetError()
+        );
+        Ensures(false);
+    }
+
+    auto entry = ShaderCacheEntry{
+        .resource_counts = request.resource_counts,
+        .spirv = std::vector<uint8_t>(spirv_bytes, spirv_bytes + spirv_size),
+    };
+    SDL_free(spirv_bytes);
+
+    // A failed write only costs the next startup a recompile.
+    write_shader_cache(cache_path, cache_key, entry);
+
+    return entry;
+}
+
+// The SPIR-V for request: taken from precompiled_spirv (see
+// GPUDevice::precompile_shaders) if it's there, otherwise loaded or compiled
+// on the spot.
+auto get_hlsl_spirv(
+    const HlslCompileRequest& request,
+    const std::unordered_map<uint64_t, ShaderCacheEntry>& precompiled_spirv
+) -> std::vector<uint8_t> {
+    const auto hlsl_source = read_hlsl_source(request.path);
+    const auto cache_key = get_hlsl_cache_key(request, hlsl_source);
+
+    const auto precompiled = precompiled_spirv.find(cache_key);
+    if (precompiled != precompiled_spirv.end() &&
+        precompiled->second.resource_counts == request.resource_counts) {
+        return precompiled->second.spirv;
+    }
+
+    return load_or_compile_hlsl(request, hlsl_source, cache_key).spirv;
+}
+
+#endif
+
 }  // namespace
 
 namespace Luminol::Graphics::SDL_GPU {
@@ -78,7 +303,9 @@ namespace Luminol::Graphics::SDL_GPU {
 // its dtor keeps that invariant. Do not reorder those members.
 GPUDevice::GPUDevice(SDL_Window* window)
     : device{create_sdl_gpu_device(window), [window](SDL_GPUDevice* device) {
+#ifndef LUMINOL_PRECOMPILED_SHADERS
                  SDL_ShaderCross_Quit();
+#endif
                  SDL_ReleaseWindowFromGPUDevice(device, window);
                  SDL_DestroyGPUDevice(device);
              }} {
@@ -121,38 +348,16 @@ auto GPUDevice::create_shader(const ShaderInfo& info) -> Shader {
     };
 
     if (info.source_language == ShaderSourceLanguage::Hlsl) {
-        auto shader_file = std::ifstream{info.path, std::ios::in};
-        auto hlsl_source = std::string{
-            std::istreambuf_iterator<char>{shader_file},
-            std::istreambuf_iterator<char>{}
-        };
-
-        const auto hlsl_info = SDL_ShaderCross_HLSL_Info{
-            .source = hlsl_source.c_str(),
-            .entrypoint = info.entrypoint.c_str(),
-            .include_dir = nullptr,
-            .defines = nullptr,
-            .shader_stage = to_shadercross_stage(info.stage),
-            .props = 0,
-        };
-
-        size_t spirv_size = 0;
-        auto* spirv_bytes = static_cast<uint8_t*>(
-            SDL_ShaderCross_CompileSPIRVFromHLSL(&hlsl_info, &spirv_size)
+#ifdef LUMINOL_PRECOMPILED_SHADERS
+        return this->create_shader(to_precompiled_spirv_info(info));
+#else
+        const auto spirv = get_hlsl_spirv(
+            make_hlsl_compile_request(info), this->precompiled_spirv
         );
-        if (spirv_bytes == nullptr) {
-            SDL_LogError(
-                SDL_LOG_CATEGORY_ERROR,
-                "Failed to compile HLSL to SPIRV (%s): %s",
-                info.path.string().c_str(),
-                SDL_GetError()
-            );
-            Ensures(false);
-        }
 
         const auto spirv_info = SDL_ShaderCross_SPIRV_Info{
-            .bytecode = spirv_bytes,
-            .bytecode_size = spirv_size,
+            .bytecode = spirv.data(),
+            .bytecode_size = spirv.size(),
             .entrypoint = info.entrypoint.c_str(),
             .shader_stage = to_shadercross_stage(info.stage),
             .props = 0,
@@ -169,8 +374,6 @@ auto GPUDevice::create_shader(const ShaderInfo& info) -> Shader {
             this->device.get(), &spirv_info, &resource_info, 0
         );
 
-        SDL_free(spirv_bytes);
-
         if (sdl_shader == nullptr) {
             SDL_LogError(
                 SDL_LOG_CATEGORY_ERROR,
@@ -186,22 +389,14 @@ auto GPUDevice::create_shader(const ShaderInfo& info) -> Shader {
                 sdl_shader, shader_deleter
             )
         };
+#endif
     }
 
-    auto shader_file = std::ifstream{
-        info.path, std::ios::in | std::ios::binary | std::ios::ate
-    };
-
-    const auto code_size = shader_file.tellg();
-    shader_file.seekg(0, std::ios::beg);
-
-    auto code_vector = std::vector<uint8_t>{};
-    code_vector.resize(code_size);
-    shader_file.read(reinterpret_cast<char*>(code_vector.data()), code_size);
+    const auto code = read_spirv_binary(info.path);
 
     const auto sdl_gpu_shader_create_info = SDL_GPUShaderCreateInfo{
-        .code_size = static_cast<size_t>(code_size),
-        .code = code_vector.data(),
+        .code_size = code.size(),
+        .code = code.data(),
         .entrypoint = info.entrypoint.c_str(),
         .format = SDL_GPU_SHADERFORMAT_SPIRV,
         .stage = to_sdl_shader_stage(info.stage),
@@ -212,9 +407,21 @@ auto GPUDevice::create_shader(const ShaderInfo& info) -> Shader {
         .props = 0,
     };
 
+    auto* sdl_shader =
+        SDL_CreateGPUShader(this->device.get(), &sdl_gpu_shader_create_info);
+
+    if (sdl_shader == nullptr) {
+        SDL_LogError(
+            SDL_LOG_CATEGORY_ERROR,
+            "Failed to create graphics shader from SPIRV (%s): %s",
+            info.path.string().c_str(),
+            SDL_GetError()
+        );
+        Ensures(false);
+    }
+
     return Shader{std::unique_ptr<SDL_GPUShader, Shader::SDL_GPUShaderDeleter>(
-        SDL_CreateGPUShader(this->device.get(), &sdl_gpu_shader_create_info),
-        shader_deleter
+        sdl_shader, shader_deleter
     )};
 }
 
@@ -368,38 +575,16 @@ auto GPUDevice::create_compute_pipeline(const ComputePipelineInfo& info)
         };
 
     if (info.source_language == ShaderSourceLanguage::Hlsl) {
-        auto shader_file = std::ifstream{info.path, std::ios::in};
-        auto hlsl_source = std::string{
-            std::istreambuf_iterator<char>{shader_file},
-            std::istreambuf_iterator<char>{}
-        };
-
-        const auto hlsl_info = SDL_ShaderCross_HLSL_Info{
-            .source = hlsl_source.c_str(),
-            .entrypoint = info.entrypoint.c_str(),
-            .include_dir = nullptr,
-            .defines = nullptr,
-            .shader_stage = SDL_SHADERCROSS_SHADERSTAGE_COMPUTE,
-            .props = 0,
-        };
-
-        size_t spirv_size = 0;
-        auto* spirv_bytes = static_cast<uint8_t*>(
-            SDL_ShaderCross_CompileSPIRVFromHLSL(&hlsl_info, &spirv_size)
+#ifdef LUMINOL_PRECOMPILED_SHADERS
+        return this->create_compute_pipeline(to_precompiled_spirv_info(info));
+#else
+        const auto spirv = get_hlsl_spirv(
+            make_hlsl_compile_request(info), this->precompiled_spirv
         );
-        if (spirv_bytes == nullptr) {
-            SDL_LogError(
-                SDL_LOG_CATEGORY_ERROR,
-                "Failed to compile HLSL to SPIRV (%s): %s",
-                info.path.string().c_str(),
-                SDL_GetError()
-            );
-            Ensures(false);
-        }
 
         const auto spirv_info = SDL_ShaderCross_SPIRV_Info{
-            .bytecode = spirv_bytes,
-            .bytecode_size = spirv_size,
+            .bytecode = spirv.data(),
+            .bytecode_size = spirv.size(),
             .entrypoint = info.entrypoint.c_str(),
             .shader_stage = SDL_SHADERCROSS_SHADERSTAGE_COMPUTE,
             .props = 0,
@@ -424,8 +609,6 @@ auto GPUDevice::create_compute_pipeline(const ComputePipelineInfo& info)
             this->device.get(), &spirv_info, &metadata, 0
         );
 
-        SDL_free(spirv_bytes);
-
         if (sdl_pipeline == nullptr) {
             SDL_LogError(
                 SDL_LOG_CATEGORY_ERROR,
@@ -441,22 +624,14 @@ auto GPUDevice::create_compute_pipeline(const ComputePipelineInfo& info)
             ComputePipeline::SDL_GPUComputePipelineDeleter>(
             sdl_pipeline, pipeline_deleter
         )};
+#endif
     }
 
-    auto shader_file = std::ifstream{
-        info.path, std::ios::in | std::ios::binary | std::ios::ate
-    };
-
-    const auto code_size = shader_file.tellg();
-    shader_file.seekg(0, std::ios::beg);
-
-    auto code_vector = std::vector<uint8_t>{};
-    code_vector.resize(code_size);
-    shader_file.read(reinterpret_cast<char*>(code_vector.data()), code_size);
+    const auto code = read_spirv_binary(info.path);
 
     const auto create_info = SDL_GPUComputePipelineCreateInfo{
-        .code_size = static_cast<size_t>(code_size),
-        .code = code_vector.data(),
+        .code_size = code.size(),
+        .code = code.data(),
         .entrypoint = info.entrypoint.c_str(),
         .format = SDL_GPU_SHADERFORMAT_SPIRV,
         .num_samplers = info.sampler_count,
@@ -471,11 +646,23 @@ auto GPUDevice::create_compute_pipeline(const ComputePipelineInfo& info)
         .props = 0,
     };
 
+    auto* sdl_pipeline =
+        SDL_CreateGPUComputePipeline(this->device.get(), &create_info);
+
+    if (sdl_pipeline == nullptr) {
+        SDL_LogError(
+            SDL_LOG_CATEGORY_ERROR,
+            "Failed to create compute pipeline from SPIRV (%s): %s",
+            info.path.string().c_str(),
+            SDL_GetError()
+        );
+        Ensures(false);
+    }
+
     return ComputePipeline{std::unique_ptr<
         SDL_GPUComputePipeline,
         ComputePipeline::SDL_GPUComputePipelineDeleter>(
-        SDL_CreateGPUComputePipeline(this->device.get(), &create_info),
-        pipeline_deleter
+        sdl_pipeline, pipeline_deleter
     )};
 }
 
@@ -729,6 +916,23 @@ auto GPUDevice::wait_for_idle() const -> void {
     }
 }
 
+auto GPUDevice::set_allowed_frames_in_flight(uint32_t frames_in_flight) const
+    -> bool {
+    if (!SDL_SetGPUAllowedFramesInFlight(
+            this->device.get(), frames_in_flight
+        )) {
+        SDL_LogError(
+            SDL_LOG_CATEGORY_ERROR,
+            "Failed to set GPU frames in flight to %u: %s",
+            frames_in_flight,
+            SDL_GetError()
+        );
+        return false;
+    }
+
+    return true;
+}
+
 auto GPUDevice::wait_for_fence(SDL_GPUFence* fence) const -> void {
     if (fence == nullptr) {
         return;
@@ -746,6 +950,14 @@ auto GPUDevice::wait_for_fence(SDL_GPUFence* fence) const -> void {
     }
 }
 
+auto GPUDevice::is_fence_signaled(SDL_GPUFence* fence) const -> bool {
+    if (fence == nullptr) {
+        return true;
+    }
+
+    return SDL_QueryGPUFence(this->device.get(), fence);
+}
+
 auto GPUDevice::release_fence(SDL_GPUFence* fence) const -> void {
     if (fence == nullptr) {
         return;
@@ -754,4 +966,104 @@ auto GPUDevice::release_fence(SDL_GPUFence* fence) const -> void {
     SDL_ReleaseGPUFence(this->device.get(), fence);
 }
 
+#ifdef LUMINOL_PRECOMPILED_SHADERS
+
+// Nothing to do - every shader was compiled at build time, and
+// create_shader/create_compute_pipeline just read its SPIR-V.
+auto GPUDevice::precompile_shaders(
+    gsl::span<const ShaderInfo> /*shaders*/,
+    gsl::span<const ComputePipelineInfo> /*compute_pipelines*/,
+    uint32_t /*worker_count*/
+) -> void {}
+
+#else
+
+auto GPUDevice::precompile_shaders(
+    gsl::span<const ShaderInfo> shaders,
+    gsl::span<const ComputePipelineInfo> compute_pipelines,
+    uint32_t worker_count
+) -> void {
+    const auto start = std::chrono::steady_clock::now();
+
+    struct PendingCompile {
+        HlslCompileRequest request;
+        std::string hlsl_source;
+        uint64_t cache_key;
+    };
+
+    // Sources are read and keyed up front, on this thread, so the same
+    // shader requested by several passes (fullscreen_vert.hlsl, say) is only
+    // compiled once.
+    auto pending = std::vector<PendingCompile>{};
+    auto pending_keys = std::unordered_set<uint64_t>{};
+    const auto add_pending = [&](HlslCompileRequest request) {
+        auto hlsl_source = read_hlsl_source(request.path);
+        const auto cache_key = get_hlsl_cache_key(request, hlsl_source);
+        if (this->precompiled_spirv.contains(cache_key) ||
+            !pending_keys.insert(cache_key).second) {
+            return;
+        }
+        pending.push_back(PendingCompile{
+            .request = std::move(request),
+            .hlsl_source = std::move(hlsl_source),
+            .cache_key = cache_key,
+        });
+    };
+    for (const auto& info : shaders) {
+        if (info.source_language == ShaderSourceLanguage::Hlsl) {
+            add_pending(make_hlsl_compile_request(info));
+        }
+    }
+    for (const auto& info : compute_pipelines) {
+        if (info.source_language == ShaderSourceLanguage::Hlsl) {
+            add_pending(make_hlsl_compile_request(info));
+        }
+    }
+
+    // Longest source first - the closest cheap proxy for compile time, so
+    // the big PBR shaders don't start last and leave the other workers idle
+    // (see Utilities::parallel_for).
+    std::ranges::sort(
+        pending,
+        std::ranges::greater{},
+        [](const PendingCompile& compile) { return compile.hlsl_source.size(); }
+    );
+
+    const auto resolved_worker_count =
+        Utilities::resolve_worker_count(worker_count, pending.size());
+    auto entries = std::vector<ShaderCacheEntry>(pending.size());
+    Utilities::parallel_for(
+        pending.size(),
+        resolved_worker_count,
+        [&](std::size_t index) {
+            const auto& compile = pending[index];
+            entries[index] = load_or_compile_hlsl(
+                compile.request, compile.hlsl_source, compile.cache_key
+            );
+        }
+    );
+
+    for (auto i = std::size_t{0}; i < pending.size(); ++i) {
+        this->precompiled_spirv.emplace(
+            pending[i].cache_key, std::move(entries[i])
+        );
+    }
+
+    SDL_Log(
+        "[ShaderCompile] %zu shaders precompiled on %u threads in %.1f ms",
+        pending.size(),
+        resolved_worker_count,
+        std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start
+        )
+            .count()
+    );
+}
+
+#endif
+
+auto GPUDevice::release_precompiled_shaders() -> void {
+    this->precompiled_spirv.clear();
+}
+
 }  // namespace Luminol::Graphics::SDL_GPU
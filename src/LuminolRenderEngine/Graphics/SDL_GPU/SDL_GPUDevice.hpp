@@ -1,8 +1,13 @@
 #pragma once
 
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <unordered_map>
 
+#include <gsl/gsl>
+
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUShaderCache.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUTypes.hpp>
 
 struct SDL_Window;
@@ -64,20 +69,54 @@ public:
     [[nodiscard]] auto set_present_mode(SDL_Window* window, PresentMode mode)
         const -> bool;
 
+    // How many frames SDL_GPU lets the swapchain run ahead of the GPU
+    // (1-3, SDL's default is 2) - acquiring a swapchain texture blocks
+    // beyond that. Returns false (and logs) if the change fails. Waits for
+    // the GPU to go idle first, so it's not for per-frame use.
+    [[nodiscard]] auto set_allowed_frames_in_flight(
+        uint32_t frames_in_flight
+    ) const -> bool;
+
     // Blocks the calling thread until fence is signaled. fence must have come
     // from this device's CommandBuffer::submit_and_acquire_fence(); a null
     // fence is a no-op. Does not release the fence - call release_fence
     // afterward.
     auto wait_for_fence(SDL_GPUFence* fence) const -> void;
 
+    // Whether fence has been signaled, without blocking. fence must have come
+    // from this device's CommandBuffer::submit_and_acquire_fence(); a null
+    // fence counts as signaled.
+    [[nodiscard]] auto is_fence_signaled(SDL_GPUFence* fence) const -> bool;
+
     // Releases a fence acquired from
     // CommandBuffer::submit_and_acquire_fence(). A null fence is a no-op.
     auto release_fence(SDL_GPUFence* fence) const -> void;
 
+    // Compiles every HLSL shader and compute pipeline described by shaders
+    // and compute_pipelines to SPIR-V at once, spread across worker_count
+    // threads (0 means one per hardware thread, see
+    // Utilities::resolve_worker_count), going through the on-disk shader
+    // cache like create_shader does. The SPIR-V is kept until
+    // release_precompiled_shaders, so create_shader/create_compute_pipeline
+    // calls for the same shader only have to create the SDL object. Calls
+    // for a shader that wasn't precompiled still work - they just compile
+    // on the calling thread as before. SpirvBinary entries are ignored, and
+    // the whole call is a no-op in a LUMINOL_PRECOMPILED_SHADERS build,
+    // which loads every HLSL shader from the SPIR-V compiled at build time.
+    auto precompile_shaders(
+        gsl::span<const ShaderInfo> shaders,
+        gsl::span<const ComputePipelineInfo> compute_pipelines,
+        uint32_t worker_count = 0
+    ) -> void;
+
+    auto release_precompiled_shaders() -> void;
+
 private:
     using SDL_GPUDeviceDeleter = std::function<void(SDL_GPUDevice*)>;
 
     std::unique_ptr<SDL_GPUDevice, SDL_GPUDeviceDeleter> device;
+    // Keyed by compute_shader_cache_key - see precompile_shaders.
+    std::unordered_map<uint64_t, ShaderCacheEntry> precompiled_spirv;
 };
 
 }  // namespace Luminol::Graphics::SDL_GPU
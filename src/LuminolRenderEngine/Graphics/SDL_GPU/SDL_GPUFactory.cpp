@@ -2,8 +2,10 @@
 
 #include <cstring>
 #include <optional>
+#include <utility>
 
 #include <gsl/gsl>
+#include <SDL3/SDL_log.h>
 #include <SDL3/SDL_video.h>
 #include <SDL3_ttf/SDL_ttf.h>
 
@@ -40,12 +42,23 @@ auto to_sample_count(uint32_t msaa_sample_count) -> SampleCount {
 template <typename TextureInfo>
 auto build_procedural_renderable(
     GPUDevice& gpu_device,
+    SDL_GPUTextureCache& texture_cache,
     gsl::span<const float> vertices,
     gsl::span<const uint32_t> indices,
-    const TextureInfo& texture_info
+    const TextureInfo& texture_info,
+    VertexFormat vertex_format
 ) -> RenderableMeshes {
     auto meshes = std::vector<SDL_GPUMesh>{};
 
+    auto compact_vertices = std::optional<CompactVertices>{};
+    if (vertex_format == VertexFormat::Compact) {
+        compact_vertices = encode_compact_vertices(vertices);
+    }
+    const auto vertex_bytes =
+        compact_vertices.has_value()
+            ? gsl::as_bytes(gsl::span{compact_vertices->vertices})
+            : gsl::as_bytes(vertices);
+
     auto command_buffer = gpu_device.create_command_buffer();
     auto vertex_buffer = std::optional<Buffer>{};
     auto index_buffer = std::optional<Buffer>{};
@@ -61,7 +74,7 @@ auto build_procedural_renderable(
             // (pbr_vert_meshlet.hlsl), purely additive - see
             // SDL_GPUMesh.cpp's matching vertex_buffer creation.
             .usage = BufferUsage::Vertex | BufferUsage::StorageRead,
-            .size = static_cast<uint32_t>(vertices.size_bytes()),
+            .size = static_cast<uint32_t>(vertex_bytes.size()),
         });
         index_buffer = gpu_device.create_buffer(BufferInfo{
             .usage = BufferUsage::Index,
@@ -71,18 +84,18 @@ auto build_procedural_renderable(
         auto vertex_transfer_buffer =
             gpu_device.create_transfer_buffer(TransferBufferInfo{
                 .usage = TransferBufferUsage::Upload,
-                .size = static_cast<uint32_t>(vertices.size_bytes()),
+                .size = static_cast<uint32_t>(vertex_bytes.size()),
             });
         {
             const auto mapped = vertex_transfer_buffer.map(false);
             std::memcpy(
-                mapped.data(), vertices.data(), vertices.size_bytes()
+                mapped.data(), vertex_bytes.data(), vertex_bytes.size()
             );
         }
         vertex_transfer_buffer.unmap();
         copy_pass.upload_to_buffer(
             vertex_transfer_buffer, 0, *vertex_buffer, 0,
-            static_cast<uint32_t>(vertices.size_bytes()), false
+            static_cast<uint32_t>(vertex_bytes.size()), false
         );
 
         auto index_transfer_buffer =
@@ -215,6 +228,7 @@ auto build_procedural_renderable(
         meshes.emplace_back(
             gpu_device,
             copy_pass,
+            texture_cache,
             lod_ranges,
             meshlet_ranges,
             0,
@@ -223,9 +237,7 @@ auto build_procedural_renderable(
         );
     }
 
-    for (const auto& mesh : meshes) {
-        mesh.generate_mipmaps(command_buffer);
-    }
+    texture_cache.generate_pending_mipmaps(command_buffer);
 
     command_buffer.submit();
 
@@ -235,6 +247,9 @@ auto build_procedural_renderable(
         .meshlet_metadata_buffer = std::move(meshlet_metadata_buffer).value(),
         .meshlet_vertices_buffer = std::move(meshlet_vertices_buffer).value(),
         .meshlet_triangles_buffer = std::move(meshlet_triangles_buffer).value(),
+        .vertex_dequantization = compact_vertices.has_value()
+                                     ? compact_vertices->dequantization
+                                     : VertexDequantization{},
         .meshes = std::move(meshes),
     };
 }
@@ -243,8 +258,14 @@ auto build_procedural_renderable(
 
 namespace Luminol::Graphics::SDL_GPU {
 
-SDL_GPUFactory::SDL_GPUFactory(uint32_t msaa_sample_count)
-    : requested_msaa_sample_count{to_sample_count(msaa_sample_count)} {
+SDL_GPUFactory::SDL_GPUFactory(
+    uint32_t msaa_sample_count,
+    const Utilities::ModelLoader::LoadOptions& model_load_options,
+    VertexFormat vertex_format
+)
+    : requested_msaa_sample_count{to_sample_count(msaa_sample_count)},
+      model_load_options{model_load_options},
+      vertex_format{vertex_format} {
     Expects(TTF_Init());
 }
 
@@ -266,6 +287,10 @@ auto SDL_GPUFactory::get_gpu_device() const -> std::shared_ptr<GPUDevice> {
     return gpu_device;
 }
 
+auto SDL_GPUFactory::get_vertex_format() const -> VertexFormat {
+    return this->vertex_format;
+}
+
 auto SDL_GPUFactory::create_mesh(
     gsl::span<const float> vertices,
     gsl::span<const uint32_t> indices,
@@ -276,7 +301,12 @@ auto SDL_GPUFactory::create_mesh(
     const auto renderable_id = this->renderable_manager.allocate_id();
 
     auto renderable_meshes = build_procedural_renderable(
-        *gpu_device, vertices, indices, texture_paths
+        *gpu_device,
+        this->texture_cache,
+        vertices,
+        indices,
+        texture_paths,
+        this->vertex_format
     );
 
     if (renderable_id >= this->meshes_by_id.size()) {
@@ -297,7 +327,12 @@ auto SDL_GPUFactory::create_mesh(
     const auto renderable_id = this->renderable_manager.allocate_id();
 
     auto renderable_meshes = build_procedural_renderable(
-        *gpu_device, vertices, indices, texture_images
+        *gpu_device,
+        this->texture_cache,
+        vertices,
+        indices,
+        texture_images,
+        this->vertex_format
     );
 
     if (renderable_id >= this->meshes_by_id.size()) {
@@ -322,16 +357,201 @@ auto SDL_GPUFactory::create_model(const std::filesystem::path& model_path)
     if (renderable_id >= this->meshes_by_id.size()) {
         this->meshes_by_id.resize(renderable_id + 1);
     }
-    this->meshes_by_id[renderable_id] =
-        load_meshes_from_model(*gpu_device, model_path);
+    this->meshes_by_id[renderable_id] = load_meshes_from_model(
+        *gpu_device,
+        this->texture_cache,
+        model_path,
+        model_load_options,
+        this->vertex_format
+    );
+
+    // A synchronous load of a path that's still loading asynchronously just
+    // wins the race - the async result is discarded once it arrives (its
+    // ticket no longer matches anything) and its callbacks fire now.
+    const auto async_load = this->async_loads.find(renderable_id);
+    if (async_load != this->async_loads.end()) {
+        auto on_loaded = std::move(async_load->second.on_loaded);
+        this->async_loads.erase(async_load);
+        for (const auto& callback : on_loaded) {
+            callback(renderable_id, RenderableLoadState::Resident);
+        }
+    }
+
+    return renderable_id;
+}
+
+auto SDL_GPUFactory::create_model_async(
+    const std::filesystem::path& model_path,
+    std::optional<RenderableId> proxy_renderable_id,
+    RenderableLoadCallback on_loaded
+) -> RenderableId {
+    Expects(gpu_device != nullptr);
+
+    const auto renderable_id = this->renderable_manager.allocate_id(model_path);
+
+    if (this->is_resident(renderable_id)) {
+        if (on_loaded) {
+            on_loaded(renderable_id, RenderableLoadState::Resident);
+        }
+        return renderable_id;
+    }
+
+    const auto existing_load = this->async_loads.find(renderable_id);
+    if (existing_load != this->async_loads.end()) {
+        auto& load = existing_load->second;
+        if (proxy_renderable_id.has_value()) {
+            load.proxy_renderable_id = proxy_renderable_id;
+        }
+        if (on_loaded) {
+            if (load.state == RenderableLoadState::Failed) {
+                on_loaded(renderable_id, RenderableLoadState::Failed);
+            } else {
+                load.on_loaded.push_back(std::move(on_loaded));
+            }
+        }
+        return renderable_id;
+    }
+
+    if (this->async_model_loader == nullptr) {
+        this->async_model_loader =
+            std::make_unique<AsyncModelLoader>(this->model_load_options);
+    }
+
+    const auto ticket = this->next_async_load_ticket++;
+    auto load = AsyncLoad{
+        .ticket = ticket,
+        .state = RenderableLoadState::Loading,
+        .proxy_renderable_id = proxy_renderable_id,
+        .on_loaded = {},
+    };
+    if (on_loaded) {
+        load.on_loaded.push_back(std::move(on_loaded));
+    }
+    this->async_loads.emplace(renderable_id, std::move(load));
+
+    this->async_model_loader->enqueue(renderable_id, ticket, model_path);
 
     return renderable_id;
 }
 
+auto SDL_GPUFactory::get_load_state(RenderableId renderable_id) const
+    -> RenderableLoadState {
+    if (this->is_resident(renderable_id)) {
+        return RenderableLoadState::Resident;
+    }
+
+    const auto async_load = this->async_loads.find(renderable_id);
+    return async_load != this->async_loads.end()
+               ? async_load->second.state
+               : RenderableLoadState::Unloaded;
+}
+
+auto SDL_GPUFactory::is_resident(RenderableId renderable_id) const -> bool {
+    return renderable_id < this->meshes_by_id.size() &&
+           this->meshes_by_id[renderable_id].has_value();
+}
+
+auto SDL_GPUFactory::get_draw_target(RenderableId renderable_id) const
+    -> std::optional<RenderableId> {
+    if (this->is_resident(renderable_id)) {
+        return renderable_id;
+    }
+
+    const auto async_load = this->async_loads.find(renderable_id);
+    if (async_load == this->async_loads.end()) {
+        return std::nullopt;
+    }
+
+    const auto proxy_renderable_id = async_load->second.proxy_renderable_id;
+    if (proxy_renderable_id.has_value() &&
+        this->is_resident(*proxy_renderable_id)) {
+        return proxy_renderable_id;
+    }
+
+    return std::nullopt;
+}
+
+auto SDL_GPUFactory::upload_completed_models(uint64_t byte_budget)
+    -> std::vector<RenderableId> {
+    auto resident_ids = std::vector<RenderableId>{};
+    if (this->async_model_loader == nullptr) {
+        return resident_ids;
+    }
+
+    for (auto& completed_load : this->async_model_loader->take_completed()) {
+        this->ready_model_loads.push_back(std::move(completed_load));
+    }
+
+    auto uploaded_bytes = uint64_t{0};
+    while (!this->ready_model_loads.empty()) {
+        const auto& next_load = this->ready_model_loads.front();
+        const auto renderable_id = next_load.renderable_id;
+        const auto async_load = this->async_loads.find(renderable_id);
+        if (async_load == this->async_loads.end() ||
+            async_load->second.ticket != next_load.ticket) {
+            this->ready_model_loads.pop_front();
+            continue;
+        }
+
+        auto& load = async_load->second;
+        if (!next_load.model.has_value()) {
+            this->ready_model_loads.pop_front();
+            SDL_LogError(
+                SDL_LOG_CATEGORY_RENDER,
+                "Failed to load model for renderable %u asynchronously",
+                renderable_id
+            );
+            load.state = RenderableLoadState::Failed;
+            for (const auto& callback : std::exchange(load.on_loaded, {})) {
+                callback(renderable_id, RenderableLoadState::Failed);
+            }
+            continue;
+        }
+
+        // Checked before taking the model, so it waits for the next call
+        // rather than overshooting this one's budget.
+        const auto upload_size_bytes =
+            next_load.model->get_upload_size_bytes();
+        if (!fits_upload_budget(
+                uploaded_bytes, upload_size_bytes, byte_budget
+            )) {
+            break;
+        }
+        uploaded_bytes += upload_size_bytes;
+
+        const auto completed_load = std::move(this->ready_model_loads.front());
+        this->ready_model_loads.pop_front();
+
+        if (renderable_id >= this->meshes_by_id.size()) {
+            this->meshes_by_id.resize(renderable_id + 1);
+        }
+        this->meshes_by_id[renderable_id] = upload_prepared_model(
+            *gpu_device,
+            this->texture_cache,
+            *completed_load.model,
+            this->vertex_format
+        );
+
+        auto on_loaded = std::move(load.on_loaded);
+        this->async_loads.erase(async_load);
+        resident_ids.push_back(renderable_id);
+
+        for (const auto& callback : on_loaded) {
+            callback(renderable_id, RenderableLoadState::Resident);
+        }
+    }
+
+    return resident_ids;
+}
+
 auto SDL_GPUFactory::remove_renderable(RenderableId renderable_id) -> void {
-    if (renderable_id < this->meshes_by_id.size()) {
+    if (renderable_id < this->meshes_by_id.size() &&
+        this->meshes_by_id[renderable_id].has_value()) {
         this->meshes_by_id[renderable_id].reset();
+        // Textures only this renderable's meshes were still using.
+        this->texture_cache.release_unused();
     }
+    this->async_loads.erase(renderable_id);
     this->renderable_manager.remove_renderable(renderable_id);
 }
 
@@ -350,6 +570,13 @@ auto SDL_GPUFactory::get_index_buffer(RenderableId renderable_id) const
     return gsl::at(this->meshes_by_id, renderable_id).value().index_buffer;
 }
 
+auto SDL_GPUFactory::get_vertex_dequantization(RenderableId renderable_id) const
+    -> const VertexDequantization& {
+    return gsl::at(this->meshes_by_id, renderable_id)
+        .value()
+        .vertex_dequantization;
+}
+
 auto SDL_GPUFactory::get_meshlet_metadata_buffer(RenderableId renderable_id) const
     -> const Buffer& {
     return gsl::at(this->meshes_by_id, renderable_id)
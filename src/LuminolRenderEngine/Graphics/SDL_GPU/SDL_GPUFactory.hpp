@@ -1,5 +1,6 @@
 #pragma once
 
+#include <deque>
 #include <filesystem>
 #include <memory>
 #include <optional>
@@ -10,9 +11,12 @@
 
 #include <LuminolRenderEngine/Graphics/RenderableManager.hpp>
 #include <LuminolRenderEngine/Graphics/TexturePaths.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUAsyncModelLoader.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/Text/SDL_GPUFont.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUMesh.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUTextureCache.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUTypes.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUVertexFormat.hpp>
 #include <LuminolRenderEngine/Window/Window.hpp>
 
 namespace Luminol::Graphics::SDL_GPU {
@@ -22,7 +26,11 @@ class SDL_GPURenderer;
 
 class SDL_GPUFactory : public std::enable_shared_from_this<SDL_GPUFactory> {
 public:
-    explicit SDL_GPUFactory(uint32_t msaa_sample_count = 4);
+    explicit SDL_GPUFactory(
+        uint32_t msaa_sample_count = 4,
+        const Utilities::ModelLoader::LoadOptions& model_load_options = {},
+        VertexFormat vertex_format = VertexFormat::Full
+    );
     ~SDL_GPUFactory();
 
     SDL_GPUFactory(const SDL_GPUFactory&) = delete;
@@ -48,10 +56,49 @@ public:
     [[nodiscard]] auto create_model(const std::filesystem::path& model_path)
         -> RenderableId;
 
+    // Returns immediately; the model is prepared on a background thread (see
+    // AsyncModelLoader) and uploaded by a later upload_completed_models
+    // call. Like create_model, the same path always maps to the same id - a
+    // path that's already resident just gets on_loaded invoked right away,
+    // and one that's already loading gets on_loaded appended. Until the id
+    // is resident, get_draw_target redirects it to proxy_renderable_id (if
+    // given and itself resident) or drops it.
+    [[nodiscard]] auto create_model_async(
+        const std::filesystem::path& model_path,
+        std::optional<RenderableId> proxy_renderable_id = std::nullopt,
+        RenderableLoadCallback on_loaded = {}
+    ) -> RenderableId;
+
+    [[nodiscard]] auto get_load_state(RenderableId renderable_id) const
+        -> RenderableLoadState;
+
+    [[nodiscard]] auto is_resident(RenderableId renderable_id) const -> bool;
+
+    // The id a queue_draw for renderable_id should actually draw this frame:
+    // itself once resident, otherwise its async load's proxy if that is
+    // resident, otherwise std::nullopt (skip the draw).
+    [[nodiscard]] auto get_draw_target(RenderableId renderable_id) const
+        -> std::optional<RenderableId>;
+
+    // Uploads async loads that have finished preparing, oldest first, while
+    // the next one fits what's left of byte_budget (see
+    // PreparedModel::get_upload_size_bytes and fits_upload_budget). A model
+    // is never split across frames, so the first one each call is uploaded
+    // even if it alone exceeds the budget - otherwise an oversized model
+    // would never become resident. Invokes each finished load's
+    // callbacks and returns the ids that became resident. Must be called on
+    // the render thread, outside any command buffer being recorded.
+    auto upload_completed_models(uint64_t byte_budget)
+        -> std::vector<RenderableId>;
+
     auto remove_renderable(RenderableId renderable_id) -> void;
 
     [[nodiscard]] auto get_gpu_device() const -> std::shared_ptr<GPUDevice>;
 
+    // The layout every renderable's vertex buffer is stored in - fixed for
+    // the factory's lifetime, so passes build their pipelines for it once.
+    [[nodiscard]] auto get_vertex_format() const -> VertexFormat;
+
     [[nodiscard]] auto get_meshes(RenderableId renderable_id) const
         -> gsl::span<const SDL_GPUMesh>;
 
@@ -61,6 +108,9 @@ public:
         -> const Buffer&;
     [[nodiscard]] auto get_index_buffer(RenderableId renderable_id) const
         -> const Buffer&;
+    // Pushed to vertex uniform slot 1 alongside the vertex buffer binding.
+    [[nodiscard]] auto get_vertex_dequantization(RenderableId renderable_id)
+        const -> const VertexDequantization&;
 
     // The renderable's shared meshlet arrays - see RenderableMeshes,
     // SDL_GPUMeshletCullPass. Only consumed by the main color pass's
@@ -80,8 +130,13 @@ public:
 
 private:
     SampleCount requested_msaa_sample_count;
+    Utilities::ModelLoader::LoadOptions model_load_options;
+    VertexFormat vertex_format;
 
     std::shared_ptr<GPUDevice> gpu_device;
+    // Shared by every renderable's meshes, so the same image referenced by
+    // several submeshes or models is uploaded (and mip-mapped) once.
+    SDL_GPUTextureCache texture_cache;
     RenderableManager renderable_manager;
     // Indexed directly by RenderableId (allocated monotonically, never
     // reused - see RenderableManager::get_free_renderable_id), so lookups
@@ -91,6 +146,25 @@ private:
 
     RenderableManager font_manager;
     std::unordered_map<FontId, SDL_GPUFont> fonts_by_id;
+
+    // One entry per create_model_async id that isn't resident yet (Loading)
+    // or never will be (Failed); erased once it becomes resident or is
+    // removed. ticket distinguishes this load from an earlier one for the
+    // same (since removed and reallocated) id still in flight on the loader
+    // thread, whose result is then discarded.
+    struct AsyncLoad {
+        uint64_t ticket;
+        RenderableLoadState state;
+        std::optional<RenderableId> proxy_renderable_id;
+        std::vector<RenderableLoadCallback> on_loaded;
+    };
+    std::unordered_map<RenderableId, AsyncLoad> async_loads;
+    uint64_t next_async_load_ticket = 0;
+    // Prepared on the loader thread but not uploaded yet (over budget).
+    std::deque<CompletedModelLoad> ready_model_loads;
+    // Created on first use so apps that never load asynchronously don't pay
+    // for an idle thread. Declared last: destroyed (joined) first.
+    std::unique_ptr<AsyncModelLoader> async_model_loader;
 };
 
 }  // namespace Luminol::Graphics::SDL_GPU
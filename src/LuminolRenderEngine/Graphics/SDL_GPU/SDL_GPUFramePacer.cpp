@@ -0,0 +1,121 @@
+#include "SDL_GPUFramePacer.hpp"
+
+#include <cstddef>
+
+#include <gsl/gsl>
+
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUCommandBuffer.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUDevice.hpp>
+
+namespace Luminol::Graphics::SDL_GPU {
+
+namespace {
+
+// Room for max_frames_in_flight plus the frames a StagingRing wait or a
+// readback can briefly add, so tracking them never allocates.
+constexpr auto max_expected_tracked_frames = std::size_t{8};
+
+}  // namespace
+
+FramePacer::FramePacer(std::shared_ptr<GPUDevice> device)
+    : device{std::move(device)} {
+    Expects(this->device != nullptr);
+
+    in_flight_frames.reserve(max_expected_tracked_frames);
+}
+
+FramePacer::~FramePacer() {
+    for (const auto& frame : in_flight_frames) {
+        device->release_fence(frame.fence);
+    }
+}
+
+auto FramePacer::begin_frame(uint32_t frames_in_flight) -> void {
+    Expects(
+        frames_in_flight >= min_frames_in_flight &&
+        frames_in_flight <= max_frames_in_flight
+    );
+
+    poll();
+
+    // Blocking here, rather than in acquire_swapchain_texture, keeps the
+    // wait out of the swapchain's own pacing so it can be told apart.
+    if (in_flight_frames.size() >= frames_in_flight) {
+        const auto wait_timer = Utilities::Timer{};
+        wait_for_frame(
+            in_flight_frames[in_flight_frames.size() - frames_in_flight].frame
+        );
+        frame_stats.gpu_wait_time =
+            Units::Seconds{wait_timer.elapsed_seconds()};
+    }
+
+    frame_stats.frames_in_flight =
+        static_cast<uint32_t>(in_flight_frames.size());
+}
+
+auto FramePacer::submit(CommandBuffer& command_buffer) -> uint64_t {
+    poll();
+    if (in_flight_frames.empty() && gpu_idle_timer.has_value()) {
+        frame_stats.cpu_wait_time =
+            Units::Seconds{gpu_idle_timer->elapsed_seconds()};
+    }
+    gpu_idle_timer.reset();
+
+    ++last_submitted_frame;
+    in_flight_frames.push_back(InFlightFrame{
+        .frame = last_submitted_frame,
+        .fence = command_buffer.submit_and_acquire_fence(),
+        .submit_timer = Utilities::Timer{},
+    });
+
+    last_frame_stats = frame_stats;
+    frame_stats = FramePacingStats{};
+
+    return last_submitted_frame;
+}
+
+auto FramePacer::wait_for_frame(uint64_t frame) -> void {
+    Expects(frame <= last_submitted_frame);
+
+    while (!is_frame_complete(frame)) {
+        device->wait_for_fence(in_flight_frames.front().fence);
+        retire_oldest_frame();
+    }
+    poll();
+}
+
+auto FramePacer::poll() -> void {
+    while (!in_flight_frames.empty() &&
+           device->is_fence_signaled(in_flight_frames.front().fence)) {
+        retire_oldest_frame();
+    }
+}
+
+auto FramePacer::is_frame_complete(uint64_t frame) const -> bool {
+    return frame <= last_completed_frame;
+}
+
+auto FramePacer::get_last_submitted_frame() const -> uint64_t {
+    return last_submitted_frame;
+}
+
+auto FramePacer::get_last_frame_stats() const -> FramePacingStats {
+    return last_frame_stats;
+}
+
+auto FramePacer::retire_oldest_frame() -> void {
+    const auto& oldest = in_flight_frames.front();
+
+    frame_stats.gpu_frame_time =
+        Units::Seconds{oldest.submit_timer.elapsed_seconds()};
+    frame_stats.gpu_frame_index = oldest.frame;
+    last_completed_frame = oldest.frame;
+    device->release_fence(oldest.fence);
+
+    in_flight_frames.erase(in_flight_frames.begin());
+    if (in_flight_frames.empty()) {
+        gpu_idle_timer = Utilities::Timer{};
+    }
+}
+
+}  // namespace Luminol::Graphics::SDL_GPU
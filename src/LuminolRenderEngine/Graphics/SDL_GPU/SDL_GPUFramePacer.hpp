@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <LuminolMaths/Units/Time.hpp>
+
+#include <LuminolRenderEngine/Utilities/Timer.hpp>
+
+struct SDL_GPUFence;
+
+namespace Luminol::Graphics::SDL_GPU {
+
+class CommandBuffer;
+class GPUDevice;
+
+// Where one frame's time went, for telling CPU-bound frames from GPU-bound
+// ones without stalling the pipeline.
+struct FramePacingStats {
+    // Time begin_frame() blocked waiting for the GPU to finish a frame, so
+    // that no more than the frames-in-flight limit were queued - nonzero
+    // means GPU-bound.
+    Units::Seconds gpu_wait_time{0.0};
+    // Time the GPU sat with nothing queued before this frame was submitted
+    // - nonzero means CPU-bound. A lower bound: the GPU's finish is only
+    // noticed the next time the pacer polls its fences.
+    Units::Seconds cpu_wait_time{0.0};
+    // Submit-to-completion time of the newest frame found finished during
+    // this one (frame gpu_frame_index, a few frames back), or nullopt if
+    // none finished. An upper bound on that frame's GPU time, found by
+    // polling its fence rather than waiting on it.
+    std::optional<Units::Seconds> gpu_frame_time;
+    uint64_t gpu_frame_index = 0;
+    // Frames still running on the GPU once begin_frame() returned.
+    uint32_t frames_in_flight = 0;
+};
+
+// Tracks every submitted frame by a per-frame fence, so the renderer can cap
+// how many frames it queues ahead of the GPU, and anything reusing per-frame
+// memory (StagingRing) can tell which frames the GPU is done with.
+//
+// Frames are numbered from 1 in submission order - 0 means "no frame", which
+// is always complete. A frame's fence is polled (never waited on) once per
+// begin_frame()/submit() unless something explicitly waits for it, so
+// tracking a frame costs no CPU/GPU sync.
+class FramePacer {
+public:
+    constexpr static auto min_frames_in_flight = uint32_t{1};
+    constexpr static auto max_frames_in_flight = uint32_t{3};
+    // Lowest input latency: the CPU never runs more than one frame ahead,
+    // at the cost of leaving the GPU idle while the CPU records.
+    constexpr static auto low_latency_frames_in_flight = min_frames_in_flight;
+    constexpr static auto default_frames_in_flight = uint32_t{2};
+    // Highest throughput: the CPU can run up to three frames ahead, so
+    // neither side waits on the other through a slow frame or two.
+    constexpr static auto throughput_frames_in_flight = max_frames_in_flight;
+
+    explicit FramePacer(std::shared_ptr<GPUDevice> device);
+
+    FramePacer(const FramePacer&) = delete;
+    FramePacer(FramePacer&&) = delete;
+    auto operator=(const FramePacer&) -> FramePacer& = delete;
+    auto operator=(FramePacer&&) -> FramePacer& = delete;
+    ~FramePacer();
+
+    // Starts a frame: blocks until fewer than frames_in_flight earlier
+    // frames are still running on the GPU.
+    auto begin_frame(uint32_t frames_in_flight) -> void;
+
+    // Submits command_buffer with a fence, closing the frame's stats.
+    // Returns the new frame's number.
+    auto submit(CommandBuffer& command_buffer) -> uint64_t;
+
+    // Blocks until frame has finished on the GPU.
+    auto wait_for_frame(uint64_t frame) -> void;
+
+    // Retires every frame that has finished, without blocking.
+    auto poll() -> void;
+
+    [[nodiscard]] auto is_frame_complete(uint64_t frame) const -> bool;
+    [[nodiscard]] auto get_last_submitted_frame() const -> uint64_t;
+    [[nodiscard]] auto get_last_frame_stats() const -> FramePacingStats;
+
+private:
+    struct InFlightFrame {
+        uint64_t frame = 0;
+        SDL_GPUFence* fence = nullptr;
+        Utilities::Timer submit_timer;
+    };
+
+    // Retires the oldest in-flight frame, which must have finished.
+    auto retire_oldest_frame() -> void;
+
+    std::shared_ptr<GPUDevice> device;
+
+    // Oldest first.
+    std::vector<InFlightFrame> in_flight_frames;
+    uint64_t last_submitted_frame = 0;
+    uint64_t last_completed_frame = 0;
+
+    // Running since the GPU was last seen with nothing queued.
+    std::optional<Utilities::Timer> gpu_idle_timer = Utilities::Timer{};
+
+    FramePacingStats frame_stats;
+    FramePacingStats last_frame_stats;
+};
+
+}  // namespace Luminol::Graphics::SDL_GPU
@@ -0,0 +1,191 @@
+#include "SDL_GPUInstanceBatch.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace Luminol::Graphics::SDL_GPU {
+
+auto ensure_capacity(QueuedDraws& queued_draws, RenderableId renderable_id)
+    -> void {
+    if (renderable_id < queued_draws.frame_ranges.size()) {
+        return;
+    }
+
+    const auto new_size = renderable_id + 1;
+    queued_draws.frame_ranges.resize(new_size);
+    queued_draws.mapped_instance_counts.resize(new_size, 0);
+    queued_draws.mapped_world_bounds.resize(new_size);
+    queued_draws.static_model_matrices.resize(new_size);
+    queued_draws.is_static.resize(new_size, 0);
+}
+
+auto queue_frame_instances(
+    QueuedDraws& queued_draws,
+    RenderableId renderable_id,
+    gsl::span<const Maths::Matrix4x4f> model_matrices
+) -> void {
+    if (model_matrices.empty()) {
+        return;
+    }
+
+    auto& matrices = queued_draws.frame_model_matrices;
+    const auto first_instance = static_cast<uint32_t>(matrices.size());
+    const auto instance_count = static_cast<uint32_t>(model_matrices.size());
+    matrices.insert(
+        matrices.end(), model_matrices.begin(), model_matrices.end()
+    );
+
+    auto& runs = queued_draws.frame_runs;
+    if (!runs.empty() && runs.back().renderable_id == renderable_id) {
+        runs.back().range.instance_count += instance_count;
+        return;
+    }
+
+    runs.push_back(QueuedRun{
+        .renderable_id = renderable_id,
+        .range =
+            InstanceRange{
+                .first_instance = first_instance,
+                .instance_count = instance_count,
+            },
+    });
+}
+
+auto group_frame_instances(QueuedDraws& queued_draws) -> void {
+    auto& ranges = queued_draws.frame_ranges;
+    std::ranges::fill(ranges, InstanceRange{});
+
+    auto needs_regroup = false;
+    for (const auto& run : queued_draws.frame_runs) {
+        auto& range = ranges[run.renderable_id];
+        needs_regroup = needs_regroup || range.instance_count > 0;
+        range.first_instance = run.range.first_instance;
+        range.instance_count += run.range.instance_count;
+    }
+
+    if (!needs_regroup) {
+        return;
+    }
+
+    // Lay renderables out in order of first appearance, copying every run to
+    // its renderable's next free slot. A cursor holds that slot + 1, so 0
+    // means the renderable hasn't been laid out yet.
+    auto& cursors = queued_draws.grouping_cursors;
+    cursors.assign(ranges.size(), 0);
+
+    auto& source = queued_draws.frame_model_matrices;
+    auto& grouped = queued_draws.grouping_scratch;
+    grouped.resize(source.size());
+
+    auto next_first_instance = uint32_t{0};
+    for (const auto& run : queued_draws.frame_runs) {
+        auto& range = ranges[run.renderable_id];
+        auto& cursor = cursors[run.renderable_id];
+        if (cursor == 0) {
+            range.first_instance = next_first_instance;
+            cursor = next_first_instance + 1;
+            next_first_instance += range.instance_count;
+        }
+
+        std::copy_n(
+            source.begin() + run.range.first_instance,
+            run.range.instance_count,
+            grouped.begin() + (cursor - 1)
+        );
+        cursor += run.range.instance_count;
+    }
+    std::swap(source, grouped);
+}
+
+auto get_model_matrices(
+    const QueuedDraws& queued_draws, RenderableId renderable_id
+) -> gsl::span<const Maths::Matrix4x4f> {
+    const auto retained_model_matrices =
+        queued_draws.retained_instances.get_model_matrices(renderable_id);
+    if (!retained_model_matrices.empty()) {
+        return retained_model_matrices;
+    }
+
+    if (renderable_id >= queued_draws.frame_ranges.size()) {
+        return {};
+    }
+
+    if (queued_draws.is_static[renderable_id] != 0) {
+        return queued_draws.static_model_matrices[renderable_id];
+    }
+
+    const auto& range = queued_draws.frame_ranges[renderable_id];
+    const auto frame_model_matrices =
+        gsl::span<const Maths::Matrix4x4f>{queued_draws.frame_model_matrices};
+    return frame_model_matrices.subspan(
+        range.first_instance, range.instance_count
+    );
+}
+
+auto get_instance_count(
+    const QueuedDraws& queued_draws, RenderableId renderable_id
+) -> uint32_t {
+    if (renderable_id < queued_draws.mapped_instance_counts.size() &&
+        queued_draws.mapped_instance_counts[renderable_id] > 0) {
+        return queued_draws.mapped_instance_counts[renderable_id];
+    }
+    return static_cast<uint32_t>(
+        get_model_matrices(queued_draws, renderable_id).size()
+    );
+}
+
+auto get_mapped_world_bounds(
+    const QueuedDraws& queued_draws, RenderableId renderable_id
+) -> std::optional<BoundingBox> {
+    if (renderable_id >= queued_draws.mapped_instance_counts.size() ||
+        queued_draws.mapped_instance_counts[renderable_id] == 0) {
+        return std::nullopt;
+    }
+    return queued_draws.mapped_world_bounds[renderable_id];
+}
+
+auto clear_frame_instances(QueuedDraws& queued_draws) -> void {
+    queued_draws.frame_model_matrices.clear();
+    queued_draws.frame_runs.clear();
+    std::ranges::fill(queued_draws.frame_ranges, InstanceRange{});
+    std::ranges::fill(queued_draws.mapped_instance_counts, 0U);
+}
+
+auto hand_off_queued_draws(QueuedDraws& source, QueuedDraws& destination)
+    -> void {
+    // Same size on both sides, so the per-renderable vectors swapped below
+    // stay valid for every id either side has seen.
+    if (!source.frame_ranges.empty()) {
+        ensure_capacity(
+            destination,
+            static_cast<RenderableId>(source.frame_ranges.size() - 1)
+        );
+    }
+    if (!destination.frame_ranges.empty()) {
+        ensure_capacity(
+            source,
+            static_cast<RenderableId>(destination.frame_ranges.size() - 1)
+        );
+    }
+
+    std::swap(source.frame_model_matrices, destination.frame_model_matrices);
+    std::swap(source.frame_runs, destination.frame_runs);
+    std::swap(
+        source.mapped_instance_counts, destination.mapped_instance_counts
+    );
+    std::swap(source.mapped_world_bounds, destination.mapped_world_bounds);
+
+    if (source.static_instances_dirty) {
+        destination.static_model_matrices = source.static_model_matrices;
+        destination.is_static = source.is_static;
+        destination.static_instances_dirty = true;
+        source.static_instances_dirty = false;
+    }
+
+    destination.retained_instances.sync_from(source.retained_instances);
+    source.retained_instances.clear_dirty();
+
+    clear_frame_instances(source);
+}
+
+}  // namespace Luminol::Graphics::SDL_GPU
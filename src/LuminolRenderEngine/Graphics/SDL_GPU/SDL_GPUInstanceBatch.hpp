@@ -1,47 +1,134 @@
 #pragma once
 
 #include <cstdint>
+#include <optional>
 #include <vector>
 
+#include <gsl/gsl>
 #include <LuminolMaths/Matrix.hpp>
 
+#include <LuminolRenderEngine/Graphics/BoundingBox.hpp>
 #include <LuminolRenderEngine/Graphics/RenderableManager.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPURetainedInstanceStore.hpp>
 
 namespace Luminol::Graphics::SDL_GPU {
 
 struct InstanceBatch {
     RenderableId renderable_id;
     uint32_t instance_count;
+    // Index of the batch's first instance within the instance arena it was
+    // uploaded into (see SDL_GPUInstanceBufferCache::get_first_instance).
+    // Every pass offsets its draws' first_instance - and the cull pass its
+    // instance_models reads - by this.
+    uint32_t first_instance = 0;
 };
 
-// Per-RenderableId queued-draw state for the current frame, indexed directly
-// by id (allocated monotonically, never reused - see
-// RenderableManager::get_free_renderable_id) instead of an unordered_map, so
-// every render pass's per-batch lookup is a direct index instead of a hash
-// probe. registered distinguishes "never queued" from "queued but currently
-// empty" - needed because the dense vectors must stay index-valid for every
-// id up to the highest ever queued, not just the ones actually in use this
-// frame.
+// A renderable's contiguous slice of an instance arena.
+struct InstanceRange {
+    uint32_t first_instance = 0;
+    uint32_t instance_count = 0;
+};
+
+// One queue_draw/queue_draw_instanced call's slice of
+// QueuedDraws::frame_model_matrices (consecutive calls for the same id are
+// merged into one).
+struct QueuedRun {
+    RenderableId renderable_id;
+    InstanceRange range;
+};
+
+// Queued-draw state. Dynamic draws go into one flat, per-frame arena
+// (frame_model_matrices) that keeps its capacity across frames, so queueing
+// never allocates per renderable, and the whole frame uploads as one
+// contiguous block. Static draws (queue_draw_instanced_static) are retained
+// across frames in their own per-renderable lists instead, and retained
+// instances (create_instance) in retained_instances. Mapped draws
+// (map_instances) never pass through the CPU at all - only their count and
+// caller-supplied bounds are recorded here.
+//
+// Per-renderable vectors are indexed directly by id (allocated
+// monotonically, never reused - see RenderableManager::get_free_renderable_id)
+// instead of an unordered_map, so every render pass's per-batch lookup is a
+// direct index instead of a hash probe.
 struct QueuedDraws {
-    std::vector<std::vector<Maths::Matrix4x4f>> model_matrices;
-    std::vector<std::uint8_t> registered;
+    // In queue call order until group_frame_instances() makes every
+    // renderable's instances contiguous.
+    std::vector<Maths::Matrix4x4f> frame_model_matrices;
+    std::vector<QueuedRun> frame_runs;
+    // Each renderable's slice of frame_model_matrices - only valid after
+    // group_frame_instances(). instance_count 0 if it wasn't queued this
+    // frame.
+    std::vector<InstanceRange> frame_ranges;
+
+    // Instances map_instances handed out this frame (0 if it wasn't mapped)
+    // and the world-space bounds the caller gave for all of them, which
+    // stand in for the matrices wherever the CPU would otherwise read them
+    // back (sorting, CPU frustum tests).
+    std::vector<uint32_t> mapped_instance_counts;
+    std::vector<BoundingBox> mapped_world_bounds;
+
+    std::vector<std::vector<Maths::Matrix4x4f>> static_model_matrices;
     std::vector<std::uint8_t> is_static;
-    std::vector<std::uint8_t> pending_static_upload;
+    // Set whenever the static instance set changes (or a static id becomes
+    // resident), so the static arena is rebuilt and re-uploaded once.
+    bool static_instances_dirty = false;
+
+    RetainedInstanceStore retained_instances;
+
+    // Reused by group_frame_instances() when it has to reorder.
+    std::vector<Maths::Matrix4x4f> grouping_scratch;
+    std::vector<uint32_t> grouping_cursors;
 };
 
-// Grows every vector in queued_draws together so renderable_id is always a
-// valid index into all four afterward.
-inline auto ensure_capacity(QueuedDraws& queued_draws, RenderableId renderable_id)
-    -> void {
-    if (renderable_id < queued_draws.model_matrices.size()) {
-        return;
-    }
-
-    const auto new_size = renderable_id + 1;
-    queued_draws.model_matrices.resize(new_size);
-    queued_draws.registered.resize(new_size, 0);
-    queued_draws.is_static.resize(new_size, 0);
-    queued_draws.pending_static_upload.resize(new_size, 0);
-}
+// Grows every per-renderable vector in queued_draws together so
+// renderable_id is always a valid index into all of them afterward.
+auto ensure_capacity(QueuedDraws& queued_draws, RenderableId renderable_id)
+    -> void;
+
+// Appends model_matrices to this frame's arena for renderable_id.
+auto queue_frame_instances(
+    QueuedDraws& queued_draws,
+    RenderableId renderable_id,
+    gsl::span<const Maths::Matrix4x4f> model_matrices
+) -> void;
+
+// Fills frame_ranges. Only moves matrices around when some renderable was
+// queued by more than one non-consecutive call this frame; the usual one
+// queue_draw_instanced call per renderable is already grouped.
+auto group_frame_instances(QueuedDraws& queued_draws) -> void;
+
+// renderable_id's model matrices for this frame - its static list if it's
+// static, its retained instances if it has any, otherwise its frame_ranges
+// slice (so only valid after group_frame_instances()).
+[[nodiscard]] auto get_model_matrices(
+    const QueuedDraws& queued_draws, RenderableId renderable_id
+) -> gsl::span<const Maths::Matrix4x4f>;
+
+// How many instances renderable_id draws this frame, whichever API they
+// came from.
+[[nodiscard]] auto get_instance_count(
+    const QueuedDraws& queued_draws, RenderableId renderable_id
+) -> uint32_t;
+
+// The bounds passed to map_instances for renderable_id this frame, if it was
+// mapped - its matrices only exist in GPU staging memory, so
+// get_model_matrices() returns nothing for it.
+[[nodiscard]] auto get_mapped_world_bounds(
+    const QueuedDraws& queued_draws, RenderableId renderable_id
+) -> std::optional<BoundingBox>;
+
+// Empties the frame arena for the next frame, keeping its capacity, and
+// forgets this frame's mapped draws. Static lists are left alone.
+auto clear_frame_instances(QueuedDraws& queued_draws) -> void;
+
+// Moves everything queued into source since the last hand-off over to
+// destination, a second QueuedDraws that another thread records from (see
+// SDL_GPURenderer::set_render_thread_enabled): this frame's draws are
+// swapped across, so both sides keep their capacity, static lists are
+// copied only when they've changed, and retained instances only slot by
+// dirty slot. Leaves source with an empty frame and nothing dirty, and
+// destination dirty wherever the GPU copy is now stale.
+auto hand_off_queued_draws(QueuedDraws& source, QueuedDraws& destination)
+    -> void;
 
 }  // namespace Luminol::Graphics::SDL_GPU
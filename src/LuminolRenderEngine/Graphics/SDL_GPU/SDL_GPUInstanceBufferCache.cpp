@@ -1,6 +1,8 @@
 #include "SDL_GPUInstanceBufferCache.hpp"
 
-#include <cstring>
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <numeric>
 #include <vector>
 
@@ -11,100 +13,549 @@ namespace Luminol::Graphics::SDL_GPU {
 
 namespace {
 
-auto ensure_identity_indices_capacity(
+// Matrices per JobSystem job in upload_arena's pack - 256 KiB of them,
+// enough to amortize the job's scheduling cost.
+constexpr auto matrices_per_copy_job = std::size_t{4096};
+
+// Clean retained instances re-uploaded to merge two dirty ranges rather
+// than issue a separate copy for each - 3 KiB of transforms.
+constexpr auto max_dirty_range_gap = uint32_t{64};
+
+constexpr auto max_dirty_range_count = std::size_t{1024};
+
+// Arenas grow to the next power of two instances, so a frame whose instance
+// count creeps up a little at a time doesn't recreate its buffers each time.
+auto get_arena_capacity_size(uint32_t instance_count) -> uint32_t {
+    return std::bit_ceil(std::max(instance_count, 1U)) *
+        static_cast<uint32_t>(sizeof(InstanceTransform));
+}
+
+// count transforms of staging memory, starting first_instance transforms
+// in.
+auto get_staged_transforms(
+    gsl::span<uint8_t> mapped, std::size_t first_instance, std::size_t count
+) -> gsl::span<InstanceTransform> {
+    return gsl::span{
+        reinterpret_cast<InstanceTransform*>(
+            mapped.data() + (first_instance * sizeof(InstanceTransform))
+        ),
+        count,
+    };
+}
+
+}  // namespace
+
+auto SDL_GPUInstanceBufferCache::upload(
     GPUDevice& device,
     CopyPass& copy_pass,
-    std::optional<Buffer>& identity_indices_buffer,
-    std::optional<TransferBuffer>& identity_indices_transfer_buffer,
-    uint32_t required_count
+    StagingRing& staging_ring,
+    RenderableId renderable_id,
+    gsl::span<const Maths::Matrix4x4f> model_matrices
+) -> const Buffer& {
+    auto frame_ranges = std::vector<InstanceRange>(renderable_id + 1);
+    frame_ranges[renderable_id] = InstanceRange{
+        .first_instance = 0,
+        .instance_count = static_cast<uint32_t>(model_matrices.size()),
+    };
+    upload_frame_instances(
+        device, copy_pass, staging_ring, model_matrices, frame_ranges
+    );
+
+    return frame_arena.buffer.value();
+}
+
+auto SDL_GPUInstanceBufferCache::upload_frame_instances(
+    GPUDevice& device,
+    CopyPass& copy_pass,
+    StagingRing& staging_ring,
+    gsl::span<const Maths::Matrix4x4f> model_matrices,
+    gsl::span<const InstanceRange> frame_ranges,
+    Utilities::JobSystem* job_system
 ) -> void {
-    const auto required_size = required_count * static_cast<uint32_t>(sizeof(uint32_t));
-    if (identity_indices_buffer.has_value() &&
-        identity_indices_buffer->get_size() >= required_size) {
+    if (model_matrices.empty()) {
         return;
     }
 
-    if (!identity_indices_transfer_buffer.has_value() ||
-        identity_indices_transfer_buffer->get_size() < required_size) {
-        identity_indices_transfer_buffer = device.create_transfer_buffer(TransferBufferInfo{
-            .usage = TransferBufferUsage::Upload,
-            .size = required_size,
-        });
+    const auto sources = std::array{ArenaSource{
+        .model_matrices = model_matrices,
+        .first_instance = 0,
+    }};
+    upload_arena(
+        device, copy_pass, staging_ring, frame_arena,
+        static_cast<uint32_t>(model_matrices.size()), sources, job_system
+    );
+
+    if (frame_ranges.size() > instance_locations.size()) {
+        instance_locations.resize(frame_ranges.size());
     }
-    identity_indices_buffer = device.create_buffer(BufferInfo{
-        .usage = BufferUsage::StorageRead,
-        .size = required_size,
-    });
+    for (auto renderable_id = RenderableId{0};
+         renderable_id < frame_ranges.size(); ++renderable_id) {
+        const auto& range = frame_ranges[renderable_id];
+        if (range.instance_count == 0) {
+            continue;
+        }
 
-    auto indices = std::vector<uint32_t>(required_count);
-    std::iota(indices.begin(), indices.end(), 0U);
+        instance_locations[renderable_id] = InstanceLocation{
+            .arena = InstanceArenaKind::Frame,
+            .first_instance = range.first_instance,
+        };
+    }
+
+    ensure_identity_indices_capacity(device, copy_pass, staging_ring);
+}
 
-    const auto mapped = identity_indices_transfer_buffer->map(true);
-    std::memcpy(mapped.data(), indices.data(), required_size);
-    identity_indices_transfer_buffer->unmap();
-    copy_pass.upload_to_buffer(
-        *identity_indices_transfer_buffer, 0, *identity_indices_buffer, 0,
-        required_size, true
+auto SDL_GPUInstanceBufferCache::upload_static_instances(
+    GPUDevice& device,
+    CopyPass& copy_pass,
+    StagingRing& staging_ring,
+    gsl::span<const InstanceUpload> uploads,
+    Utilities::JobSystem* job_system
+) -> void {
+    if (uploads.empty()) {
+        return;
+    }
+
+    auto sources = std::vector<ArenaSource>{};
+    sources.reserve(uploads.size());
+    auto first_instance = uint32_t{0};
+
+    for (const auto& upload : uploads) {
+        sources.push_back(ArenaSource{
+            .model_matrices = upload.model_matrices,
+            .first_instance = first_instance,
+        });
+
+        if (upload.renderable_id >= instance_locations.size()) {
+            instance_locations.resize(upload.renderable_id + 1);
+        }
+        instance_locations[upload.renderable_id] = InstanceLocation{
+            .arena = InstanceArenaKind::Static,
+            .first_instance = first_instance,
+        };
+        first_instance += static_cast<uint32_t>(upload.model_matrices.size());
+    }
+
+    upload_arena(
+        device, copy_pass, staging_ring, static_arena, first_instance, sources,
+        job_system
     );
+    ensure_identity_indices_capacity(device, copy_pass, staging_ring);
 }
 
-}  // namespace
+auto SDL_GPUInstanceBufferCache::upload_retained_instances(
+    GPUDevice& device,
+    CopyPass& copy_pass,
+    StagingRing& staging_ring,
+    const RetainedInstanceStore& retained_instances,
+    Utilities::JobSystem* job_system
+) -> void {
+    const auto dirty_renderables = retained_instances.get_dirty_renderables();
+    if (dirty_renderables.empty()) {
+        return;
+    }
 
-auto SDL_GPUInstanceBufferCache::upload(
+    // Only creates grow a renderable, and they always dirty it, so checking
+    // the dirty renderables is enough.
+    const auto needs_relayout = std::ranges::any_of(
+        dirty_renderables,
+        [&](RenderableId renderable_id) {
+            return renderable_id >= retained_slabs.size() ||
+                retained_instances.get_model_matrices(renderable_id).size() >
+                retained_slabs[renderable_id].capacity;
+        }
+    );
+
+    if (!needs_relayout) {
+        const auto ranges = collect_retained_dirty_ranges(retained_instances);
+        // Past this many separate copies (movers scattered all over a large
+        // renderable), one full re-upload is cheaper than recording them all.
+        if (ranges.size() <= max_dirty_range_count) {
+            upload_retained_dirty_ranges(
+                copy_pass, staging_ring, retained_instances, ranges
+            );
+            return;
+        }
+    }
+
+    relayout_retained_arena(
+        device, copy_pass, staging_ring, retained_instances, job_system
+    );
+}
+
+auto SDL_GPUInstanceBufferCache::relayout_retained_arena(
     GPUDevice& device,
     CopyPass& copy_pass,
+    StagingRing& staging_ring,
+    const RetainedInstanceStore& retained_instances,
+    Utilities::JobSystem* job_system
+) -> void {
+    const auto renderable_count = retained_instances.get_renderable_count();
+    retained_slabs.resize(renderable_count);
+    if (renderable_count > instance_locations.size()) {
+        instance_locations.resize(renderable_count);
+    }
+
+    auto sources = std::vector<ArenaSource>{};
+    auto first_instance = uint32_t{0};
+
+    for (auto renderable_id = RenderableId{0}; renderable_id < renderable_count;
+         ++renderable_id) {
+        const auto model_matrices =
+            retained_instances.get_model_matrices(renderable_id);
+        const auto instance_count =
+            static_cast<uint32_t>(model_matrices.size());
+        // Power-of-two headroom per renderable, so creating a few more
+        // instances next frame fits in place instead of relaying out again.
+        const auto capacity =
+            instance_count == 0 ? 0U : std::bit_ceil(instance_count);
+
+        retained_slabs[renderable_id] = RetainedSlab{
+            .first_instance = first_instance,
+            .capacity = capacity,
+        };
+        if (instance_count == 0) {
+            continue;
+        }
+
+        sources.push_back(ArenaSource{
+            .model_matrices = model_matrices,
+            .first_instance = first_instance,
+        });
+        instance_locations[renderable_id] = InstanceLocation{
+            .arena = InstanceArenaKind::Retained,
+            .first_instance = first_instance,
+        };
+        first_instance += capacity;
+    }
+
+    upload_arena(
+        device, copy_pass, staging_ring, retained_arena, first_instance,
+        sources, job_system
+    );
+    ensure_identity_indices_capacity(device, copy_pass, staging_ring);
+}
+
+auto SDL_GPUInstanceBufferCache::map_instances(
+    StagingRing& staging_ring,
     RenderableId renderable_id,
-    gsl::span<const Maths::Matrix4x4f> model_matrices
-) -> const Buffer& {
-    const auto required_size = static_cast<uint32_t>(
-        model_matrices.size() * sizeof(Maths::Matrix4x4f)
+    uint32_t instance_count
+) -> gsl::span<InstanceTransform> {
+    if (instance_count == 0) {
+        return {};
+    }
+
+    const auto allocation = staging_ring.allocate(
+        instance_count * static_cast<uint32_t>(sizeof(InstanceTransform))
     );
+    mapped_allocations.push_back(allocation);
 
-    if (renderable_id >= instance_transfer_buffers.size()) {
-        instance_transfer_buffers.resize(renderable_id + 1);
+    if (renderable_id >= instance_locations.size()) {
+        instance_locations.resize(renderable_id + 1);
     }
-    if (renderable_id >= instance_buffers.size()) {
-        instance_buffers.resize(renderable_id + 1);
+    // upload_mapped_instances() copies the allocations into the arena back
+    // to back, so these transforms land at the running total.
+    instance_locations[renderable_id] = InstanceLocation{
+        .arena = InstanceArenaKind::Mapped,
+        .first_instance = mapped_instance_count,
+    };
+    mapped_instance_count += instance_count;
+
+    return get_staged_transforms(allocation.memory, 0, instance_count);
+}
+
+auto SDL_GPUInstanceBufferCache::upload_mapped_instances(
+    GPUDevice& device, CopyPass& copy_pass, StagingRing& staging_ring
+) -> void {
+    mapped_arena.instance_count = mapped_instance_count;
+    if (mapped_instance_count == 0) {
+        return;
     }
 
-    auto& transfer_buffer = instance_transfer_buffers[renderable_id];
-    if (!transfer_buffer.has_value() ||
-        transfer_buffer->get_size() < required_size) {
-        transfer_buffer = device.create_transfer_buffer(TransferBufferInfo{
-            .usage = TransferBufferUsage::Upload,
-            .size = required_size,
+    const auto required_size = static_cast<uint32_t>(
+        mapped_instance_count * sizeof(InstanceTransform)
+    );
+    if (!mapped_arena.buffer.has_value() ||
+        mapped_arena.buffer->get_size() < required_size) {
+        mapped_arena.buffer = device.create_buffer(BufferInfo{
+            .usage = BufferUsage::StorageRead | BufferUsage::ComputeStorageRead,
+            .size = get_arena_capacity_size(mapped_instance_count),
         });
     }
 
-    auto& instance_buffer = instance_buffers[renderable_id];
-    if (!instance_buffer.has_value() ||
-        instance_buffer->get_size() < required_size) {
-        instance_buffer = device.create_buffer(BufferInfo{
+    // Back-to-back allocations are usually contiguous in the ring (a
+    // transform is a whole number of allocation alignments), so runs of
+    // them go up as one copy.
+    const auto is_contiguous = [](const StagingAllocation& first,
+                                  const StagingAllocation& second) {
+        return first.transfer_buffer_index == second.transfer_buffer_index &&
+            first.offset + first.memory.size() == second.offset;
+    };
+
+    auto offset = uint32_t{0};
+    for (auto run_begin = std::size_t{0};
+         run_begin < mapped_allocations.size();) {
+        const auto& first = mapped_allocations[run_begin];
+        auto size = static_cast<uint32_t>(first.memory.size());
+        auto run_end = run_begin + 1;
+        for (; run_end < mapped_allocations.size() &&
+             is_contiguous(
+                 mapped_allocations[run_end - 1], mapped_allocations[run_end]
+             );
+             ++run_end) {
+            size += static_cast<uint32_t>(
+                mapped_allocations[run_end].memory.size()
+            );
+        }
+
+        // Only the first copy cycles - the rest write other parts of the
+        // buffer it just cycled to.
+        staging_ring.upload(
+            copy_pass,
+            StagingAllocation{
+                .memory = gsl::span{first.memory.data(), size},
+                .offset = first.offset,
+                .transfer_buffer_index = first.transfer_buffer_index,
+            },
+            0, *mapped_arena.buffer, offset, size, offset == 0
+        );
+        offset += size;
+        run_begin = run_end;
+    }
+
+    mapped_allocations.clear();
+    mapped_instance_count = 0;
+
+    ensure_identity_indices_capacity(device, copy_pass, staging_ring);
+}
+
+auto SDL_GPUInstanceBufferCache::discard_mapped_instances() -> void {
+    mapped_allocations.clear();
+    mapped_instance_count = 0;
+}
+
+auto SDL_GPUInstanceBufferCache::collect_retained_dirty_ranges(
+    const RetainedInstanceStore& retained_instances
+) -> gsl::span<const DirtyRange> {
+    auto& ranges = dirty_range_scratch;
+    ranges.clear();
+    auto dirty_instance_count = uint32_t{0};
+
+    for (const auto renderable_id :
+         retained_instances.get_dirty_renderables()) {
+        const auto instance_count = static_cast<uint32_t>(
+            retained_instances.get_model_matrices(renderable_id).size()
+        );
+
+        auto& slots = dirty_slot_scratch;
+        slots.clear();
+        for (const auto slot :
+             retained_instances.get_dirty_slots(renderable_id)) {
+            if (slot < instance_count) {
+                slots.push_back(slot);
+            }
+        }
+        std::ranges::sort(slots);
+
+        // Coalesce nearby slots, re-uploading the few clean ones between
+        // them, so scattered updates don't become one copy per instance.
+        for (auto index = std::size_t{0}; index < slots.size();) {
+            const auto begin = slots[index];
+            auto end = begin + 1;
+            for (++index; index < slots.size() &&
+                 slots[index] <= end + max_dirty_range_gap;
+                 ++index) {
+                end = std::max(end, slots[index] + 1);
+            }
+
+            ranges.push_back(DirtyRange{
+                .renderable_id = renderable_id,
+                .begin = begin,
+                .end = end,
+                .staging_offset = dirty_instance_count,
+            });
+            dirty_instance_count += end - begin;
+        }
+    }
+
+    return ranges;
+}
+
+auto SDL_GPUInstanceBufferCache::upload_retained_dirty_ranges(
+    CopyPass& copy_pass,
+    StagingRing& staging_ring,
+    const RetainedInstanceStore& retained_instances,
+    gsl::span<const DirtyRange> ranges
+) -> void {
+    if (ranges.empty()) {
+        return;
+    }
+
+    // Ranges are staged back to back, so the last one ends at the total.
+    const auto staged_count = ranges.back().staging_offset +
+        (ranges.back().end - ranges.back().begin);
+    const auto staging = staging_ring.allocate(
+        staged_count * static_cast<uint32_t>(sizeof(InstanceTransform))
+    );
+    for (const auto& range : ranges) {
+        const auto count = range.end - range.begin;
+        to_instance_transforms(
+            retained_instances.get_model_matrices(range.renderable_id)
+                .subspan(range.begin, count),
+            get_staged_transforms(staging.memory, range.staging_offset, count)
+        );
+    }
+
+    // cycle = false: unlike a full arena upload, this must keep every
+    // instance it doesn't overwrite, so it writes the current buffer in
+    // place (ordered after earlier frames' reads on the GPU timeline).
+    for (const auto& range : ranges) {
+        const auto first_instance =
+            retained_slabs[range.renderable_id].first_instance;
+        staging_ring.upload(
+            copy_pass, staging,
+            range.staging_offset *
+                static_cast<uint32_t>(sizeof(InstanceTransform)),
+            retained_arena.buffer.value(),
+            (first_instance + range.begin) *
+                static_cast<uint32_t>(sizeof(InstanceTransform)),
+            (range.end - range.begin) *
+                static_cast<uint32_t>(sizeof(InstanceTransform)),
+            false
+        );
+    }
+}
+
+auto SDL_GPUInstanceBufferCache::upload_arena(
+    GPUDevice& device,
+    CopyPass& copy_pass,
+    StagingRing& staging_ring,
+    InstanceArena& arena,
+    uint32_t instance_count,
+    gsl::span<const ArenaSource> sources,
+    Utilities::JobSystem* job_system
+) -> void {
+    arena.instance_count = instance_count;
+    if (instance_count == 0) {
+        return;
+    }
+
+    const auto required_size = static_cast<uint32_t>(
+        instance_count * sizeof(InstanceTransform)
+    );
+
+    if (!arena.buffer.has_value() || arena.buffer->get_size() < required_size) {
+        arena.buffer = device.create_buffer(BufferInfo{
             .usage = BufferUsage::StorageRead | BufferUsage::ComputeStorageRead,
-            .size = required_size,
+            .size = get_arena_capacity_size(arena.instance_count),
         });
     }
 
-    const auto mapped = transfer_buffer->map(true);
-    std::memcpy(mapped.data(), model_matrices.data(), required_size);
-    transfer_buffer->unmap();
+    const auto staging = staging_ring.allocate(required_size);
+    const auto copy_matrices = [&](std::size_t source_index,
+                                   std::size_t begin,
+                                   std::size_t end) {
+        const auto& source = sources[source_index];
+        to_instance_transforms(
+            source.model_matrices.subspan(begin, end - begin),
+            get_staged_transforms(
+                staging.memory, source.first_instance + begin, end - begin
+            )
+        );
+    };
 
-    copy_pass.upload_to_buffer(
-        *transfer_buffer, 0, *instance_buffer, 0, required_size, true
-    );
+    if (job_system == nullptr) {
+        for (auto source_index = std::size_t{0}; source_index < sources.size();
+             ++source_index) {
+            copy_matrices(
+                source_index, 0, sources[source_index].model_matrices.size()
+            );
+        }
+    } else {
+        // Split by matrix range over every source's matrices back to back
+        // rather than by source, so the frame arena's single source (or one
+        // renderable with 100k static instances) is spread across threads
+        // too. Each range copies its overlap with every source it spans.
+        auto total_count = std::size_t{0};
+        for (const auto& source : sources) {
+            total_count += source.model_matrices.size();
+        }
+
+        job_system->parallel_for(
+            total_count, matrices_per_copy_job,
+            [&copy_matrices, &sources](std::size_t begin, std::size_t end) {
+                auto source_begin = std::size_t{0};
+                for (auto source_index = std::size_t{0};
+                     source_index < sources.size() && source_begin < end;
+                     ++source_index) {
+                    const auto source_end = source_begin +
+                        sources[source_index].model_matrices.size();
+                    if (source_end > begin) {
+                        copy_matrices(
+                            source_index,
+                            std::max(begin, source_begin) - source_begin,
+                            std::min(end, source_end) - source_begin
+                        );
+                    }
+                    source_begin = source_end;
+                }
+            }
+        );
+    }
+
+    staging_ring.upload(copy_pass, staging, *arena.buffer);
+}
 
-    ensure_identity_indices_capacity(
-        device, copy_pass, identity_indices_buffer,
-        identity_indices_transfer_buffer,
-        static_cast<uint32_t>(model_matrices.size())
+auto SDL_GPUInstanceBufferCache::ensure_identity_indices_capacity(
+    GPUDevice& device, CopyPass& copy_pass, StagingRing& staging_ring
+) -> void {
+    const auto required_count = std::max(
+        {frame_arena.instance_count, static_arena.instance_count,
+         retained_arena.instance_count, mapped_arena.instance_count}
     );
+    const auto required_size =
+        required_count * static_cast<uint32_t>(sizeof(uint32_t));
+    if (identity_indices_buffer.has_value() &&
+        identity_indices_buffer->get_size() >= required_size) {
+        return;
+    }
+
+    // Same power-of-two growth as the arenas it indexes into.
+    const auto capacity_count = std::bit_ceil(std::max(required_count, 1U));
+    const auto capacity_size =
+        capacity_count * static_cast<uint32_t>(sizeof(uint32_t));
 
-    return *instance_buffer;
+    identity_indices_buffer = device.create_buffer(BufferInfo{
+        .usage = BufferUsage::StorageRead,
+        .size = capacity_size,
+    });
+
+    const auto staging = staging_ring.allocate(capacity_size);
+    const auto indices = gsl::span{
+        reinterpret_cast<uint32_t*>(staging.memory.data()), capacity_count
+    };
+    std::iota(indices.begin(), indices.end(), 0U);
+    staging_ring.upload(copy_pass, staging, *identity_indices_buffer);
 }
 
 auto SDL_GPUInstanceBufferCache::get(RenderableId renderable_id) const
     -> const Buffer& {
-    return gsl::at(instance_buffers, renderable_id).value();
+    switch (gsl::at(instance_locations, renderable_id).arena) {
+        case InstanceArenaKind::Static:
+            return static_arena.buffer.value();
+        case InstanceArenaKind::Retained:
+            return retained_arena.buffer.value();
+        case InstanceArenaKind::Mapped:
+            return mapped_arena.buffer.value();
+        case InstanceArenaKind::Frame:
+            break;
+    }
+    return frame_arena.buffer.value();
+}
+
+auto SDL_GPUInstanceBufferCache::get_first_instance(
+    RenderableId renderable_id
+) const -> uint32_t {
+    return gsl::at(instance_locations, renderable_id).first_instance;
 }
 
 auto SDL_GPUInstanceBufferCache::get_identity_indices_buffer() const
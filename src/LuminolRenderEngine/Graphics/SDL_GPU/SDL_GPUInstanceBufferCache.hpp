@@ -1,53 +1,237 @@
 #pragma once
 
+#include <cstdint>
 #include <optional>
 #include <vector>
 
 #include <gsl/gsl>
 #include <LuminolMaths/Matrix.hpp>
 
+#include <LuminolRenderEngine/Graphics/InstanceTransform.hpp>
 #include <LuminolRenderEngine/Graphics/RenderableManager.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUBuffer.hpp>
-#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUTransferBuffer.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUInstanceBatch.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPURetainedInstanceStore.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUStagingRing.hpp>
+#include <LuminolRenderEngine/Utilities/JobSystem.hpp>
 
 namespace Luminol::Graphics::SDL_GPU {
 
 class GPUDevice;
 class CopyPass;
 
-// Owns a persistent, per-renderable GPU storage buffer (plus its staging
-// transfer buffer) used to upload per-instance model matrices. Buffers are
-// grown in place as larger batches are seen, never recreated on every frame.
+struct InstanceUpload {
+    RenderableId renderable_id;
+    gsl::span<const Maths::Matrix4x4f> model_matrices;
+};
+
+// Owns the GPU storage buffers per-instance transforms are uploaded into,
+// staged through the renderer's StagingRing. Model matrices are packed into
+// InstanceTransforms (48 bytes instead of 64) as they're written to
+// staging, so the pack is the upload's one CPU copy. Rather than one buffer per
+// renderable, instances live in four arenas: a frame arena holding every
+// dynamic (queue_draw/queue_draw_instanced) instance of the frame, uploaded
+// as one staging allocation and one copy; a static arena holding every
+// queue_draw_instanced_static instance, rebuilt only when that set changes;
+// a retained arena holding every create_instance instance, where only
+// dirty instances are re-uploaded; and a mapped arena holding every
+// map_instances instance, written by the caller straight into staging.
+// A renderable's instances are a contiguous range of one of them - passes
+// bind get(id) and offset by get_first_instance(id). Arenas are grown in
+// place (to the next power of two), never recreated every frame.
 class SDL_GPUInstanceBufferCache {
 public:
+    // Uploads a single renderable's model_matrices as the whole frame
+    // arena, at first instance 0. For tools and tests driving one renderable
+    // without a QueuedDraws - the renderer uses upload_frame_instances().
     auto upload(
         GPUDevice& device,
         CopyPass& copy_pass,
+        StagingRing& staging_ring,
         RenderableId renderable_id,
         gsl::span<const Maths::Matrix4x4f> model_matrices
     ) -> const Buffer&;
 
+    // Uploads the frame arena: model_matrices is every dynamic instance this
+    // frame, already grouped per renderable as frame_ranges (indexed by
+    // RenderableId) describes - see group_frame_instances(). Buffers are
+    // created, staged and copied on the calling thread, since SDL_GPU device
+    // calls aren't thread-safe; only packing the matrices into staging - the
+    // part that scales with instance count - is split across job_system's
+    // threads, when given.
+    auto upload_frame_instances(
+        GPUDevice& device,
+        CopyPass& copy_pass,
+        StagingRing& staging_ring,
+        gsl::span<const Maths::Matrix4x4f> model_matrices,
+        gsl::span<const InstanceRange> frame_ranges,
+        Utilities::JobSystem* job_system = nullptr
+    ) -> void;
+
+    // Rebuilds the static arena from uploads (each renderable id at most
+    // once), laid out back to back in order.
+    auto upload_static_instances(
+        GPUDevice& device,
+        CopyPass& copy_pass,
+        StagingRing& staging_ring,
+        gsl::span<const InstanceUpload> uploads,
+        Utilities::JobSystem* job_system = nullptr
+    ) -> void;
+
+    // Brings the retained arena up to date with retained_instances' dirty
+    // slots. Usually that's one small copy per run of nearby dirty slots into
+    // the persistent buffer; only when a renderable outgrows its slab, a new
+    // renderable appears, or the dirty slots are too scattered to copy
+    // individually is the whole arena laid out and uploaded again.
+    // The caller clears retained_instances' dirty state afterward.
+    auto upload_retained_instances(
+        GPUDevice& device,
+        CopyPass& copy_pass,
+        StagingRing& staging_ring,
+        const RetainedInstanceStore& retained_instances,
+        Utilities::JobSystem* job_system = nullptr
+    ) -> void;
+
+    // Hands out instance_count transforms of this frame's staging_ring
+    // memory for renderable_id to write directly - no CPU-side copy is
+    // kept, and upload_mapped_instances() copies them to the GPU as is. The
+    // span must be written before the frame records its first upload (see
+    // StagingRing) and is gone after upload_mapped_instances() or
+    // discard_mapped_instances(); a renderable may be mapped at most once
+    // per frame.
+    [[nodiscard]] auto map_instances(
+        StagingRing& staging_ring,
+        RenderableId renderable_id,
+        uint32_t instance_count
+    ) -> gsl::span<InstanceTransform>;
+
+    // Copies every instance handed out by map_instances() into the mapped
+    // arena - one copy per contiguous run of staging, usually just one.
+    auto upload_mapped_instances(
+        GPUDevice& device, CopyPass& copy_pass, StagingRing& staging_ring
+    ) -> void;
+
+    // Forgets this frame's map_instances() allocations without uploading
+    // them, for a frame that's skipped - the ring reclaims them with the
+    // frame. No-op after upload_mapped_instances().
+    auto discard_mapped_instances() -> void;
+
+    // The arena buffer renderable_id's instances were last uploaded into.
     [[nodiscard]] auto get(RenderableId renderable_id) const -> const Buffer&;
 
-    // Shared identity mapping buffer (element i == i), grown lazily in
-    // upload() to cover the largest instance count seen so far. pbr_vert.hlsl
-    // always indexes instance_models through a visible_instance_indices
-    // indirection (see SDL_GPUInstanceCullPass, which populates a *culled*
-    // mapping); passes that draw every instance uncompacted (the shadow
-    // passes) bind this identity buffer instead, making that indirection a
-    // no-op.
+    // Index of renderable_id's first instance within get(renderable_id).
+    [[nodiscard]] auto get_first_instance(RenderableId renderable_id) const
+        -> uint32_t;
+
+    // Shared identity mapping buffer (element i == i), grown lazily to
+    // cover the larger arena. pbr_vert.hlsl always indexes instance_models
+    // through a visible_instance_indices indirection (see
+    // SDL_GPUInstanceCullPass, which populates a *culled* mapping); passes
+    // that draw every instance uncompacted (the shadow passes) bind this
+    // identity buffer instead, making that indirection a no-op - their
+    // draws' first_instance then selects the renderable's arena range.
     [[nodiscard]] auto get_identity_indices_buffer() const -> const Buffer&;
 
 private:
-    // Indexed directly by RenderableId, so upload()/get() are a direct index
-    // instead of a hash probe. Grows to cover the largest id seen; a reused
-    // (recycled) id already has a valid slot. nullopt until the first
-    // upload() call for that id.
-    std::vector<std::optional<Buffer>> instance_buffers;
-    std::vector<std::optional<TransferBuffer>> instance_transfer_buffers;
+    struct InstanceArena {
+        std::optional<Buffer> buffer;
+        uint32_t instance_count = 0;
+    };
+
+    enum class InstanceArenaKind : uint8_t {
+        Frame,
+        Static,
+        Retained,
+        Mapped,
+    };
+
+    struct InstanceLocation {
+        InstanceArenaKind arena = InstanceArenaKind::Frame;
+        uint32_t first_instance = 0;
+    };
+
+    struct ArenaSource {
+        gsl::span<const Maths::Matrix4x4f> model_matrices;
+        uint32_t first_instance;
+    };
+
+    // A renderable's reserved block of the retained arena - it may grow up
+    // to capacity instances in place.
+    struct RetainedSlab {
+        uint32_t first_instance = 0;
+        uint32_t capacity = 0;
+    };
+
+    // Retained slots [begin, end) of renderable_id, staged at
+    // staging_offset instances into the frame's staging allocation.
+    struct DirtyRange {
+        RenderableId renderable_id;
+        uint32_t begin;
+        uint32_t end;
+        uint32_t staging_offset;
+    };
+
+    // Packs each source into one staging allocation at its first_instance
+    // and records one copy of the whole instance_count into arena's storage
+    // buffer.
+    static auto upload_arena(
+        GPUDevice& device,
+        CopyPass& copy_pass,
+        StagingRing& staging_ring,
+        InstanceArena& arena,
+        uint32_t instance_count,
+        gsl::span<const ArenaSource> sources,
+        Utilities::JobSystem* job_system
+    ) -> void;
+
+    auto relayout_retained_arena(
+        GPUDevice& device,
+        CopyPass& copy_pass,
+        StagingRing& staging_ring,
+        const RetainedInstanceStore& retained_instances,
+        Utilities::JobSystem* job_system
+    ) -> void;
+
+    // Sorted, coalesced dirty slots of every dirty renderable, staged back
+    // to back. The span is into dirty_range_scratch, valid until the next
+    // call.
+    auto collect_retained_dirty_ranges(
+        const RetainedInstanceStore& retained_instances
+    ) -> gsl::span<const DirtyRange>;
+
+    auto upload_retained_dirty_ranges(
+        CopyPass& copy_pass,
+        StagingRing& staging_ring,
+        const RetainedInstanceStore& retained_instances,
+        gsl::span<const DirtyRange> ranges
+    ) -> void;
+
+    auto ensure_identity_indices_capacity(
+        GPUDevice& device, CopyPass& copy_pass, StagingRing& staging_ring
+    ) -> void;
+
+    InstanceArena frame_arena;
+    InstanceArena static_arena;
+    InstanceArena retained_arena;
+    InstanceArena mapped_arena;
+
+    // map_instances() staging this frame, in mapped arena order.
+    std::vector<StagingAllocation> mapped_allocations;
+    // Instances map_instances() handed out this frame, across every
+    // allocation.
+    uint32_t mapped_instance_count = 0;
+
+    // Indexed directly by RenderableId.
+    std::vector<RetainedSlab> retained_slabs;
+    std::vector<uint32_t> dirty_slot_scratch;
+    std::vector<DirtyRange> dirty_range_scratch;
+
+    // Indexed directly by RenderableId, so get()/get_first_instance() are a
+    // direct index instead of a hash probe. Grows to cover the largest id
+    // uploaded.
+    std::vector<InstanceLocation> instance_locations;
 
     std::optional<Buffer> identity_indices_buffer;
-    std::optional<TransferBuffer> identity_indices_transfer_buffer;
 };
 
 }  // namespace Luminol::Graphics::SDL_GPU
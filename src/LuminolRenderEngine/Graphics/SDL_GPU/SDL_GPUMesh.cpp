@@ -3,83 +3,124 @@
 #include <algorithm>
 #include <array>
 #include <cstring>
+#include <functional>
 #include <limits>
+#include <numeric>
 #include <optional>
 #include <stdexcept>
+#include <unordered_map>
 
 #include <gsl/gsl>
 #include <meshoptimizer.h>
+#include <SDL3/SDL_log.h>
 
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUCommandBuffer.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/RenderPasses/SDL_GPUCopyPass.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUDevice.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUMeshCache.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/RenderPasses/SDL_GPURenderPass.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUTransferBuffer.hpp>
 #include <LuminolRenderEngine/Utilities/ImageLoader.hpp>
 #include <LuminolRenderEngine/Utilities/ModelLoader.hpp>
+#include <LuminolRenderEngine/Utilities/ParallelFor.hpp>
 
 namespace {
 
 using namespace Luminol::Graphics::SDL_GPU;
 
-auto load_first_texture_or_nothing(
-    const std::vector<std::filesystem::path>& texture_paths,
+auto load_texture_or_nothing(
+    const std::optional<std::filesystem::path>& texture_path,
     const std::unordered_map<
         std::filesystem::path,
         Luminol::Utilities::ImageLoader::Image>& textures_map
 ) -> std::optional<Luminol::Utilities::ImageLoader::Image> {
-    if (texture_paths.empty()) {
+    if (!texture_path.has_value()) {
+        return std::nullopt;
+    }
+
+    return textures_map.at(texture_path.value());
+}
+
+auto first_path_or_nothing(const std::vector<std::filesystem::path>& paths)
+    -> std::optional<std::filesystem::path> {
+    if (paths.empty()) {
         return std::nullopt;
     }
 
-    return textures_map.at(texture_paths[0]);
+    return paths[0];
 }
 
-// True when both paths lists are non-empty and their first entry is the same
-// file - i.e. this material slot shares a source image with another slot
-// (e.g. glTF's packed occlusion/roughness/metallic convention).
-auto shares_first_path(
-    const std::vector<std::filesystem::path>& lhs_paths,
-    const std::vector<std::filesystem::path>& rhs_paths
+// True when both slots have a path and it's the same file - i.e. this
+// material slot shares a source image with another slot (e.g. glTF's packed
+// occlusion/roughness/metallic convention).
+auto shares_path(
+    const std::optional<std::filesystem::path>& lhs_path,
+    const std::optional<std::filesystem::path>& rhs_path
 ) -> bool {
-    return !lhs_paths.empty() && !rhs_paths.empty() && lhs_paths[0] == rhs_paths[0];
+    return lhs_path.has_value() && lhs_path == rhs_path;
+}
+
+// Only the first path of each material slot is ever consumed, so that's all
+// a BakedMaterial (and therefore the mesh cache) keeps.
+auto to_baked_material(
+    const Luminol::Utilities::ModelLoader::MeshData& mesh_data
+) -> BakedMaterial {
+    return BakedMaterial{
+        .diffuse_texture_path =
+            first_path_or_nothing(mesh_data.diffuse_texture_paths),
+        .diffuse_texture_wrap = mesh_data.diffuse_texture_wrap,
+        .normal_texture_path =
+            first_path_or_nothing(mesh_data.normal_texture_paths),
+        .normal_texture_wrap = mesh_data.normal_texture_wrap,
+        .metallic_texture_path =
+            first_path_or_nothing(mesh_data.metallic_texture_paths),
+        .metallic_texture_wrap = mesh_data.metallic_texture_wrap,
+        .roughness_texture_path =
+            first_path_or_nothing(mesh_data.roughness_texture_paths),
+        .roughness_texture_wrap = mesh_data.roughness_texture_wrap,
+        .ambient_occlusion_texture_path =
+            first_path_or_nothing(mesh_data.ambient_occlusion_texture_paths),
+        .ambient_occlusion_texture_wrap =
+            mesh_data.ambient_occlusion_texture_wrap,
+        .alpha_mode = mesh_data.alpha_mode,
+    };
 }
 
 auto to_texture_images(
-    const Luminol::Utilities::ModelLoader::MeshData& mesh_data,
+    const BakedMaterial& material,
     const std::unordered_map<
         std::filesystem::path,
         Luminol::Utilities::ImageLoader::Image>& textures_map
 ) -> TextureImages {
     return TextureImages{
-        .diffuse_texture = load_first_texture_or_nothing(
-            mesh_data.diffuse_texture_paths, textures_map
+        .diffuse_texture = load_texture_or_nothing(
+            material.diffuse_texture_path, textures_map
         ),
-        .diffuse_texture_wrap = mesh_data.diffuse_texture_wrap,
-        .normal_texture = load_first_texture_or_nothing(
-            mesh_data.normal_texture_paths, textures_map
+        .diffuse_texture_wrap = material.diffuse_texture_wrap,
+        .normal_texture = load_texture_or_nothing(
+            material.normal_texture_path, textures_map
         ),
-        .normal_texture_wrap = mesh_data.normal_texture_wrap,
-        .metallic_texture = load_first_texture_or_nothing(
-            mesh_data.metallic_texture_paths, textures_map
+        .normal_texture_wrap = material.normal_texture_wrap,
+        .metallic_texture = load_texture_or_nothing(
+            material.metallic_texture_path, textures_map
         ),
-        .metallic_texture_wrap = mesh_data.metallic_texture_wrap,
-        .roughness_texture = load_first_texture_or_nothing(
-            mesh_data.roughness_texture_paths, textures_map
+        .metallic_texture_wrap = material.metallic_texture_wrap,
+        .roughness_texture = load_texture_or_nothing(
+            material.roughness_texture_path, textures_map
         ),
-        .roughness_texture_wrap = mesh_data.roughness_texture_wrap,
-        .ambient_occlusion_texture = load_first_texture_or_nothing(
-            mesh_data.ambient_occlusion_texture_paths, textures_map
+        .roughness_texture_wrap = material.roughness_texture_wrap,
+        .ambient_occlusion_texture = load_texture_or_nothing(
+            material.ambient_occlusion_texture_path, textures_map
         ),
         .ambient_occlusion_texture_wrap =
-            mesh_data.ambient_occlusion_texture_wrap,
-        .alpha_mode = mesh_data.alpha_mode,
-        .roughness_shares_metallic_source = shares_first_path(
-            mesh_data.roughness_texture_paths, mesh_data.metallic_texture_paths
+            material.ambient_occlusion_texture_wrap,
+        .alpha_mode = material.alpha_mode,
+        .roughness_shares_metallic_source = shares_path(
+            material.roughness_texture_path, material.metallic_texture_path
         ),
-        .ambient_occlusion_shares_metallic_source = shares_first_path(
-            mesh_data.ambient_occlusion_texture_paths,
-            mesh_data.metallic_texture_paths
+        .ambient_occlusion_shares_metallic_source = shares_path(
+            material.ambient_occlusion_texture_path,
+            material.metallic_texture_path
         ),
     };
 }
@@ -135,113 +176,43 @@ auto create_uploaded_buffer(
     return device_buffer;
 }
 
-auto create_uploaded_texture(
-    GPUDevice& device,
-    CopyPass& copy_pass,
-    uint32_t width,
-    uint32_t height,
-    const uint8_t* rgba_pixels,
-    TextureFormat format = TextureFormat::R8G8B8A8_Unorm,
-    bool generate_mipmaps = false
-) -> Texture {
-    const auto size_bytes = width * height * 4U;
-
-    auto texture = device.create_texture(TextureInfo{
-        .width = width,
-        .height = height,
-        .format = format,
-        .generate_mipmaps = generate_mipmaps,
-    });
-
-    auto transfer_buffer = device.create_transfer_buffer(TransferBufferInfo{
-        .usage = TransferBufferUsage::Upload,
-        .size = size_bytes,
-    });
-
-    const auto mapped = transfer_buffer.map(false);
-    std::memcpy(mapped.data(), rgba_pixels, size_bytes);
-    transfer_buffer.unmap();
-
-    copy_pass.upload_to_texture(
-        transfer_buffer, 0, texture, width, height, false
-    );
-
-    return texture;
-}
-
 constexpr auto desired_rgba_channels = int32_t{4};
 
-auto create_white_pixel_texture(GPUDevice& device, CopyPass& copy_pass)
-    -> Texture {
-    constexpr auto white_pixel =
-        std::array<uint8_t, 4>{0xFF, 0xFF, 0xFF, 0xFF};
-    return create_uploaded_texture(device, copy_pass, 1, 1, white_pixel.data());
-}
-
-auto create_flat_normal_texture(GPUDevice& device, CopyPass& copy_pass)
-    -> Texture {
-    constexpr auto flat_normal_pixel =
-        std::array<uint8_t, 4>{0x80, 0x80, 0xFF, 0xFF};
-    return create_uploaded_texture(
-        device, copy_pass, 1, 1, flat_normal_pixel.data()
-    );
-}
+// Shared fallbacks (see SDL_GPUTextureCache::get_white_texture) stand in
+// for material slots the model doesn't provide a texture for.
+using FallbackTexture = Texture (SDL_GPUTextureCache::*)(GPUDevice&, CopyPass&);
 
-auto create_texture_from_path(
+auto get_cached_texture(
     GPUDevice& device,
     CopyPass& copy_pass,
+    SDL_GPUTextureCache& texture_cache,
     const std::optional<std::filesystem::path>& texture_path,
-    Texture (*default_texture)(GPUDevice&, CopyPass&),
-    TextureFormat format = TextureFormat::R8G8B8A8_Unorm,
-    bool generate_mipmaps = false
+    FallbackTexture fallback_texture,
+    TextureFormat format = TextureFormat::R8G8B8A8_Unorm
 ) -> Texture {
     if (!texture_path.has_value()) {
-        return default_texture(device, copy_pass);
+        return (texture_cache.*fallback_texture)(device, copy_pass);
     }
 
-    const auto image = Luminol::Utilities::ImageLoader::load_image(
-        texture_path.value(), desired_rgba_channels
-    );
-
-    const auto width = static_cast<uint32_t>(image.width);
-    const auto height = static_cast<uint32_t>(image.height);
-
-    return create_uploaded_texture(
-        device,
-        copy_pass,
-        width,
-        height,
-        image.data.data(),
-        format,
-        generate_mipmaps
+    return texture_cache.get_or_load(
+        device, copy_pass, texture_path.value(), format
     );
 }
 
-auto create_texture_from_image(
+auto get_cached_texture(
     GPUDevice& device,
     CopyPass& copy_pass,
+    SDL_GPUTextureCache& texture_cache,
     const std::optional<Luminol::Utilities::ImageLoader::Image>& texture_image,
-    Texture (*default_texture)(GPUDevice&, CopyPass&),
-    TextureFormat format = TextureFormat::R8G8B8A8_Unorm,
-    bool generate_mipmaps = false
+    FallbackTexture fallback_texture,
+    TextureFormat format = TextureFormat::R8G8B8A8_Unorm
 ) -> Texture {
     if (!texture_image.has_value()) {
-        return default_texture(device, copy_pass);
+        return (texture_cache.*fallback_texture)(device, copy_pass);
     }
 
-    const auto& image = texture_image.value();
-
-    const auto width = static_cast<uint32_t>(image.width);
-    const auto height = static_cast<uint32_t>(image.height);
-
-    return create_uploaded_texture(
-        device,
-        copy_pass,
-        width,
-        height,
-        image.data.data(),
-        format,
-        generate_mipmaps
+    return texture_cache.get_or_upload(
+        device, copy_pass, texture_image.value(), format
     );
 }
 
@@ -251,6 +222,8 @@ auto create_texture_from_image(
 // SDL_GPUInstanceCullPass.cpp / SDL_GPUMeshletCullPass), which is also why
 // it's the conventional choice for GPU-driven meshlet renderers.
 constexpr auto meshlet_max_vertices = std::size_t{64};
+// pack_meshlet_triangle stores each local vertex slot in one byte.
+static_assert(meshlet_max_vertices <= 256);
 constexpr auto meshlet_max_triangles = std::size_t{64};
 // 0 = no cone-based backface culling in this first cut (see
 // meshlet_cull.hlsl's bounding-sphere-only test) - cone data is still
@@ -259,6 +232,34 @@ constexpr auto meshlet_max_triangles = std::size_t{64};
 // meshopt_computeMeshletBounds always returns them; simply unused for now.
 constexpr auto meshlet_cone_weight = 0.0F;
 
+// meshopt_optimizeOverdraw may worsen vertex cache efficiency by at most
+// this factor in exchange for less overdraw.
+constexpr auto overdraw_threshold = 1.05F;
+
+// Target index-count ratios (relative to LOD0) for LOD1.. onward, and the
+// meshopt_simplify target error tolerated to reach them. Global defaults
+// for now - not configurable per model.
+constexpr auto lod_index_ratios =
+    std::array<float, max_lod_levels - 1>{0.5F, 0.25F, 0.1F};
+constexpr auto lod_target_error = 0.02F;
+constexpr auto min_lod_index_count = std::size_t{96};
+
+// Every meshlet triangle used to take three widened uint32 indices; it's now
+// one pack_meshlet_triangle word, so each word saves two.
+auto log_meshlet_triangle_packing(
+    const std::filesystem::path& model_path, const BakedMeshView& baked_mesh
+) -> void {
+    const auto packed_bytes = baked_mesh.meshlet_triangles.size_bytes();
+    SDL_Log(
+        "[MeshLoad] %s: %zu meshlet triangles packed into %zu KiB "
+        "(%zu KiB saved)",
+        model_path.string().c_str(),
+        baked_mesh.meshlet_triangles.size(),
+        packed_bytes / 1024U,
+        (packed_bytes * 2U) / 1024U
+    );
+}
+
 }  // namespace
 
 namespace Luminol::Graphics::SDL_GPU {
@@ -376,10 +377,12 @@ auto build_meshlets(
             );
         }
 
-        const auto triangle_index_count = meshlet.triangle_count * 3U;
-        for (auto i = uint32_t{0}; i < triangle_index_count; ++i) {
-            combined_meshlet_triangles.push_back(static_cast<uint32_t>(
-                raw_meshlet_triangles[meshlet.triangle_offset + i]
+        for (auto triangle = uint32_t{0}; triangle < meshlet.triangle_count;
+             ++triangle) {
+            const auto* local_indices =
+                &raw_meshlet_triangles[meshlet.triangle_offset + triangle * 3U];
+            combined_meshlet_triangles.push_back(pack_meshlet_triangle(
+                local_indices[0], local_indices[1], local_indices[2]
             ));
         }
     }
@@ -390,6 +393,14 @@ auto build_meshlets(
     };
 }
 
+auto pack_meshlet_triangle(
+    uint8_t local_vertex0, uint8_t local_vertex1, uint8_t local_vertex2
+) -> uint32_t {
+    return static_cast<uint32_t>(local_vertex0) |
+           (static_cast<uint32_t>(local_vertex1) << 8U) |
+           (static_cast<uint32_t>(local_vertex2) << 16U);
+}
+
 auto compute_mesh_local_bounds(gsl::span<const float> vertices) -> BoundingBox {
     const auto vertex_count = vertices.size() / vertex_stride_in_floats;
     if (vertex_count == 0) {
@@ -426,6 +437,7 @@ auto compute_mesh_local_bounds(gsl::span<const float> vertices) -> BoundingBox {
 SDL_GPUMesh::SDL_GPUMesh(
     GPUDevice& device,
     CopyPass& copy_pass,
+    SDL_GPUTextureCache& texture_cache,
     const std::array<LodRange, max_lod_levels>& lod_ranges,
     const std::array<MeshletRange, max_lod_levels>& meshlet_ranges,
     int32_t vertex_offset,
@@ -436,61 +448,45 @@ SDL_GPUMesh::SDL_GPUMesh(
       meshlet_ranges{meshlet_ranges},
       vertex_offset{vertex_offset},
       local_bounds{local_bounds},
-      diffuse_texture{create_texture_from_path(
+      diffuse_texture{get_cached_texture(
           device,
           copy_pass,
+          texture_cache,
           texture_paths.diffuse_texture_path,
-          create_white_pixel_texture,
-          TextureFormat::R8G8B8A8_Unorm_Srgb,
-          true
+          &SDL_GPUTextureCache::get_white_texture,
+          TextureFormat::R8G8B8A8_Unorm_Srgb
       )},
-      normal_texture{create_texture_from_path(
+      normal_texture{get_cached_texture(
           device,
           copy_pass,
+          texture_cache,
           texture_paths.normal_texture_path,
-          create_flat_normal_texture,
-          TextureFormat::R8G8B8A8_Unorm,
-          true
+          &SDL_GPUTextureCache::get_flat_normal_texture
       )},
-      metallic_texture{create_texture_from_path(
+      metallic_texture{get_cached_texture(
           device,
           copy_pass,
+          texture_cache,
           texture_paths.metallic_texture_path,
-          create_white_pixel_texture,
-          TextureFormat::R8G8B8A8_Unorm,
-          true
+          &SDL_GPUTextureCache::get_white_texture
       )},
       // Packed ORM (occlusion/roughness/metallic) textures share one source
-      // file across these three material slots - reuse the already-uploaded
-      // metallic_texture instead of uploading the same pixel data again.
-      roughness_texture{
-          texture_paths.metallic_texture_path.has_value() &&
-                  texture_paths.roughness_texture_path ==
-                      texture_paths.metallic_texture_path
-              ? metallic_texture
-              : create_texture_from_path(
-                    device,
-                    copy_pass,
-                    texture_paths.roughness_texture_path,
-                    create_white_pixel_texture,
-                    TextureFormat::R8G8B8A8_Unorm,
-                    true
-                )
-      },
-      ambient_occlusion_texture{
-          texture_paths.metallic_texture_path.has_value() &&
-                  texture_paths.ambient_occlusion_texture_path ==
-                      texture_paths.metallic_texture_path
-              ? metallic_texture
-              : create_texture_from_path(
-                    device,
-                    copy_pass,
-                    texture_paths.ambient_occlusion_texture_path,
-                    create_white_pixel_texture,
-                    TextureFormat::R8G8B8A8_Unorm,
-                    true
-                )
-      },
+      // file across these three material slots - texture_cache keys on the
+      // path, so they resolve to metallic_texture's GPU texture anyway.
+      roughness_texture{get_cached_texture(
+          device,
+          copy_pass,
+          texture_cache,
+          texture_paths.roughness_texture_path,
+          &SDL_GPUTextureCache::get_white_texture
+      )},
+      ambient_occlusion_texture{get_cached_texture(
+          device,
+          copy_pass,
+          texture_cache,
+          texture_paths.ambient_occlusion_texture_path,
+          &SDL_GPUTextureCache::get_white_texture
+      )},
       diffuse_sampler{device.create_sampler(SamplerInfo{
           .address_mode_u = SamplerAddressMode::Repeat,
           .address_mode_v = SamplerAddressMode::Repeat,
@@ -525,6 +521,7 @@ SDL_GPUMesh::SDL_GPUMesh(
 SDL_GPUMesh::SDL_GPUMesh(
     GPUDevice& device,
     CopyPass& copy_pass,
+    SDL_GPUTextureCache& texture_cache,
     const std::array<LodRange, max_lod_levels>& lod_ranges,
     const std::array<MeshletRange, max_lod_levels>& meshlet_ranges,
     int32_t vertex_offset,
@@ -535,55 +532,52 @@ SDL_GPUMesh::SDL_GPUMesh(
       meshlet_ranges{meshlet_ranges},
       vertex_offset{vertex_offset},
       local_bounds{local_bounds},
-      diffuse_texture{create_texture_from_image(
+      diffuse_texture{get_cached_texture(
           device,
           copy_pass,
+          texture_cache,
           texture_images.diffuse_texture,
-          create_white_pixel_texture,
-          TextureFormat::R8G8B8A8_Unorm_Srgb,
-          true
+          &SDL_GPUTextureCache::get_white_texture,
+          TextureFormat::R8G8B8A8_Unorm_Srgb
       )},
-      normal_texture{create_texture_from_image(
+      normal_texture{get_cached_texture(
           device,
           copy_pass,
+          texture_cache,
           texture_images.normal_texture,
-          create_flat_normal_texture,
-          TextureFormat::R8G8B8A8_Unorm,
-          true
+          &SDL_GPUTextureCache::get_flat_normal_texture
       )},
-      metallic_texture{create_texture_from_image(
+      metallic_texture{get_cached_texture(
           device,
           copy_pass,
+          texture_cache,
           texture_images.metallic_texture,
-          create_white_pixel_texture,
-          TextureFormat::R8G8B8A8_Unorm,
-          true
+          &SDL_GPUTextureCache::get_white_texture
       )},
       // Packed ORM (occlusion/roughness/metallic) textures share one source
-      // file across these three material slots - reuse the already-uploaded
-      // metallic_texture instead of uploading the same pixel data again.
+      // file across these three material slots - reuse metallic_texture
+      // without even the cache lookup (which would hash the pixels of a
+      // path-less image).
       roughness_texture{
           texture_images.roughness_shares_metallic_source
               ? metallic_texture
-              : create_texture_from_image(
+              : get_cached_texture(
                     device,
                     copy_pass,
+                    texture_cache,
                     texture_images.roughness_texture,
-                    create_white_pixel_texture,
-                    TextureFormat::R8G8B8A8_Unorm,
-                    true
+                    &SDL_GPUTextureCache::get_white_texture
                 )
       },
       ambient_occlusion_texture{
           texture_images.ambient_occlusion_shares_metallic_source
               ? metallic_texture
-              : create_texture_from_image(
+              : get_cached_texture(
                     device,
                     copy_pass,
+                    texture_cache,
                     texture_images.ambient_occlusion_texture,
-                    create_white_pixel_texture,
-                    TextureFormat::R8G8B8A8_Unorm,
-                    true
+                    &SDL_GPUTextureCache::get_white_texture
                 )
       },
       diffuse_sampler{make_sampler(device, texture_images.diffuse_texture_wrap)},
@@ -608,7 +602,7 @@ auto SDL_GPUMesh::draw(RenderPass& sdl_gpu_pass) const -> void {
 }
 
 auto SDL_GPUMesh::draw_instanced(
-    int32_t instance_count, RenderPass& sdl_gpu_pass
+    int32_t instance_count, RenderPass& sdl_gpu_pass, uint32_t first_instance
 ) const -> void {
     const auto sampler_bindings = std::array{
         TextureSamplerBinding{
@@ -632,7 +626,7 @@ auto SDL_GPUMesh::draw_instanced(
 
     sdl_gpu_pass.draw_indexed_primitives(
         lod_ranges[0].index_count, static_cast<uint32_t>(instance_count),
-        lod_ranges[0].first_index, vertex_offset
+        lod_ranges[0].first_index, vertex_offset, first_instance
     );
 }
 
@@ -707,254 +701,319 @@ auto SDL_GPUMesh::get_meshlet_range(std::size_t lod_index) const
     return meshlet_ranges.at(lod_index);
 }
 
-auto SDL_GPUMesh::generate_mipmaps(CommandBuffer& command_buffer) const
-    -> void {
-    const auto textures = std::array<const Texture*, 5>{
-        &diffuse_texture,
-        &normal_texture,
-        &metallic_texture,
-        &roughness_texture,
-        &ambient_occlusion_texture,
-    };
-
-    // Roughness/ambient-occlusion may share metallic_texture's native handle
-    // (see TextureImages::roughness_shares_metallic_source) - skip a handle
-    // already processed this call so its mip chain isn't generated twice.
-    auto processed_handles = std::array<SDL_GPUTexture*, 5>{};
-    auto processed_count = std::size_t{0};
-
-    for (const auto* texture : textures) {
-        // Default 1x1 fallback textures (used when a material has no path
-        // for this slot) only have 1 mip level; SDL asserts if asked to
-        // generate mipmaps for those.
-        if (texture->get_mip_levels() <= 1) {
-            continue;
-        }
+namespace {
 
-        auto* const handle = texture->native_handle();
-        auto already_processed = false;
-        for (auto i = std::size_t{0}; i < processed_count; ++i) {
-            if (processed_handles.at(i) == handle) {
-                already_processed = true;
-                break;
-            }
-        }
-        if (already_processed) {
-            continue;
-        }
+// Everything load_meshes_from_model bakes into a renderable besides the
+// source geometry itself - folded into the mesh cache key, so changing any
+// of these (or vertex_stride_in_floats / the meshlet limits) invalidates
+// previously baked entries instead of silently reusing them.
+auto get_mesh_bake_settings_hash() -> uint64_t {
+    const auto settings = std::array<float, 9>{
+        static_cast<float>(vertex_stride_in_floats),
+        overdraw_threshold,
+        lod_index_ratios[0],
+        lod_index_ratios[1],
+        lod_index_ratios[2],
+        lod_target_error,
+        static_cast<float>(min_lod_index_count),
+        static_cast<float>(meshlet_max_vertices * 1000 + meshlet_max_triangles),
+        meshlet_cone_weight,
+    };
+    static_assert(max_lod_levels == 4);
 
-        command_buffer.generate_mipmaps(*texture);
-        processed_handles.at(processed_count) = handle;
-        ++processed_count;
-    }
+    return hash_bytes(mesh_cache_hash_seed, gsl::as_bytes(gsl::span{settings}));
 }
 
-auto load_meshes_from_model(
-    GPUDevice& device, const std::filesystem::path& model_path
-) -> RenderableMeshes {
-    const auto model_data_opt =
-        Luminol::Utilities::ModelLoader::load_model(model_path);
+// One submesh's share of a BakedMesh, baked in isolation: every offset is
+// relative to the submesh itself (LodRange::first_index,
+// MeshletRange::first_meshlet and the meshlet vertex/triangle offsets all
+// start at 0, and meshlet_vertices index into this submesh's own vertices).
+// That's what lets bake_model run submeshes concurrently - merge_submesh
+// then rebases each result onto the renderable-wide arrays in submesh
+// order, producing exactly what a serial bake would have.
+struct SubmeshBakeResult {
+    std::vector<float> vertices;
+    std::vector<uint32_t> indices;
+    std::vector<GpuMeshletMetadata> meshlets;
+    std::vector<uint32_t> meshlet_vertices;
+    std::vector<uint32_t> meshlet_triangles;
+    BakedSubmesh submesh;
+};
+
+// Interleaving, meshoptimizer's vertex cache/overdraw/fetch optimizations,
+// LOD simplification and meshlet building for one submesh - the expensive
+// part of a cold load that the mesh cache exists to skip.
+auto bake_submesh(const Luminol::Utilities::ModelLoader::MeshData& mesh_data)
+    -> SubmeshBakeResult {
+    constexpr auto vertex_components = vertex_stride_in_floats;
+
+    Expects(mesh_data.vertices.size() == mesh_data.texture_coordinates.size());
+
+    auto result = SubmeshBakeResult{};
+
+    auto mesh_vertices = std::vector<float>{};
+    mesh_vertices.reserve(mesh_data.vertices.size() * vertex_components);
+
+    for (size_t i = 0; i < mesh_data.vertices.size(); ++i) {
+        mesh_vertices.push_back(mesh_data.vertices[i].x());
+        mesh_vertices.push_back(mesh_data.vertices[i].y());
+        mesh_vertices.push_back(mesh_data.vertices[i].z());
+        mesh_vertices.push_back(mesh_data.texture_coordinates[i].x());
+        mesh_vertices.push_back(mesh_data.texture_coordinates[i].y());
+        mesh_vertices.push_back(mesh_data.normals[i].x());
+        mesh_vertices.push_back(mesh_data.normals[i].y());
+        mesh_vertices.push_back(mesh_data.normals[i].z());
+        mesh_vertices.push_back(mesh_data.tangents[i].x());
+        mesh_vertices.push_back(mesh_data.tangents[i].y());
+        mesh_vertices.push_back(mesh_data.tangents[i].z());
+    }
 
-    Expects(model_data_opt.has_value());
+    auto mesh_indices = mesh_data.indices;
+    const auto vertex_stride = vertex_components * sizeof(float);
 
-    const auto& model_data = model_data_opt.value();
+    meshopt_optimizeVertexCache(
+        mesh_indices.data(), mesh_indices.data(), mesh_indices.size(),
+        mesh_data.vertices.size()
+    );
+    meshopt_optimizeOverdraw(
+        mesh_indices.data(), mesh_indices.data(), mesh_indices.size(),
+        mesh_vertices.data(), mesh_data.vertices.size(), vertex_stride,
+        overdraw_threshold
+    );
+    const auto new_vertex_count = meshopt_optimizeVertexFetch(
+        mesh_vertices.data(), mesh_indices.data(), mesh_indices.size(),
+        mesh_vertices.data(), mesh_data.vertices.size(), vertex_stride
+    );
+    mesh_vertices.resize(new_vertex_count * vertex_components);
 
-    constexpr auto vertex_components = 11;
+    auto first_index = uint32_t{0};
 
-    // Build one shared vertex/index buffer covering every submesh, so all of
-    // a renderable's submeshes can be drawn against a single bound
-    // vertex/index buffer (required for indirect multi-draw batching, see
-    // SDL_GPUPointSpotShadowPass). Each submesh's indices in ModelLoader
-    // output are already local/0-based, so they're concatenated as-is; only
-    // first_index/vertex_offset need to track the running totals. Each
-    // submesh also gets max_lod_levels-1 additional simplified index ranges
-    // appended after its LOD0 range, all referencing the same vertex range
-    // (see LodRange).
-    struct SubmeshInfo {
-        std::array<LodRange, max_lod_levels> lod_ranges;
-        std::array<MeshletRange, max_lod_levels> meshlet_ranges;
-        int32_t vertex_offset;
-        BoundingBox local_bounds;
-        Utilities::ModelLoader::MeshData const* mesh_data;
+    auto lod_ranges = std::array<LodRange, max_lod_levels>{};
+    lod_ranges[0] = LodRange{
+        .first_index = first_index,
+        .index_count = static_cast<uint32_t>(mesh_indices.size()),
     };
 
-    // Target index-count ratios (relative to LOD0) for LOD1.. onward, and the
-    // meshopt_simplify target error tolerated to reach them. Global defaults
-    // for now - not configurable per model.
-    constexpr auto lod_index_ratios =
-        std::array<float, max_lod_levels - 1>{0.5F, 0.25F, 0.1F};
-    constexpr auto lod_target_error = 0.02F;
-    constexpr auto min_lod_index_count = std::size_t{96};
-
-    auto combined_vertices = std::vector<float>{};
-    auto combined_indices = std::vector<uint32_t>{};
-    auto combined_meshlets = std::vector<GpuMeshletMetadata>{};
-    auto combined_meshlet_vertices = std::vector<uint32_t>{};
-    auto combined_meshlet_triangles = std::vector<uint32_t>{};
-    auto submesh_infos = std::vector<SubmeshInfo>{};
-    submesh_infos.reserve(model_data.meshes.size());
-
-    auto running_vertex_offset = int32_t{0};
-    auto running_first_index = uint32_t{0};
-
-    for (const auto& mesh_data : model_data.meshes) {
-        Expects(
-            mesh_data.vertices.size() == mesh_data.texture_coordinates.size()
+    auto meshlet_ranges = std::array<MeshletRange, max_lod_levels>{};
+    meshlet_ranges[0] = build_meshlets(
+        mesh_indices,
+        mesh_vertices,
+        new_vertex_count,
+        vertex_stride,
+        0U,
+        result.meshlets,
+        result.meshlet_vertices,
+        result.meshlet_triangles
+    );
+
+    result.indices.insert(
+        result.indices.end(), mesh_indices.begin(), mesh_indices.end()
+    );
+    first_index += static_cast<uint32_t>(mesh_indices.size());
+
+    // Generate coarser LODs by repeatedly simplifying the previous LOD's
+    // index buffer. meshopt_simplify only selects a subset of the existing
+    // vertices (it never introduces new ones), so every LOD level can keep
+    // referencing this submesh's single vertex range.
+    auto previous_lod_indices = mesh_indices;
+    for (auto lod = std::size_t{1}; lod < max_lod_levels; ++lod) {
+        auto target_index_count = std::max(
+            min_lod_index_count,
+            static_cast<std::size_t>(
+                static_cast<float>(mesh_indices.size()) *
+                lod_index_ratios.at(lod - 1)
+            )
         );
+        target_index_count -= target_index_count % 3;
 
-        auto mesh_vertices = std::vector<float>{};
-        mesh_vertices.reserve(mesh_data.vertices.size() * vertex_components);
-
-        for (size_t i = 0; i < mesh_data.vertices.size(); ++i) {
-            mesh_vertices.push_back(mesh_data.vertices[i].x());
-            mesh_vertices.push_back(mesh_data.vertices[i].y());
-            mesh_vertices.push_back(mesh_data.vertices[i].z());
-            mesh_vertices.push_back(mesh_data.texture_coordinates[i].x());
-            mesh_vertices.push_back(mesh_data.texture_coordinates[i].y());
-            mesh_vertices.push_back(mesh_data.normals[i].x());
-            mesh_vertices.push_back(mesh_data.normals[i].y());
-            mesh_vertices.push_back(mesh_data.normals[i].z());
-            mesh_vertices.push_back(mesh_data.tangents[i].x());
-            mesh_vertices.push_back(mesh_data.tangents[i].y());
-            mesh_vertices.push_back(mesh_data.tangents[i].z());
+        if (target_index_count >= previous_lod_indices.size()) {
+            lod_ranges.at(lod) = lod_ranges.at(lod - 1);
+            meshlet_ranges.at(lod) = meshlet_ranges.at(lod - 1);
+            continue;
         }
 
-        auto mesh_indices = mesh_data.indices;
-        const auto vertex_stride = vertex_components * sizeof(float);
+        auto simplified_indices =
+            std::vector<uint32_t>(previous_lod_indices.size());
+        auto result_error = 0.0F;
+        const auto simplified_count = meshopt_simplify(
+            simplified_indices.data(),
+            previous_lod_indices.data(),
+            previous_lod_indices.size(),
+            mesh_vertices.data(),
+            new_vertex_count,
+            vertex_stride,
+            target_index_count,
+            lod_target_error,
+            meshopt_SimplifyLockBorder,
+            &result_error
+        );
+        simplified_indices.resize(simplified_count);
+
+        // meshopt_simplify can stop early once its error bound is hit,
+        // producing few or no fewer triangles than the previous LOD - reuse
+        // the previous (finer) LOD's range rather than storing a degenerate
+        // or non-simplified duplicate.
+        if (simplified_count < 3 ||
+            simplified_count >= previous_lod_indices.size()) {
+            lod_ranges.at(lod) = lod_ranges.at(lod - 1);
+            meshlet_ranges.at(lod) = meshlet_ranges.at(lod - 1);
+            continue;
+        }
 
         meshopt_optimizeVertexCache(
-            mesh_indices.data(), mesh_indices.data(), mesh_indices.size(),
-            mesh_data.vertices.size()
-        );
-        meshopt_optimizeOverdraw(
-            mesh_indices.data(), mesh_indices.data(), mesh_indices.size(),
-            mesh_vertices.data(), mesh_data.vertices.size(), vertex_stride,
-            1.05F
+            simplified_indices.data(), simplified_indices.data(),
+            simplified_indices.size(), new_vertex_count
         );
-        const auto new_vertex_count = meshopt_optimizeVertexFetch(
-            mesh_vertices.data(), mesh_indices.data(), mesh_indices.size(),
-            mesh_vertices.data(), mesh_data.vertices.size(), vertex_stride
-        );
-        mesh_vertices.resize(new_vertex_count * vertex_components);
 
-        auto lod_ranges = std::array<LodRange, max_lod_levels>{};
-        lod_ranges[0] = LodRange{
-            .first_index = running_first_index,
-            .index_count = static_cast<uint32_t>(mesh_indices.size()),
+        lod_ranges.at(lod) = LodRange{
+            .first_index = first_index,
+            .index_count = static_cast<uint32_t>(simplified_indices.size()),
         };
-
-        auto meshlet_ranges = std::array<MeshletRange, max_lod_levels>{};
-        meshlet_ranges[0] = build_meshlets(
-            mesh_indices,
+        meshlet_ranges.at(lod) = build_meshlets(
+            simplified_indices,
             mesh_vertices,
             new_vertex_count,
             vertex_stride,
-            static_cast<uint32_t>(running_vertex_offset),
-            combined_meshlets,
-            combined_meshlet_vertices,
-            combined_meshlet_triangles
+            0U,
+            result.meshlets,
+            result.meshlet_vertices,
+            result.meshlet_triangles
         );
-
-        combined_indices.insert(
-            combined_indices.end(), mesh_indices.begin(), mesh_indices.end()
+        result.indices.insert(
+            result.indices.end(), simplified_indices.begin(),
+            simplified_indices.end()
         );
-        running_first_index += static_cast<uint32_t>(mesh_indices.size());
-
-        // Generate coarser LODs by repeatedly simplifying the previous LOD's
-        // index buffer. meshopt_simplify only selects a subset of the
-        // existing vertices (it never introduces new ones), so every LOD
-        // level can keep referencing this submesh's single vertex range.
-        auto previous_lod_indices = mesh_indices;
-        for (auto lod = std::size_t{1}; lod < max_lod_levels; ++lod) {
-            auto target_index_count = std::max(
-                min_lod_index_count,
-                static_cast<std::size_t>(
-                    static_cast<float>(mesh_indices.size()) *
-                    lod_index_ratios.at(lod - 1)
-                )
-            );
-            target_index_count -= target_index_count % 3;
+        first_index += static_cast<uint32_t>(simplified_indices.size());
 
-            if (target_index_count >= previous_lod_indices.size()) {
-                lod_ranges.at(lod) = lod_ranges.at(lod - 1);
-                meshlet_ranges.at(lod) = meshlet_ranges.at(lod - 1);
-                continue;
-            }
+        previous_lod_indices = std::move(simplified_indices);
+    }
 
-            auto simplified_indices =
-                std::vector<uint32_t>(previous_lod_indices.size());
-            auto result_error = 0.0F;
-            const auto simplified_count = meshopt_simplify(
-                simplified_indices.data(),
-                previous_lod_indices.data(),
-                previous_lod_indices.size(),
-                mesh_vertices.data(),
-                new_vertex_count,
-                vertex_stride,
-                target_index_count,
-                lod_target_error,
-                meshopt_SimplifyLockBorder,
-                &result_error
-            );
-            simplified_indices.resize(simplified_count);
-
-            // meshopt_simplify can stop early once its error bound is hit,
-            // producing few or no fewer triangles than the previous LOD -
-            // reuse the previous (finer) LOD's range rather than storing a
-            // degenerate or non-simplified duplicate.
-            if (simplified_count < 3 ||
-                simplified_count >= previous_lod_indices.size()) {
-                lod_ranges.at(lod) = lod_ranges.at(lod - 1);
-                meshlet_ranges.at(lod) = meshlet_ranges.at(lod - 1);
-                continue;
-            }
+    result.submesh = BakedSubmesh{
+        .lod_ranges = lod_ranges,
+        .meshlet_ranges = meshlet_ranges,
+        .vertex_offset = 0,
+        .local_bounds = compute_mesh_local_bounds(mesh_vertices),
+        .material = to_baked_material(mesh_data),
+    };
+    result.vertices = std::move(mesh_vertices);
 
-            meshopt_optimizeVertexCache(
-                simplified_indices.data(), simplified_indices.data(),
-                simplified_indices.size(), new_vertex_count
-            );
+    return result;
+}
 
-            lod_ranges.at(lod) = LodRange{
-                .first_index = running_first_index,
-                .index_count = static_cast<uint32_t>(simplified_indices.size()),
-            };
-            meshlet_ranges.at(lod) = build_meshlets(
-                simplified_indices,
-                mesh_vertices,
-                new_vertex_count,
-                vertex_stride,
-                static_cast<uint32_t>(running_vertex_offset),
-                combined_meshlets,
-                combined_meshlet_vertices,
-                combined_meshlet_triangles
-            );
-            combined_indices.insert(
-                combined_indices.end(), simplified_indices.begin(),
-                simplified_indices.end()
-            );
-            running_first_index +=
-                static_cast<uint32_t>(simplified_indices.size());
+// Appends one submesh's self-relative bake onto the renderable-wide arrays,
+// shifting every offset/index by how much of each array the preceding
+// submeshes already occupy - the same running totals the serial bake used
+// to thread through the loop.
+auto merge_submesh(SubmeshBakeResult&& result, BakedMesh& baked) -> void {
+    const auto vertex_offset = static_cast<uint32_t>(
+        baked.vertices.size() / vertex_stride_in_floats
+    );
+    const auto index_offset = static_cast<uint32_t>(baked.indices.size());
+    const auto meshlet_offset = static_cast<uint32_t>(baked.meshlets.size());
+    const auto meshlet_vertex_offset =
+        static_cast<uint32_t>(baked.meshlet_vertices.size());
+    const auto meshlet_triangle_offset =
+        static_cast<uint32_t>(baked.meshlet_triangles.size());
+
+    auto submesh = std::move(result.submesh);
+    submesh.vertex_offset = static_cast<int32_t>(vertex_offset);
+    for (auto& lod_range : submesh.lod_ranges) {
+        lod_range.first_index += index_offset;
+    }
+    for (auto& meshlet_range : submesh.meshlet_ranges) {
+        meshlet_range.first_meshlet += meshlet_offset;
+    }
+    baked.submeshes.push_back(std::move(submesh));
 
-            previous_lod_indices = std::move(simplified_indices);
-        }
+    for (auto meshlet : result.meshlets) {
+        meshlet.vertex_offset += meshlet_vertex_offset;
+        meshlet.triangle_offset += meshlet_triangle_offset;
+        baked.meshlets.push_back(meshlet);
+    }
+    for (const auto meshlet_vertex : result.meshlet_vertices) {
+        baked.meshlet_vertices.push_back(meshlet_vertex + vertex_offset);
+    }
 
-        submesh_infos.push_back(SubmeshInfo{
-            .lod_ranges = lod_ranges,
-            .meshlet_ranges = meshlet_ranges,
-            .vertex_offset = running_vertex_offset,
-            .local_bounds = compute_mesh_local_bounds(mesh_vertices),
-            .mesh_data = &mesh_data,
-        });
+    baked.vertices.insert(
+        baked.vertices.end(), result.vertices.begin(), result.vertices.end()
+    );
+    baked.indices.insert(
+        baked.indices.end(), result.indices.begin(), result.indices.end()
+    );
+    baked.meshlet_triangles.insert(
+        baked.meshlet_triangles.end(),
+        result.meshlet_triangles.begin(),
+        result.meshlet_triangles.end()
+    );
+}
 
-        combined_vertices.insert(
-            combined_vertices.end(), mesh_vertices.begin(), mesh_vertices.end()
-        );
+// Warm-load counterpart of ModelLoader::load_model's texture decoding: a
+// cache hit skips assimp entirely, so the material images still have to be
+// decoded here (textures aren't part of the baked cache entry) - collected
+// up front and decoded in one parallel batch, same as load_model.
+auto load_material_textures(
+    gsl::span<const BakedSubmesh> submeshes, uint32_t decode_worker_count
+)
+    -> std::unordered_map<
+        std::filesystem::path,
+        Luminol::Utilities::ImageLoader::Image> {
+    auto unique_paths = std::vector<std::filesystem::path>{};
+    const auto collect =
+        [&unique_paths](const std::optional<std::filesystem::path>& path) {
+            if (path.has_value() &&
+                std::ranges::find(unique_paths, *path) == unique_paths.end()) {
+                unique_paths.push_back(*path);
+            }
+        };
 
-        running_vertex_offset += static_cast<int32_t>(new_vertex_count);
+    for (const auto& submesh : submeshes) {
+        collect(submesh.material.diffuse_texture_path);
+        collect(submesh.material.normal_texture_path);
+        collect(submesh.material.metallic_texture_path);
+        collect(submesh.material.roughness_texture_path);
+        collect(submesh.material.ambient_occlusion_texture_path);
     }
 
+    auto images = Luminol::Utilities::ImageLoader::load_images(
+        unique_paths, desired_rgba_channels, decode_worker_count
+    );
+
+    auto textures_map = std::unordered_map<
+        std::filesystem::path,
+        Luminol::Utilities::ImageLoader::Image>{};
+    textures_map.reserve(images.size());
+    for (auto i = std::size_t{0}; i < images.size(); ++i) {
+        textures_map.emplace(unique_paths[i], std::move(images[i]));
+    }
+
+    return textures_map;
+}
+
+auto upload_baked_mesh(
+    GPUDevice& device,
+    SDL_GPUTextureCache& texture_cache,
+    const BakedMeshView& baked_mesh,
+    const std::unordered_map<
+        std::filesystem::path,
+        Luminol::Utilities::ImageLoader::Image>& textures_map,
+    VertexFormat vertex_format
+) -> RenderableMeshes {
     auto meshes = std::vector<SDL_GPUMesh>{};
-    meshes.reserve(submesh_infos.size());
+    meshes.reserve(baked_mesh.submeshes.size());
+
+    // The bake (and the mesh cache) always stays full-precision fp32 - the
+    // compact layout is a pure function of it, so it's encoded here rather
+    // than invalidating every cache entry whenever the format is switched.
+    auto compact_vertices = std::optional<CompactVertices>{};
+    if (vertex_format == VertexFormat::Compact) {
+        compact_vertices = encode_compact_vertices(baked_mesh.vertices);
+    }
+    const auto vertex_bytes =
+        compact_vertices.has_value()
+            ? gsl::as_bytes(gsl::span{compact_vertices->vertices})
+            : gsl::as_bytes(baked_mesh.vertices);
+
+    const auto texture_stats_before = texture_cache.get_stats();
 
     auto command_buffer = device.create_command_buffer();
     auto vertex_buffer = std::optional<Buffer>{};
@@ -968,12 +1027,10 @@ auto load_meshes_from_model(
         vertex_buffer = create_uploaded_buffer(
             device,
             copy_pass,
-            combined_vertices.data(),
-            static_cast<uint32_t>(
-                combined_vertices.size() * sizeof(float)
-            ),
+            vertex_bytes.data(),
+            static_cast<uint32_t>(vertex_bytes.size()),
             // StorageRead (in addition to Vertex): also bindable as a
-            // StructuredBuffer<float> for the main pass's meshlet
+            // StructuredBuffer<float/uint> for the main pass's meshlet
             // vertex-pull path (pbr_vert_meshlet.hlsl) - purely additive,
             // the existing fixed-function vertex buffer path is unchanged.
             BufferUsage::Vertex | BufferUsage::StorageRead
@@ -981,10 +1038,8 @@ auto load_meshes_from_model(
         index_buffer = create_uploaded_buffer(
             device,
             copy_pass,
-            combined_indices.data(),
-            static_cast<uint32_t>(
-                combined_indices.size() * sizeof(uint32_t)
-            ),
+            baked_mesh.indices.data(),
+            static_cast<uint32_t>(baked_mesh.indices.size_bytes()),
             BufferUsage::Index
         );
         // StorageRead (not Vertex/Index): these are only ever read via
@@ -997,61 +1052,228 @@ auto load_meshes_from_model(
         meshlet_metadata_buffer = create_uploaded_buffer(
             device,
             copy_pass,
-            combined_meshlets.data(),
-            static_cast<uint32_t>(
-                combined_meshlets.size() * sizeof(GpuMeshletMetadata)
-            ),
+            baked_mesh.meshlets.data(),
+            static_cast<uint32_t>(baked_mesh.meshlets.size_bytes()),
             BufferUsage::StorageRead | BufferUsage::ComputeStorageRead
         );
         meshlet_vertices_buffer = create_uploaded_buffer(
             device,
             copy_pass,
-            combined_meshlet_vertices.data(),
-            static_cast<uint32_t>(
-                combined_meshlet_vertices.size() * sizeof(uint32_t)
-            ),
+            baked_mesh.meshlet_vertices.data(),
+            static_cast<uint32_t>(baked_mesh.meshlet_vertices.size_bytes()),
             BufferUsage::StorageRead
         );
         meshlet_triangles_buffer = create_uploaded_buffer(
             device,
             copy_pass,
-            combined_meshlet_triangles.data(),
-            static_cast<uint32_t>(
-                combined_meshlet_triangles.size() * sizeof(uint32_t)
-            ),
+            baked_mesh.meshlet_triangles.data(),
+            static_cast<uint32_t>(baked_mesh.meshlet_triangles.size_bytes()),
             BufferUsage::StorageRead
         );
 
-        for (const auto& info : submesh_infos) {
+        for (const auto& submesh : baked_mesh.submeshes) {
             const auto texture_images =
-                to_texture_images(*info.mesh_data, model_data.textures_map);
+                to_texture_images(submesh.material, textures_map);
 
             meshes.emplace_back(
                 device,
                 copy_pass,
-                info.lod_ranges,
-                info.meshlet_ranges,
-                info.vertex_offset,
-                info.local_bounds,
+                texture_cache,
+                submesh.lod_ranges,
+                submesh.meshlet_ranges,
+                submesh.vertex_offset,
+                submesh.local_bounds,
                 texture_images
             );
         }
     }
 
-    for (const auto& mesh : meshes) {
-        mesh.generate_mipmaps(command_buffer);
-    }
+    texture_cache.generate_pending_mipmaps(command_buffer);
 
     command_buffer.submit();
 
+    log_texture_cache_savings(texture_stats_before, texture_cache.get_stats());
+
     return RenderableMeshes{
         .vertex_buffer = std::move(vertex_buffer).value(),
         .index_buffer = std::move(index_buffer).value(),
         .meshlet_metadata_buffer = std::move(meshlet_metadata_buffer).value(),
         .meshlet_vertices_buffer = std::move(meshlet_vertices_buffer).value(),
         .meshlet_triangles_buffer = std::move(meshlet_triangles_buffer).value(),
+        .vertex_dequantization = compact_vertices.has_value()
+                                     ? compact_vertices->dequantization
+                                     : VertexDequantization{},
         .meshes = std::move(meshes),
     };
 }
 
+}  // namespace
+
+auto bake_model(
+    const Utilities::ModelLoader::ModelData& model_data, uint32_t worker_count
+) -> BakedMesh {
+    const auto submesh_count = model_data.meshes.size();
+
+    // Every submesh is independent until the merge, so they're baked
+    // concurrently - largest first, since a model's submeshes range from a
+    // handful of triangles to most of its geometry, and starting a huge one
+    // last would leave every other worker idle while it finishes.
+    auto bake_order = std::vector<std::size_t>(submesh_count);
+    std::iota(bake_order.begin(), bake_order.end(), std::size_t{0});
+    std::ranges::stable_sort(
+        bake_order,
+        std::ranges::greater{},
+        [&model_data](std::size_t submesh_index) {
+            return model_data.meshes[submesh_index].indices.size();
+        }
+    );
+
+    auto results = std::vector<SubmeshBakeResult>(submesh_count);
+    Utilities::parallel_for(
+        submesh_count,
+        worker_count,
+        [&](std::size_t job_index) {
+            const auto submesh_index = bake_order[job_index];
+            results[submesh_index] =
+                bake_submesh(model_data.meshes[submesh_index]);
+        }
+    );
+
+    // Build one shared vertex/index buffer covering every submesh, so all of
+    // a renderable's submeshes can be drawn against a single bound
+    // vertex/index buffer (required for indirect multi-draw batching, see
+    // SDL_GPUPointSpotShadowPass). Merging strictly in submesh order keeps
+    // the output byte-identical to a serial bake regardless of which worker
+    // finished first.
+    auto baked = BakedMesh{};
+    auto total_vertices = std::size_t{0};
+    auto total_indices = std::size_t{0};
+    auto total_meshlets = std::size_t{0};
+    auto total_meshlet_vertices = std::size_t{0};
+    auto total_meshlet_triangles = std::size_t{0};
+    for (const auto& result : results) {
+        total_vertices += result.vertices.size();
+        total_indices += result.indices.size();
+        total_meshlets += result.meshlets.size();
+        total_meshlet_vertices += result.meshlet_vertices.size();
+        total_meshlet_triangles += result.meshlet_triangles.size();
+    }
+    baked.vertices.reserve(total_vertices);
+    baked.indices.reserve(total_indices);
+    baked.meshlets.reserve(total_meshlets);
+    baked.meshlet_vertices.reserve(total_meshlet_vertices);
+    baked.meshlet_triangles.reserve(total_meshlet_triangles);
+    baked.submeshes.reserve(submesh_count);
+
+    for (auto& result : results) {
+        merge_submesh(std::move(result), baked);
+    }
+
+    return baked;
+}
+
+auto PreparedModel::view() const -> BakedMeshView {
+    return this->cache_entry.has_value() ? this->cache_entry->view()
+                                         : this->baked_mesh.view();
+}
+
+auto PreparedModel::get_upload_size_bytes() const -> uint64_t {
+    const auto mesh = this->view();
+    auto size_bytes = uint64_t{mesh.vertices.size_bytes()} +
+                      mesh.indices.size_bytes() + mesh.meshlets.size_bytes() +
+                      mesh.meshlet_vertices.size_bytes() +
+                      mesh.meshlet_triangles.size_bytes();
+    for (const auto& [path, image] : this->textures_map) {
+        size_bytes += image.data.size();
+    }
+    return size_bytes;
+}
+
+auto prepare_model(
+    const std::filesystem::path& model_path,
+    const Utilities::ModelLoader::LoadOptions& options
+) -> std::optional<PreparedModel> {
+    const auto model_directory = model_path.parent_path();
+    const auto cache_key = compute_mesh_cache_key(
+        model_path,
+        Luminol::Utilities::ModelLoader::get_import_flags(),
+        get_mesh_bake_settings_hash()
+    );
+
+    // Warm load: the cache entry's arrays stay memory-mapped and are later
+    // uploaded straight from the mapping - no assimp, no meshoptimizer, no
+    // intermediate copies. PreparedModel owns the mapping, so it only has to
+    // outlive upload_prepared_model's memcpy into the transfer buffers.
+    if (cache_key.has_value()) {
+        auto cache_entry = MeshCacheEntry::open(
+            get_mesh_cache_path(*cache_key), *cache_key, model_directory
+        );
+        if (cache_entry.has_value()) {
+            auto textures_map = load_material_textures(
+                cache_entry->view().submeshes,
+                options.texture_decode_worker_count
+            );
+            log_meshlet_triangle_packing(model_path, cache_entry->view());
+            return PreparedModel{
+                .cache_entry = std::move(cache_entry),
+                .baked_mesh = {},
+                .textures_map = std::move(textures_map),
+            };
+        }
+    }
+
+    auto model_data_opt =
+        Luminol::Utilities::ModelLoader::load_model(model_path, options);
+    if (!model_data_opt.has_value()) {
+        return std::nullopt;
+    }
+
+    auto& model_data = model_data_opt.value();
+    auto baked_mesh = bake_model(model_data, options.mesh_bake_worker_count);
+
+    if (cache_key.has_value()) {
+        write_mesh_cache(
+            get_mesh_cache_path(*cache_key),
+            *cache_key,
+            baked_mesh.view(),
+            model_directory
+        );
+    }
+
+    log_meshlet_triangle_packing(model_path, baked_mesh.view());
+
+    return PreparedModel{
+        .cache_entry = std::nullopt,
+        .baked_mesh = std::move(baked_mesh),
+        .textures_map = std::move(model_data.textures_map),
+    };
+}
+
+auto upload_prepared_model(
+    GPUDevice& device,
+    SDL_GPUTextureCache& texture_cache,
+    const PreparedModel& model,
+    VertexFormat vertex_format
+) -> RenderableMeshes {
+    return upload_baked_mesh(
+        device, texture_cache, model.view(), model.textures_map, vertex_format
+    );
+}
+
+auto load_meshes_from_model(
+    GPUDevice& device,
+    SDL_GPUTextureCache& texture_cache,
+    const std::filesystem::path& model_path,
+    const Utilities::ModelLoader::LoadOptions& options,
+    VertexFormat vertex_format
+) -> RenderableMeshes {
+    const auto prepared_model = prepare_model(model_path, options);
+
+    Expects(prepared_model.has_value());
+
+    return upload_prepared_model(
+        device, texture_cache, *prepared_model, vertex_format
+    );
+}
+
 }  // namespace Luminol::Graphics::SDL_GPU
@@ -11,6 +11,8 @@
 #include <LuminolRenderEngine/Graphics/TexturePaths.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUBuffer.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUTexture.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUTextureCache.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUVertexFormat.hpp>
 #include <LuminolRenderEngine/Utilities/ImageLoader.hpp>
 #include <LuminolRenderEngine/Utilities/ModelLoader.hpp>
 
@@ -49,7 +51,9 @@ struct MeshletRange {
 // level, generated by meshopt_buildMeshlets (see load_meshes_from_model).
 // vertex_offset/triangle_offset are absolute offsets into the renderable's
 // shared meshlet_vertices_buffer / meshlet_triangles_buffer (baked at load
-// time - callers never need a separate per-submesh base). bounds_center/
+// time - callers never need a separate per-submesh base). triangle_offset
+// counts packed triangle words, not individual indices - see
+// pack_meshlet_triangle. bounds_center/
 // bounds_radius and local_bounds_min/max are both local-space (transformed
 // by each instance's model matrix at cull time) and describe the SAME
 // cluster - the sphere is kept for the frustum test (cheap, and frustum
@@ -102,12 +106,15 @@ struct TextureImages {
 // A submesh's draw parameters into its renderable's shared vertex/index
 // buffers (see RenderableMeshes) - not owned buffers of its own, so several
 // submeshes can be batched into a single indirect multi-draw call sharing
-// one bound vertex/index buffer.
+// one bound vertex/index buffer. Material textures come from texture_cache,
+// so submeshes (and renderables) referencing the same image share one GPU
+// texture - see SDL_GPUTextureCache.
 class SDL_GPUMesh {
 public:
     SDL_GPUMesh(
         GPUDevice& device,
         CopyPass& copy_pass,
+        SDL_GPUTextureCache& texture_cache,
         const std::array<LodRange, max_lod_levels>& lod_ranges,
         const std::array<MeshletRange, max_lod_levels>& meshlet_ranges,
         int32_t vertex_offset,
@@ -118,6 +125,7 @@ public:
     SDL_GPUMesh(
         GPUDevice& device,
         CopyPass& copy_pass,
+        SDL_GPUTextureCache& texture_cache,
         const std::array<LodRange, max_lod_levels>& lod_ranges,
         const std::array<MeshletRange, max_lod_levels>& meshlet_ranges,
         int32_t vertex_offset,
@@ -128,8 +136,13 @@ public:
     // Caller must have already bound this mesh's renderable's shared
     // vertex/index buffers (see RenderableMeshes) on sdl_gpu_pass.
     auto draw(RenderPass& sdl_gpu_pass) const -> void;
-    auto draw_instanced(int32_t instance_count, RenderPass& sdl_gpu_pass) const
-        -> void;
+    // first_instance offsets SV_InstanceID, selecting where in the bound
+    // instance arena (see SDL_GPUInstanceBufferCache) the instances start.
+    auto draw_instanced(
+        int32_t instance_count,
+        RenderPass& sdl_gpu_pass,
+        uint32_t first_instance = 0
+    ) const -> void;
 
     // Issues the draw call without binding material samplers. Used by passes
     // whose fragment shader doesn't sample any of this mesh's material
@@ -187,10 +200,6 @@ public:
     // draw skipping).
     [[nodiscard]] auto get_local_bounds() const -> const BoundingBox&;
 
-    // Generates mip chains for the material textures. Must be called outside
-    // any render/copy pass on command_buffer.
-    auto generate_mipmaps(CommandBuffer& command_buffer) const -> void;
-
 private:
     std::array<LodRange, max_lod_levels> lod_ranges;
     std::array<MeshletRange, max_lod_levels> meshlet_ranges;
@@ -229,6 +238,9 @@ struct RenderableMeshes {
     Buffer meshlet_metadata_buffer;
     Buffer meshlet_vertices_buffer;
     Buffer meshlet_triangles_buffer;
+    // Identity unless vertex_buffer holds VertexFormat::Compact vertices -
+    // pushed to vertex uniform slot 1 wherever vertex_buffer is drawn from.
+    VertexDequantization vertex_dequantization;
     std::vector<SDL_GPUMesh> meshes;
 };
 
@@ -241,7 +253,11 @@ struct RenderableMeshes {
     -> BoundingBox;
 
 [[nodiscard]] auto load_meshes_from_model(
-    GPUDevice& device, const std::filesystem::path& model_path
+    GPUDevice& device,
+    SDL_GPUTextureCache& texture_cache,
+    const std::filesystem::path& model_path,
+    const Utilities::ModelLoader::LoadOptions& options = {},
+    VertexFormat vertex_format = VertexFormat::Full
 ) -> RenderableMeshes;
 
 // Builds meshlets for one already-finalized (vertex-cache-optimized) index
@@ -254,7 +270,9 @@ struct RenderableMeshes {
 // vertex_positions_stride is in bytes (matches meshoptimizer's own
 // convention); submesh_vertex_offset is added to every meshlet_vertices
 // entry so it's an absolute index into the renderable's combined vertex
-// buffer, matching LodRange/vertex_offset's existing convention.
+// buffer, matching LodRange/vertex_offset's existing convention. Each
+// meshlet triangle is appended to combined_meshlet_triangles as a single
+// pack_meshlet_triangle word.
 [[nodiscard]] auto build_meshlets(
     gsl::span<const uint32_t> indices,
     gsl::span<const float> vertex_positions,
@@ -266,4 +284,15 @@ struct RenderableMeshes {
     std::vector<uint32_t>& combined_meshlet_triangles
 ) -> MeshletRange;
 
+// Packs one meshlet triangle's three local vertex slots (each < the 64-vertex
+// meshlet limit, so a byte is plenty) into bits 0-7, 8-15 and 16-23 of a
+// single word - 4 bytes per triangle instead of 12 for three widened uint32
+// indices. Still one whole word per triangle rather than a tighter
+// byte stream, so pbr_vert_meshlet.hlsl can fetch a triangle with a single
+// aligned StructuredBuffer<uint> load and no cross-word straddling; it
+// unpacks with (word >> (8 * vertex_in_triangle)) & 0xFF.
+[[nodiscard]] auto pack_meshlet_triangle(
+    uint8_t local_vertex0, uint8_t local_vertex1, uint8_t local_vertex2
+) -> uint32_t;
+
 }  // namespace Luminol::Graphics::SDL_GPU
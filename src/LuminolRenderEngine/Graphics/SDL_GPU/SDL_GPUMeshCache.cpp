@@ -0,0 +1,721 @@
+#include "SDL_GPUMeshCache.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+#include <SDL3/SDL_log.h>
+
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUVertexFormat.hpp>
+
+namespace {
+
+using namespace Luminol::Graphics::SDL_GPU;
+using Luminol::Utilities::ModelLoader::AlphaMode;
+using Luminol::Utilities::ModelLoader::TextureWrap;
+using Luminol::Utilities::ModelLoader::TextureWrapMode;
+
+constexpr auto cache_magic =
+    std::array<char, 8>{'L', 'M', 'N', 'M', 'E', 'S', 'H', '\0'};
+
+// Every section starts on a 16-byte boundary, so the typed spans handed out
+// by MeshCacheEntry::view() are correctly aligned for float/uint32_t/
+// GpuMeshletMetadata (mmap itself returns page-aligned memory).
+constexpr auto section_alignment = uint64_t{16};
+
+enum class Section : std::size_t {
+    Vertices,
+    Indices,
+    Meshlets,
+    MeshletVertices,
+    MeshletTriangles,
+    Submeshes,
+    Count,
+};
+
+struct SectionRecord {
+    uint64_t offset;
+    uint64_t size_bytes;
+};
+
+struct MeshCacheHeader {
+    std::array<char, 8> magic;
+    uint32_t version;
+    // Catches a header compiled with a different layout (e.g. a struct
+    // padding change) that forgot to bump mesh_cache_version.
+    uint32_t header_size;
+    uint64_t key;
+    uint64_t file_size;
+    // hash_bytes over everything after the header, padding included - so a
+    // corrupted entry whose sections are still in bounds is caught too.
+    uint64_t payload_hash;
+    std::array<SectionRecord, static_cast<std::size_t>(Section::Count)>
+        sections;
+};
+
+static_assert(std::is_trivially_copyable_v<MeshCacheHeader>);
+
+using SectionPayloads = std::array<
+    gsl::span<const std::byte>,
+    static_cast<std::size_t>(Section::Count)>;
+static_assert(std::is_trivially_copyable_v<GpuMeshletMetadata>);
+
+// Fixed-size part of a serialized BakedSubmesh - followed by the five
+// material slot paths, each a uint32_t byte length (no_texture_path if the
+// slot is empty) and that many UTF-8 bytes.
+struct SubmeshRecord {
+    std::array<LodRange, max_lod_levels> lod_ranges;
+    std::array<MeshletRange, max_lod_levels> meshlet_ranges;
+    int32_t vertex_offset;
+    std::array<float, 3> bounds_min;
+    std::array<float, 3> bounds_max;
+    // u, v per material slot, in BakedMaterial declaration order.
+    std::array<uint8_t, 10> wrap_modes;
+    uint8_t alpha_mode;
+    uint8_t padding;
+};
+
+static_assert(std::is_trivially_copyable_v<SubmeshRecord>);
+
+constexpr auto no_texture_path = uint32_t{0xFFFFFFFF};
+
+auto section_index(Section section) -> std::size_t {
+    return static_cast<std::size_t>(section);
+}
+
+auto align_up(uint64_t value, uint64_t alignment) -> uint64_t {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+// Calls emit with every byte of the file after the header, in order -
+// padding included - so write_mesh_cache hashes exactly what it writes.
+template <typename Emit>
+auto emit_payload(
+    const MeshCacheHeader& header,
+    const SectionPayloads& payloads,
+    const Emit& emit
+) -> void {
+    constexpr auto zero_padding = std::array<std::byte, section_alignment>{};
+    auto offset = uint64_t{sizeof(MeshCacheHeader)};
+    const auto pad_to = [&](uint64_t target) {
+        emit(gsl::span<const std::byte>{
+            zero_padding.data(), static_cast<std::size_t>(target - offset)
+        });
+        offset = target;
+    };
+
+    for (auto i = std::size_t{0}; i < payloads.size(); ++i) {
+        pad_to(header.sections.at(i).offset);
+        emit(payloads.at(i));
+        offset += payloads.at(i).size_bytes();
+    }
+    pad_to(header.file_size);
+}
+
+template <typename T>
+auto append_pod(std::vector<std::byte>& bytes, const T& value) -> void {
+    static_assert(std::is_trivially_copyable_v<T>);
+    const auto offset = bytes.size();
+    bytes.resize(offset + sizeof(T));
+    std::memcpy(bytes.data() + offset, &value, sizeof(T));
+}
+
+auto append_path(
+    std::vector<std::byte>& bytes,
+    const std::optional<std::filesystem::path>& path,
+    const std::filesystem::path& model_directory
+) -> void {
+    if (!path.has_value()) {
+        append_pod(bytes, no_texture_path);
+        return;
+    }
+
+    auto relative_path = path->lexically_relative(model_directory);
+    if (relative_path.empty()) {
+        relative_path = *path;
+    }
+
+    const auto utf8_path = relative_path.generic_u8string();
+    append_pod(bytes, static_cast<uint32_t>(utf8_path.size()));
+
+    const auto offset = bytes.size();
+    bytes.resize(offset + utf8_path.size());
+    std::memcpy(bytes.data() + offset, utf8_path.data(), utf8_path.size());
+}
+
+auto serialize_submeshes(
+    gsl::span<const BakedSubmesh> submeshes,
+    const std::filesystem::path& model_directory
+) -> std::vector<std::byte> {
+    auto bytes = std::vector<std::byte>{};
+
+    for (const auto& submesh : submeshes) {
+        const auto& material = submesh.material;
+        const auto wraps = std::array<const TextureWrap*, 5>{
+            &material.diffuse_texture_wrap,
+            &material.normal_texture_wrap,
+            &material.metallic_texture_wrap,
+            &material.roughness_texture_wrap,
+            &material.ambient_occlusion_texture_wrap,
+        };
+
+        auto record = SubmeshRecord{
+            .lod_ranges = submesh.lod_ranges,
+            .meshlet_ranges = submesh.meshlet_ranges,
+            .vertex_offset = submesh.vertex_offset,
+            .bounds_min =
+                {submesh.local_bounds.min.x(),
+                 submesh.local_bounds.min.y(),
+                 submesh.local_bounds.min.z()},
+            .bounds_max =
+                {submesh.local_bounds.max.x(),
+                 submesh.local_bounds.max.y(),
+                 submesh.local_bounds.max.z()},
+            .wrap_modes = {},
+            .alpha_mode = static_cast<uint8_t>(material.alpha_mode),
+            .padding = 0,
+        };
+        for (auto slot = std::size_t{0}; slot < wraps.size(); ++slot) {
+            record.wrap_modes.at(slot * 2) =
+                static_cast<uint8_t>(wraps.at(slot)->u);
+            record.wrap_modes.at(slot * 2 + 1) =
+                static_cast<uint8_t>(wraps.at(slot)->v);
+        }
+        append_pod(bytes, record);
+
+        append_path(bytes, material.diffuse_texture_path, model_directory);
+        append_path(bytes, material.normal_texture_path, model_directory);
+        append_path(bytes, material.metallic_texture_path, model_directory);
+        append_path(bytes, material.roughness_texture_path, model_directory);
+        append_path(
+            bytes, material.ambient_occlusion_texture_path, model_directory
+        );
+    }
+
+    return bytes;
+}
+
+// Bounds-checked cursor over the submesh section - every read fails softly
+// (returns false) instead of reading past the mapping, so a truncated or
+// corrupted file degrades into a cache miss.
+class ByteReader {
+public:
+    explicit ByteReader(gsl::span<const std::byte> bytes) : bytes{bytes} {}
+
+    template <typename T>
+    auto read_pod(T& value) -> bool {
+        static_assert(std::is_trivially_copyable_v<T>);
+        if (bytes.size() - offset < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, bytes.data() + offset, sizeof(T));
+        offset += sizeof(T);
+        return true;
+    }
+
+    auto read_path(
+        std::optional<std::filesystem::path>& path,
+        const std::filesystem::path& model_directory
+    ) -> bool {
+        auto length = uint32_t{0};
+        if (!read_pod(length)) {
+            return false;
+        }
+        if (length == no_texture_path) {
+            path = std::nullopt;
+            return true;
+        }
+        if (bytes.size() - offset < length) {
+            return false;
+        }
+
+        auto utf8_path = std::u8string(length, u8'\0');
+        std::memcpy(utf8_path.data(), bytes.data() + offset, length);
+        offset += length;
+
+        path = model_directory / std::filesystem::path{utf8_path};
+        return true;
+    }
+
+    [[nodiscard]] auto at_end() const -> bool {
+        return offset == bytes.size();
+    }
+
+private:
+    gsl::span<const std::byte> bytes;
+    std::size_t offset = 0;
+};
+
+auto to_wrap_mode(uint8_t value, TextureWrapMode& mode) -> bool {
+    if (value > static_cast<uint8_t>(TextureWrapMode::MirroredRepeat)) {
+        return false;
+    }
+    mode = static_cast<TextureWrapMode>(value);
+    return true;
+}
+
+auto deserialize_submeshes(
+    gsl::span<const std::byte> bytes,
+    const std::filesystem::path& model_directory,
+    std::vector<BakedSubmesh>& submeshes
+) -> bool {
+    auto reader = ByteReader{bytes};
+
+    while (!reader.at_end()) {
+        auto record = SubmeshRecord{};
+        if (!reader.read_pod(record) ||
+            record.alpha_mode > static_cast<uint8_t>(AlphaMode::Blend)) {
+            return false;
+        }
+
+        auto material = BakedMaterial{};
+        const auto wraps = std::array<TextureWrap*, 5>{
+            &material.diffuse_texture_wrap,
+            &material.normal_texture_wrap,
+            &material.metallic_texture_wrap,
+            &material.roughness_texture_wrap,
+            &material.ambient_occlusion_texture_wrap,
+        };
+        for (auto slot = std::size_t{0}; slot < wraps.size(); ++slot) {
+            if (!to_wrap_mode(
+                    record.wrap_modes.at(slot * 2), wraps.at(slot)->u
+                ) ||
+                !to_wrap_mode(
+                    record.wrap_modes.at(slot * 2 + 1), wraps.at(slot)->v
+                )) {
+                return false;
+            }
+        }
+        material.alpha_mode = static_cast<AlphaMode>(record.alpha_mode);
+
+        if (!reader.read_path(material.diffuse_texture_path, model_directory) ||
+            !reader.read_path(material.normal_texture_path, model_directory) ||
+            !reader.read_path(
+                material.metallic_texture_path, model_directory
+            ) ||
+            !reader.read_path(
+                material.roughness_texture_path, model_directory
+            ) ||
+            !reader.read_path(
+                material.ambient_occlusion_texture_path, model_directory
+            )) {
+            return false;
+        }
+
+        submeshes.push_back(BakedSubmesh{
+            .lod_ranges = record.lod_ranges,
+            .meshlet_ranges = record.meshlet_ranges,
+            .vertex_offset = record.vertex_offset,
+            .local_bounds =
+                Luminol::Graphics::BoundingBox{
+                    .min =
+                        Luminol::Maths::Vector3f{
+                            record.bounds_min[0],
+                            record.bounds_min[1],
+                            record.bounds_min[2]
+                        },
+                    .max =
+                        Luminol::Maths::Vector3f{
+                            record.bounds_max[0],
+                            record.bounds_max[1],
+                            record.bounds_max[2]
+                        },
+                },
+            .material = std::move(material),
+        });
+    }
+
+    return true;
+}
+
+// Whether first + count elements fit in a section of size elements, without
+// overflowing.
+auto range_in_bounds(uint64_t first, uint64_t count, std::size_t size)
+    -> bool {
+    return first <= size && count <= size - first;
+}
+
+// Everything the GPU indexes with values read from the file: each
+// submesh's LOD index ranges, meshlet ranges and vertex offset, and each
+// meshlet's slices of meshlet_vertices/meshlet_triangles (one packed word
+// per triangle, see pack_meshlet_triangle). An out-of-range value would
+// otherwise become an out-of-bounds draw or meshlet read.
+auto ranges_in_bounds(
+    const BakedMeshView& view, gsl::span<const BakedSubmesh> submeshes
+) -> bool {
+    if (view.vertices.size() % full_vertex_stride_in_floats != 0) {
+        return false;
+    }
+    const auto vertex_count =
+        view.vertices.size() / full_vertex_stride_in_floats;
+
+    for (const auto& submesh : submeshes) {
+        if (submesh.vertex_offset < 0 ||
+            static_cast<std::size_t>(submesh.vertex_offset) > vertex_count) {
+            return false;
+        }
+        for (const auto& lod_range : submesh.lod_ranges) {
+            if (!range_in_bounds(
+                    lod_range.first_index,
+                    lod_range.index_count,
+                    view.indices.size()
+                )) {
+                return false;
+            }
+        }
+        for (const auto& meshlet_range : submesh.meshlet_ranges) {
+            if (!range_in_bounds(
+                    meshlet_range.first_meshlet,
+                    meshlet_range.meshlet_count,
+                    view.meshlets.size()
+                )) {
+                return false;
+            }
+        }
+    }
+
+    for (const auto& meshlet : view.meshlets) {
+        if (!range_in_bounds(
+                meshlet.vertex_offset,
+                meshlet.vertex_count,
+                view.meshlet_vertices.size()
+            ) ||
+            !range_in_bounds(
+                meshlet.triangle_offset,
+                meshlet.triangle_count,
+                view.meshlet_triangles.size()
+            )) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// A temporary file name for cache_path that no other writer picks, even
+// one writing the same entry at the same time - a random per-process nonce
+// tells processes apart and a counter tells this process's writes apart.
+auto get_temporary_path(const std::filesystem::path& cache_path)
+    -> std::filesystem::path {
+    static const auto process_nonce = std::random_device{}();
+    static auto write_counter = std::atomic<uint64_t>{0};
+
+    auto temporary_path = cache_path;
+    temporary_path += "." + std::to_string(process_nonce) + "-" +
+        std::to_string(write_counter.fetch_add(1)) + ".tmp";
+    return temporary_path;
+}
+
+auto log_corrupt_entry(
+    const std::filesystem::path& cache_path, const char* reason
+) -> void {
+    SDL_Log(
+        "[MeshCache] discarding %s: %s", cache_path.string().c_str(), reason
+    );
+}
+
+template <typename T>
+auto typed_section(const std::byte* base, const SectionRecord& section)
+    -> gsl::span<const T> {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    return gsl::span<const T>{
+        reinterpret_cast<const T*>(base + section.offset),
+        static_cast<std::size_t>(section.size_bytes / sizeof(T)),
+    };
+}
+
+auto hash_file(uint64_t seed, const std::filesystem::path& path)
+    -> std::optional<uint64_t> {
+    const auto file = Luminol::Utilities::MappedFile::open(path);
+    if (!file.has_value()) {
+        return std::nullopt;
+    }
+    return hash_bytes(
+        seed, gsl::span<const std::byte>{file->data(), file->size()}
+    );
+}
+
+}  // namespace
+
+namespace Luminol::Graphics::SDL_GPU {
+
+auto BakedMesh::view() const -> BakedMeshView {
+    return BakedMeshView{
+        .vertices = vertices,
+        .indices = indices,
+        .meshlets = meshlets,
+        .meshlet_vertices = meshlet_vertices,
+        .meshlet_triangles = meshlet_triangles,
+        .submeshes = submeshes,
+    };
+}
+
+MeshCacheEntry::MeshCacheEntry(
+    Utilities::MappedFile file, BakedMeshView mapped_view
+)
+    : file{std::move(file)}, mapped_view{mapped_view} {}
+
+auto MeshCacheEntry::open(
+    const std::filesystem::path& cache_path,
+    uint64_t expected_key,
+    const std::filesystem::path& model_directory
+) -> std::optional<MeshCacheEntry> {
+    auto file = Utilities::MappedFile::open(cache_path);
+    if (!file.has_value() || file->size() < sizeof(MeshCacheHeader)) {
+        return std::nullopt;
+    }
+
+    auto header = MeshCacheHeader{};
+    std::memcpy(&header, file->data(), sizeof(MeshCacheHeader));
+
+    if (header.magic != cache_magic || header.version != mesh_cache_version ||
+        header.header_size != sizeof(MeshCacheHeader) ||
+        header.key != expected_key || header.file_size != file->size()) {
+        return std::nullopt;
+    }
+
+    const auto element_sizes =
+        std::array<uint64_t, static_cast<std::size_t>(Section::Count)>{
+            sizeof(float),
+            sizeof(uint32_t),
+            sizeof(GpuMeshletMetadata),
+            sizeof(uint32_t),
+            sizeof(uint32_t),
+            1,
+        };
+    for (auto i = std::size_t{0}; i < header.sections.size(); ++i) {
+        const auto& section = header.sections.at(i);
+        if (section.offset % section_alignment != 0 ||
+            section.offset < sizeof(MeshCacheHeader) ||
+            section.offset > header.file_size ||
+            section.size_bytes > header.file_size - section.offset ||
+            section.size_bytes % element_sizes.at(i) != 0) {
+            return std::nullopt;
+        }
+    }
+
+    const auto* const base = file->data();
+    if (hash_bytes(
+            mesh_cache_hash_seed,
+            gsl::span<const std::byte>{
+                base + sizeof(MeshCacheHeader),
+                static_cast<std::size_t>(
+                    header.file_size - sizeof(MeshCacheHeader)
+                )
+            }
+        ) != header.payload_hash) {
+        log_corrupt_entry(cache_path, "payload checksum mismatch");
+        return std::nullopt;
+    }
+
+    const auto& sections = header.sections;
+    const auto& submesh_section =
+        sections.at(section_index(Section::Submeshes));
+
+    auto submeshes = std::vector<BakedSubmesh>{};
+    if (!deserialize_submeshes(
+            gsl::span<const std::byte>{
+                base + submesh_section.offset,
+                static_cast<std::size_t>(submesh_section.size_bytes)
+            },
+            model_directory,
+            submeshes
+        )) {
+        return std::nullopt;
+    }
+
+    const auto mapped_view = BakedMeshView{
+        .vertices = typed_section<float>(
+            base, sections.at(section_index(Section::Vertices))
+        ),
+        .indices = typed_section<uint32_t>(
+            base, sections.at(section_index(Section::Indices))
+        ),
+        .meshlets = typed_section<GpuMeshletMetadata>(
+            base, sections.at(section_index(Section::Meshlets))
+        ),
+        .meshlet_vertices = typed_section<uint32_t>(
+            base, sections.at(section_index(Section::MeshletVertices))
+        ),
+        .meshlet_triangles = typed_section<uint32_t>(
+            base, sections.at(section_index(Section::MeshletTriangles))
+        ),
+        .submeshes = {},
+    };
+    if (!ranges_in_bounds(mapped_view, submeshes)) {
+        log_corrupt_entry(cache_path, "range out of bounds");
+        return std::nullopt;
+    }
+
+    auto entry = MeshCacheEntry{std::move(file).value(), mapped_view};
+    entry.submeshes = std::move(submeshes);
+    return entry;
+}
+
+auto MeshCacheEntry::view() const -> BakedMeshView {
+    auto result = mapped_view;
+    result.submeshes = submeshes;
+    return result;
+}
+
+auto get_mesh_cache_directory() -> std::filesystem::path {
+    return std::filesystem::path{"cache"} / "meshes";
+}
+
+auto get_mesh_cache_path(uint64_t key) -> std::filesystem::path {
+    constexpr auto hex_digits = std::string_view{"0123456789abcdef"};
+
+    auto file_name = std::string(16, '0');
+    for (auto i = std::size_t{0}; i < file_name.size(); ++i) {
+        const auto shift = (file_name.size() - 1 - i) * 4;
+        file_name[i] = hex_digits[(key >> shift) & 0xFU];
+    }
+
+    return get_mesh_cache_directory() / (file_name + ".lmesh");
+}
+
+auto hash_bytes(uint64_t seed, gsl::span<const std::byte> bytes) -> uint64_t {
+    constexpr auto fnv_prime = uint64_t{0x100000001B3};
+
+    auto hash = seed;
+    for (const auto byte : bytes) {
+        hash ^= static_cast<uint64_t>(byte);
+        hash *= fnv_prime;
+    }
+    return hash;
+}
+
+auto compute_mesh_cache_key(
+    const std::filesystem::path& model_path,
+    uint32_t import_flags,
+    uint64_t bake_settings_hash
+) -> std::optional<uint64_t> {
+    auto hash = hash_bytes(
+        mesh_cache_hash_seed, gsl::as_bytes(gsl::span{&mesh_cache_version, 1})
+    );
+    hash = hash_bytes(hash, gsl::as_bytes(gsl::span{&import_flags, 1}));
+    hash = hash_bytes(hash, gsl::as_bytes(gsl::span{&bake_settings_hash, 1}));
+
+    const auto model_hash = hash_file(hash, model_path);
+    if (!model_hash.has_value()) {
+        return std::nullopt;
+    }
+    hash = *model_hash;
+
+    // glTF keeps its geometry in an external .bin buffer and OBJ its
+    // materials (which decide the baked texture paths/alpha modes) in a
+    // .mtl - both conventionally share the model file's stem.
+    for (const auto* const extension : {".bin", ".mtl"}) {
+        auto sidecar_path = model_path;
+        sidecar_path.replace_extension(extension);
+
+        auto error = std::error_code{};
+        if (!std::filesystem::is_regular_file(sidecar_path, error)) {
+            continue;
+        }
+
+        const auto sidecar_hash = hash_file(hash, sidecar_path);
+        if (sidecar_hash.has_value()) {
+            hash = *sidecar_hash;
+        }
+    }
+
+    return hash;
+}
+
+auto write_mesh_cache(
+    const std::filesystem::path& cache_path,
+    uint64_t key,
+    const BakedMeshView& baked_mesh,
+    const std::filesystem::path& model_directory
+) -> bool {
+    const auto submesh_bytes =
+        serialize_submeshes(baked_mesh.submeshes, model_directory);
+
+    const auto payloads = SectionPayloads{
+        gsl::as_bytes(baked_mesh.vertices),
+        gsl::as_bytes(baked_mesh.indices),
+        gsl::as_bytes(baked_mesh.meshlets),
+        gsl::as_bytes(baked_mesh.meshlet_vertices),
+        gsl::as_bytes(baked_mesh.meshlet_triangles),
+        gsl::span<const std::byte>{submesh_bytes},
+    };
+
+    auto header = MeshCacheHeader{
+        .magic = cache_magic,
+        .version = mesh_cache_version,
+        .header_size = sizeof(MeshCacheHeader),
+        .key = key,
+        .file_size = 0,
+        .payload_hash = 0,
+        .sections = {},
+    };
+
+    auto running_offset = align_up(sizeof(MeshCacheHeader), section_alignment);
+    for (auto i = std::size_t{0}; i < payloads.size(); ++i) {
+        header.sections.at(i) = SectionRecord{
+            .offset = running_offset,
+            .size_bytes = payloads.at(i).size_bytes(),
+        };
+        running_offset = align_up(
+            running_offset + payloads.at(i).size_bytes(), section_alignment
+        );
+    }
+    header.file_size = running_offset;
+
+    header.payload_hash = mesh_cache_hash_seed;
+    emit_payload(header, payloads, [&header](gsl::span<const std::byte> bytes) {
+        header.payload_hash = hash_bytes(header.payload_hash, bytes);
+    });
+
+    auto error = std::error_code{};
+    std::filesystem::create_directories(cache_path.parent_path(), error);
+
+    const auto temporary_path = get_temporary_path(cache_path);
+
+    {
+        auto stream = std::ofstream{
+            temporary_path, std::ios::binary | std::ios::trunc
+        };
+        if (!stream) {
+            return false;
+        }
+
+        const auto write_bytes = [&stream](gsl::span<const std::byte> bytes) {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+            stream.write(
+                reinterpret_cast<const char*>(bytes.data()),
+                static_cast<std::streamsize>(bytes.size())
+            );
+        };
+
+        write_bytes(gsl::as_bytes(gsl::span{&header, 1}));
+        emit_payload(header, payloads, write_bytes);
+
+        if (!stream) {
+            stream.close();
+            std::filesystem::remove(temporary_path, error);
+            return false;
+        }
+    }
+
+    std::filesystem::rename(temporary_path, cache_path, error);
+    if (error) {
+        SDL_Log(
+            "[MeshCache] failed to store %s: %s",
+            cache_path.string().c_str(),
+            error.message().c_str()
+        );
+        std::filesystem::remove(temporary_path, error);
+        return false;
+    }
+
+    return true;
+}
+
+}  // namespace Luminol::Graphics::SDL_GPU
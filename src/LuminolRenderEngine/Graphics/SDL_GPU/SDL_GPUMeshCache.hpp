@@ -0,0 +1,199 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include <gsl/gsl>
+
+#include <LuminolRenderEngine/Graphics/BoundingBox.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUMesh.hpp>
+#include <LuminolRenderEngine/Utilities/ImageLoader.hpp>
+#include <LuminolRenderEngine/Utilities/MappedFile.hpp>
+#include <LuminolRenderEngine/Utilities/ModelLoader.hpp>
+
+namespace Luminol::Graphics::SDL_GPU {
+
+// Bump whenever the on-disk layout below OR anything load_meshes_from_model
+// bakes into it changes in a way the cache key doesn't already cover - the
+// key hashes the model's bytes, ModelLoader's import flags and the bake
+// settings, but not the code that interprets them (the assimp version,
+// ModelLoader's conversion of its output, vertex layout, meshlet packing,
+// LOD generation). Stale entries then simply stop matching, since the
+// version is folded into every cache key as well as checked in the file
+// header.
+inline constexpr auto mesh_cache_version = uint32_t{3};
+
+// The subset of a submesh's ModelLoader::MeshData that SDL_GPUMesh actually
+// consumes (only the first path of each material slot is ever used, see
+// to_texture_images in SDL_GPUMesh.cpp) - enough to rebuild the material on
+// a warm load without re-running assimp. Paths are stored relative to the
+// model's directory on disk and rebased on load, so the same source file
+// loaded via a different relative path still hits the same cache entry.
+struct BakedMaterial {
+    std::optional<std::filesystem::path> diffuse_texture_path;
+    Utilities::ModelLoader::TextureWrap diffuse_texture_wrap;
+    std::optional<std::filesystem::path> normal_texture_path;
+    Utilities::ModelLoader::TextureWrap normal_texture_wrap;
+    std::optional<std::filesystem::path> metallic_texture_path;
+    Utilities::ModelLoader::TextureWrap metallic_texture_wrap;
+    std::optional<std::filesystem::path> roughness_texture_path;
+    Utilities::ModelLoader::TextureWrap roughness_texture_wrap;
+    std::optional<std::filesystem::path> ambient_occlusion_texture_path;
+    Utilities::ModelLoader::TextureWrap ambient_occlusion_texture_wrap;
+    Utilities::ModelLoader::AlphaMode alpha_mode =
+        Utilities::ModelLoader::AlphaMode::Opaque;
+};
+
+// One submesh's SDL_GPUMesh constructor arguments, minus the GPU objects.
+struct BakedSubmesh {
+    std::array<LodRange, max_lod_levels> lod_ranges;
+    std::array<MeshletRange, max_lod_levels> meshlet_ranges;
+    int32_t vertex_offset;
+    BoundingBox local_bounds;
+    BakedMaterial material;
+};
+
+// Non-owning view over a renderable's final, upload-ready arrays - exactly
+// what load_meshes_from_model hands to create_uploaded_buffer, whether they
+// were just produced by assimp + meshoptimizer (BakedMesh) or are pointing
+// straight into a memory-mapped cache file (MeshCacheEntry).
+struct BakedMeshView {
+    gsl::span<const float> vertices;
+    gsl::span<const uint32_t> indices;
+    gsl::span<const GpuMeshletMetadata> meshlets;
+    gsl::span<const uint32_t> meshlet_vertices;
+    gsl::span<const uint32_t> meshlet_triangles;
+    gsl::span<const BakedSubmesh> submeshes;
+};
+
+struct BakedMesh {
+    std::vector<float> vertices;
+    std::vector<uint32_t> indices;
+    std::vector<GpuMeshletMetadata> meshlets;
+    std::vector<uint32_t> meshlet_vertices;
+    std::vector<uint32_t> meshlet_triangles;
+    std::vector<BakedSubmesh> submeshes;
+
+    [[nodiscard]] auto view() const -> BakedMeshView;
+};
+
+// The cold-load half of load_meshes_from_model: interleaves, optimizes,
+// LOD-simplifies and meshletizes every submesh of model_data into one
+// renderable-wide BakedMesh. Submeshes are baked on worker_count threads
+// (0 = one per hardware thread, 1 = serially on the caller) and merged in
+// submesh order, so the result - and therefore the cache entry written from
+// it - is byte-identical for every worker count.
+[[nodiscard]] auto bake_model(
+    const Utilities::ModelLoader::ModelData& model_data,
+    uint32_t worker_count = 0
+) -> BakedMesh;
+
+// A validated, memory-mapped cache file. The large arrays in view() alias
+// the mapping directly (no copy) and stay valid for this object's lifetime;
+// only the small per-submesh table is decoded into owned memory.
+class MeshCacheEntry {
+public:
+    // std::nullopt on a missing file, a version/key mismatch, a payload
+    // checksum mismatch, any truncated/inconsistent section, or an index,
+    // meshlet or vertex range reaching past its section - callers treat all
+    // of these as a cache miss and rebake. model_directory rebases the
+    // stored relative texture paths (see BakedMaterial).
+    [[nodiscard]] static auto open(
+        const std::filesystem::path& cache_path,
+        uint64_t expected_key,
+        const std::filesystem::path& model_directory
+    ) -> std::optional<MeshCacheEntry>;
+
+    [[nodiscard]] auto view() const -> BakedMeshView;
+
+private:
+    MeshCacheEntry(Utilities::MappedFile file, BakedMeshView mapped_view);
+
+    Utilities::MappedFile file;
+    BakedMeshView mapped_view;
+    std::vector<BakedSubmesh> submeshes;
+};
+
+// Everything load_meshes_from_model needs from disk, fully decoded but not
+// yet touching the GPU: either a memory-mapped cache entry (warm) or a
+// freshly baked mesh (cold), plus the decoded material images. Produced by
+// prepare_model, which never calls into SDL_GPU and so is safe to run on a
+// background thread (see SDL_GPUAsyncModelLoader); consumed by
+// upload_prepared_model on the thread that owns the GPUDevice.
+struct PreparedModel {
+    std::optional<MeshCacheEntry> cache_entry;
+    BakedMesh baked_mesh;
+    std::unordered_map<std::filesystem::path, Utilities::ImageLoader::Image>
+        textures_map;
+
+    [[nodiscard]] auto view() const -> BakedMeshView;
+
+    // Bytes upload_prepared_model will copy into transfer buffers - what
+    // SDL_GPUFactory::upload_completed_models charges against its per-frame
+    // budget. Excludes mip generation, which happens GPU-side.
+    [[nodiscard]] auto get_upload_size_bytes() const -> uint64_t;
+};
+
+// The CPU half of load_meshes_from_model: mesh cache lookup, or assimp +
+// bake_model + cache write on a miss, and texture decoding. std::nullopt if
+// the model can't be loaded.
+[[nodiscard]] auto prepare_model(
+    const std::filesystem::path& model_path,
+    const Utilities::ModelLoader::LoadOptions& options = {}
+) -> std::optional<PreparedModel>;
+
+// The GPU half of load_meshes_from_model: creates and uploads every buffer
+// and any texture texture_cache doesn't already hold in one submitted
+// command buffer, encoding the vertices into vertex_format on the way.
+[[nodiscard]] auto upload_prepared_model(
+    GPUDevice& device,
+    SDL_GPUTextureCache& texture_cache,
+    const PreparedModel& model,
+    VertexFormat vertex_format = VertexFormat::Full
+) -> RenderableMeshes;
+
+// Where cache files live, relative to the working directory (the build
+// directory for the tests/demos - same convention as the res/ paths).
+[[nodiscard]] auto get_mesh_cache_directory() -> std::filesystem::path;
+
+// Content-addressed path for key inside get_mesh_cache_directory().
+[[nodiscard]] auto get_mesh_cache_path(uint64_t key) -> std::filesystem::path;
+
+// Cache key = FNV-1a over mesh_cache_version, import_flags (the assimp
+// post-process steps the model is imported with, see
+// ModelLoader::get_import_flags), bake_settings_hash (whatever
+// load_meshes_from_model's LOD/meshlet/optimizer settings hash to) and the
+// bytes of the model file plus its same-stem geometry sidecars (.bin for
+// glTF, .mtl for OBJ). Texture files aren't hashed - they aren't baked, only
+// referenced by path and decoded on every load anyway. std::nullopt if the
+// model file can't be read.
+[[nodiscard]] auto compute_mesh_cache_key(
+    const std::filesystem::path& model_path,
+    uint32_t import_flags,
+    uint64_t bake_settings_hash
+) -> std::optional<uint64_t>;
+
+// Writes to a uniquely named temporary file and renames it into place, so a
+// crash or a concurrent loader never observes a half-written entry, and
+// concurrent writers of the same entry never share a temporary file.
+// Returns false (and leaves no file behind) on any I/O failure - the cache
+// is an optimization, so callers just carry on with the freshly baked data.
+auto write_mesh_cache(
+    const std::filesystem::path& cache_path,
+    uint64_t key,
+    const BakedMeshView& baked_mesh,
+    const std::filesystem::path& model_directory
+) -> bool;
+
+// FNV-1a 64-bit over bytes, continuing from seed - exposed so callers can
+// fold their own settings into a bake_settings_hash with the same function.
+[[nodiscard]] auto hash_bytes(uint64_t seed, gsl::span<const std::byte> bytes)
+    -> uint64_t;
+
+inline constexpr auto mesh_cache_hash_seed = uint64_t{0xCBF29CE484222325};
+
+}  // namespace Luminol::Graphics::SDL_GPU
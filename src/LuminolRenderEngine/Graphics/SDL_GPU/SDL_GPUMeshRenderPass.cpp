@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <array>
+#include <memory_resource>
 #include <optional>
 #include <vector>
 
@@ -18,44 +19,6 @@ namespace {
 
 using namespace Luminol::Graphics::SDL_GPU;
 
-constexpr auto vertex_stride_in_floats = 11U;
-constexpr auto vertex_stride_in_bytes =
-    sizeof(float) * vertex_stride_in_floats;
-
-constexpr auto mesh_vertex_buffer_descriptions = std::array{
-    VertexBufferDescription{
-        .slot = 0,
-        .pitch = vertex_stride_in_bytes,
-    },
-};
-
-constexpr auto mesh_vertex_attributes = std::array{
-    VertexAttribute{
-        .location = 0,
-        .buffer_slot = 0,
-        .format = VertexElementFormat::Float3,
-        .offset = 0,
-    },
-    VertexAttribute{
-        .location = 1,
-        .buffer_slot = 0,
-        .format = VertexElementFormat::Float2,
-        .offset = sizeof(float) * 3,
-    },
-    VertexAttribute{
-        .location = 2,
-        .buffer_slot = 0,
-        .format = VertexElementFormat::Float3,
-        .offset = sizeof(float) * 5,
-    },
-    VertexAttribute{
-        .location = 3,
-        .buffer_slot = 0,
-        .format = VertexElementFormat::Float3,
-        .offset = sizeof(float) * 8,
-    },
-};
-
 constexpr auto depth_texture_format = TextureFormat::D24_Unorm;
 constexpr auto hdr_color_texture_format = TextureFormat::R16G16B16A16_Float;
 
@@ -76,25 +39,33 @@ constexpr auto ssr_sampler_slot = 12U;
 constexpr auto cluster_light_buffer_count = 4U;
 constexpr auto cluster_light_buffer_slot = 0U;
 
-// Spot shadow-matrix buffer (t17, space2), the fifth and last fragment
-// storage buffer.
+// Spot shadow-matrix buffer (t17, space2), the fifth fragment storage
+// buffer.
 constexpr auto spot_shadow_matrix_buffer_slot = cluster_light_buffer_count;
-constexpr auto fragment_storage_buffer_count = cluster_light_buffer_count + 1U;
-
-auto make_mesh_shader(
-    GPUDevice& device, const std::filesystem::path& path, ShaderStage stage
-) -> Shader {
-    return device.create_shader(ShaderInfo{
-        .path = path,
-        .stage = stage,
-        .source_language = ShaderSourceLanguage::Hlsl,
-        .sampler_count =
-            (stage == ShaderStage::Fragment) ? fragment_sampler_count : 0U,
-        .uniform_buffer_count = 1U,
-        .storage_buffer_count = stage == ShaderStage::Vertex ? 2U
-            : stage == ShaderStage::Fragment  ? fragment_storage_buffer_count
-                                               : 0U,
-    });
+
+// Z-binned light culling buffers (t18-t20, space2) - see
+// SDL_GPUZBinPass. Bound in either culling mode, since the shader declares
+// them regardless.
+constexpr auto z_bin_light_buffer_count = 3U;
+constexpr auto z_bin_light_buffer_slot = spot_shadow_matrix_buffer_slot + 1U;
+constexpr auto fragment_storage_buffer_count =
+    z_bin_light_buffer_slot + z_bin_light_buffer_count;
+
+constexpr auto mesh_fragment_shader_path = "res/shaders/sdl_gpu/pbr_frag.hlsl";
+constexpr auto mesh_alpha_test_fragment_shader_path =
+    "res/shaders/sdl_gpu/pbr_frag_alpha_test.hlsl";
+
+// pbr_frag.hlsl and its alpha-tested variant - the vertex half is the
+// shared get_mesh_vertex_shader_info.
+auto get_mesh_fragment_shader_info(const std::filesystem::path& path)
+    -> ShaderInfo {
+    return make_hlsl_shader_info(
+        path,
+        ShaderStage::Fragment,
+        fragment_sampler_count,
+        1U,
+        fragment_storage_buffer_count
+    );
 }
 
 // pbr_vert_meshlet.hlsl's vertex storage buffer count (instance_models,
@@ -103,15 +74,17 @@ auto make_mesh_shader(
 // comment for why this differs from mesh_vertex_shader's fixed 2.
 constexpr auto mesh_meshlet_vertex_storage_buffer_count = 6U;
 
-auto make_mesh_meshlet_vertex_shader(GPUDevice& device) -> Shader {
-    return device.create_shader(ShaderInfo{
+auto get_mesh_meshlet_vertex_shader_info(VertexFormat vertex_format)
+    -> ShaderInfo {
+    return ShaderInfo{
         .path = "res/shaders/sdl_gpu/pbr_vert_meshlet.hlsl",
         .stage = ShaderStage::Vertex,
         .source_language = ShaderSourceLanguage::Hlsl,
         .sampler_count = 0U,
-        .uniform_buffer_count = 1U,
+        .uniform_buffer_count = mesh_vertex_uniform_buffer_count,
         .storage_buffer_count = mesh_meshlet_vertex_storage_buffer_count,
-    });
+        .defines = get_vertex_format_shader_defines(vertex_format),
+    };
 }
 
 // Mirrors cbuffer UBO in pbr_vert.hlsl.
@@ -123,6 +96,7 @@ struct TransparentDrawItem {
     Luminol::Graphics::RenderableId renderable_id;
     const SDL_GPUMesh* mesh;
     uint32_t instance_count;
+    uint32_t first_instance;
     float distance_squared;
 };
 
@@ -151,6 +125,23 @@ auto batch_distance_squared_to_camera(
     return (diff_x * diff_x) + (diff_y * diff_y) + (diff_z * diff_z);
 }
 
+// Same, for a mapped batch (SDL_GPURenderer::map_instances), whose transforms
+// never reach the CPU: the center of the bounds the caller gave instead of
+// the average translation.
+auto bounds_distance_squared_to_camera(
+    const Luminol::Graphics::BoundingBox& world_bounds,
+    const Luminol::Maths::Vector4f& camera_position
+) -> float {
+    const auto diff_x = ((world_bounds.min.x() + world_bounds.max.x()) / 2.0F) -
+        camera_position.x();
+    const auto diff_y = ((world_bounds.min.y() + world_bounds.max.y()) / 2.0F) -
+        camera_position.y();
+    const auto diff_z = ((world_bounds.min.z() + world_bounds.max.z()) / 2.0F) -
+        camera_position.z();
+
+    return (diff_x * diff_x) + (diff_y * diff_y) + (diff_z * diff_z);
+}
+
 // Blended, depth-tested-but-not-depth-written variant of the mesh pipeline
 // for transparent meshes. Culling is disabled so both faces of thin
 // transparent geometry (e.g. glass panes, foliage cards) are visible.
@@ -158,15 +149,17 @@ auto make_mesh_transparent_pipeline(
     GPUDevice& device,
     const Shader& vertex_shader,
     const Shader& fragment_shader,
-    SampleCount sample_count
+    SampleCount sample_count,
+    VertexFormat vertex_format
 ) -> GraphicsPipeline {
     return device.create_graphics_pipeline(GraphicsPipelineInfo{
         .vertex_shader = vertex_shader,
         .fragment_shader = fragment_shader,
         .color_target_format = hdr_color_texture_format,
         .primitive_type = PrimitiveType::TriangleList,
-        .vertex_buffer_descriptions = mesh_vertex_buffer_descriptions,
-        .vertex_attributes = mesh_vertex_attributes,
+        .vertex_buffer_descriptions =
+            get_mesh_vertex_buffer_descriptions(vertex_format),
+        .vertex_attributes = get_mesh_vertex_attributes(vertex_format),
         .enable_depth_test = true,
         .enable_depth_write = false,
         .depth_stencil_format = depth_texture_format,
@@ -239,29 +232,30 @@ auto make_mesh_alpha_test_meshlet_pipeline(
 namespace Luminol::Graphics::SDL_GPU {
 
 SDL_GPUMeshRenderPass::SDL_GPUMeshRenderPass(
-    GPUDevice& device, SampleCount sample_count
+    GPUDevice& device, SampleCount sample_count, VertexFormat vertex_format
 )
-    : mesh_vertex_shader{make_mesh_shader(
-          device, "res/shaders/sdl_gpu/pbr_vert.hlsl", ShaderStage::Vertex
-      )},
-      mesh_vertex_meshlet_shader{make_mesh_meshlet_vertex_shader(device)},
-      mesh_fragment_shader{make_mesh_shader(
-          device, "res/shaders/sdl_gpu/pbr_frag.hlsl", ShaderStage::Fragment
+    : mesh_vertex_shader{
+          device.create_shader(get_mesh_vertex_shader_info(vertex_format))
+      },
+      mesh_vertex_meshlet_shader{device.create_shader(
+          get_mesh_meshlet_vertex_shader_info(vertex_format)
       )},
-      mesh_alpha_test_fragment_shader{make_mesh_shader(
-          device, "res/shaders/sdl_gpu/pbr_frag_alpha_test.hlsl",
-          ShaderStage::Fragment
+      mesh_fragment_shader{device.create_shader(
+          get_mesh_fragment_shader_info(mesh_fragment_shader_path)
       )},
-      depth_prepass_fragment_shader{make_hlsl_shader(
-          device, "res/shaders/sdl_gpu/shadow_depth_frag.hlsl",
-          ShaderStage::Fragment
+      mesh_alpha_test_fragment_shader{device.create_shader(
+          get_mesh_fragment_shader_info(mesh_alpha_test_fragment_shader_path)
       )},
+      depth_prepass_fragment_shader{
+          device.create_shader(get_depth_only_fragment_shader_info())
+      },
       mesh_transparent_pipeline{make_mesh_transparent_pipeline(
-          device, mesh_vertex_shader, mesh_fragment_shader, sample_count
+          device, mesh_vertex_shader, mesh_fragment_shader, sample_count,
+          vertex_format
       )},
       depth_prepass_pipeline{make_depth_only_mesh_pipeline(
           device, mesh_vertex_shader, depth_prepass_fragment_shader,
-          depth_texture_format, sample_count
+          depth_texture_format, vertex_format, sample_count
       )},
       mesh_meshlet_pipeline{make_mesh_meshlet_pipeline(
           device, mesh_vertex_meshlet_shader, mesh_fragment_shader,
@@ -272,37 +266,103 @@ SDL_GPUMeshRenderPass::SDL_GPUMeshRenderPass(
           sample_count
       )} {}
 
+auto SDL_GPUMeshRenderPass::get_shader_compile_requests(
+    VertexFormat vertex_format
+) -> ShaderCompileRequests {
+    return ShaderCompileRequests{
+        .shaders =
+            {
+                get_mesh_vertex_shader_info(vertex_format),
+                get_mesh_meshlet_vertex_shader_info(vertex_format),
+                get_mesh_fragment_shader_info(mesh_fragment_shader_path),
+                get_mesh_fragment_shader_info(
+                    mesh_alpha_test_fragment_shader_path
+                ),
+                get_depth_only_fragment_shader_info(),
+            },
+        .compute_pipelines = {},
+    };
+}
+
 auto SDL_GPUMeshRenderPass::get_instance_buffer_cache() const
     -> const SDL_GPUInstanceBufferCache& {
     return instance_buffer_cache;
 }
 
+auto SDL_GPUMeshRenderPass::map_instances(
+    StagingRing& staging_ring,
+    RenderableId renderable_id,
+    uint32_t instance_count
+) -> gsl::span<InstanceTransform> {
+    return instance_buffer_cache.map_instances(
+        staging_ring, renderable_id, instance_count
+    );
+}
+
+auto SDL_GPUMeshRenderPass::discard_mapped_instances() -> void {
+    instance_buffer_cache.discard_mapped_instances();
+}
+
 auto SDL_GPUMeshRenderPass::upload_instances(
-    GPUDevice& device, CopyPass& copy_pass, const QueuedDraws& queued_draws
-) -> std::vector<InstanceBatch> {
-    auto instance_batches = std::vector<InstanceBatch>{};
-    instance_batches.reserve(queued_draws.model_matrices.size());
+    const SDL_GPUFactory& graphics_factory,
+    GPUDevice& device,
+    CopyPass& copy_pass,
+    StagingRing& staging_ring,
+    const QueuedDraws& queued_draws,
+    std::pmr::memory_resource& frame_memory,
+    Utilities::JobSystem* job_system
+) -> std::pmr::vector<InstanceBatch> {
+    instance_buffer_cache.upload_frame_instances(
+        device, copy_pass, staging_ring, queued_draws.frame_model_matrices,
+        queued_draws.frame_ranges, job_system
+    );
 
-    for (auto renderable_id = RenderableId{0};
-         renderable_id < queued_draws.model_matrices.size(); ++renderable_id) {
-        if (queued_draws.registered[renderable_id] == 0) {
-            continue;
+    if (queued_draws.static_instances_dirty) {
+        auto static_uploads = std::pmr::vector<InstanceUpload>{&frame_memory};
+        for (auto renderable_id = RenderableId{0};
+             renderable_id < queued_draws.is_static.size(); ++renderable_id) {
+            if (queued_draws.is_static[renderable_id] == 0 ||
+                !graphics_factory.is_resident(renderable_id)) {
+                continue;
+            }
+
+            static_uploads.push_back(InstanceUpload{
+                .renderable_id = renderable_id,
+                .model_matrices =
+                    queued_draws.static_model_matrices[renderable_id],
+            });
         }
 
-        const auto& model_matrices = queued_draws.model_matrices[renderable_id];
-        const auto is_static = queued_draws.is_static[renderable_id] != 0;
-        const auto needs_gpu_upload =
-            !is_static || queued_draws.pending_static_upload[renderable_id] != 0;
+        instance_buffer_cache.upload_static_instances(
+            device, copy_pass, staging_ring, static_uploads, job_system
+        );
+    }
 
-        if (needs_gpu_upload) {
-            instance_buffer_cache.upload(
-                device, copy_pass, renderable_id, model_matrices
-            );
+    instance_buffer_cache.upload_retained_instances(
+        device, copy_pass, staging_ring, queued_draws.retained_instances,
+        job_system
+    );
+    instance_buffer_cache.upload_mapped_instances(
+        device, copy_pass, staging_ring
+    );
+
+    auto instance_batches = std::pmr::vector<InstanceBatch>{&frame_memory};
+    instance_batches.reserve(queued_draws.frame_runs.size());
+
+    for (auto renderable_id = RenderableId{0};
+         renderable_id < queued_draws.is_static.size(); ++renderable_id) {
+        const auto instance_count =
+            get_instance_count(queued_draws, renderable_id);
+        if (instance_count == 0 ||
+            !graphics_factory.is_resident(renderable_id)) {
+            continue;
         }
 
         instance_batches.push_back(InstanceBatch{
             .renderable_id = renderable_id,
-            .instance_count = static_cast<uint32_t>(model_matrices.size()),
+            .instance_count = instance_count,
+            .first_instance =
+                instance_buffer_cache.get_first_instance(renderable_id),
         });
     }
 
@@ -366,6 +426,10 @@ auto SDL_GPUMeshRenderPass::draw_depth_prepass(
             graphics_factory.get_index_buffer(batch.renderable_id),
             IndexElementSize::Bits32, 0
         );
+        push_vertex_dequantization(
+            command_buffer,
+            graphics_factory.get_vertex_dequantization(batch.renderable_id)
+        );
 
         for (auto mesh_index = std::size_t{0}; mesh_index < meshes.size();
              ++mesh_index) {
@@ -400,6 +464,7 @@ auto SDL_GPUMeshRenderPass::draw(
     RenderPass& render_pass,
     gsl::span<const InstanceBatch> instance_batches,
     const QueuedDraws& queued_draws,
+    const BatchMeshBounds& batch_mesh_world_bounds,
     const Maths::Matrix4x4f& view_proj,
     const std::array<Maths::Vector4f, 6>& camera_frustum_planes,
     const Buffer& meshlet_indirect_command_buffer,
@@ -414,7 +479,8 @@ auto SDL_GPUMeshRenderPass::draw(
     const ClusteredLightBuffers& clustered_light_buffers,
     const PointSpotShadowTextures& point_spot_shadow_textures,
     const Texture& ssr_texture,
-    const Sampler& ssr_sampler
+    const Sampler& ssr_sampler,
+    std::pmr::memory_resource& frame_memory
 ) -> void {
     auto adjusted_light_data = light_data;
     adjusted_light_data.shadow_params.z() =
@@ -503,6 +569,16 @@ auto SDL_GPUMeshRenderPass::draw(
         spot_shadow_matrix_buffer_slot, spot_shadow_matrix_buffer_bindings
     );
 
+    const auto z_bin_light_buffer_bindings =
+        std::array<const Buffer* const, z_bin_light_buffer_count>{
+            clustered_light_buffers.light_z_bins,
+            clustered_light_buffers.light_tile_masks,
+            clustered_light_buffers.depth_sorted_lights,
+        };
+    render_pass.bind_fragment_storage_buffers(
+        z_bin_light_buffer_slot, z_bin_light_buffer_bindings
+    );
+
     // Each submesh is drawn indirectly with a GPU-culled, per-instance-per-
     // meshlet-compacted num_instances (see SDL_GPUMeshletCullPass) - one
     // non-indexed indirect draw call per (submesh, LOD), since each needs its
@@ -542,6 +618,12 @@ auto SDL_GPUMeshRenderPass::draw(
                 render_pass.bind_vertex_storage_buffers(
                     0, storage_buffer_bindings
                 );
+                push_vertex_dequantization(
+                    command_buffer,
+                    graphics_factory.get_vertex_dequantization(
+                        batch.renderable_id
+                    )
+                );
 
                 for (auto mesh_index = std::size_t{0};
                      mesh_index < meshes.size(); ++mesh_index) {
@@ -579,7 +661,8 @@ auto SDL_GPUMeshRenderPass::draw(
     render_pass.bind_graphics_pipeline(mesh_alpha_test_meshlet_pipeline);
     draw_meshlet_batches_matching(Utilities::ModelLoader::AlphaMode::Mask);
 
-    auto transparent_items = std::vector<TransparentDrawItem>{};
+    auto transparent_items =
+        std::pmr::vector<TransparentDrawItem>{&frame_memory};
 
     for (auto batch_index = std::size_t{0}; batch_index < instance_batches.size();
          ++batch_index) {
@@ -596,18 +679,26 @@ auto SDL_GPUMeshRenderPass::draw(
             continue;
         }
 
-        const auto& model_matrices =
-            queued_draws.model_matrices[batch.renderable_id];
-        const auto distance_squared = batch_distance_squared_to_camera(
-            model_matrices, light_data.view_position
-        );
+        const auto mapped_world_bounds =
+            get_mapped_world_bounds(queued_draws, batch.renderable_id);
+        const auto distance_squared = mapped_world_bounds.has_value()
+            ? bounds_distance_squared_to_camera(
+                  *mapped_world_bounds, light_data.view_position
+              )
+            : batch_distance_squared_to_camera(
+                  get_model_matrices(queued_draws, batch.renderable_id),
+                  light_data.view_position
+              );
 
-        for (const auto& mesh : meshes) {
+        for (auto mesh_index = std::size_t{0}; mesh_index < meshes.size();
+             ++mesh_index) {
+            const auto& mesh = meshes[mesh_index];
             if (mesh.alpha_mode() != Utilities::ModelLoader::AlphaMode::Blend) {
                 continue;
             }
 
-            const auto bounds = compute_mesh_world_bounds(mesh, model_matrices);
+            const auto& bounds =
+                batch_mesh_world_bounds[batch_index][mesh_index];
             if (!aabb_in_frustum(camera_frustum_planes, bounds.min, bounds.max)) {
                 continue;
             }
@@ -616,6 +707,7 @@ auto SDL_GPUMeshRenderPass::draw(
                 .renderable_id = batch.renderable_id,
                 .mesh = &mesh,
                 .instance_count = batch.instance_count,
+                .first_instance = batch.first_instance,
                 .distance_squared = distance_squared,
             });
         }
@@ -638,7 +730,7 @@ auto SDL_GPUMeshRenderPass::draw(
 
     // Transparent items are drawn individually in sorted order (not
     // GPU-culled/compacted - see the comment above draw_batches_matching),
-    // so each covers the full 0..instance_count-1 range: bind the identity
+    // so each covers its renderable's full arena range: bind the identity
     // indices buffer to make pbr_vert.hlsl's visible_instance_indices
     // indirection a no-op.
     const auto identity_vertex_ubo = VertexUBO{
@@ -674,12 +766,17 @@ auto SDL_GPUMeshRenderPass::draw(
                 graphics_factory.get_index_buffer(item.renderable_id),
                 IndexElementSize::Bits32, 0
             );
+            push_vertex_dequantization(
+                command_buffer,
+                graphics_factory.get_vertex_dequantization(item.renderable_id)
+            );
 
             bound_renderable_id = item.renderable_id;
         }
 
         item.mesh->draw_instanced(
-            static_cast<int32_t>(item.instance_count), render_pass
+            static_cast<int32_t>(item.instance_count), render_pass,
+            item.first_instance
         );
     }
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <memory_resource>
 #include <vector>
 
 #include <gsl/gsl>
@@ -12,14 +13,17 @@
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUGraphicsPipeline.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUInstanceBatch.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUInstanceBufferCache.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/Culling/SDL_GPUCullingUtils.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/Culling/SDL_GPUInstanceCullPass.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/Culling/SDL_GPUMeshletCullPass.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUShader.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUTexture.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUVertexFormat.hpp>
 
 namespace Luminol::Graphics::SDL_GPU {
 
 class GPUDevice;
+struct ShaderCompileRequests;
 class CopyPass;
 class CommandBuffer;
 class RenderPass;
@@ -46,7 +50,8 @@ struct LightData {
     // z: max prefiltered specular mip level (see SDL_GPUIBLRenderPass)
     Maths::Vector4f shadow_params;
     // x: camera near plane, y: camera far plane (for view-space depth
-    // reconstruction when computing the cluster index), z/w: unused.
+    // reconstruction when computing the cluster index), z: LightCullingMode,
+    // w: light tile mask words per tile (ZBinned only).
     Maths::Vector4f cluster_params;
     std::array<Maths::Matrix4x4f, shadow_pass_num_cascades>
         cascade_light_space_matrices;
@@ -68,6 +73,11 @@ struct ClusteredLightBuffers {
     const Buffer* spot_lights;
     const Buffer* cluster_light_grid;
     const Buffer* global_light_index_list;
+    // SDL_GPUZBinPass's buffers, read instead of the two above in
+    // LightCullingMode::ZBinned.
+    const Buffer* light_z_bins;
+    const Buffer* light_tile_masks;
+    const Buffer* depth_sorted_lights;
 };
 
 // Bundles the precomputed split-sum IBL textures/samplers produced by
@@ -102,24 +112,45 @@ struct PointSpotShadowTextures {
 // SDL_GPURenderer just coordinates passes.
 class SDL_GPUMeshRenderPass {
 public:
-    SDL_GPUMeshRenderPass(GPUDevice& device, SampleCount sample_count);
-
-    // queued_draws.is_static/pending_static_upload: renderable ids registered
-    // as static (see SDL_GPURenderer::queue_draw_instanced_static) and, of
-    // those, the subset that actually need a GPU (re-)upload this frame. A
-    // registered renderable id with is_static set but pending_static_upload
-    // clear reuses its previously uploaded instance buffer instead of
-    // re-uploading unchanged data.
+    // vertex_format: SDL_GPUFactory::get_vertex_format - selects the vertex
+    // layout and shader variant of every mesh pipeline here.
+    SDL_GPUMeshRenderPass(
+        GPUDevice& device, SampleCount sample_count, VertexFormat vertex_format
+    );
+
+    [[nodiscard]] static auto get_shader_compile_requests(
+        VertexFormat vertex_format
+    ) -> ShaderCompileRequests;
+
+    // Uploads queued_draws' frame arena (every dynamic instance, grouped by
+    // group_frame_instances()) as one transfer, and rebuilds the static
+    // arena only when queued_draws.static_instances_dirty is set - otherwise
+    // static renderables reuse their previously uploaded range instead of
+    // re-uploading unchanged data - and uploads just the retained instances
+    // written since the last frame. Returns one batch per resident renderable
+    // with instances this frame; ids that aren't resident in
+    // graphics_factory (an async load still in flight) are skipped entirely.
+    // The batches are allocated from frame_memory. job_system, if given,
+    // splits the copy into the mapped transfer buffers across its threads -
+    // see SDL_GPUInstanceBufferCache::upload_frame_instances.
     [[nodiscard]] auto upload_instances(
-        GPUDevice& device, CopyPass& copy_pass, const QueuedDraws& queued_draws
-    ) -> std::vector<InstanceBatch>;
+        const SDL_GPUFactory& graphics_factory,
+        GPUDevice& device,
+        CopyPass& copy_pass,
+        StagingRing& staging_ring,
+        const QueuedDraws& queued_draws,
+        std::pmr::memory_resource& frame_memory,
+        Utilities::JobSystem* job_system = nullptr
+    ) -> std::pmr::vector<InstanceBatch>;
 
+    // Transparent draws are sorted in a list allocated from frame_memory.
     auto draw(
         const SDL_GPUFactory& graphics_factory,
         CommandBuffer& command_buffer,
         RenderPass& render_pass,
         gsl::span<const InstanceBatch> instance_batches,
         const QueuedDraws& queued_draws,
+        const BatchMeshBounds& batch_mesh_world_bounds,
         const Maths::Matrix4x4f& view_proj,
         const std::array<Maths::Vector4f, 6>& camera_frustum_planes,
         const Buffer& meshlet_indirect_command_buffer,
@@ -134,7 +165,8 @@ public:
         const ClusteredLightBuffers& clustered_light_buffers,
         const PointSpotShadowTextures& point_spot_shadow_textures,
         const Texture& ssr_texture,
-        const Sampler& ssr_sampler
+        const Sampler& ssr_sampler,
+        std::pmr::memory_resource& frame_memory
     ) -> void;
 
     // Depth-only pre-pass for Opaque submeshes only, run before draw() so the
@@ -156,6 +188,19 @@ public:
         const Texture& msaa_depth_texture
     ) -> void;
 
+    // This frame's mapped staging for renderable_id - see
+    // SDL_GPUInstanceBufferCache::map_instances. upload_instances() uploads
+    // it.
+    [[nodiscard]] auto map_instances(
+        StagingRing& staging_ring,
+        RenderableId renderable_id,
+        uint32_t instance_count
+    ) -> gsl::span<InstanceTransform>;
+
+    // Drops this frame's map_instances() allocations for a frame that never
+    // reaches upload_instances().
+    auto discard_mapped_instances() -> void;
+
     [[nodiscard]] auto get_instance_buffer_cache() const
         -> const SDL_GPUInstanceBufferCache&;
 
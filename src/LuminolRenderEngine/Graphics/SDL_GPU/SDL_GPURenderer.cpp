@@ -4,6 +4,9 @@
 #include <array>
 #include <cassert>
 #include <cmath>
+#include <condition_variable>
+#include <memory_resource>
+#include <mutex>
 #include <numbers>
 #include <utility>
 
@@ -196,6 +199,80 @@ auto clamp_supported_sample_count(const GPUDevice& device, SampleCount requested
     return SampleCount::x1;
 }
 
+auto get_hiz_debug_fragment_shader_info() -> ShaderInfo {
+    return make_hlsl_shader_info(
+        "res/shaders/sdl_gpu/hiz_debug_visualize_frag.hlsl",
+        ShaderStage::Fragment,
+        1U,
+        1U
+    );
+}
+
+// Compiles every shader and compute pipeline the renderer's passes create
+// in parallel, before any pass is constructed, so each pass constructor
+// only has to create SDL objects from ready SPIR-V instead of running DXC
+// one shader at a time (see GPUDevice::precompile_shaders). Takes and
+// returns gpu_device so it can run from SDL_GPURenderer's member
+// initializer list, right before the first pass.
+auto precompile_renderer_shaders(
+    std::shared_ptr<GPUDevice> gpu_device, VertexFormat vertex_format
+) -> std::shared_ptr<GPUDevice> {
+    auto requests = ShaderCompileRequests{};
+    append_shader_compile_requests(
+        requests,
+        SDL_GPUMeshRenderPass::get_shader_compile_requests(vertex_format)
+    );
+    append_shader_compile_requests(
+        requests,
+        SDL_GPUAmbientOcclusionPass::get_shader_compile_requests(vertex_format)
+    );
+    append_shader_compile_requests(
+        requests,
+        SDL_GPUScreenSpaceReflectionPass::get_shader_compile_requests()
+    );
+    append_shader_compile_requests(
+        requests, SDL_GPUHiZPass::get_shader_compile_requests()
+    );
+    append_shader_compile_requests(
+        requests,
+        SDL_GPUOcclusionDepthPass::get_shader_compile_requests(vertex_format)
+    );
+    append_shader_compile_requests(
+        requests, SDL_GPUInstanceCullPass::get_shader_compile_requests()
+    );
+    append_shader_compile_requests(
+        requests, SDL_GPUMeshletCullPass::get_shader_compile_requests()
+    );
+    append_shader_compile_requests(
+        requests, SDL_GPUClusterPass::get_shader_compile_requests()
+    );
+    append_shader_compile_requests(
+        requests, SDL_GPUShadowPass::get_shader_compile_requests(vertex_format)
+    );
+    append_shader_compile_requests(
+        requests,
+        SDL_GPUPointSpotShadowPass::get_shader_compile_requests(vertex_format)
+    );
+    append_shader_compile_requests(
+        requests, SDL_GPUTonemapPass::get_shader_compile_requests()
+    );
+    append_shader_compile_requests(
+        requests, SDL_GPUSkyboxRenderPass::get_shader_compile_requests()
+    );
+    append_shader_compile_requests(
+        requests, SDL_GPUIBLRenderPass::get_shader_compile_requests()
+    );
+    append_shader_compile_requests(
+        requests, SDL_GPUTextRenderPass::get_shader_compile_requests()
+    );
+    requests.shaders.push_back(get_hiz_debug_fragment_shader_info());
+
+    gpu_device->precompile_shaders(
+        requests.shaders, requests.compute_pipelines
+    );
+    return gpu_device;
+}
+
 }  // namespace
 
 namespace Luminol::Graphics::SDL_GPU {
@@ -209,23 +286,38 @@ SDL_GPURenderer::SDL_GPURenderer(
     : Renderer(graphics_factory),
       sdl_window{static_cast<SDL_Window*>(window.get_window_handle())},
       sdl_gpu_factory{std::move(graphics_factory)},
-      gpu_device{std::move(gpu_device)},
+      gpu_device{precompile_renderer_shaders(
+          std::move(gpu_device), this->sdl_gpu_factory->get_vertex_format()
+      )},
+      frame_pacer{this->gpu_device},
+      staging_ring{this->gpu_device, frame_pacer},
       mesh_render_pass{
           *this->gpu_device,
           clamp_supported_sample_count(
               *this->gpu_device, requested_msaa_sample_count
-          )
+          ),
+          this->sdl_gpu_factory->get_vertex_format()
+      },
+      ao_pass{
+          *this->gpu_device, sdl_window,
+          this->sdl_gpu_factory->get_vertex_format()
       },
-      ao_pass{*this->gpu_device, sdl_window},
       ssr_pass{*this->gpu_device, sdl_window},
       hiz_pass{*this->gpu_device, sdl_window},
       phase1_cull_pass{*this->gpu_device},
-      occlusion_depth_pass{*this->gpu_device, sdl_window},
+      occlusion_depth_pass{
+          *this->gpu_device, sdl_window,
+          this->sdl_gpu_factory->get_vertex_format()
+      },
       instance_cull_pass{*this->gpu_device},
       meshlet_cull_pass{*this->gpu_device},
       cluster_pass{*this->gpu_device},
-      shadow_pass{*this->gpu_device},
-      point_spot_shadow_pass{*this->gpu_device},
+      shadow_pass{
+          *this->gpu_device, this->sdl_gpu_factory->get_vertex_format()
+      },
+      point_spot_shadow_pass{
+          *this->gpu_device, this->sdl_gpu_factory->get_vertex_format()
+      },
       tonemap_pass{*this->gpu_device, sdl_window},
       skybox_render_pass{
           *this->gpu_device,
@@ -258,14 +350,12 @@ SDL_GPURenderer::SDL_GPURenderer(
       msaa_depth_texture{make_msaa_depth_texture(
           *this->gpu_device, sdl_window, msaa_sample_count
       )},
-      hiz_debug_vertex_shader{make_hlsl_shader(
-          *this->gpu_device, "res/shaders/sdl_gpu/fullscreen_vert.hlsl",
-          ShaderStage::Vertex
-      )},
-      hiz_debug_fragment_shader{make_hlsl_shader(
-          *this->gpu_device, "res/shaders/sdl_gpu/hiz_debug_visualize_frag.hlsl",
-          ShaderStage::Fragment, 1U, 1U
-      )},
+      hiz_debug_vertex_shader{
+          this->gpu_device->create_shader(get_fullscreen_vertex_shader_info())
+      },
+      hiz_debug_fragment_shader{
+          this->gpu_device->create_shader(get_hiz_debug_fragment_shader_info())
+      },
       hiz_debug_pipeline{make_fullscreen_pipeline(
           *this->gpu_device, hiz_debug_vertex_shader, hiz_debug_fragment_shader,
           this->gpu_device->get_swapchain_texture_format(sdl_window)
@@ -274,7 +364,58 @@ SDL_GPURenderer::SDL_GPURenderer(
           .filter = SamplerFilter::Nearest,
           .address_mode_u = SamplerAddressMode::ClampToEdge,
           .address_mode_v = SamplerAddressMode::ClampToEdge,
-      })} {}
+      })} {
+    this->gpu_device->release_precompiled_shaders();
+}
+
+SDL_GPURenderer::~SDL_GPURenderer() { stop_render_thread(); }
+
+auto SDL_GPURenderer::create_renderable(
+    gsl::span<const float> vertices,
+    gsl::span<const uint32_t> indices,
+    const TexturePaths& texture_paths
+) -> RenderableId {
+    wait_for_render_thread();
+    return Renderer::create_renderable(vertices, indices, texture_paths);
+}
+
+auto SDL_GPURenderer::create_renderable(
+    gsl::span<const float> vertices,
+    gsl::span<const uint32_t> indices,
+    const TextureImages& texture_images
+) -> RenderableId {
+    wait_for_render_thread();
+    return Renderer::create_renderable(vertices, indices, texture_images);
+}
+
+auto SDL_GPURenderer::create_renderable(const std::filesystem::path& model_path)
+    -> RenderableId {
+    wait_for_render_thread();
+    return Renderer::create_renderable(model_path);
+}
+
+auto SDL_GPURenderer::create_renderable_async(
+    const std::filesystem::path& model_path,
+    std::optional<RenderableId> proxy_renderable_id,
+    RenderableLoadCallback on_loaded
+) -> RenderableId {
+    wait_for_render_thread();
+    return Renderer::create_renderable_async(
+        model_path, proxy_renderable_id, std::move(on_loaded)
+    );
+}
+
+auto SDL_GPURenderer::remove_renderable(RenderableId renderable_id) -> void {
+    wait_for_render_thread();
+    Renderer::remove_renderable(renderable_id);
+}
+
+auto SDL_GPURenderer::create_font(
+    const std::filesystem::path& font_path, float point_size
+) -> FontId {
+    wait_for_render_thread();
+    return Renderer::create_font(font_path, point_size);
+}
 
 auto SDL_GPURenderer::set_view_matrix(const Maths::Matrix4x4f& view_matrix)
     -> void {
@@ -296,93 +437,293 @@ auto SDL_GPURenderer::clear_color(const Maths::Vector4f& color) const -> void {
 }
 
 auto SDL_GPURenderer::queue_draw(
-    RenderableId renderable_id, const Maths::Matrix4x4f& model_matrix
+    RenderableId requested_renderable_id, const Maths::Matrix4x4f& model_matrix
 ) -> void {
-    ensure_capacity(queued_draws, renderable_id);
+    auto& submission_draws = get_submission_queued_draws();
+    const auto draw_target =
+        sdl_gpu_factory->get_draw_target(requested_renderable_id);
+    if (!draw_target.has_value()) {
+        return;
+    }
+    const auto renderable_id = *draw_target;
+
+    ensure_capacity(submission_draws, renderable_id);
     assert(
-        gsl::at(queued_draws.is_static, renderable_id) == 0 &&
+        gsl::at(submission_draws.is_static, renderable_id) == 0 &&
         "queue_draw called for a renderable_id registered via "
         "queue_draw_instanced_static; use queue_draw_instanced_static "
         "instead of mixing APIs for the same renderable_id"
     );
-    gsl::at(queued_draws.model_matrices, renderable_id).push_back(model_matrix);
-    gsl::at(queued_draws.registered, renderable_id) = 1;
+    assert(
+        submission_draws.retained_instances.get_model_matrices(renderable_id)
+            .empty() &&
+        "queue_draw called for a renderable_id with retained instances; use "
+        "create_instance instead of mixing APIs for the same renderable_id"
+    );
+    assert(
+        gsl::at(submission_draws.mapped_instance_counts, renderable_id) == 0 &&
+        "queue_draw called for a renderable_id mapped via map_instances this "
+        "frame; don't mix APIs for the same renderable_id"
+    );
+    queue_frame_instances(
+        submission_draws, renderable_id, gsl::span{&model_matrix, 1}
+    );
 }
 
 auto SDL_GPURenderer::queue_draw_instanced(
-    RenderableId renderable_id, gsl::span<const Maths::Matrix4x4f> model_matrices
+    RenderableId requested_renderable_id,
+    gsl::span<const Maths::Matrix4x4f> model_matrices
 ) -> void {
-    ensure_capacity(queued_draws, renderable_id);
+    auto& submission_draws = get_submission_queued_draws();
+    const auto draw_target =
+        sdl_gpu_factory->get_draw_target(requested_renderable_id);
+    if (!draw_target.has_value()) {
+        return;
+    }
+    const auto renderable_id = *draw_target;
+
+    ensure_capacity(submission_draws, renderable_id);
     assert(
-        gsl::at(queued_draws.is_static, renderable_id) == 0 &&
+        gsl::at(submission_draws.is_static, renderable_id) == 0 &&
         "queue_draw_instanced called for a renderable_id registered via "
         "queue_draw_instanced_static; use queue_draw_instanced_static "
         "instead of mixing APIs for the same renderable_id"
     );
-    auto& batch = gsl::at(queued_draws.model_matrices, renderable_id);
-    batch.insert(batch.end(), model_matrices.begin(), model_matrices.end());
-    gsl::at(queued_draws.registered, renderable_id) = 1;
+    assert(
+        submission_draws.retained_instances.get_model_matrices(renderable_id)
+            .empty() &&
+        "queue_draw_instanced called for a renderable_id with retained "
+        "instances; use create_instance instead of mixing APIs for the same "
+        "renderable_id"
+    );
+    assert(
+        gsl::at(submission_draws.mapped_instance_counts, renderable_id) == 0 &&
+        "queue_draw_instanced called for a renderable_id mapped via "
+        "map_instances this frame; don't mix APIs for the same renderable_id"
+    );
+    queue_frame_instances(submission_draws, renderable_id, model_matrices);
 }
 
 auto SDL_GPURenderer::queue_draw_instanced_static(
     RenderableId renderable_id, gsl::span<const Maths::Matrix4x4f> model_matrices
 ) -> void {
-    ensure_capacity(queued_draws, renderable_id);
-    auto& batch = gsl::at(queued_draws.model_matrices, renderable_id);
+    auto& submission_draws = get_submission_queued_draws();
+    ensure_capacity(submission_draws, renderable_id);
+    auto& batch =
+        gsl::at(submission_draws.static_model_matrices, renderable_id);
     batch.assign(model_matrices.begin(), model_matrices.end());
-    gsl::at(queued_draws.registered, renderable_id) = 1;
-    gsl::at(queued_draws.is_static, renderable_id) = 1;
-    gsl::at(queued_draws.pending_static_upload, renderable_id) = 1;
+    gsl::at(submission_draws.is_static, renderable_id) = 1;
+    submission_draws.static_instances_dirty = true;
+}
+
+auto SDL_GPURenderer::create_instance(
+    RenderableId renderable_id, const Maths::Matrix4x4f& model_matrix
+) -> InstanceId {
+    auto& submission_draws = get_submission_queued_draws();
+    ensure_capacity(submission_draws, renderable_id);
+    assert(
+        gsl::at(submission_draws.is_static, renderable_id) == 0 &&
+        "create_instance called for a renderable_id registered via "
+        "queue_draw_instanced_static; use queue_draw_instanced_static "
+        "instead of mixing APIs for the same renderable_id"
+    );
+    return submission_draws.retained_instances.create(
+        renderable_id, model_matrix
+    );
+}
+
+auto SDL_GPURenderer::update_instance(
+    InstanceId instance_id, const Maths::Matrix4x4f& model_matrix
+) -> void {
+    get_submission_queued_draws().retained_instances.update(
+        instance_id, model_matrix
+    );
+}
+
+auto SDL_GPURenderer::destroy_instance(InstanceId instance_id) -> void {
+    get_submission_queued_draws().retained_instances.destroy(instance_id);
+}
+
+auto SDL_GPURenderer::map_instances(
+    RenderableId requested_renderable_id,
+    uint32_t instance_count,
+    const BoundingBox& world_bounds
+) -> gsl::span<InstanceTransform> {
+    auto& submission_draws = get_submission_queued_draws();
+    const auto draw_target =
+        sdl_gpu_factory->get_draw_target(requested_renderable_id);
+    if (!draw_target.has_value() || instance_count == 0) {
+        return {};
+    }
+    const auto renderable_id = *draw_target;
+
+    ensure_capacity(submission_draws, renderable_id);
+    assert(
+        gsl::at(submission_draws.is_static, renderable_id) == 0 &&
+        submission_draws.retained_instances.get_model_matrices(renderable_id)
+            .empty() &&
+        std::ranges::none_of(
+            submission_draws.frame_runs,
+            [renderable_id](const QueuedRun& run) {
+                return run.renderable_id == renderable_id;
+            }
+        ) &&
+        "map_instances called for a renderable_id drawn through another API; "
+        "don't mix APIs for the same renderable_id"
+    );
+    assert(
+        gsl::at(submission_draws.mapped_instance_counts, renderable_id) == 0 &&
+        "map_instances called twice for the same renderable_id in one frame"
+    );
+
+    submission_draws.mapped_instance_counts[renderable_id] = instance_count;
+    submission_draws.mapped_world_bounds[renderable_id] = world_bounds;
+
+    if (is_render_thread_enabled()) {
+        auto allocator = std::pmr::polymorphic_allocator<InstanceTransform>{
+            &pending_frame.mapped_arena
+        };
+        const auto transforms = gsl::span<InstanceTransform>{
+            allocator.allocate(instance_count), instance_count
+        };
+        pending_frame.mapped_instances.push_back(PendingMappedInstances{
+            .renderable_id = renderable_id,
+            .transforms = transforms,
+        });
+        return transforms;
+    }
+
+    return mesh_render_pass.map_instances(
+        staging_ring, renderable_id, instance_count
+    );
 }
 
 auto SDL_GPURenderer::clear_queued_draws() -> void {
-    for (auto renderable_id = RenderableId{0};
-         renderable_id < queued_draws.model_matrices.size(); ++renderable_id) {
-        if (queued_draws.registered[renderable_id] == 0 ||
+    clear_frame_instances(queued_draws);
+    // Only still holds anything when draw() bailed out before uploading.
+    mesh_render_pass.discard_mapped_instances();
+}
+
+auto SDL_GPURenderer::get_submission_queued_draws() -> QueuedDraws& {
+    return is_render_thread_enabled() ? pending_frame.queued_draws
+                                      : queued_draws;
+}
+
+auto SDL_GPURenderer::get_frame_light_manager() -> LightManager& {
+    return is_render_thread_enabled() ? render_light_manager
+                                      : get_light_manager();
+}
+
+auto SDL_GPURenderer::end_frame_memory() -> void {
+    frame_arena.reset();
+    roll_over_heap_allocation_count();
+}
+
+auto SDL_GPURenderer::roll_over_heap_allocation_count() -> void {
+    const auto heap_allocation_count = Utilities::get_heap_allocation_count();
+    last_frame_heap_allocation_count =
+        heap_allocation_count - frame_heap_allocation_start;
+    frame_heap_allocation_start = heap_allocation_count;
+}
+
+auto SDL_GPURenderer::upload_async_models() -> void {
+    const auto upload_timer = Utilities::Timer{};
+    const auto resident_ids =
+        sdl_gpu_factory->upload_completed_models(async_upload_budget_bytes);
+    // Static registrations made while their id was still loading were
+    // left out of the static arena by upload_instances - rebuild it once
+    // more now that they're resident.
+    for (const auto renderable_id : resident_ids) {
+        if (renderable_id < queued_draws.is_static.size() &&
             queued_draws.is_static[renderable_id] != 0) {
-            continue;
+            queued_draws.static_instances_dirty = true;
         }
-        queued_draws.model_matrices[renderable_id].clear();
     }
+    performance_logger.record(
+        "async_model_upload", Units::Seconds{upload_timer.elapsed_seconds()}
+    );
 }
 
-auto SDL_GPURenderer::handle_resize(const SwapchainTexture& swapchain) -> void {
-    if (depth_texture.get_width() == swapchain.width &&
-        depth_texture.get_height() == swapchain.height) {
+auto SDL_GPURenderer::handle_resize(uint32_t width, uint32_t height) -> void {
+    if (depth_texture.get_width() == width &&
+        depth_texture.get_height() == height) {
         return;
     }
 
-    depth_texture = make_depth_texture(*gpu_device, swapchain.width, swapchain.height);
-    hdr_color_texture =
-        make_hdr_color_texture(*gpu_device, swapchain.width, swapchain.height);
+    depth_texture = make_depth_texture(*gpu_device, width, height);
+    hdr_color_texture = make_hdr_color_texture(*gpu_device, width, height);
     previous_hdr_color_texture =
-        make_hdr_color_texture(*gpu_device, swapchain.width, swapchain.height);
+        make_hdr_color_texture(*gpu_device, width, height);
     has_valid_previous_hdr = false;
     msaa_color_texture = make_msaa_color_texture(
-        *gpu_device, swapchain.width, swapchain.height, msaa_sample_count
+        *gpu_device, width, height, msaa_sample_count
     );
     msaa_depth_texture = make_msaa_depth_texture(
-        *gpu_device, swapchain.width, swapchain.height, msaa_sample_count
+        *gpu_device, width, height, msaa_sample_count
     );
-    ao_pass.resize(*gpu_device, swapchain.width, swapchain.height);
-    ssr_pass.resize(*gpu_device, swapchain.width, swapchain.height);
-    hiz_pass.resize(*gpu_device, swapchain.width, swapchain.height);
-    occlusion_depth_pass.resize(*gpu_device, swapchain.width, swapchain.height);
+    ao_pass.resize(*gpu_device, width, height);
+    ssr_pass.resize(*gpu_device, width, height);
+    hiz_pass.resize(*gpu_device, width, height);
+    occlusion_depth_pass.resize(*gpu_device, width, height);
     has_valid_previous_depth = false;
 }
 
-auto SDL_GPURenderer::upload_instances_and_compute_frustum(
+auto SDL_GPURenderer::prepare_frame(
     CommandBuffer& command_buffer, const Maths::Vector4f& camera_position
 ) -> FramePrepData {
-    auto instance_batches = std::vector<InstanceBatch>{};
+    if (job_system == nullptr) {
+        job_system =
+            std::make_unique<Utilities::JobSystem>(frame_prep_worker_count);
+    }
+
+    const auto current_view_projection =
+        frame_settings.view_matrix * frame_settings.projection_matrix;
+
+    // Touches nothing but the LightManager, so it runs alongside the
+    // instance upload below. Its inputs and output share one struct so the
+    // job captures two pointers, which std::function stores without
+    // allocating.
+    struct LightJob {
+        Maths::Matrix4x4f view_projection;
+        Maths::Vector3f camera_position;
+        const Light* light_data = nullptr;
+    };
+    auto light_job = LightJob{
+        .view_projection = current_view_projection,
+        .camera_position = Maths::Vector3f{
+            camera_position.x(), camera_position.y(), camera_position.z()
+        },
+    };
+    auto light_jobs = Utilities::JobSystem::JobGroup{};
+    job_system->submit(
+        light_jobs,
+        [this, &light_job] {
+            const auto stage_timer = Utilities::Timer{};
+            get_frame_light_manager().update_shadow_casters(
+                light_job.view_projection, light_job.camera_position
+            );
+            light_job.light_data = &get_frame_light_manager().get_light_data();
+            performance_logger.record_stage(
+                "prep_lights", Units::Seconds{stage_timer.elapsed_seconds()}
+            );
+        }
+    );
+
+    // Same arena as upload_instances' result, so assigning it is a move.
+    auto instance_batches = std::pmr::vector<InstanceBatch>{&frame_arena};
     {
         const auto pass_timer = Utilities::Timer{};
         command_buffer.push_debug_group("instance_upload");
 
+        group_frame_instances(queued_draws);
+
         auto copy_pass = command_buffer.begin_copy_pass();
-        instance_batches =
-            mesh_render_pass.upload_instances(*gpu_device, copy_pass, queued_draws);
-        std::ranges::fill(queued_draws.pending_static_upload, 0);
+        instance_batches = mesh_render_pass.upload_instances(
+            *sdl_gpu_factory, *gpu_device, copy_pass, staging_ring,
+            queued_draws, frame_arena, job_system.get()
+        );
+        queued_draws.static_instances_dirty = false;
+        queued_draws.retained_instances.clear_dirty();
 
         command_buffer.pop_debug_group();
         performance_logger.record(
@@ -395,19 +736,36 @@ auto SDL_GPURenderer::upload_instances_and_compute_frustum(
     // record_main_pass benefits from early-Z rejection. Must happen here,
     // before any cull pass below - instance_cull_layout is built positionally
     // aligned to this order, so re-sorting afterward would desync them.
+    const auto sort_timer = Utilities::Timer{};
     const auto batch_distance_squared = [this, &camera_position](
                                              const InstanceBatch& batch
                                          ) -> float {
-        const auto& model_matrices =
-            queued_draws.model_matrices[batch.renderable_id];
+        const auto distance_squared = [&](float x, float y, float z) {
+            const auto delta_x = x - camera_position.x();
+            const auto delta_y = y - camera_position.y();
+            const auto delta_z = z - camera_position.z();
+            return (delta_x * delta_x) + (delta_y * delta_y) +
+                (delta_z * delta_z);
+        };
+
+        // Mapped batches' transforms are only in GPU staging - use the center
+        // of the bounds their caller gave instead.
+        if (const auto bounds =
+                get_mapped_world_bounds(queued_draws, batch.renderable_id)) {
+            return distance_squared(
+                (bounds->min.x() + bounds->max.x()) / 2.0F,
+                (bounds->min.y() + bounds->max.y()) / 2.0F,
+                (bounds->min.z() + bounds->max.z()) / 2.0F
+            );
+        }
+
+        const auto model_matrices =
+            get_model_matrices(queued_draws, batch.renderable_id);
         if (model_matrices.empty()) {
             return 0.0F;
         }
         const auto& matrix = model_matrices.front();
-        const auto delta_x = matrix[3][0] - camera_position.x();
-        const auto delta_y = matrix[3][1] - camera_position.y();
-        const auto delta_z = matrix[3][2] - camera_position.z();
-        return (delta_x * delta_x) + (delta_y * delta_y) + (delta_z * delta_z);
+        return distance_squared(matrix[3][0], matrix[3][1], matrix[3][2]);
     };
     std::sort(
         instance_batches.begin(), instance_batches.end(),
@@ -415,24 +773,41 @@ auto SDL_GPURenderer::upload_instances_and_compute_frustum(
             const InstanceBatch& lhs, const InstanceBatch& rhs
         ) { return batch_distance_squared(lhs) < batch_distance_squared(rhs); }
     );
+    performance_logger.record_stage(
+        "prep_batch_sort", Units::Seconds{sort_timer.elapsed_seconds()}
+    );
+
+    // Once, in the sorted order, for every pass that frustum-tests whole
+    // submeshes on the CPU (cascade and point/spot shadows, the transparent
+    // bin).
+    const auto bounds_timer = Utilities::Timer{};
+    auto batch_mesh_world_bounds = compute_batch_mesh_world_bounds(
+        *sdl_gpu_factory, instance_batches, queued_draws, frame_arena,
+        job_system.get()
+    );
+    performance_logger.record_stage(
+        "prep_mesh_bounds", Units::Seconds{bounds_timer.elapsed_seconds()}
+    );
 
-    const auto current_view_projection = view_matrix * projection_matrix;
-    const auto camera_frustum_planes =
-        extract_frustum_planes(current_view_projection);
+    job_system->wait(light_jobs);
 
     return FramePrepData{
         .instance_batches = std::move(instance_batches),
-        .camera_frustum_planes = camera_frustum_planes,
+        .batch_mesh_world_bounds = std::move(batch_mesh_world_bounds),
+        .light_data = light_job.light_data,
+        .camera_frustum_planes =
+            extract_frustum_planes(current_view_projection),
         .current_view_projection = current_view_projection,
     };
 }
 
 auto SDL_GPURenderer::compute_camera_frame_data() const -> CameraFrameData {
-    const auto camera_params = extract_camera_params(projection_matrix);
+    const auto camera_params =
+        extract_camera_params(frame_settings.projection_matrix);
 
     return CameraFrameData{
-        .position = get_view_position(view_matrix),
-        .forward = get_camera_forward(view_matrix),
+        .position = get_view_position(frame_settings.view_matrix),
+        .forward = get_camera_forward(frame_settings.view_matrix),
         .vertical_fov_degrees = camera_params.vertical_fov_degrees,
         .aspect_ratio = camera_params.aspect_ratio,
         .near_plane = camera_params.near_plane,
@@ -461,20 +836,20 @@ auto SDL_GPURenderer::run_occlusion_prepass(
     hiz_pass.build(command_buffer, depth_texture, point_sampler);
 
     const auto phase1_cull_layout = phase1_cull_pass.cull(
-        *this->sdl_gpu_factory, command_buffer,
+        *this->sdl_gpu_factory, command_buffer, staging_ring,
         mesh_render_pass.get_instance_buffer_cache(), instance_batches,
         camera_frustum_planes, current_view_projection,
         hiz_pass.get_pyramid_texture(), hiz_pass.get_pyramid_sampler(),
         (has_valid_previous_depth && !debug_disable_occlusion_culling)
             ? hiz_pass.get_mip_levels()
             : 0U,
-        camera_position, true
+        camera_position, true, frame_arena, job_system.get()
     );
 
     occlusion_depth_pass.draw(
         *this->sdl_gpu_factory, command_buffer,
         mesh_render_pass.get_instance_buffer_cache(), instance_batches,
-        view_matrix, projection_matrix,
+        frame_settings.view_matrix, frame_settings.projection_matrix,
         phase1_cull_pass.get_indirect_command_buffer(),
         phase1_cull_pass.get_visible_instance_indices_buffer(),
         phase1_cull_layout
@@ -498,15 +873,12 @@ auto SDL_GPURenderer::record_debug_hiz_visualize(
     CommandBuffer& command_buffer,
     const SwapchainTexture& swapchain,
     const CameraFrameData& camera
-) -> bool {
-    // Debug-only: short-circuit the rest of the frame and blit the Hi-Z
-    // pyramid's mip 0 straight to the screen instead of the normal scene, to
-    // visually sanity-check its contents. Inspects the phase-2 (same-frame)
-    // pyramid, since that's the one the final cull below actually uses.
-    if (!debug_visualize_hiz) {
-        return false;
-    }
-
+) -> void {
+    // Debug-only: the rest of the frame was short-circuited, so blit the
+    // Hi-Z pyramid's mip 0 straight to the screen instead of the normal
+    // scene, to visually sanity-check its contents. Inspects the phase-2
+    // (same-frame) pyramid, since that's the one the final cull actually
+    // uses.
     const auto visualize_color_targets = std::array{ColorTargetInfo{
         .texture = &swapchain.texture,
         .load_op = LoadOp::DontCare,
@@ -539,8 +911,6 @@ auto SDL_GPURenderer::record_debug_hiz_visualize(
 
         visualize_render_pass.draw_primitives(3, 1, 0, 0);
     }
-
-    return true;
 }
 
 auto SDL_GPURenderer::record_ao_and_ssr(
@@ -553,8 +923,8 @@ auto SDL_GPURenderer::record_ao_and_ssr(
         command_buffer,
         mesh_render_pass.get_instance_buffer_cache(),
         instance_batches,
-        view_matrix,
-        projection_matrix,
+        frame_settings.view_matrix,
+        frame_settings.projection_matrix,
         instance_cull_pass.get_indirect_command_buffer(),
         instance_cull_pass.get_visible_instance_indices_buffer(),
         instance_cull_layout,
@@ -567,7 +937,7 @@ auto SDL_GPURenderer::record_ao_and_ssr(
     // resolved HDR color. Consumed by the main pass below.
     ssr_pass.draw(
         command_buffer,
-        projection_matrix,
+        frame_settings.projection_matrix,
         depth_texture,
         ao_pass.get_normal_texture(),
         previous_hdr_color_texture,
@@ -579,14 +949,10 @@ auto SDL_GPURenderer::record_ao_and_ssr(
 auto SDL_GPURenderer::record_shadows(
     CommandBuffer& command_buffer,
     gsl::span<const InstanceBatch> instance_batches,
+    const BatchMeshBounds& batch_mesh_world_bounds,
+    const Light& light_manager_data,
     const CameraFrameData& camera
-) -> const Light& {
-    get_light_manager().update_shadow_casters(
-        view_matrix * projection_matrix,
-        Maths::Vector3f{camera.position.x(), camera.position.y(), camera.position.z()}
-    );
-
-    const auto& light_manager_data = get_light_manager().get_light_data();
+) -> void {
     const auto& directional_light = light_manager_data.directional_light;
 
     {
@@ -605,7 +971,10 @@ auto SDL_GPURenderer::record_shadows(
     {
         const auto pass_timer = Utilities::Timer{};
         command_buffer.push_debug_group("cluster_cull");
-        cluster_pass.cull_lights(command_buffer, light_manager_data, view_matrix);
+        cluster_pass.cull_lights(
+            *this->gpu_device, frame_pacer, command_buffer, staging_ring,
+            light_manager_data, frame_settings.view_matrix
+        );
         command_buffer.pop_debug_group();
         performance_logger.record(
             "cluster_cull", Units::Seconds{pass_timer.elapsed_seconds()}
@@ -615,38 +984,41 @@ auto SDL_GPURenderer::record_shadows(
     shadow_pass.draw(
         *this->sdl_gpu_factory,
         command_buffer,
+        staging_ring,
         mesh_render_pass.get_instance_buffer_cache(),
         instance_batches,
-        queued_draws,
+        batch_mesh_world_bounds,
         Maths::Vector3f{
             directional_light.direction.x(),
             directional_light.direction.y(),
             directional_light.direction.z()
         },
-        view_matrix,
-        projection_matrix,
+        frame_settings.view_matrix,
+        frame_settings.projection_matrix,
         hiz_pass.get_pyramid_texture(),
         hiz_pass.get_pyramid_sampler(),
-        performance_logger
+        performance_logger,
+        frame_arena
     );
 
     point_spot_shadow_pass.draw(
         *this->sdl_gpu_factory,
         command_buffer,
+        staging_ring,
         mesh_render_pass.get_instance_buffer_cache(),
         instance_batches,
-        queued_draws,
+        batch_mesh_world_bounds,
         light_manager_data,
-        performance_logger
+        performance_logger,
+        frame_arena,
+        job_system.get()
     );
-
-    return light_manager_data;
 }
 
 auto SDL_GPURenderer::record_main_pass(
     CommandBuffer& command_buffer,
-    const SwapchainTexture& swapchain,
     gsl::span<const InstanceBatch> instance_batches,
+    const BatchMeshBounds& batch_mesh_world_bounds,
     const std::array<Maths::Vector4f, 6>& camera_frustum_planes,
     const InstanceCullLayout& instance_cull_layout,
     const MeshletCullLayout& meshlet_cull_layout,
@@ -669,7 +1041,7 @@ auto SDL_GPURenderer::record_main_pass(
             *this->sdl_gpu_factory,
             command_buffer,
             instance_batches,
-            view_matrix * projection_matrix,
+            frame_settings.view_matrix * frame_settings.projection_matrix,
             instance_cull_pass.get_indirect_command_buffer(),
             instance_cull_pass.get_visible_instance_indices_buffer(),
             instance_cull_layout,
@@ -691,7 +1063,7 @@ auto SDL_GPURenderer::record_main_pass(
 
     const auto color_targets = std::array{ColorTargetInfo{
         .texture = &msaa_color_texture_view,
-        .clear_color = clear_color_value,
+        .clear_color = frame_settings.clear_color,
         .load_op = LoadOp::Clear,
         .store_op = StoreOp::Resolve,
         .resolve_texture = &hdr_color_texture_view,
@@ -715,8 +1087,8 @@ auto SDL_GPURenderer::record_main_pass(
         .color = directional_light.color,
         .view_position = camera.position,
         .screen_size = Maths::Vector4f{
-            static_cast<float>(swapchain.width),
-            static_cast<float>(swapchain.height),
+            static_cast<float>(hdr_color_texture.get_width()),
+            static_cast<float>(hdr_color_texture.get_height()),
             0.0F,
             0.0F,
         },
@@ -729,8 +1101,10 @@ auto SDL_GPURenderer::record_main_pass(
         .cluster_params = Maths::Vector4f{
             camera.near_plane,
             camera.far_plane,
-            0.0F,
-            0.0F,
+            static_cast<float>(cluster_pass.get_culling_mode()),
+            static_cast<float>(
+                cluster_pass.get_z_bin_pass().get_tile_mask_word_count()
+            ),
         },
         .cascade_light_space_matrices =
             shadow_pass.get_cascade_light_space_matrices(),
@@ -744,7 +1118,8 @@ auto SDL_GPURenderer::record_main_pass(
         render_pass,
         instance_batches,
         queued_draws,
-        view_matrix * projection_matrix,
+        batch_mesh_world_bounds,
+        frame_settings.view_matrix * frame_settings.projection_matrix,
         camera_frustum_planes,
         meshlet_cull_pass.get_indirect_command_buffer(),
         meshlet_cull_pass.get_visible_meshlet_instances_buffer(),
@@ -769,6 +1144,12 @@ auto SDL_GPURenderer::record_main_pass(
             .cluster_light_grid = &cluster_pass.get_cluster_light_grid_buffer(),
             .global_light_index_list =
                 &cluster_pass.get_global_light_index_list_buffer(),
+            .light_z_bins =
+                &cluster_pass.get_z_bin_pass().get_light_z_bin_buffer(),
+            .light_tile_masks =
+                &cluster_pass.get_z_bin_pass().get_light_tile_mask_buffer(),
+            .depth_sorted_lights =
+                &cluster_pass.get_z_bin_pass().get_depth_sorted_light_buffer(),
         },
         PointSpotShadowTextures{
             .point_shadow_texture =
@@ -783,11 +1164,13 @@ auto SDL_GPURenderer::record_main_pass(
                 &point_spot_shadow_pass.get_spot_shadow_matrix_buffer(),
         },
         ssr_pass.get_ssr_texture(),
-        ssr_pass.get_sampler()
+        ssr_pass.get_sampler(),
+        frame_arena
     );
 
     skybox_render_pass.draw(
-        command_buffer, render_pass, view_matrix, projection_matrix
+        command_buffer, render_pass, frame_settings.view_matrix,
+        frame_settings.projection_matrix
     );
 
     command_buffer.pop_debug_group();
@@ -812,7 +1195,8 @@ auto SDL_GPURenderer::record_tonemap_and_text(
         command_buffer.begin_render_pass(tonemap_color_targets);
 
     tonemap_pass.draw(
-        command_buffer, tonemap_render_pass, hdr_color_texture, exposure
+        command_buffer, tonemap_render_pass, hdr_color_texture,
+        frame_settings.exposure
     );
 
     text_render_pass.draw(
@@ -826,8 +1210,21 @@ auto SDL_GPURenderer::record_tonemap_and_text(
 }
 
 auto SDL_GPURenderer::draw() -> void {
+    if (is_render_thread_enabled()) {
+        draw_with_render_thread();
+        return;
+    }
+
+    // First, so it runs after every frame_arena-backed local is destroyed.
+    const auto frame_memory_guard =
+        gsl::finally([this] { this->end_frame_memory(); });
     const auto frame_timer = Utilities::Timer{};
 
+    frame_pacer.begin_frame(frames_in_flight);
+
+    upload_async_models();
+    hand_off_frame();
+
     auto command_buffer = gpu_device->create_command_buffer();
 
     const auto acquire_timer = Utilities::Timer{};
@@ -837,22 +1234,71 @@ auto SDL_GPURenderer::draw() -> void {
     );
 
     if (!swapchain.has_value()) {
-        command_buffer.submit();
+        submit_frame(command_buffer);
         clear_queued_draws();
         return;
     }
 
-    handle_resize(*swapchain);
+    handle_resize(swapchain->width, swapchain->height);
 
     const auto camera = compute_camera_frame_data();
+    const auto recorded = RecordedFrame{
+        .camera = camera,
+        .visualize_hiz = !record_scene(command_buffer, camera),
+    };
+    record_present(command_buffer, *swapchain, recorded);
+
+    submit_frame(command_buffer);
+    clear_queued_draws();
+
+    performance_logger.record(
+        "frame", Units::Seconds{frame_timer.elapsed_seconds()}
+    );
+    performance_logger.end_frame();
+}
+
+auto SDL_GPURenderer::hand_off_frame() -> void {
+    frame_settings = FrameSettings{
+        .view_matrix = view_matrix,
+        .projection_matrix = projection_matrix,
+        .clear_color = clear_color_value,
+        .exposure = exposure,
+    };
+    text_render_pass.hand_off_queued_text();
+
+    if (is_render_thread_enabled()) {
+        hand_off_pending_frame();
+    }
+}
+
+auto SDL_GPURenderer::hand_off_pending_frame() -> void {
+    hand_off_queued_draws(pending_frame.queued_draws, queued_draws);
+
+    for (const auto& mapped : pending_frame.mapped_instances) {
+        const auto transforms = mesh_render_pass.map_instances(
+            staging_ring, mapped.renderable_id,
+            static_cast<uint32_t>(mapped.transforms.size())
+        );
+        std::ranges::copy(mapped.transforms, transforms.begin());
+    }
+    pending_frame.mapped_instances.clear();
+    pending_frame.mapped_arena.reset();
+
+    render_light_manager.sync_lights_from(get_light_manager());
+}
+
+auto SDL_GPURenderer::record_scene(
+    CommandBuffer& command_buffer, const CameraFrameData& camera
+) -> bool {
     const auto camera_position_3f = Maths::Vector3f{
         camera.position.x(), camera.position.y(), camera.position.z()
     };
 
-    auto frame_prep =
-        upload_instances_and_compute_frustum(command_buffer, camera.position);
+    auto frame_prep = prepare_frame(command_buffer, camera.position);
 
-    text_render_pass.flush_frame_geometry(*gpu_device, command_buffer);
+    text_render_pass.flush_frame_geometry(
+        *gpu_device, command_buffer, staging_ring
+    );
 
     run_occlusion_prepass(
         command_buffer, frame_prep.instance_batches,
@@ -860,10 +1306,8 @@ auto SDL_GPURenderer::draw() -> void {
         camera_position_3f
     );
 
-    if (record_debug_hiz_visualize(command_buffer, *swapchain, camera)) {
-        command_buffer.submit();
-        clear_queued_draws();
-        return;
+    if (debug_visualize_hiz) {
+        return false;
     }
 
     // Phase 2 cull: the final, always-correct visible set, consumed by every
@@ -885,11 +1329,11 @@ auto SDL_GPURenderer::draw() -> void {
     // since anything this test previously (wrongly-or-rightly) culled is
     // simply drawn instead.
     const auto instance_cull_layout = instance_cull_pass.cull(
-        *this->sdl_gpu_factory, command_buffer,
+        *this->sdl_gpu_factory, command_buffer, staging_ring,
         mesh_render_pass.get_instance_buffer_cache(), frame_prep.instance_batches,
         frame_prep.camera_frustum_planes, frame_prep.current_view_projection,
         hiz_pass.get_pyramid_texture(), hiz_pass.get_pyramid_sampler(), 0U,
-        camera_position_3f, true
+        camera_position_3f, true, frame_arena, job_system.get()
     );
 
     // Phase B: further culls Phase 2's surviving (submesh, LOD) instances at
@@ -897,41 +1341,48 @@ auto SDL_GPURenderer::draw() -> void {
     // must run on this same command_buffer before any render pass opens
     // below (see SDL_GPUMeshletCullPass's doc comment).
     const auto meshlet_cull_layout = meshlet_cull_pass.cull(
-        *this->sdl_gpu_factory, command_buffer,
+        *this->sdl_gpu_factory, command_buffer, staging_ring,
         mesh_render_pass.get_instance_buffer_cache(), frame_prep.instance_batches,
         instance_cull_layout, instance_cull_pass, frame_prep.camera_frustum_planes,
         frame_prep.current_view_projection, hiz_pass.get_pyramid_texture(),
         hiz_pass.get_pyramid_sampler(),
-        debug_disable_occlusion_culling ? 0U : hiz_pass.get_mip_levels()
+        debug_disable_occlusion_culling ? 0U : hiz_pass.get_mip_levels(),
+        frame_arena
     );
 
-    record_ao_and_ssr(command_buffer, frame_prep.instance_batches, instance_cull_layout);
+    record_ao_and_ssr(
+        command_buffer, frame_prep.instance_batches, instance_cull_layout
+    );
 
-    const auto& light_manager_data =
-        record_shadows(command_buffer, frame_prep.instance_batches, camera);
+    record_shadows(
+        command_buffer, frame_prep.instance_batches,
+        frame_prep.batch_mesh_world_bounds, *frame_prep.light_data, camera
+    );
+    // cluster_pass has uploaded this frame's light changes.
+    get_frame_light_manager().clear_changes();
 
     record_main_pass(
-        command_buffer, *swapchain, frame_prep.instance_batches,
-        frame_prep.camera_frustum_planes, instance_cull_layout, meshlet_cull_layout,
-        light_manager_data, camera
+        command_buffer, frame_prep.instance_batches,
+        frame_prep.batch_mesh_world_bounds, frame_prep.camera_frustum_planes,
+        instance_cull_layout, meshlet_cull_layout, *frame_prep.light_data,
+        camera
     );
 
-    record_tonemap_and_text(command_buffer, *swapchain);
+    has_valid_previous_depth = true;
+    return true;
+}
 
-    if (debug_gpu_profiling_enabled) {
-        const auto gpu_timer = Utilities::Timer{};
-        auto* fence = command_buffer.submit_and_acquire_fence();
-        gpu_device->wait_for_fence(fence);
-        performance_logger.record(
-            "gpu_frame_proxy", Units::Seconds{gpu_timer.elapsed_seconds()}
-        );
-        gpu_device->release_fence(fence);
-    } else {
-        command_buffer.submit();
+auto SDL_GPURenderer::record_present(
+    CommandBuffer& command_buffer,
+    const SwapchainTexture& swapchain,
+    const RecordedFrame& frame
+) -> void {
+    if (frame.visualize_hiz) {
+        record_debug_hiz_visualize(command_buffer, swapchain, frame.camera);
+        return;
     }
-    clear_queued_draws();
 
-    has_valid_previous_depth = true;
+    record_tonemap_and_text(command_buffer, swapchain);
 
     // Ping-pong the HDR targets: this frame's resolved color becomes next
     // frame's SSR reflection source. Swapping the wrapper handles avoids a
@@ -939,19 +1390,247 @@ auto SDL_GPURenderer::draw() -> void {
     // hdr_color_texture, so it's safe to repurpose it as "previous" now.
     std::swap(hdr_color_texture, previous_hdr_color_texture);
     has_valid_previous_hdr = true;
+}
+
+auto SDL_GPURenderer::submit_frame(CommandBuffer& command_buffer) -> void {
+    const auto gpu_timer = Utilities::Timer{};
+    const auto frame = frame_pacer.submit(command_buffer);
+    if (debug_gpu_profiling_enabled) {
+        frame_pacer.wait_for_frame(frame);
+        performance_logger.record(
+            "gpu_frame_proxy", Units::Seconds{gpu_timer.elapsed_seconds()}
+        );
+    }
+    staging_ring.end_frame(frame);
+    cluster_pass.end_frame(frame);
+
+    const auto pacing_stats = frame_pacer.get_last_frame_stats();
+    performance_logger.record("gpu_wait", pacing_stats.gpu_wait_time);
+    performance_logger.record("cpu_wait", pacing_stats.cpu_wait_time);
+    if (pacing_stats.gpu_frame_time.has_value()) {
+        performance_logger.record("gpu_frame", *pacing_stats.gpu_frame_time);
+    }
+    performance_logger.record(
+        "staging_wait", staging_ring.get_last_frame_stats().fence_wait_time
+    );
+}
+
+auto SDL_GPURenderer::draw_with_render_thread() -> void {
+    const auto frame_timer = Utilities::Timer{};
+
+    const auto wait_timer = Utilities::Timer{};
+    wait_for_render_thread();
+    performance_logger.record(
+        "render_thread_wait", Units::Seconds{wait_timer.elapsed_seconds()}
+    );
+
+    present_recorded_frame();
+
+    upload_async_models();
+    hand_off_frame();
+
+    const auto [width, height] = get_window_size_in_pixels(sdl_window);
+    handle_resize(width, height);
 
     performance_logger.record(
         "frame", Units::Seconds{frame_timer.elapsed_seconds()}
     );
     performance_logger.end_frame();
+    roll_over_heap_allocation_count();
+
+    {
+        const auto lock = std::scoped_lock{render_thread_mutex};
+        render_frame_pending = true;
+    }
+    render_thread_condition.notify_all();
+}
+
+auto SDL_GPURenderer::present_recorded_frame() -> void {
+    if (!recorded_frame.has_value()) {
+        return;
+    }
+
+    auto command_buffer = gpu_device->create_command_buffer();
+
+    const auto acquire_timer = Utilities::Timer{};
+    const auto swapchain = command_buffer.acquire_swapchain_texture(sdl_window);
+    performance_logger.record(
+        "acquire_swapchain", Units::Seconds{acquire_timer.elapsed_seconds()}
+    );
+
+    if (swapchain.has_value()) {
+        record_present(command_buffer, *swapchain, *recorded_frame);
+    }
+    submit_frame(command_buffer);
+    recorded_frame.reset();
+}
+
+auto SDL_GPURenderer::wait_for_render_thread() -> void {
+    if (!is_render_thread_enabled()) {
+        return;
+    }
+
+    auto lock = std::unique_lock{render_thread_mutex};
+    render_thread_condition.wait(lock, [this] {
+        return !render_frame_pending;
+    });
+}
+
+auto SDL_GPURenderer::stop_render_thread() -> void {
+    if (!render_thread.joinable()) {
+        return;
+    }
+
+    wait_for_render_thread();
+    {
+        const auto lock = std::scoped_lock{render_thread_mutex};
+        render_thread_stopping = true;
+    }
+    render_thread_condition.notify_all();
+    render_thread.join();
+    render_thread_stopping = false;
+}
+
+auto SDL_GPURenderer::run_render_thread() -> void {
+    auto lock = std::unique_lock{render_thread_mutex};
+    while (true) {
+        render_thread_condition.wait(lock, [this] {
+            return render_frame_pending || render_thread_stopping;
+        });
+        if (!render_frame_pending) {
+            return;
+        }
+
+        lock.unlock();
+        record_render_thread_frame();
+        lock.lock();
+
+        render_frame_pending = false;
+        render_thread_condition.notify_all();
+    }
+}
+
+auto SDL_GPURenderer::record_render_thread_frame() -> void {
+    const auto frame_timer = Utilities::Timer{};
+
+    frame_pacer.begin_frame(frames_in_flight);
+
+    auto command_buffer = gpu_device->create_command_buffer();
+    const auto camera = compute_camera_frame_data();
+    const auto scene_recorded = record_scene(command_buffer, camera);
+    // No fence of its own - the present pass submitted after it covers it
+    // (see submit_frame), and so does staging_ring's frame.
+    command_buffer.submit();
+
+    clear_queued_draws();
+    frame_arena.reset();
+
+    recorded_frame = RecordedFrame{
+        .camera = camera,
+        .visualize_hiz = !scene_recorded,
+    };
+
+    performance_logger.record(
+        "render_thread_frame", Units::Seconds{frame_timer.elapsed_seconds()}
+    );
+}
+
+auto SDL_GPURenderer::get_last_frame_heap_allocation_count() const
+    -> uint64_t {
+    return last_frame_heap_allocation_count;
+}
+
+auto SDL_GPURenderer::get_last_frame_staging_stats() const
+    -> StagingRingFrameStats {
+    return staging_ring.get_last_frame_stats();
+}
+
+auto SDL_GPURenderer::set_light_index_budget(uint32_t budget_bytes) -> void {
+    wait_for_render_thread();
+    cluster_pass.set_light_index_budget(budget_bytes);
+}
+
+auto SDL_GPURenderer::get_light_index_list_settings() const
+    -> LightIndexListSettings {
+    return cluster_pass.get_light_index_list_settings();
+}
+
+auto SDL_GPURenderer::get_last_light_index_list_usage() const
+    -> LightIndexListUsage {
+    return cluster_pass.get_last_light_index_list_usage();
+}
+
+auto SDL_GPURenderer::set_light_culling_mode(LightCullingMode mode) -> void {
+    wait_for_render_thread();
+    cluster_pass.set_culling_mode(mode);
+}
+
+auto SDL_GPURenderer::get_light_culling_mode() const -> LightCullingMode {
+    return cluster_pass.get_culling_mode();
+}
+
+auto SDL_GPURenderer::set_render_thread_enabled(bool enabled) -> void {
+    if (enabled == is_render_thread_enabled()) {
+        return;
+    }
+
+    if (enabled) {
+        // The caller's side starts out as a copy of everything registered
+        // so far - static and retained instances carry over between frames.
+        pending_frame.queued_draws = queued_draws;
+        render_light_manager = get_light_manager();
+        get_light_manager().clear_changes();
+        render_thread = std::thread{[this] { run_render_thread(); }};
+        return;
+    }
+
+    wait_for_render_thread();
+    present_recorded_frame();
+    stop_render_thread();
+    // What was queued since the last draw() goes out with the next one.
+    hand_off_pending_frame();
+    // The light buffers hold render_light_manager's uploads, not ours.
+    get_light_manager().mark_all_lights_changed();
+}
+
+auto SDL_GPURenderer::is_render_thread_enabled() const -> bool {
+    return render_thread.joinable();
+}
+
+auto SDL_GPURenderer::set_frames_in_flight(uint32_t count) -> void {
+    wait_for_render_thread();
+
+    const auto clamped_count = std::clamp(
+        count, FramePacer::min_frames_in_flight,
+        FramePacer::max_frames_in_flight
+    );
+    if (clamped_count == frames_in_flight) {
+        return;
+    }
+
+    // SDL_GPU's swapchain would otherwise still block at its own limit.
+    if (!gpu_device->set_allowed_frames_in_flight(clamped_count)) {
+        return;
+    }
+    frames_in_flight = clamped_count;
+}
+
+auto SDL_GPURenderer::get_frames_in_flight() const -> uint32_t {
+    return frames_in_flight;
+}
+
+auto SDL_GPURenderer::get_last_frame_pacing_stats() const -> FramePacingStats {
+    return frame_pacer.get_last_frame_stats();
 }
 
 auto SDL_GPURenderer::set_debug_disable_occlusion_culling(bool disabled)
     -> void {
+    wait_for_render_thread();
     debug_disable_occlusion_culling = disabled;
 }
 
 auto SDL_GPURenderer::set_debug_visualize_hiz(bool enabled) -> void {
+    wait_for_render_thread();
     debug_visualize_hiz = enabled;
 }
 
@@ -960,12 +1639,15 @@ auto SDL_GPURenderer::set_debug_gpu_profiling_enabled(bool enabled) -> void {
 }
 
 auto SDL_GPURenderer::set_debug_present_mode(PresentMode mode) -> void {
+    wait_for_render_thread();
     if (!gpu_device->set_present_mode(sdl_window, mode)) {
         SDL_Log("[GpuProfiling] present mode change failed or unsupported");
     }
 }
 
 auto SDL_GPURenderer::debug_log_visible_instance_count() -> void {
+    wait_for_render_thread();
+
     const auto& indirect_buffer = instance_cull_pass.get_indirect_command_buffer();
     const auto buffer_size = indirect_buffer.get_size();
     if (buffer_size == 0) {
@@ -1017,6 +1699,18 @@ auto SDL_GPURenderer::debug_log_visible_instance_count() -> void {
     );
 }
 
+auto SDL_GPURenderer::set_async_upload_budget(uint64_t bytes_per_frame)
+    -> void {
+    async_upload_budget_bytes = bytes_per_frame;
+}
+
+auto SDL_GPURenderer::set_frame_prep_worker_count(uint32_t worker_count)
+    -> void {
+    wait_for_render_thread();
+    frame_prep_worker_count = worker_count;
+    job_system.reset();
+}
+
 auto SDL_GPURenderer::queue_draw_text(
     FontId font_id,
     std::string_view text,
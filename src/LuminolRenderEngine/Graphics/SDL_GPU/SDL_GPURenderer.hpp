@@ -1,8 +1,15 @@
 #pragma once
 
 #include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
 #include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
 #include <string_view>
+#include <thread>
 #include <vector>
 
 #include <LuminolMaths/Vector.hpp>
@@ -13,6 +20,7 @@
 #include <LuminolRenderEngine/Graphics/SDL_GPU/Lighting/SDL_GPUClusterPass.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUCommandBuffer.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUDevice.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUFramePacer.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/Text/SDL_GPUFont.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/Culling/SDL_GPUHiZPass.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/Lighting/SDL_GPUIBLRenderPass.hpp>
@@ -24,9 +32,13 @@
 #include <LuminolRenderEngine/Graphics/SDL_GPU/PostProcess/SDL_GPUScreenSpaceReflectionPass.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/Shadows/SDL_GPUShadowPass.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/Sky/SDL_GPUSkyboxRenderPass.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUStagingRing.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/Text/SDL_GPUTextRenderPass.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUTexture.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/PostProcess/SDL_GPUTonemapPass.hpp>
+#include <LuminolRenderEngine/Utilities/AllocationCounter.hpp>
+#include <LuminolRenderEngine/Utilities/FrameArena.hpp>
+#include <LuminolRenderEngine/Utilities/JobSystem.hpp>
 #include <LuminolRenderEngine/Utilities/PerformanceLogger.hpp>
 
 namespace Luminol::Graphics::SDL_GPU {
@@ -42,6 +54,39 @@ public:
         SampleCount requested_msaa_sample_count = SampleCount::x4
     );
 
+    SDL_GPURenderer(const SDL_GPURenderer&) = delete;
+    SDL_GPURenderer(SDL_GPURenderer&&) = delete;
+    auto operator=(const SDL_GPURenderer&) -> SDL_GPURenderer& = delete;
+    auto operator=(SDL_GPURenderer&&) -> SDL_GPURenderer& = delete;
+    ~SDL_GPURenderer();
+
+    // Renderer's resource creation/removal, which in render-thread mode
+    // first waits for the render thread to finish its frame, since it reads
+    // the factory's resources while recording - keep these out of the
+    // per-frame path there.
+    [[nodiscard]] auto create_renderable(
+        gsl::span<const float> vertices,
+        gsl::span<const uint32_t> indices,
+        const TexturePaths& texture_paths
+    ) -> RenderableId;
+    [[nodiscard]] auto create_renderable(
+        gsl::span<const float> vertices,
+        gsl::span<const uint32_t> indices,
+        const TextureImages& texture_images
+    ) -> RenderableId;
+    [[nodiscard]] auto create_renderable(
+        const std::filesystem::path& model_path
+    ) -> RenderableId;
+    [[nodiscard]] auto create_renderable_async(
+        const std::filesystem::path& model_path,
+        std::optional<RenderableId> proxy_renderable_id = std::nullopt,
+        RenderableLoadCallback on_loaded = {}
+    ) -> RenderableId;
+    auto remove_renderable(RenderableId renderable_id) -> void;
+    [[nodiscard]] auto create_font(
+        const std::filesystem::path& font_path, float point_size
+    ) -> FontId;
+
     auto set_view_matrix(const Maths::Matrix4x4f& view_matrix) -> void;
     auto set_projection_matrix(const Maths::Matrix4x4f& projection_matrix)
         -> void;
@@ -50,6 +95,10 @@ public:
 
     auto clear_color(const Maths::Vector4f& color) const -> void;
 
+    // Draws of an id that isn't resident yet (see create_renderable_async)
+    // go to its proxy, or are dropped, for this frame only - queue_draw and
+    // queue_draw_instanced are called every frame anyway, so they pick up
+    // the real model as soon as it lands.
     auto queue_draw(
         RenderableId renderable_id, const Maths::Matrix4x4f& model_matrix
     ) -> void;
@@ -71,12 +120,49 @@ public:
     // renderable_id (which forces exactly one more upload on the next
     // draw()). Do not call queue_draw / queue_draw_instanced for a
     // renderable_id that has ever been passed to this function - mixing the
-    // two is unsupported (asserted against in debug builds).
+    // two is unsupported (asserted against in debug builds). A static id
+    // that's still loading asynchronously isn't proxied - it just starts
+    // drawing (with exactly one upload) once it becomes resident.
     auto queue_draw_instanced_static(
         RenderableId renderable_id,
         gsl::span<const Maths::Matrix4x4f> model_matrices
     ) -> void;
 
+    // Retained instances: unlike queue_draw_instanced (re-submitted and
+    // re-uploaded in full every frame), an instance created here is drawn
+    // every frame until destroy_instance, and only instances written since
+    // the previous draw() (created, updated, or moved by a destroy) are
+    // uploaded again - a mostly-static scene pays for its movers, not its
+    // size. Like queue_draw_instanced_static, don't mix these with
+    // queue_draw/queue_draw_instanced/queue_draw_instanced_static for the
+    // same renderable_id (asserted against in debug builds), and a
+    // renderable that's still loading isn't proxied.
+    [[nodiscard]] auto create_instance(
+        RenderableId renderable_id, const Maths::Matrix4x4f& model_matrix
+    ) -> InstanceId;
+    auto update_instance(
+        InstanceId instance_id, const Maths::Matrix4x4f& model_matrix
+    ) -> void;
+    auto destroy_instance(InstanceId instance_id) -> void;
+
+    // Zero-copy alternative to queue_draw_instanced for this frame only:
+    // returns instance_count transforms of writable GPU staging memory for
+    // the caller to fill (see to_instance_transform) before the next draw(),
+    // which uploads them with a single copy - there's no CPU-side copy of
+    // them at all. world_bounds must enclose every mapped instance's
+    // geometry in world space; it's what CPU-side sorting and frustum tests
+    // use in place of the transforms, which are never read back. Returns an
+    // empty span if renderable_id can't be drawn this frame (still loading
+    // with no resident proxy). At most once per renderable_id per frame, and
+    // not mixed with the other draw APIs for the same renderable_id
+    // (asserted against in debug builds). In render-thread mode the span is
+    // CPU memory instead, copied to staging when draw() hands the frame off.
+    [[nodiscard]] auto map_instances(
+        RenderableId renderable_id,
+        uint32_t instance_count,
+        const BoundingBox& world_bounds
+    ) -> gsl::span<InstanceTransform>;
+
     auto queue_draw_text(
         FontId font_id,
         std::string_view text,
@@ -86,6 +172,20 @@ public:
 
     auto draw() -> void;
 
+    // Upper bound on bytes of finished create_renderable_async loads that
+    // draw() uploads per frame before moving on (at least one model is
+    // always uploaded, see SDL_GPUFactory::upload_completed_models) -
+    // trades how quickly a burst of loads becomes visible for how long any
+    // one frame stalls on the copies.
+    auto set_async_upload_budget(uint64_t bytes_per_frame) -> void;
+
+    // Threads draw() spreads its CPU frame preparation across (instance
+    // copies, light repacking, bounds, cull metadata, point/spot shadow
+    // culling), including the calling thread - 0 means one per hardware
+    // thread, 1 keeps it all on the calling thread. Takes effect from the
+    // next draw().
+    auto set_frame_prep_worker_count(uint32_t worker_count) -> void;
+
     auto set_debug_disable_occlusion_culling(bool disabled) -> void;
     auto debug_log_visible_instance_count() -> void;
     auto set_debug_visualize_hiz(bool enabled) -> void;
@@ -106,22 +206,119 @@ public:
     // to measure real render cost instead.
     auto set_debug_present_mode(PresentMode mode) -> void;
 
+    // Heap allocations (see Utilities::get_heap_allocation_count) made by
+    // every thread between the last two draw() returns - the whole frame,
+    // including the caller's queue_draw calls leading up to it. Always 0
+    // unless built with LUMINOL_RENDER_ENGINE_COUNT_HEAP_ALLOCATIONS; once
+    // the scene stops changing, it's expected to stay at 0.
+    [[nodiscard]] auto get_last_frame_heap_allocation_count() const
+        -> uint64_t;
+
+    // Per-frame upload traffic through the staging ring (see StagingRing)
+    // for the last draw() - bytes staged, allocations, and any waits on an
+    // earlier frame's fence, which mean the ring is undersized.
+    [[nodiscard]] auto get_last_frame_staging_stats() const
+        -> StagingRingFrameStats;
+
+    // Caps the VRAM clustered light culling's global light index list may
+    // grow to (see SDL_GPUClusterPass) - default_light_index_budget_bytes
+    // unless set. The list starts small and grows to what the scene needs
+    // within it; past that, clusters keep fewer, most important lights.
+    auto set_light_index_budget(uint32_t budget_bytes) -> void;
+    // The list's current size and per-cluster light limit, and the newest
+    // usage read back from the GPU that they were adapted to.
+    [[nodiscard]] auto get_light_index_list_settings() const
+        -> LightIndexListSettings;
+    [[nodiscard]] auto get_last_light_index_list_usage() const
+        -> LightIndexListUsage;
+
+    // Clustered (the default) or ZBinned light culling - see
+    // LightCullingMode. ZBinned costs a GPU sort of every light per frame
+    // but no per-cluster lists, so it holds up better with many lights
+    // crowded into few clusters.
+    auto set_light_culling_mode(LightCullingMode mode) -> void;
+    [[nodiscard]] auto get_light_culling_mode() const -> LightCullingMode;
+
+    // How many frames draw() lets the CPU queue ahead of the GPU, clamped to
+    // FramePacer's 1-3 - low_latency_frames_in_flight (1) trades GPU idle
+    // time for input latency, throughput_frames_in_flight (3) the reverse.
+    // Takes effect from the next draw(); changing it waits for the GPU to go
+    // idle once. Defaults to 2, which SDL_GPU's swapchain also assumes.
+    auto set_frames_in_flight(uint32_t count) -> void;
+    [[nodiscard]] auto get_frames_in_flight() const -> uint32_t;
+
+    // CPU-wait/GPU-wait breakdown and the non-blocking GPU frame time of the
+    // last draw() - see FramePacingStats. Also logged through
+    // performance_logger as "gpu_wait", "cpu_wait" and "gpu_frame".
+    [[nodiscard]] auto get_last_frame_pacing_stats() const
+        -> FramePacingStats;
+
+    // Render-thread mode: instead of recording the frame itself, draw()
+    // hands everything queued since the last draw() - camera, clear color,
+    // exposure, instance draws, lights and text - to a dedicated render
+    // thread as one frame packet and returns while that thread records and
+    // submits it, so the caller simulates the next frame meanwhile. A
+    // CPU-heavy loop then takes about max(simulation, rendering) per frame
+    // instead of their sum, for one frame of extra latency. draw() only
+    // blocks while the render thread is still busy with the previous frame
+    // (logged as "render_thread_wait").
+    //
+    // SDL_GPU ties swapchain acquisition to the window's thread, so draw()
+    // still acquires the swapchain and records the previous frame's
+    // tonemap/text pass itself, then hands off; every other pass runs on
+    // the render thread. Everything else here is still called from the
+    // thread calling draw() only. Setters the render thread reads (debug
+    // toggles, frames in flight, worker count) and resource creation wait
+    // for its frame to finish first. Off by default; switching waits for
+    // the render thread's frame to finish and presents it.
+    auto set_render_thread_enabled(bool enabled) -> void;
+    [[nodiscard]] auto is_render_thread_enabled() const -> bool;
+
 private:
-    // Empties queued_draws for the next frame without destroying its
-    // per-renderable vectors, so their heap capacity carries over instead of
-    // being freed and reallocated from scratch every frame.
+    // Empties queued_draws' frame arena for the next frame without
+    // releasing it, so its heap capacity carries over instead of being freed
+    // and reallocated from scratch every frame.
     auto clear_queued_draws() -> void;
 
+    // Where the queueing API writes: queued_draws itself, or in
+    // render-thread mode pending_frame's copy, handed off by draw().
+    [[nodiscard]] auto get_submission_queued_draws() -> QueuedDraws&;
+
+    // The lights this frame is recorded with: the caller's LightManager, or
+    // in render-thread mode render_light_manager, synced from it by draw().
+    [[nodiscard]] auto get_frame_light_manager() -> LightManager&;
+
+    // Uploads finished create_renderable_async loads within
+    // async_upload_budget_bytes. Each upload records and submits its own
+    // command buffer, so runs before the frame's own is created, landing
+    // ahead of the frame's draws in the queue.
+    auto upload_async_models() -> void;
+
     // Recreates all swapchain-resolution-dependent textures/passes when the
     // window has been resized since last frame.
-    auto handle_resize(const SwapchainTexture& swapchain) -> void;
+    auto handle_resize(uint32_t width, uint32_t height) -> void;
 
+    // Rewinds frame_arena and rolls the per-frame heap allocation count
+    // over - runs as draw() returns, on every path out of it.
+    auto end_frame_memory() -> void;
+    auto roll_over_heap_allocation_count() -> void;
+
+    // Everything draw() works out on the CPU before recording any pass.
+    // light_data is this frame's repacked light data, owned by the
+    // renderer's LightManager, with shadow casters already selected.
+    // Its lists are allocated from frame_arena.
     struct FramePrepData {
-        std::vector<InstanceBatch> instance_batches;
+        std::pmr::vector<InstanceBatch> instance_batches;
+        BatchMeshBounds batch_mesh_world_bounds;
+        const Light* light_data;
         std::array<Maths::Vector4f, 6> camera_frustum_planes;
         Maths::Matrix4x4f current_view_projection;
     };
-    [[nodiscard]] auto upload_instances_and_compute_frustum(
+    // Fans the independent stages out across job_system - shadow caster
+    // selection and light repacking run alongside the instance upload - and
+    // joins them all before returning, so nothing is still running once
+    // command recording starts.
+    [[nodiscard]] auto prepare_frame(
         CommandBuffer& command_buffer, const Maths::Vector4f& camera_position
     ) -> FramePrepData;
 
@@ -138,6 +335,48 @@ private:
     };
     [[nodiscard]] auto compute_camera_frame_data() const -> CameraFrameData;
 
+    // What the recording side of draw() reads instead of the setters'
+    // values, copied over by hand_off_frame() - so in render-thread mode
+    // the caller can already set up the next frame.
+    struct FrameSettings {
+        Maths::Matrix4x4f view_matrix = Maths::Matrix4x4f::identity();
+        Maths::Matrix4x4f projection_matrix = Maths::Matrix4x4f::identity();
+        Maths::Vector4f clear_color = {0.0F, 0.0F, 0.0F, 1.0F};
+        float exposure = 1.0F;
+    };
+
+    // Starts the frame's recording side: copies the camera, clear color and
+    // exposure into frame_settings and makes the queued text this frame's,
+    // plus hand_off_pending_frame() in render-thread mode.
+    auto hand_off_frame() -> void;
+
+    // Render-thread mode's hand-off of pending_frame into queued_draws (and
+    // map_instances' transforms into staging) and of the caller's lights
+    // into render_light_manager. Only while the render thread is idle.
+    auto hand_off_pending_frame() -> void;
+
+    // A recorded scene waiting for its tonemap/text pass into the
+    // swapchain - or, when visualize_hiz, for the Hi-Z debug blit instead
+    // (see record_debug_hiz_visualize).
+    struct RecordedFrame {
+        CameraFrameData camera;
+        bool visualize_hiz;
+    };
+
+    // Every pass up to the resolved HDR color, plus this frame's text
+    // upload. Returns false if debug_visualize_hiz cut it short right
+    // after the occlusion prepass.
+    [[nodiscard]] auto record_scene(
+        CommandBuffer& command_buffer, const CameraFrameData& camera
+    ) -> bool;
+
+    // The recorded scene's pass into the swapchain, then the HDR ping-pong.
+    auto record_present(
+        CommandBuffer& command_buffer,
+        const SwapchainTexture& swapchain,
+        const RecordedFrame& frame
+    ) -> void;
+
     // Two-phase GPU occlusion culling prepass (Hi-Z phase 1 build, phase-1
     // cull, occlusion-depth bootstrap draw, Hi-Z phase 2 build). Must run
     // before any render pass is opened this frame - see the comment on the
@@ -150,16 +389,13 @@ private:
         const Maths::Vector3f& camera_position
     ) -> void;
 
-    // Debug-only short-circuit: blits the Hi-Z pyramid to the swapchain
-    // instead of the normal scene. Returns true if the frame was short-
-    // circuited, in which case the caller must submit the command buffer,
-    // clear queued_draws, and return without recording the rest of the
-    // frame.
-    [[nodiscard]] auto record_debug_hiz_visualize(
+    // Debug-only: blits the Hi-Z pyramid to the swapchain instead of the
+    // normal scene, for a frame record_scene() cut short.
+    auto record_debug_hiz_visualize(
         CommandBuffer& command_buffer,
         const SwapchainTexture& swapchain,
         const CameraFrameData& camera
-    ) -> bool;
+    ) -> void;
 
     // AO must run before SSR - SSR consumes AO's same-frame normal texture.
     auto record_ao_and_ssr(
@@ -169,20 +405,21 @@ private:
     ) -> void;
 
     // Cluster light grid/cull, directional cascade shadows, point/spot
-    // shadows. Returns this frame's repacked light data (owned by the
-    // renderer's LightManager), consumed by record_main_pass afterward.
-    [[nodiscard]] auto record_shadows(
+    // shadows, from prepare_frame's light data and bounds.
+    auto record_shadows(
         CommandBuffer& command_buffer,
         gsl::span<const InstanceBatch> instance_batches,
+        const BatchMeshBounds& batch_mesh_world_bounds,
+        const Light& light_manager_data,
         const CameraFrameData& camera
-    ) -> const Light&;
+    ) -> void;
 
     // Forward mesh pass followed by the skybox, drawn into the same open
     // render pass.
     auto record_main_pass(
         CommandBuffer& command_buffer,
-        const SwapchainTexture& swapchain,
         gsl::span<const InstanceBatch> instance_batches,
+        const BatchMeshBounds& batch_mesh_world_bounds,
         const std::array<Maths::Vector4f, 6>& camera_frustum_planes,
         const InstanceCullLayout& instance_cull_layout,
         const MeshletCullLayout& meshlet_cull_layout,
@@ -195,10 +432,32 @@ private:
         CommandBuffer& command_buffer, const SwapchainTexture& swapchain
     ) -> void;
 
+    // Submits the frame through frame_pacer, closes staging_ring's frame on
+    // it, and records the frame's pacing samples - every path out of draw()
+    // that recorded anything ends here. In render-thread mode, the present
+    // command buffer's fence also covers the scene submitted before it.
+    auto submit_frame(CommandBuffer& command_buffer) -> void;
+
+    // draw() in render-thread mode: waits for the render thread's frame,
+    // presents it, hands off the next one and wakes the thread back up.
+    auto draw_with_render_thread() -> void;
+    // Acquires the swapchain for recorded_frame and submits its present
+    // pass, if the render thread left one.
+    auto present_recorded_frame() -> void;
+    auto wait_for_render_thread() -> void;
+    auto stop_render_thread() -> void;
+    auto run_render_thread() -> void;
+    // One frame on the render thread: everything but the present pass,
+    // submitted without a fence.
+    auto record_render_thread_frame() -> void;
+
     SDL_Window* sdl_window = nullptr;
 
     std::shared_ptr<SDL_GPUFactory> sdl_gpu_factory;
     std::shared_ptr<GPUDevice> gpu_device;
+    FramePacer frame_pacer;
+    // Every per-frame upload of every pass goes through this.
+    StagingRing staging_ring;
 
     SDL_GPUMeshRenderPass mesh_render_pass;
     SDL_GPUAmbientOcclusionPass ao_pass;
@@ -260,16 +519,30 @@ private:
 
     Utilities::PerformanceLogger performance_logger;
 
-    // is_static entries are exempt from clear_queued_draws()'s per-frame
-    // clear - their model_matrices are left populated across frames instead
-    // of being emptied. pending_static_upload marks ids that have been
-    // (re-)registered but not yet uploaded to the GPU, i.e. need exactly one
-    // instance buffer upload on the next draw() call - populated by
-    // queue_draw_instanced_static, drained once that upload has happened.
+    // Created on the first draw() after construction or
+    // set_frame_prep_worker_count, so changing the count right after
+    // construction doesn't spin up a pool only to tear it down again.
+    uint32_t frame_prep_worker_count = 0;
+    std::unique_ptr<Utilities::JobSystem> job_system;
+
+    // Backs every per-frame list draw() builds on the calling thread, so
+    // steady-state frames don't touch the heap; reset as draw() returns.
+    // Lists filled by parallel jobs live in their passes as scratch kept
+    // across frames instead, since the arena isn't thread-safe.
+    Utilities::FrameArena frame_arena;
+
+    // static_model_matrices are exempt from clear_queued_draws()'s per-frame
+    // clear - they stay populated across frames instead of being emptied.
+    // static_instances_dirty marks a static set that has changed (or gained
+    // a newly resident id) since the static arena was last uploaded, i.e.
+    // needs exactly one static arena upload on the next draw() call - set by
+    // queue_draw_instanced_static, cleared once that upload has happened.
     QueuedDraws queued_draws;
 
+    // The setters' values - draw() records from frame_settings instead.
     Maths::Matrix4x4f view_matrix = Maths::Matrix4x4f::identity();
     Maths::Matrix4x4f projection_matrix = Maths::Matrix4x4f::identity();
+    FrameSettings frame_settings;
 
     // False on the first frame and immediately after a resize, when
     // depth_texture/hiz_pass hold no valid previous-frame data - disables
@@ -284,8 +557,51 @@ private:
     // Debug-only: see set_debug_gpu_profiling_enabled.
     bool debug_gpu_profiling_enabled = false;
 
+    // See set_frames_in_flight.
+    uint32_t frames_in_flight = FramePacer::default_frames_in_flight;
+
     mutable Maths::Vector4f clear_color_value = {0.0F, 0.0F, 0.0F, 1.0F};
     float exposure = 1.0F;
+
+    uint64_t async_upload_budget_bytes = uint64_t{64} * 1024 * 1024;
+
+    // A map_instances call in render-thread mode, whose transforms wait in
+    // pending_frame's mapped_arena until hand-off - the staging ring
+    // belongs to the render thread meanwhile.
+    struct PendingMappedInstances {
+        RenderableId renderable_id;
+        gsl::span<InstanceTransform> transforms;
+    };
+
+    // The caller's half of render-thread mode's double-buffered frame
+    // packet, written by the queueing API while the render thread records
+    // from queued_draws. Its static and retained instances are
+    // authoritative in that mode; queued_draws only mirrors them.
+    struct PendingFrame {
+        QueuedDraws queued_draws;
+        Utilities::FrameArena mapped_arena;
+        std::vector<PendingMappedInstances> mapped_instances;
+    };
+    PendingFrame pending_frame;
+    // The render thread's copy of get_light_manager() - see
+    // LightManager::sync_lights_from.
+    LightManager render_light_manager;
+
+    // Hands one frame at a time to the render thread: draw() sets
+    // render_frame_pending, and the thread clears it once the frame's
+    // scene is submitted. Everything draw() reads or writes is otherwise
+    // left alone while it's set.
+    std::thread render_thread;
+    std::mutex render_thread_mutex;
+    std::condition_variable render_thread_condition;
+    bool render_frame_pending = false;
+    bool render_thread_stopping = false;
+    std::optional<RecordedFrame> recorded_frame;
+
+    // Last so construction's own allocations aren't charged to frame one.
+    uint64_t frame_heap_allocation_start =
+        Utilities::get_heap_allocation_count();
+    uint64_t last_frame_heap_allocation_count = 0;
 };
 
 }  // namespace Luminol::Graphics::SDL_GPU
@@ -1,10 +1,12 @@
 #include "SDL_GPUResourceBuilders.hpp"
 
-#include <cstring>
+#include <algorithm>
+#include <iterator>
 #include <optional>
 
 #include <SDL3/SDL_video.h>
 
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUCommandBuffer.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUDevice.hpp>
 
 namespace Luminol::Graphics::SDL_GPU {
@@ -18,16 +20,28 @@ auto get_window_size_in_pixels(SDL_Window* window)
     return {static_cast<uint32_t>(width), static_cast<uint32_t>(height)};
 }
 
-auto make_hlsl_shader(
-    GPUDevice& device,
+auto append_shader_compile_requests(
+    ShaderCompileRequests& all_requests, ShaderCompileRequests requests
+) -> void {
+    std::ranges::move(
+        requests.shaders, std::back_inserter(all_requests.shaders)
+    );
+    std::ranges::move(
+        requests.compute_pipelines,
+        std::back_inserter(all_requests.compute_pipelines)
+    );
+}
+
+auto make_hlsl_shader_info(
     const std::filesystem::path& path,
     ShaderStage stage,
     uint32_t sampler_count,
     uint32_t uniform_buffer_count,
     uint32_t storage_buffer_count,
-    uint32_t storage_texture_count
-) -> Shader {
-    return device.create_shader(ShaderInfo{
+    uint32_t storage_texture_count,
+    gsl::span<const ShaderDefine> defines
+) -> ShaderInfo {
+    return ShaderInfo{
         .path = path,
         .stage = stage,
         .source_language = ShaderSourceLanguage::Hlsl,
@@ -35,7 +49,32 @@ auto make_hlsl_shader(
         .uniform_buffer_count = uniform_buffer_count,
         .storage_buffer_count = storage_buffer_count,
         .storage_texture_count = storage_texture_count,
-    });
+        .defines = {defines.begin(), defines.end()},
+    };
+}
+
+auto get_fullscreen_vertex_shader_info() -> ShaderInfo {
+    return make_hlsl_shader_info(
+        "res/shaders/sdl_gpu/fullscreen_vert.hlsl", ShaderStage::Vertex
+    );
+}
+
+auto get_mesh_vertex_shader_info(VertexFormat vertex_format) -> ShaderInfo {
+    return make_hlsl_shader_info(
+        "res/shaders/sdl_gpu/pbr_vert.hlsl",
+        ShaderStage::Vertex,
+        0U,
+        mesh_vertex_uniform_buffer_count,
+        2U,
+        0U,
+        get_vertex_format_shader_defines(vertex_format)
+    );
+}
+
+auto get_depth_only_fragment_shader_info() -> ShaderInfo {
+    return make_hlsl_shader_info(
+        "res/shaders/sdl_gpu/shadow_depth_frag.hlsl", ShaderStage::Fragment
+    );
 }
 
 auto make_fullscreen_pipeline(
@@ -61,6 +100,7 @@ auto make_depth_only_mesh_pipeline(
     const Shader& vertex_shader,
     const Shader& fragment_shader,
     TextureFormat depth_stencil_format,
+    VertexFormat vertex_format,
     SampleCount sample_count
 ) -> GraphicsPipeline {
     return device.create_graphics_pipeline(GraphicsPipelineInfo{
@@ -68,8 +108,9 @@ auto make_depth_only_mesh_pipeline(
         .fragment_shader = fragment_shader,
         .color_target_format = std::nullopt,
         .primitive_type = PrimitiveType::TriangleList,
-        .vertex_buffer_descriptions = mesh_vertex_buffer_descriptions,
-        .vertex_attributes = mesh_vertex_attributes,
+        .vertex_buffer_descriptions =
+            get_mesh_vertex_buffer_descriptions(vertex_format),
+        .vertex_attributes = get_mesh_vertex_attributes(vertex_format),
         .enable_depth_test = true,
         .depth_stencil_format = depth_stencil_format,
         .cull_mode = CullMode::Back,
@@ -90,17 +131,15 @@ auto make_clamp_linear_sampler(
     });
 }
 
-auto upload_via_transfer(
-    CopyPass& copy_pass,
-    TransferBuffer& transfer_buffer,
-    const Buffer& buffer,
-    gsl::span<const std::byte> data
+auto push_vertex_dequantization(
+    CommandBuffer& command_buffer, const VertexDequantization& dequantization
 ) -> void {
-    const auto mapped = transfer_buffer.map(true);
-    std::memcpy(mapped.data(), data.data(), data.size());
-    transfer_buffer.unmap();
-    copy_pass.upload_to_buffer(
-        transfer_buffer, 0, buffer, 0, static_cast<uint32_t>(data.size()), true
+    command_buffer.push_vertex_uniform_data(
+        vertex_dequantization_uniform_slot,
+        gsl::span{
+            reinterpret_cast<const std::byte*>(&dequantization),
+            sizeof(dequantization)
+        }
     );
 }
 
@@ -5,75 +5,75 @@
 #include <cstdint>
 #include <filesystem>
 #include <utility>
+#include <vector>
 
 #include <gsl/gsl>
 
 #include <LuminolRenderEngine/Graphics/SDL_GPU/RenderPasses/SDL_GPUCopyPass.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUBuffer.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUComputePipeline.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUGraphicsPipeline.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUShader.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUTexture.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUTransferBuffer.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUTypes.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUVertexFormat.hpp>
 
 struct SDL_Window;
 
 namespace Luminol::Graphics::SDL_GPU {
 
+class CommandBuffer;
 class GPUDevice;
 
-// Shared vertex layout for the standard PBR mesh vertex format (position,
-// uv, normal, tangent) used by every pass that draws mesh geometry directly.
-constexpr auto mesh_vertex_stride_in_floats = 11U;
-constexpr auto mesh_vertex_stride_in_bytes =
-    sizeof(float) * mesh_vertex_stride_in_floats;
-
-constexpr auto mesh_vertex_buffer_descriptions = std::array{
-    VertexBufferDescription{
-        .slot = 0,
-        .pitch = mesh_vertex_stride_in_bytes,
-    },
-};
-
-constexpr auto mesh_vertex_attributes = std::array{
-    VertexAttribute{
-        .location = 0,
-        .buffer_slot = 0,
-        .format = VertexElementFormat::Float3,
-        .offset = 0,
-    },
-    VertexAttribute{
-        .location = 1,
-        .buffer_slot = 0,
-        .format = VertexElementFormat::Float2,
-        .offset = sizeof(float) * 3,
-    },
-    VertexAttribute{
-        .location = 2,
-        .buffer_slot = 0,
-        .format = VertexElementFormat::Float3,
-        .offset = sizeof(float) * 5,
-    },
-    VertexAttribute{
-        .location = 3,
-        .buffer_slot = 0,
-        .format = VertexElementFormat::Float3,
-        .offset = sizeof(float) * 8,
-    },
-};
+// Vertex uniform slot of cbuffer VertexDequantization in pbr_vert.hlsl /
+// pbr_vert_meshlet.hlsl (slot 0 is each pass's own view_proj UBO), so every
+// pass building those shaders declares 2 vertex uniform buffers.
+constexpr auto vertex_dequantization_uniform_slot = 1U;
+constexpr auto mesh_vertex_uniform_buffer_count =
+    vertex_dequantization_uniform_slot + 1U;
 
 [[nodiscard]] auto get_window_size_in_pixels(SDL_Window* window)
     -> std::pair<uint32_t, uint32_t>;
 
-[[nodiscard]] auto make_hlsl_shader(
-    GPUDevice& device,
+// Every shader and compute pipeline a render pass creates in its
+// constructor, as returned by its static get_shader_compile_requests - lets
+// SDL_GPURenderer compile all of them in parallel (see
+// GPUDevice::precompile_shaders) before constructing any pass. That function
+// takes the constructor's shader-affecting arguments (e.g. the vertex
+// format) and needs no device. Each pass builds both from the same *_info
+// functions, so the two can't drift apart.
+struct ShaderCompileRequests {
+    std::vector<ShaderInfo> shaders;
+    std::vector<ComputePipelineInfo> compute_pipelines;
+};
+
+// Appends everything in requests to all_requests.
+auto append_shader_compile_requests(
+    ShaderCompileRequests& all_requests, ShaderCompileRequests requests
+) -> void;
+
+[[nodiscard]] auto make_hlsl_shader_info(
     const std::filesystem::path& path,
     ShaderStage stage,
     uint32_t sampler_count = 0,
     uint32_t uniform_buffer_count = 0,
     uint32_t storage_buffer_count = 0,
-    uint32_t storage_texture_count = 0
-) -> Shader;
+    uint32_t storage_texture_count = 0,
+    gsl::span<const ShaderDefine> defines = {}
+) -> ShaderInfo;
+
+// fullscreen_vert.hlsl, shared by every fullscreen pass.
+[[nodiscard]] auto get_fullscreen_vertex_shader_info() -> ShaderInfo;
+
+// pbr_vert.hlsl for vertex_format, shared by every pass that draws meshes
+// through the regular (non-meshlet) vertex path.
+[[nodiscard]] auto get_mesh_vertex_shader_info(VertexFormat vertex_format)
+    -> ShaderInfo;
+
+// shadow_depth_frag.hlsl, the fragment half of every depth-only mesh
+// pipeline (see make_depth_only_mesh_pipeline).
+[[nodiscard]] auto get_depth_only_fragment_shader_info() -> ShaderInfo;
 
 // Fullscreen-triangle pipeline shape: no vertex input, depth test disabled,
 // no culling, single color target.
@@ -84,8 +84,9 @@ constexpr auto mesh_vertex_attributes = std::array{
     TextureFormat color_target_format
 ) -> GraphicsPipeline;
 
-// Depth-only mesh pipeline shape (e.g. shadow maps): standard mesh vertex
-// layout, no color target, depth test enabled, back-face culling.
+// Depth-only mesh pipeline shape (e.g. shadow maps): vertex_format's mesh
+// vertex layout (see get_mesh_vertex_attributes), no color target, depth
+// test enabled, back-face culling.
 // sample_count defaults to x1 (every current caller is a single-sample
 // depth/shadow map); pass the real value to build one matching an MSAA
 // color target's sample count instead (e.g. a depth pre-pass sharing the
@@ -95,6 +96,7 @@ constexpr auto mesh_vertex_attributes = std::array{
     const Shader& vertex_shader,
     const Shader& fragment_shader,
     TextureFormat depth_stencil_format,
+    VertexFormat vertex_format,
     SampleCount sample_count = SampleCount::x1
 ) -> GraphicsPipeline;
 
@@ -108,14 +110,12 @@ constexpr auto mesh_vertex_attributes = std::array{
     bool enable_mipmap_filtering = false
 ) -> Sampler;
 
-// Maps transfer_buffer, copies data into it, unmaps, then uploads it into
-// buffer via copy_pass. Caller owns sizing/growing both buffers beforehand -
-// this only performs the CPU-to-GPU staging copy.
-auto upload_via_transfer(
-    CopyPass& copy_pass,
-    TransferBuffer& transfer_buffer,
-    const Buffer& buffer,
-    gsl::span<const std::byte> data
+// Pushes a renderable's VertexDequantization (SDL_GPUFactory::
+// get_vertex_dequantization) to vertex_dequantization_uniform_slot - must
+// accompany every bind of that renderable's vertex buffer, in either vertex
+// format.
+auto push_vertex_dequantization(
+    CommandBuffer& command_buffer, const VertexDequantization& dequantization
 ) -> void;
 
 }  // namespace Luminol::Graphics::SDL_GPU
@@ -0,0 +1,143 @@
+#include "SDL_GPURetainedInstanceStore.hpp"
+
+namespace Luminol::Graphics::SDL_GPU {
+
+auto RetainedInstanceStore::create(
+    RenderableId renderable_id, const Maths::Matrix4x4f& model_matrix
+) -> InstanceId {
+    const auto instance_id = instance_ids.allocate().value();
+    if (instance_id >= instance_slots.size()) {
+        instance_slots.resize(instance_id + 1);
+    }
+    if (renderable_id >= renderables.size()) {
+        renderables.resize(renderable_id + 1);
+    }
+
+    auto& instances = renderables[renderable_id];
+    const auto slot = static_cast<uint32_t>(instances.model_matrices.size());
+    instances.model_matrices.push_back(model_matrix);
+    instances.instance_ids.push_back(instance_id);
+    instances.slot_dirty.push_back(0);
+
+    instance_slots[instance_id] = InstanceSlot{
+        .renderable_id = renderable_id,
+        .slot = slot,
+    };
+    mark_dirty(renderable_id, slot);
+
+    return instance_id;
+}
+
+auto RetainedInstanceStore::update(
+    InstanceId instance_id, const Maths::Matrix4x4f& model_matrix
+) -> void {
+    const auto& instance_slot = gsl::at(instance_slots, instance_id);
+    auto& instances = renderables[instance_slot.renderable_id];
+    instances.model_matrices[instance_slot.slot] = model_matrix;
+    mark_dirty(instance_slot.renderable_id, instance_slot.slot);
+}
+
+auto RetainedInstanceStore::destroy(InstanceId instance_id) -> void {
+    const auto instance_slot = gsl::at(instance_slots, instance_id);
+    auto& instances = renderables[instance_slot.renderable_id];
+
+    const auto last_slot =
+        static_cast<uint32_t>(instances.model_matrices.size() - 1);
+    if (instance_slot.slot != last_slot) {
+        const auto moved_instance_id = instances.instance_ids[last_slot];
+        instances.model_matrices[instance_slot.slot] =
+            instances.model_matrices[last_slot];
+        instances.instance_ids[instance_slot.slot] = moved_instance_id;
+        instance_slots[moved_instance_id].slot = instance_slot.slot;
+        mark_dirty(instance_slot.renderable_id, instance_slot.slot);
+    }
+
+    instances.model_matrices.pop_back();
+    instances.instance_ids.pop_back();
+    instances.slot_dirty.pop_back();
+    instance_ids.free(instance_id);
+}
+
+auto RetainedInstanceStore::get_model_matrices(
+    RenderableId renderable_id
+) const -> gsl::span<const Maths::Matrix4x4f> {
+    if (renderable_id >= renderables.size()) {
+        return {};
+    }
+    return renderables[renderable_id].model_matrices;
+}
+
+auto RetainedInstanceStore::get_renderable_count() const -> RenderableId {
+    return static_cast<RenderableId>(renderables.size());
+}
+
+auto RetainedInstanceStore::get_dirty_renderables() const
+    -> gsl::span<const RenderableId> {
+    return dirty_renderables;
+}
+
+auto RetainedInstanceStore::get_dirty_slots(RenderableId renderable_id) const
+    -> gsl::span<const uint32_t> {
+    return gsl::at(renderables, renderable_id).dirty_slots;
+}
+
+auto RetainedInstanceStore::clear_dirty() -> void {
+    for (const auto renderable_id : dirty_renderables) {
+        auto& instances = renderables[renderable_id];
+        for (const auto slot : instances.dirty_slots) {
+            if (slot < instances.slot_dirty.size()) {
+                instances.slot_dirty[slot] = 0;
+            }
+        }
+        instances.dirty_slots.clear();
+    }
+    dirty_renderables.clear();
+}
+
+auto RetainedInstanceStore::sync_from(const RetainedInstanceStore& source)
+    -> void {
+    if (renderables.size() < source.renderables.size()) {
+        renderables.resize(source.renderables.size());
+    }
+
+    // Every renderable, not just the dirty ones - destroying the last slot
+    // shrinks a renderable without dirtying anything.
+    for (auto renderable_id = RenderableId{0};
+         renderable_id < source.renderables.size();
+         ++renderable_id) {
+        const auto& source_instances = source.renderables[renderable_id];
+        auto& instances = renderables[renderable_id];
+
+        const auto instance_count = source_instances.model_matrices.size();
+        if (instances.model_matrices.size() != instance_count) {
+            instances.model_matrices.resize(instance_count);
+            instances.slot_dirty.resize(instance_count, 0);
+        }
+
+        for (const auto slot : source_instances.dirty_slots) {
+            if (slot >= instance_count) {
+                continue;
+            }
+            instances.model_matrices[slot] =
+                source_instances.model_matrices[slot];
+            mark_dirty(renderable_id, slot);
+        }
+    }
+}
+
+auto RetainedInstanceStore::mark_dirty(
+    RenderableId renderable_id, uint32_t slot
+) -> void {
+    auto& instances = renderables[renderable_id];
+    if (instances.slot_dirty[slot] != 0) {
+        return;
+    }
+
+    if (instances.dirty_slots.empty()) {
+        dirty_renderables.push_back(renderable_id);
+    }
+    instances.slot_dirty[slot] = 1;
+    instances.dirty_slots.push_back(slot);
+}
+
+}  // namespace Luminol::Graphics::SDL_GPU
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <gsl/gsl>
+#include <LuminolMaths/Matrix.hpp>
+
+#include <LuminolRenderEngine/Graphics/IdPool.hpp>
+#include <LuminolRenderEngine/Graphics/RenderableManager.hpp>
+
+namespace Luminol::Graphics::SDL_GPU {
+
+// CPU-side storage for retained instances (SDL_GPURenderer::create_instance
+// and friends): instances that persist across frames until destroyed, so
+// only the ones that actually changed need uploading again.
+//
+// Each renderable's instances are kept dense (destroy swaps the last
+// instance into the freed slot), so they upload and draw as one contiguous
+// range. Every write marks its slot dirty; SDL_GPUInstanceBufferCache::
+// upload_retained_instances uploads just those slots and then calls
+// clear_dirty().
+class RetainedInstanceStore {
+public:
+    [[nodiscard]] auto create(
+        RenderableId renderable_id, const Maths::Matrix4x4f& model_matrix
+    ) -> InstanceId;
+    auto update(InstanceId instance_id, const Maths::Matrix4x4f& model_matrix)
+        -> void;
+    auto destroy(InstanceId instance_id) -> void;
+
+    // renderable_id's live instances, in slot order.
+    [[nodiscard]] auto get_model_matrices(RenderableId renderable_id) const
+        -> gsl::span<const Maths::Matrix4x4f>;
+
+    // One past the largest renderable id that has ever had a retained
+    // instance.
+    [[nodiscard]] auto get_renderable_count() const -> RenderableId;
+
+    // Renderables with at least one dirty slot since the last clear_dirty().
+    [[nodiscard]] auto get_dirty_renderables() const
+        -> gsl::span<const RenderableId>;
+
+    // renderable_id's slots written since the last clear_dirty(), unsorted
+    // and possibly including slots past the end that a destroy() has since
+    // removed (callers skip those).
+    [[nodiscard]] auto get_dirty_slots(RenderableId renderable_id) const
+        -> gsl::span<const uint32_t>;
+
+    auto clear_dirty() -> void;
+
+    // Brings this store's matrices up to date with source's by copying just
+    // the slots source has marked dirty (and trimming renderables source has
+    // shrunk), marking each one dirty here in turn - for a second copy that
+    // another thread uploads from while source keeps taking writes (see
+    // SDL_GPURenderer::set_render_thread_enabled). Instance ids aren't
+    // mirrored, so the copy is read-only: never create/update/destroy on it.
+    auto sync_from(const RetainedInstanceStore& source) -> void;
+
+private:
+    struct InstanceSlot {
+        RenderableId renderable_id;
+        uint32_t slot;
+    };
+
+    struct RenderableInstances {
+        std::vector<Maths::Matrix4x4f> model_matrices;
+        // slot -> InstanceId, so destroy() can re-point the instance it
+        // swaps into the freed slot.
+        std::vector<InstanceId> instance_ids;
+        std::vector<uint32_t> dirty_slots;
+        // Per slot, so a slot updated several times between uploads is
+        // only listed once in dirty_slots.
+        std::vector<std::uint8_t> slot_dirty;
+    };
+
+    auto mark_dirty(RenderableId renderable_id, uint32_t slot) -> void;
+
+    IdPool<InstanceId> instance_ids;
+    // Indexed directly by InstanceId.
+    std::vector<InstanceSlot> instance_slots;
+    // Indexed directly by RenderableId.
+    std::vector<RenderableInstances> renderables;
+    std::vector<RenderableId> dirty_renderables;
+};
+
+}  // namespace Luminol::Graphics::SDL_GPU
@@ -6,6 +6,24 @@
 
 namespace Luminol::Graphics::SDL_GPU {
 
+auto get_precompiled_spirv_path(
+    const std::filesystem::path& hlsl_path,
+    gsl::span<const ShaderDefine> defines
+) -> std::filesystem::path {
+    auto file_name = hlsl_path.stem().string();
+    for (const auto& define : defines) {
+        file_name += '.';
+        file_name += define.name;
+        if (define.value != "1") {
+            file_name += '=';
+            file_name += define.value;
+        }
+    }
+    file_name += ".spv";
+
+    return hlsl_path.parent_path() / "spirv" / file_name;
+}
+
 Shader::Shader(std::unique_ptr<SDL_GPUShader, SDL_GPUShaderDeleter> shader)
     : shader{std::move(shader)} {
     Expects(this->shader);
@@ -4,6 +4,9 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <vector>
+
+#include <gsl/gsl>
 
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUTypes.hpp>
 
@@ -11,6 +14,13 @@ struct SDL_GPUShader;
 
 namespace Luminol::Graphics::SDL_GPU {
 
+// A preprocessor define passed to the HLSL compiler, equivalent to
+// "#define name value" at the top of the source. Ignored for SpirvBinary.
+struct ShaderDefine {
+    std::string name;
+    std::string value = "1";
+};
+
 struct ShaderInfo {
     std::filesystem::path path;
     ShaderStage stage;
@@ -20,8 +30,18 @@ struct ShaderInfo {
     uint32_t uniform_buffer_count = {0};
     uint32_t storage_buffer_count = {0};
     uint32_t storage_texture_count = {0};
+    std::vector<ShaderDefine> defines;
 };
 
+// Where the compile-shaders build target (cmake/CompileShaders.cmake) writes
+// the SPIR-V for hlsl_path built with defines: a spirv/ folder next to the
+// HLSL, named after its stem plus one ".NAME" (or ".NAME=value", for values
+// other than "1") suffix per define, in order.
+[[nodiscard]] auto get_precompiled_spirv_path(
+    const std::filesystem::path& hlsl_path,
+    gsl::span<const ShaderDefine> defines
+) -> std::filesystem::path;
+
 class Shader {
 public:
     using SDL_GPUShaderDeleter = std::function<void(SDL_GPUShader*)>;
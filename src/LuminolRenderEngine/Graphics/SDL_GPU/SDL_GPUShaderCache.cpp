@@ -0,0 +1,217 @@
+#include "SDL_GPUShaderCache.hpp"
+
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+#include <SDL3/SDL_log.h>
+
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUMeshCache.hpp>
+
+namespace {
+
+using namespace Luminol::Graphics::SDL_GPU;
+
+constexpr auto cache_magic =
+    std::array<char, 8>{'L', 'M', 'N', 'S', 'P', 'I', 'R', 'V'};
+
+// First word of every SPIR-V module.
+constexpr auto spirv_magic = uint32_t{0x07230203};
+
+struct ShaderCacheHeader {
+    std::array<char, 8> magic;
+    uint32_t version;
+    // Catches a header compiled with a different layout that forgot to bump
+    // shader_cache_version.
+    uint32_t header_size;
+    uint64_t key;
+    ShaderResourceCounts resource_counts;
+    uint32_t padding;
+    uint64_t spirv_size;
+    // hash_bytes over the SPIR-V - a flipped bit anywhere in the module is a
+    // miss instead of a driver crash at pipeline creation.
+    uint64_t spirv_hash;
+};
+
+static_assert(std::is_trivially_copyable_v<ShaderCacheHeader>);
+
+auto hash_string(uint64_t seed, std::string_view text) -> uint64_t {
+    // Length first, so ("ab", "c") and ("a", "bc") hash differently.
+    const auto length = static_cast<uint64_t>(text.size());
+    const auto hash = hash_bytes(seed, gsl::as_bytes(gsl::span{&length, 1}));
+    return hash_bytes(
+        hash, gsl::as_bytes(gsl::span<const char>{text.data(), text.size()})
+    );
+}
+
+auto log_corrupt_entry(
+    const std::filesystem::path& cache_path, const char* reason
+) -> void {
+    SDL_Log(
+        "[ShaderCache] discarding %s: %s", cache_path.string().c_str(), reason
+    );
+}
+
+}  // namespace
+
+namespace Luminol::Graphics::SDL_GPU {
+
+auto get_shader_cache_directory() -> std::filesystem::path {
+    return std::filesystem::path{"cache"} / "shaders";
+}
+
+auto get_shader_cache_path(uint64_t key) -> std::filesystem::path {
+    constexpr auto hex_digits = std::string_view{"0123456789abcdef"};
+
+    auto file_name = std::string(16, '0');
+    for (auto i = std::size_t{0}; i < file_name.size(); ++i) {
+        const auto shift = (file_name.size() - 1 - i) * 4;
+        file_name[i] = hex_digits[(key >> shift) & 0xFU];
+    }
+
+    return get_shader_cache_directory() / (file_name + ".lspv");
+}
+
+auto compute_shader_cache_key(
+    std::string_view hlsl_source,
+    std::string_view entrypoint,
+    ShaderStage stage,
+    gsl::span<const ShaderDefine> defines,
+    std::string_view compiler_revision
+) -> uint64_t {
+    auto hash = hash_bytes(
+        mesh_cache_hash_seed,
+        gsl::as_bytes(gsl::span{&shader_cache_version, 1})
+    );
+    hash = hash_string(hash, compiler_revision);
+    hash = hash_string(hash, hlsl_source);
+    hash = hash_string(hash, entrypoint);
+    hash = hash_bytes(hash, gsl::as_bytes(gsl::span{&stage, 1}));
+    for (const auto& define : defines) {
+        hash = hash_string(hash, define.name);
+        hash = hash_string(hash, define.value);
+    }
+    return hash;
+}
+
+auto read_shader_cache(const std::filesystem::path& cache_path, uint64_t key)
+    -> std::optional<ShaderCacheEntry> {
+    auto stream = std::ifstream{cache_path, std::ios::binary | std::ios::ate};
+    if (!stream) {
+        return std::nullopt;
+    }
+
+    const auto file_size = static_cast<uint64_t>(stream.tellg());
+    stream.seekg(0, std::ios::beg);
+
+    auto header = ShaderCacheHeader{};
+    if (file_size < sizeof(ShaderCacheHeader) ||
+        !stream.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        log_corrupt_entry(cache_path, "truncated header");
+        return std::nullopt;
+    }
+
+    if (header.magic != cache_magic ||
+        header.header_size != sizeof(ShaderCacheHeader)) {
+        log_corrupt_entry(cache_path, "not a shader cache entry");
+        return std::nullopt;
+    }
+    // An older layout or a (vanishingly unlikely) file name collision -
+    // stale rather than corrupt, so not worth a log line.
+    if (header.version != shader_cache_version || header.key != key) {
+        return std::nullopt;
+    }
+    if (header.spirv_size != file_size - sizeof(ShaderCacheHeader) ||
+        header.spirv_size < sizeof(uint32_t) ||
+        header.spirv_size % sizeof(uint32_t) != 0) {
+        log_corrupt_entry(cache_path, "SPIR-V size mismatch");
+        return std::nullopt;
+    }
+
+    auto entry = ShaderCacheEntry{
+        .resource_counts = header.resource_counts,
+        .spirv = std::vector<uint8_t>(header.spirv_size),
+    };
+    if (!stream.read(
+            reinterpret_cast<char*>(entry.spirv.data()),
+            static_cast<std::streamsize>(entry.spirv.size())
+        )) {
+        log_corrupt_entry(cache_path, "truncated SPIR-V");
+        return std::nullopt;
+    }
+
+    auto first_word = uint32_t{0};
+    std::memcpy(&first_word, entry.spirv.data(), sizeof(first_word));
+    if (first_word != spirv_magic ||
+        hash_bytes(mesh_cache_hash_seed, gsl::as_bytes(gsl::span{entry.spirv})
+        ) != header.spirv_hash) {
+        log_corrupt_entry(cache_path, "SPIR-V checksum mismatch");
+        return std::nullopt;
+    }
+
+    return entry;
+}
+
+auto write_shader_cache(
+    const std::filesystem::path& cache_path,
+    uint64_t key,
+    const ShaderCacheEntry& entry
+) -> bool {
+    const auto header = ShaderCacheHeader{
+        .magic = cache_magic,
+        .version = shader_cache_version,
+        .header_size = sizeof(ShaderCacheHeader),
+        .key = key,
+        .resource_counts = entry.resource_counts,
+        .padding = 0,
+        .spirv_size = entry.spirv.size(),
+        .spirv_hash = hash_bytes(
+            mesh_cache_hash_seed, gsl::as_bytes(gsl::span{entry.spirv})
+        ),
+    };
+
+    auto error = std::error_code{};
+    std::filesystem::create_directories(cache_path.parent_path(), error);
+
+    auto temporary_path = cache_path;
+    temporary_path += ".tmp";
+
+    {
+        auto stream = std::ofstream{
+            temporary_path, std::ios::binary | std::ios::trunc
+        };
+        if (!stream) {
+            return false;
+        }
+
+        stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        stream.write(
+            reinterpret_cast<const char*>(entry.spirv.data()),
+            static_cast<std::streamsize>(entry.spirv.size())
+        );
+
+        if (!stream) {
+            stream.close();
+            std::filesystem::remove(temporary_path, error);
+            return false;
+        }
+    }
+
+    std::filesystem::rename(temporary_path, cache_path, error);
+    if (error) {
+        SDL_Log(
+            "[ShaderCache] failed to store %s: %s",
+            cache_path.string().c_str(),
+            error.message().c_str()
+        );
+        std::filesystem::remove(temporary_path, error);
+        return false;
+    }
+
+    return true;
+}
+
+}  // namespace Luminol::Graphics::SDL_GPU
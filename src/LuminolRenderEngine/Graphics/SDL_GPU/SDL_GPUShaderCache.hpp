@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include <gsl/gsl>
+
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUShader.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUTypes.hpp>
+
+namespace Luminol::Graphics::SDL_GPU {
+
+// Bump whenever the on-disk layout below changes. Compiler upgrades don't
+// need a bump - the compiler revision is part of every key.
+inline constexpr auto shader_cache_version = uint32_t{1};
+
+// The resource counts a shader or compute pipeline is created with
+// (ShaderInfo / ComputePipelineInfo), stored next to its SPIR-V. Graphics
+// shaders leave the compute-only fields zero. This engine declares the
+// counts in each pass's ShaderInfo rather than reflecting them from the
+// SPIR-V, so an entry whose counts no longer match the request is treated
+// as stale rather than trusted.
+struct ShaderResourceCounts {
+    uint32_t sampler_count = 0;
+    uint32_t uniform_buffer_count = 0;
+    uint32_t storage_buffer_count = 0;
+    uint32_t storage_texture_count = 0;
+    uint32_t readonly_storage_texture_count = 0;
+    uint32_t readonly_storage_buffer_count = 0;
+    uint32_t readwrite_storage_texture_count = 0;
+    uint32_t readwrite_storage_buffer_count = 0;
+    uint32_t threadcount_x = 0;
+    uint32_t threadcount_y = 0;
+    uint32_t threadcount_z = 0;
+
+    auto operator==(const ShaderResourceCounts&) const -> bool = default;
+};
+
+struct ShaderCacheEntry {
+    ShaderResourceCounts resource_counts;
+    std::vector<uint8_t> spirv;
+};
+
+// Where cache files live, relative to the working directory - next to the
+// mesh cache (see get_mesh_cache_directory).
+[[nodiscard]] auto get_shader_cache_directory() -> std::filesystem::path;
+
+// Content-addressed path for key inside get_shader_cache_directory().
+[[nodiscard]] auto get_shader_cache_path(uint64_t key) -> std::filesystem::path;
+
+// Cache key = FNV-1a over shader_cache_version, compiler_revision (which
+// shadercross, and so which vendored DXC, produced the SPIR-V), the HLSL
+// source text, entrypoint, stage and every define. Include files aren't
+// followed - none of this engine's shaders use any.
+[[nodiscard]] auto compute_shader_cache_key(
+    std::string_view hlsl_source,
+    std::string_view entrypoint,
+    ShaderStage stage,
+    gsl::span<const ShaderDefine> defines,
+    std::string_view compiler_revision
+) -> uint64_t;
+
+// std::nullopt on a miss - no file, or one that's truncated, written for a
+// different key or layout, or whose SPIR-V fails its checksum. Corrupt
+// entries are logged; callers recompile and overwrite them.
+[[nodiscard]] auto read_shader_cache(
+    const std::filesystem::path& cache_path, uint64_t key
+) -> std::optional<ShaderCacheEntry>;
+
+// Same temporary-file-and-rename scheme as write_mesh_cache, and likewise
+// returns false (leaving no file behind) on any I/O failure.
+auto write_shader_cache(
+    const std::filesystem::path& cache_path,
+    uint64_t key,
+    const ShaderCacheEntry& entry
+) -> bool;
+
+}  // namespace Luminol::Graphics::SDL_GPU
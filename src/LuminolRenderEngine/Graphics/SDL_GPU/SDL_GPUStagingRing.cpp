@@ -0,0 +1,230 @@
+#include "SDL_GPUStagingRing.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#include <LuminolRenderEngine/Graphics/SDL_GPU/RenderPasses/SDL_GPUCopyPass.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUBuffer.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUDevice.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUFramePacer.hpp>
+#include <LuminolRenderEngine/Utilities/Timer.hpp>
+
+namespace Luminol::Graphics::SDL_GPU {
+
+namespace {
+
+// More than FramePacer ever lets be in flight, so tracking them never
+// allocates.
+constexpr auto max_expected_frames_in_flight = std::size_t{8};
+
+auto align_up(uint32_t size, uint32_t alignment) -> uint32_t {
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+}  // namespace
+
+StagingRing::StagingRing(
+    std::shared_ptr<GPUDevice> device,
+    FramePacer& frame_pacer,
+    uint32_t capacity
+)
+    : device{std::move(device)}, frame_pacer{&frame_pacer} {
+    Expects(this->device != nullptr);
+
+    in_flight_frames.reserve(max_expected_frames_in_flight);
+    push_buffer(std::max(capacity, allocation_alignment));
+}
+
+StagingRing::~StagingRing() {
+    for (auto& buffer : buffers) {
+        unmap(buffer);
+    }
+}
+
+auto StagingRing::allocate(uint32_t size) -> StagingAllocation {
+    if (size == 0) {
+        return {};
+    }
+
+    const auto aligned_size = align_up(size, allocation_alignment);
+
+    reclaim_completed_frames();
+    auto offset = reserve(aligned_size);
+    while (offset == capacity) {
+        const auto frame_size = allocated_end - frame_begin + aligned_size;
+        if (in_flight_frames.empty() ||
+            frame_size > capacity / min_frames_per_capacity) {
+            grow(aligned_size);
+        } else {
+            wait_for_oldest_frame();
+        }
+        offset = reserve(aligned_size);
+    }
+
+    auto& buffer = buffers.back();
+    if (buffer.mapped.empty()) {
+        // No cycling - reserve() already kept this range clear of every
+        // frame the GPU may still be reading.
+        buffer.mapped = buffer.transfer_buffer.map(false);
+    }
+
+    frame_stats.bytes_staged += size;
+    ++frame_stats.allocation_count;
+
+    return StagingAllocation{
+        .memory = buffer.mapped.subspan(offset, size),
+        .offset = offset,
+        .transfer_buffer_index = static_cast<uint32_t>(buffers.size() - 1),
+    };
+}
+
+auto StagingRing::upload(
+    CopyPass& copy_pass,
+    const StagingAllocation& allocation,
+    uint32_t source_offset,
+    const Buffer& destination,
+    uint32_t destination_offset,
+    uint32_t size,
+    bool cycle
+) -> void {
+    Expects(source_offset + size <= allocation.memory.size());
+
+    auto& buffer = gsl::at(buffers, allocation.transfer_buffer_index);
+    unmap(buffer);
+    copy_pass.upload_to_buffer(
+        buffer.transfer_buffer, allocation.offset + source_offset, destination,
+        destination_offset, size, cycle
+    );
+}
+
+auto StagingRing::upload(
+    CopyPass& copy_pass,
+    const StagingAllocation& allocation,
+    const Buffer& destination
+) -> void {
+    upload(
+        copy_pass, allocation, 0, destination, 0,
+        static_cast<uint32_t>(allocation.memory.size()), true
+    );
+}
+
+auto StagingRing::upload(
+    CopyPass& copy_pass,
+    const Buffer& destination,
+    gsl::span<const std::byte> data
+) -> void {
+    const auto allocation = allocate(static_cast<uint32_t>(data.size()));
+    if (allocation.memory.empty()) {
+        return;
+    }
+
+    std::memcpy(allocation.memory.data(), data.data(), data.size());
+    upload(copy_pass, allocation, destination);
+}
+
+auto StagingRing::end_frame(uint64_t frame) -> void {
+    in_flight_frames.push_back(InFlightFrame{
+        .end = allocated_end,
+        .frame = frame,
+    });
+    frame_begin = allocated_end;
+
+    for (auto& buffer : buffers) {
+        unmap(buffer);
+    }
+    // SDL_GPU defers releasing outgrown buffers until the GPU is done
+    // with them.
+    if (buffers.size() > 1) {
+        buffers.erase(buffers.begin(), buffers.end() - 1);
+    }
+
+    last_frame_stats = frame_stats;
+    frame_stats = StagingRingFrameStats{};
+
+    reclaim_completed_frames();
+}
+
+auto StagingRing::get_last_frame_stats() const -> StagingRingFrameStats {
+    return last_frame_stats;
+}
+
+auto StagingRing::get_capacity() const -> uint32_t { return capacity; }
+
+auto StagingRing::reserve(uint32_t size) -> uint32_t {
+    const auto offset = static_cast<uint32_t>(allocated_end % capacity);
+    // An allocation never straddles the end - it skips to the start instead.
+    const auto padding = offset + uint64_t{size} > capacity
+        ? uint64_t{capacity - offset}
+        : uint64_t{0};
+
+    if (allocated_end - reclaimed_end + padding + size > capacity) {
+        return capacity;
+    }
+
+    allocated_end += padding + size;
+    return padding == 0 ? offset : 0U;
+}
+
+auto StagingRing::reclaim_completed_frames() -> void {
+    frame_pacer->poll();
+
+    auto completed = std::size_t{0};
+    while (completed < in_flight_frames.size() &&
+           frame_pacer->is_frame_complete(in_flight_frames[completed].frame)) {
+        reclaimed_end = in_flight_frames[completed].end;
+        ++completed;
+    }
+
+    in_flight_frames.erase(
+        in_flight_frames.begin(),
+        in_flight_frames.begin() + static_cast<std::ptrdiff_t>(completed)
+    );
+}
+
+auto StagingRing::wait_for_oldest_frame() -> void {
+    Expects(!in_flight_frames.empty());
+
+    const auto wait_timer = Utilities::Timer{};
+    frame_pacer->wait_for_frame(in_flight_frames.front().frame);
+    ++frame_stats.fence_wait_count;
+    frame_stats.fence_wait_time += Units::Seconds{wait_timer.elapsed_seconds()};
+
+    reclaim_completed_frames();
+}
+
+auto StagingRing::grow(uint32_t size) -> void {
+    const auto frame_size = allocated_end - frame_begin + size;
+    const auto new_capacity = static_cast<uint32_t>(std::bit_ceil(std::max(
+        uint64_t{capacity} * 2, frame_size * min_frames_per_capacity
+    )));
+
+    // In-flight frames only read the old buffer, so they no longer gate
+    // anything.
+    in_flight_frames.clear();
+
+    push_buffer(new_capacity);
+}
+
+auto StagingRing::push_buffer(uint32_t new_capacity) -> void {
+    buffers.push_back(RingBuffer{
+        .transfer_buffer = device->create_transfer_buffer(TransferBufferInfo{
+            .usage = TransferBufferUsage::Upload,
+            .size = new_capacity,
+        }),
+    });
+    capacity = new_capacity;
+
+    allocated_end = 0;
+    reclaimed_end = 0;
+    frame_begin = 0;
+}
+
+auto StagingRing::unmap(RingBuffer& buffer) -> void {
+    if (!buffer.mapped.empty()) {
+        buffer.transfer_buffer.unmap();
+        buffer.mapped = {};
+    }
+}
+
+}  // namespace Luminol::Graphics::SDL_GPU
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <gsl/gsl>
+#include <LuminolMaths/Units/Time.hpp>
+
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUTransferBuffer.hpp>
+
+namespace Luminol::Graphics::SDL_GPU {
+
+class Buffer;
+class CopyPass;
+class FramePacer;
+class GPUDevice;
+
+// A sub-range of the staging ring handed out by StagingRing::allocate().
+struct StagingAllocation {
+    gsl::span<uint8_t> memory = {};
+    // Byte offset of memory within its transfer buffer.
+    uint32_t offset = 0;
+    // Which of the ring's transfer buffers memory is in - see
+    // StagingRing::allocate().
+    uint32_t transfer_buffer_index = 0;
+};
+
+// Upload traffic of one frame, for measuring and budgeting upload bandwidth.
+struct StagingRingFrameStats {
+    // Bytes handed out, alignment padding excluded.
+    uint64_t bytes_staged = 0;
+    uint32_t allocation_count = 0;
+    // Times the ring was full and had to wait on an earlier frame,
+    // and the time spent waiting - both should stay 0 once it's sized.
+    uint32_t fence_wait_count = 0;
+    Units::Seconds fence_wait_time{0.0};
+};
+
+// Device-level staging for every per-frame upload: one large upload transfer
+// buffer that allocate() bump-allocates from, wrapping around as a ring.
+// end_frame() takes the FramePacer frame that consumed the frame's
+// allocations, and the frame's range is only handed out again once that
+// frame completes - so unlike a cycled transfer buffer, nothing is created
+// or renamed per frame, several frames stay in flight at once, and all
+// upload traffic is counted in one place (get_last_frame_stats()).
+//
+// When the ring is full, allocate() first waits on the oldest in-flight
+// frame, and only grows - to a fresh buffer holding at least
+// min_frames_per_capacity frames like the current one - when this frame
+// alone outgrows its share. Growing mid-frame keeps the old buffer alive
+// until end_frame(), since this frame's earlier allocations live in it.
+//
+// upload() unmaps the ring (SDL_GPU requires a transfer buffer to be
+// unmapped while its copies are recorded), so an allocation's memory must be
+// written before the next upload() - allocate, fill, then upload, as every
+// pass does. Filling from jobs in parallel is fine; calling the ring itself
+// isn't thread-safe - one thread at a time, handing it over under a lock
+// (see SDL_GPURenderer's render thread).
+class StagingRing {
+public:
+    constexpr static auto default_capacity = uint32_t{16} << 20U;
+    constexpr static auto min_frames_per_capacity = uint32_t{3};
+    // Every allocation starts on this boundary, which covers every type
+    // staged through the ring.
+    constexpr static auto allocation_alignment = uint32_t{16};
+
+    // frame_pacer must outlive the ring.
+    StagingRing(
+        std::shared_ptr<GPUDevice> device,
+        FramePacer& frame_pacer,
+        uint32_t capacity = default_capacity
+    );
+
+    StagingRing(const StagingRing&) = delete;
+    StagingRing(StagingRing&&) = delete;
+    auto operator=(const StagingRing&) -> StagingRing& = delete;
+    auto operator=(StagingRing&&) -> StagingRing& = delete;
+    ~StagingRing();
+
+    // size bytes of mapped staging memory for this frame. Empty for a size
+    // of 0.
+    [[nodiscard]] auto allocate(uint32_t size) -> StagingAllocation;
+
+    // Records a copy of size bytes, source_offset bytes into allocation, to
+    // destination at destination_offset. allocation must be from this frame.
+    auto upload(
+        CopyPass& copy_pass,
+        const StagingAllocation& allocation,
+        uint32_t source_offset,
+        const Buffer& destination,
+        uint32_t destination_offset,
+        uint32_t size,
+        bool cycle
+    ) -> void;
+
+    // Copies all of allocation to the start of destination, cycling it.
+    auto upload(
+        CopyPass& copy_pass,
+        const StagingAllocation& allocation,
+        const Buffer& destination
+    ) -> void;
+
+    // Stages data and copies it to the start of destination, cycling it.
+    auto upload(
+        CopyPass& copy_pass,
+        const Buffer& destination,
+        gsl::span<const std::byte> data
+    ) -> void;
+
+    // Closes the frame: frame (from FramePacer::submit() of the command
+    // buffer every allocation since the last end_frame() was recorded into)
+    // gates reuse of its range.
+    auto end_frame(uint64_t frame) -> void;
+
+    [[nodiscard]] auto get_last_frame_stats() const -> StagingRingFrameStats;
+    [[nodiscard]] auto get_capacity() const -> uint32_t;
+
+private:
+    struct RingBuffer {
+        TransferBuffer transfer_buffer;
+        // Empty while the buffer isn't mapped.
+        gsl::span<uint8_t> mapped = {};
+    };
+
+    // A submitted frame: everything before end is free once frame_pacer
+    // reports frame complete.
+    struct InFlightFrame {
+        uint64_t end = 0;
+        uint64_t frame = 0;
+    };
+
+    // Offset of size bytes in the current buffer, or capacity if they don't
+    // fit without overwriting an in-flight frame.
+    [[nodiscard]] auto reserve(uint32_t size) -> uint32_t;
+
+    auto reclaim_completed_frames() -> void;
+    auto wait_for_oldest_frame() -> void;
+    auto grow(uint32_t size) -> void;
+
+    auto push_buffer(uint32_t capacity) -> void;
+    auto unmap(RingBuffer& buffer) -> void;
+
+    std::shared_ptr<GPUDevice> device;
+    FramePacer* frame_pacer;
+
+    // Allocation only ever comes from the last buffer - earlier ones were
+    // outgrown this frame and are released by end_frame().
+    std::vector<RingBuffer> buffers;
+    uint32_t capacity = 0;
+
+    // Running byte positions in the current buffer, wrap padding included,
+    // taken modulo capacity for offsets: everything in [reclaimed_end,
+    // allocated_end) may still be read by the GPU or written by this frame.
+    uint64_t allocated_end = 0;
+    uint64_t reclaimed_end = 0;
+    uint64_t frame_begin = 0;
+
+    // Oldest first.
+    std::vector<InFlightFrame> in_flight_frames;
+
+    StagingRingFrameStats frame_stats;
+    StagingRingFrameStats last_frame_stats;
+};
+
+}  // namespace Luminol::Graphics::SDL_GPU
@@ -35,6 +35,10 @@ auto Texture::get_height() const -> uint32_t { return height; }
 
 auto Texture::get_mip_levels() const -> uint32_t { return mip_levels; }
 
+auto Texture::get_use_count() const -> uint32_t {
+    return static_cast<uint32_t>(texture.use_count());
+}
+
 Sampler::Sampler(std::unique_ptr<SDL_GPUSampler, SDL_GPUSamplerDeleter> sampler
 )
     : sampler{std::move(sampler)} {
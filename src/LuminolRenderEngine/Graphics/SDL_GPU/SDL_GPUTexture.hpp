@@ -71,6 +71,9 @@ public:
     [[nodiscard]] auto get_width() const -> uint32_t;
     [[nodiscard]] auto get_height() const -> uint32_t;
     [[nodiscard]] auto get_mip_levels() const -> uint32_t;
+    // How many Texture copies share this GPU texture - lets
+    // SDL_GPUTextureCache tell when it's the last holder.
+    [[nodiscard]] auto get_use_count() const -> uint32_t;
 
 private:
     std::shared_ptr<SDL_GPUTexture> texture;
@@ -0,0 +1,261 @@
+#include "SDL_GPUTextureCache.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+
+#include <gsl/gsl>
+#include <SDL3/SDL_log.h>
+
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUCommandBuffer.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/RenderPasses/SDL_GPUCopyPass.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUDevice.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUMeshCache.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUTransferBuffer.hpp>
+
+namespace {
+
+using namespace Luminol::Graphics::SDL_GPU;
+
+constexpr auto desired_rgba_channels = int32_t{4};
+
+auto create_uploaded_texture(
+    GPUDevice& device,
+    CopyPass& copy_pass,
+    uint32_t width,
+    uint32_t height,
+    const uint8_t* rgba_pixels,
+    TextureFormat format = TextureFormat::R8G8B8A8_Unorm,
+    bool generate_mipmaps = false
+) -> Texture {
+    const auto size_bytes = width * height * 4U;
+
+    auto texture = device.create_texture(TextureInfo{
+        .width = width,
+        .height = height,
+        .format = format,
+        .generate_mipmaps = generate_mipmaps,
+    });
+
+    auto transfer_buffer = device.create_transfer_buffer(TransferBufferInfo{
+        .usage = TransferBufferUsage::Upload,
+        .size = size_bytes,
+    });
+
+    const auto mapped = transfer_buffer.map(false);
+    std::memcpy(mapped.data(), rgba_pixels, size_bytes);
+    transfer_buffer.unmap();
+
+    copy_pass.upload_to_texture(
+        transfer_buffer, 0, texture, width, height, false
+    );
+
+    return texture;
+}
+
+auto create_uploaded_image(
+    GPUDevice& device,
+    CopyPass& copy_pass,
+    const Luminol::Utilities::ImageLoader::Image& image,
+    TextureFormat format
+) -> Texture {
+    return create_uploaded_texture(
+        device,
+        copy_pass,
+        static_cast<uint32_t>(image.width),
+        static_cast<uint32_t>(image.height),
+        image.data.data(),
+        format,
+        true
+    );
+}
+
+// RGBA8 bytes across every mip level the texture was allocated with.
+auto get_texture_size_bytes(const Texture& texture) -> uint64_t {
+    auto width = uint64_t{texture.get_width()};
+    auto height = uint64_t{texture.get_height()};
+    auto size_bytes = uint64_t{0};
+    for (auto level = uint32_t{0}; level < texture.get_mip_levels(); ++level) {
+        size_bytes += width * height * 4U;
+        width = std::max(width / 2U, uint64_t{1});
+        height = std::max(height / 2U, uint64_t{1});
+    }
+    return size_bytes;
+}
+
+auto make_format_suffix(TextureFormat format) -> std::string {
+    return "#" + std::to_string(static_cast<uint32_t>(format));
+}
+
+auto make_path_key(const std::filesystem::path& path, TextureFormat format)
+    -> std::string {
+    return "path:" + path.lexically_normal().generic_string() +
+           make_format_suffix(format);
+}
+
+// Images built in memory (procedural meshes, get_default_normal_map) have
+// no path to key on, so identical pixels are what makes them the same.
+auto make_pixels_key(
+    const Luminol::Utilities::ImageLoader::Image& image, TextureFormat format
+) -> std::string {
+    const auto hash =
+        hash_bytes(mesh_cache_hash_seed, gsl::as_bytes(gsl::span{image.data}));
+    return "pixels:" + std::to_string(hash) + ":" +
+           std::to_string(image.width) + "x" + std::to_string(image.height) +
+           make_format_suffix(format);
+}
+
+auto elapsed_milliseconds(std::chrono::steady_clock::time_point start)
+    -> double {
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::steady_clock::now() - start
+    )
+        .count();
+}
+
+}  // namespace
+
+namespace Luminol::Graphics::SDL_GPU {
+
+auto SDL_GPUTextureCache::get_or_upload(
+    GPUDevice& device,
+    CopyPass& copy_pass,
+    const Utilities::ImageLoader::Image& image,
+    TextureFormat format
+) -> Texture {
+    const auto key = image.path.empty() ? make_pixels_key(image, format)
+                                        : make_path_key(image.path, format);
+    if (auto texture = this->find(key); texture.has_value()) {
+        return std::move(texture).value();
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    auto texture = create_uploaded_image(device, copy_pass, image, format);
+    return this->insert(key, std::move(texture), elapsed_milliseconds(start));
+}
+
+auto SDL_GPUTextureCache::get_or_load(
+    GPUDevice& device,
+    CopyPass& copy_pass,
+    const std::filesystem::path& texture_path,
+    TextureFormat format
+) -> Texture {
+    const auto key = make_path_key(texture_path, format);
+    if (auto texture = this->find(key); texture.has_value()) {
+        return std::move(texture).value();
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto image =
+        Utilities::ImageLoader::load_image(texture_path, desired_rgba_channels);
+    auto texture = create_uploaded_image(device, copy_pass, image, format);
+    return this->insert(key, std::move(texture), elapsed_milliseconds(start));
+}
+
+auto SDL_GPUTextureCache::get_white_texture(
+    GPUDevice& device, CopyPass& copy_pass
+) -> Texture {
+    if (!this->white_texture.has_value()) {
+        constexpr auto white_pixel =
+            std::array<uint8_t, 4>{0xFF, 0xFF, 0xFF, 0xFF};
+        this->white_texture = create_uploaded_texture(
+            device, copy_pass, 1, 1, white_pixel.data()
+        );
+    }
+    return this->white_texture.value();
+}
+
+auto SDL_GPUTextureCache::get_flat_normal_texture(
+    GPUDevice& device, CopyPass& copy_pass
+) -> Texture {
+    if (!this->flat_normal_texture.has_value()) {
+        constexpr auto flat_normal_pixel =
+            std::array<uint8_t, 4>{0x80, 0x80, 0xFF, 0xFF};
+        this->flat_normal_texture = create_uploaded_texture(
+            device, copy_pass, 1, 1, flat_normal_pixel.data()
+        );
+    }
+    return this->flat_normal_texture.value();
+}
+
+auto SDL_GPUTextureCache::generate_pending_mipmaps(
+    CommandBuffer& command_buffer
+) -> void {
+    for (const auto& texture : this->pending_mipmaps) {
+        // A 1x1 source image still only gets 1 mip level; SDL asserts if
+        // asked to generate mipmaps for those.
+        if (texture.get_mip_levels() > 1) {
+            command_buffer.generate_mipmaps(texture);
+        }
+    }
+    this->pending_mipmaps.clear();
+}
+
+auto SDL_GPUTextureCache::release_unused() -> std::size_t {
+    return std::erase_if(this->entries, [](const auto& key_entry) {
+        return key_entry.second.texture.get_use_count() == 1;
+    });
+}
+
+auto SDL_GPUTextureCache::get_resident_count() const -> std::size_t {
+    return this->entries.size();
+}
+
+auto SDL_GPUTextureCache::get_stats() const -> const TextureCacheStats& {
+    return this->stats;
+}
+
+auto SDL_GPUTextureCache::find(const std::string& key)
+    -> std::optional<Texture> {
+    const auto entry = this->entries.find(key);
+    if (entry == this->entries.end()) {
+        return std::nullopt;
+    }
+
+    ++this->stats.reused_textures;
+    this->stats.reused_bytes += entry->second.size_bytes;
+    this->stats.saved_milliseconds += entry->second.upload_milliseconds;
+    return entry->second.texture;
+}
+
+auto SDL_GPUTextureCache::insert(
+    const std::string& key, Texture texture, double upload_milliseconds
+) -> Texture {
+    const auto size_bytes = get_texture_size_bytes(texture);
+
+    ++this->stats.uploaded_textures;
+    this->stats.uploaded_bytes += size_bytes;
+    this->stats.upload_milliseconds += upload_milliseconds;
+
+    this->pending_mipmaps.push_back(texture);
+    this->entries.emplace(
+        key,
+        Entry{
+            .texture = texture,
+            .size_bytes = size_bytes,
+            .upload_milliseconds = upload_milliseconds,
+        }
+    );
+    return texture;
+}
+
+auto log_texture_cache_savings(
+    const TextureCacheStats& before, const TextureCacheStats& after
+) -> void {
+    constexpr auto bytes_per_mebibyte = 1024.0 * 1024.0;
+
+    SDL_Log(
+        "[TextureCache] %" SDL_PRIu64 " textures uploaded, %" SDL_PRIu64
+        " reused: %.1f MiB VRAM and %.1f ms saved (%.1f MiB / %.1f ms total)",
+        after.uploaded_textures - before.uploaded_textures,
+        after.reused_textures - before.reused_textures,
+        static_cast<double>(after.reused_bytes - before.reused_bytes) /
+            bytes_per_mebibyte,
+        after.saved_milliseconds - before.saved_milliseconds,
+        static_cast<double>(after.reused_bytes) / bytes_per_mebibyte,
+        after.saved_milliseconds
+    );
+}
+
+}  // namespace Luminol::Graphics::SDL_GPU
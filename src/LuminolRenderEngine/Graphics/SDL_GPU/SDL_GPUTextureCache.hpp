@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUTexture.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUTypes.hpp>
+#include <LuminolRenderEngine/Utilities/ImageLoader.hpp>
+
+namespace Luminol::Graphics::SDL_GPU {
+
+class GPUDevice;
+class CopyPass;
+class CommandBuffer;
+
+// Running totals since the cache was created. A "reuse" is a material slot
+// that got an already-resident texture instead of uploading its own copy -
+// reused_bytes/saved_milliseconds are what those slots would have cost
+// without the cache (VRAM including the mip chain, and the CPU time the
+// original upload took, decode included for path-sourced textures).
+struct TextureCacheStats {
+    uint64_t uploaded_textures = 0;
+    uint64_t reused_textures = 0;
+    uint64_t uploaded_bytes = 0;
+    uint64_t reused_bytes = 0;
+    double upload_milliseconds = 0.0;
+    double saved_milliseconds = 0.0;
+};
+
+// Device-wide cache of material textures, shared by every SDL_GPUMesh of
+// every renderable the owning SDL_GPUFactory creates. Keyed by source path
+// (or, for images without one, a hash of their pixels) plus the texture
+// format, since the same file sampled as sRGB diffuse and as linear data
+// needs two different GPU textures. Handing out Texture copies makes the
+// cache refcounted for free - Texture already shares its GPU texture via a
+// shared_ptr, see SDL_GPUTexture.hpp - and release_unused drops entries
+// once only the cache itself still holds them.
+//
+// Not thread-safe: like every other GPU upload, only used from the thread
+// that owns the GPUDevice (see SDL_GPUFactory::upload_completed_models).
+class SDL_GPUTextureCache {
+public:
+    // Returns the cached texture for image in format, uploading it (with a
+    // full mip chain, queued for generate_pending_mipmaps) on a miss.
+    [[nodiscard]] auto get_or_upload(
+        GPUDevice& device,
+        CopyPass& copy_pass,
+        const Utilities::ImageLoader::Image& image,
+        TextureFormat format
+    ) -> Texture;
+
+    // Same as get_or_upload, but only decodes texture_path on a miss.
+    [[nodiscard]] auto get_or_load(
+        GPUDevice& device,
+        CopyPass& copy_pass,
+        const std::filesystem::path& texture_path,
+        TextureFormat format
+    ) -> Texture;
+
+    // 1x1 fallbacks for material slots without a texture, created once and
+    // kept for the cache's lifetime.
+    [[nodiscard]] auto get_white_texture(GPUDevice& device, CopyPass& copy_pass)
+        -> Texture;
+    [[nodiscard]] auto get_flat_normal_texture(
+        GPUDevice& device, CopyPass& copy_pass
+    ) -> Texture;
+
+    // Generates the mip chain of every texture uploaded since the last call,
+    // exactly once per texture no matter how many meshes share it. Must be
+    // called after the copy pass that uploaded them has ended, outside any
+    // render/copy pass on command_buffer.
+    auto generate_pending_mipmaps(CommandBuffer& command_buffer) -> void;
+
+    // Drops every cached texture no SDL_GPUMesh references any more, freeing
+    // its GPU memory. Returns how many were dropped.
+    auto release_unused() -> std::size_t;
+
+    [[nodiscard]] auto get_resident_count() const -> std::size_t;
+    [[nodiscard]] auto get_stats() const -> const TextureCacheStats&;
+
+private:
+    struct Entry {
+        Texture texture;
+        uint64_t size_bytes;
+        double upload_milliseconds;
+    };
+
+    [[nodiscard]] auto find(const std::string& key) -> std::optional<Texture>;
+    auto insert(
+        const std::string& key, Texture texture, double upload_milliseconds
+    ) -> Texture;
+
+    std::unordered_map<std::string, Entry> entries;
+    std::optional<Texture> white_texture;
+    std::optional<Texture> flat_normal_texture;
+    std::vector<Texture> pending_mipmaps;
+    TextureCacheStats stats;
+};
+
+// Logs what the cache saved between two get_stats() snapshots taken around
+// one model's upload: textures uploaded vs. reused, and the VRAM and upload
+// time the reused ones would otherwise have cost.
+auto log_texture_cache_savings(
+    const TextureCacheStats& before, const TextureCacheStats& after
+) -> void;
+
+}  // namespace Luminol::Graphics::SDL_GPU
@@ -177,6 +177,10 @@ auto to_sdl_vertex_element_format(VertexElementFormat format)
             return SDL_GPU_VERTEXELEMENTFORMAT_FLOAT3;
         case VertexElementFormat::Float4:
             return SDL_GPU_VERTEXELEMENTFORMAT_FLOAT4;
+        case VertexElementFormat::Half2:
+            return SDL_GPU_VERTEXELEMENTFORMAT_HALF2;
+        case VertexElementFormat::Short4Norm:
+            return SDL_GPU_VERTEXELEMENTFORMAT_SHORT4_NORM;
     }
     throw std::runtime_error{"Invalid vertex element format"};
 }
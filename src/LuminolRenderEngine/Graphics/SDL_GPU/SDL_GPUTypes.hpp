@@ -106,6 +106,11 @@ enum class VertexElementFormat : uint8_t {
     Float2,
     Float3,
     Float4,
+    // Two IEEE half floats, widened to float2 in the shader.
+    Half2,
+    // Four signed 16-bit integers mapped to [-1, 1] (-32768 clamps to -1),
+    // read as float4 in the shader.
+    Short4Norm,
 };
 
 enum class VertexInputRate : uint8_t {
@@ -0,0 +1,333 @@
+#include "SDL_GPUVertexFormat.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+namespace {
+
+using namespace Luminol::Graphics::SDL_GPU;
+
+constexpr auto snorm16_max = 32767.0F;
+
+constexpr auto full_vertex_buffer_descriptions = std::array{
+    VertexBufferDescription{
+        .slot = 0,
+        .pitch = sizeof(float) * full_vertex_stride_in_floats,
+    },
+};
+
+constexpr auto full_vertex_attributes = std::array{
+    VertexAttribute{
+        .location = 0,
+        .buffer_slot = 0,
+        .format = VertexElementFormat::Float3,
+        .offset = 0,
+    },
+    VertexAttribute{
+        .location = 1,
+        .buffer_slot = 0,
+        .format = VertexElementFormat::Float2,
+        .offset = sizeof(float) * 3,
+    },
+    VertexAttribute{
+        .location = 2,
+        .buffer_slot = 0,
+        .format = VertexElementFormat::Float3,
+        .offset = sizeof(float) * 5,
+    },
+    VertexAttribute{
+        .location = 3,
+        .buffer_slot = 0,
+        .format = VertexElementFormat::Float3,
+        .offset = sizeof(float) * 8,
+    },
+};
+
+constexpr auto compact_vertex_buffer_descriptions = std::array{
+    VertexBufferDescription{
+        .slot = 0,
+        .pitch = sizeof(CompactVertex),
+    },
+};
+
+// Normal and tangent share one Short4Norm attribute (location 2) - there's
+// no location 3 in the compact layout.
+constexpr auto compact_vertex_attributes = std::array{
+    VertexAttribute{
+        .location = 0,
+        .buffer_slot = 0,
+        .format = VertexElementFormat::Short4Norm,
+        .offset = offsetof(CompactVertex, position),
+    },
+    VertexAttribute{
+        .location = 1,
+        .buffer_slot = 0,
+        .format = VertexElementFormat::Half2,
+        .offset = offsetof(CompactVertex, uv),
+    },
+    VertexAttribute{
+        .location = 2,
+        .buffer_slot = 0,
+        .format = VertexElementFormat::Short4Norm,
+        .offset = offsetof(CompactVertex, normal_tangent),
+    },
+};
+
+auto to_snorm16(float value) -> int16_t {
+    return static_cast<int16_t>(
+        std::lround(std::clamp(value, -1.0F, 1.0F) * snorm16_max)
+    );
+}
+
+auto from_snorm16(int16_t value) -> float {
+    // Matches the GPU's snorm conversion: -32768 and -32767 both map to -1.
+    return std::max(static_cast<float>(value) / snorm16_max, -1.0F);
+}
+
+// Round-to-nearest-even fp32 -> IEEE fp16, saturating to infinity past
+// 65504 and flushing below the smallest half subnormal to zero - the same
+// result as the hardware's (and HLSL f32tof16's) conversion.
+auto to_half(float value) -> uint16_t {
+    const auto bits = std::bit_cast<uint32_t>(value);
+    const auto sign = static_cast<uint16_t>((bits >> 16U) & 0x8000U);
+    const auto exponent = static_cast<int32_t>((bits >> 23U) & 0xFFU);
+    auto mantissa = bits & 0x7FFFFFU;
+
+    if (exponent == 0xFF) {
+        return static_cast<uint16_t>(
+            sign | 0x7C00U | (mantissa != 0 ? 0x200U : 0U)
+        );
+    }
+
+    const auto half_exponent = exponent - 127 + 15;
+    if (half_exponent >= 0x1F) {
+        return static_cast<uint16_t>(sign | 0x7C00U);
+    }
+
+    if (half_exponent <= 0) {
+        if (half_exponent < -10) {
+            return sign;
+        }
+        mantissa |= 0x800000U;
+        const auto shift = static_cast<uint32_t>(14 - half_exponent);
+        const auto half_mantissa = mantissa >> shift;
+        const auto remainder = mantissa & ((1U << shift) - 1U);
+        const auto halfway = 1U << (shift - 1U);
+        const auto round_up =
+            remainder > halfway ||
+            (remainder == halfway && (half_mantissa & 1U) != 0);
+        return static_cast<uint16_t>(
+            sign | (half_mantissa + (round_up ? 1U : 0U))
+        );
+    }
+
+    const auto half_mantissa = mantissa >> 13U;
+    const auto remainder = mantissa & 0x1FFFU;
+    const auto round_up =
+        remainder > 0x1000U ||
+        (remainder == 0x1000U && (half_mantissa & 1U) != 0);
+    // A carry out of the mantissa correctly bumps the exponent (and rounds
+    // 65520+ up to infinity).
+    return static_cast<uint16_t>(
+        sign + ((static_cast<uint32_t>(half_exponent) << 10U) | half_mantissa) +
+        (round_up ? 1U : 0U)
+    );
+}
+
+auto from_half(uint16_t value) -> float {
+    const auto sign = (static_cast<uint32_t>(value) & 0x8000U) << 16U;
+    const auto exponent = (static_cast<uint32_t>(value) >> 10U) & 0x1FU;
+    const auto mantissa = static_cast<uint32_t>(value) & 0x3FFU;
+
+    if (exponent == 0) {
+        const auto magnitude = std::ldexp(static_cast<float>(mantissa), -24);
+        return sign != 0 ? -magnitude : magnitude;
+    }
+    if (exponent == 0x1F) {
+        return std::bit_cast<float>(sign | 0x7F800000U | (mantissa << 13U));
+    }
+    return std::bit_cast<float>(
+        sign | ((exponent - 15 + 127) << 23U) | (mantissa << 13U)
+    );
+}
+
+auto sign_not_zero(float value) -> float {
+    return value >= 0.0F ? 1.0F : -1.0F;
+}
+
+// Octahedral unit vector encoding: project onto the |x|+|y|+|z| = 1
+// octahedron and fold the lower hemisphere over the diagonals onto the
+// upper one, giving a point in [-1, 1]^2. Must stay in sync with
+// oct_decode in pbr_vert.hlsl / pbr_vert_meshlet.hlsl.
+auto oct_encode(float x, float y, float z) -> std::array<int16_t, 2> {
+    const auto l1_norm = std::abs(x) + std::abs(y) + std::abs(z);
+    if (l1_norm == 0.0F) {
+        return {0, 0};
+    }
+
+    auto u = x / l1_norm;
+    auto v = y / l1_norm;
+    if (z < 0.0F) {
+        const auto folded_u = (1.0F - std::abs(v)) * sign_not_zero(u);
+        const auto folded_v = (1.0F - std::abs(u)) * sign_not_zero(v);
+        u = folded_u;
+        v = folded_v;
+    }
+
+    return {to_snorm16(u), to_snorm16(v)};
+}
+
+auto oct_decode(int16_t encoded_u, int16_t encoded_v)
+    -> std::array<float, 3> {
+    const auto u = from_snorm16(encoded_u);
+    const auto v = from_snorm16(encoded_v);
+
+    auto x = u;
+    auto y = v;
+    const auto z = 1.0F - std::abs(u) - std::abs(v);
+    const auto fold = std::max(-z, 0.0F);
+    x += x >= 0.0F ? -fold : fold;
+    y += y >= 0.0F ? -fold : fold;
+
+    const auto length = std::sqrt(x * x + y * y + z * z);
+    return {x / length, y / length, z / length};
+}
+
+}  // namespace
+
+namespace Luminol::Graphics::SDL_GPU {
+
+auto encode_compact_vertices(gsl::span<const float> vertices)
+    -> CompactVertices {
+    Expects(vertices.size() % full_vertex_stride_in_floats == 0);
+
+    const auto vertex_count = vertices.size() / full_vertex_stride_in_floats;
+
+    auto bounds_min = std::array<float, 3>{
+        std::numeric_limits<float>::max(),
+        std::numeric_limits<float>::max(),
+        std::numeric_limits<float>::max(),
+    };
+    auto bounds_max = std::array<float, 3>{
+        std::numeric_limits<float>::lowest(),
+        std::numeric_limits<float>::lowest(),
+        std::numeric_limits<float>::lowest(),
+    };
+    for (auto i = size_t{0}; i < vertex_count; ++i) {
+        const auto* vertex = &vertices[i * full_vertex_stride_in_floats];
+        for (auto axis = size_t{0}; axis < 3; ++axis) {
+            bounds_min[axis] = std::min(bounds_min[axis], vertex[axis]);
+            bounds_max[axis] = std::max(bounds_max[axis], vertex[axis]);
+        }
+    }
+
+    auto result = CompactVertices{};
+    if (vertex_count == 0) {
+        return result;
+    }
+
+    for (auto axis = size_t{0}; axis < 3; ++axis) {
+        result.dequantization.position_offset[axis] =
+            (bounds_min[axis] + bounds_max[axis]) * 0.5F;
+        // A flat axis (e.g. a plane) still needs a non-zero scale to divide
+        // by; every vertex sits at the offset there, so any value works.
+        result.dequantization.position_scale[axis] = std::max(
+            (bounds_max[axis] - bounds_min[axis]) * 0.5F,
+            std::numeric_limits<float>::min()
+        );
+    }
+
+    const auto& offset = result.dequantization.position_offset;
+    const auto& scale = result.dequantization.position_scale;
+
+    result.vertices.reserve(vertex_count);
+    for (auto i = size_t{0}; i < vertex_count; ++i) {
+        const auto* vertex = &vertices[i * full_vertex_stride_in_floats];
+        const auto normal = oct_encode(vertex[5], vertex[6], vertex[7]);
+        const auto tangent = oct_encode(vertex[8], vertex[9], vertex[10]);
+
+        result.vertices.push_back(CompactVertex{
+            .position =
+                {
+                    to_snorm16((vertex[0] - offset[0]) / scale[0]),
+                    to_snorm16((vertex[1] - offset[1]) / scale[1]),
+                    to_snorm16((vertex[2] - offset[2]) / scale[2]),
+                    0,
+                },
+            .uv = {to_half(vertex[3]), to_half(vertex[4])},
+            .normal_tangent = {normal[0], normal[1], tangent[0], tangent[1]},
+        });
+    }
+
+    return result;
+}
+
+auto decode_compact_vertex(
+    const CompactVertex& vertex, const VertexDequantization& dequantization
+) -> std::array<float, full_vertex_stride_in_floats> {
+    const auto& offset = dequantization.position_offset;
+    const auto& scale = dequantization.position_scale;
+    const auto normal =
+        oct_decode(vertex.normal_tangent[0], vertex.normal_tangent[1]);
+    const auto tangent =
+        oct_decode(vertex.normal_tangent[2], vertex.normal_tangent[3]);
+
+    return {
+        offset[0] + scale[0] * from_snorm16(vertex.position[0]),
+        offset[1] + scale[1] * from_snorm16(vertex.position[1]),
+        offset[2] + scale[2] * from_snorm16(vertex.position[2]),
+        from_half(vertex.uv[0]),
+        from_half(vertex.uv[1]),
+        normal[0],
+        normal[1],
+        normal[2],
+        tangent[0],
+        tangent[1],
+        tangent[2],
+    };
+}
+
+auto get_vertex_stride_in_bytes(VertexFormat format) -> uint32_t {
+    switch (format) {
+        case VertexFormat::Compact:
+            return sizeof(CompactVertex);
+        case VertexFormat::Full:
+        default:
+            return sizeof(float) * full_vertex_stride_in_floats;
+    }
+}
+
+auto get_mesh_vertex_buffer_descriptions(VertexFormat format)
+    -> gsl::span<const VertexBufferDescription> {
+    switch (format) {
+        case VertexFormat::Compact:
+            return compact_vertex_buffer_descriptions;
+        case VertexFormat::Full:
+        default:
+            return full_vertex_buffer_descriptions;
+    }
+}
+
+auto get_mesh_vertex_attributes(VertexFormat format)
+    -> gsl::span<const VertexAttribute> {
+    switch (format) {
+        case VertexFormat::Compact:
+            return compact_vertex_attributes;
+        case VertexFormat::Full:
+        default:
+            return full_vertex_attributes;
+    }
+}
+
+auto get_vertex_format_shader_defines(VertexFormat format)
+    -> std::vector<ShaderDefine> {
+    if (format == VertexFormat::Compact) {
+        return {ShaderDefine{.name = "COMPACT_VERTICES"}};
+    }
+    return {};
+}
+
+}  // namespace Luminol::Graphics::SDL_GPU
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <gsl/gsl>
+
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUShader.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUTypes.hpp>
+
+namespace Luminol::Graphics::SDL_GPU {
+
+// Layout of every renderable's shared vertex buffer, chosen once per
+// SDL_GPUFactory (see Properties::vertex_format) - every mesh pipeline and
+// both mesh vertex shaders are built for exactly one of these.
+enum class VertexFormat : uint8_t {
+    // position3/uv2/normal3/tangent3 as fp32 - 11 floats, 44 bytes.
+    Full,
+    // CompactVertex - 20 bytes. Trades a little precision (see
+    // CompactVertex) for less than half the vertex fetch bandwidth/VRAM.
+    Compact,
+};
+
+// The interleaved fp32 vertex every loader/baker produces (and the mesh
+// cache stores) - Compact is only encoded from it at upload time.
+inline constexpr auto full_vertex_stride_in_floats = 11U;
+
+// position: snorm16 relative to the renderable's bounding box (see
+//   VertexDequantization) - about 1/65535 of the box's extent per axis,
+//   i.e. sub-millimetre on a room-sized model. w is padding.
+// uv: IEEE half floats - exact for the usual [0, 1] texel grid up to 2048
+//   texels, and still representable for tiled UVs outside [0, 1].
+// normal_tangent: both octahedral-encoded as snorm16 pairs (xy = normal,
+//   zw = tangent) - under 0.01 degrees of angular error.
+struct CompactVertex {
+    std::array<int16_t, 4> position;
+    std::array<uint16_t, 2> uv;
+    std::array<int16_t, 4> normal_tangent;
+};
+static_assert(sizeof(CompactVertex) == 20);
+
+// Maps a CompactVertex's snorm16 position back to model space:
+// position = offset + scale * snorm. Identity for VertexFormat::Full.
+// Pushed as a per-renderable vertex uniform (slot 1) by every pass that
+// draws mesh geometry; mirrors cbuffer VertexDequantization in
+// pbr_vert.hlsl / pbr_vert_meshlet.hlsl (float4s for std140-safe packing).
+struct VertexDequantization {
+    std::array<float, 4> position_offset = {0.0F, 0.0F, 0.0F, 0.0F};
+    std::array<float, 4> position_scale = {1.0F, 1.0F, 1.0F, 0.0F};
+};
+
+struct CompactVertices {
+    std::vector<CompactVertex> vertices;
+    VertexDequantization dequantization;
+};
+
+// Encodes interleaved full_vertex_stride_in_floats vertices. Positions are
+// quantized against the bounding box of ALL of them rather than per
+// submesh: every submesh of a renderable shares one vertex buffer and is
+// drawn by the same multi-draw call, so one set of dequantization constants
+// per renderable is all a vertex shader can be handed.
+[[nodiscard]] auto encode_compact_vertices(gsl::span<const float> vertices)
+    -> CompactVertices;
+
+// Inverse of encode_compact_vertices for one vertex, in the same
+// full_vertex_stride_in_floats layout - what the shaders compute, for tests
+// and CPU-side tooling.
+[[nodiscard]] auto decode_compact_vertex(
+    const CompactVertex& vertex, const VertexDequantization& dequantization
+) -> std::array<float, full_vertex_stride_in_floats>;
+
+[[nodiscard]] auto get_vertex_stride_in_bytes(VertexFormat format)
+    -> uint32_t;
+
+// Fixed-function vertex input for pipelines drawing mesh geometry with
+// pbr_vert.hlsl (built with get_vertex_format_shader_defines(format)).
+[[nodiscard]] auto get_mesh_vertex_buffer_descriptions(VertexFormat format)
+    -> gsl::span<const VertexBufferDescription>;
+[[nodiscard]] auto get_mesh_vertex_attributes(VertexFormat format)
+    -> gsl::span<const VertexAttribute>;
+
+// COMPACT_VERTICES for VertexFormat::Compact, nothing for Full.
+[[nodiscard]] auto get_vertex_format_shader_defines(VertexFormat format)
+    -> std::vector<ShaderDefine>;
+
+}  // namespace Luminol::Graphics::SDL_GPU
@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <memory_resource>
 #include <numbers>
 #include <vector>
 
@@ -18,6 +19,7 @@
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUFactory.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/RenderPasses/SDL_GPURenderPass.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUResourceBuilders.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUStagingRing.hpp>
 #include <LuminolRenderEngine/Utilities/Timer.hpp>
 
 namespace {
@@ -124,9 +126,9 @@ constexpr auto cube_faces = std::array{
 };
 
 // Must match the light_cull_radius cutoff in pbr_frag.hlsl /
-// cluster_light_count.hlsl / cluster_light_compact.hlsl / LightManager.cpp
-// exactly, so a shadow's far plane matches the sphere shading fades the
-// light's contribution to zero at.
+// cluster_light_transform.hlsl / LightManager.cpp exactly, so a shadow's far
+// plane matches the sphere shading fades the light's contribution to zero
+// at.
 auto light_cull_radius(const Vector3f& color) -> float {
     constexpr auto cutoff = 1.0F / 16.0F;
     const auto intensity = std::max({color.x(), color.y(), color.z()});
@@ -248,12 +250,16 @@ struct SelectedSpotLight {
     float far_plane;
 };
 
-auto collect_selected_point_lights(const Luminol::Graphics::Light& light_data)
-    -> std::vector<SelectedPointLight> {
-    auto selected = std::vector<SelectedPointLight>{};
-    selected.reserve(light_data.point_light_count);
+auto collect_selected_point_lights(
+    const Luminol::Graphics::Light& light_data,
+    std::pmr::memory_resource& frame_memory
+) -> std::pmr::vector<SelectedPointLight> {
+    auto selected = std::pmr::vector<SelectedPointLight>{&frame_memory};
+    selected.reserve(light_data.shadow_casting_point_lights.size());
 
-    for (auto i = uint32_t{0}; i < light_data.point_light_count; ++i) {
+    // Only the lights LightManager lists as holding a slot, rather than
+    // scanning every packed light for one.
+    for (const auto i : light_data.shadow_casting_point_lights) {
         const auto& light = gsl::at(light_data.point_lights, i);
         const auto shadow_slot = light.shadow_data.x();
         if (shadow_slot < 0.0F) {
@@ -273,12 +279,14 @@ auto collect_selected_point_lights(const Luminol::Graphics::Light& light_data)
     return selected;
 }
 
-auto collect_selected_spot_lights(const Luminol::Graphics::Light& light_data)
-    -> std::vector<SelectedSpotLight> {
-    auto selected = std::vector<SelectedSpotLight>{};
-    selected.reserve(light_data.spot_light_count);
+auto collect_selected_spot_lights(
+    const Luminol::Graphics::Light& light_data,
+    std::pmr::memory_resource& frame_memory
+) -> std::pmr::vector<SelectedSpotLight> {
+    auto selected = std::pmr::vector<SelectedSpotLight>{&frame_memory};
+    selected.reserve(light_data.shadow_casting_spot_lights.size());
 
-    for (auto i = uint32_t{0}; i < light_data.spot_light_count; ++i) {
+    for (const auto i : light_data.shadow_casting_spot_lights) {
         const auto& light = gsl::at(light_data.spot_lights, i);
         if (light.shadow_slot < 0.0F) {
             continue;
@@ -303,8 +311,8 @@ auto collect_selected_spot_lights(const Luminol::Graphics::Light& light_data)
 // and uploads it to the GPU.
 auto build_and_upload_spot_shadow_matrices(
     CommandBuffer& command_buffer,
+    StagingRing& staging_ring,
     gsl::span<const SelectedSpotLight> selected_spot_lights,
-    TransferBuffer& spot_shadow_matrix_transfer_buffer,
     Buffer& spot_shadow_matrix_buffer,
     std::vector<Matrix4x4f>& spot_shadow_matrices
 ) -> void {
@@ -325,9 +333,8 @@ auto build_and_upload_spot_shadow_matrices(
 
     {
         auto copy_pass = command_buffer.begin_copy_pass();
-        upload_via_transfer(
-            copy_pass, spot_shadow_matrix_transfer_buffer,
-            spot_shadow_matrix_buffer,
+        staging_ring.upload(
+            copy_pass, spot_shadow_matrix_buffer,
             gsl::span{
                 reinterpret_cast<const std::byte*>(spot_shadow_matrices.data()),
                 spot_shadow_matrix_buffer_size
@@ -337,39 +344,43 @@ auto build_and_upload_spot_shadow_matrices(
 }
 
 struct IndirectCommandResult {
-    std::vector<IndirectDrawCommand> indirect_commands;
-    std::vector<IndirectDrawRange> point_ranges;
-    std::vector<IndirectDrawRange> spot_ranges;
+    std::pmr::vector<IndirectDrawCommand> indirect_commands;
+    std::pmr::vector<IndirectDrawRange> point_ranges;
+    std::pmr::vector<IndirectDrawRange> spot_ranges;
 };
 
+// One point-light cube face or spot light to build draw commands for.
+struct ShadowView {
+    std::array<Vector4f, 6> frustum_planes;
+    bool is_point_face;
+};
+
+using ShadowViewCommands = SDL_GPUPointSpotShadowPass::ShadowViewCommands;
+
 // Phase 1: build every (tile, batch)'s indirect draw commands up front, from
 // CPU AABB culling, so each tile's surviving meshes across every batch can be
 // uploaded once and submitted as one indirect multi-draw call per batch
 // instead of one draw call per mesh. point_ranges/spot_ranges are appended in
 // exactly this (point-then-spot) order - the caller's Phase 2 submission
-// walks them with a running index in the same order.
+// walks them with a running index in the same order. Every view culls
+// independently into its own list of view_commands (one job per view when
+// job_system is given), then the lists are stitched together in that same
+// order into frame_memory.
 auto build_indirect_commands(
     const SDL_GPUFactory& graphics_factory,
     gsl::span<const InstanceBatch> instance_batches,
     gsl::span<const SelectedPointLight> selected_point_lights,
     gsl::span<const SelectedSpotLight> selected_spot_lights,
     const BatchMeshBounds& batch_mesh_world_bounds,
-    gsl::span<const Matrix4x4f> spot_shadow_matrices
+    gsl::span<const Matrix4x4f> spot_shadow_matrices,
+    std::vector<ShadowViewCommands>& view_commands,
+    std::pmr::memory_resource& frame_memory,
+    Luminol::Utilities::JobSystem* job_system
 ) -> IndirectCommandResult {
-    auto result = IndirectCommandResult{};
-    result.point_ranges.reserve(
-        selected_point_lights.size() * cube_faces_per_light *
-        instance_batches.size()
-    );
-    result.spot_ranges.reserve(selected_spot_lights.size() * instance_batches.size());
-    // Rough lower-bound estimate (assumes ~1 surviving command per
-    // (view, batch) pair) - avoids the worst reallocation growth for the
-    // common case without eagerly reserving the full worst-case capacity
-    // (max_indirect_draw_commands) every frame.
-    result.indirect_commands.reserve(
-        (selected_point_lights.size() * cube_faces_per_light +
-         selected_spot_lights.size()) *
-        instance_batches.size()
+    auto views = std::pmr::vector<ShadowView>{&frame_memory};
+    views.reserve(
+        selected_point_lights.size() * cube_faces_per_light +
+        selected_spot_lights.size()
     );
 
     for (const auto& point_light : selected_point_lights) {
@@ -381,16 +392,10 @@ auto build_indirect_commands(
             const auto view_projection = point_light_face_view_projection(
                 point_light.position, point_light.far_plane, face
             );
-            const auto frustum_planes = extract_frustum_planes(view_projection);
-
-            for (auto batch_index = std::size_t{0};
-                 batch_index < instance_batches.size(); ++batch_index) {
-                result.point_ranges.push_back(append_batch_indirect_commands(
-                    graphics_factory, instance_batches[batch_index],
-                    batch_mesh_world_bounds[batch_index], frustum_planes,
-                    std::nullopt, result.indirect_commands
-                ));
-            }
+            views.push_back(ShadowView{
+                .frustum_planes = extract_frustum_planes(view_projection),
+                .is_point_face = true,
+            });
         }
     }
 
@@ -399,18 +404,89 @@ auto build_indirect_commands(
             continue;
         }
 
-        const auto frustum_planes = extract_frustum_planes(
-            spot_shadow_matrices[spot_light.slot]
-        );
+        views.push_back(ShadowView{
+            .frustum_planes =
+                extract_frustum_planes(spot_shadow_matrices[spot_light.slot]),
+            .is_point_face = false,
+        });
+    }
+
+    // Only ever grown, so every list keeps its capacity for the next frame.
+    if (view_commands.size() < views.size()) {
+        view_commands.resize(views.size());
+    }
+    const auto build_view = [&](std::size_t view_index) {
+        auto& [commands, ranges] = view_commands[view_index];
+        commands.clear();
+        ranges.clear();
+        ranges.reserve(instance_batches.size());
+        // Rough lower-bound estimate (assumes ~1 surviving command per
+        // batch) - avoids the worst reallocation growth for the common case
+        // without eagerly reserving the full worst-case capacity.
+        commands.reserve(instance_batches.size());
 
         for (auto batch_index = std::size_t{0};
              batch_index < instance_batches.size(); ++batch_index) {
-            result.spot_ranges.push_back(append_batch_indirect_commands(
+            ranges.push_back(append_batch_indirect_commands(
                 graphics_factory, instance_batches[batch_index],
-                batch_mesh_world_bounds[batch_index], frustum_planes,
-                std::nullopt, result.indirect_commands
+                batch_mesh_world_bounds[batch_index],
+                views[view_index].frustum_planes, std::nullopt, commands
             ));
         }
+    };
+
+    if (job_system != nullptr) {
+        job_system->parallel_for(
+            views.size(), 1,
+            [&build_view](std::size_t begin, std::size_t end) {
+                for (auto view_index = begin; view_index < end; ++view_index) {
+                    build_view(view_index);
+                }
+            }
+        );
+    } else {
+        for (auto view_index = std::size_t{0}; view_index < views.size();
+             ++view_index) {
+            build_view(view_index);
+        }
+    }
+
+    auto result = IndirectCommandResult{
+        .indirect_commands =
+            std::pmr::vector<IndirectDrawCommand>{&frame_memory},
+        .point_ranges = std::pmr::vector<IndirectDrawRange>{&frame_memory},
+        .spot_ranges = std::pmr::vector<IndirectDrawRange>{&frame_memory},
+    };
+    auto total_command_count = std::size_t{0};
+    for (auto view_index = std::size_t{0}; view_index < views.size();
+         ++view_index) {
+        total_command_count += view_commands[view_index].commands.size();
+    }
+    result.indirect_commands.reserve(total_command_count);
+    result.point_ranges.reserve(
+        selected_point_lights.size() * cube_faces_per_light *
+        instance_batches.size()
+    );
+    result.spot_ranges.reserve(selected_spot_lights.size() * instance_batches.size());
+
+    for (auto view_index = std::size_t{0}; view_index < views.size();
+         ++view_index) {
+        const auto& [commands, ranges] = view_commands[view_index];
+        const auto command_base =
+            static_cast<uint32_t>(result.indirect_commands.size());
+        auto& out_ranges = views[view_index].is_point_face
+            ? result.point_ranges
+            : result.spot_ranges;
+
+        for (const auto& range : ranges) {
+            out_ranges.push_back(IndirectDrawRange{
+                .offset = command_base + range.offset,
+                .count = range.count,
+            });
+        }
+        result.indirect_commands.insert(
+            result.indirect_commands.end(), commands.begin(), commands.end()
+        );
     }
 
     return result;
@@ -484,6 +560,10 @@ auto record_shadow_tile(
             graphics_factory.get_index_buffer(batch.renderable_id),
             IndexElementSize::Bits32, 0
         );
+        push_vertex_dequantization(
+            command_buffer,
+            graphics_factory.get_vertex_dequantization(batch.renderable_id)
+        );
 
         const auto& instance_buffer =
             instance_buffer_cache.get(batch.renderable_id);
@@ -600,18 +680,18 @@ auto record_spot_shadow_pass(
 
 namespace Luminol::Graphics::SDL_GPU {
 
-SDL_GPUPointSpotShadowPass::SDL_GPUPointSpotShadowPass(GPUDevice& device)
-    : shadow_vertex_shader{make_hlsl_shader(
-          device, "res/shaders/sdl_gpu/pbr_vert.hlsl", ShaderStage::Vertex,
-          0U, 1U, 2U
-      )},
-      shadow_fragment_shader{make_hlsl_shader(
-          device, "res/shaders/sdl_gpu/shadow_depth_frag.hlsl",
-          ShaderStage::Fragment
-      )},
+SDL_GPUPointSpotShadowPass::SDL_GPUPointSpotShadowPass(
+    GPUDevice& device, VertexFormat vertex_format
+)
+    : shadow_vertex_shader{
+          device.create_shader(get_mesh_vertex_shader_info(vertex_format))
+      },
+      shadow_fragment_shader{
+          device.create_shader(get_depth_only_fragment_shader_info())
+      },
       shadow_pipeline{make_depth_only_mesh_pipeline(
           device, shadow_vertex_shader, shadow_fragment_shader,
-          shadow_map_format
+          shadow_map_format, vertex_format
       )},
       point_shadow_texture{make_point_shadow_texture(device)},
       point_shadow_sampler{make_clamp_linear_sampler(
@@ -625,47 +705,46 @@ SDL_GPUPointSpotShadowPass::SDL_GPUPointSpotShadowPass(GPUDevice& device)
           .usage = BufferUsage::StorageRead,
           .size = spot_shadow_matrix_buffer_size,
       })},
-      spot_shadow_matrix_transfer_buffer{device.create_transfer_buffer(TransferBufferInfo{
-          .usage = TransferBufferUsage::Upload,
-          .size = spot_shadow_matrix_buffer_size,
-      })},
       indirect_draw_buffer{device.create_buffer(BufferInfo{
           .usage = BufferUsage::Indirect,
           .size = indirect_draw_buffer_size,
-      })},
-      indirect_draw_transfer_buffer{device.create_transfer_buffer(TransferBufferInfo{
-          .usage = TransferBufferUsage::Upload,
-          .size = indirect_draw_buffer_size,
       })} {}
 
+auto SDL_GPUPointSpotShadowPass::get_shader_compile_requests(
+    VertexFormat vertex_format
+) -> ShaderCompileRequests {
+    return ShaderCompileRequests{
+        .shaders =
+            {
+                get_mesh_vertex_shader_info(vertex_format),
+                get_depth_only_fragment_shader_info(),
+            },
+        .compute_pipelines = {},
+    };
+}
+
 auto SDL_GPUPointSpotShadowPass::draw(
     const SDL_GPUFactory& graphics_factory,
     CommandBuffer& command_buffer,
+    StagingRing& staging_ring,
     const SDL_GPUInstanceBufferCache& instance_buffer_cache,
     gsl::span<const InstanceBatch> instance_batches,
-    const QueuedDraws& queued_draws,
+    const BatchMeshBounds& batch_mesh_world_bounds,
     const Light& light_data,
-    Utilities::PerformanceLogger& performance_logger
+    Utilities::PerformanceLogger& performance_logger,
+    std::pmr::memory_resource& frame_memory,
+    Utilities::JobSystem* job_system
 ) -> void {
     const auto pass_timer = Utilities::Timer{};
     command_buffer.push_debug_group("point_spot_shadow_pass");
 
-    const auto selected_point_lights = collect_selected_point_lights(light_data);
-    const auto selected_spot_lights = collect_selected_spot_lights(light_data);
-
-    // Skip the O(instance count) CPU AABB computation entirely when no
-    // point/spot light is shadow-casting this frame - it's only consumed by
-    // append_batch_indirect_commands below, which is a no-op in that case,
-    // so an empty BatchMeshBounds is never indexed.
-    const auto batch_mesh_world_bounds =
-        (selected_point_lights.empty() && selected_spot_lights.empty())
-        ? BatchMeshBounds{}
-        : compute_batch_mesh_world_bounds(
-              graphics_factory, instance_batches, queued_draws
-          );
+    const auto selected_point_lights =
+        collect_selected_point_lights(light_data, frame_memory);
+    const auto selected_spot_lights =
+        collect_selected_spot_lights(light_data, frame_memory);
 
     build_and_upload_spot_shadow_matrices(
-        command_buffer, selected_spot_lights, spot_shadow_matrix_transfer_buffer,
+        command_buffer, staging_ring, selected_spot_lights,
         spot_shadow_matrix_buffer, spot_shadow_matrices
     );
 
@@ -674,9 +753,14 @@ auto SDL_GPUPointSpotShadowPass::draw(
     const auto spot_shadow_texture_view =
         TextureView{spot_shadow_texture.native_handle()};
 
+    const auto cull_timer = Utilities::Timer{};
     auto [indirect_commands, point_ranges, spot_ranges] = build_indirect_commands(
         graphics_factory, instance_batches, selected_point_lights,
-        selected_spot_lights, batch_mesh_world_bounds, spot_shadow_matrices
+        selected_spot_lights, batch_mesh_world_bounds, spot_shadow_matrices,
+        view_commands, frame_memory, job_system
+    );
+    performance_logger.record_stage(
+        "point_spot_cull", Units::Seconds{cull_timer.elapsed_seconds()}
     );
 
     Expects(indirect_commands.size() <= max_indirect_draw_commands);
@@ -686,8 +770,8 @@ auto SDL_GPUPointSpotShadowPass::draw(
         const auto size = static_cast<uint32_t>(
             indirect_commands.size() * sizeof(IndirectDrawCommand)
         );
-        upload_via_transfer(
-            copy_pass, indirect_draw_transfer_buffer, indirect_draw_buffer,
+        staging_ring.upload(
+            copy_pass, indirect_draw_buffer,
             gsl::span{
                 reinterpret_cast<const std::byte*>(indirect_commands.data()),
                 size
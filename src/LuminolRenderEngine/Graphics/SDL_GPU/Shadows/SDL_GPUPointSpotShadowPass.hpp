@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory_resource>
 #include <vector>
 
 #include <gsl/gsl>
@@ -10,43 +11,57 @@
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUBuffer.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUGraphicsPipeline.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUInstanceBufferCache.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/Culling/SDL_GPUCullingUtils.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUMeshRenderPass.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUShader.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUTexture.hpp>
-#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUTransferBuffer.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUVertexFormat.hpp>
+#include <LuminolRenderEngine/Utilities/JobSystem.hpp>
 #include <LuminolRenderEngine/Utilities/PerformanceLogger.hpp>
 
 namespace Luminol::Graphics::SDL_GPU {
 
 class GPUDevice;
+struct ShaderCompileRequests;
 class CommandBuffer;
 class SDL_GPUFactory;
+class StagingRing;
 
 // Renders depth-only shadow maps for a capped, frame-selected subset of
 // point and spot lights (see LightManager::update_shadow_casters), since a
-// full shadow map per light is infeasible at up to max_point_lights /
-// max_spot_lights simultaneous lights. Point lights get a cube face set in a
+// full shadow map per light is infeasible at up to tens of thousands of
+// simultaneous lights. Point lights get a cube face set in a
 // TextureCubeArray (one cube per shadow-casting light, addressed by
 // direction + array slot); spot lights get a single 2D layer in a
 // Texture2DArray. Mirrors the per-pass class shape used by
 // SDL_GPUShadowPass.
 class SDL_GPUPointSpotShadowPass {
 public:
-    explicit SDL_GPUPointSpotShadowPass(GPUDevice& device);
+    SDL_GPUPointSpotShadowPass(GPUDevice& device, VertexFormat vertex_format);
+
+    [[nodiscard]] static auto get_shader_compile_requests(
+        VertexFormat vertex_format
+    ) -> ShaderCompileRequests;
 
     // light_data must already have shadow slots assigned (i.e.
     // LightManager::update_shadow_casters was called before
-    // LightManager::get_light_data() this frame). queued_draws provides the
-    // per-instance transforms used to compute world-space bounding spheres
-    // for per-light-face draw-call culling.
+    // LightManager::get_light_data() this frame). batch_mesh_world_bounds
+    // (this frame's compute_batch_mesh_world_bounds for instance_batches)
+    // drives the per-light-face draw-call culling, which job_system, if
+    // given, spreads across its threads one light view per job. Spot
+    // matrices and draw commands are staged through staging_ring; per-frame
+    // scratch comes from frame_memory.
     auto draw(
         const SDL_GPUFactory& graphics_factory,
         CommandBuffer& command_buffer,
+        StagingRing& staging_ring,
         const SDL_GPUInstanceBufferCache& instance_buffer_cache,
         gsl::span<const InstanceBatch> instance_batches,
-        const QueuedDraws& queued_draws,
+        const BatchMeshBounds& batch_mesh_world_bounds,
         const Light& light_data,
-        Utilities::PerformanceLogger& performance_logger
+        Utilities::PerformanceLogger& performance_logger,
+        std::pmr::memory_resource& frame_memory,
+        Utilities::JobSystem* job_system = nullptr
     ) -> void;
 
     [[nodiscard]] auto get_point_shadow_texture() const -> const Texture&;
@@ -55,6 +70,13 @@ public:
     [[nodiscard]] auto get_spot_shadow_sampler() const -> const Sampler&;
     [[nodiscard]] auto get_spot_shadow_matrix_buffer() const -> const Buffer&;
 
+    // One light view's surviving commands, with ranges relative to its own
+    // commands until draw() concatenates every view's.
+    struct ShadowViewCommands {
+        std::vector<IndirectDrawCommand> commands;
+        std::vector<IndirectDrawRange> ranges;
+    };
+
 private:
     Shader shadow_vertex_shader;
     Shader shadow_fragment_shader;
@@ -67,7 +89,6 @@ private:
     Sampler spot_shadow_sampler;
 
     Buffer spot_shadow_matrix_buffer;
-    TransferBuffer spot_shadow_matrix_transfer_buffer;
     // Per-slot spot light view-projection matrices, persisted across frames
     // so its heap capacity doesn't get freed and reallocated every frame;
     // lazily sized to max_shadow_casting_spot_lights on first use.
@@ -78,7 +99,10 @@ private:
     // submitted as a single indirect multi-draw call instead of one draw
     // call per surviving mesh.
     Buffer indirect_draw_buffer;
-    TransferBuffer indirect_draw_transfer_buffer;
+    // Per-view command lists, filled by parallel jobs so they can't come
+    // from the (single-threaded) frame arena; kept across frames so their
+    // capacity is reused instead of reallocated.
+    std::vector<ShadowViewCommands> view_commands;
 };
 
 }  // namespace Luminol::Graphics::SDL_GPU
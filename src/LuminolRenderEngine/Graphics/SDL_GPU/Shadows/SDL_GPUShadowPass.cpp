@@ -237,18 +237,18 @@ auto make_shadow_map_texture(GPUDevice& device) -> Texture {
 
 namespace Luminol::Graphics::SDL_GPU {
 
-SDL_GPUShadowPass::SDL_GPUShadowPass(GPUDevice& device)
-    : shadow_vertex_shader{make_hlsl_shader(
-          device, "res/shaders/sdl_gpu/pbr_vert.hlsl", ShaderStage::Vertex,
-          0U, 1U, 2U
-      )},
-      shadow_fragment_shader{make_hlsl_shader(
-          device, "res/shaders/sdl_gpu/shadow_depth_frag.hlsl",
-          ShaderStage::Fragment
-      )},
+SDL_GPUShadowPass::SDL_GPUShadowPass(
+    GPUDevice& device, VertexFormat vertex_format
+)
+    : shadow_vertex_shader{
+          device.create_shader(get_mesh_vertex_shader_info(vertex_format))
+      },
+      shadow_fragment_shader{
+          device.create_shader(get_depth_only_fragment_shader_info())
+      },
       shadow_pipeline{make_depth_only_mesh_pipeline(
           device, shadow_vertex_shader, shadow_fragment_shader,
-          shadow_map_format
+          shadow_map_format, vertex_format
       )},
       shadow_map_texture{make_shadow_map_texture(device)},
       shadow_map_sampler{make_clamp_linear_sampler(
@@ -263,18 +263,36 @@ SDL_GPUShadowPass::SDL_GPUShadowPass(GPUDevice& device)
           Matrix4x4f::identity(), Matrix4x4f::identity()
       } {}
 
+auto SDL_GPUShadowPass::get_shader_compile_requests(
+    VertexFormat vertex_format
+) -> ShaderCompileRequests {
+    return ShaderCompileRequests{
+        .shaders =
+            {
+                get_mesh_vertex_shader_info(vertex_format),
+                get_depth_only_fragment_shader_info(),
+            },
+        // The per-cascade cull passes' pipelines.
+        .compute_pipelines =
+            SDL_GPUInstanceCullPass::get_shader_compile_requests()
+                .compute_pipelines,
+    };
+}
+
 auto SDL_GPUShadowPass::draw(
     const SDL_GPUFactory& graphics_factory,
     CommandBuffer& command_buffer,
+    StagingRing& staging_ring,
     const SDL_GPUInstanceBufferCache& instance_buffer_cache,
     gsl::span<const InstanceBatch> instance_batches,
-    const QueuedDraws& queued_draws,
+    const BatchMeshBounds& batch_mesh_world_bounds,
     const Maths::Vector3f& light_direction,
     const Maths::Matrix4x4f& view_matrix,
     const Maths::Matrix4x4f& projection_matrix,
     const Texture& hiz_pyramid,
     const Sampler& hiz_sampler,
-    Utilities::PerformanceLogger& performance_logger
+    Utilities::PerformanceLogger& performance_logger,
+    std::pmr::memory_resource& frame_memory
 ) -> void {
     const auto pass_timer = Utilities::Timer{};
     command_buffer.push_debug_group("shadow_pass");
@@ -285,11 +303,7 @@ auto SDL_GPUShadowPass::draw(
     );
     const auto camera_position = get_view_position(view_matrix);
 
-    // One world-space AABB per (batch, submesh), reused for every cascade's
-    // frustum test below instead of being recomputed per cascade.
-    const auto batch_mesh_world_bounds = compute_batch_mesh_world_bounds(
-        graphics_factory, instance_batches, queued_draws
-    );
+    Expects(batch_mesh_world_bounds.size() == instance_batches.size());
 
     const auto shadow_map_texture_view =
         TextureView{shadow_map_texture.native_handle()};
@@ -299,10 +313,14 @@ auto SDL_GPUShadowPass::draw(
     // pass while a render pass is active, so every cascade's cull() (which
     // opens its own copy + compute passes) runs first, and its results
     // (filtered batch list + resulting layout) are stashed for phase 2.
+    // Each inner batch list allocates from frame_memory too.
     auto cascade_filtered_batches =
-        std::array<std::vector<InstanceBatch>, shadow_pass_num_cascades>{};
+        std::pmr::vector<std::pmr::vector<InstanceBatch>>(
+            shadow_pass_num_cascades, &frame_memory
+        );
     auto cascade_cull_layouts =
-        std::array<InstanceCullLayout, shadow_pass_num_cascades>{};
+        std::pmr::vector<InstanceCullLayout>{&frame_memory};
+    cascade_cull_layouts.reserve(shadow_pass_num_cascades);
 
     for (auto cascade_index = 0U; cascade_index < shadow_pass_num_cascades;
          ++cascade_index) {
@@ -325,10 +343,11 @@ auto SDL_GPUShadowPass::draw(
         // orthographic frustum, so the per-instance GPU cull dispatch below
         // isn't even issued for batches nowhere near this cascade.
         auto& filtered_batches = cascade_filtered_batches[cascade_index];
+        filtered_batches.reserve(instance_batches.size());
         for (auto batch_index = std::size_t{0};
              batch_index < instance_batches.size(); ++batch_index) {
             const auto& batch = instance_batches[batch_index];
-            const auto& mesh_bounds = batch_mesh_world_bounds[batch_index];
+            const auto mesh_bounds = batch_mesh_world_bounds[batch_index];
             const auto batch_in_frustum = std::any_of(
                 mesh_bounds.begin(), mesh_bounds.end(),
                 [&cascade_frustum_planes](const BoundingBox& bounds) {
@@ -342,13 +361,14 @@ auto SDL_GPUShadowPass::draw(
             }
         }
 
-        cascade_cull_layouts[cascade_index] =
+        cascade_cull_layouts.push_back(
             cascade_cull_passes[cascade_index].cull(
-                graphics_factory, command_buffer, instance_buffer_cache,
-                filtered_batches, cascade_frustum_planes,
+                graphics_factory, command_buffer, staging_ring,
+                instance_buffer_cache, filtered_batches, cascade_frustum_planes,
                 cascade_light_space_matrices.at(cascade_index), hiz_pyramid,
-                hiz_sampler, 0U, camera_position, true
-            );
+                hiz_sampler, 0U, camera_position, true, frame_memory
+            )
+        );
     }
 
     // Phase 2: per-cascade render passes, drawing only the instances each
@@ -386,7 +406,7 @@ auto SDL_GPUShadowPass::draw(
         for (auto batch_index = std::size_t{0};
              batch_index < filtered_batches.size(); ++batch_index) {
             const auto& batch = filtered_batches[batch_index];
-            const auto& submesh_infos = cull_layout[batch_index];
+            const auto submesh_infos = cull_layout[batch_index];
 
             if (submesh_infos.empty()) {
                 continue;
@@ -413,6 +433,10 @@ auto SDL_GPUShadowPass::draw(
                 graphics_factory.get_index_buffer(batch.renderable_id),
                 IndexElementSize::Bits32, 0
             );
+            push_vertex_dequantization(
+                command_buffer,
+                graphics_factory.get_vertex_dequantization(batch.renderable_id)
+            );
 
             // Every submesh in this batch's IndirectDrawCommand slice is
             // contiguous (SDL_GPUInstanceCullPass::cull builds them that
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <memory_resource>
 #include <vector>
 
 #include <gsl/gsl>
@@ -9,17 +10,21 @@
 
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUGraphicsPipeline.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUInstanceBufferCache.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/Culling/SDL_GPUCullingUtils.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/Culling/SDL_GPUInstanceCullPass.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUMeshRenderPass.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUShader.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUTexture.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUVertexFormat.hpp>
 #include <LuminolRenderEngine/Utilities/PerformanceLogger.hpp>
 
 namespace Luminol::Graphics::SDL_GPU {
 
 class GPUDevice;
+struct ShaderCompileRequests;
 class CommandBuffer;
 class SDL_GPUFactory;
+class StagingRing;
 
 // Renders scene depth from the directional light's point of view into a
 // cascaded shadow map: the camera frustum is split into
@@ -30,20 +35,30 @@ class SDL_GPUFactory;
 // Mirrors the per-pass class shape used by SDL_GPUAmbientOcclusionPass.
 class SDL_GPUShadowPass {
 public:
-    explicit SDL_GPUShadowPass(GPUDevice& device);
+    SDL_GPUShadowPass(GPUDevice& device, VertexFormat vertex_format);
 
+    [[nodiscard]] static auto get_shader_compile_requests(
+        VertexFormat vertex_format
+    ) -> ShaderCompileRequests;
+
+    // batch_mesh_world_bounds: this frame's compute_batch_mesh_world_bounds
+    // for instance_batches, shared with the other passes that need it. The
+    // cascade cull passes stage through staging_ring. The per-cascade batch
+    // lists and cull layouts are allocated from frame_memory.
     auto draw(
         const SDL_GPUFactory& graphics_factory,
         CommandBuffer& command_buffer,
+        StagingRing& staging_ring,
         const SDL_GPUInstanceBufferCache& instance_buffer_cache,
         gsl::span<const InstanceBatch> instance_batches,
-        const QueuedDraws& queued_draws,
+        const BatchMeshBounds& batch_mesh_world_bounds,
         const Maths::Vector3f& light_direction,
         const Maths::Matrix4x4f& view_matrix,
         const Maths::Matrix4x4f& projection_matrix,
         const Texture& hiz_pyramid,
         const Sampler& hiz_sampler,
-        Utilities::PerformanceLogger& performance_logger
+        Utilities::PerformanceLogger& performance_logger,
+        std::pmr::memory_resource& frame_memory
     ) -> void;
 
     [[nodiscard]] auto get_shadow_map_texture() const -> const Texture&;
@@ -80,6 +80,18 @@ auto strip_translation(const Matrix4x4f& view_matrix) -> Matrix4x4f {
     }};
 }
 
+auto get_skybox_vertex_shader_info() -> ShaderInfo {
+    return make_hlsl_shader_info(
+        "res/shaders/sdl_gpu/skybox_vert.hlsl", ShaderStage::Vertex, 0U, 1U
+    );
+}
+
+auto get_skybox_fragment_shader_info() -> ShaderInfo {
+    return make_hlsl_shader_info(
+        "res/shaders/sdl_gpu/skybox_frag.hlsl", ShaderStage::Fragment, 1U, 0U
+    );
+}
+
 }  // namespace
 
 namespace Luminol::Graphics::SDL_GPU {
@@ -87,25 +99,29 @@ namespace Luminol::Graphics::SDL_GPU {
 SDL_GPUSkyboxRenderPass::SDL_GPUSkyboxRenderPass(
     GPUDevice& device, SampleCount sample_count
 )
-    : skybox_vertex_shader{make_hlsl_shader(
-          device,
-          "res/shaders/sdl_gpu/skybox_vert.hlsl",
-          ShaderStage::Vertex,
-          0U,
-          1U
-      )},
-      skybox_fragment_shader{make_hlsl_shader(
-          device,
-          "res/shaders/sdl_gpu/skybox_frag.hlsl",
-          ShaderStage::Fragment,
-          1U,
-          0U
-      )},
+    : skybox_vertex_shader{
+          device.create_shader(get_skybox_vertex_shader_info())
+      },
+      skybox_fragment_shader{
+          device.create_shader(get_skybox_fragment_shader_info())
+      },
       skybox_pipeline{make_skybox_pipeline(
           device, skybox_vertex_shader, skybox_fragment_shader, sample_count
       )},
       skybox{make_skybox(device)} {}
 
+auto SDL_GPUSkyboxRenderPass::get_shader_compile_requests()
+    -> ShaderCompileRequests {
+    return ShaderCompileRequests{
+        .shaders =
+            {
+                get_skybox_vertex_shader_info(),
+                get_skybox_fragment_shader_info(),
+            },
+        .compute_pipelines = {},
+    };
+}
+
 auto SDL_GPUSkyboxRenderPass::draw(
     CommandBuffer& command_buffer,
     RenderPass& render_pass,
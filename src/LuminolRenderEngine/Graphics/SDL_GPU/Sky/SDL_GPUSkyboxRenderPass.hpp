@@ -9,6 +9,7 @@
 namespace Luminol::Graphics::SDL_GPU {
 
 class GPUDevice;
+struct ShaderCompileRequests;
 class CommandBuffer;
 class RenderPass;
 
@@ -22,6 +23,9 @@ class SDL_GPUSkyboxRenderPass {
 public:
     SDL_GPUSkyboxRenderPass(GPUDevice& device, SampleCount sample_count);
 
+    [[nodiscard]] static auto get_shader_compile_requests()
+        -> ShaderCompileRequests;
+
     auto draw(
         CommandBuffer& command_buffer,
         RenderPass& render_pass,
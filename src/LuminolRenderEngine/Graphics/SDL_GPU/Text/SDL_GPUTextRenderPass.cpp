@@ -1,7 +1,10 @@
 #include "SDL_GPUTextRenderPass.hpp"
 
+#include <algorithm>
 #include <array>
-#include <cstring>
+#include <bit>
+#include <iterator>
+#include <utility>
 
 #include <gsl/gsl>
 
@@ -10,7 +13,7 @@
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUDevice.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/RenderPasses/SDL_GPURenderPass.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUResourceBuilders.hpp>
-#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUTransferBuffer.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUStagingRing.hpp>
 
 namespace {
 
@@ -69,29 +72,43 @@ auto make_text_pipeline(
     });
 }
 
+auto get_text_vertex_shader_info() -> ShaderInfo {
+    return make_hlsl_shader_info(
+        "res/shaders/sdl_gpu/text_vert.hlsl", ShaderStage::Vertex, 0U, 1U
+    );
+}
+
+auto get_text_fragment_shader_info() -> ShaderInfo {
+    return make_hlsl_shader_info(
+        "res/shaders/sdl_gpu/text_frag.hlsl", ShaderStage::Fragment, 1U, 0U
+    );
+}
+
 }  // namespace
 
 namespace Luminol::Graphics::SDL_GPU {
 
 SDL_GPUTextRenderPass::SDL_GPUTextRenderPass(GPUDevice& device, SDL_Window* window)
-    : text_vertex_shader{make_hlsl_shader(
-          device,
-          "res/shaders/sdl_gpu/text_vert.hlsl",
-          ShaderStage::Vertex,
-          0U,
-          1U
-      )},
-      text_fragment_shader{make_hlsl_shader(
-          device,
-          "res/shaders/sdl_gpu/text_frag.hlsl",
-          ShaderStage::Fragment,
-          1U,
-          0U
-      )},
+    : text_vertex_shader{device.create_shader(get_text_vertex_shader_info())},
+      text_fragment_shader{
+          device.create_shader(get_text_fragment_shader_info())
+      },
       text_pipeline{make_text_pipeline(
           device, window, text_vertex_shader, text_fragment_shader
       )} {}
 
+auto SDL_GPUTextRenderPass::get_shader_compile_requests()
+    -> ShaderCompileRequests {
+    return ShaderCompileRequests{
+        .shaders =
+            {
+                get_text_vertex_shader_info(),
+                get_text_fragment_shader_info(),
+            },
+        .compute_pipelines = {},
+    };
+}
+
 auto SDL_GPUTextRenderPass::queue_draw(
     FontId font_id,
     const SDL_GPUFont& font,
@@ -103,8 +120,13 @@ auto SDL_GPUTextRenderPass::queue_draw(
         return;
     }
 
-    pending_fonts.emplace(font_id, &font);
-    auto& vertices = pending_glyphs[font_id];
+    auto queued = std::ranges::find(queued_text, font_id, &QueuedText::font_id);
+    if (queued == queued_text.end()) {
+        queued_text.push_back(QueuedText{.font_id = font_id});
+        queued = std::prev(queued_text.end());
+    }
+    queued->font = &font;
+    auto& vertices = queued->vertices;
 
     auto pen_x = position.x();
     const auto baseline_y = position.y() + font.get_ascent();
@@ -156,51 +178,73 @@ auto SDL_GPUTextRenderPass::queue_draw(
     }
 }
 
+auto SDL_GPUTextRenderPass::hand_off_queued_text() -> void {
+    for (auto& geometry : font_geometry) {
+        geometry.vertices.clear();
+    }
+
+    for (auto& queued : queued_text) {
+        if (queued.vertices.empty()) {
+            continue;
+        }
+
+        auto geometry = std::ranges::find(
+            font_geometry, queued.font_id, &FontGeometry::font_id
+        );
+        if (geometry == font_geometry.end()) {
+            font_geometry.push_back(FontGeometry{.font_id = queued.font_id});
+            geometry = std::prev(font_geometry.end());
+        }
+        geometry->font = queued.font;
+        std::swap(geometry->vertices, queued.vertices);
+    }
+}
+
 auto SDL_GPUTextRenderPass::flush_frame_geometry(
-    GPUDevice& device, CommandBuffer& command_buffer
+    GPUDevice& device, CommandBuffer& command_buffer, StagingRing& staging_ring
 ) -> void {
-    draw_batches.clear();
+    auto has_pending_geometry = false;
+    for (auto& geometry : font_geometry) {
+        // Whatever a draw() that never ran (a frame cut short) left behind
+        // is stale by now.
+        geometry.vertex_count = 0;
+        has_pending_geometry =
+            has_pending_geometry || !geometry.vertices.empty();
+    }
+    if (!has_pending_geometry) {
+        return;
+    }
 
-    if (!pending_glyphs.empty()) {
-        auto copy_pass = command_buffer.begin_copy_pass();
-        for (auto& [font_id, vertices] : pending_glyphs) {
-            if (vertices.empty()) {
-                continue;
-            }
+    auto copy_pass = command_buffer.begin_copy_pass();
+    for (auto& geometry : font_geometry) {
+        if (geometry.vertices.empty()) {
+            continue;
+        }
 
-            const auto size_bytes =
-                static_cast<uint32_t>(vertices.size() * sizeof(TextVertex));
+        const auto size_bytes = static_cast<uint32_t>(
+            geometry.vertices.size() * sizeof(TextVertex)
+        );
 
-            auto vertex_buffer = device.create_buffer(BufferInfo{
+        // Grown to the next power of two, so text that gets a little longer
+        // each frame doesn't recreate it each time.
+        if (!geometry.vertex_buffer.has_value() ||
+            geometry.vertex_buffer->get_size() < size_bytes) {
+            geometry.vertex_buffer = device.create_buffer(BufferInfo{
                 .usage = BufferUsage::Vertex,
-                .size = size_bytes,
-            });
-
-            auto transfer_buffer =
-                device.create_transfer_buffer(TransferBufferInfo{
-                    .usage = TransferBufferUsage::Upload,
-                    .size = size_bytes,
-                });
-            {
-                const auto mapped = transfer_buffer.map(false);
-                std::memcpy(mapped.data(), vertices.data(), size_bytes);
-                transfer_buffer.unmap();
-            }
-
-            copy_pass.upload_to_buffer(
-                transfer_buffer, 0, vertex_buffer, 0, size_bytes, false
-            );
-
-            draw_batches.push_back(DrawBatch{
-                .font = pending_fonts.at(font_id),
-                .vertex_buffer = std::move(vertex_buffer),
-                .vertex_count = static_cast<uint32_t>(vertices.size()),
+                .size = std::bit_ceil(size_bytes),
             });
         }
-    }
 
-    pending_glyphs.clear();
-    pending_fonts.clear();
+        // Cycling, since last frame's draw may still be pending on the GPU.
+        staging_ring.upload(
+            copy_pass, *geometry.vertex_buffer,
+            gsl::as_bytes(gsl::span{geometry.vertices})
+        );
+
+        geometry.vertex_count =
+            static_cast<uint32_t>(geometry.vertices.size());
+        geometry.vertices.clear();
+    }
 }
 
 auto SDL_GPUTextRenderPass::draw(
@@ -209,41 +253,50 @@ auto SDL_GPUTextRenderPass::draw(
     uint32_t screen_width,
     uint32_t screen_height
 ) -> void {
-    if (!draw_batches.empty()) {
-        render_pass.bind_graphics_pipeline(text_pipeline);
+    const auto has_geometry = std::ranges::any_of(
+        font_geometry,
+        [](const FontGeometry& geometry) { return geometry.vertex_count > 0; }
+    );
+    if (!has_geometry) {
+        return;
+    }
 
-        const auto vertex_uniforms = TextVertexUniforms{
-            .screen_size = Maths::Vector2f{
-                static_cast<float>(screen_width),
-                static_cast<float>(screen_height)
-            },
-            .padding = Maths::Vector2f{0.0F, 0.0F},
-        };
-        command_buffer.push_vertex_uniform_data(
-            0,
-            gsl::span{
-                reinterpret_cast<const std::byte*>(&vertex_uniforms),
-                sizeof(vertex_uniforms)
-            }
-        );
+    render_pass.bind_graphics_pipeline(text_pipeline);
+
+    const auto vertex_uniforms = TextVertexUniforms{
+        .screen_size = Maths::Vector2f{
+            static_cast<float>(screen_width),
+            static_cast<float>(screen_height)
+        },
+        .padding = Maths::Vector2f{0.0F, 0.0F},
+    };
+    command_buffer.push_vertex_uniform_data(
+        0,
+        gsl::span{
+            reinterpret_cast<const std::byte*>(&vertex_uniforms),
+            sizeof(vertex_uniforms)
+        }
+    );
 
-        for (const auto& batch : draw_batches) {
-            const auto vertex_bindings = std::array{VertexBufferBinding{
-                .buffer = &batch.vertex_buffer, .offset = 0
-            }};
-            render_pass.bind_vertex_buffers(0, vertex_bindings);
+    for (auto& geometry : font_geometry) {
+        if (geometry.vertex_count == 0) {
+            continue;
+        }
 
-            const auto sampler_bindings = std::array{TextureSamplerBinding{
-                .texture = &batch.font->get_atlas_texture(),
-                .sampler = &batch.font->get_atlas_sampler()
-            }};
-            render_pass.bind_fragment_samplers(0, sampler_bindings);
+        const auto vertex_bindings = std::array{VertexBufferBinding{
+            .buffer = &*geometry.vertex_buffer, .offset = 0
+        }};
+        render_pass.bind_vertex_buffers(0, vertex_bindings);
 
-            render_pass.draw_primitives(batch.vertex_count, 1, 0, 0);
-        }
-    }
+        const auto sampler_bindings = std::array{TextureSamplerBinding{
+            .texture = &geometry.font->get_atlas_texture(),
+            .sampler = &geometry.font->get_atlas_sampler()
+        }};
+        render_pass.bind_fragment_samplers(0, sampler_bindings);
 
-    draw_batches.clear();
+        render_pass.draw_primitives(geometry.vertex_count, 1, 0, 0);
+        geometry.vertex_count = 0;
+    }
 }
 
 }  // namespace Luminol::Graphics::SDL_GPU
@@ -1,7 +1,7 @@
 #pragma once
 
+#include <optional>
 #include <string_view>
-#include <unordered_map>
 #include <vector>
 
 #include <LuminolMaths/Vector.hpp>
@@ -16,23 +16,28 @@ struct SDL_Window;
 namespace Luminol::Graphics::SDL_GPU {
 
 class GPUDevice;
+struct ShaderCompileRequests;
 class CommandBuffer;
 class RenderPass;
+class StagingRing;
 
 // Renders screen-space text as alpha-blended quads sampling each font's
 // pre-baked glyph atlas (see SDL_GPUFont) on top of the final tonemapped
 // image. Unlike a per-string-texture design, no GPU resources are
 // allocated per frame - queue_draw only does CPU quad-geometry math, and
-// flush_frame_geometry uploads one small vertex buffer per font used that
-// frame.
+// flush_frame_geometry uploads it into a vertex buffer per font that's kept
+// across frames and only grows.
 class SDL_GPUTextRenderPass {
 public:
     SDL_GPUTextRenderPass(GPUDevice& device, SDL_Window* window);
 
+    [[nodiscard]] static auto get_shader_compile_requests()
+        -> ShaderCompileRequests;
+
     // CPU-only: looks up glyph quads from font's atlas and appends them to
-    // this frame's pending geometry. No GPU device/command-buffer work,
+    // the next frame's queued geometry. No GPU device/command-buffer work,
     // since no command buffer exists yet at the point application code
-    // calls this (before draw()). See flush_frame_geometry.
+    // calls this (before draw()). See hand_off_queued_text.
     auto queue_draw(
         FontId font_id,
         const SDL_GPUFont& font,
@@ -41,12 +46,23 @@ public:
         const Maths::Vector4f& color
     ) -> void;
 
-    // Uploads this frame's queued glyph geometry (one vertex buffer per
-    // font used), batched into one copy pass on the caller's
+    // Makes everything queue_draw queued since the last call this frame's
+    // pending geometry, dropping whatever an unflushed frame left behind.
+    // Kept apart from queue_draw's list so the caller can keep queueing the
+    // next frame's text while another thread flushes and draws this one
+    // (see SDL_GPURenderer::set_render_thread_enabled) - call it while
+    // neither flush_frame_geometry nor draw is running.
+    auto hand_off_queued_text() -> void;
+
+    // Uploads this frame's pending glyph geometry (through staging_ring into
+    // each font's vertex buffer), batched into one copy pass on the caller's
     // command_buffer. Must run before any render pass is opened on
     // command_buffer this frame, and before draw() below.
-    auto flush_frame_geometry(GPUDevice& device, CommandBuffer& command_buffer)
-        -> void;
+    auto flush_frame_geometry(
+        GPUDevice& device,
+        CommandBuffer& command_buffer,
+        StagingRing& staging_ring
+    ) -> void;
 
     auto draw(
         CommandBuffer& command_buffer,
@@ -62,19 +78,34 @@ private:
         Maths::Vector4f color;
     };
 
-    struct DrawBatch {
+    // Everything for one font that's been drawn with, kept across frames
+    // (vertices' capacity included) so a steady stream of text doesn't
+    // allocate. vertices is this frame's pending geometry; vertex_count is
+    // how much of it flush_frame_geometry uploaded for draw().
+    struct FontGeometry {
+        FontId font_id;
         const SDL_GPUFont* font = nullptr;
-        Buffer vertex_buffer;
+        std::vector<TextVertex> vertices = {};
+        std::optional<Buffer> vertex_buffer = std::nullopt;
         uint32_t vertex_count = 0;
     };
 
+    // queue_draw's geometry for one font, waiting for hand_off_queued_text.
+    struct QueuedText {
+        FontId font_id;
+        const SDL_GPUFont* font = nullptr;
+        std::vector<TextVertex> vertices = {};
+    };
+
     Shader text_vertex_shader;
     Shader text_fragment_shader;
     GraphicsPipeline text_pipeline;
 
-    std::unordered_map<FontId, std::vector<TextVertex>> pending_glyphs;
-    std::unordered_map<FontId, const SDL_GPUFont*> pending_fonts;
-    std::vector<DrawBatch> draw_batches;
+    // Both searched linearly - a frame only ever uses a handful of fonts.
+    // Their vertex lists are swapped, never copied, on hand-off, so each
+    // keeps the other's capacity.
+    std::vector<QueuedText> queued_text;
+    std::vector<FontGeometry> font_geometry;
 };
 
 }  // namespace Luminol::Graphics::SDL_GPU
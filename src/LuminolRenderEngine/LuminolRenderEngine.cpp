@@ -9,9 +9,29 @@ namespace Luminol {
 RenderEngine::RenderEngine(const Properties& properties)
     : window(properties.width, properties.height, properties.title),
       renderer(std::make_shared<Graphics::SDL_GPU::SDL_GPUFactory>(
-                   properties.msaa_sample_count
+                   properties.msaa_sample_count,
+                   Utilities::ModelLoader::LoadOptions{
+                       .texture_decode_worker_count =
+                           properties.texture_decode_worker_count,
+                       .mesh_bake_worker_count =
+                           properties.mesh_bake_worker_count,
+                   },
+                   properties.use_compact_vertex_format
+                       ? Graphics::SDL_GPU::VertexFormat::Compact
+                       : Graphics::SDL_GPU::VertexFormat::Full
                )
-                   ->create_renderer(this->window)) {}
+                   ->create_renderer(this->window)) {
+    this->renderer->get_light_manager().set_capacity(Graphics::LightCapacity{
+        .max_point_lights = properties.max_point_lights,
+        .max_spot_lights = properties.max_spot_lights,
+    });
+    this->renderer->set_light_index_budget(properties.light_index_budget_bytes);
+    this->renderer->set_frame_prep_worker_count(
+        properties.frame_prep_worker_count
+    );
+    this->renderer->set_frames_in_flight(properties.frames_in_flight);
+    this->renderer->set_render_thread_enabled(properties.use_render_thread);
+}
 
 RenderEngine::~RenderEngine() = default;
 
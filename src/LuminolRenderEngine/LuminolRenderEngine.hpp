@@ -6,6 +6,7 @@
 
 #include <LuminolRenderEngine/Window/Window.hpp>
 #include <LuminolRenderEngine/Graphics/Camera.hpp>
+#include <LuminolRenderEngine/Graphics/Light.hpp>
 #include <LuminolRenderEngine/Graphics/RenderableManager.hpp>
 
 namespace Luminol::Graphics::SDL_GPU {
@@ -24,6 +25,35 @@ struct Properties {
     // MSAA sample count; rounded down to the nearest supported power of
     // two, clamped further by device capability.
     uint32_t msaa_sample_count = 4;
+    // Threads used to decode a model's material textures in
+    // create_renderable(model_path) - 0 means one per hardware thread.
+    uint32_t texture_decode_worker_count = 0;
+    // Threads used to optimize/meshletize a model's submeshes when it isn't
+    // in the mesh cache yet - 0 means one per hardware thread.
+    uint32_t mesh_bake_worker_count = 0;
+    // Threads each frame's CPU-side preparation (instance uploads, light
+    // repacking, culling setup) is spread across - 0 means one per hardware
+    // thread. See SDL_GPURenderer::set_frame_prep_worker_count.
+    uint32_t frame_prep_worker_count = 0;
+    // Frames the CPU may queue ahead of the GPU, 1-3 - 1 for the lowest
+    // latency, 3 for the most throughput. See
+    // SDL_GPURenderer::set_frames_in_flight.
+    uint32_t frames_in_flight = 2;
+    // Record and submit frames on a dedicated render thread, so draw()
+    // returns while the frame renders - see
+    // SDL_GPURenderer::set_render_thread_enabled.
+    bool use_render_thread = false;
+    // Most point/spot lights the renderer's LightManager holds at once -
+    // see LightManager::set_capacity.
+    uint32_t max_point_lights = Graphics::default_max_point_lights;
+    uint32_t max_spot_lights = Graphics::default_max_spot_lights;
+    // VRAM the clustered light culling's global light index list may grow
+    // to - 8 MiB by default. See SDL_GPURenderer::set_light_index_budget.
+    uint32_t light_index_budget_bytes = uint32_t{8} << 20U;
+    // Store every renderable's vertices quantized (20 bytes instead of 44,
+    // see SDL_GPU::VertexFormat::Compact) - less VRAM and vertex fetch
+    // bandwidth, at a small cost in position/normal precision.
+    bool use_compact_vertex_format = false;
 };
 
 class RenderEngine {
@@ -0,0 +1,201 @@
+#include "AllocationCounter.hpp"
+
+#ifdef LUMINOL_COUNT_HEAP_ALLOCATIONS
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<uint64_t> heap_allocation_count{0};
+
+auto aligned_malloc(std::size_t size, std::align_val_t alignment) -> void* {
+    const auto alignment_size = static_cast<std::size_t>(alignment);
+#ifdef _MSC_VER
+    return _aligned_malloc(size, alignment_size);
+#else
+    // aligned_alloc wants size to be a multiple of the alignment.
+    const auto padded_size =
+        (size + alignment_size - 1) / alignment_size * alignment_size;
+    return std::aligned_alloc(alignment_size, padded_size);
+#endif
+}
+
+auto aligned_free(void* pointer) -> void {
+#ifdef _MSC_VER
+    _aligned_free(pointer);
+#else
+    std::free(pointer);
+#endif
+}
+
+// Counts once per operator new call, however many times the new handler
+// has to be run to satisfy it.
+template <typename Allocate>
+auto counted_allocate(Allocate&& allocate) -> void* {
+    heap_allocation_count.fetch_add(1, std::memory_order_relaxed);
+
+    while (true) {
+        auto* pointer = allocate();
+        if (pointer != nullptr) {
+            return pointer;
+        }
+
+        const auto new_handler = std::get_new_handler();
+        if (new_handler == nullptr) {
+            throw std::bad_alloc{};
+        }
+        new_handler();
+    }
+}
+
+auto allocate(std::size_t size) -> void* {
+    return counted_allocate([size] {
+        return std::malloc(size == 0 ? 1 : size);
+    });
+}
+
+auto allocate(std::size_t size, std::align_val_t alignment) -> void* {
+    return counted_allocate([size, alignment] {
+        return aligned_malloc(size == 0 ? 1 : size, alignment);
+    });
+}
+
+}  // namespace
+
+// Every replaceable overload, so nothing falls through to the standard
+// library's allocator and then gets freed by the free() below.
+// NOLINTBEGIN(cert-dcl54-cpp, misc-new-delete-overloads)
+auto operator new(std::size_t size) -> void* { return allocate(size); }
+
+auto operator new[](std::size_t size) -> void* { return allocate(size); }
+
+auto operator new(std::size_t size, const std::nothrow_t& /*tag*/) noexcept
+    -> void* {
+    try {
+        return allocate(size);
+    } catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+auto operator new[](std::size_t size, const std::nothrow_t& /*tag*/) noexcept
+    -> void* {
+    try {
+        return allocate(size);
+    } catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+auto operator new(std::size_t size, std::align_val_t alignment) -> void* {
+    return allocate(size, alignment);
+}
+
+auto operator new[](std::size_t size, std::align_val_t alignment) -> void* {
+    return allocate(size, alignment);
+}
+
+auto operator new(
+    std::size_t size,
+    std::align_val_t alignment,
+    const std::nothrow_t& /*tag*/
+) noexcept -> void* {
+    try {
+        return allocate(size, alignment);
+    } catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+auto operator new[](
+    std::size_t size,
+    std::align_val_t alignment,
+    const std::nothrow_t& /*tag*/
+) noexcept -> void* {
+    try {
+        return allocate(size, alignment);
+    } catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+auto operator delete(void* pointer) noexcept -> void { std::free(pointer); }
+
+auto operator delete[](void* pointer) noexcept -> void { std::free(pointer); }
+
+auto operator delete(void* pointer, std::size_t /*size*/) noexcept -> void {
+    std::free(pointer);
+}
+
+auto operator delete[](void* pointer, std::size_t /*size*/) noexcept -> void {
+    std::free(pointer);
+}
+
+auto operator delete(void* pointer, const std::nothrow_t& /*tag*/) noexcept
+    -> void {
+    std::free(pointer);
+}
+
+auto operator delete[](void* pointer, const std::nothrow_t& /*tag*/) noexcept
+    -> void {
+    std::free(pointer);
+}
+
+auto operator delete(void* pointer, std::align_val_t /*alignment*/) noexcept
+    -> void {
+    aligned_free(pointer);
+}
+
+auto operator delete[](void* pointer, std::align_val_t /*alignment*/) noexcept
+    -> void {
+    aligned_free(pointer);
+}
+
+auto operator delete(
+    void* pointer, std::size_t /*size*/, std::align_val_t /*alignment*/
+) noexcept -> void {
+    aligned_free(pointer);
+}
+
+auto operator delete[](
+    void* pointer, std::size_t /*size*/, std::align_val_t /*alignment*/
+) noexcept -> void {
+    aligned_free(pointer);
+}
+
+auto operator delete(
+    void* pointer,
+    std::align_val_t /*alignment*/,
+    const std::nothrow_t& /*tag*/
+) noexcept -> void {
+    aligned_free(pointer);
+}
+
+auto operator delete[](
+    void* pointer,
+    std::align_val_t /*alignment*/,
+    const std::nothrow_t& /*tag*/
+) noexcept -> void {
+    aligned_free(pointer);
+}
+// NOLINTEND(cert-dcl54-cpp, misc-new-delete-overloads)
+
+namespace Luminol::Utilities {
+
+auto get_heap_allocation_count() -> uint64_t {
+    return heap_allocation_count.load(std::memory_order_relaxed);
+}
+
+}  // namespace Luminol::Utilities
+
+#else
+
+namespace Luminol::Utilities {
+
+auto get_heap_allocation_count() -> uint64_t { return 0; }
+
+}  // namespace Luminol::Utilities
+
+#endif
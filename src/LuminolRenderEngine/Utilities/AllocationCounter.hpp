@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Luminol::Utilities {
+
+// Whether this build counts heap allocations - see
+// get_heap_allocation_count().
+[[nodiscard]] constexpr auto is_counting_heap_allocations() -> bool {
+#ifdef LUMINOL_COUNT_HEAP_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Calls to the global operator new (every overload) made so far by every
+// thread in the process. Always 0 unless built with the
+// LUMINOL_RENDER_ENGINE_COUNT_HEAP_ALLOCATIONS CMake option, which replaces
+// operator new and delete with malloc-backed versions that bump a relaxed
+// atomic. A debug aid for keeping the frame path allocation-free, not a
+// profiler - allocations straight through malloc (SDL's, for one) aren't
+// seen.
+[[nodiscard]] auto get_heap_allocation_count() -> uint64_t;
+
+}  // namespace Luminol::Utilities
@@ -0,0 +1,80 @@
+#include "FrameArena.hpp"
+
+#include <algorithm>
+
+namespace Luminol::Utilities {
+
+FrameArena::FrameArena(std::size_t initial_capacity) {
+    this->push_block(std::max(initial_capacity, std::size_t{1}));
+}
+
+auto FrameArena::reset() -> void {
+    // Frees the chain only after a frame that overflowed, trading it for one
+    // block that fits that frame - the steady state keeps its single block.
+    if (this->blocks.size() > 1) {
+        const auto capacity = this->get_capacity();
+        this->blocks.clear();
+        this->push_block(capacity);
+    }
+
+    this->block_offset = 0;
+    this->retired_bytes_used = 0;
+}
+
+auto FrameArena::get_bytes_used() const -> std::size_t {
+    return this->retired_bytes_used + this->block_offset;
+}
+
+auto FrameArena::get_capacity() const -> std::size_t {
+    auto capacity = std::size_t{0};
+    for (const auto& block : this->blocks) {
+        capacity += block.size;
+    }
+    return capacity;
+}
+
+auto FrameArena::do_allocate(std::size_t bytes, std::size_t alignment)
+    -> void* {
+    auto* block = &this->blocks.back();
+    void* pointer = block->memory.get() + this->block_offset;
+    auto space = block->size - this->block_offset;
+
+    if (std::align(alignment, bytes, pointer, space) == nullptr) {
+        // Doubling keeps a frame that overflows by a lot to a few blocks;
+        // bytes + alignment fits this allocation at any alignment.
+        const auto size = std::max(block->size * 2, bytes + alignment);
+        this->retired_bytes_used += this->block_offset;
+        this->push_block(size);
+
+        block = &this->blocks.back();
+        pointer = block->memory.get();
+        space = block->size;
+        std::align(alignment, bytes, pointer, space);
+    }
+
+    this->block_offset =
+        static_cast<std::size_t>(
+            static_cast<std::byte*>(pointer) - block->memory.get()
+        ) +
+        bytes;
+    return pointer;
+}
+
+auto FrameArena::do_deallocate(
+    void* /*pointer*/, std::size_t /*bytes*/, std::size_t /*alignment*/
+) -> void {}
+
+auto FrameArena::do_is_equal(const std::pmr::memory_resource& other)
+    const noexcept -> bool {
+    return this == &other;
+}
+
+auto FrameArena::push_block(std::size_t size) -> void {
+    this->blocks.push_back(Block{
+        .memory = std::make_unique_for_overwrite<std::byte[]>(size),
+        .size = size,
+    });
+    this->block_offset = 0;
+}
+
+}  // namespace Luminol::Utilities
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace Luminol::Utilities {
+
+// Bump allocator for memory that lives for exactly one frame, as a
+// std::pmr::memory_resource so frame-path containers can be std::pmr ones
+// allocating from it. Allocation is a pointer bump, deallocation is a no-op,
+// and reset() rewinds the whole arena at once when the frame ends.
+//
+// Memory is never returned to the heap while the arena lives: a frame that
+// overflows the current block chains on a new one, and reset() then swaps
+// the whole chain for one block big enough for that frame, so once the
+// working set is known every later frame bumps through a single block
+// without touching the heap.
+//
+// Not thread-safe - allocate from the thread that owns the frame, and size
+// anything a job fills in parallel before submitting it.
+class FrameArena final : public std::pmr::memory_resource {
+public:
+    constexpr static auto default_initial_capacity = std::size_t{1} << 20U;
+
+    explicit FrameArena(
+        std::size_t initial_capacity = default_initial_capacity
+    );
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena(FrameArena&&) = delete;
+    auto operator=(const FrameArena&) -> FrameArena& = delete;
+    auto operator=(FrameArena&&) -> FrameArena& = delete;
+    ~FrameArena() override = default;
+
+    // Invalidates everything allocated since the last reset().
+    auto reset() -> void;
+
+    // Bytes handed out since the last reset(), alignment padding included.
+    [[nodiscard]] auto get_bytes_used() const -> std::size_t;
+
+    // Bytes reserved across every block, used or not.
+    [[nodiscard]] auto get_capacity() const -> std::size_t;
+
+private:
+    struct Block {
+        std::unique_ptr<std::byte[]> memory;
+        std::size_t size = 0;
+    };
+
+    auto do_allocate(std::size_t bytes, std::size_t alignment)
+        -> void* override;
+    auto do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment)
+        -> void override;
+    [[nodiscard]] auto do_is_equal(const std::pmr::memory_resource& other)
+        const noexcept -> bool override;
+
+    auto push_block(std::size_t size) -> void;
+
+    // Allocation only ever bumps through the last block.
+    std::vector<Block> blocks;
+    std::size_t block_offset = 0;
+    // Used bytes of every block before the last.
+    std::size_t retired_bytes_used = 0;
+};
+
+}  // namespace Luminol::Utilities
@@ -1,5 +1,9 @@
 #include "ImageLoader.hpp"
 
+#include <cstring>
+
+#include <LuminolRenderEngine/Utilities/ParallelFor.hpp>
+
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
 
@@ -33,6 +37,20 @@ auto load_image(const std::filesystem::path& path, int32_t desired_channels)
     return image;
 }
 
+auto load_images(
+    const std::vector<std::filesystem::path>& paths,
+    int32_t desired_channels,
+    uint32_t worker_count
+) -> std::vector<Image> {
+    auto images = std::vector<Image>(paths.size());
+
+    parallel_for(paths.size(), worker_count, [&](std::size_t index) {
+        images[index] = load_image(paths[index], desired_channels);
+    });
+
+    return images;
+}
+
 auto get_default_normal_map() -> Image {
     const auto default_normal_map_pixels =
         std::vector<uint8_t>{0x7F, 0x7F, 0xFF, 0xFF};
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstdint>
 #include <filesystem>
+#include <vector>
 
 namespace Luminol::Utilities::ImageLoader {
 
@@ -15,6 +17,17 @@ struct Image {
 auto load_image(const std::filesystem::path& path, int32_t desired_channels = 0)
     -> Image;
 
+// Decodes every path in paths with load_image, spread across up to
+// worker_count threads (0 = one per hardware thread) - stb_image decoding is
+// CPU-bound and independent per file, so a model with dozens of
+// multi-megabyte textures decodes several times faster than one
+// load_image call after another. Results are in the same order as paths.
+auto load_images(
+    const std::vector<std::filesystem::path>& paths,
+    int32_t desired_channels = 0,
+    uint32_t worker_count = 0
+) -> std::vector<Image>;
+
 auto get_default_normal_map() -> Image;
 
 }  // namespace Luminol::Utilities::ImageLoader
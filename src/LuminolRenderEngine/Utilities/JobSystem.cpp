@@ -0,0 +1,223 @@
+#include "JobSystem.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#include <LuminolRenderEngine/Utilities/ParallelFor.hpp>
+
+namespace {
+
+// Which pool (if any) the current thread is a worker of, and which queue it
+// owns there. Lets submit() push onto the submitting worker's own queue and
+// wait() pop its own newest job rather than stealing.
+thread_local const Luminol::Utilities::JobSystem* current_job_system =
+    nullptr;
+thread_local uint32_t current_queue_index = 0;
+
+// Split count into about this many ranges per thread, so a thread that
+// finishes early has something left to steal.
+constexpr auto ranges_per_thread = std::size_t{4};
+
+// Starting capacity of a worker's job ring buffer.
+constexpr auto min_queue_capacity = std::size_t{64};
+
+}  // namespace
+
+namespace Luminol::Utilities {
+
+JobSystem::JobSystem(uint32_t worker_count) {
+    // The waiting thread works too, so only worker_count - 1 threads are
+    // spawned.
+    const auto thread_count = resolve_worker_count(
+        worker_count, std::numeric_limits<std::size_t>::max()
+    ) - 1;
+
+    const auto queue_count = std::max(1U, thread_count);
+    this->queues.reserve(queue_count);
+    for (auto i = 0U; i < queue_count; ++i) {
+        this->queues.push_back(std::make_unique<JobQueue>());
+    }
+
+    this->threads.reserve(thread_count);
+    for (auto i = 0U; i < thread_count; ++i) {
+        this->threads.emplace_back([this, i](const std::stop_token& token) {
+            this->worker_loop(token, i);
+        });
+    }
+}
+
+JobSystem::~JobSystem() {
+    // Stop every worker up front so they all wind down together rather than
+    // one per jthread destructor.
+    for (auto& thread : this->threads) {
+        thread.request_stop();
+    }
+}
+
+auto JobSystem::submit(JobGroup& group, std::function<void()> job) -> void {
+    this->enqueue(Job{.function = std::move(job), .group = &group});
+}
+
+auto JobSystem::submit(
+    JobGroup& group,
+    const RangeBody& body,
+    std::size_t begin,
+    std::size_t end
+) -> void {
+    this->enqueue(
+        Job{.range_body = &body, .begin = begin, .end = end, .group = &group}
+    );
+}
+
+auto JobSystem::enqueue(Job&& job) -> void {
+    job.group->pending_job_count.fetch_add(1, std::memory_order_relaxed);
+
+    const auto queue_index =
+        current_job_system == this
+            ? current_queue_index
+            : this->next_submit_queue.fetch_add(1, std::memory_order_relaxed) %
+                  static_cast<uint32_t>(this->queues.size());
+
+    auto& queue = *this->queues[queue_index];
+    {
+        const auto lock = std::scoped_lock{queue.mutex};
+        queue.push_back(std::move(job));
+    }
+    this->queued_job_count.fetch_add(1, std::memory_order_release);
+
+    // Taking sleep_mutex orders this against a worker that has just found
+    // queued_job_count == 0 and is about to sleep, so the wake isn't lost.
+    { const auto lock = std::scoped_lock{this->sleep_mutex}; }
+    this->wake_condition.notify_one();
+}
+
+auto JobSystem::wait(JobGroup& group) -> void {
+    const auto is_worker = current_job_system == this;
+    const auto queue_index = is_worker ? current_queue_index : 0U;
+
+    while (group.pending_job_count.load(std::memory_order_acquire) > 0) {
+        if (!this->try_run_job(queue_index, is_worker)) {
+            // Everything left in the group is running on other threads.
+            std::this_thread::yield();
+        }
+    }
+}
+
+auto JobSystem::parallel_for(
+    std::size_t count,
+    std::size_t min_range_size,
+    const RangeBody& body
+) -> void {
+    if (count == 0) {
+        return;
+    }
+
+    const auto target_range_count =
+        std::size_t{this->get_worker_count()} * ranges_per_thread;
+    const auto range_size = std::max(
+        {std::size_t{1},
+         min_range_size,
+         (count + target_range_count - 1) / target_range_count}
+    );
+
+    if (range_size >= count) {
+        body(0, count);
+        return;
+    }
+
+    auto group = JobGroup{};
+    for (auto begin = range_size; begin < count; begin += range_size) {
+        const auto end = std::min(begin + range_size, count);
+        this->submit(group, body, begin, end);
+    }
+
+    body(0, range_size);
+    this->wait(group);
+}
+
+auto JobSystem::get_worker_count() const -> uint32_t {
+    return static_cast<uint32_t>(this->threads.size()) + 1;
+}
+
+auto JobSystem::worker_loop(
+    const std::stop_token& stop_token, uint32_t queue_index
+) -> void {
+    current_job_system = this;
+    current_queue_index = queue_index;
+
+    while (!stop_token.stop_requested()) {
+        if (this->try_run_job(queue_index, true)) {
+            continue;
+        }
+
+        auto lock = std::unique_lock{this->sleep_mutex};
+        this->wake_condition.wait(lock, stop_token, [this] {
+            return this->queued_job_count.load(std::memory_order_acquire) > 0;
+        });
+    }
+}
+
+auto JobSystem::try_run_job(uint32_t queue_index, bool owns_queue) -> bool {
+    const auto queue_count = static_cast<uint32_t>(this->queues.size());
+
+    for (auto offset = 0U; offset < queue_count; ++offset) {
+        auto& queue = *this->queues[(queue_index + offset) % queue_count];
+
+        auto job = Job{};
+        {
+            const auto lock = std::scoped_lock{queue.mutex};
+            if (queue.count == 0) {
+                continue;
+            }
+
+            job = owns_queue && offset == 0 ? queue.pop_back()
+                                            : queue.pop_front();
+        }
+        this->queued_job_count.fetch_sub(1, std::memory_order_relaxed);
+
+        if (job.range_body != nullptr) {
+            (*job.range_body)(job.begin, job.end);
+        } else {
+            job.function();
+        }
+        job.group->pending_job_count.fetch_sub(1, std::memory_order_release);
+        return true;
+    }
+
+    return false;
+}
+
+auto JobSystem::JobQueue::push_back(Job&& job) -> void {
+    if (this->count == this->jobs.size()) {
+        // Unrolls the ring into the front of the bigger buffer.
+        auto grown =
+            std::vector<Job>(std::max(min_queue_capacity, this->count * 2));
+        for (auto i = std::size_t{0}; i < this->count; ++i) {
+            grown[i] = std::move(
+                this->jobs[(this->front + i) % this->jobs.size()]
+            );
+        }
+        this->jobs = std::move(grown);
+        this->front = 0;
+    }
+
+    this->jobs[(this->front + this->count) % this->jobs.size()] =
+        std::move(job);
+    this->count += 1;
+}
+
+auto JobSystem::JobQueue::pop_back() -> Job {
+    this->count -= 1;
+    return std::move(
+        this->jobs[(this->front + this->count) % this->jobs.size()]
+    );
+}
+
+auto JobSystem::JobQueue::pop_front() -> Job {
+    auto job = std::move(this->jobs[this->front]);
+    this->front = (this->front + 1) % this->jobs.size();
+    this->count -= 1;
+    return job;
+}
+
+}  // namespace Luminol::Utilities
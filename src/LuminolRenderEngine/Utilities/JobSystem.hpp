@@ -0,0 +1,145 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Luminol::Utilities {
+
+// Persistent work-stealing thread pool for short, fine-grained jobs that
+// recur every frame (see SDL_GPURenderer::draw), where parallel_for's
+// spawn-and-join per call would cost more than the work itself.
+//
+// Every worker owns a deque: it pops its own newest job first (LIFO - the
+// data a job just fanned out is still in cache) and, once that's empty,
+// steals the oldest job from another worker's deque. Jobs submitted from a
+// non-worker thread are dealt round-robin across the deques. wait() never
+// blocks while there's work queued - the waiting thread runs jobs too - so
+// the caller contributes a core, and a job may itself submit and wait on
+// nested jobs without deadlocking the pool.
+//
+// Jobs must not throw, and everything they touch must be safe to use
+// concurrently with every other job in flight.
+class JobSystem {
+public:
+    // Counts outstanding jobs submitted against it; wait() returns once
+    // every one of them has finished. Must not be destroyed while any are
+    // still pending.
+    class JobGroup {
+    public:
+        JobGroup() = default;
+
+        JobGroup(const JobGroup&) = delete;
+        JobGroup(JobGroup&&) = delete;
+        auto operator=(const JobGroup&) -> JobGroup& = delete;
+        auto operator=(JobGroup&&) -> JobGroup& = delete;
+        ~JobGroup() = default;
+
+    private:
+        friend class JobSystem;
+
+        std::atomic<uint32_t> pending_job_count{0};
+    };
+
+    // worker_count includes the thread calling wait()/parallel_for, like
+    // Utilities::parallel_for's - 0 means one per hardware thread (see
+    // resolve_worker_count), and 1 spawns no threads at all, running every
+    // job on the waiting thread.
+    explicit JobSystem(uint32_t worker_count = 0);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem(JobSystem&&) = delete;
+    auto operator=(const JobSystem&) -> JobSystem& = delete;
+    auto operator=(JobSystem&&) -> JobSystem& = delete;
+
+    using RangeBody = std::function<void(std::size_t, std::size_t)>;
+
+    auto submit(JobGroup& group, std::function<void()> job) -> void;
+
+    // Queues body(begin, end) by reference rather than wrapping it in a new
+    // std::function, so it never allocates - body must outlive the job.
+    auto submit(
+        JobGroup& group,
+        const RangeBody& body,
+        std::size_t begin,
+        std::size_t end
+    ) -> void;
+
+    // Runs queued jobs (from any group) on the calling thread until every
+    // job submitted against group has finished.
+    auto wait(JobGroup& group) -> void;
+
+    // Calls body(begin, end) over consecutive ranges covering [0, count),
+    // each at least min_range_size indices long (bar the last), spread
+    // across the pool and the calling thread, and returns once all of them
+    // have finished. Ranges are also never smaller than count split ~4 ways
+    // per thread, so a tiny min_range_size doesn't drown the work in
+    // scheduling overhead.
+    auto parallel_for(
+        std::size_t count,
+        std::size_t min_range_size,
+        const RangeBody& body
+    ) -> void;
+
+    // Including the thread that waits - see the constructor.
+    [[nodiscard]] auto get_worker_count() const -> uint32_t;
+
+private:
+    // Either function, or range_body over [begin, end).
+    struct Job {
+        std::function<void()> function = {};
+        const RangeBody* range_body = nullptr;
+        std::size_t begin = 0;
+        std::size_t end = 0;
+        JobGroup* group = nullptr;
+    };
+
+    // Ring buffer of jobs that keeps its capacity once grown, where a
+    // std::deque frees and reallocates its blocks as jobs come and go -
+    // submitting a frame's jobs doesn't allocate once the queues have grown
+    // to fit one.
+    struct JobQueue {
+        std::mutex mutex;
+        std::vector<Job> jobs;
+        std::size_t front = 0;
+        std::size_t count = 0;
+
+        auto push_back(Job&& job) -> void;
+        [[nodiscard]] auto pop_back() -> Job;
+        [[nodiscard]] auto pop_front() -> Job;
+    };
+
+    auto enqueue(Job&& job) -> void;
+
+    auto worker_loop(const std::stop_token& stop_token, uint32_t queue_index)
+        -> void;
+
+    // Pops from queue_index's back if it's the calling worker's own queue,
+    // otherwise steals from the front of the first non-empty queue starting
+    // at queue_index. False if every queue was empty.
+    auto try_run_job(uint32_t queue_index, bool owns_queue) -> bool;
+
+    // One per spawned thread, or a single one with none so submit() always
+    // has somewhere to put a job for wait() to pick up.
+    std::vector<std::unique_ptr<JobQueue>> queues;
+    std::atomic<uint32_t> next_submit_queue{0};
+
+    // Workers with nothing to run or steal sleep here until submit() queues
+    // something. queued_job_count is what they check before going to sleep.
+    std::mutex sleep_mutex;
+    std::condition_variable_any wake_condition;
+    std::atomic<std::size_t> queued_job_count{0};
+
+    // Declared last: destroyed (stopped and joined) first, while the queues
+    // and condition variable they use are still alive.
+    std::vector<std::jthread> threads;
+};
+
+}  // namespace Luminol::Utilities
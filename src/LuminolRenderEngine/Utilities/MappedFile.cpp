@@ -0,0 +1,165 @@
+#include "MappedFile.hpp"
+
+#include <utility>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Luminol::Utilities {
+
+#ifdef _WIN32
+
+auto MappedFile::open(const std::filesystem::path& path)
+    -> std::optional<MappedFile> {
+    auto* const file_handle = CreateFileW(
+        path.c_str(),
+        GENERIC_READ,
+        FILE_SHARE_READ,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+        nullptr
+    );
+    if (file_handle == INVALID_HANDLE_VALUE) {
+        return std::nullopt;
+    }
+
+    auto file_size = LARGE_INTEGER{};
+    if (GetFileSizeEx(file_handle, &file_size) == 0 ||
+        file_size.QuadPart <= 0) {
+        CloseHandle(file_handle);
+        return std::nullopt;
+    }
+
+    auto* const mapping_handle =
+        CreateFileMappingW(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping_handle == nullptr) {
+        CloseHandle(file_handle);
+        return std::nullopt;
+    }
+
+    const auto* const view =
+        MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+        CloseHandle(mapping_handle);
+        CloseHandle(file_handle);
+        return std::nullopt;
+    }
+
+    auto mapped_file = MappedFile{};
+    mapped_file.mapped_data = static_cast<const std::byte*>(view);
+    mapped_file.mapped_size = static_cast<std::size_t>(file_size.QuadPart);
+    mapped_file.file_handle = file_handle;
+    mapped_file.mapping_handle = mapping_handle;
+    return mapped_file;
+}
+
+auto MappedFile::release() -> void {
+    if (mapped_data != nullptr) {
+        UnmapViewOfFile(mapped_data);
+    }
+    if (mapping_handle != nullptr) {
+        CloseHandle(mapping_handle);
+    }
+    if (file_handle != nullptr) {
+        CloseHandle(file_handle);
+    }
+    mapped_data = nullptr;
+    mapped_size = 0;
+    mapping_handle = nullptr;
+    file_handle = nullptr;
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : mapped_data{std::exchange(other.mapped_data, nullptr)},
+      mapped_size{std::exchange(other.mapped_size, 0)},
+      file_handle{std::exchange(other.file_handle, nullptr)},
+      mapping_handle{std::exchange(other.mapping_handle, nullptr)} {}
+
+auto MappedFile::operator=(MappedFile&& other) noexcept -> MappedFile& {
+    if (this != &other) {
+        release();
+        mapped_data = std::exchange(other.mapped_data, nullptr);
+        mapped_size = std::exchange(other.mapped_size, 0);
+        file_handle = std::exchange(other.file_handle, nullptr);
+        mapping_handle = std::exchange(other.mapping_handle, nullptr);
+    }
+    return *this;
+}
+
+#else
+
+auto MappedFile::open(const std::filesystem::path& path)
+    -> std::optional<MappedFile> {
+    const auto file_descriptor = ::open(path.c_str(), O_RDONLY);
+    if (file_descriptor < 0) {
+        return std::nullopt;
+    }
+
+    struct stat file_stat = {};
+    if (::fstat(file_descriptor, &file_stat) != 0 || file_stat.st_size <= 0) {
+        ::close(file_descriptor);
+        return std::nullopt;
+    }
+
+    const auto size = static_cast<std::size_t>(file_stat.st_size);
+    auto* const view =
+        ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+
+    // The mapping keeps its own reference to the file - the descriptor isn't
+    // needed past this point whether or not mmap succeeded.
+    ::close(file_descriptor);
+
+    if (view == MAP_FAILED) {
+        return std::nullopt;
+    }
+
+    auto mapped_file = MappedFile{};
+    mapped_file.mapped_data = static_cast<const std::byte*>(view);
+    mapped_file.mapped_size = size;
+    return mapped_file;
+}
+
+auto MappedFile::release() -> void {
+    if (mapped_data != nullptr) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+        ::munmap(const_cast<std::byte*>(mapped_data), mapped_size);
+    }
+    mapped_data = nullptr;
+    mapped_size = 0;
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : mapped_data{std::exchange(other.mapped_data, nullptr)},
+      mapped_size{std::exchange(other.mapped_size, 0)} {}
+
+auto MappedFile::operator=(MappedFile&& other) noexcept -> MappedFile& {
+    if (this != &other) {
+        release();
+        mapped_data = std::exchange(other.mapped_data, nullptr);
+        mapped_size = std::exchange(other.mapped_size, 0);
+    }
+    return *this;
+}
+
+#endif
+
+MappedFile::~MappedFile() { release(); }
+
+auto MappedFile::data() const -> const std::byte* { return mapped_data; }
+
+auto MappedFile::size() const -> std::size_t { return mapped_size; }
+
+}  // namespace Luminol::Utilities
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+
+namespace Luminol::Utilities {
+
+// Read-only memory mapping of a whole file. Used by the baked mesh cache
+// (see SDL_GPUMeshCache) so warm loads can hand mapped bytes straight to a
+// GPU upload instead of first copying them into intermediate std::vectors -
+// the OS pages the file in on demand, and the mapping is dropped as soon as
+// the upload has been recorded. Move-only; unmaps on destruction.
+class MappedFile {
+public:
+    // std::nullopt if the file doesn't exist, is empty or can't be mapped.
+    [[nodiscard]] static auto open(const std::filesystem::path& path)
+        -> std::optional<MappedFile>;
+
+    MappedFile(const MappedFile&) = delete;
+    auto operator=(const MappedFile&) -> MappedFile& = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    auto operator=(MappedFile&& other) noexcept -> MappedFile&;
+    ~MappedFile();
+
+    [[nodiscard]] auto data() const -> const std::byte*;
+    [[nodiscard]] auto size() const -> std::size_t;
+
+private:
+    MappedFile() = default;
+
+    auto release() -> void;
+
+    const std::byte* mapped_data = nullptr;
+    std::size_t mapped_size = 0;
+#ifdef _WIN32
+    void* file_handle = nullptr;
+    void* mapping_handle = nullptr;
+#endif
+};
+
+}  // namespace Luminol::Utilities
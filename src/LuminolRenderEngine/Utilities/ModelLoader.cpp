@@ -2,6 +2,7 @@
 
 #include <array>
 #include <string_view>
+#include <unordered_set>
 
 #include <gsl/gsl>
 
@@ -15,6 +16,17 @@ namespace {
 using namespace Luminol::Utilities::ImageLoader;
 using namespace Luminol::Utilities::ModelLoader;
 
+constexpr auto import_flags = uint32_t{
+    aiProcess_Triangulate | aiProcess_JoinIdenticalVertices |
+    aiProcess_MakeLeftHanded | aiProcess_FlipWindingOrder | aiProcess_FlipUVs |
+    aiProcess_PreTransformVertices | aiProcess_OptimizeGraph |
+    aiProcess_GenSmoothNormals | aiProcess_CalcTangentSpace |
+    aiProcess_OptimizeMeshes | aiProcess_SortByPType |
+    aiProcess_RemoveRedundantMaterials | aiProcess_ImproveCacheLocality |
+    aiProcess_FindDegenerates | aiProcess_FindInvalidData |
+    aiProcess_ValidateDataStructure
+};
+
 auto load_vertices(const aiMesh& mesh)
     -> std::vector<Luminol::Maths::Vector3f> {
     auto vertices = std::vector<Luminol::Maths::Vector3f>{};
@@ -123,12 +135,21 @@ struct LoadedTextures {
     Luminol::Utilities::ModelLoader::TextureWrap wrap;
 };
 
+// Every unique texture path referenced by the model's meshes, in first-seen
+// order - collected while walking the meshes and decoded in one parallel
+// batch afterwards (see load_model), instead of decoding each file inline
+// the first time a mesh references it.
+struct PendingTextures {
+    std::vector<std::filesystem::path> paths;
+    std::unordered_set<std::filesystem::path> seen;
+};
+
 auto load_textures(
     const aiMesh& mesh,
     gsl::span<aiMaterial*> materials,
     aiTextureType texture_type,
     const std::filesystem::path& directory,
-    std::unordered_map<std::filesystem::path, Image>& textures_map
+    PendingTextures& pending_textures
 ) -> LoadedTextures {
     if (materials.empty()) {
         return LoadedTextures{};
@@ -143,8 +164,6 @@ auto load_textures(
 
     auto wrap = Luminol::Utilities::ModelLoader::TextureWrap{};
 
-    constexpr auto desired_rgba_channels = int32_t{4};
-
     for (auto i = 0u; i < textures_count; ++i) {
         auto texture_path = aiString{};
         auto mapmode = std::array<aiTextureMapMode, 3>{
@@ -166,9 +185,8 @@ auto load_textures(
             };
         }
 
-        if (!textures_map.contains(texture_path_key)) {
-            textures_map[texture_path_key] =
-                load_image(texture_path_key, desired_rgba_channels);
+        if (pending_textures.seen.insert(texture_path_key).second) {
+            pending_textures.paths.push_back(texture_path_key);
         }
     }
 
@@ -215,27 +233,27 @@ auto load_mesh(
     const aiMesh& mesh,
     gsl::span<aiMaterial*> materials,
     const std::filesystem::path& directory,
-    std::unordered_map<std::filesystem::path, Image>& textures_map
+    PendingTextures& pending_textures
 ) -> MeshData {
     auto diffuse = load_textures(
-        mesh, materials, aiTextureType_DIFFUSE, directory, textures_map
+        mesh, materials, aiTextureType_DIFFUSE, directory, pending_textures
     );
     auto emissive = load_textures(
-        mesh, materials, aiTextureType_EMISSIVE, directory, textures_map
+        mesh, materials, aiTextureType_EMISSIVE, directory, pending_textures
     );
     auto normal = load_textures(
-        mesh, materials, aiTextureType_NORMALS, directory, textures_map
+        mesh, materials, aiTextureType_NORMALS, directory, pending_textures
     );
     auto metallic = load_textures(
-        mesh, materials, aiTextureType_METALNESS, directory, textures_map
+        mesh, materials, aiTextureType_METALNESS, directory, pending_textures
     );
     auto roughness = load_textures(
         mesh, materials, aiTextureType_DIFFUSE_ROUGHNESS, directory,
-        textures_map
+        pending_textures
     );
     auto ambient_occlusion = load_textures(
         mesh, materials, aiTextureType_AMBIENT_OCCLUSION, directory,
-        textures_map
+        pending_textures
     );
 
     return MeshData{
@@ -264,19 +282,14 @@ auto load_mesh(
 
 namespace Luminol::Utilities::ModelLoader {
 
-auto load_model(const std::filesystem::path& path) -> std::optional<ModelData> {
+auto get_import_flags() -> uint32_t {
+    return import_flags;
+}
+
+auto load_model(const std::filesystem::path& path, const LoadOptions& options)
+    -> std::optional<ModelData> {
     auto importer = Assimp::Importer{};
-    const auto* const scene = importer.ReadFile(
-        path.string(),
-        aiProcess_Triangulate | aiProcess_JoinIdenticalVertices |
-            aiProcess_MakeLeftHanded | aiProcess_FlipWindingOrder |
-            aiProcess_FlipUVs | aiProcess_PreTransformVertices |
-            aiProcess_OptimizeGraph | aiProcess_GenSmoothNormals |
-            aiProcess_CalcTangentSpace | aiProcess_OptimizeMeshes |
-            aiProcess_SortByPType | aiProcess_RemoveRedundantMaterials |
-            aiProcess_ImproveCacheLocality | aiProcess_FindDegenerates |
-            aiProcess_FindInvalidData | aiProcess_ValidateDataStructure
-    );
+    const auto* const scene = importer.ReadFile(path.string(), import_flags);
 
     if (scene == nullptr || (scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE) != 0) {
         return std::nullopt;
@@ -287,15 +300,32 @@ auto load_model(const std::filesystem::path& path) -> std::optional<ModelData> {
 
     const auto mesh_span = gsl::make_span(scene->mMeshes, scene->mNumMeshes);
 
+    auto pending_textures = PendingTextures{};
+
     for (const auto* mesh : mesh_span) {
         const auto materials_span =
             gsl::make_span(scene->mMaterials, scene->mNumMaterials);
 
         model_data.meshes.emplace_back(load_mesh(
-            *mesh, materials_span, path.parent_path(), model_data.textures_map
+            *mesh, materials_span, path.parent_path(), pending_textures
         ));
     }
 
+    constexpr auto desired_rgba_channels = int32_t{4};
+
+    auto images = load_images(
+        pending_textures.paths,
+        desired_rgba_channels,
+        options.texture_decode_worker_count
+    );
+
+    model_data.textures_map.reserve(images.size());
+    for (auto i = std::size_t{0}; i < images.size(); ++i) {
+        model_data.textures_map.emplace(
+            pending_textures.paths[i], std::move(images[i])
+        );
+    }
+
     return model_data;
 }
 
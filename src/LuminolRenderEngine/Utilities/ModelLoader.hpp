@@ -4,6 +4,7 @@
 #include <optional>
 #include <filesystem>
 #include <unordered_map>
+#include <cstdint>
 
 #include <LuminolMaths/Vector.hpp>
 
@@ -57,6 +58,28 @@ struct ModelData {
     std::unordered_map<std::filesystem::path, ImageLoader::Image> textures_map;
 };
 
-auto load_model(const std::filesystem::path& path) -> std::optional<ModelData>;
+struct LoadOptions {
+    // Threads used to decode the model's material textures (see
+    // ImageLoader::load_images) - 0 means one per hardware thread, 1 decodes
+    // everything on the calling thread.
+    uint32_t texture_decode_worker_count = 0;
+    // Threads SDL_GPU::bake_model uses to optimize/meshletize the model's
+    // submeshes on a mesh cache miss - same 0/1 convention as above. Not
+    // used by load_model itself, but carried here so one options struct
+    // covers every stage of a model load.
+    uint32_t mesh_bake_worker_count = 0;
+    // Neither worker count changes what's loaded or baked, so neither is
+    // part of SDL_GPU's mesh cache key - an option that does must be folded
+    // into it (see SDL_GPU::compute_mesh_cache_key).
+};
+
+// The assimp post-process steps (aiPostProcessSteps) load_model imports
+// with. They decide the imported geometry - triangulation, normals,
+// tangents, joined vertices - so the mesh cache key includes them.
+[[nodiscard]] auto get_import_flags() -> uint32_t;
+
+auto load_model(
+    const std::filesystem::path& path, const LoadOptions& options = {}
+) -> std::optional<ModelData>;
 
 }  // namespace Luminol::Utilities::ModelLoader
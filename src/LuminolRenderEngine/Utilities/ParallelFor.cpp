@@ -0,0 +1,53 @@
+#include "ParallelFor.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace Luminol::Utilities {
+
+auto resolve_worker_count(
+    uint32_t requested_worker_count, std::size_t job_count
+) -> uint32_t {
+    auto worker_count = requested_worker_count;
+    if (worker_count == 0) {
+        worker_count = std::max(1U, std::thread::hardware_concurrency());
+    }
+
+    const auto max_useful_workers =
+        static_cast<uint32_t>(std::min<std::size_t>(job_count, UINT32_MAX));
+    return std::max(1U, std::min(worker_count, max_useful_workers));
+}
+
+auto parallel_for(
+    std::size_t count,
+    uint32_t worker_count,
+    const std::function<void(std::size_t)>& body
+) -> void {
+    worker_count = resolve_worker_count(worker_count, count);
+
+    auto next_index = std::atomic<std::size_t>{0};
+    const auto run_until_done = [&] {
+        for (auto index = next_index.fetch_add(1); index < count;
+             index = next_index.fetch_add(1)) {
+            body(index);
+        }
+    };
+
+    if (worker_count <= 1) {
+        run_until_done();
+        return;
+    }
+
+    // The calling thread works too, so only worker_count - 1 extra threads
+    // are spawned; jthread joins on scope exit.
+    auto workers = std::vector<std::jthread>{};
+    workers.reserve(worker_count - 1);
+    for (auto i = 1U; i < worker_count; ++i) {
+        workers.emplace_back(run_until_done);
+    }
+    run_until_done();
+}
+
+}  // namespace Luminol::Utilities
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace Luminol::Utilities {
+
+// Resolves a user-facing worker count setting: 0 means one worker per
+// hardware thread, and there's never any point in more workers than jobs.
+// Always at least 1.
+[[nodiscard]] auto resolve_worker_count(
+    uint32_t requested_worker_count, std::size_t job_count
+) -> uint32_t;
+
+// Calls body(i) for every i in [0, count), spread across up to worker_count
+// threads (see resolve_worker_count) including the calling thread, and
+// returns once every call has finished. Workers pull the next index off a
+// shared counter rather than taking fixed slices, so a few expensive
+// indices (a 4K texture, a huge submesh) don't leave the other workers idle
+// - callers that know their job costs up front should order indices most
+// expensive first. body must be safe to call concurrently for different
+// indices.
+auto parallel_for(
+    std::size_t count,
+    uint32_t worker_count,
+    const std::function<void(std::size_t)>& body
+) -> void;
+
+}  // namespace Luminol::Utilities
@@ -1,9 +1,41 @@
 #include "PerformanceLogger.hpp"
 
 #include <algorithm>
+#include <array>
+#include <cstdio>
 
 #include <SDL3/SDL_log.h>
 
+namespace {
+
+// Samples that time waiting or GPU work rather than CPU recording, so
+// they're logged but left out of cpu_record_total.
+constexpr auto non_recording_sample_names = std::array<std::string_view, 9>{
+    "frame",
+    "acquire_swapchain",
+    "gpu_frame_proxy",
+    "gpu_frame",
+    "gpu_wait",
+    "cpu_wait",
+    "staging_wait",
+    "render_thread_frame",
+    "render_thread_wait",
+};
+
+// Appends " name: <milliseconds>ms |", formatting the number on the stack
+// so a log line only grows message, never allocates a temporary per sample.
+auto append_sample(
+    std::string& message, std::string_view name, double milliseconds
+) -> void {
+    auto number = std::array<char, 32>{};
+    std::snprintf(number.data(), number.size(), "%f", milliseconds);
+
+    message.append(" ").append(name).append(": ");
+    message.append(number.data()).append("ms |");
+}
+
+}  // namespace
+
 namespace Luminol::Utilities {
 
 PerformanceLogger::PerformanceLogger(uint32_t log_interval_frames)
@@ -11,6 +43,21 @@ PerformanceLogger::PerformanceLogger(uint32_t log_interval_frames)
 
 auto PerformanceLogger::record(std::string_view name, Units::Seconds elapsed)
     -> void {
+    accumulate(samples, name, elapsed);
+}
+
+auto PerformanceLogger::record_stage(
+    std::string_view name, Units::Seconds elapsed
+) -> void {
+    const auto lock = std::scoped_lock{stage_samples_mutex};
+    accumulate(stage_samples, name, elapsed);
+}
+
+auto PerformanceLogger::accumulate(
+    std::vector<Sample>& samples,
+    std::string_view name,
+    Units::Seconds elapsed
+) -> void {
     const auto existing = std::find_if(
         samples.begin(),
         samples.end(),
@@ -30,6 +77,11 @@ auto PerformanceLogger::record(std::string_view name, Units::Seconds elapsed)
     });
 }
 
+auto PerformanceLogger::reset_sample(Sample& sample) -> void {
+    sample.total_time = Units::Seconds{0.0};
+    sample.count = 0;
+}
+
 auto PerformanceLogger::end_frame() -> void {
     frame_count += 1;
 
@@ -41,13 +93,15 @@ auto PerformanceLogger::end_frame() -> void {
 }
 
 auto PerformanceLogger::log_and_reset() -> void {
-    auto message = std::string{"[Perf]"};
-
-    // Every sample here (other than "frame", "acquire_swapchain", and
-    // "gpu_frame_proxy") times a plain CPU std::chrono span around SDL_GPU
-    // command-recording calls, not GPU execution: SDL_GPU submission is
-    // asynchronous, so these measure how long the CPU took to encode
-    // commands, which is not the same as how long the GPU took to run them.
+    auto& message = log_message;
+    message.assign("[Perf]");
+
+    // Every sample here (other than "frame" and the waits and GPU times
+    // below - see non_recording_sample_names) times a plain CPU
+    // std::chrono span around SDL_GPU command-recording calls, not GPU
+    // execution: SDL_GPU submission is asynchronous, so these measure how
+    // long the CPU took to encode commands, which is not the same as how
+    // long the GPU took to run them.
     // SDL_GPU has no timestamp/query API, so there is currently no way to
     // measure true per-pass GPU duration.
     //
@@ -59,6 +113,22 @@ auto PerformanceLogger::log_and_reset() -> void {
     // between builds - excluding it (as an earlier version of this function
     // did) hides exactly the signal you'd be looking for.
     //
+    // "gpu_wait", "cpu_wait" and "gpu_frame" come from
+    // SDL_GPURenderer's FramePacer and split a frame's time without any
+    // sync: "gpu_wait" is draw() blocked on the frames-in-flight limit
+    // (GPU-bound), "cpu_wait" is the GPU sitting idle until the frame was
+    // submitted (CPU-bound), and "gpu_frame" is a submit-to-completion time
+    // for a frame a few frames back, found by polling its fence - an upper
+    // bound on its GPU time that, unlike "gpu_frame_proxy", doesn't stall.
+    // "staging_wait" is the part of the recording samples StagingRing spent
+    // waiting on an earlier frame.
+    //
+    // "render_thread_frame" and "render_thread_wait" only appear with
+    // SDL_GPURenderer::set_render_thread_enabled(true): the first is the
+    // render thread's whole frame (which the recording samples already
+    // break down), the second how long draw() blocked on it - nonzero means
+    // rendering, not the caller's simulation, is the bottleneck.
+    //
     // "gpu_frame_proxy" (only present when
     // SDL_GPURenderer::set_debug_gpu_profiling_enabled(true) has been called)
     // is a coarse approximation of whole-frame GPU execution time: the CPU
@@ -72,26 +142,52 @@ auto PerformanceLogger::log_and_reset() -> void {
     auto cpu_record_total_milliseconds = 0.0;
 
     for (const auto& sample : samples) {
+        if (sample.count == 0) {
+            continue;
+        }
+
         const auto average_seconds =
             sample.total_time / static_cast<double>(sample.count);
         const auto average_milliseconds =
             average_seconds.as<Units::Millisecond>().get_value();
 
-        message += " " + sample.name + ": " +
-                   std::to_string(average_milliseconds) + "ms |";
+        append_sample(message, sample.name, average_milliseconds);
 
-        if (sample.name != "acquire_swapchain" && sample.name != "frame" &&
-            sample.name != "gpu_frame_proxy") {
+        if (std::ranges::find(non_recording_sample_names, sample.name) ==
+            non_recording_sample_names.end()) {
             cpu_record_total_milliseconds += average_milliseconds;
         }
     }
 
-    message += " cpu_record_total: " +
-        std::to_string(cpu_record_total_milliseconds) + "ms |";
+    append_sample(message, "cpu_record_total", cpu_record_total_milliseconds);
+
+    {
+        const auto lock = std::scoped_lock{stage_samples_mutex};
+        const auto has_stage_samples = std::ranges::any_of(
+            stage_samples,
+            [](const Sample& sample) { return sample.count > 0; }
+        );
+        if (has_stage_samples) {
+            message += " stages:";
+        }
+        for (auto& sample : stage_samples) {
+            if (sample.count == 0) {
+                continue;
+            }
+
+            const auto average_seconds =
+                sample.total_time / static_cast<double>(sample.count);
+            append_sample(
+                message, sample.name,
+                average_seconds.as<Units::Millisecond>().get_value()
+            );
+            reset_sample(sample);
+        }
+    }
 
     SDL_Log("%s", message.c_str());
 
-    samples.clear();
+    std::ranges::for_each(samples, reset_sample);
     frame_count = 0;
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <mutex>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -18,6 +19,14 @@ public:
     );
 
     auto record(std::string_view name, Units::Seconds elapsed) -> void;
+
+    // Times one stage of the CPU frame preparation the renderer fans out
+    // across its JobSystem. Unlike record(), safe to call from any thread.
+    // Stages can run concurrently with each other and with the samples
+    // record() times, so they're logged as their own group and left out of
+    // cpu_record_total.
+    auto record_stage(std::string_view name, Units::Seconds elapsed) -> void;
+
     auto end_frame() -> void;
 
 private:
@@ -27,11 +36,29 @@ private:
         uint32_t count = 0;
     };
 
+    static auto accumulate(
+        std::vector<Sample>& samples,
+        std::string_view name,
+        Units::Seconds elapsed
+    ) -> void;
+
+    // Zeroes a sample in place rather than erasing it, so its name (and the
+    // sample list) keep their storage for the next interval.
+    static auto reset_sample(Sample& sample) -> void;
+
     auto log_and_reset() -> void;
 
     std::vector<Sample> samples;
+
+    std::mutex stage_samples_mutex;
+    std::vector<Sample> stage_samples;
+
     uint32_t frame_count = 0;
     uint32_t log_interval_frames;
+
+    // Reused for every log line, so logging stops allocating once it's
+    // grown to fit one.
+    std::string log_message;
 };
 
 }  // namespace Luminol::Utilities
@@ -0,0 +1,114 @@
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+#include <LuminolMaths/Matrix.hpp>
+#include <LuminolMaths/Vector.hpp>
+
+#include <LuminolRenderEngine/Graphics/BatchCulling.hpp>
+
+#include <doctest/doctest.h>
+
+namespace {
+
+using namespace Luminol::Graphics;
+using Luminol::Maths::Matrix4x4f;
+using Luminol::Maths::Vector3f;
+
+// Every level is exercised whatever the CPU: levels it doesn't support are
+// clamped down, so on older hardware some of these just rerun a lower path.
+constexpr auto all_levels =
+    std::array{SimdLevel::Scalar, SimdLevel::SSE4_2, SimdLevel::AVX2};
+
+// Odd and even counts (the AVX2 path transforms matrices in pairs), as well
+// as the empty and single-item edge cases.
+constexpr auto batch_sizes = std::array<std::size_t, 5>{0, 1, 7, 8, 37};
+
+auto make_random_affine_matrices(std::size_t count, std::mt19937& rng)
+    -> std::vector<Matrix4x4f> {
+    auto linear = std::uniform_real_distribution<float>{-2.0F, 2.0F};
+    auto translation = std::uniform_real_distribution<float>{-50.0F, 50.0F};
+
+    auto matrices = std::vector<Matrix4x4f>{};
+    for (auto i = std::size_t{0}; i < count; ++i) {
+        auto matrix = Matrix4x4f::identity();
+        for (auto row = std::size_t{0}; row < 3; ++row) {
+            for (auto column = std::size_t{0}; column < 3; ++column) {
+                matrix[row][column] = linear(rng);
+            }
+            matrix[3][row] = translation(rng);
+        }
+        matrices.push_back(matrix);
+    }
+    return matrices;
+}
+
+const auto local_bounds = BoundingBox{
+    .min = Vector3f{-1.0F, -0.5F, -2.0F},
+    .max = Vector3f{3.0F, 0.5F, 1.0F},
+};
+
+auto check_bounds_equal(const BoundingBox& actual, const BoundingBox& expected)
+    -> void {
+    CHECK(actual.min.x() == doctest::Approx(expected.min.x()));
+    CHECK(actual.min.y() == doctest::Approx(expected.min.y()));
+    CHECK(actual.min.z() == doctest::Approx(expected.min.z()));
+    CHECK(actual.max.x() == doctest::Approx(expected.max.x()));
+    CHECK(actual.max.y() == doctest::Approx(expected.max.y()));
+    CHECK(actual.max.z() == doctest::Approx(expected.max.z()));
+}
+
+}  // namespace
+
+TEST_CASE("transform_bounds matches the 8 transformed corners' AABB") {
+    auto matrix = Matrix4x4f::identity();
+    matrix[0][0] = 0.0F;
+    matrix[0][1] = 2.0F;
+    matrix[1][0] = -1.0F;
+    matrix[1][1] = 0.0F;
+    matrix[3][0] = 10.0F;
+
+    // x' = -y + 10, y' = 2x, z' = z.
+    const auto bounds = transform_bounds(matrix, local_bounds);
+    check_bounds_equal(
+        bounds,
+        BoundingBox{
+            .min = Vector3f{9.5F, -2.0F, -2.0F},
+            .max = Vector3f{10.5F, 6.0F, 1.0F},
+        }
+    );
+}
+
+TEST_CASE("transform_bounds_union matches merged transform_bounds") {
+    auto rng = std::mt19937{5678};
+
+    for (const auto count : batch_sizes) {
+        const auto matrices = make_random_affine_matrices(count, rng);
+
+        auto expected = local_bounds;
+        for (auto i = std::size_t{0}; i < count; ++i) {
+            const auto bounds = transform_bounds(matrices[i], local_bounds);
+            if (i == 0) {
+                expected = bounds;
+                continue;
+            }
+            expected.min = Vector3f{
+                std::min(expected.min.x(), bounds.min.x()),
+                std::min(expected.min.y(), bounds.min.y()),
+                std::min(expected.min.z(), bounds.min.z()),
+            };
+            expected.max = Vector3f{
+                std::max(expected.max.x(), bounds.max.x()),
+                std::max(expected.max.y(), bounds.max.y()),
+                std::max(expected.max.z(), bounds.max.z()),
+            };
+        }
+
+        for (const auto level : all_levels) {
+            check_bounds_equal(
+                transform_bounds_union(matrices, local_bounds, level), expected
+            );
+        }
+    }
+}
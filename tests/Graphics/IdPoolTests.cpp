@@ -75,3 +75,33 @@ TEST_CASE("multiple freed ids are reused lowest first") {
     CHECK(pool.allocate() == 2);
     CHECK(pool.allocate() == 3);
 }
+
+TEST_CASE("raising the capacity lets an exhausted pool allocate again") {
+    auto pool = IdPool<uint32_t>{1};
+
+    REQUIRE(pool.allocate() == 0);
+    REQUIRE(pool.allocate() == std::nullopt);
+
+    pool.set_capacity(2);
+
+    CHECK(pool.allocate() == 1);
+    CHECK(pool.allocate() == std::nullopt);
+}
+
+TEST_CASE("lowering the capacity keeps ids past it from being reused") {
+    auto pool = IdPool<uint32_t>{};
+
+    const auto id0 = pool.allocate();
+    const auto id1 = pool.allocate();
+    REQUIRE(id0 == 0);
+    REQUIRE(id1 == 1);
+
+    pool.set_capacity(1);
+    pool.free(*id1);
+
+    CHECK(pool.allocate() == std::nullopt);
+
+    pool.free(*id0);
+
+    CHECK(pool.allocate() == 0);
+}
@@ -0,0 +1,88 @@
+#include <array>
+#include <vector>
+
+#include <LuminolMaths/Matrix.hpp>
+
+#include <LuminolRenderEngine/Graphics/InstanceTransform.hpp>
+
+#include <doctest/doctest.h>
+
+namespace {
+
+using namespace Luminol::Graphics;
+using Luminol::Maths::Matrix4x4f;
+
+// Rotation/non-uniform scale/shear in the linear part, plus a translation -
+// every entry distinct so a transposed or misplaced element shows up.
+auto make_affine_matrix() -> Matrix4x4f {
+    auto matrix = Matrix4x4f::identity();
+    auto value = 1.0F;
+    for (auto row = std::size_t{0}; row < 4; ++row) {
+        for (auto column = std::size_t{0}; column < 3; ++column) {
+            matrix[row][column] = value;
+            value += 1.0F;
+        }
+    }
+    return matrix;
+}
+
+// Row-vector point transform, as pbr_vert.hlsl does with the full matrix.
+auto transform_point(const Matrix4x4f& matrix, std::array<float, 3> point)
+    -> std::array<float, 3> {
+    auto result = std::array<float, 3>{};
+    for (auto column = std::size_t{0}; column < 3; ++column) {
+        result[column] = (point[0] * matrix[0][column]) +
+            (point[1] * matrix[1][column]) + (point[2] * matrix[2][column]) +
+            matrix[3][column];
+    }
+    return result;
+}
+
+// The shaders' decode: one dot product per world axis.
+auto transform_point(
+    const InstanceTransform& transform, std::array<float, 3> point
+) -> std::array<float, 3> {
+    const auto dot = [&point](const std::array<float, 4>& axis) {
+        return (point[0] * axis[0]) + (point[1] * axis[1]) +
+            (point[2] * axis[2]) + axis[3];
+    };
+    return {dot(transform.world_x), dot(transform.world_y),
+            dot(transform.world_z)};
+}
+
+}  // namespace
+
+TEST_CASE("an affine matrix survives the round trip exactly") {
+    const auto matrix = make_affine_matrix();
+    const auto round_tripped = to_model_matrix(to_instance_transform(matrix));
+
+    for (auto row = std::size_t{0}; row < 4; ++row) {
+        for (auto column = std::size_t{0}; column < 4; ++column) {
+            CHECK(round_tripped[row][column] == matrix[row][column]);
+        }
+    }
+}
+
+TEST_CASE("decoding transforms points like the full matrix") {
+    const auto matrix = make_affine_matrix();
+    const auto transform = to_instance_transform(matrix);
+
+    const auto point = std::array<float, 3>{0.5F, -2.0F, 3.0F};
+    CHECK(transform_point(transform, point) == transform_point(matrix, point));
+}
+
+TEST_CASE("batch packing matches packing one at a time") {
+    auto matrices = std::vector<Matrix4x4f>(3, make_affine_matrix());
+    matrices[1][3][0] = 100.0F;
+    matrices[2][0][1] = -7.0F;
+
+    auto transforms = std::vector<InstanceTransform>(matrices.size());
+    to_instance_transforms(matrices, transforms);
+
+    for (auto i = std::size_t{0}; i < matrices.size(); ++i) {
+        const auto expected = to_instance_transform(matrices[i]);
+        CHECK(transforms[i].world_x == expected.world_x);
+        CHECK(transforms[i].world_y == expected.world_y);
+        CHECK(transforms[i].world_z == expected.world_z);
+    }
+}
@@ -1,5 +1,8 @@
+#include <algorithm>
+#include <cmath>
 #include <cstdint>
 #include <optional>
+#include <vector>
 
 #include <LuminolMaths/Transform.hpp>
 #include <LuminolMaths/Units/Angle.hpp>
@@ -50,15 +53,39 @@ auto light_at_z(float z) -> PointLight {
 
 }  // namespace
 
-TEST_CASE("add_point_light returns nullopt once max_point_lights is exhausted") {
-    auto light_manager = LightManager{};
+TEST_CASE("add_point_light returns nullopt once the capacity is exhausted") {
+    constexpr auto capacity = 4u;
+    auto light_manager =
+        LightManager{LightCapacity{.max_point_lights = capacity}};
 
-    for (auto i = 0u; i < max_point_lights; ++i) {
+    for (auto i = 0u; i < capacity; ++i) {
         const auto id = light_manager.add_point_light(light_at_z(5.0F));
         REQUIRE(id.has_value());
     }
 
     CHECK(light_manager.add_point_light(light_at_z(5.0F)) == std::nullopt);
+
+    light_manager.set_capacity(LightCapacity{.max_point_lights = capacity + 1});
+    CHECK(light_manager.add_point_light(light_at_z(5.0F)).has_value());
+}
+
+TEST_CASE("light storage grows past the old fixed 1024-light cap") {
+    constexpr auto light_count = 5000u;
+    auto light_manager = LightManager{};
+
+    for (auto i = 0u; i < light_count; ++i) {
+        const auto id =
+            light_manager.add_point_light(light_at_z(static_cast<float>(i)));
+        REQUIRE(id.has_value());
+    }
+
+    const auto& light_data = light_manager.get_light_data();
+    REQUIRE(light_data.point_light_count == light_count);
+    CHECK(light_data.point_lights.size() >= light_count);
+    CHECK(
+        light_data.point_lights[light_count - 1].position.z() ==
+        static_cast<float>(light_count - 1)
+    );
 }
 
 TEST_CASE("removed point light ids are reused, lowest id first") {
@@ -99,7 +126,7 @@ TEST_CASE(
     // One light per slot plus enough extras to spill well past the
     // max_slots*1.25 hysteresis soft margin, so ranking is unambiguous:
     // ids are added nearest-first, so id == array index into point_lights
-    // (get_light_data() iterates in ascending LightId order).
+    // (lights are packed in insertion order while none are removed).
     constexpr auto extra_lights = 10u;
     for (auto i = 0u; i < max_shadow_casting_point_lights + extra_lights; ++i) {
         const auto id =
@@ -199,3 +226,199 @@ TEST_CASE(
     CHECK(light_data.point_lights[0].shadow_data.x() == slot_of_id0);
     CHECK(light_data.point_lights[5].shadow_data.x() == slot_of_id5);
 }
+
+TEST_CASE("sync_lights_from keeps surviving lights' shadow slots") {
+    auto source = LightManager{};
+    const auto near_id = source.add_point_light(light_at_z(5.0F));
+    const auto far_id = source.add_point_light(light_at_z(10.0F));
+    REQUIRE(near_id.has_value());
+    REQUIRE(far_id.has_value());
+
+    auto copy = LightManager{};
+    copy.sync_lights_from(source);
+    copy.update_shadow_casters(
+        make_test_view_projection(), Vector3f{0.0F, 0.0F, 0.0F}
+    );
+    float far_slot = 0;
+    {
+        const auto& light_data = copy.get_light_data();
+        REQUIRE(light_data.point_light_count == 2);
+        far_slot = light_data.point_lights[1].shadow_data.x();
+        CHECK(far_slot >= 0.0F);
+    }
+
+    // The source never selects shadow casters itself, yet the copy's
+    // assignment survives each sync; a removed light loses its slot.
+    source.update_point_light(*far_id, light_at_z(11.0F));
+    source.remove_point_light(*near_id);
+    copy.sync_lights_from(source);
+
+    const auto& light_data = copy.get_light_data();
+    REQUIRE(light_data.point_light_count == 1);
+    CHECK(light_data.point_lights[0].position.z() == 11.0F);
+    CHECK(light_data.point_lights[0].shadow_data.x() == far_slot);
+}
+
+TEST_CASE("remove_point_light keeps packed lights dense and marks moved ones") {
+    auto light_manager = LightManager{};
+    const auto id0 = light_manager.add_point_light(light_at_z(5.0F));
+    const auto id1 = light_manager.add_point_light(light_at_z(6.0F));
+    const auto id2 = light_manager.add_point_light(light_at_z(7.0F));
+    REQUIRE(id0.has_value());
+    REQUIRE(id1.has_value());
+    REQUIRE(id2.has_value());
+
+    light_manager.clear_changes();
+    CHECK(light_manager.get_light_data().changed_point_lights.empty());
+
+    // The last packed light (id2) moves into id0's place.
+    light_manager.remove_point_light(*id0);
+
+    const auto& light_data = light_manager.get_light_data();
+    REQUIRE(light_data.point_light_count == 2);
+    CHECK(light_data.point_lights[0].position.z() == 7.0F);
+    CHECK(light_data.point_lights[1].position.z() == 6.0F);
+
+    const auto& changed = light_data.changed_point_lights;
+    REQUIRE(changed.size() == 1);
+    CHECK(changed[0] == 0);
+
+    light_manager.clear_changes();
+    CHECK(light_manager.get_light_data().changed_point_lights.empty());
+}
+
+TEST_CASE(
+    "update_shadow_casters gives the first frame's slots to the nearest "
+    "lights in the frustum wherever they are"
+) {
+    auto light_manager = LightManager{};
+
+    // Scattered over many index cells, some behind the camera, so the
+    // selection has to rank across cells rather than within one.
+    auto positions = std::vector<Vector3f>{};
+    auto state = 7u;
+    const auto next_float = [&state](float min, float max) {
+        state = (state * 1664525u) + 1013904223u;
+        const auto unit =
+            static_cast<float>(state >> 8u) / static_cast<float>(1u << 24u);
+        return min + ((max - min) * unit);
+    };
+    while (positions.size() < 300u) {
+        // Lights this near straddle the frustum's near plane.
+        const auto z = next_float(-60.0F, 90.0F);
+        if (std::abs(z) <= 5.0F) {
+            continue;
+        }
+        const auto extent = std::abs(z) * 0.7F;
+        positions.push_back(Vector3f{
+            next_float(-extent, extent), next_float(-extent, extent), z
+        });
+        const auto id = light_manager.add_point_light(PointLight{
+            .position = positions.back(),
+            .color = Vector3f{1.0F, 1.0F, 1.0F},
+        });
+        REQUIRE(id.has_value());
+        REQUIRE(*id == positions.size() - 1);
+    }
+
+    light_manager.update_shadow_casters(
+        make_test_view_projection(), Vector3f{0.0F, 0.0F, 0.0F}
+    );
+
+    // White lights reach 4 units, so every one in front of the camera is
+    // in the frustum and every one behind it is out.
+    auto in_front = std::vector<uint32_t>{};
+    for (auto id = 0u; id < positions.size(); ++id) {
+        if (positions[id].z() > 5.0F) {
+            in_front.push_back(id);
+        }
+    }
+    std::ranges::sort(in_front, [&positions](uint32_t lhs, uint32_t rhs) {
+        return positions[lhs].dot(positions[lhs]) <
+            positions[rhs].dot(positions[rhs]);
+    });
+    REQUIRE(in_front.size() > max_shadow_casting_point_lights);
+
+    const auto& light_data = light_manager.get_light_data();
+    auto nearest_in_front = std::vector<uint32_t>{
+        in_front.begin(), in_front.begin() + max_shadow_casting_point_lights
+    };
+    auto slot_holders = std::vector<uint32_t>{};
+    for (auto id = 0u; id < positions.size(); ++id) {
+        if (light_data.point_lights[id].shadow_data.x() >= 0.0F) {
+            slot_holders.push_back(id);
+        }
+    }
+    std::ranges::sort(nearest_in_front);
+    CHECK(slot_holders == nearest_in_front);
+}
+
+TEST_CASE(
+    "shadow_casting_point_lights lists the slot holders' packed lights in "
+    "slot order"
+) {
+    auto light_manager = LightManager{};
+    const auto id0 = light_manager.add_point_light(light_at_z(5.0F));
+    const auto id1 = light_manager.add_point_light(light_at_z(6.0F));
+    const auto id2 = light_manager.add_point_light(light_at_z(7.0F));
+    REQUIRE(id0.has_value());
+    REQUIRE(id1.has_value());
+    REQUIRE(id2.has_value());
+
+    const auto check_shadow_casters = [&light_manager](std::size_t count) {
+        const auto& light_data = light_manager.get_light_data();
+        const auto& shadow_casters = light_data.shadow_casting_point_lights;
+        REQUIRE(shadow_casters.size() == count);
+        auto previous_slot = -1.0F;
+        for (const auto packed_index : shadow_casters) {
+            CAPTURE(packed_index);
+            REQUIRE(packed_index < light_data.point_light_count);
+            const auto slot =
+                light_data.point_lights[packed_index].shadow_data.x();
+            CHECK(slot > previous_slot);
+            previous_slot = slot;
+        }
+    };
+
+    light_manager.update_shadow_casters(
+        make_test_view_projection(), Vector3f{0.0F, 0.0F, 0.0F}
+    );
+    check_shadow_casters(3);
+
+    // id2's packed light moves into id0's place, and id0's slot empties.
+    light_manager.remove_point_light(*id0);
+    check_shadow_casters(2);
+
+    light_manager.update_shadow_casters(
+        make_test_view_projection(), Vector3f{0.0F, 0.0F, 0.0F}
+    );
+    check_shadow_casters(2);
+}
+
+TEST_CASE("the point light index follows added, moved and removed lights") {
+    auto light_manager = LightManager{};
+    const auto id0 = light_manager.add_point_light(light_at_z(5.0F));
+    const auto id1 = light_manager.add_point_light(light_at_z(50.0F));
+    REQUIRE(id0.has_value());
+    REQUIRE(id1.has_value());
+
+    const auto& index = light_manager.get_point_light_index();
+    CHECK(index.size() == 2);
+
+    // White lights reach 4 units, so this finds lights within 6 units.
+    const auto query_near_origin = [&index] {
+        auto found = std::vector<uint32_t>{};
+        index.query_sphere(Vector3f{0.0F, 0.0F, 0.0F}, 2.0F, found);
+        std::ranges::sort(found);
+        return found;
+    };
+    CHECK(query_near_origin() == std::vector<uint32_t>{*id0});
+
+    light_manager.update_point_light(*id1, light_at_z(3.0F));
+    CHECK((query_near_origin() == std::vector<uint32_t>{*id0, *id1}));
+
+    light_manager.remove_point_light(*id0);
+    CHECK_FALSE(index.contains(*id0));
+    CHECK(index.size() == 1);
+    CHECK(query_near_origin() == std::vector<uint32_t>{*id1});
+}
@@ -0,0 +1,264 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <LuminolMaths/Transform.hpp>
+#include <LuminolMaths/Units/Angle.hpp>
+#include <LuminolMaths/Vector.hpp>
+
+#include <LuminolRenderEngine/Graphics/Frustum.hpp>
+#include <LuminolRenderEngine/Graphics/LightSpatialIndex.hpp>
+
+#include <doctest/doctest.h>
+
+using namespace Luminol::Graphics;
+using namespace Luminol::Maths;
+
+namespace {
+
+// Deterministic, so a failure reproduces.
+class Random {
+public:
+    auto next_float(float min, float max) -> float {
+        state = (state * 1664525U) + 1013904223U;
+        const auto unit =
+            static_cast<float>(state >> 8U) / static_cast<float>(1U << 24U);
+        return min + ((max - min) * unit);
+    }
+
+private:
+    uint32_t state = 12345U;
+};
+
+constexpr auto test_light_count = 2000u;
+
+// Spread over several cells either side of the origin on every axis.
+auto make_test_lights() -> std::vector<IndexedLight> {
+    auto random = Random{};
+    auto lights = std::vector<IndexedLight>{};
+    for (auto i = 0u; i < test_light_count; ++i) {
+        lights.push_back(IndexedLight{
+            .position =
+                Vector3f{
+                    random.next_float(-100.0F, 100.0F),
+                    random.next_float(-20.0F, 20.0F),
+                    random.next_float(-100.0F, 100.0F),
+                },
+            .radius = random.next_float(0.5F, 6.0F),
+            .intensity = random.next_float(0.05F, 2.0F),
+        });
+    }
+    return lights;
+}
+
+auto make_test_index(const std::vector<IndexedLight>& lights)
+    -> LightSpatialIndex {
+    auto index = LightSpatialIndex{};
+    for (auto id = 0u; id < lights.size(); ++id) {
+        index.insert(id, lights[id]);
+    }
+    return index;
+}
+
+// The axis-aligned box [min, max] as six inward-facing planes, in
+// extract_frustum_planes' order.
+auto make_box_planes(const Vector3f& min, const Vector3f& max)
+    -> std::array<Vector4f, 6> {
+    return std::array<Vector4f, 6>{
+        Vector4f{1.0F, 0.0F, 0.0F, -min.x()},
+        Vector4f{-1.0F, 0.0F, 0.0F, max.x()},
+        Vector4f{0.0F, 1.0F, 0.0F, -min.y()},
+        Vector4f{0.0F, -1.0F, 0.0F, max.y()},
+        Vector4f{0.0F, 0.0F, 1.0F, -min.z()},
+        Vector4f{0.0F, 0.0F, -1.0F, max.z()},
+    };
+}
+
+auto sorted(std::vector<uint32_t> ids) -> std::vector<uint32_t> {
+    std::ranges::sort(ids);
+    return ids;
+}
+
+}  // namespace
+
+TEST_CASE("query_sphere finds exactly the lights whose spheres intersect") {
+    const auto lights = make_test_lights();
+    const auto index = make_test_index(lights);
+    REQUIRE(index.size() == lights.size());
+
+    const auto center = Vector3f{10.0F, 0.0F, -30.0F};
+    constexpr auto radius = 25.0F;
+
+    auto expected = std::vector<uint32_t>{};
+    for (auto id = 0u; id < lights.size(); ++id) {
+        const auto offset = lights[id].position - center;
+        const auto reach = radius + lights[id].radius;
+        if (offset.dot(offset) <= reach * reach) {
+            expected.push_back(id);
+        }
+    }
+    REQUIRE_FALSE(expected.empty());
+
+    auto found = std::vector<uint32_t>{};
+    index.query_sphere(center, radius, found);
+    CHECK(sorted(found) == expected);
+}
+
+TEST_CASE("query_frustum finds exactly the lights sphere_in_frustum passes") {
+    const auto lights = make_test_lights();
+    const auto index = make_test_index(lights);
+    const auto planes = make_box_planes(
+        Vector3f{-40.0F, -5.0F, 0.0F}, Vector3f{25.0F, 5.0F, 70.0F}
+    );
+
+    auto expected = std::vector<uint32_t>{};
+    for (auto id = 0u; id < lights.size(); ++id) {
+        if (sphere_in_frustum(planes, lights[id].position, lights[id].radius)) {
+            expected.push_back(id);
+        }
+    }
+    REQUIRE_FALSE(expected.empty());
+
+    auto found = std::vector<uint32_t>{};
+    index.query_frustum(planes, found);
+    CHECK(sorted(found) == expected);
+}
+
+TEST_CASE("query_frustum matches sphere_in_frustum for a perspective frustum") {
+    const auto lights = make_test_lights();
+    const auto index = make_test_index(lights);
+
+    const auto view = Transform::left_handed_look_at_matrix(
+        Transform::LookAtParams<float>{
+            .eye = Vector3f{0.0F, 0.0F, 0.0F},
+            .target = Vector3f{0.0F, 0.0F, 1.0F},
+            .up_vector = Vector3f{0.0F, 1.0F, 0.0F},
+        }
+    );
+    const auto projection = Transform::left_handed_perspective_projection_matrix(
+        Transform::PerspectiveMatrixParams<float>{
+            .fov = Luminol::Units::Degrees_f{60.0F},
+            .aspect_ratio = 16.0F / 9.0F,
+            .near_plane = 0.1F,
+            .far_plane = 60.0F,
+        }
+    );
+    const auto planes = extract_frustum_planes(view * projection);
+
+    auto expected = std::vector<uint32_t>{};
+    for (auto id = 0u; id < lights.size(); ++id) {
+        if (sphere_in_frustum(planes, lights[id].position, lights[id].radius)) {
+            expected.push_back(id);
+        }
+    }
+    REQUIRE_FALSE(expected.empty());
+    REQUIRE(expected.size() < lights.size() / 2);
+
+    auto found = std::vector<uint32_t>{};
+    index.query_frustum(planes, found);
+    CHECK(sorted(found) == expected);
+}
+
+TEST_CASE("select_highest_scoring matches ranking every light") {
+    const auto lights = make_test_lights();
+    const auto index = make_test_index(lights);
+    const auto planes = make_box_planes(
+        Vector3f{-60.0F, -20.0F, -10.0F}, Vector3f{60.0F, 20.0F, 100.0F}
+    );
+    const auto camera_position = Vector3f{0.0F, 0.0F, -10.0F};
+    constexpr auto count = std::size_t{20};
+
+    auto expected = std::vector<ScoredLight>{};
+    for (auto id = 0u; id < lights.size(); ++id) {
+        const auto& light = lights[id];
+        if (!sphere_in_frustum(planes, light.position, light.radius)) {
+            continue;
+        }
+        const auto to_light = light.position - camera_position;
+        expected.push_back(ScoredLight{
+            .id = id,
+            .score =
+                light.intensity / std::max(to_light.dot(to_light), 0.01F),
+        });
+    }
+    std::ranges::sort(expected, [](const auto& lhs, const auto& rhs) {
+        return lhs.score > rhs.score;
+    });
+    REQUIRE(expected.size() > count);
+    expected.resize(count);
+
+    auto selected = std::vector<ScoredLight>{};
+    auto scratch = LightSpatialIndex::SelectionScratch{};
+    index.select_highest_scoring(
+        planes, camera_position, count, selected, scratch
+    );
+
+    REQUIRE(selected.size() == count);
+    for (auto i = 0u; i < count; ++i) {
+        CAPTURE(i);
+        CHECK(selected[i].id == expected[i].id);
+        CHECK(selected[i].score == expected[i].score);
+    }
+}
+
+TEST_CASE("select_highest_scoring returns every candidate when there are few") {
+    auto index = LightSpatialIndex{};
+    index.insert(
+        0, IndexedLight{.position = {0, 0, 5}, .radius = 1, .intensity = 1}
+    );
+    index.insert(
+        1, IndexedLight{.position = {0, 0, 50}, .radius = 1, .intensity = 1}
+    );
+    // Outside the box.
+    index.insert(
+        2, IndexedLight{.position = {0, 0, -50}, .radius = 1, .intensity = 9}
+    );
+
+    auto selected = std::vector<ScoredLight>{};
+    auto scratch = LightSpatialIndex::SelectionScratch{};
+    index.select_highest_scoring(
+        make_box_planes(Vector3f{-10, -10, 0}, Vector3f{10, 10, 100}),
+        Vector3f{0, 0, 0}, 8, selected, scratch
+    );
+
+    REQUIRE(selected.size() == 2);
+    CHECK(selected[0].id == 0);
+    CHECK(selected[1].id == 1);
+}
+
+TEST_CASE("insert moves an indexed light and remove forgets it") {
+    auto index = LightSpatialIndex{};
+    index.insert(
+        3, IndexedLight{.position = {0, 0, 0}, .radius = 1, .intensity = 1}
+    );
+    index.insert(
+        4, IndexedLight{.position = {1, 0, 0}, .radius = 1, .intensity = 1}
+    );
+    CHECK(index.contains(3));
+    CHECK_FALSE(index.contains(0));
+    CHECK(index.size() == 2);
+
+    // Several cells away, so it changes cell.
+    index.insert(
+        3, IndexedLight{.position = {-200, 0, 0}, .radius = 1, .intensity = 1}
+    );
+    CHECK(index.size() == 2);
+
+    auto found = std::vector<uint32_t>{};
+    index.query_sphere(Vector3f{0, 0, 0}, 0.5F, found);
+    CHECK(found == std::vector<uint32_t>{4});
+
+    found.clear();
+    index.query_sphere(Vector3f{-200, 0, 0}, 0.5F, found);
+    CHECK(found == std::vector<uint32_t>{3});
+
+    index.remove(3);
+    index.remove(3);
+    CHECK_FALSE(index.contains(3));
+    CHECK(index.size() == 1);
+
+    found.clear();
+    index.query_sphere(Vector3f{-200, 0, 0}, 0.5F, found);
+    CHECK(found.empty());
+}
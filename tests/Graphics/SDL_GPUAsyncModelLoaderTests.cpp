@@ -0,0 +1,93 @@
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUAsyncModelLoader.hpp>
+
+#include <doctest/doctest.h>
+
+using namespace Luminol::Graphics::SDL_GPU;
+
+namespace {
+
+auto wait_for_completed(AsyncModelLoader& loader, std::size_t count)
+    -> std::vector<CompletedModelLoad> {
+    using namespace std::chrono_literals;
+
+    auto completed = std::vector<CompletedModelLoad>{};
+    for (auto attempt = 0; attempt < 3000 && completed.size() < count;
+         ++attempt) {
+        for (auto& load : loader.take_completed()) {
+            completed.push_back(std::move(load));
+        }
+        std::this_thread::sleep_for(10ms);
+    }
+    return completed;
+}
+
+}  // namespace
+
+TEST_CASE("AsyncModelLoader prepares queued models in order") {
+    auto loader = AsyncModelLoader{};
+    loader.enqueue(7, 100, "res/models/cube/cube.obj");
+    loader.enqueue(3, 101, "res/models/does_not_exist.obj");
+
+    const auto completed = wait_for_completed(loader, 2);
+    REQUIRE(completed.size() == 2);
+
+    CHECK(completed[0].renderable_id == 7);
+    CHECK(completed[0].ticket == 100);
+    REQUIRE(completed[0].model.has_value());
+    CHECK_FALSE(completed[0].model->view().submeshes.empty());
+    CHECK(completed[0].model->get_upload_size_bytes() > 0);
+
+    CHECK(completed[1].renderable_id == 3);
+    CHECK(completed[1].ticket == 101);
+    CHECK_FALSE(completed[1].model.has_value());
+}
+
+TEST_CASE("AsyncModelLoader can be destroyed with loads still queued") {
+    auto loader = AsyncModelLoader{};
+    for (auto ticket = uint64_t{0}; ticket < 8; ++ticket) {
+        loader.enqueue(0, ticket, "res/models/cube/cube.obj");
+    }
+}
+
+TEST_CASE("fits_upload_budget defers a model that would overshoot the budget") {
+    constexpr auto mebibyte = uint64_t{1024} * 1024;
+    constexpr auto byte_budget = 64 * mebibyte;
+
+    auto loader = AsyncModelLoader{};
+    loader.enqueue(0, 0, "res/models/cube/cube.obj");
+    const auto completed = wait_for_completed(loader, 1);
+    REQUIRE(completed.size() == 1);
+    REQUIRE(completed[0].model.has_value());
+    const auto small_model_bytes = completed[0].model->get_upload_size_bytes();
+    REQUIRE(small_model_bytes < byte_budget);
+
+    // With the small model already taken, a large one waits for the next
+    // call, and uploads then as that call's first model.
+    CHECK_FALSE(
+        fits_upload_budget(small_model_bytes, 500 * mebibyte, byte_budget)
+    );
+    CHECK(fits_upload_budget(0, 500 * mebibyte, byte_budget));
+
+    CHECK(fits_upload_budget(
+        small_model_bytes, byte_budget - small_model_bytes, byte_budget
+    ));
+    CHECK_FALSE(fits_upload_budget(
+        small_model_bytes, byte_budget - small_model_bytes + 1, byte_budget
+    ));
+}
+
+TEST_CASE("fits_upload_budget takes nothing more after an oversized model") {
+    constexpr auto byte_budget = uint64_t{1000};
+
+    CHECK(fits_upload_budget(0, 5000, byte_budget));
+    CHECK_FALSE(fits_upload_budget(5000, 1, byte_budget));
+    CHECK_FALSE(fits_upload_budget(
+        byte_budget, std::numeric_limits<uint64_t>::max(), byte_budget
+    ));
+}
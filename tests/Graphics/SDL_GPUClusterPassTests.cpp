@@ -0,0 +1,116 @@
+#include <LuminolRenderEngine/Graphics/SDL_GPU/Lighting/SDL_GPUClusterPass.hpp>
+
+#include <doctest/doctest.h>
+
+using namespace Luminol::Graphics::SDL_GPU;
+
+TEST_CASE("an overflowing light index list grows within the budget") {
+    const auto next = adapt_light_index_list_settings(
+        LightIndexListSettings{.capacity = 1024, .lights_per_cluster = 2048},
+        LightIndexListUsage{
+            .required_entry_count = 3000,
+            .dropped_entry_count = 2000,
+            .clamped_cluster_count = 0,
+        },
+        uint32_t{1} << 20U
+    );
+
+    // 3000 plus a quarter, rounded up to a power of two.
+    CHECK(next.capacity == 4096);
+    CHECK(next.lights_per_cluster == 2048);
+}
+
+TEST_CASE("a light index list at its budget clamps lights per cluster") {
+    const auto next = adapt_light_index_list_settings(
+        LightIndexListSettings{.capacity = 4096, .lights_per_cluster = 2048},
+        LightIndexListUsage{
+            .required_entry_count = 16384,
+            .dropped_entry_count = 12288,
+            .clamped_cluster_count = 0,
+        },
+        8192
+    );
+
+    CHECK(next.capacity == 8192);
+    // Scaled by what fits over what was needed.
+    CHECK(next.lights_per_cluster == 1024);
+}
+
+TEST_CASE("lights per cluster never clamps below min_lights_per_cluster") {
+    const auto next = adapt_light_index_list_settings(
+        LightIndexListSettings{.capacity = 4096, .lights_per_cluster = 64},
+        LightIndexListUsage{
+            .required_entry_count = 1000000,
+            .dropped_entry_count = 995904,
+            .clamped_cluster_count = 3456,
+        },
+        4096
+    );
+
+    CHECK(next.capacity == 4096);
+    CHECK(next.lights_per_cluster == min_lights_per_cluster);
+}
+
+TEST_CASE("clamped lights per cluster double once doubling them fits") {
+    const auto next = adapt_light_index_list_settings(
+        LightIndexListSettings{.capacity = 8192, .lights_per_cluster = 256},
+        LightIndexListUsage{
+            .required_entry_count = 4000,
+            .dropped_entry_count = 0,
+            .clamped_cluster_count = 5,
+        },
+        uint32_t{1} << 20U
+    );
+
+    CHECK(next.capacity == 8192);
+    CHECK(next.lights_per_cluster == 512);
+}
+
+TEST_CASE("clamped lights per cluster grow the list before doubling") {
+    const auto next = adapt_light_index_list_settings(
+        LightIndexListSettings{.capacity = 8192, .lights_per_cluster = 256},
+        LightIndexListUsage{
+            .required_entry_count = 6000,
+            .dropped_entry_count = 0,
+            .clamped_cluster_count = 5,
+        },
+        uint32_t{1} << 20U
+    );
+
+    CHECK(next.capacity == 16384);
+    CHECK(next.lights_per_cluster == 256);
+}
+
+TEST_CASE("clamped lights per cluster stay put with no room in the budget") {
+    const auto current =
+        LightIndexListSettings{.capacity = 8192, .lights_per_cluster = 256};
+
+    const auto next = adapt_light_index_list_settings(
+        current,
+        LightIndexListUsage{
+            .required_entry_count = 6000,
+            .dropped_entry_count = 0,
+            .clamped_cluster_count = 5,
+        },
+        8192
+    );
+
+    CHECK(next == current);
+}
+
+TEST_CASE("a light index list that fits without clamping is left alone") {
+    const auto current =
+        LightIndexListSettings{.capacity = 8192, .lights_per_cluster = 2048};
+
+    const auto next = adapt_light_index_list_settings(
+        current,
+        LightIndexListUsage{
+            .required_entry_count = 100,
+            .dropped_entry_count = 0,
+            .clamped_cluster_count = 0,
+        },
+        uint32_t{1} << 20U
+    );
+
+    CHECK(next == current);
+}
@@ -0,0 +1,373 @@
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUMeshCache.hpp>
+
+#include <doctest/doctest.h>
+
+using namespace Luminol::Graphics;
+using namespace Luminol::Graphics::SDL_GPU;
+
+namespace {
+
+auto make_test_baked_mesh(const std::filesystem::path& model_directory)
+    -> BakedMesh {
+    auto baked = BakedMesh{};
+    baked.vertices = std::vector<float>(33, 0.5F);
+    baked.indices = {0, 1, 2};
+    baked.meshlets.push_back(GpuMeshletMetadata{
+        .vertex_offset = 0,
+        .triangle_offset = 0,
+        .vertex_count = 3,
+        .triangle_count = 1,
+        .bounds_center = {0.0F, 1.0F, 2.0F},
+        .bounds_radius = 3.0F,
+        .local_bounds_min = {-1.0F, -1.0F, -1.0F, 0.0F},
+        .local_bounds_max = {1.0F, 1.0F, 1.0F, 0.0F},
+    });
+    baked.meshlet_vertices = {0, 1, 2};
+    baked.meshlet_triangles = {pack_meshlet_triangle(0, 1, 2)};
+
+    auto submesh = BakedSubmesh{
+        .lod_ranges = {},
+        .meshlet_ranges = {},
+        .vertex_offset = 0,
+        .local_bounds =
+            BoundingBox{
+                .min = Luminol::Maths::Vector3f{-1.0F, -2.0F, -3.0F},
+                .max = Luminol::Maths::Vector3f{1.0F, 2.0F, 3.0F},
+            },
+        .material = BakedMaterial{},
+    };
+    submesh.lod_ranges.fill(LodRange{.first_index = 0, .index_count = 3});
+    submesh.meshlet_ranges.fill(
+        MeshletRange{.first_meshlet = 0, .meshlet_count = 1}
+    );
+    submesh.material.diffuse_texture_path =
+        model_directory / "textures" / "diffuse.png";
+    submesh.material.normal_texture_wrap.u =
+        Luminol::Utilities::ModelLoader::TextureWrapMode::ClampToEdge;
+    submesh.material.alpha_mode =
+        Luminol::Utilities::ModelLoader::AlphaMode::Blend;
+    baked.submeshes.push_back(submesh);
+
+    return baked;
+}
+
+template <typename T>
+auto bytes_equal(const std::vector<T>& lhs, const std::vector<T>& rhs)
+    -> bool {
+    return lhs.size() == rhs.size() &&
+           (lhs.empty() ||
+            std::memcmp(lhs.data(), rhs.data(), lhs.size() * sizeof(T)) == 0);
+}
+
+auto make_temporary_cache_path(const char* name) -> std::filesystem::path {
+    const auto directory =
+        std::filesystem::temp_directory_path() / "luminol_mesh_cache_tests";
+    std::filesystem::create_directories(directory);
+    return directory / name;
+}
+
+auto read_file(const std::filesystem::path& path) -> std::vector<std::byte> {
+    auto bytes = std::vector<std::byte>(std::filesystem::file_size(path));
+    auto stream = std::ifstream{path, std::ios::binary};
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    stream.read(
+        reinterpret_cast<char*>(bytes.data()),
+        static_cast<std::streamsize>(bytes.size())
+    );
+    return bytes;
+}
+
+auto write_file(
+    const std::filesystem::path& path, const std::vector<std::byte>& bytes
+) -> void {
+    auto stream = std::ofstream{path, std::ios::binary | std::ios::trunc};
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    stream.write(
+        reinterpret_cast<const char*>(bytes.data()),
+        static_cast<std::streamsize>(bytes.size())
+    );
+}
+
+}  // namespace
+
+TEST_CASE("mesh cache round-trips every baked array and submesh") {
+    const auto cache_path = make_temporary_cache_path("round_trip.lmesh");
+    const auto model_directory = std::filesystem::path{"res/models/test"};
+    const auto baked = make_test_baked_mesh(model_directory);
+    constexpr auto key = uint64_t{0x1234};
+
+    REQUIRE(write_mesh_cache(cache_path, key, baked.view(), model_directory));
+
+    const auto entry = MeshCacheEntry::open(cache_path, key, model_directory);
+    REQUIRE(entry.has_value());
+
+    const auto view = entry->view();
+    CHECK(view.vertices.size() == baked.vertices.size());
+    CHECK(view.vertices[32] == doctest::Approx(0.5F));
+    CHECK(view.indices.size() == 3);
+    REQUIRE(view.meshlets.size() == 1);
+    CHECK(view.meshlets[0].bounds_radius == doctest::Approx(3.0F));
+    CHECK(view.meshlet_vertices.size() == 3);
+    CHECK(view.meshlet_triangles.size() == 1);
+    CHECK(view.meshlet_triangles[0] == 0x020100U);
+
+    REQUIRE(view.submeshes.size() == 1);
+    const auto& submesh = view.submeshes[0];
+    CHECK(submesh.lod_ranges[3].index_count == 3);
+    CHECK(submesh.meshlet_ranges[2].meshlet_count == 1);
+    CHECK(submesh.local_bounds.max.z() == doctest::Approx(3.0F));
+    CHECK(
+        submesh.material.diffuse_texture_path ==
+        model_directory / "textures" / "diffuse.png"
+    );
+    CHECK_FALSE(submesh.material.normal_texture_path.has_value());
+    CHECK(
+        submesh.material.normal_texture_wrap.u ==
+        Luminol::Utilities::ModelLoader::TextureWrapMode::ClampToEdge
+    );
+    CHECK(
+        submesh.material.alpha_mode ==
+        Luminol::Utilities::ModelLoader::AlphaMode::Blend
+    );
+}
+
+TEST_CASE("mesh cache texture paths are rebased onto the loading directory") {
+    const auto cache_path = make_temporary_cache_path("rebase.lmesh");
+    const auto baked = make_test_baked_mesh("original/dir");
+    constexpr auto key = uint64_t{0x5678};
+
+    REQUIRE(write_mesh_cache(cache_path, key, baked.view(), "original/dir"));
+
+    const auto entry = MeshCacheEntry::open(cache_path, key, "moved/dir");
+    REQUIRE(entry.has_value());
+    CHECK(
+        entry->view().submeshes[0].material.diffuse_texture_path ==
+        std::filesystem::path{"moved/dir"} / "textures" / "diffuse.png"
+    );
+}
+
+TEST_CASE("mesh cache rejects an entry written under a different key") {
+    const auto cache_path = make_temporary_cache_path("key_mismatch.lmesh");
+    const auto baked = make_test_baked_mesh("dir");
+
+    REQUIRE(write_mesh_cache(cache_path, 1, baked.view(), "dir"));
+
+    CHECK_FALSE(MeshCacheEntry::open(cache_path, 2, "dir").has_value());
+}
+
+TEST_CASE("mesh cache rejects a truncated entry") {
+    const auto cache_path = make_temporary_cache_path("truncated.lmesh");
+    const auto baked = make_test_baked_mesh("dir");
+    constexpr auto key = uint64_t{42};
+
+    REQUIRE(write_mesh_cache(cache_path, key, baked.view(), "dir"));
+    std::filesystem::resize_file(
+        cache_path, std::filesystem::file_size(cache_path) - 16
+    );
+
+    CHECK_FALSE(MeshCacheEntry::open(cache_path, key, "dir").has_value());
+}
+
+TEST_CASE("mesh cache rejects an entry with a corrupted payload byte") {
+    const auto cache_path = make_temporary_cache_path("corrupt.lmesh");
+    const auto baked = make_test_baked_mesh("dir");
+    constexpr auto key = uint64_t{42};
+
+    REQUIRE(write_mesh_cache(cache_path, key, baked.view(), "dir"));
+
+    auto bytes = read_file(cache_path);
+    // Flip a bit in the vertices - every section stays in bounds, so only
+    // the payload checksum can notice.
+    const auto vertex_bytes = gsl::as_bytes(gsl::span{baked.vertices});
+    const auto vertices = std::ranges::search(bytes, vertex_bytes);
+    REQUIRE_FALSE(vertices.empty());
+    vertices.front() ^= std::byte{0x40};
+    write_file(cache_path, bytes);
+
+    CHECK_FALSE(MeshCacheEntry::open(cache_path, key, "dir").has_value());
+}
+
+TEST_CASE("mesh cache rejects ranges past the end of their section") {
+    const auto cache_path = make_temporary_cache_path("out_of_range.lmesh");
+    constexpr auto key = uint64_t{42};
+
+    auto lod_past_end = make_test_baked_mesh("dir");
+    lod_past_end.submeshes[0].lod_ranges[2].index_count = 4;
+    REQUIRE(write_mesh_cache(cache_path, key, lod_past_end.view(), "dir"));
+    CHECK_FALSE(MeshCacheEntry::open(cache_path, key, "dir").has_value());
+
+    auto meshlets_past_end = make_test_baked_mesh("dir");
+    meshlets_past_end.submeshes[0].meshlet_ranges[1].first_meshlet = 1;
+    REQUIRE(write_mesh_cache(cache_path, key, meshlets_past_end.view(), "dir"));
+    CHECK_FALSE(MeshCacheEntry::open(cache_path, key, "dir").has_value());
+
+    auto meshlet_vertices_past_end = make_test_baked_mesh("dir");
+    meshlet_vertices_past_end.meshlets[0].vertex_offset = 1;
+    REQUIRE(write_mesh_cache(
+        cache_path, key, meshlet_vertices_past_end.view(), "dir"
+    ));
+    CHECK_FALSE(MeshCacheEntry::open(cache_path, key, "dir").has_value());
+
+    auto vertex_offset_past_end = make_test_baked_mesh("dir");
+    vertex_offset_past_end.submeshes[0].vertex_offset = 4;
+    REQUIRE(write_mesh_cache(
+        cache_path, key, vertex_offset_past_end.view(), "dir"
+    ));
+    CHECK_FALSE(MeshCacheEntry::open(cache_path, key, "dir").has_value());
+
+    // And the unmodified mesh still opens.
+    REQUIRE(write_mesh_cache(
+        cache_path, key, make_test_baked_mesh("dir").view(), "dir"
+    ));
+    CHECK(MeshCacheEntry::open(cache_path, key, "dir").has_value());
+}
+
+TEST_CASE("concurrent writers of one mesh cache entry leave a valid entry") {
+    const auto cache_path = make_temporary_cache_path("concurrent.lmesh");
+    const auto baked = make_test_baked_mesh("dir");
+    constexpr auto key = uint64_t{42};
+
+    auto failed_writes = std::atomic<int>{0};
+    {
+        auto writers = std::vector<std::jthread>{};
+        for (auto writer = 0; writer < 4; ++writer) {
+            writers.emplace_back([&cache_path, &baked, &failed_writes] {
+                for (auto write = 0; write < 25; ++write) {
+                    if (!write_mesh_cache(
+                            cache_path, key, baked.view(), "dir"
+                        )) {
+                        ++failed_writes;
+                    }
+                }
+            });
+        }
+    }
+
+    CHECK(failed_writes == 0);
+    CHECK(MeshCacheEntry::open(cache_path, key, "dir").has_value());
+    for (const auto& file : std::filesystem::directory_iterator{
+             cache_path.parent_path()
+         }) {
+        CHECK(file.path().extension() != ".tmp");
+    }
+}
+
+TEST_CASE("mesh cache treats a missing file as a miss") {
+    CHECK_FALSE(
+        MeshCacheEntry::open(make_temporary_cache_path("missing.lmesh"), 0, "")
+            .has_value()
+    );
+}
+
+TEST_CASE("compute_mesh_cache_key depends on the bake settings") {
+    const auto model_path = make_temporary_cache_path("model.obj");
+    {
+        auto stream = std::ofstream{model_path};
+        stream << "v 0 0 0\n";
+    }
+
+    const auto key_a = compute_mesh_cache_key(model_path, 0, 1);
+    const auto key_b = compute_mesh_cache_key(model_path, 0, 2);
+    REQUIRE(key_a.has_value());
+    REQUIRE(key_b.has_value());
+    CHECK(*key_a != *key_b);
+    CHECK(compute_mesh_cache_key(model_path, 0, 1) == key_a);
+}
+
+TEST_CASE("compute_mesh_cache_key depends on the import flags") {
+    const auto model_path = make_temporary_cache_path("import_flags.obj");
+    {
+        auto stream = std::ofstream{model_path};
+        stream << "v 0 0 0\n";
+    }
+
+    const auto import_flags =
+        Luminol::Utilities::ModelLoader::get_import_flags();
+    const auto key_a = compute_mesh_cache_key(model_path, import_flags, 1);
+    const auto key_b = compute_mesh_cache_key(model_path, import_flags ^ 1U, 1);
+    REQUIRE(key_a.has_value());
+    REQUIRE(key_b.has_value());
+    CHECK(*key_a != *key_b);
+}
+
+TEST_CASE("bake_model output is byte-identical for every worker count") {
+    // 79 submeshes of very different sizes, so the parallel bake really does
+    // finish them out of order.
+    const auto model = Luminol::Utilities::ModelLoader::load_model(
+        "res/models/survival_guitar_backpack/scene.gltf"
+    );
+    REQUIRE(model.has_value());
+
+    const auto serial = bake_model(*model, 1);
+    const auto parallel = bake_model(*model, 4);
+
+    CHECK(bytes_equal(serial.vertices, parallel.vertices));
+    CHECK(bytes_equal(serial.indices, parallel.indices));
+    CHECK(bytes_equal(serial.meshlets, parallel.meshlets));
+    CHECK(bytes_equal(serial.meshlet_vertices, parallel.meshlet_vertices));
+    CHECK(bytes_equal(serial.meshlet_triangles, parallel.meshlet_triangles));
+
+    REQUIRE(serial.submeshes.size() == model->meshes.size());
+    REQUIRE(parallel.submeshes.size() == serial.submeshes.size());
+    for (auto i = std::size_t{0}; i < serial.submeshes.size(); ++i) {
+        CAPTURE(i);
+        const auto& expected = serial.submeshes[i];
+        const auto& actual = parallel.submeshes[i];
+        CHECK(actual.vertex_offset == expected.vertex_offset);
+        CHECK(
+            std::memcmp(
+                actual.lod_ranges.data(),
+                expected.lod_ranges.data(),
+                sizeof(expected.lod_ranges)
+            ) == 0
+        );
+        CHECK(
+            std::memcmp(
+                actual.meshlet_ranges.data(),
+                expected.meshlet_ranges.data(),
+                sizeof(expected.meshlet_ranges)
+            ) == 0
+        );
+        CHECK(
+            actual.material.diffuse_texture_path ==
+            expected.material.diffuse_texture_path
+        );
+    }
+}
+
+TEST_CASE("bake_model packs one word per meshlet triangle") {
+    const auto model = Luminol::Utilities::ModelLoader::load_model(
+        "res/models/survival_guitar_backpack/scene.gltf"
+    );
+    REQUIRE(model.has_value());
+
+    const auto baked = bake_model(*model, 1);
+
+    auto expected_triangle_offset = uint32_t{0};
+    for (const auto& meshlet : baked.meshlets) {
+        CHECK(meshlet.triangle_offset == expected_triangle_offset);
+        expected_triangle_offset += meshlet.triangle_count;
+
+        for (auto triangle = uint32_t{0}; triangle < meshlet.triangle_count;
+             ++triangle) {
+            const auto packed =
+                baked.meshlet_triangles[meshlet.triangle_offset + triangle];
+            CHECK((packed >> 24U) == 0U);
+            for (auto vertex = 0U; vertex < 3U; ++vertex) {
+                const auto local_vertex_slot =
+                    (packed >> (8U * vertex)) & 0xFFU;
+                CHECK(local_vertex_slot < meshlet.vertex_count);
+            }
+        }
+    }
+    CHECK(baked.meshlet_triangles.size() == expected_triangle_offset);
+}
@@ -0,0 +1,168 @@
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <LuminolMaths/Matrix.hpp>
+
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPURetainedInstanceStore.hpp>
+
+#include <doctest/doctest.h>
+
+namespace {
+
+using namespace Luminol::Graphics;
+using namespace Luminol::Graphics::SDL_GPU;
+using Luminol::Maths::Matrix4x4f;
+
+auto make_translation(float x) -> Matrix4x4f {
+    auto matrix = Matrix4x4f::identity();
+    matrix[3][0] = x;
+    return matrix;
+}
+
+auto get_translations(
+    const RetainedInstanceStore& store, RenderableId renderable_id
+) -> std::vector<float> {
+    auto translations = std::vector<float>{};
+    for (const auto& matrix : store.get_model_matrices(renderable_id)) {
+        translations.push_back(matrix[3][0]);
+    }
+    return translations;
+}
+
+auto get_sorted_dirty_slots(
+    const RetainedInstanceStore& store, RenderableId renderable_id
+) -> std::vector<uint32_t> {
+    const auto dirty_slots = store.get_dirty_slots(renderable_id);
+    auto slots = std::vector<uint32_t>{dirty_slots.begin(), dirty_slots.end()};
+    std::ranges::sort(slots);
+    return slots;
+}
+
+}  // namespace
+
+TEST_CASE("created instances are stored densely per renderable") {
+    auto store = RetainedInstanceStore{};
+
+    const auto a = store.create(2, make_translation(1.0F));
+    const auto b = store.create(0, make_translation(2.0F));
+    const auto c = store.create(2, make_translation(3.0F));
+
+    CHECK(a != b);
+    CHECK(b != c);
+    CHECK(store.get_renderable_count() == 3);
+    const auto expected = std::vector<float>{1.0F, 3.0F};
+    CHECK(get_translations(store, 2) == expected);
+    CHECK(get_translations(store, 0) == std::vector<float>(1, 2.0F));
+    CHECK(store.get_model_matrices(1).empty());
+    CHECK(store.get_model_matrices(7).empty());
+}
+
+TEST_CASE("only written slots are dirty, once each, until cleared") {
+    auto store = RetainedInstanceStore{};
+
+    auto instance_ids = std::vector<InstanceId>{};
+    for (auto i = 0; i < 8; ++i) {
+        instance_ids.push_back(store.create(0, make_translation(0.0F)));
+    }
+    CHECK(store.get_dirty_slots(0).size() == 8);
+
+    store.clear_dirty();
+    CHECK(store.get_dirty_renderables().empty());
+    CHECK(store.get_dirty_slots(0).empty());
+
+    store.update(instance_ids[5], make_translation(5.0F));
+    store.update(instance_ids[2], make_translation(2.0F));
+    store.update(instance_ids[5], make_translation(50.0F));
+
+    REQUIRE(store.get_dirty_renderables().size() == 1);
+    CHECK(store.get_dirty_renderables()[0] == 0);
+    const auto expected = std::vector<uint32_t>{2, 5};
+    CHECK(get_sorted_dirty_slots(store, 0) == expected);
+    CHECK(store.get_model_matrices(0)[5][3][0] == 50.0F);
+}
+
+TEST_CASE("destroy moves the last instance into the freed slot") {
+    auto store = RetainedInstanceStore{};
+
+    const auto a = store.create(0, make_translation(1.0F));
+    const auto b = store.create(0, make_translation(2.0F));
+    const auto c = store.create(0, make_translation(3.0F));
+    store.clear_dirty();
+
+    store.destroy(a);
+    const auto moved = std::vector<float>{3.0F, 2.0F};
+    CHECK(get_translations(store, 0) == moved);
+    CHECK(get_sorted_dirty_slots(store, 0) == std::vector<uint32_t>(1, 0));
+
+    // c's handle follows it to its new slot; b's stays put.
+    store.update(c, make_translation(30.0F));
+    store.update(b, make_translation(20.0F));
+    const auto updated = std::vector<float>{30.0F, 20.0F};
+    CHECK(get_translations(store, 0) == updated);
+
+    // Destroying the last slot moves nothing.
+    store.clear_dirty();
+    const auto d = store.create(0, make_translation(4.0F));
+    store.clear_dirty();
+    store.destroy(d);
+    CHECK(get_translations(store, 0) == updated);
+    CHECK(store.get_dirty_renderables().empty());
+}
+
+TEST_CASE("destroyed instance ids are reused") {
+    auto store = RetainedInstanceStore{};
+
+    const auto a = store.create(0, make_translation(1.0F));
+    const auto b = store.create(0, make_translation(2.0F));
+    store.destroy(a);
+
+    const auto reused = store.create(1, make_translation(3.0F));
+    CHECK(reused == a);
+    CHECK(get_translations(store, 1) == std::vector<float>(1, 3.0F));
+
+    store.update(reused, make_translation(4.0F));
+    store.update(b, make_translation(5.0F));
+    CHECK(get_translations(store, 1) == std::vector<float>(1, 4.0F));
+    CHECK(get_translations(store, 0) == std::vector<float>(1, 5.0F));
+}
+
+TEST_CASE("sync_from copies only dirty slots and follows shrinking") {
+    auto source = RetainedInstanceStore{};
+    auto copy = RetainedInstanceStore{};
+
+    const auto a = source.create(0, make_translation(1.0F));
+    const auto b = source.create(0, make_translation(2.0F));
+    const auto c = source.create(1, make_translation(3.0F));
+    copy.sync_from(source);
+    source.clear_dirty();
+
+    const auto synced = std::vector<float>{1.0F, 2.0F};
+    const auto all_slots = std::vector<uint32_t>{0, 1};
+    CHECK(get_translations(copy, 0) == synced);
+    CHECK(get_translations(copy, 1) == std::vector<float>(1, 3.0F));
+    CHECK(get_sorted_dirty_slots(copy, 0) == all_slots);
+    copy.clear_dirty();
+
+    source.update(b, make_translation(20.0F));
+    copy.sync_from(source);
+    source.clear_dirty();
+    const auto updated = std::vector<float>{1.0F, 20.0F};
+    CHECK(get_translations(copy, 0) == updated);
+    CHECK(get_sorted_dirty_slots(copy, 0) == std::vector<uint32_t>(1, 1));
+    CHECK(copy.get_dirty_slots(1).empty());
+    copy.clear_dirty();
+
+    // Destroying the last slot dirties nothing, but the copy still shrinks.
+    source.destroy(b);
+    source.destroy(c);
+    copy.sync_from(source);
+    source.clear_dirty();
+    CHECK(get_translations(copy, 0) == std::vector<float>(1, 1.0F));
+    CHECK(get_translations(copy, 1).empty());
+    CHECK(copy.get_dirty_renderables().empty());
+
+    source.update(a, make_translation(10.0F));
+    copy.sync_from(source);
+    CHECK(get_translations(copy, 0) == std::vector<float>(1, 10.0F));
+}
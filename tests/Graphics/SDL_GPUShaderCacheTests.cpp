@@ -0,0 +1,156 @@
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUShaderCache.hpp>
+
+#include <doctest/doctest.h>
+
+using namespace Luminol::Graphics::SDL_GPU;
+
+namespace {
+
+// Not a valid module beyond its magic word - the cache only checks that.
+auto make_test_entry() -> ShaderCacheEntry {
+    return ShaderCacheEntry{
+        .resource_counts =
+            ShaderResourceCounts{
+                .sampler_count = 2,
+                .uniform_buffer_count = 1,
+                .storage_buffer_count = 3,
+            },
+        .spirv = {0x03, 0x02, 0x23, 0x07, 0x00, 0x00, 0x01, 0x00,
+                  0xAA, 0xBB, 0xCC, 0xDD, 0x01, 0x02, 0x03, 0x04},
+    };
+}
+
+auto make_temporary_cache_path(const char* name) -> std::filesystem::path {
+    const auto directory =
+        std::filesystem::temp_directory_path() / "luminol_shader_cache_tests";
+    std::filesystem::create_directories(directory);
+    return directory / name;
+}
+
+}  // namespace
+
+TEST_CASE("shader cache round-trips SPIR-V and resource counts") {
+    const auto cache_path = make_temporary_cache_path("round_trip.lspv");
+    const auto entry = make_test_entry();
+    constexpr auto key = uint64_t{0x1234};
+
+    REQUIRE(write_shader_cache(cache_path, key, entry));
+
+    const auto read = read_shader_cache(cache_path, key);
+    REQUIRE(read.has_value());
+    CHECK(read->resource_counts == entry.resource_counts);
+    CHECK(read->spirv == entry.spirv);
+}
+
+TEST_CASE("shader cache misses on a different key") {
+    const auto cache_path = make_temporary_cache_path("wrong_key.lspv");
+    REQUIRE(write_shader_cache(cache_path, 0x1234, make_test_entry()));
+
+    CHECK_FALSE(read_shader_cache(cache_path, 0x5678).has_value());
+}
+
+TEST_CASE("shader cache misses on a missing file") {
+    CHECK_FALSE(read_shader_cache(
+                    make_temporary_cache_path("does_not_exist.lspv"), 0x1234
+    )
+                    .has_value());
+}
+
+TEST_CASE("shader cache rejects a corrupted SPIR-V byte") {
+    const auto cache_path = make_temporary_cache_path("corrupt.lspv");
+    constexpr auto key = uint64_t{0x1234};
+    REQUIRE(write_shader_cache(cache_path, key, make_test_entry()));
+
+    {
+        auto stream = std::fstream{
+            cache_path, std::ios::in | std::ios::out | std::ios::binary
+        };
+        stream.seekp(-1, std::ios::end);
+        stream.put('\x7F');
+    }
+
+    CHECK_FALSE(read_shader_cache(cache_path, key).has_value());
+}
+
+TEST_CASE("shader cache rejects a truncated entry") {
+    const auto cache_path = make_temporary_cache_path("truncated.lspv");
+    constexpr auto key = uint64_t{0x1234};
+    REQUIRE(write_shader_cache(cache_path, key, make_test_entry()));
+
+    std::filesystem::resize_file(
+        cache_path, std::filesystem::file_size(cache_path) - 4
+    );
+
+    CHECK_FALSE(read_shader_cache(cache_path, key).has_value());
+}
+
+TEST_CASE("shader cache key covers source, entrypoint, stage, defines and "
+          "compiler") {
+    const auto defines = std::vector<ShaderDefine>{{.name = "FOO"}};
+    const auto base = compute_shader_cache_key(
+        "float4 main() : SV_Target { return 1; }",
+        "main",
+        ShaderStage::Fragment,
+        defines,
+        "rev-a"
+    );
+
+    CHECK(
+        base == compute_shader_cache_key(
+                    "float4 main() : SV_Target { return 1; }",
+                    "main",
+                    ShaderStage::Fragment,
+                    defines,
+                    "rev-a"
+                )
+    );
+    CHECK(
+        base != compute_shader_cache_key(
+                    "float4 main() : SV_Target { return 0; }",
+                    "main",
+                    ShaderStage::Fragment,
+                    defines,
+                    "rev-a"
+                )
+    );
+    CHECK(
+        base != compute_shader_cache_key(
+                    "float4 main() : SV_Target { return 1; }",
+                    "other",
+                    ShaderStage::Fragment,
+                    defines,
+                    "rev-a"
+                )
+    );
+    CHECK(
+        base != compute_shader_cache_key(
+                    "float4 main() : SV_Target { return 1; }",
+                    "main",
+                    ShaderStage::Vertex,
+                    defines,
+                    "rev-a"
+                )
+    );
+    CHECK(
+        base != compute_shader_cache_key(
+                    "float4 main() : SV_Target { return 1; }",
+                    "main",
+                    ShaderStage::Fragment,
+                    {},
+                    "rev-a"
+                )
+    );
+    CHECK(
+        base != compute_shader_cache_key(
+                    "float4 main() : SV_Target { return 1; }",
+                    "main",
+                    ShaderStage::Fragment,
+                    defines,
+                    "rev-b"
+                )
+    );
+}
@@ -0,0 +1,34 @@
+#include <vector>
+
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUShader.hpp>
+
+#include <doctest/doctest.h>
+
+using namespace Luminol::Graphics::SDL_GPU;
+
+// These names are the contract with cmake/CompileShaders.cmake, which writes
+// the files - a mismatch only shows up as a missing file at runtime.
+
+TEST_CASE("precompiled SPIR-V lives in a spirv folder next to the HLSL") {
+    const auto path = get_precompiled_spirv_path(
+        "res/shaders/sdl_gpu/tonemap_frag.hlsl", {}
+    );
+
+    CHECK(path == "res/shaders/sdl_gpu/spirv/tonemap_frag.spv");
+}
+
+TEST_CASE("precompiled SPIR-V name has one suffix per define, in order") {
+    const auto defines = std::vector<ShaderDefine>{
+        {.name = "COMPACT_VERTICES"},
+        {.name = "LIGHT_COUNT", .value = "4"},
+    };
+
+    const auto path = get_precompiled_spirv_path(
+        "res/shaders/sdl_gpu/pbr_vert.hlsl", defines
+    );
+
+    CHECK(
+        path ==
+        "res/shaders/sdl_gpu/spirv/pbr_vert.COMPACT_VERTICES.LIGHT_COUNT=4.spv"
+    );
+}
@@ -190,6 +190,14 @@ TEST_CASE("to_sdl_vertex_element_format maps all formats") {
         to_sdl_vertex_element_format(VertexElementFormat::Float4) ==
         SDL_GPU_VERTEXELEMENTFORMAT_FLOAT4
     );
+    CHECK(
+        to_sdl_vertex_element_format(VertexElementFormat::Half2) ==
+        SDL_GPU_VERTEXELEMENTFORMAT_HALF2
+    );
+    CHECK(
+        to_sdl_vertex_element_format(VertexElementFormat::Short4Norm) ==
+        SDL_GPU_VERTEXELEMENTFORMAT_SHORT4_NORM
+    );
 }
 
 TEST_CASE("to_sdl_vertex_input_rate maps both rates") {
@@ -0,0 +1,101 @@
+#include <cmath>
+#include <vector>
+
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUVertexFormat.hpp>
+
+#include <doctest/doctest.h>
+
+using namespace Luminol::Graphics::SDL_GPU;
+
+namespace {
+
+// position3, uv2, normal3, tangent3 - the full_vertex_stride_in_floats
+// layout every loader produces.
+auto make_test_vertices() -> std::vector<float> {
+    const auto inv_sqrt3 = 1.0F / std::sqrt(3.0F);
+    const auto inv_sqrt2 = 1.0F / std::sqrt(2.0F);
+    // clang-format off
+    return {
+        -10.0F, 0.0F, 5.0F,  0.25F, 1.5F,    0.0F, 0.0F, -1.0F,
+            1.0F, 0.0F, 0.0F,
+        10.0F, 2.0F, -5.0F,  0.999F, -3.0F,  inv_sqrt3, inv_sqrt3, inv_sqrt3,
+            0.0F, inv_sqrt2, -inv_sqrt2,
+        3.0F, 1.0F, 0.0F,    512.0F, 0.0F,   0.0F, 1.0F, 0.0F,
+            -1.0F, 0.0F, 0.0F,
+    };
+    // clang-format on
+}
+
+}  // namespace
+
+TEST_CASE("compact vertices decode back within quantization tolerance") {
+    const auto vertices = make_test_vertices();
+    const auto compact = encode_compact_vertices(vertices);
+
+    REQUIRE(
+        compact.vertices.size() ==
+        vertices.size() / full_vertex_stride_in_floats
+    );
+
+    for (auto i = std::size_t{0}; i < compact.vertices.size(); ++i) {
+        CAPTURE(i);
+        const auto decoded =
+            decode_compact_vertex(compact.vertices[i], compact.dequantization);
+        const auto* expected = &vertices[i * full_vertex_stride_in_floats];
+
+        // Positions: half a snorm16 step of the bounding box's largest
+        // half-extent (10, on x).
+        for (auto axis = std::size_t{0}; axis < 3; ++axis) {
+            CHECK(std::abs(decoded[axis] - expected[axis]) <= 10.0F / 32767.0F);
+        }
+        // UVs: half floats, 11 significant bits.
+        for (auto component = std::size_t{3}; component < 5; ++component) {
+            CHECK(
+                std::abs(decoded[component] - expected[component]) <=
+                std::abs(expected[component]) / 2048.0F
+            );
+        }
+        // Unit vectors: well under 0.01 degrees off.
+        for (auto component = std::size_t{5}; component < 11; ++component) {
+            CHECK(std::abs(decoded[component] - expected[component]) <= 1e-4F);
+        }
+    }
+}
+
+TEST_CASE("compact vertices hit the bounding box corners exactly") {
+    const auto vertices = make_test_vertices();
+    const auto compact = encode_compact_vertices(vertices);
+
+    CHECK(compact.vertices[0].position[0] == -32767);
+    CHECK(compact.vertices[1].position[0] == 32767);
+    CHECK(compact.dequantization.position_offset[0] == doctest::Approx(0.0F));
+    CHECK(compact.dequantization.position_scale[0] == doctest::Approx(10.0F));
+}
+
+TEST_CASE("compact vertices tolerate a flat axis") {
+    auto vertices = make_test_vertices();
+    for (auto i = std::size_t{0}; i < vertices.size();
+         i += full_vertex_stride_in_floats) {
+        vertices[i + 1] = 7.0F;
+    }
+
+    const auto compact = encode_compact_vertices(vertices);
+    const auto decoded =
+        decode_compact_vertex(compact.vertices[2], compact.dequantization);
+
+    CHECK(std::isfinite(decoded[1]));
+    CHECK(decoded[1] == doctest::Approx(7.0F));
+}
+
+TEST_CASE("vertex format layouts match their vertex structs") {
+    CHECK(get_vertex_stride_in_bytes(VertexFormat::Full) == 44);
+    CHECK(get_vertex_stride_in_bytes(VertexFormat::Compact) == 20);
+    CHECK(
+        get_mesh_vertex_buffer_descriptions(VertexFormat::Compact)[0].pitch ==
+        sizeof(CompactVertex)
+    );
+    CHECK(get_mesh_vertex_attributes(VertexFormat::Full).size() == 4);
+    CHECK(get_mesh_vertex_attributes(VertexFormat::Compact).size() == 3);
+    CHECK(get_vertex_format_shader_defines(VertexFormat::Full).empty());
+    CHECK(get_vertex_format_shader_defines(VertexFormat::Compact).size() == 1);
+}
@@ -19,6 +19,8 @@
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUCommandBuffer.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/RenderPasses/SDL_GPUCopyPass.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUDevice.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUFramePacer.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUStagingRing.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUTransferBuffer.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUTypes.hpp>
 #include <LuminolRenderEngine/Window/Window.hpp>
@@ -147,7 +149,7 @@ struct GpuClusterLightGrid {
     uint32_t offset;
     uint32_t point_count;
     uint32_t spot_count;
-    uint32_t padding;
+    uint32_t importance_cutoff;
 };
 
 }  // namespace
@@ -171,9 +173,12 @@ auto main() -> int {
     );
 
     auto cluster_pass = SDL_GPUClusterPass{*gpu_device};
+    auto frame_pacer = FramePacer{gpu_device};
+    auto staging_ring = StagingRing{gpu_device, frame_pacer};
 
     auto light_data = Graphics::Light{};
     light_data.point_light_count = static_cast<uint32_t>(test_point_lights.size());
+    light_data.point_lights.resize(test_point_lights.size());
     for (auto i = size_t{0}; i < test_point_lights.size(); ++i) {
         light_data.point_lights[i] = Graphics::AlignedPointLight{
             .position =
@@ -191,8 +196,10 @@ auto main() -> int {
                     1.0F,
                 },
         };
+        light_data.changed_point_lights.push_back(static_cast<uint32_t>(i));
     }
     light_data.spot_light_count = static_cast<uint32_t>(test_spot_lights.size());
+    light_data.spot_lights.resize(test_spot_lights.size());
     for (auto i = size_t{0}; i < test_spot_lights.size(); ++i) {
         light_data.spot_lights[i] = Graphics::AlignedSpotLight{
             .position =
@@ -212,6 +219,7 @@ auto main() -> int {
             .cut_off = 0.9F,
             .outer_cut_off = 0.8F,
         };
+        light_data.changed_spot_lights.push_back(static_cast<uint32_t>(i));
     }
 
     const auto view_matrix = Transform::left_handed_look_at_matrix(
@@ -226,7 +234,10 @@ auto main() -> int {
     cluster_pass.build_cluster_grid(
         command_buffer, vertical_fov_degrees, aspect_ratio, near_plane, far_plane
     );
-    cluster_pass.cull_lights(command_buffer, light_data, view_matrix);
+    cluster_pass.cull_lights(
+        *gpu_device, frame_pacer, command_buffer, staging_ring, light_data,
+        view_matrix
+    );
 
     const auto& cluster_light_grid_buffer = cluster_pass.get_cluster_light_grid_buffer();
     const auto& global_light_index_list_buffer =
@@ -258,7 +269,9 @@ auto main() -> int {
             global_light_index_list_buffer.get_size()
         );
     }
-    command_buffer.submit();
+    const auto frame = frame_pacer.submit(command_buffer);
+    staging_ring.end_frame(frame);
+    cluster_pass.end_frame(frame);
     gpu_device->wait_for_idle();
 
     const auto grid_mapped = grid_download_buffer.map(false);
@@ -267,8 +280,9 @@ auto main() -> int {
     grid_download_buffer.unmap();
 
     const auto index_mapped = index_download_buffer.map(false);
-    auto index_results =
-        std::vector<uint32_t>(global_light_index_capacity);
+    auto index_results = std::vector<uint32_t>(
+        global_light_index_list_buffer.get_size() / sizeof(uint32_t)
+    );
     std::memcpy(index_results.data(), index_mapped.data(), index_mapped.size());
     index_download_buffer.unmap();
 
@@ -5,12 +5,15 @@
 
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUCommandBuffer.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUDevice.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUFramePacer.hpp>
 #include <LuminolRenderEngine/Window/Window.hpp>
 
-// Validates that the GPU debug-group/label annotations and the fence-based
-// submit/wait/release path (added for opt-in GPU performance profiling) run
-// without crashing or logging an SDL error. This does not (and cannot,
-// without a native-backend interop SDL_GPU doesn't expose) verify actual GPU
+// Validates that the GPU debug-group/label annotations, the fence-based
+// submit/wait/release path (added for opt-in GPU performance profiling) and
+// FramePacer's frame tracking run without crashing or logging an SDL error,
+// and that FramePacer never lets more frames than requested stay in flight.
+// This does not (and cannot, without a native-backend interop SDL_GPU
+// doesn't expose) verify actual GPU
 // timing values - see the doc comments on CommandBuffer::submit_and_acquire_fence
 // and PerformanceLogger::log_and_reset for why.
 
@@ -48,6 +51,47 @@ auto main() -> int {
     gpu_device->wait_for_fence(nullptr);
     gpu_device->release_fence(nullptr);
 
+    auto success = true;
+    {
+        auto frame_pacer = FramePacer{gpu_device};
+
+        for (auto frames_in_flight = FramePacer::min_frames_in_flight;
+             frames_in_flight <= FramePacer::max_frames_in_flight;
+             ++frames_in_flight) {
+            for (auto i = 0; i < 4; ++i) {
+                frame_pacer.begin_frame(frames_in_flight);
+
+                auto command_buffer = gpu_device->create_command_buffer();
+                (void)frame_pacer.submit(command_buffer);
+
+                const auto stats = frame_pacer.get_last_frame_stats();
+                if (stats.frames_in_flight >= frames_in_flight) {
+                    std::printf(
+                        "GPU profiling smoke test FAILED: %u frames in "
+                        "flight with a limit of %u\n",
+                        stats.frames_in_flight, frames_in_flight
+                    );
+                    success = false;
+                }
+            }
+        }
+
+        const auto last_frame = frame_pacer.get_last_submitted_frame();
+        frame_pacer.wait_for_frame(last_frame);
+        if (!frame_pacer.is_frame_complete(last_frame)) {
+            std::printf(
+                "GPU profiling smoke test FAILED: frame %llu not complete "
+                "after waiting for it\n",
+                static_cast<unsigned long long>(last_frame)
+            );
+            success = false;
+        }
+    }
+
+    if (!success) {
+        return 1;
+    }
+
     std::printf("GPU profiling smoke test PASSED\n");
     return 0;
 }
@@ -20,11 +20,13 @@
 #include <LuminolRenderEngine/Graphics/SDL_GPU/Culling/SDL_GPUCullingUtils.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUDevice.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUFactory.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUFramePacer.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUInstanceBatch.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUInstanceBufferCache.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/Culling/SDL_GPUInstanceCullPass.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUMesh.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPURenderer.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUStagingRing.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUTexture.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUTransferBuffer.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUTypes.hpp>
@@ -146,19 +148,25 @@ auto main() -> int {
     const auto frustum_planes = extract_frustum_planes(view_projection);
 
     auto instance_buffer_cache = SDL_GPUInstanceBufferCache{};
+    auto frame_pacer = FramePacer{gpu_device};
+    auto staging_ring = StagingRing{gpu_device, frame_pacer};
 
     auto command_buffer = gpu_device->create_command_buffer();
     {
         auto copy_pass = command_buffer.begin_copy_pass();
         instance_buffer_cache.upload(
-            *gpu_device, copy_pass, renderable_id, gsl::span{model_matrices}
+            *gpu_device, copy_pass, staging_ring, renderable_id,
+            gsl::span{model_matrices}
         );
     }
 
     const auto instance_batches = std::array<InstanceBatch, 1>{
         InstanceBatch{
             .renderable_id = renderable_id,
-            .instance_count = static_cast<uint32_t>(model_matrices.size())
+            .instance_count = static_cast<uint32_t>(model_matrices.size()),
+            .first_instance = instance_buffer_cache.get_first_instance(
+                renderable_id
+            ),
         }
     };
 
@@ -180,6 +188,7 @@ auto main() -> int {
     const auto layout = instance_cull_pass.cull(
         *factory,
         command_buffer,
+        staging_ring,
         instance_buffer_cache,
         gsl::span{instance_batches},
         frustum_planes,
@@ -225,7 +234,7 @@ auto main() -> int {
             max_visible_indices_size
         );
     }
-    command_buffer.submit();
+    staging_ring.end_frame(frame_pacer.submit(command_buffer));
     gpu_device->wait_for_idle();
 
     auto indirect_command = IndirectDrawCommand{};
@@ -20,11 +20,13 @@
 #include <LuminolRenderEngine/Graphics/SDL_GPU/Culling/SDL_GPUCullingUtils.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUDevice.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUFactory.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUFramePacer.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUInstanceBatch.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUInstanceBufferCache.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/Culling/SDL_GPUInstanceCullPass.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUMesh.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPURenderer.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUStagingRing.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUTexture.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUTransferBuffer.hpp>
 #include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUTypes.hpp>
@@ -134,6 +136,8 @@ struct DownloadedLod {
 auto download_lods(
     GPUDevice& gpu_device,
     CommandBuffer& command_buffer,
+    FramePacer& frame_pacer,
+    StagingRing& staging_ring,
     const SDL_GPUInstanceCullPass& instance_cull_pass,
     const SubmeshCullInfo& submesh_info,
     uint32_t instance_count
@@ -180,7 +184,7 @@ auto download_lods(
             );
         }
     }
-    command_buffer.submit();
+    staging_ring.end_frame(frame_pacer.submit(command_buffer));
     gpu_device.wait_for_idle();
 
     auto results = std::array<DownloadedLod, max_lod_levels>{};
@@ -261,20 +265,26 @@ auto main() -> int {
     const auto frustum_planes = extract_frustum_planes(view_projection);
 
     auto instance_buffer_cache = SDL_GPUInstanceBufferCache{};
+    auto frame_pacer = FramePacer{gpu_device};
+    auto staging_ring = StagingRing{gpu_device, frame_pacer};
     {
         auto upload_command_buffer = gpu_device->create_command_buffer();
         auto copy_pass = upload_command_buffer.begin_copy_pass();
         instance_buffer_cache.upload(
-            *gpu_device, copy_pass, renderable_id, gsl::span{model_matrices}
+            *gpu_device, copy_pass, staging_ring, renderable_id,
+            gsl::span{model_matrices}
         );
-        upload_command_buffer.submit();
+        staging_ring.end_frame(frame_pacer.submit(upload_command_buffer));
         gpu_device->wait_for_idle();
     }
 
     const auto instance_batches = std::array<InstanceBatch, 1>{
         InstanceBatch{
             .renderable_id = renderable_id,
-            .instance_count = static_cast<uint32_t>(model_matrices.size())
+            .instance_count = static_cast<uint32_t>(model_matrices.size()),
+            .first_instance = instance_buffer_cache.get_first_instance(
+                renderable_id
+            ),
         }
     };
 
@@ -329,6 +339,7 @@ auto main() -> int {
         const auto layout = instance_cull_pass.cull(
             *factory,
             command_buffer,
+            staging_ring,
             instance_buffer_cache,
             gsl::span{instance_batches},
             frustum_planes,
@@ -342,7 +353,8 @@ auto main() -> int {
         const auto& submesh_info = layout.at(0).at(0);
 
         const auto downloaded = download_lods(
-            *gpu_device, command_buffer, instance_cull_pass, submesh_info,
+            *gpu_device, command_buffer, frame_pacer, staging_ring,
+            instance_cull_pass, submesh_info,
             static_cast<uint32_t>(model_matrices.size())
         );
 
@@ -372,6 +384,7 @@ auto main() -> int {
         const auto layout = instance_cull_pass.cull(
             *factory,
             command_buffer,
+            staging_ring,
             instance_buffer_cache,
             gsl::span{instance_batches},
             frustum_planes,
@@ -385,7 +398,8 @@ auto main() -> int {
         const auto& submesh_info = layout.at(0).at(0);
 
         const auto downloaded = download_lods(
-            *gpu_device, command_buffer, instance_cull_pass, submesh_info,
+            *gpu_device, command_buffer, frame_pacer, staging_ring,
+            instance_cull_pass, submesh_info,
             static_cast<uint32_t>(model_matrices.size())
         );
 
@@ -0,0 +1,329 @@
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <numbers>
+#include <vector>
+
+#include <SDL3/SDL_video.h>
+
+#include <LuminolMaths/Matrix.hpp>
+#include <LuminolMaths/Transform.hpp>
+#include <LuminolMaths/Vector.hpp>
+
+#include <LuminolRenderEngine/Graphics/Light.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUBuffer.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/Lighting/SDL_GPUClusterPass.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/Lighting/SDL_GPUZBinPass.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUCommandBuffer.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/RenderPasses/SDL_GPUCopyPass.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUDevice.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUFramePacer.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUStagingRing.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUTransferBuffer.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUTypes.hpp>
+#include <LuminolRenderEngine/Window/Window.hpp>
+
+// Validates SDL_GPUClusterPass::cull_lights in LightCullingMode::ZBinned
+// (SDL_GPUZBinPass's sort -> tile cull -> z bin) with enough lights that the
+// bitonic sort spans several blocks, so light_sort_global.hlsl runs too.
+// Reads the three buffers back and checks, in plain C++:
+//   - the sorted lights are every light exactly once, in view depth order,
+//     followed by padding;
+//   - each light's sorted slot lies within the z bin of its center's depth
+//     (mirroring light_z_bin.hlsl's bin math);
+//   - each light's bit is set in the tile its center projects into - a
+//     sphere centered in a tile always touches it.
+// The tile/bin edges themselves aren't compared, since float rounding there
+// can differ between the CPU and GPU.
+
+namespace {
+
+using namespace Luminol::Graphics::SDL_GPU;
+using namespace Luminol::Maths;
+
+constexpr auto vertical_fov_degrees = 45.0F;
+constexpr auto aspect_ratio = 16.0F / 9.0F;
+constexpr auto near_plane = 0.1F;
+constexpr auto far_plane = 100.0F;
+
+// 2600 lights sort as 4096 slots - two global steps.
+constexpr auto point_light_count = uint32_t{1800};
+constexpr auto spot_light_count = uint32_t{800};
+
+constexpr auto spot_light_flag = uint32_t{0x80000000};
+constexpr auto padding_key = uint32_t{0xFFFFFFFF};
+
+struct SortedLight {
+    uint32_t key;
+    uint32_t light;
+};
+
+struct TestLight {
+    float x;
+    float y;
+    float z;
+    float intensity;
+};
+
+// Deterministic, so a failure reproduces.
+class Random {
+public:
+    auto next_float(float min, float max) -> float {
+        state = (state * 1664525U) + 1013904223U;
+        const auto unit =
+            static_cast<float>(state >> 8U) / static_cast<float>(1U << 24U);
+        return min + ((max - min) * unit);
+    }
+
+private:
+    uint32_t state = 12345U;
+};
+
+// Lights in front of the camera (at the origin, looking down +z), most of
+// them on screen.
+auto make_test_lights(Random& random, uint32_t count)
+    -> std::vector<TestLight> {
+    auto lights = std::vector<TestLight>{};
+    lights.reserve(count);
+    for (auto i = uint32_t{0}; i < count; ++i) {
+        const auto z = random.next_float(1.0F, 90.0F);
+        lights.push_back(TestLight{
+            .x = random.next_float(-z, z),
+            .y = random.next_float(-0.5F * z, 0.5F * z),
+            .z = z,
+            .intensity = random.next_float(0.05F, 1.0F),
+        });
+    }
+    return lights;
+}
+
+// Must match depth_key in light_sort_local.hlsl.
+auto depth_key(float depth) -> uint32_t {
+    const auto bits = std::bit_cast<uint32_t>(depth);
+    return (bits & 0x80000000U) != 0 ? ~bits : bits | 0x80000000U;
+}
+
+// Must match z_bin in light_z_bin.hlsl.
+auto z_bin(float z_view) -> uint32_t {
+    const auto slice =
+        std::log(z_view / near_plane) / std::log(far_plane / near_plane);
+    return std::min(
+        static_cast<uint32_t>(
+            std::max(slice, 0.0F) * static_cast<float>(light_z_bin_count)
+        ),
+        light_z_bin_count - 1
+    );
+}
+
+// The tile light's center projects into, or light_tile_count if it's off
+// screen. Row 0 is the bottom row, as in light_tile_cull.hlsl.
+auto center_tile(const TestLight& light, float tan_half_fov_y) -> uint32_t {
+    const auto ndc_x = light.x / (light.z * aspect_ratio * tan_half_fov_y);
+    const auto ndc_y = light.y / (light.z * tan_half_fov_y);
+    if (std::abs(ndc_x) >= 1.0F || std::abs(ndc_y) >= 1.0F) {
+        return light_tile_count;
+    }
+    const auto tile_x = static_cast<uint32_t>(
+        (ndc_x + 1.0F) * 0.5F * static_cast<float>(light_tile_grid_x)
+    );
+    const auto tile_y = static_cast<uint32_t>(
+        (ndc_y + 1.0F) * 0.5F * static_cast<float>(light_tile_grid_y)
+    );
+    return (tile_y * light_tile_grid_x) + tile_x;
+}
+
+auto download(
+    GPUDevice& device, CommandBuffer& command_buffer, const Buffer& buffer
+) -> TransferBuffer {
+    auto transfer_buffer = device.create_transfer_buffer(TransferBufferInfo{
+        .usage = TransferBufferUsage::Download,
+        .size = buffer.get_size(),
+    });
+    auto copy_pass = command_buffer.begin_copy_pass();
+    copy_pass.download_from_buffer(
+        buffer, 0, transfer_buffer, 0, buffer.get_size()
+    );
+    return transfer_buffer;
+}
+
+template <typename T>
+auto read_back(TransferBuffer& transfer_buffer) -> std::vector<T> {
+    const auto mapped = transfer_buffer.map(false);
+    auto results = std::vector<T>(mapped.size() / sizeof(T));
+    std::memcpy(results.data(), mapped.data(), results.size() * sizeof(T));
+    transfer_buffer.unmap();
+    return results;
+}
+
+}  // namespace
+
+auto main() -> int {
+    using namespace Luminol;
+
+    auto random = Random{};
+    const auto test_point_lights = make_test_lights(random, point_light_count);
+    const auto test_spot_lights = make_test_lights(random, spot_light_count);
+
+    auto window = Window{1, 1, "Luminol Z-Bin Light Cull Smoke Test"};
+    auto gpu_device = std::make_shared<GPUDevice>(
+        static_cast<SDL_Window*>(window.get_window_handle())
+    );
+
+    auto cluster_pass = SDL_GPUClusterPass{*gpu_device};
+    cluster_pass.set_culling_mode(LightCullingMode::ZBinned);
+    auto frame_pacer = FramePacer{gpu_device};
+    auto staging_ring = StagingRing{gpu_device, frame_pacer};
+
+    auto light_data = Graphics::Light{};
+    light_data.point_light_count = point_light_count;
+    light_data.point_lights.resize(point_light_count);
+    for (auto i = uint32_t{0}; i < point_light_count; ++i) {
+        const auto& light = test_point_lights[i];
+        light_data.point_lights[i] = Graphics::AlignedPointLight{
+            .position = Vector4f{light.x, light.y, light.z, 1.0F},
+            .color = Vector4f{
+                light.intensity, light.intensity, light.intensity, 1.0F
+            },
+        };
+        light_data.changed_point_lights.push_back(i);
+    }
+    light_data.spot_light_count = spot_light_count;
+    light_data.spot_lights.resize(spot_light_count);
+    for (auto i = uint32_t{0}; i < spot_light_count; ++i) {
+        const auto& light = test_spot_lights[i];
+        light_data.spot_lights[i] = Graphics::AlignedSpotLight{
+            .position = Vector4f{light.x, light.y, light.z, 1.0F},
+            .direction = Vector4f{0.0F, 0.0F, 1.0F, 0.0F},
+            .color =
+                Vector3f{light.intensity, light.intensity, light.intensity},
+            .cut_off = 0.9F,
+            .outer_cut_off = 0.8F,
+        };
+        light_data.changed_spot_lights.push_back(i);
+    }
+
+    const auto view_matrix = Transform::left_handed_look_at_matrix(
+        Transform::LookAtParams<float>{
+            .eye = {0.0F, 0.0F, 0.0F},
+            .target = {0.0F, 0.0F, 1.0F},
+            .up_vector = {0.0F, 1.0F, 0.0F},
+        }
+    );
+
+    auto command_buffer = gpu_device->create_command_buffer();
+    cluster_pass.build_cluster_grid(
+        command_buffer, vertical_fov_degrees, aspect_ratio, near_plane,
+        far_plane
+    );
+    cluster_pass.cull_lights(
+        *gpu_device, frame_pacer, command_buffer, staging_ring, light_data,
+        view_matrix
+    );
+
+    const auto& z_bin_pass = cluster_pass.get_z_bin_pass();
+    auto sorted_download = download(
+        *gpu_device, command_buffer, z_bin_pass.get_depth_sorted_light_buffer()
+    );
+    auto bin_download = download(
+        *gpu_device, command_buffer, z_bin_pass.get_light_z_bin_buffer()
+    );
+    auto mask_download = download(
+        *gpu_device, command_buffer, z_bin_pass.get_light_tile_mask_buffer()
+    );
+    const auto frame = frame_pacer.submit(command_buffer);
+    staging_ring.end_frame(frame);
+    cluster_pass.end_frame(frame);
+    gpu_device->wait_for_idle();
+
+    const auto sorted_lights = read_back<SortedLight>(sorted_download);
+    const auto z_bins = read_back<uint32_t>(bin_download);
+    const auto tile_masks = read_back<uint32_t>(mask_download);
+    const auto word_count = z_bin_pass.get_tile_mask_word_count();
+
+    const auto light_count = point_light_count + spot_light_count;
+    const auto tan_half_fov_y = std::tan(
+        vertical_fov_degrees * (std::numbers::pi_v<float> / 180.0F) / 2.0F
+    );
+
+    auto failure_count = uint32_t{0};
+    const auto fail = [&](const char* check, uint32_t slot) {
+        if (failure_count < 10) {
+            std::printf(
+                "Z-bin light cull smoke test FAILED: %s at sorted slot %u\n",
+                check,
+                slot
+            );
+        }
+        ++failure_count;
+    };
+
+    if (word_count != (light_count + 31) / 32) {
+        fail("wrong tile mask word count", 0);
+    }
+
+    auto seen_point_lights = std::vector<bool>(point_light_count, false);
+    auto seen_spot_lights = std::vector<bool>(spot_light_count, false);
+
+    for (auto slot = uint32_t{0}; slot < sorted_lights.size(); ++slot) {
+        const auto entry = sorted_lights[slot];
+        if (slot >= light_count) {
+            if (entry.key != padding_key) {
+                fail("light sorted after the padding", slot);
+            }
+            continue;
+        }
+
+        if (slot > 0 && sorted_lights[slot - 1].key > entry.key) {
+            fail("out of depth order", slot);
+        }
+
+        const auto is_spot = (entry.light & spot_light_flag) != 0;
+        const auto index = entry.light & ~spot_light_flag;
+        auto& seen = is_spot ? seen_spot_lights : seen_point_lights;
+        if (index >= seen.size() || seen[index]) {
+            fail("unknown or repeated light", slot);
+            continue;
+        }
+        seen[index] = true;
+
+        const auto& light =
+            is_spot ? test_spot_lights[index] : test_point_lights[index];
+        if (entry.key != depth_key(light.z)) {
+            fail("key doesn't match the light's depth", slot);
+        }
+
+        const auto bin = z_bin(light.z);
+        if (z_bins[bin * 2] > slot || z_bins[(bin * 2) + 1] < slot) {
+            fail("missing from its center's z bin", slot);
+        }
+
+        const auto tile = center_tile(light, tan_half_fov_y);
+        if (tile < light_tile_count) {
+            const auto word = tile_masks[(tile * word_count) + (slot / 32)];
+            if ((word & (1U << (slot % 32))) == 0) {
+                fail("missing from its center's tile mask", slot);
+            }
+        }
+    }
+
+    if (failure_count == 0) {
+        std::printf(
+            "Z-bin light cull smoke test PASSED (%u point + %u spot lights, "
+            "%zu sorted slots)\n",
+            point_light_count,
+            spot_light_count,
+            sorted_lights.size()
+        );
+    } else {
+        std::printf(
+            "Z-bin light cull smoke test FAILED: %u checks failed\n",
+            failure_count
+        );
+    }
+
+    return failure_count == 0 ? 0 : 1;
+}
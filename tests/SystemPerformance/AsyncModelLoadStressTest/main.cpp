@@ -0,0 +1,133 @@
+#include <cstdio>
+#include <filesystem>
+#include <system_error>
+
+#include <LuminolMaths/Transform.hpp>
+#include <LuminolRenderEngine/Graphics/Camera.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUMeshCache.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPURenderer.hpp>
+#include <LuminolRenderEngine/LuminolRenderEngine.hpp>
+#include <LuminolRenderEngine/Utilities/Timer.hpp>
+
+// Frame-hitch test for Renderer::create_renderable_async: starts a cold
+// (mesh cache wiped) Sponza load in the background while rendering a proxy
+// cube every frame, and keeps rendering until the load callback fires. A
+// synchronous create_renderable would stall one frame for the whole load
+// (seconds); here the worst frame should only pay for the final GPU upload,
+// and every frame before that should look like an ordinary cube frame.
+//
+// Fails if the load doesn't complete, if the callback doesn't fire exactly
+// once, or if the worst frame while loading exceeds max_worst_frame_time_ms.
+//
+// THRESHOLD CALIBRATION: max_worst_frame_time_ms below is a deliberately
+// generous placeholder, not a measured baseline (this test can't be run in
+// the environment that wrote it). Run this once, note the printed actual
+// worst frame, and tighten the threshold to ~2x that real number.
+
+namespace {
+
+constexpr auto model_path = "res/models/Sponza/glTF/Sponza.gltf";
+
+constexpr auto max_load_seconds = 120.0;
+constexpr auto max_worst_frame_time_ms = 500.0;
+
+}  // namespace
+
+auto main() -> int {
+    using namespace Luminol;
+    using namespace Luminol::Graphics;
+
+    auto error = std::error_code{};
+    std::filesystem::remove_all(SDL_GPU::get_mesh_cache_directory(), error);
+
+    auto luminol_engine = RenderEngine(Properties{
+        .title = "Luminol Async Model Load Stress Test",
+    });
+
+    auto& renderer = luminol_engine.get_renderer();
+
+    auto camera = Camera{CameraProperties{
+        .position = Maths::Vector3f{0.0F, 1.0F, -5.0F},
+        .forward = Maths::Vector3f{0.0F, 0.0F, 1.0F},
+    }};
+    camera.set_aspect_ratio(
+        static_cast<float>(luminol_engine.get_window().get_width()) /
+        static_cast<float>(luminol_engine.get_window().get_height())
+    );
+
+    const auto proxy_id =
+        renderer.create_renderable("res/models/cube/cube.obj");
+
+    auto callback_count = 0;
+    auto final_state = RenderableLoadState::Loading;
+
+    auto load_timer = Utilities::Timer{};
+    const auto model_id = renderer.create_renderable_async(
+        model_path,
+        proxy_id,
+        [&](RenderableId, RenderableLoadState state) {
+            ++callback_count;
+            final_state = state;
+        }
+    );
+    const auto create_call_ms = load_timer.elapsed_seconds() * 1000.0;
+
+    const auto model_matrix =
+        Maths::Transform::scale_4x4(Maths::Vector3f{0.01F, 0.01F, 0.01F});
+
+    auto frame_count = 0;
+    auto worst_frame_time_seconds = 0.0;
+    while (callback_count == 0 &&
+           load_timer.elapsed_seconds() < max_load_seconds) {
+        auto frame_timer = Utilities::Timer{};
+        renderer.set_view_matrix(camera.get_view_matrix());
+        renderer.set_projection_matrix(camera.get_projection_matrix());
+        renderer.queue_draw(model_id, model_matrix);
+        renderer.draw();
+
+        const auto frame_time_seconds = frame_timer.elapsed_seconds();
+        if (frame_time_seconds > worst_frame_time_seconds) {
+            worst_frame_time_seconds = frame_time_seconds;
+        }
+        ++frame_count;
+    }
+    const auto load_seconds = load_timer.elapsed_seconds();
+    const auto worst_frame_time_ms = worst_frame_time_seconds * 1000.0;
+
+    std::printf(
+        "AsyncModelLoad stress test: %s - create_renderable_async returned "
+        "in %.3f ms, loaded in %.3f s over %d frames, worst frame %.3f ms\n",
+        model_path,
+        create_call_ms,
+        load_seconds,
+        frame_count,
+        worst_frame_time_ms
+    );
+
+    const auto loaded = callback_count == 1 &&
+                        final_state == RenderableLoadState::Resident &&
+                        renderer.get_load_state(model_id) ==
+                            RenderableLoadState::Resident;
+    const auto success =
+        loaded && worst_frame_time_ms <= max_worst_frame_time_ms;
+    if (!loaded) {
+        std::printf(
+            "AsyncModelLoad stress test FAILED: load did not complete "
+            "(callback fired %d times)\n",
+            callback_count
+        );
+    } else if (!success) {
+        std::printf(
+            "AsyncModelLoad stress test FAILED: worst frame %.3f ms exceeds "
+            "threshold %.3f ms\n",
+            worst_frame_time_ms,
+            max_worst_frame_time_ms
+        );
+    } else {
+        std::printf("AsyncModelLoad stress test PASSED\n");
+    }
+
+    renderer.remove_renderable(model_id);
+
+    return success ? 0 : 1;
+}
@@ -0,0 +1,139 @@
+#include <cstdio>
+#include <vector>
+
+#include <LuminolMaths/Transform.hpp>
+#include <LuminolRenderEngine/Graphics/Camera.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPURenderer.hpp>
+#include <LuminolRenderEngine/LuminolRenderEngine.hpp>
+#include <LuminolRenderEngine/Utilities/Timer.hpp>
+
+// Headless stress test comparing the two vertex buffer layouts
+// (Properties::use_compact_vertex_format, see SDL_GPU::VertexFormat): renders
+// the same geometry-heavy scene - a grid of Sponza instances, so vertex fetch
+// in the depth pre-pass, shadow cascades, occlusion depth and AO normal
+// passes adds up - once with full-precision 44-byte vertices and once with
+// 20-byte compact ones, each in its own freshly created engine.
+//
+// Fails if the compact layout is more than max_compact_slowdown slower than
+// the full one: the decode is a handful of ALU ops per vertex, so it should
+// never cost more than the bandwidth it saves.
+//
+// THRESHOLD CALIBRATION: max_compact_slowdown below is a deliberately
+// generous placeholder, not a measured baseline (this test can't be run in
+// the environment that wrote it). Run this once, note the printed actual
+// ratio, and tighten the threshold to just above that real number.
+
+namespace {
+
+using namespace Luminol;
+using namespace Luminol::Graphics;
+
+constexpr auto model_path = "res/models/Sponza/glTF/Sponza.gltf";
+
+constexpr auto grid_size = 4;
+constexpr auto grid_spacing = 40.0F;
+
+constexpr auto warmup_frames = 30;
+constexpr auto measured_frames = 120;
+
+constexpr auto max_compact_slowdown = 1.1;
+
+auto make_grid_model_matrices() -> std::vector<Maths::Matrix4x4f> {
+    auto model_matrices = std::vector<Maths::Matrix4x4f>{};
+    model_matrices.reserve(
+        static_cast<size_t>(grid_size) * static_cast<size_t>(grid_size)
+    );
+
+    for (auto grid_x = 0; grid_x < grid_size; ++grid_x) {
+        for (auto grid_z = 0; grid_z < grid_size; ++grid_z) {
+            const auto position = Maths::Vector3f{
+                static_cast<float>(grid_x) * grid_spacing,
+                0.0F,
+                static_cast<float>(grid_z) * grid_spacing,
+            };
+            model_matrices.push_back(
+                Maths::Transform::translate_4x4(position)
+            );
+        }
+    }
+
+    return model_matrices;
+}
+
+auto measure_average_frame_time_ms(bool use_compact_vertex_format)
+    -> double {
+    auto luminol_engine = RenderEngine(Properties{
+        .title = "Luminol Compact Vertex Stress Test",
+        .use_compact_vertex_format = use_compact_vertex_format,
+    });
+
+    auto camera = Camera{CameraProperties{
+        .position = Maths::Vector3f{-20.0F, 15.0F, -20.0F},
+        .forward = Maths::Vector3f{1.0F, -0.2F, 1.0F},
+    }};
+    camera.set_aspect_ratio(
+        static_cast<float>(luminol_engine.get_window().get_width()) /
+        static_cast<float>(luminol_engine.get_window().get_height())
+    );
+
+    auto& renderer = luminol_engine.get_renderer();
+
+    const auto model_id = renderer.create_renderable(model_path);
+    renderer.queue_draw_instanced_static(model_id, make_grid_model_matrices());
+
+    constexpr auto color = Maths::Vector4f{0.0F, 0.0F, 0.0F, 1.0F};
+
+    auto run_frame = [&] {
+        renderer.clear_color(color);
+        renderer.set_view_matrix(camera.get_view_matrix());
+        renderer.set_projection_matrix(camera.get_projection_matrix());
+        renderer.draw();
+    };
+
+    for (auto frame = 0; frame < warmup_frames; ++frame) {
+        run_frame();
+    }
+
+    auto timer = Utilities::Timer{};
+    for (auto frame = 0; frame < measured_frames; ++frame) {
+        run_frame();
+    }
+
+    return (timer.elapsed_seconds() / measured_frames) * 1000.0;
+}
+
+}  // namespace
+
+auto main() -> int {
+    const auto full_ms = measure_average_frame_time_ms(false);
+    const auto compact_ms = measure_average_frame_time_ms(true);
+
+    const auto ratio = compact_ms / full_ms;
+
+    std::printf(
+        "CompactVertex stress test: %s x%d, %d frames measured (after %d "
+        "warmup) - full 44 B/vertex %.3f ms/frame, compact 20 B/vertex "
+        "%.3f ms/frame (%.2fx)\n",
+        model_path,
+        grid_size * grid_size,
+        measured_frames,
+        warmup_frames,
+        full_ms,
+        compact_ms,
+        ratio
+    );
+
+    const auto success = ratio <= max_compact_slowdown;
+    if (!success) {
+        std::printf(
+            "CompactVertex stress test FAILED: compact/full frame time ratio "
+            "%.2fx exceeds threshold %.2fx\n",
+            ratio,
+            max_compact_slowdown
+        );
+    } else {
+        std::printf("CompactVertex stress test PASSED\n");
+    }
+
+    return success ? 0 : 1;
+}
@@ -0,0 +1,164 @@
+#include <algorithm>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include <LuminolMaths/Transform.hpp>
+#include <LuminolRenderEngine/Graphics/Camera.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPURenderer.hpp>
+#include <LuminolRenderEngine/LuminolRenderEngine.hpp>
+#include <LuminolRenderEngine/Utilities/Timer.hpp>
+
+// Headless stress test for SDL_GPURenderer's JobSystem-driven CPU frame
+// preparation: 125k dynamic (re-submitted every frame) cube instances,
+// split across renderable_count renderables so the per-batch stages
+// (bounds, cull metadata) have batches to spread as well as the per-matrix
+// instance copy. Renders the same scene with frame_prep_worker_count = 1
+// (everything on the calling thread) and then one worker per hardware
+// thread, and compares average frame times. Both runs include the same GPU
+// work, so the speedup understates how much the CPU prep itself scaled -
+// the per-stage "[Perf] ... stages:" log lines show that directly.
+//
+// The speedup threshold is only enforced on machines with at least
+// min_threads_for_speedup_check hardware threads.
+//
+// THRESHOLD CALIBRATION: min_parallel_speedup below is a deliberately
+// conservative placeholder, not a measured baseline (this test can't be run
+// in the environment that wrote it). Run this once, note the printed actual
+// speedup, and raise the threshold to ~2/3 that real number.
+
+namespace {
+
+using namespace Luminol;
+using namespace Luminol::Graphics;
+
+constexpr auto grid_size = 50;
+constexpr auto grid_spacing = 5.0F;
+constexpr auto renderable_count = 64;
+
+constexpr auto warmup_frames = 30;
+constexpr auto measured_frames = 120;
+
+constexpr auto min_threads_for_speedup_check = 4U;
+constexpr auto min_parallel_speedup = 1.1;
+
+// One list of model matrices per renderable, dealing the grid's cells out
+// round-robin so every renderable spans the whole grid.
+auto make_grid_model_matrices()
+    -> std::vector<std::vector<Maths::Matrix4x4f>> {
+    auto model_matrices =
+        std::vector<std::vector<Maths::Matrix4x4f>>(renderable_count);
+
+    constexpr auto grid_offset =
+        grid_spacing * static_cast<float>(grid_size - 1) / 2.0F;
+
+    auto cell_index = std::size_t{0};
+    for (auto grid_x = 0; grid_x < grid_size; ++grid_x) {
+        for (auto grid_y = 0; grid_y < grid_size; ++grid_y) {
+            for (auto grid_z = 0; grid_z < grid_size; ++grid_z) {
+                const auto position = Maths::Vector3f{
+                    (static_cast<float>(grid_x) * grid_spacing) - grid_offset,
+                    (static_cast<float>(grid_y) * grid_spacing) - grid_offset,
+                    (static_cast<float>(grid_z) * grid_spacing) - grid_offset,
+                };
+                model_matrices[cell_index % renderable_count].push_back(
+                    Maths::Transform::translate_4x4(position)
+                );
+                cell_index += 1;
+            }
+        }
+    }
+
+    return model_matrices;
+}
+
+}  // namespace
+
+auto main() -> int {
+    constexpr auto camera_initial_position =
+        Maths::Vector3f{0.0F, 0.0F, -150.0F};
+    constexpr auto camera_initial_forward = Maths::Vector3f{0.0F, 0.0F, 1.0F};
+    constexpr auto camera_far_plane = 500.0F;
+
+    auto luminol_engine = RenderEngine(Properties{
+        .title = "Luminol Frame Prep Scaling Stress Test",
+    });
+    auto& renderer = luminol_engine.get_renderer();
+
+    auto camera = Camera{CameraProperties{
+        .position = camera_initial_position,
+        .forward = camera_initial_forward,
+        .far_plane = camera_far_plane,
+    }};
+    camera.set_aspect_ratio(
+        static_cast<float>(luminol_engine.get_window().get_width()) /
+        static_cast<float>(luminol_engine.get_window().get_height())
+    );
+
+    auto model_ids = std::vector<RenderableId>{};
+    for (auto i = 0; i < renderable_count; ++i) {
+        model_ids.push_back(
+            renderer.create_renderable("res/models/cube/cube.obj")
+        );
+    }
+    const auto model_matrices = make_grid_model_matrices();
+
+    constexpr auto color = Maths::Vector4f{0.0F, 0.0F, 0.0F, 1.0F};
+
+    const auto run_frame = [&] {
+        renderer.clear_color(color);
+        renderer.set_view_matrix(camera.get_view_matrix());
+        renderer.set_projection_matrix(camera.get_projection_matrix());
+        for (auto i = std::size_t{0}; i < model_ids.size(); ++i) {
+            renderer.queue_draw_instanced(model_ids[i], model_matrices[i]);
+        }
+        renderer.draw();
+    };
+
+    const auto average_frame_time_ms = [&](uint32_t worker_count) {
+        renderer.set_frame_prep_worker_count(worker_count);
+
+        for (auto frame = 0; frame < warmup_frames; ++frame) {
+            run_frame();
+        }
+
+        auto timer = Utilities::Timer{};
+        for (auto frame = 0; frame < measured_frames; ++frame) {
+            run_frame();
+        }
+        return (timer.elapsed_seconds() / measured_frames) * 1000.0;
+    };
+
+    const auto hardware_threads =
+        std::max(1U, std::thread::hardware_concurrency());
+
+    const auto serial_ms = average_frame_time_ms(1);
+    const auto parallel_ms = average_frame_time_ms(hardware_threads);
+    const auto speedup = serial_ms / parallel_ms;
+
+    std::printf(
+        "FramePrepScaling stress test: %d instances in %d renderables - "
+        "1 worker %.3f ms/frame, %u workers %.3f ms/frame (%.2fx)\n",
+        grid_size * grid_size * grid_size,
+        renderable_count,
+        serial_ms,
+        hardware_threads,
+        parallel_ms,
+        speedup
+    );
+
+    const auto success = hardware_threads < min_threads_for_speedup_check ||
+                         speedup >= min_parallel_speedup;
+    if (!success) {
+        std::printf(
+            "FramePrepScaling stress test FAILED: speedup %.2fx is below "
+            "threshold %.2fx\n",
+            speedup,
+            min_parallel_speedup
+        );
+    } else {
+        std::printf("FramePrepScaling stress test PASSED\n");
+    }
+
+    return success ? 0 : 1;
+}
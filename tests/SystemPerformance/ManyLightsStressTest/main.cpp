@@ -1,6 +1,7 @@
 #include <algorithm>
 #include <array>
 #include <cstdio>
+#include <vector>
 
 #include <LuminolMaths/Transform.hpp>
 #include <LuminolRenderEngine/Graphics/Camera.hpp>
@@ -11,72 +12,126 @@
 
 // Headless stress test exercising LightManager::update_shadow_casters'
 // per-frame scoring/hysteresis and the clustered light-culling GPU pass at
-// their designed capacity ceiling (max_point_lights / max_spot_lights, 1024
-// each - Light.hpp). Scene geometry is the Sponza model (same asset/camera
-// framing as Demo/Sponza) plus a single small cube, so this also stresses
-// per-submesh batch culling/shading cost alongside the light-culling cost.
+// increasing light counts - 1k, 8k, 32k and 64k each of point and spot
+// lights, laid out at the same spacing so a larger variant covers more
+// ground rather than packing lights denser (the city-at-night case).
+// Scene geometry is the Sponza model (same asset/camera framing as
+// Demo/Sponza), so this also stresses per-submesh batch culling/shading
+// cost alongside the light-culling cost. Every variant runs under both
+// light culling modes (see SDL_GPURenderer::set_light_culling_mode), and
+// each run's frame times are printed - for clustered culling along with the
+// size the global light index list settled at (see
+// SDL_GPURenderer::set_light_index_budget) - and checked against the
+// variant's threshold.
 //
 // THRESHOLD CALIBRATION: max_average_frame_time_ms below is a deliberately
-// generous placeholder, not a measured baseline (this test can't be run in
-// the environment that wrote it). Run this once, note the printed actual
-// average, and tighten the threshold to ~2-3x that real number.
+// generous placeholder for each variant, not a measured baseline (this test
+// can't be run in the environment that wrote it). Run this once, note the
+// printed actual averages, and tighten each threshold to ~2-3x that real
+// number.
 
 namespace {
 
 using namespace Luminol;
 using namespace Luminol::Graphics;
 
-// 8x8x16 = 1024, matching max_point_lights/max_spot_lights exactly.
-constexpr auto grid_x = 8;
-constexpr auto grid_y = 8;
-constexpr auto grid_z = 16;
+struct LightGridVariant {
+    const char* name;
+    int grid_x;
+    int grid_y;
+    int grid_z;
+    double max_average_frame_time_ms;
+};
+
+// grid_x * grid_y * grid_z point lights, and as many spot lights.
+constexpr auto variants = std::array<LightGridVariant, 4>{
+    LightGridVariant{"1k", 8, 8, 16, 7.0},
+    LightGridVariant{"8k", 32, 8, 32, 12.0},
+    LightGridVariant{"32k", 64, 8, 64, 25.0},
+    LightGridVariant{"64k", 64, 8, 128, 40.0},
+};
+
+struct CullingModeVariant {
+    const char* name;
+    SDL_GPU::LightCullingMode mode;
+};
+
+// Every light variant runs under each, against the same threshold.
+constexpr auto culling_modes = std::array<CullingModeVariant, 2>{
+    CullingModeVariant{"clustered", SDL_GPU::LightCullingMode::Clustered},
+    CullingModeVariant{"z-binned", SDL_GPU::LightCullingMode::ZBinned},
+};
+
 constexpr auto grid_spacing = 2.0F;
 
 constexpr auto warmup_frames = 30;
 constexpr auto measured_frames = 120;
 
-constexpr auto max_average_frame_time_ms = 7.0;
+struct LightIds {
+    std::vector<LightManager::LightId> point_light_ids;
+    std::vector<LightManager::LightId> spot_light_ids;
+};
 
-auto add_lights(LightManager& light_manager) -> void {
+auto add_lights(LightManager& light_manager, const LightGridVariant& variant)
+    -> LightIds {
     // Centered near the origin, roughly Sponza's interior volume (see
     // Demo/Sponza's camera position/forward below) - not an exact fit to the
     // mesh bounds, just close enough that lights land inside the scene
     // rather than off in empty space.
-    constexpr auto offset_x = grid_spacing * static_cast<float>(grid_x - 1) / 2.0F;
-    constexpr auto offset_z = grid_spacing * static_cast<float>(grid_z - 1) / 2.0F;
-
-    for (auto x = 0; x < grid_x; ++x) {
-        for (auto y = 0; y < grid_y; ++y) {
-            for (auto z = 0; z < grid_z; ++z) {
+    const auto offset_x =
+        grid_spacing * static_cast<float>(variant.grid_x - 1) / 2.0F;
+    const auto offset_z =
+        grid_spacing * static_cast<float>(variant.grid_z - 1) / 2.0F;
+
+    auto ids = LightIds{};
+    for (auto x = 0; x < variant.grid_x; ++x) {
+        for (auto y = 0; y < variant.grid_y; ++y) {
+            for (auto z = 0; z < variant.grid_z; ++z) {
                 const auto position = Maths::Vector3f{
                     (static_cast<float>(x) * grid_spacing) - offset_x,
                     1.0F + (static_cast<float>(y) * grid_spacing),
                     (static_cast<float>(z) * grid_spacing) - offset_z,
                 };
 
-                (void)light_manager.add_point_light(PointLight{
-                    .position = position,
-                    .color = Maths::Vector3f{1.0F, 1.0F, 1.0F},
-                });
-
-                (void)light_manager.add_spot_light(SpotLight{
-                    .position = position,
-                    .direction = Maths::Vector3f{0.0F, -1.0F, 0.0F},
-                    .color = Maths::Vector3f{1.0F, 1.0F, 1.0F},
-                    .cut_off = 0.9F,
-                    .outer_cut_off = 0.8F,
-                });
+                const auto point_light_id =
+                    light_manager.add_point_light(PointLight{
+                        .position = position,
+                        .color = Maths::Vector3f{1.0F, 1.0F, 1.0F},
+                    });
+                if (point_light_id.has_value()) {
+                    ids.point_light_ids.push_back(*point_light_id);
+                }
+
+                const auto spot_light_id =
+                    light_manager.add_spot_light(SpotLight{
+                        .position = position,
+                        .direction = Maths::Vector3f{0.0F, -1.0F, 0.0F},
+                        .color = Maths::Vector3f{1.0F, 1.0F, 1.0F},
+                        .cut_off = 0.9F,
+                        .outer_cut_off = 0.8F,
+                    });
+                if (spot_light_id.has_value()) {
+                    ids.spot_light_ids.push_back(*spot_light_id);
+                }
             }
         }
     }
+
+    return ids;
+}
+
+auto remove_lights(LightManager& light_manager, const LightIds& ids) -> void {
+    for (const auto id : ids.point_light_ids) {
+        light_manager.remove_point_light(id);
+    }
+    for (const auto id : ids.spot_light_ids) {
+        light_manager.remove_spot_light(id);
+    }
 }
 
 }  // namespace
 
 auto main() -> int {
-    using namespace Luminol;
-    using namespace Luminol::Graphics;
-
     // Same camera framing as Demo/Sponza.
     constexpr auto camera_initial_position = Maths::Vector3f{10.0F, 1.0F, 0.0F};
     constexpr auto camera_initial_forward = Maths::Vector3f{-1.0F, 0.0F, 0.0F};
@@ -85,6 +140,7 @@ auto main() -> int {
     auto luminol_engine = RenderEngine(Properties{
         .title = "Luminol Many Lights Stress Test",
     });
+    auto& renderer = luminol_engine.get_renderer();
 
     auto camera = Camera{CameraProperties{
         .position = camera_initial_position,
@@ -92,11 +148,8 @@ auto main() -> int {
         .far_plane = camera_far_plane,
     }};
 
-    const auto sponza_model_id = luminol_engine.get_renderer().create_renderable(
-        "res/models/Sponza/glTF/Sponza.gltf"
-    );
-
-    add_lights(luminol_engine.get_renderer().get_light_manager());
+    const auto sponza_model_id =
+        renderer.create_renderable("res/models/Sponza/glTF/Sponza.gltf");
 
     camera.set_aspect_ratio(
         static_cast<float>(luminol_engine.get_window().get_width()) /
@@ -106,59 +159,92 @@ auto main() -> int {
     constexpr auto color = Maths::Vector4f{0.0F, 0.0F, 0.0F, 1.0F};
 
     auto run_frame = [&] {
-        luminol_engine.get_renderer().clear_color(color);
-        luminol_engine.get_renderer().set_view_matrix(camera.get_view_matrix());
-        luminol_engine.get_renderer().set_projection_matrix(
-            camera.get_projection_matrix()
-        );
-        luminol_engine.get_renderer().queue_draw(
-            sponza_model_id, Maths::Matrix4x4f::identity()
-        );
-        luminol_engine.get_renderer().draw();
+        renderer.clear_color(color);
+        renderer.set_view_matrix(camera.get_view_matrix());
+        renderer.set_projection_matrix(camera.get_projection_matrix());
+        renderer.queue_draw(sponza_model_id, Maths::Matrix4x4f::identity());
+        renderer.draw();
     };
 
-    for (auto frame = 0; frame < warmup_frames; ++frame) {
-        run_frame();
-    }
+    auto success = true;
 
-    auto total_frame_time_seconds = 0.0;
-    auto worst_frame_time_seconds = 0.0;
+    for (const auto& variant : variants) {
+        const auto ids = add_lights(renderer.get_light_manager(), variant);
 
-    for (auto frame = 0; frame < measured_frames; ++frame) {
-        auto timer = Utilities::Timer{};
-        run_frame();
-        const auto frame_time_seconds = timer.elapsed_seconds();
+        for (const auto& mode : culling_modes) {
+            renderer.set_light_culling_mode(mode.mode);
 
-        total_frame_time_seconds += frame_time_seconds;
-        worst_frame_time_seconds =
-            std::max(worst_frame_time_seconds, frame_time_seconds);
-    }
+            for (auto frame = 0; frame < warmup_frames; ++frame) {
+                run_frame();
+            }
 
-    const auto average_frame_time_ms =
-        (total_frame_time_seconds / measured_frames) * 1000.0;
-    const auto worst_frame_time_ms = worst_frame_time_seconds * 1000.0;
-
-    std::printf(
-        "ManyLights stress test: %d point + %d spot lights, %d frames "
-        "measured (after %d warmup) - average %.3f ms/frame, worst %.3f "
-        "ms/frame\n",
-        grid_x * grid_y * grid_z,
-        grid_x * grid_y * grid_z,
-        measured_frames,
-        warmup_frames,
-        average_frame_time_ms,
-        worst_frame_time_ms
-    );
+            auto total_frame_time_seconds = 0.0;
+            auto worst_frame_time_seconds = 0.0;
+
+            for (auto frame = 0; frame < measured_frames; ++frame) {
+                auto timer = Utilities::Timer{};
+                run_frame();
+                const auto frame_time_seconds = timer.elapsed_seconds();
+
+                total_frame_time_seconds += frame_time_seconds;
+                worst_frame_time_seconds =
+                    std::max(worst_frame_time_seconds, frame_time_seconds);
+            }
+
+            const auto average_frame_time_ms =
+                (total_frame_time_seconds / measured_frames) * 1000.0;
+            const auto worst_frame_time_ms = worst_frame_time_seconds * 1000.0;
+
+            std::printf(
+                "ManyLights stress test [%s, %s]: %zu point + %zu spot "
+                "lights, %d frames measured (after %d warmup) - average "
+                "%.3f ms/frame, worst %.3f ms/frame\n",
+                variant.name,
+                mode.name,
+                ids.point_light_ids.size(),
+                ids.spot_light_ids.size(),
+                measured_frames,
+                warmup_frames,
+                average_frame_time_ms,
+                worst_frame_time_ms
+            );
+
+            if (mode.mode == SDL_GPU::LightCullingMode::Clustered) {
+                const auto list_settings =
+                    renderer.get_light_index_list_settings();
+                const auto list_usage =
+                    renderer.get_last_light_index_list_usage();
+                std::printf(
+                    "ManyLights stress test [%s, %s]: light index list %u "
+                    "KiB, %u lights/cluster - %u entries needed, %u "
+                    "dropped, %u clusters clamped\n",
+                    variant.name,
+                    mode.name,
+                    list_settings.capacity * 4 / 1024,
+                    list_settings.lights_per_cluster,
+                    list_usage.required_entry_count,
+                    list_usage.dropped_entry_count,
+                    list_usage.clamped_cluster_count
+                );
+            }
+
+            if (average_frame_time_ms > variant.max_average_frame_time_ms) {
+                std::printf(
+                    "ManyLights stress test [%s, %s] FAILED: average %.3f "
+                    "ms/frame exceeds threshold %.3f ms/frame\n",
+                    variant.name,
+                    mode.name,
+                    average_frame_time_ms,
+                    variant.max_average_frame_time_ms
+                );
+                success = false;
+            }
+        }
+
+        remove_lights(renderer.get_light_manager(), ids);
+    }
 
-    const auto success = average_frame_time_ms <= max_average_frame_time_ms;
-    if (!success) {
-        std::printf(
-            "ManyLights stress test FAILED: average %.3f ms/frame exceeds "
-            "threshold %.3f ms/frame\n",
-            average_frame_time_ms,
-            max_average_frame_time_ms
-        );
-    } else {
+    if (success) {
         std::printf("ManyLights stress test PASSED\n");
     }
 
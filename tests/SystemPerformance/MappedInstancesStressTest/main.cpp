@@ -0,0 +1,163 @@
+#include <cstdio>
+#include <vector>
+
+#include <LuminolMaths/Transform.hpp>
+#include <LuminolRenderEngine/Graphics/BoundingBox.hpp>
+#include <LuminolRenderEngine/Graphics/Camera.hpp>
+#include <LuminolRenderEngine/Graphics/InstanceTransform.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPURenderer.hpp>
+#include <LuminolRenderEngine/LuminolRenderEngine.hpp>
+#include <LuminolRenderEngine/Utilities/Timer.hpp>
+
+// Headless stress test for map_instances: a 1M-cube grid where every cube
+// bobs up and down every frame, so every matrix is rewritten each frame.
+// Renders it once through queue_draw_instanced, where the caller's matrices
+// are copied into the renderer's frame arena and then again into staging,
+// and once through map_instances, where the caller writes them straight
+// into staging, and checks the mapped run's average frame time is at most
+// max_mapped_frame_time_ratio of the dynamic one. Both runs compute the
+// same matrices and draw the same scene, so the difference is the two
+// copies.
+//
+// THRESHOLD CALIBRATION: max_mapped_frame_time_ratio below is a deliberately
+// conservative placeholder, not a measured baseline (this test can't be run
+// in the environment that wrote it). Run this once, note the printed actual
+// ratio, and lower the threshold to ~1.5x that real number.
+
+namespace {
+
+using namespace Luminol;
+using namespace Luminol::Graphics;
+
+constexpr auto grid_size = 100;
+constexpr auto grid_spacing = 5.0F;
+constexpr auto grid_offset =
+    grid_spacing * static_cast<float>(grid_size - 1) / 2.0F;
+constexpr auto instance_count = grid_size * grid_size * grid_size;
+
+constexpr auto warmup_frames = 30;
+constexpr auto measured_frames = 120;
+
+constexpr auto max_mapped_frame_time_ratio = 0.95;
+
+// Instance index's cube for frame, nudged up or down alternately so the
+// grid doesn't drift.
+auto make_model_matrix(int index, int frame) -> Maths::Matrix4x4f {
+    const auto grid_x = index / (grid_size * grid_size);
+    const auto grid_y = (index / grid_size) % grid_size;
+    const auto grid_z = index % grid_size;
+    const auto bob = frame % 2 == 0 ? 0.5F : -0.5F;
+
+    return Maths::Transform::translate_4x4(Maths::Vector3f{
+        (static_cast<float>(grid_x) * grid_spacing) - grid_offset,
+        (static_cast<float>(grid_y) * grid_spacing) - grid_offset + bob,
+        (static_cast<float>(grid_z) * grid_spacing) - grid_offset,
+    });
+}
+
+}  // namespace
+
+auto main() -> int {
+    using namespace Luminol;
+    using namespace Luminol::Graphics;
+
+    constexpr auto camera_initial_position =
+        Maths::Vector3f{0.0F, 0.0F, -150.0F};
+    constexpr auto camera_initial_forward = Maths::Vector3f{0.0F, 0.0F, 1.0F};
+    constexpr auto camera_far_plane = 500.0F;
+
+    auto luminol_engine = RenderEngine(Properties{
+        .title = "Luminol Mapped Instances Stress Test",
+    });
+    auto& renderer = luminol_engine.get_renderer();
+    renderer.set_debug_present_mode(SDL_GPU::PresentMode::Immediate);
+
+    auto camera = Camera{CameraProperties{
+        .position = camera_initial_position,
+        .forward = camera_initial_forward,
+        .far_plane = camera_far_plane,
+    }};
+    camera.set_aspect_ratio(
+        static_cast<float>(luminol_engine.get_window().get_width()) /
+        static_cast<float>(luminol_engine.get_window().get_height())
+    );
+
+    const auto model_id =
+        renderer.create_renderable("res/models/cube/cube.obj");
+
+    // The unit cube at every grid point, plus the bob.
+    constexpr auto bounds_extent = grid_offset + 1.5F;
+    constexpr auto world_bounds = BoundingBox{
+        .min = Maths::Vector3f{-bounds_extent, -bounds_extent, -bounds_extent},
+        .max = Maths::Vector3f{bounds_extent, bounds_extent, bounds_extent},
+    };
+
+    constexpr auto color = Maths::Vector4f{0.0F, 0.0F, 0.0F, 1.0F};
+
+    const auto average_frame_time_ms = [&](const auto& run_frame) {
+        for (auto frame = 0; frame < warmup_frames; ++frame) {
+            run_frame(frame);
+        }
+
+        auto timer = Utilities::Timer{};
+        for (auto frame = 0; frame < measured_frames; ++frame) {
+            run_frame(warmup_frames + frame);
+        }
+        return (timer.elapsed_seconds() / measured_frames) * 1000.0;
+    };
+
+    const auto begin_frame = [&] {
+        renderer.clear_color(color);
+        renderer.set_view_matrix(camera.get_view_matrix());
+        renderer.set_projection_matrix(camera.get_projection_matrix());
+    };
+
+    auto model_matrices = std::vector<Maths::Matrix4x4f>(instance_count);
+    const auto dynamic_ms = average_frame_time_ms([&](int frame) {
+        begin_frame();
+        for (auto index = 0; index < instance_count; ++index) {
+            model_matrices[index] = make_model_matrix(index, frame);
+        }
+        renderer.queue_draw_instanced(model_id, model_matrices);
+        renderer.draw();
+    });
+
+    const auto mapped_ms = average_frame_time_ms([&](int frame) {
+        begin_frame();
+        const auto mapped = renderer.map_instances(
+            model_id, static_cast<uint32_t>(instance_count), world_bounds
+        );
+        for (auto index = 0; index < static_cast<int>(mapped.size());
+             ++index) {
+            mapped[index] = to_instance_transform(
+                make_model_matrix(index, frame)
+            );
+        }
+        renderer.draw();
+    });
+
+    const auto ratio = mapped_ms / dynamic_ms;
+
+    std::printf(
+        "MappedInstances stress test: %d instances - queue_draw_instanced "
+        "%.3f ms/frame, map_instances %.3f ms/frame (%.2fx)\n",
+        instance_count,
+        dynamic_ms,
+        mapped_ms,
+        ratio
+    );
+
+    const auto success = ratio <= max_mapped_frame_time_ratio;
+    if (!success) {
+        std::printf(
+            "MappedInstances stress test FAILED: ratio %.2fx exceeds "
+            "threshold %.2fx\n",
+            ratio,
+            max_mapped_frame_time_ratio
+        );
+    } else {
+        std::printf("MappedInstances stress test PASSED\n");
+    }
+
+    return success ? 0 : 1;
+}
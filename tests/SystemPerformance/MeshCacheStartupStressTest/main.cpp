@@ -0,0 +1,83 @@
+#include <cstdio>
+#include <filesystem>
+#include <system_error>
+
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUMeshCache.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPURenderer.hpp>
+#include <LuminolRenderEngine/LuminolRenderEngine.hpp>
+#include <LuminolRenderEngine/Utilities/Timer.hpp>
+
+// Startup benchmark for the baked mesh cache (SDL_GPUMeshCache): loads the
+// Sponza model once with the cache directory wiped (cold - assimp +
+// meshoptimizer + cache write), removes it, then loads it again (warm -
+// memory-mapped cache entry, no assimp/meshoptimizer). Both loads still
+// decode and upload every material texture, since textures aren't part of
+// the cache entry, so the difference between the two is the mesh baking
+// cost the cache removes.
+//
+// Fails if the warm load isn't at least min_warm_speedup times faster than
+// the cold one, which would mean the cache was missed (or rebaked).
+//
+// THRESHOLD CALIBRATION: min_warm_speedup below is a deliberately
+// conservative placeholder, not a measured baseline (this test can't be run
+// in the environment that wrote it). Run this once, note the printed actual
+// speedup, and raise the threshold to ~1/2 that real number.
+
+namespace {
+
+constexpr auto model_path = "res/models/Sponza/glTF/Sponza.gltf";
+
+constexpr auto min_warm_speedup = 1.1;
+
+}  // namespace
+
+auto main() -> int {
+    using namespace Luminol;
+    using namespace Luminol::Graphics;
+
+    auto error = std::error_code{};
+    std::filesystem::remove_all(SDL_GPU::get_mesh_cache_directory(), error);
+
+    auto luminol_engine = RenderEngine(Properties{
+        .title = "Luminol Mesh Cache Startup Stress Test",
+    });
+
+    auto& renderer = luminol_engine.get_renderer();
+
+    auto cold_timer = Utilities::Timer{};
+    const auto cold_model_id = renderer.create_renderable(model_path);
+    const auto cold_load_ms = cold_timer.elapsed_seconds() * 1000.0;
+
+    renderer.remove_renderable(cold_model_id);
+
+    auto warm_timer = Utilities::Timer{};
+    const auto warm_model_id = renderer.create_renderable(model_path);
+    const auto warm_load_ms = warm_timer.elapsed_seconds() * 1000.0;
+
+    renderer.remove_renderable(warm_model_id);
+
+    const auto speedup = cold_load_ms / warm_load_ms;
+
+    std::printf(
+        "MeshCacheStartup stress test: %s - cold load %.3f ms, warm load "
+        "%.3f ms (%.2fx)\n",
+        model_path,
+        cold_load_ms,
+        warm_load_ms,
+        speedup
+    );
+
+    const auto success = speedup >= min_warm_speedup;
+    if (!success) {
+        std::printf(
+            "MeshCacheStartup stress test FAILED: warm load speedup %.2fx "
+            "is below threshold %.2fx\n",
+            speedup,
+            min_warm_speedup
+        );
+    } else {
+        std::printf("MeshCacheStartup stress test PASSED\n");
+    }
+
+    return success ? 0 : 1;
+}
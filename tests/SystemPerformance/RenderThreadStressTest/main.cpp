@@ -0,0 +1,213 @@
+#include <algorithm>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include <LuminolMaths/Transform.hpp>
+#include <LuminolRenderEngine/Graphics/BoundingBox.hpp>
+#include <LuminolRenderEngine/Graphics/Camera.hpp>
+#include <LuminolRenderEngine/Graphics/InstanceTransform.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPURenderer.hpp>
+#include <LuminolRenderEngine/LuminolRenderEngine.hpp>
+#include <LuminolRenderEngine/Utilities/Timer.hpp>
+
+// Headless stress test for SDL_GPURenderer's render-thread mode: every frame
+// spins the calling thread for simulation_ms of stand-in game logic, then
+// queues a dynamic cube grid, a mapped cube grid and a few moving retained
+// instances - heavy enough that recording the frame costs about as much CPU
+// as the simulation. Runs the same loop with the render thread off (the two
+// add up) and on (the render thread records frame N while the caller
+// simulates frame N + 1), and compares average frame times.
+//
+// Only enforced on machines with at least min_threads_for_speedup_check
+// hardware threads, since the overlap needs a core for each side.
+//
+// THRESHOLD CALIBRATION: min_render_thread_speedup below is a deliberately
+// conservative placeholder, not a measured baseline (this test can't be run
+// in the environment that wrote it). Run this once, note the printed actual
+// speedup, and raise the threshold to ~2/3 that real number.
+
+namespace {
+
+using namespace Luminol;
+using namespace Luminol::Graphics;
+
+constexpr auto grid_size = 30;
+constexpr auto grid_spacing = 5.0F;
+constexpr auto grid_offset =
+    grid_spacing * static_cast<float>(grid_size - 1) / 2.0F;
+constexpr auto grid_instance_count = grid_size * grid_size * grid_size;
+
+constexpr auto retained_instance_count = 1000;
+constexpr auto moving_retained_instance_count = 100;
+
+constexpr auto simulation_ms = 4.0;
+
+constexpr auto warmup_frames = 30;
+constexpr auto measured_frames = 120;
+
+constexpr auto min_threads_for_speedup_check = 4U;
+constexpr auto min_render_thread_speedup = 1.1;
+
+// Instance index's grid cube, pushed out along x by offset so the grids
+// don't overlap, and nudged up or down alternately per frame.
+auto make_model_matrix(int index, float offset, int frame)
+    -> Maths::Matrix4x4f {
+    const auto grid_x = index / (grid_size * grid_size);
+    const auto grid_y = (index / grid_size) % grid_size;
+    const auto grid_z = index % grid_size;
+    const auto bob = frame % 2 == 0 ? 0.5F : -0.5F;
+
+    return Maths::Transform::translate_4x4(Maths::Vector3f{
+        (static_cast<float>(grid_x) * grid_spacing) - grid_offset + offset,
+        (static_cast<float>(grid_y) * grid_spacing) - grid_offset + bob,
+        (static_cast<float>(grid_z) * grid_spacing) - grid_offset,
+    });
+}
+
+// Busy, rather than sleeping, so it holds a core the way game logic would.
+auto simulate() -> void {
+    const auto timer = Utilities::Timer{};
+    while (timer.elapsed_seconds() * 1000.0 < simulation_ms) {
+    }
+}
+
+}  // namespace
+
+auto main() -> int {
+    constexpr auto camera_initial_position =
+        Maths::Vector3f{0.0F, 0.0F, -250.0F};
+    constexpr auto camera_initial_forward = Maths::Vector3f{0.0F, 0.0F, 1.0F};
+    constexpr auto camera_far_plane = 600.0F;
+    constexpr auto grid_separation = grid_spacing * grid_size * 1.5F;
+
+    auto luminol_engine = RenderEngine(Properties{
+        .title = "Luminol Render Thread Stress Test",
+    });
+    auto& renderer = luminol_engine.get_renderer();
+    renderer.set_debug_present_mode(SDL_GPU::PresentMode::Immediate);
+
+    auto camera = Camera{CameraProperties{
+        .position = camera_initial_position,
+        .forward = camera_initial_forward,
+        .far_plane = camera_far_plane,
+    }};
+    camera.set_aspect_ratio(
+        static_cast<float>(luminol_engine.get_window().get_width()) /
+        static_cast<float>(luminol_engine.get_window().get_height())
+    );
+
+    // One renderable per API - a renderable's instances come from one API.
+    const auto dynamic_model_id =
+        renderer.create_renderable("res/models/cube/cube.obj");
+    const auto mapped_model_id =
+        renderer.create_renderable("res/models/cube/cube.obj");
+    const auto retained_model_id =
+        renderer.create_renderable("res/models/cube/cube.obj");
+
+    auto instance_ids = std::vector<InstanceId>{};
+    instance_ids.reserve(retained_instance_count);
+    for (auto index = 0; index < retained_instance_count; ++index) {
+        instance_ids.push_back(renderer.create_instance(
+            retained_model_id, make_model_matrix(index, grid_separation, 0)
+        ));
+    }
+
+    constexpr auto mapped_extent = grid_offset + 1.5F;
+    constexpr auto mapped_world_bounds = BoundingBox{
+        .min = Maths::Vector3f{
+            -grid_separation - mapped_extent, -mapped_extent, -mapped_extent
+        },
+        .max = Maths::Vector3f{
+            -grid_separation + mapped_extent, mapped_extent, mapped_extent
+        },
+    };
+
+    auto model_matrices = std::vector<Maths::Matrix4x4f>(grid_instance_count);
+
+    constexpr auto color = Maths::Vector4f{0.0F, 0.0F, 0.0F, 1.0F};
+
+    auto frame = 0;
+    const auto run_frame = [&] {
+        simulate();
+
+        renderer.clear_color(color);
+        renderer.set_view_matrix(camera.get_view_matrix());
+        renderer.set_projection_matrix(camera.get_projection_matrix());
+
+        for (auto index = 0; index < grid_instance_count; ++index) {
+            model_matrices[index] = make_model_matrix(index, 0.0F, frame);
+        }
+        renderer.queue_draw_instanced(dynamic_model_id, model_matrices);
+
+        const auto mapped = renderer.map_instances(
+            mapped_model_id, static_cast<uint32_t>(grid_instance_count),
+            mapped_world_bounds
+        );
+        for (auto index = 0; index < static_cast<int>(mapped.size());
+             ++index) {
+            mapped[index] = to_instance_transform(
+                make_model_matrix(index, -grid_separation, frame)
+            );
+        }
+
+        for (auto i = 0; i < moving_retained_instance_count; ++i) {
+            const auto index =
+                ((frame * moving_retained_instance_count) + i) %
+                retained_instance_count;
+            renderer.update_instance(
+                instance_ids[index],
+                make_model_matrix(index, grid_separation, frame)
+            );
+        }
+
+        renderer.draw();
+        ++frame;
+    };
+
+    const auto average_frame_time_ms = [&](bool use_render_thread) {
+        renderer.set_render_thread_enabled(use_render_thread);
+
+        for (auto i = 0; i < warmup_frames; ++i) {
+            run_frame();
+        }
+
+        auto timer = Utilities::Timer{};
+        for (auto i = 0; i < measured_frames; ++i) {
+            run_frame();
+        }
+        return (timer.elapsed_seconds() / measured_frames) * 1000.0;
+    };
+
+    const auto hardware_threads =
+        std::max(1U, std::thread::hardware_concurrency());
+
+    const auto serial_ms = average_frame_time_ms(false);
+    const auto threaded_ms = average_frame_time_ms(true);
+    renderer.set_render_thread_enabled(false);
+    const auto speedup = serial_ms / threaded_ms;
+
+    std::printf(
+        "RenderThread stress test: %.1f ms simulation per frame - "
+        "serial %.3f ms/frame, render thread %.3f ms/frame (%.2fx)\n",
+        simulation_ms,
+        serial_ms,
+        threaded_ms,
+        speedup
+    );
+
+    const auto success = hardware_threads < min_threads_for_speedup_check ||
+                         speedup >= min_render_thread_speedup;
+    if (!success) {
+        std::printf(
+            "RenderThread stress test FAILED: speedup %.2fx is below "
+            "threshold %.2fx\n",
+            speedup,
+            min_render_thread_speedup
+        );
+    } else {
+        std::printf("RenderThread stress test PASSED\n");
+    }
+
+    return success ? 0 : 1;
+}
@@ -0,0 +1,194 @@
+#include <cstdio>
+#include <vector>
+
+#include <LuminolMaths/Transform.hpp>
+#include <LuminolRenderEngine/Graphics/Camera.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPURenderer.hpp>
+#include <LuminolRenderEngine/LuminolRenderEngine.hpp>
+#include <LuminolRenderEngine/Utilities/Timer.hpp>
+
+// Headless stress test for retained instances (create_instance /
+// update_instance): a 1M-cube grid where 1% of the cubes move every frame.
+// Renders it once through queue_draw_instanced, which copies and re-uploads
+// all 1M matrices every frame, and once through retained instances, which
+// upload only the moved 1%, and checks the retained run's average frame
+// time is at most max_retained_frame_time_ratio of the dynamic one. Both
+// runs draw the same scene, so the ratio understates how much cheaper
+// instance_upload itself got - the "[Perf]" log lines show that directly.
+//
+// The movers are a contiguous window of the grid that advances every frame,
+// like a group of objects animating together, so their dirty slots coalesce
+// into a few copies.
+//
+// THRESHOLD CALIBRATION: max_retained_frame_time_ratio below is a
+// deliberately conservative placeholder, not a measured baseline (this test
+// can't be run in the environment that wrote it). Run this once, note the
+// printed actual ratio, and lower the threshold to ~1.5x that real number.
+
+namespace {
+
+using namespace Luminol;
+using namespace Luminol::Graphics;
+
+constexpr auto grid_size = 100;
+constexpr auto grid_spacing = 5.0F;
+constexpr auto moving_instance_count = std::size_t{10'000};
+
+constexpr auto warmup_frames = 30;
+constexpr auto measured_frames = 120;
+
+constexpr auto max_retained_frame_time_ratio = 0.9;
+
+auto make_grid_model_matrices() -> std::vector<Maths::Matrix4x4f> {
+    auto model_matrices = std::vector<Maths::Matrix4x4f>{};
+    model_matrices.reserve(
+        static_cast<size_t>(grid_size) * static_cast<size_t>(grid_size) *
+        static_cast<size_t>(grid_size)
+    );
+
+    constexpr auto grid_offset =
+        grid_spacing * static_cast<float>(grid_size - 1) / 2.0F;
+
+    for (auto grid_x = 0; grid_x < grid_size; ++grid_x) {
+        for (auto grid_y = 0; grid_y < grid_size; ++grid_y) {
+            for (auto grid_z = 0; grid_z < grid_size; ++grid_z) {
+                const auto position = Maths::Vector3f{
+                    (static_cast<float>(grid_x) * grid_spacing) - grid_offset,
+                    (static_cast<float>(grid_y) * grid_spacing) - grid_offset,
+                    (static_cast<float>(grid_z) * grid_spacing) - grid_offset,
+                };
+                model_matrices.push_back(
+                    Maths::Transform::translate_4x4(position)
+                );
+            }
+        }
+    }
+
+    return model_matrices;
+}
+
+// Nudges this frame's window of movers up or down, alternating per frame so
+// the grid doesn't drift.
+template <typename OnMoved>
+auto move_instances(
+    std::vector<Maths::Matrix4x4f>& model_matrices,
+    int frame,
+    OnMoved&& on_moved
+) -> void {
+    const auto offset = frame % 2 == 0 ? 0.5F : -0.5F;
+    const auto first = (static_cast<std::size_t>(frame) *
+                        moving_instance_count) %
+        model_matrices.size();
+    for (auto i = std::size_t{0}; i < moving_instance_count; ++i) {
+        const auto index = (first + i) % model_matrices.size();
+        model_matrices[index][3][1] += offset;
+        on_moved(index);
+    }
+}
+
+}  // namespace
+
+auto main() -> int {
+    using namespace Luminol;
+    using namespace Luminol::Graphics;
+
+    constexpr auto camera_initial_position =
+        Maths::Vector3f{0.0F, 0.0F, -150.0F};
+    constexpr auto camera_initial_forward = Maths::Vector3f{0.0F, 0.0F, 1.0F};
+    constexpr auto camera_far_plane = 500.0F;
+
+    auto luminol_engine = RenderEngine(Properties{
+        .title = "Luminol Retained Instances Stress Test",
+    });
+    auto& renderer = luminol_engine.get_renderer();
+    renderer.set_debug_present_mode(SDL_GPU::PresentMode::Immediate);
+
+    auto camera = Camera{CameraProperties{
+        .position = camera_initial_position,
+        .forward = camera_initial_forward,
+        .far_plane = camera_far_plane,
+    }};
+    camera.set_aspect_ratio(
+        static_cast<float>(luminol_engine.get_window().get_width()) /
+        static_cast<float>(luminol_engine.get_window().get_height())
+    );
+
+    // One renderable per run - a renderable's instances come from one API.
+    const auto dynamic_model_id =
+        renderer.create_renderable("res/models/cube/cube.obj");
+    const auto retained_model_id =
+        renderer.create_renderable("res/models/cube/cube.obj");
+    auto model_matrices = make_grid_model_matrices();
+
+    constexpr auto color = Maths::Vector4f{0.0F, 0.0F, 0.0F, 1.0F};
+
+    const auto average_frame_time_ms = [&](const auto& run_frame) {
+        for (auto frame = 0; frame < warmup_frames; ++frame) {
+            run_frame(frame);
+        }
+
+        auto timer = Utilities::Timer{};
+        for (auto frame = 0; frame < measured_frames; ++frame) {
+            run_frame(warmup_frames + frame);
+        }
+        return (timer.elapsed_seconds() / measured_frames) * 1000.0;
+    };
+
+    const auto begin_frame = [&] {
+        renderer.clear_color(color);
+        renderer.set_view_matrix(camera.get_view_matrix());
+        renderer.set_projection_matrix(camera.get_projection_matrix());
+    };
+
+    const auto dynamic_ms = average_frame_time_ms([&](int frame) {
+        begin_frame();
+        move_instances(model_matrices, frame, [](std::size_t) {});
+        renderer.queue_draw_instanced(dynamic_model_id, model_matrices);
+        renderer.draw();
+    });
+
+    auto instance_ids = std::vector<InstanceId>{};
+    instance_ids.reserve(model_matrices.size());
+    for (const auto& model_matrix : model_matrices) {
+        instance_ids.push_back(
+            renderer.create_instance(retained_model_id, model_matrix)
+        );
+    }
+
+    const auto retained_ms = average_frame_time_ms([&](int frame) {
+        begin_frame();
+        move_instances(model_matrices, frame, [&](std::size_t index) {
+            renderer.update_instance(
+                instance_ids[index], model_matrices[index]
+            );
+        });
+        renderer.draw();
+    });
+
+    const auto ratio = retained_ms / dynamic_ms;
+
+    std::printf(
+        "RetainedInstances stress test: %zu instances, %zu moving per frame "
+        "- queue_draw_instanced %.3f ms/frame, retained %.3f ms/frame "
+        "(%.2fx)\n",
+        model_matrices.size(),
+        moving_instance_count,
+        dynamic_ms,
+        retained_ms,
+        ratio
+    );
+
+    const auto success = ratio <= max_retained_frame_time_ratio;
+    if (!success) {
+        std::printf(
+            "RetainedInstances stress test FAILED: ratio %.2fx exceeds "
+            "threshold %.2fx\n",
+            ratio,
+            max_retained_frame_time_ratio
+        );
+    } else {
+        std::printf("RetainedInstances stress test PASSED\n");
+    }
+
+    return success ? 0 : 1;
+}
@@ -0,0 +1,73 @@
+#include <cstdio>
+#include <filesystem>
+#include <system_error>
+
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPUShaderCache.hpp>
+#include <LuminolRenderEngine/LuminolRenderEngine.hpp>
+#include <LuminolRenderEngine/Utilities/Timer.hpp>
+
+// Startup benchmark for the SPIR-V shader cache (SDL_GPUShaderCache): builds
+// a RenderEngine once with the shader cache directory wiped (cold - every
+// pass's HLSL compiled by DXC, then written to the cache), destroys it, then
+// builds it again (warm - every shader loaded from the cache, no HLSL
+// compilation). Window and device creation are in both timings, so the
+// difference between the two is the compile time the cache removes from the
+// renderer constructor.
+//
+// Fails if the warm startup isn't at least min_warm_speedup times faster
+// than the cold one, which would mean shaders were recompiled.
+//
+// THRESHOLD CALIBRATION: min_warm_speedup below is a deliberately
+// conservative placeholder, not a measured baseline (this test can't be run
+// in the environment that wrote it). Run this once, note the printed actual
+// speedup, and raise the threshold to ~1/2 that real number.
+
+namespace {
+
+constexpr auto min_warm_speedup = 1.2;
+
+auto time_startup_ms() -> double {
+    auto timer = Luminol::Utilities::Timer{};
+    {
+        const auto luminol_engine = Luminol::RenderEngine(Luminol::Properties{
+            .title = "Luminol Shader Cache Startup Stress Test",
+        });
+    }
+    return timer.elapsed_seconds() * 1000.0;
+}
+
+}  // namespace
+
+auto main() -> int {
+    using namespace Luminol::Graphics;
+
+    auto error = std::error_code{};
+    std::filesystem::remove_all(SDL_GPU::get_shader_cache_directory(), error);
+
+    const auto cold_startup_ms = time_startup_ms();
+    const auto warm_startup_ms = time_startup_ms();
+
+    const auto speedup = cold_startup_ms / warm_startup_ms;
+
+    std::printf(
+        "ShaderCacheStartup stress test: cold startup %.3f ms, warm startup "
+        "%.3f ms (%.2fx)\n",
+        cold_startup_ms,
+        warm_startup_ms,
+        speedup
+    );
+
+    const auto success = speedup >= min_warm_speedup;
+    if (!success) {
+        std::printf(
+            "ShaderCacheStartup stress test FAILED: warm startup speedup "
+            "%.2fx is below threshold %.2fx\n",
+            speedup,
+            min_warm_speedup
+        );
+    } else {
+        std::printf("ShaderCacheStartup stress test PASSED\n");
+    }
+
+    return success ? 0 : 1;
+}
@@ -0,0 +1,255 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include <LuminolMaths/Transform.hpp>
+#include <LuminolRenderEngine/Graphics/BoundingBox.hpp>
+#include <LuminolRenderEngine/Graphics/Camera.hpp>
+#include <LuminolRenderEngine/Graphics/InstanceTransform.hpp>
+#include <LuminolRenderEngine/Graphics/SDL_GPU/SDL_GPURenderer.hpp>
+#include <LuminolRenderEngine/LuminolRenderEngine.hpp>
+#include <LuminolRenderEngine/Utilities/AllocationCounter.hpp>
+
+// Headless check that a steady-state frame makes no heap allocations: a
+// scene that exercises every per-frame path at once - a static grid, a
+// queue_draw_instanced grid that moves every frame, retained instances with
+// a few movers, map_instances, shadow-casting point and spot lights, and a
+// line of text that changes every frame - is drawn for warmup_frames so
+// every pooled buffer and retained list reaches its working size, then
+// every measured frame must report
+// SDL_GPURenderer::get_last_frame_heap_allocation_count() == 0.
+//
+// Only built with LUMINOL_RENDER_ENGINE_COUNT_HEAP_ALLOCATIONS, since
+// nothing is counted otherwise. The threshold is exact, not a timing, so
+// there's nothing to calibrate - any allocation is a regression to track
+// down (break on operator new after warmup to find it). Allocations SDL
+// makes through its own malloc aren't counted.
+
+namespace {
+
+using namespace Luminol;
+using namespace Luminol::Graphics;
+
+constexpr auto grid_size = 20;
+constexpr auto grid_spacing = 5.0F;
+constexpr auto grid_offset =
+    grid_spacing * static_cast<float>(grid_size - 1) / 2.0F;
+constexpr auto grid_instance_count = grid_size * grid_size * grid_size;
+
+constexpr auto moving_retained_instance_count = std::size_t{100};
+constexpr auto light_count = 64;
+
+constexpr auto warmup_frames = 60;
+constexpr auto measured_frames = 120;
+
+// Instance index's grid cube, pushed out along x by offset so the static,
+// dynamic, retained and mapped grids don't overlap, and nudged up or down
+// alternately per frame so it doesn't drift.
+auto make_model_matrix(int index, float offset, int frame)
+    -> Maths::Matrix4x4f {
+    const auto grid_x = index / (grid_size * grid_size);
+    const auto grid_y = (index / grid_size) % grid_size;
+    const auto grid_z = index % grid_size;
+    const auto bob = frame % 2 == 0 ? 0.5F : -0.5F;
+
+    return Maths::Transform::translate_4x4(Maths::Vector3f{
+        (static_cast<float>(grid_x) * grid_spacing) - grid_offset + offset,
+        (static_cast<float>(grid_y) * grid_spacing) - grid_offset + bob,
+        (static_cast<float>(grid_z) * grid_spacing) - grid_offset,
+    });
+}
+
+auto add_lights(LightManager& light_manager) -> void {
+    for (auto i = 0; i < light_count; ++i) {
+        const auto position = Maths::Vector3f{
+            (static_cast<float>(i % 8) * 20.0F) - 70.0F,
+            grid_offset + 5.0F,
+            (static_cast<float>(i / 8) * 20.0F) - 70.0F,
+        };
+
+        (void)light_manager.add_point_light(PointLight{
+            .position = position,
+            .color = Maths::Vector3f{4.0F, 4.0F, 4.0F},
+        });
+
+        (void)light_manager.add_spot_light(SpotLight{
+            .position = position,
+            .direction = Maths::Vector3f{0.0F, -1.0F, 0.0F},
+            .color = Maths::Vector3f{4.0F, 4.0F, 4.0F},
+            .cut_off = 0.9F,
+            .outer_cut_off = 0.8F,
+        });
+    }
+}
+
+}  // namespace
+
+auto main() -> int {
+    using namespace Luminol;
+    using namespace Luminol::Graphics;
+
+    if (!Utilities::is_counting_heap_allocations()) {
+        std::printf(
+            "SteadyStateAllocation stress test FAILED: built without "
+            "LUMINOL_RENDER_ENGINE_COUNT_HEAP_ALLOCATIONS\n"
+        );
+        return 1;
+    }
+
+    constexpr auto camera_initial_position =
+        Maths::Vector3f{0.0F, 20.0F, -250.0F};
+    constexpr auto camera_initial_forward = Maths::Vector3f{0.0F, 0.0F, 1.0F};
+    constexpr auto camera_far_plane = 600.0F;
+    constexpr auto grid_separation = grid_spacing * grid_size * 1.5F;
+
+    auto luminol_engine = RenderEngine(Properties{
+        .title = "Luminol Steady State Allocation Stress Test",
+    });
+    auto& renderer = luminol_engine.get_renderer();
+    renderer.set_debug_present_mode(SDL_GPU::PresentMode::Immediate);
+
+    auto camera = Camera{CameraProperties{
+        .position = camera_initial_position,
+        .forward = camera_initial_forward,
+        .far_plane = camera_far_plane,
+    }};
+    camera.set_aspect_ratio(
+        static_cast<float>(luminol_engine.get_window().get_width()) /
+        static_cast<float>(luminol_engine.get_window().get_height())
+    );
+
+    // One renderable per API - a renderable's instances come from one API.
+    const auto static_model_id =
+        renderer.create_renderable("res/models/cube/cube.obj");
+    const auto dynamic_model_id =
+        renderer.create_renderable("res/models/cube/cube.obj");
+    const auto retained_model_id =
+        renderer.create_renderable("res/models/cube/cube.obj");
+    const auto mapped_model_id =
+        renderer.create_renderable("res/models/cube/cube.obj");
+    const auto font_id =
+        renderer.create_font("res/fonts/RobotoMono-Regular.ttf", 16.0F);
+
+    add_lights(renderer.get_light_manager());
+
+    auto model_matrices = std::vector<Maths::Matrix4x4f>(grid_instance_count);
+    for (auto index = 0; index < grid_instance_count; ++index) {
+        model_matrices[index] =
+            make_model_matrix(index, -1.5F * grid_separation, 0);
+    }
+    renderer.queue_draw_instanced_static(static_model_id, model_matrices);
+
+    auto instance_ids = std::vector<InstanceId>{};
+    instance_ids.reserve(grid_instance_count);
+    for (auto index = 0; index < grid_instance_count; ++index) {
+        instance_ids.push_back(renderer.create_instance(
+            retained_model_id,
+            make_model_matrix(index, 0.5F * grid_separation, 0)
+        ));
+    }
+
+    constexpr auto mapped_extent = grid_offset + 1.5F;
+    constexpr auto mapped_offset = 1.5F * grid_separation;
+    constexpr auto mapped_world_bounds = BoundingBox{
+        .min = Maths::Vector3f{
+            mapped_offset - mapped_extent, -mapped_extent, -mapped_extent
+        },
+        .max = Maths::Vector3f{
+            mapped_offset + mapped_extent, mapped_extent, mapped_extent
+        },
+    };
+
+    constexpr auto color = Maths::Vector4f{0.0F, 0.0F, 0.0F, 1.0F};
+    constexpr auto text_color = Maths::Vector4f{1.0F, 1.0F, 1.0F, 1.0F};
+
+    auto text = std::array<char, 64>{};
+    const auto run_frame = [&](int frame) {
+        renderer.clear_color(color);
+        renderer.set_view_matrix(camera.get_view_matrix());
+        renderer.set_projection_matrix(camera.get_projection_matrix());
+
+        for (auto index = 0; index < grid_instance_count; ++index) {
+            model_matrices[index] =
+                make_model_matrix(index, -0.5F * grid_separation, frame);
+        }
+        renderer.queue_draw_instanced(dynamic_model_id, model_matrices);
+
+        const auto first_mover =
+            (static_cast<std::size_t>(frame) * moving_retained_instance_count
+            ) %
+            instance_ids.size();
+        for (auto i = std::size_t{0}; i < moving_retained_instance_count;
+             ++i) {
+            const auto index = (first_mover + i) % instance_ids.size();
+            renderer.update_instance(
+                instance_ids[index],
+                make_model_matrix(
+                    static_cast<int>(index), 0.5F * grid_separation, frame
+                )
+            );
+        }
+
+        const auto mapped = renderer.map_instances(
+            mapped_model_id, static_cast<uint32_t>(grid_instance_count),
+            mapped_world_bounds
+        );
+        for (auto index = 0; index < static_cast<int>(mapped.size());
+             ++index) {
+            mapped[index] = to_instance_transform(
+                make_model_matrix(index, mapped_offset, frame)
+            );
+        }
+
+        std::snprintf(text.data(), text.size(), "frame %d", frame);
+        renderer.queue_draw_text(
+            font_id, text.data(), Maths::Vector2f{10.0F, 10.0F}, text_color
+        );
+
+        renderer.draw();
+    };
+
+    for (auto frame = 0; frame < warmup_frames; ++frame) {
+        run_frame(frame);
+    }
+
+    auto allocating_frame_count = 0;
+    auto max_frame_allocation_count = uint64_t{0};
+    auto total_allocation_count = uint64_t{0};
+    for (auto frame = 0; frame < measured_frames; ++frame) {
+        run_frame(warmup_frames + frame);
+
+        const auto allocation_count =
+            renderer.get_last_frame_heap_allocation_count();
+        if (allocation_count > 0) {
+            ++allocating_frame_count;
+        }
+        max_frame_allocation_count =
+            std::max(max_frame_allocation_count, allocation_count);
+        total_allocation_count += allocation_count;
+    }
+
+    std::printf(
+        "SteadyStateAllocation stress test: %d measured frames - %d "
+        "allocated, %llu allocations total, at most %llu in one frame\n",
+        measured_frames,
+        allocating_frame_count,
+        static_cast<unsigned long long>(total_allocation_count),
+        static_cast<unsigned long long>(max_frame_allocation_count)
+    );
+
+    const auto success = allocating_frame_count == 0;
+    if (!success) {
+        std::printf(
+            "SteadyStateAllocation stress test FAILED: %d of %d frames "
+            "allocated after warmup\n",
+            allocating_frame_count,
+            measured_frames
+        );
+    } else {
+        std::printf("SteadyStateAllocation stress test PASSED\n");
+    }
+
+    return success ? 0 : 1;
+}
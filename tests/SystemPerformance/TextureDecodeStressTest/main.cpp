@@ -0,0 +1,91 @@
+#include <algorithm>
+#include <cstdio>
+#include <thread>
+
+#include <LuminolRenderEngine/Utilities/ModelLoader.hpp>
+#include <LuminolRenderEngine/Utilities/Timer.hpp>
+
+// Headless (no window/GPU) timing test for ModelLoader::load_model's
+// parallel texture decode stage: loads the Sponza model - dozens of
+// multi-megabyte JPEG/PNG material textures - once with a single decode
+// worker and once with one worker per hardware thread, and compares the
+// two. Both runs include the identical assimp import, so the difference is
+// purely the decode stage's scaling.
+//
+// The speedup threshold is only enforced on machines with at least
+// min_threads_for_speedup_check hardware threads - on fewer cores there's
+// no parallelism to measure, and the test just reports the timings.
+//
+// THRESHOLD CALIBRATION: min_parallel_speedup below is a deliberately
+// conservative placeholder, not a measured baseline (this test can't be run
+// in the environment that wrote it). Run this once, note the printed actual
+// speedup, and raise the threshold to ~2/3 that real number.
+
+namespace {
+
+constexpr auto model_path = "res/models/Sponza/glTF/Sponza.gltf";
+
+constexpr auto min_threads_for_speedup_check = 4U;
+constexpr auto min_parallel_speedup = 1.5;
+
+auto time_load_ms(uint32_t worker_count) -> double {
+    using namespace Luminol::Utilities;
+
+    auto timer = Timer{};
+    const auto model = ModelLoader::load_model(
+        model_path,
+        ModelLoader::LoadOptions{.texture_decode_worker_count = worker_count}
+    );
+    const auto elapsed_ms = timer.elapsed_seconds() * 1000.0;
+
+    if (!model.has_value() || model->textures_map.empty()) {
+        std::printf(
+            "TextureDecode stress test: failed to load %s\n", model_path
+        );
+        return -1.0;
+    }
+
+    return elapsed_ms;
+}
+
+}  // namespace
+
+auto main() -> int {
+    const auto hardware_threads =
+        std::max(1U, std::thread::hardware_concurrency());
+
+    const auto serial_ms = time_load_ms(1);
+    const auto parallel_ms = time_load_ms(hardware_threads);
+
+    if (serial_ms < 0.0 || parallel_ms < 0.0) {
+        std::printf("TextureDecode stress test FAILED\n");
+        return 1;
+    }
+
+    const auto speedup = serial_ms / parallel_ms;
+
+    std::printf(
+        "TextureDecode stress test: %s - 1 worker %.3f ms, %u workers "
+        "%.3f ms (%.2fx)\n",
+        model_path,
+        serial_ms,
+        hardware_threads,
+        parallel_ms,
+        speedup
+    );
+
+    const auto success = hardware_threads < min_threads_for_speedup_check ||
+                         speedup >= min_parallel_speedup;
+    if (!success) {
+        std::printf(
+            "TextureDecode stress test FAILED: speedup %.2fx is below "
+            "threshold %.2fx\n",
+            speedup,
+            min_parallel_speedup
+        );
+    } else {
+        std::printf("TextureDecode stress test PASSED\n");
+    }
+
+    return success ? 0 : 1;
+}
@@ -0,0 +1,67 @@
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+#include <LuminolRenderEngine/Utilities/FrameArena.hpp>
+
+#include <doctest/doctest.h>
+
+using namespace Luminol::Utilities;
+
+TEST_CASE("FrameArena honours every allocation's alignment") {
+    auto arena = FrameArena{256};
+
+    for (const auto alignment : {1U, 2U, 8U, 16U, 64U, 256U}) {
+        auto* pointer = arena.allocate(3, alignment);
+        CHECK(reinterpret_cast<std::uintptr_t>(pointer) % alignment == 0);
+    }
+}
+
+TEST_CASE("FrameArena allocations in one frame don't overlap") {
+    auto arena = FrameArena{64};
+
+    // Spills across several blocks.
+    auto values = std::pmr::vector<std::pmr::vector<uint32_t>>{&arena};
+    for (auto i = 0U; i < 32; ++i) {
+        values.emplace_back(16, i);
+    }
+
+    auto all_intact = true;
+    for (auto i = 0U; i < values.size(); ++i) {
+        for (const auto value : values[i]) {
+            all_intact = all_intact && value == i;
+        }
+    }
+    CHECK(all_intact);
+}
+
+TEST_CASE("FrameArena reset rewinds to the start of its memory") {
+    auto arena = FrameArena{1024};
+
+    auto* first = arena.allocate(100, 8);
+    CHECK(arena.get_bytes_used() >= 100);
+
+    arena.reset();
+    CHECK(arena.get_bytes_used() == 0);
+    CHECK(arena.allocate(100, 8) == first);
+}
+
+TEST_CASE("FrameArena consolidates an overflowing frame into one block") {
+    auto arena = FrameArena{64};
+
+    for (auto i = 0; i < 16; ++i) {
+        static_cast<void>(arena.allocate(48, 8));
+    }
+    const auto overflowed_capacity = arena.get_capacity();
+    CHECK(overflowed_capacity >= 16 * 48);
+
+    arena.reset();
+    CHECK(arena.get_capacity() == overflowed_capacity);
+
+    // The same frame again fits in the one block, so nothing new is added.
+    for (auto i = 0; i < 16; ++i) {
+        static_cast<void>(arena.allocate(48, 8));
+    }
+    CHECK(arena.get_capacity() == overflowed_capacity);
+}
@@ -0,0 +1,122 @@
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <LuminolRenderEngine/Utilities/JobSystem.hpp>
+
+#include <doctest/doctest.h>
+
+using namespace Luminol::Utilities;
+
+TEST_CASE("JobSystem parallel_for visits every index exactly once") {
+    auto job_system = JobSystem{4};
+    constexpr auto count = std::size_t{10'007};
+
+    auto visits = std::vector<std::atomic<uint32_t>>(count);
+    job_system.parallel_for(count, 1, [&](std::size_t begin, std::size_t end) {
+        for (auto i = begin; i < end; ++i) {
+            visits[i].fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    auto all_visited_once = true;
+    for (const auto& visit : visits) {
+        all_visited_once = all_visited_once && visit.load() == 1;
+    }
+    CHECK(all_visited_once);
+}
+
+TEST_CASE("JobSystem parallel_for runs small counts as a single range") {
+    auto job_system = JobSystem{4};
+
+    auto range_count = 0U;
+    job_system.parallel_for(16, 64, [&](std::size_t begin, std::size_t end) {
+        CHECK(begin == 0);
+        CHECK(end == 16);
+        range_count += 1;
+    });
+    CHECK(range_count == 1);
+}
+
+TEST_CASE("JobSystem nested parallel_for completes") {
+    auto job_system = JobSystem{4};
+    constexpr auto outer_count = std::size_t{32};
+    constexpr auto inner_count = std::size_t{1'000};
+
+    auto total = std::atomic<std::size_t>{0};
+    job_system.parallel_for(
+        outer_count,
+        1,
+        [&](std::size_t outer_begin, std::size_t outer_end) {
+            for (auto i = outer_begin; i < outer_end; ++i) {
+                job_system.parallel_for(
+                    inner_count,
+                    1,
+                    [&](std::size_t begin, std::size_t end) {
+                        total.fetch_add(end - begin, std::memory_order_relaxed);
+                    }
+                );
+            }
+        }
+    );
+
+    CHECK(total.load() == outer_count * inner_count);
+}
+
+TEST_CASE("JobSystem wait only returns once its group's jobs have finished") {
+    auto job_system = JobSystem{3};
+    auto group = JobSystem::JobGroup{};
+
+    auto finished = std::atomic<uint32_t>{0};
+    for (auto i = 0; i < 100; ++i) {
+        job_system.submit(group, [&] {
+            finished.fetch_add(1, std::memory_order_relaxed);
+        });
+    }
+    job_system.wait(group);
+
+    CHECK(finished.load() == 100);
+}
+
+TEST_CASE("JobSystem with one worker runs jobs on the waiting thread") {
+    auto job_system = JobSystem{1};
+    CHECK(job_system.get_worker_count() == 1);
+
+    const auto caller = std::this_thread::get_id();
+    auto group = JobSystem::JobGroup{};
+    auto ran_on_caller = false;
+    job_system.submit(group, [&] {
+        ran_on_caller = std::this_thread::get_id() == caller;
+    });
+    job_system.wait(group);
+
+    CHECK(ran_on_caller);
+}
+
+TEST_CASE("JobSystem range jobs run their body over exactly their range") {
+    auto job_system = JobSystem{3};
+    auto group = JobSystem::JobGroup{};
+
+    // More jobs than a queue starts with room for, so the ring buffer has to
+    // grow while jobs are queued.
+    constexpr auto job_count = std::size_t{500};
+    auto visits = std::vector<std::atomic<uint32_t>>(job_count * 2);
+    const auto body = JobSystem::RangeBody{
+        [&visits](std::size_t begin, std::size_t end) {
+            for (auto i = begin; i < end; ++i) {
+                visits[i].fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    };
+    for (auto job = std::size_t{0}; job < job_count; ++job) {
+        job_system.submit(group, body, job * 2, (job * 2) + 2);
+    }
+    job_system.wait(group);
+
+    auto all_visited_once = true;
+    for (const auto& visit : visits) {
+        all_visited_once = all_visited_once && visit.load() == 1;
+    }
+    CHECK(all_visited_once);
+}
@@ -25,3 +25,47 @@ TEST_CASE("load_model returns nullopt for a nonexistent path") {
 
     CHECK_FALSE(model.has_value());
 }
+
+TEST_CASE("load_model decodes the same textures regardless of worker count") {
+    const auto serial_model = load_model(
+        "res/models/cut_fish/scene.gltf",
+        LoadOptions{.texture_decode_worker_count = 1}
+    );
+    const auto parallel_model = load_model(
+        "res/models/cut_fish/scene.gltf",
+        LoadOptions{.texture_decode_worker_count = 4}
+    );
+
+    REQUIRE(serial_model.has_value());
+    REQUIRE(parallel_model.has_value());
+    REQUIRE_FALSE(serial_model->textures_map.empty());
+    REQUIRE(
+        serial_model->textures_map.size() ==
+        parallel_model->textures_map.size()
+    );
+
+    for (const auto& [path, image] : serial_model->textures_map) {
+        CAPTURE(path);
+        REQUIRE(parallel_model->textures_map.contains(path));
+
+        const auto& parallel_image = parallel_model->textures_map.at(path);
+        CHECK(parallel_image.width == image.width);
+        CHECK(parallel_image.height == image.height);
+        CHECK(parallel_image.data == image.data);
+    }
+}
+
+TEST_CASE("load_model references every decoded texture from some mesh") {
+    const auto model = load_model("res/models/cube/cube.obj");
+
+    REQUIRE(model.has_value());
+    REQUIRE(model->textures_map.size() == 1);
+
+    const auto& mesh = model->meshes.front();
+    REQUIRE_FALSE(mesh.diffuse_texture_paths.empty());
+    CHECK(model->textures_map.contains(mesh.diffuse_texture_paths.front()));
+    CHECK(
+        model->textures_map.at(mesh.diffuse_texture_paths.front()).channels ==
+        4
+    );
+}